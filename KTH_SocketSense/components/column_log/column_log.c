@@ -0,0 +1,319 @@
+/**
+ * @file column_log.c
+ * @brief Indexed binary log format that stores the samples column by column in fixed-size blocks.
+ *
+ * The header fields are written byte by byte, the columns with memcpy in the native byte order.
+ *
+ * @date October 17. 2026
+ */
+#include <string.h>
+
+#include "column_log.h"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "The columns of the log are stored in little endian byte order"
+#endif
+
+/*****Private Functions Definitions*************************************************/
+
+void column_log_putU32(uint8_t *dst, uint32_t value);
+void column_log_putU64(uint8_t *dst, uint64_t value);
+uint32_t column_log_getU32(const uint8_t *src);
+uint64_t column_log_getU64(const uint8_t *src);
+size_t column_log_offset(uint32_t samples, uint32_t column);
+size_t column_log_columnSize(uint32_t column);
+void column_log_writeHeader(uint8_t *dst, const column_log_header_t *header);
+
+/*****Public Functions**************************************************************/
+
+int column_log_init(column_log_block_t *block, uint8_t *buffer, size_t capacity, uint32_t max_samples,
+		uint8_t sensor_count, uint8_t sensel_count)
+{
+	uint32_t sensels = (uint32_t) sensor_count * sensel_count;
+
+	if(max_samples == 0 || sensels > COLUMN_LOG_MAX_SENSELS
+			|| capacity < COLUMN_LOG_BLOCK_LENGTH((size_t) max_samples, sensels)){
+		return COLUMN_LOG_ERR_SPACE;
+	}
+
+	block->data = buffer;
+	block->max_samples = max_samples;
+	block->sensor_count = sensor_count;
+	block->sensel_count = sensel_count;
+	column_log_clear(block);
+
+	return COLUMN_LOG_OK;
+}
+
+void column_log_clear(column_log_block_t *block)
+{
+	block->samples = 0;
+	block->min_timestamp_us = UINT64_MAX;
+	block->max_timestamp_us = 0;
+}
+
+int column_log_append(column_log_block_t *block, const sample_frame_point_t *point)
+{
+	uint32_t sensels = (uint32_t) block->sensor_count * block->sensel_count;
+	uint32_t n = block->max_samples;
+	uint32_t i = block->samples;
+	uint8_t *data = block->data;
+	uint32_t sensel;
+
+	if(i == n){
+		return COLUMN_LOG_ERR_SPACE;
+	}
+
+	memcpy(data + column_log_offset(n, COLUMN_LOG_COLUMN_TIMESTAMP) + i * 8, &point->timestamp_usec, 8);
+	memcpy(data + column_log_offset(n, COLUMN_LOG_COLUMN_TEMPERATURE) + i * 4, &point->temperature, 4);
+	memcpy(data + column_log_offset(n, COLUMN_LOG_COLUMN_HUMIDITY) + i * 4, &point->humidity, 4);
+	memcpy(data + column_log_offset(n, COLUMN_LOG_COLUMN_PRESSURE) + i * 4, &point->pressure, 4);
+	memcpy(data + column_log_offset(n, COLUMN_LOG_COLUMN_SAMPLING_TIME) + i * 4, &point->sampling_time, 4);
+	memcpy(data + column_log_offset(n, COLUMN_LOG_COLUMN_BATTERY) + i * 4, &point->battery_voltage, 4);
+	for(sensel = 0; sensel < sensels; sensel++){										//one column per sensor element
+		memcpy(data + column_log_offset(n, COLUMN_LOG_COLUMN_SENSEL + sensel) + i * 2, &point->sensels[sensel], 2);
+	}
+
+	if(point->timestamp_usec < block->min_timestamp_us){
+		block->min_timestamp_us = point->timestamp_usec;
+	}
+	if(point->timestamp_usec > block->max_timestamp_us){
+		block->max_timestamp_us = point->timestamp_usec;
+	}
+	block->samples++;
+
+	return COLUMN_LOG_OK;
+}
+
+size_t column_log_finish(column_log_block_t *block, uint32_t sequence, uint64_t previous_index)
+{
+	uint32_t sensels = (uint32_t) block->sensor_count * block->sensel_count;
+	uint32_t n = block->samples;
+	uint32_t column;
+	size_t used = COLUMN_LOG_HEADER_SIZE + (size_t) n * COLUMN_LOG_ROW_SIZE(sensels);
+	size_t length = COLUMN_LOG_BLOCK_LENGTH((size_t) n, sensels);
+	column_log_header_t header;
+
+	if(n < block->max_samples){														//move the columns of a partial block together
+		for(column = COLUMN_LOG_COLUMN_TEMPERATURE; column < COLUMN_LOG_COLUMN_SENSEL + sensels; column++){
+			memmove(block->data + column_log_offset(n, column), block->data + column_log_offset(block->max_samples, column),
+					n * column_log_columnSize(column));
+		}
+	}
+	memset(block->data + used, 0, length - used);
+
+	header.type = COLUMN_LOG_TYPE_SAMPLES;
+	header.sensor_count = block->sensor_count;
+	header.sensel_count = block->sensel_count;
+	header.count = n;
+	header.sequence = sequence;
+	header.length = (uint32_t) length;
+	header.min_timestamp_us = block->min_timestamp_us;
+	header.max_timestamp_us = block->max_timestamp_us;
+	header.previous_index = previous_index;
+	column_log_writeHeader(block->data, &header);
+
+	return length;
+}
+
+size_t column_log_writeIndex(uint8_t *dst, size_t capacity, const column_log_entry_t *entries, uint32_t count,
+		uint8_t sensor_count, uint8_t sensel_count, uint32_t sequence, uint64_t previous_index)
+{
+	size_t length = COLUMN_LOG_INDEX_LENGTH((size_t) count);
+	column_log_header_t header;
+	uint8_t *pos = dst + COLUMN_LOG_HEADER_SIZE;
+	uint32_t i;
+
+	if(capacity < length){
+		return 0;
+	}
+
+	memset(dst, 0, length);
+	header.type = COLUMN_LOG_TYPE_INDEX;
+	header.sensor_count = sensor_count;
+	header.sensel_count = sensel_count;
+	header.count = count;
+	header.sequence = sequence;
+	header.length = (uint32_t) length;
+	header.min_timestamp_us = count > 0 ? UINT64_MAX : 0;
+	header.max_timestamp_us = 0;
+	header.previous_index = previous_index;
+	for(i = 0; i < count; i++){
+		column_log_putU64(pos, entries[i].offset);
+		column_log_putU64(pos + 8, entries[i].min_timestamp_us);
+		column_log_putU64(pos + 16, entries[i].max_timestamp_us);
+		column_log_putU32(pos + 24, entries[i].samples);
+		pos += COLUMN_LOG_ENTRY_SIZE;
+		if(entries[i].min_timestamp_us < header.min_timestamp_us){
+			header.min_timestamp_us = entries[i].min_timestamp_us;
+		}
+		if(entries[i].max_timestamp_us > header.max_timestamp_us){
+			header.max_timestamp_us = entries[i].max_timestamp_us;
+		}
+	}
+	column_log_writeHeader(dst, &header);
+
+	return length;
+}
+
+int column_log_parseHeader(const uint8_t *data, size_t length, column_log_header_t *header)
+{
+	if(length < COLUMN_LOG_HEADER_SIZE){
+		return COLUMN_LOG_ERR_INCOMPLETE;
+	}
+	if(data[0] != 'S' || data[1] != 'C' || data[2] != COLUMN_LOG_VERSION){
+		return COLUMN_LOG_ERR_INVALID;
+	}
+
+	header->type = data[3];
+	header->sensor_count = data[4];
+	header->sensel_count = data[5];
+	header->count = column_log_getU32(&data[8]);
+	header->sequence = column_log_getU32(&data[12]);
+	header->length = column_log_getU32(&data[16]);
+	header->min_timestamp_us = column_log_getU64(&data[24]);
+	header->max_timestamp_us = column_log_getU64(&data[32]);
+	header->previous_index = column_log_getU64(&data[40]);
+
+	if((header->type != COLUMN_LOG_TYPE_SAMPLES && header->type != COLUMN_LOG_TYPE_INDEX)
+			|| (uint32_t) header->sensor_count * header->sensel_count > COLUMN_LOG_MAX_SENSELS
+			|| header->length < COLUMN_LOG_HEADER_SIZE + COLUMN_LOG_MARKER_SIZE
+			|| header->length % COLUMN_LOG_ALIGNMENT != 0
+			|| header->length > COLUMN_LOG_MAX_BLOCK_LENGTH){
+		return COLUMN_LOG_ERR_INVALID;
+	}
+
+	return COLUMN_LOG_OK;
+}
+
+int column_log_checkMarker(const uint8_t *marker, const column_log_header_t *header)
+{
+	uint64_t content;
+
+	if(header->type == COLUMN_LOG_TYPE_SAMPLES){
+		content = (uint64_t) header->count * COLUMN_LOG_ROW_SIZE((uint32_t) header->sensor_count * header->sensel_count);
+	}else{
+		content = (uint64_t) header->count * COLUMN_LOG_ENTRY_SIZE;
+	}
+	if(COLUMN_LOG_HEADER_SIZE + content + COLUMN_LOG_MARKER_SIZE > header->length){
+		return COLUMN_LOG_ERR_INVALID;
+	}
+
+	if(marker[0] != 'S' || marker[1] != 'E' || column_log_getU32(&marker[4]) != header->sequence){
+		return COLUMN_LOG_ERR_INVALID;
+	}
+
+	return COLUMN_LOG_OK;
+}
+
+size_t column_log_columnOffset(const column_log_header_t *header, uint32_t column)
+{
+	return column_log_offset(header->count, column);
+}
+
+void column_log_readEntry(const uint8_t *block, uint32_t index, column_log_entry_t *entry)
+{
+	const uint8_t *pos = block + COLUMN_LOG_HEADER_SIZE + (size_t) index * COLUMN_LOG_ENTRY_SIZE;
+
+	entry->offset = column_log_getU64(pos);
+	entry->min_timestamp_us = column_log_getU64(pos + 8);
+	entry->max_timestamp_us = column_log_getU64(pos + 16);
+	entry->samples = column_log_getU32(pos + 24);
+}
+
+void column_log_readPoint(const uint8_t *block, const column_log_header_t *header, uint32_t index,
+		sample_frame_point_t *point, uint16_t *sensels)
+{
+	uint32_t count = (uint32_t) header->sensor_count * header->sensel_count;
+	uint32_t n = header->count;
+	uint32_t sensel;
+
+	memcpy(&point->timestamp_usec, block + column_log_offset(n, COLUMN_LOG_COLUMN_TIMESTAMP) + index * 8, 8);
+	memcpy(&point->temperature, block + column_log_offset(n, COLUMN_LOG_COLUMN_TEMPERATURE) + index * 4, 4);
+	memcpy(&point->humidity, block + column_log_offset(n, COLUMN_LOG_COLUMN_HUMIDITY) + index * 4, 4);
+	memcpy(&point->pressure, block + column_log_offset(n, COLUMN_LOG_COLUMN_PRESSURE) + index * 4, 4);
+	memcpy(&point->sampling_time, block + column_log_offset(n, COLUMN_LOG_COLUMN_SAMPLING_TIME) + index * 4, 4);
+	memcpy(&point->battery_voltage, block + column_log_offset(n, COLUMN_LOG_COLUMN_BATTERY) + index * 4, 4);
+	for(sensel = 0; sensel < count; sensel++){
+		memcpy(&sensels[sensel], block + column_log_offset(n, COLUMN_LOG_COLUMN_SENSEL + sensel) + index * 2, 2);
+	}
+	point->sensels = sensels;
+	point->sensel_mask = NULL;
+}
+
+/*****Private Functions*************************************************************/
+
+void column_log_putU32(uint8_t *dst, uint32_t value)
+{
+	dst[0] = (uint8_t) value;
+	dst[1] = (uint8_t)(value >> 8);
+	dst[2] = (uint8_t)(value >> 16);
+	dst[3] = (uint8_t)(value >> 24);
+}
+
+void column_log_putU64(uint8_t *dst, uint64_t value)
+{
+	column_log_putU32(dst, (uint32_t) value);
+	column_log_putU32(dst + 4, (uint32_t)(value >> 32));
+}
+
+uint32_t column_log_getU32(const uint8_t *src)
+{
+	return src[0] | ((uint32_t) src[1] << 8) | ((uint32_t) src[2] << 16) | ((uint32_t) src[3] << 24);
+}
+
+uint64_t column_log_getU64(const uint8_t *src)
+{
+	return column_log_getU32(src) | ((uint64_t) column_log_getU32(src + 4) << 32);
+}
+
+/**
+ * Offset of a column in a samples block with the given number of samples (the stride of the columns).
+ */
+size_t column_log_offset(uint32_t samples, uint32_t column)
+{
+	size_t n = samples;
+
+	if(column == COLUMN_LOG_COLUMN_TIMESTAMP){
+		return COLUMN_LOG_HEADER_SIZE;
+	}
+	if(column < COLUMN_LOG_COLUMN_SENSEL){											//the 4 byte columns follow the timestamps
+		return COLUMN_LOG_HEADER_SIZE + n * 8 + (column - COLUMN_LOG_COLUMN_TEMPERATURE) * n * 4;
+	}
+
+	return COLUMN_LOG_HEADER_SIZE + n * 28 + (column - COLUMN_LOG_COLUMN_SENSEL) * n * 2;
+}
+
+size_t column_log_columnSize(uint32_t column)
+{
+	if(column == COLUMN_LOG_COLUMN_TIMESTAMP){
+		return 8;
+	}
+
+	return column < COLUMN_LOG_COLUMN_SENSEL ? 4 : 2;
+}
+
+void column_log_writeHeader(uint8_t *dst, const column_log_header_t *header)
+{
+	uint8_t *marker = dst + header->length - COLUMN_LOG_MARKER_SIZE;
+
+	memset(dst, 0, COLUMN_LOG_HEADER_SIZE);
+	dst[0] = 'S';
+	dst[1] = 'C';
+	dst[2] = COLUMN_LOG_VERSION;
+	dst[3] = header->type;
+	dst[4] = header->sensor_count;
+	dst[5] = header->sensel_count;
+	column_log_putU32(&dst[8], header->count);
+	column_log_putU32(&dst[12], header->sequence);
+	column_log_putU32(&dst[16], header->length);
+	column_log_putU64(&dst[24], header->min_timestamp_us);
+	column_log_putU64(&dst[32], header->max_timestamp_us);
+	column_log_putU64(&dst[40], header->previous_index);
+
+	marker[0] = 'S';																//the marker at the end tells that the block is complete
+	marker[1] = 'E';
+	marker[2] = 0;
+	marker[3] = 0;
+	column_log_putU32(&marker[4], header->sequence);
+}
@@ -0,0 +1,255 @@
+/**
+ * @file column_log.h
+ * @brief Indexed binary log format that stores the samples column by column in fixed-size blocks.
+ *
+ * The log-file is a sequence of blocks. Every block starts on a multiple of COLUMN_LOG_ALIGNMENT bytes (one SD-card
+ * sector) and is padded to such a multiple. It starts with a header of COLUMN_LOG_HEADER_SIZE bytes and ends with a
+ * marker of COLUMN_LOG_MARKER_SIZE bytes, all values are little endian:
+ *
+ * | Offset | Size | Content                                                            |
+ * |--------|------|--------------------------------------------------------------------|
+ * | 0      | 2    | Magic 'S' 'C'                                                      |
+ * | 2      | 1    | Version (COLUMN_LOG_VERSION)                                       |
+ * | 3      | 1    | Type (COLUMN_LOG_TYPE_SAMPLES or COLUMN_LOG_TYPE_INDEX)            |
+ * | 4      | 1    | Number of sensor strips                                            |
+ * | 5      | 1    | Number of sensor elements per strip                                |
+ * | 6      | 2    | Reserved (0)                                                       |
+ * | 8      | 4    | Number of samples (index: number of entries)                       |
+ * | 12     | 4    | Sequence number of the block since the start of the device         |
+ * | 16     | 4    | Length of the block including header, padding and marker           |
+ * | 20     | 4    | Reserved (0)                                                       |
+ * | 24     | 8    | Smallest timestamp of the block in us (UNIX time)                  |
+ * | 32     | 8    | Largest timestamp of the block in us                               |
+ * | 40     | 8    | Offset of the last index block before this block, or COLUMN_LOG_NO_INDEX |
+ * | 48     | 16   | Reserved (0)                                                       |
+ *
+ * The marker at the end of the block is 'S' 'E', two reserved bytes and the sequence number of the block. A block
+ * that was cut off by a reset has no valid marker and is skipped by the readers.
+ *
+ * A samples block holds n samples as columns that follow the header back to back: the timestamps (uint64_t[n]),
+ * temperature, humidity and pressure (float[n] each), sampling time and battery voltage (uint32_t[n] each), followed by
+ * one uint16_t[n] column per sensor element (strip major). The columns are stored in the byte order of the ESP32,
+ * which is the one of the hosts as well, and they are naturally aligned, so a reader can use them in place.
+ * A block is written once it holds the configured number of samples, or earlier with fewer samples.
+ *
+ * An index block holds one entry of COLUMN_LOG_ENTRY_SIZE bytes per samples block that was written since the previous
+ * index block: the offset of the block (uint64_t), its smallest and largest timestamp (uint64_t) and its number of
+ * samples (uint32_t, followed by 4 reserved bytes). The number of sensor strips and elements in the header of an index
+ * block are the ones of the indexed blocks, so a reader can compute their lengths. The index blocks are linked by the previous index offset of their
+ * header, and every samples block points to the last index before it. A reader finds the last valid block at the
+ * end of the file and follows the links back, so it only has to read the index blocks and the blocks after the
+ * last index to find the blocks of a time range. After a restart of the device the links start again with
+ * COLUMN_LOG_NO_INDEX, the reader then continues with the last valid block before the first block of the chain.
+ *
+ * The codec only depends on the C standard library and on the point type of sample_frame.h, it is shared by the
+ * firmware and by the host tools (tools/codec).
+ *
+ * @date October 17. 2026
+ */
+#ifndef COMPONENTS_COLUMN_LOG_H_
+#define COMPONENTS_COLUMN_LOG_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "sample_frame.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define COLUMN_LOG_HEADER_SIZE			64		//!< Size of the block header in bytes
+#define COLUMN_LOG_MARKER_SIZE			8		//!< Size of the marker at the end of a block in bytes
+#define COLUMN_LOG_ALIGNMENT			512		//!< Blocks start at and are padded to multiples of this size
+#define COLUMN_LOG_ENTRY_SIZE			32		//!< Size of one entry of an index block in bytes
+#define COLUMN_LOG_VERSION				1		//!< Version of the log format
+#define COLUMN_LOG_TYPE_SAMPLES			1		//!< Block with samples stored column by column
+#define COLUMN_LOG_TYPE_INDEX			2		//!< Block with the index of the previous samples blocks
+#define COLUMN_LOG_MAX_SENSELS			256		//!< Upper bound of sensor strips times sensor elements per strip
+#define COLUMN_LOG_MAX_BLOCK_LENGTH		(4 * 1024 * 1024)	//!< Blocks that claim to be larger are rejected by the parser
+#define COLUMN_LOG_NO_INDEX				UINT64_MAX	//!< Previous index offset if there is none
+
+#define COLUMN_LOG_COLUMN_TIMESTAMP		0		//!< uint64_t timestamps in us
+#define COLUMN_LOG_COLUMN_TEMPERATURE	1		//!< float temperatures
+#define COLUMN_LOG_COLUMN_HUMIDITY		2		//!< float humidities
+#define COLUMN_LOG_COLUMN_PRESSURE		3		//!< float pressures
+#define COLUMN_LOG_COLUMN_SAMPLING_TIME	4		//!< uint32_t sampling times
+#define COLUMN_LOG_COLUMN_BATTERY		5		//!< uint32_t battery voltages
+#define COLUMN_LOG_COLUMN_SENSEL		6		//!< First uint16_t sensor element column, strip * sensel_count + sensel follow
+
+/**
+ * @brief Size in bytes of one row of all columns.
+ */
+#define COLUMN_LOG_ROW_SIZE(sensels)	(28 + (sensels) * 2)
+
+/**
+ * @brief Length of a samples block with the given number of samples and sensor elements.
+ */
+#define COLUMN_LOG_BLOCK_LENGTH(samples, sensels)	\
+	(((COLUMN_LOG_HEADER_SIZE + (samples) * COLUMN_LOG_ROW_SIZE(sensels) + COLUMN_LOG_MARKER_SIZE \
+	+ COLUMN_LOG_ALIGNMENT - 1) / COLUMN_LOG_ALIGNMENT) * COLUMN_LOG_ALIGNMENT)
+
+/**
+ * @brief Length of an index block with the given number of entries.
+ */
+#define COLUMN_LOG_INDEX_LENGTH(entries)	\
+	(((COLUMN_LOG_HEADER_SIZE + (entries) * COLUMN_LOG_ENTRY_SIZE + COLUMN_LOG_MARKER_SIZE \
+	+ COLUMN_LOG_ALIGNMENT - 1) / COLUMN_LOG_ALIGNMENT) * COLUMN_LOG_ALIGNMENT)
+
+#define COLUMN_LOG_OK					0		//!< Success
+#define COLUMN_LOG_ERR_SPACE			-1		//!< The block is full or the buffer is too small
+#define COLUMN_LOG_ERR_INCOMPLETE		-2		//!< More data is needed to parse the block
+#define COLUMN_LOG_ERR_INVALID			-3		//!< The data is not a valid block
+
+/**
+ * @brief Parsed block header.
+ */
+typedef struct {
+	uint8_t		type;				/**< COLUMN_LOG_TYPE_SAMPLES or COLUMN_LOG_TYPE_INDEX. */
+	uint8_t		sensor_count;		/**< Number of sensor strips. */
+	uint8_t		sensel_count;		/**< Number of sensor elements per strip. */
+	uint32_t	count;				/**< Number of samples, or of index entries. */
+	uint32_t	sequence;			/**< Sequence number of the block. */
+	uint32_t	length;				/**< Length of the block in bytes. */
+	uint64_t	min_timestamp_us;	/**< Smallest timestamp. */
+	uint64_t	max_timestamp_us;	/**< Largest timestamp. */
+	uint64_t	previous_index;		/**< Offset of the previous index block, COLUMN_LOG_NO_INDEX if there is none. */
+} column_log_header_t;
+
+/**
+ * @brief One entry of an index block.
+ */
+typedef struct {
+	uint64_t	offset;				/**< Offset of the samples block in the log-file. */
+	uint64_t	min_timestamp_us;	/**< Smallest timestamp of the block. */
+	uint64_t	max_timestamp_us;	/**< Largest timestamp of the block. */
+	uint32_t	samples;			/**< Number of samples of the block. */
+} column_log_entry_t;
+
+/**
+ * @brief A samples block that is being filled.
+ *
+ * The columns are filled with a stride of max_samples and moved together when a partial block is finished.
+ */
+typedef struct {
+	uint8_t		*data;				/**< Buffer of COLUMN_LOG_BLOCK_LENGTH(max_samples, sensels) bytes. */
+	uint32_t	max_samples;		/**< Number of samples of a full block. */
+	uint8_t		sensor_count;		/**< Number of sensor strips. */
+	uint8_t		sensel_count;		/**< Number of sensor elements per strip. */
+	uint32_t	samples;			/**< Number of samples in the block. */
+	uint64_t	min_timestamp_us;	/**< Smallest timestamp in the block. */
+	uint64_t	max_timestamp_us;	/**< Largest timestamp in the block. */
+} column_log_block_t;
+
+/**
+ * @brief Initializes an empty block.
+ *
+ * @param block The block.
+ * @param buffer Buffer for the block.
+ * @param capacity Size of the buffer, at least COLUMN_LOG_BLOCK_LENGTH(max_samples, sensor_count * sensel_count).
+ * @param max_samples Number of samples of a full block.
+ * @param sensor_count Number of sensor strips.
+ * @param sensel_count Number of sensor elements per strip.
+ * @return COLUMN_LOG_OK, or COLUMN_LOG_ERR_SPACE if the buffer is too small.
+ */
+int column_log_init(column_log_block_t *block, uint8_t *buffer, size_t capacity, uint32_t max_samples,
+		uint8_t sensor_count, uint8_t sensel_count);
+
+/**
+ * @brief Removes all samples from the block.
+ */
+void column_log_clear(column_log_block_t *block);
+
+/**
+ * @brief Adds one sample to the block.
+ *
+ * @param block The block.
+ * @param point The sample, its sensels must hold sensor_count * sensel_count values.
+ * @return COLUMN_LOG_OK, or COLUMN_LOG_ERR_SPACE if the block is full.
+ */
+int column_log_append(column_log_block_t *block, const sample_frame_point_t *point);
+
+/**
+ * @brief Finishes the block, it can be written to the log-file afterwards.
+ *
+ * The columns of a partial block are moved together, the header, the padding and the marker are written.
+ * The block has to be cleared before it is filled again.
+ *
+ * @param block The block, it must hold at least one sample.
+ * @param sequence Sequence number of the block.
+ * @param previous_index Offset of the last index block in the log-file, or COLUMN_LOG_NO_INDEX.
+ * @return Length of the block in bytes.
+ */
+size_t column_log_finish(column_log_block_t *block, uint32_t sequence, uint64_t previous_index);
+
+/**
+ * @brief Writes an index block.
+ *
+ * @param dst Destination, needs COLUMN_LOG_INDEX_LENGTH(count) bytes.
+ * @param capacity Size of the destination.
+ * @param entries The entries.
+ * @param count Number of entries.
+ * @param sensor_count Number of sensor strips of the indexed blocks.
+ * @param sensel_count Number of sensor elements per strip of the indexed blocks.
+ * @param sequence Sequence number of the block.
+ * @param previous_index Offset of the previous index block in the log-file, or COLUMN_LOG_NO_INDEX.
+ * @return Length of the block, 0 if the destination is too small.
+ */
+size_t column_log_writeIndex(uint8_t *dst, size_t capacity, const column_log_entry_t *entries, uint32_t count,
+		uint8_t sensor_count, uint8_t sensel_count, uint32_t sequence, uint64_t previous_index);
+
+/**
+ * @brief Parses and checks the header of a block.
+ *
+ * @param data Start of the block.
+ * @param length Number of available bytes.
+ * @param header Destination for the header.
+ * @return COLUMN_LOG_OK, COLUMN_LOG_ERR_INCOMPLETE if less than the header is available, COLUMN_LOG_ERR_INVALID if the
+ * 			data is not a block header.
+ */
+int column_log_parseHeader(const uint8_t *data, size_t length, column_log_header_t *header);
+
+/**
+ * @brief Checks the marker at the end of a block whose header has been parsed.
+ *
+ * @param marker The last COLUMN_LOG_MARKER_SIZE bytes of the block (header->length bytes after its start).
+ * @param header The parsed header.
+ * @return COLUMN_LOG_OK, or COLUMN_LOG_ERR_INVALID if the block is incomplete or its content does not fit the header.
+ */
+int column_log_checkMarker(const uint8_t *marker, const column_log_header_t *header);
+
+/**
+ * @brief Returns the offset of a column relative to the start of a samples block.
+ *
+ * @param header The parsed header.
+ * @param column COLUMN_LOG_COLUMN_..., COLUMN_LOG_COLUMN_SENSEL + i for sensor element i.
+ * @return Offset in bytes.
+ */
+size_t column_log_columnOffset(const column_log_header_t *header, uint32_t column);
+
+/**
+ * @brief Reads one entry of an index block.
+ *
+ * @param block Start of the index block.
+ * @param index Number of the entry.
+ * @param entry Destination for the entry.
+ */
+void column_log_readEntry(const uint8_t *block, uint32_t index, column_log_entry_t *entry);
+
+/**
+ * @brief Reads one sample (row) of a samples block.
+ *
+ * @param block Start of the samples block.
+ * @param header The parsed header.
+ * @param index Number of the sample.
+ * @param point Destination, its sensels pointer is set to the given array and sensel_mask to NULL.
+ * @param sensels Destination for sensor_count * sensel_count values.
+ */
+void column_log_readPoint(const uint8_t *block, const column_log_header_t *header, uint32_t index,
+		sample_frame_point_t *point, uint16_t *sensels);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COMPONENTS_COLUMN_LOG_H_ */
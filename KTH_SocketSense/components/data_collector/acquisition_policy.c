@@ -0,0 +1,137 @@
+/**
+ * @file acquisition_policy.c
+ * @brief Selects the acquisition profile of the data collector from the activity reported by the gait monitor.
+ *
+ * @date October 17. 2026
+ */
+#include <stddef.h>
+#include <string.h>
+
+#include "esp_log.h"
+
+#include "acquisition_policy.h"
+#include "gait_monitor.h"
+
+static const char *TAG = "ACQUISITION_POLICY";
+
+#define ACQUISITION_POLICY_REST_SUMMARY (CONFIG_DATA_COLLECTOR_POLICY_REST_SUMMARY == 1 && CONFIG_DATA_COLLECTOR_FEATURES > 0)
+
+/**
+ * Acquisition profiles of the data collector, the first one that applies to the activity of a sample is selected.
+ * Standing up from a chair is recorded like the gait, the default profile is the configuration without the policy.
+ */
+static const acquisition_profile_t default_profiles[] = {
+	{"gait",		BIONICS_ACTIVITY_AMBULATING,	CONFIG_DATA_COLLECTOR_POLICY_GAIT_RATE_HZ,	0,		CONFIG_DATA_COLLECTOR_DEADBAND},
+	{"transfer",	BIONICS_ACTIVITY_CHAIR_EXIT,	CONFIG_DATA_COLLECTOR_POLICY_GAIT_RATE_HZ,	0,		CONFIG_DATA_COLLECTOR_DEADBAND},
+	{"mobile",		BIONICS_ACTIVITY_MOBILE,		CONFIG_DATA_COLLECTOR_POLICY_GAIT_RATE_HZ,	0,		CONFIG_DATA_COLLECTOR_DEADBAND},
+	{"rest",		BIONICS_ACTIVITY_IMMOBILE,		CONFIG_DATA_COLLECTOR_POLICY_REST_RATE_HZ,	ACQUISITION_POLICY_REST_SUMMARY,	CONFIG_DATA_COLLECTOR_POLICY_REST_DEADBAND},
+	{"default",		BIONICS_ACTIVITY_UNKNOWN,		0,	CONFIG_DATA_COLLECTOR_FEATURES == 2,	CONFIG_DATA_COLLECTOR_DEADBAND},
+};
+
+/*****Private Functions Definitions*************************************************/
+
+uint8_t acquisition_policy_isUpgrade(const acquisition_policy_t *policy, const acquisition_profile_t *profile);
+void acquisition_policy_select(acquisition_policy_t *policy, const acquisition_profile_t *profile, uint32_t activity);
+
+/*****Public Functions**************************************************************/
+
+void acquisition_policy_init(acquisition_policy_t *policy, const acquisition_profile_t *profiles, uint32_t count,
+		uint32_t hold_ms, uint32_t base_rate_hz)
+{
+	memset(policy, 0, sizeof(acquisition_policy_t));
+	policy->profiles = profiles;
+	policy->count = count;
+	policy->hold_us = hold_ms * 1000;
+	policy->base_rate_hz = base_rate_hz;
+}
+
+void acquisition_policy_initDefault(acquisition_policy_t *policy, uint32_t hold_ms, uint32_t base_rate_hz)
+{
+	acquisition_policy_init(policy, default_profiles, sizeof(default_profiles) / sizeof(default_profiles[0]), hold_ms,
+			base_rate_hz);
+}
+
+void acquisition_policy_reset(acquisition_policy_t *policy)
+{
+	policy->current = NULL;
+	policy->candidate = NULL;
+}
+
+const acquisition_profile_t* acquisition_policy_match(const acquisition_policy_t *policy, uint32_t activity)
+{
+	uint32_t i;
+
+	for(i = 0; i < policy->count; i++){
+		if((activity & policy->profiles[i].activity) == policy->profiles[i].activity){
+			return &policy->profiles[i];
+		}
+	}
+
+	return NULL;
+}
+
+const acquisition_profile_t* acquisition_policy_update(acquisition_policy_t *policy, uint32_t activity, int64_t time_us)
+{
+	const acquisition_profile_t *profile = acquisition_policy_match(policy, activity);
+
+	if(profile == NULL){
+		return NULL;
+	}
+	if(policy->current == NULL){
+		acquisition_policy_select(policy, profile, activity);
+		return profile;
+	}
+
+	if(profile == policy->candidate){
+		policy->candidate_codes++;
+		policy->contrary_codes = 0;
+	}else if(policy->candidate != NULL && ++policy->contrary_codes < ACQUISITION_POLICY_CONFIRM_CODES){
+		return NULL;														//a single misclassified code is ignored
+	}else{
+		policy->candidate = profile != policy->current ? profile : NULL;	//start over
+		policy->candidate_since_us = time_us;
+		policy->candidate_codes = 1;
+		policy->contrary_codes = 0;
+	}
+
+	if(policy->candidate == NULL || policy->candidate_codes < ACQUISITION_POLICY_CONFIRM_CODES){
+		return NULL;
+	}
+	if(!acquisition_policy_isUpgrade(policy, profile) && time_us - policy->candidate_since_us < policy->hold_us){
+		return NULL;
+	}
+
+	acquisition_policy_select(policy, profile, activity);
+	return profile;
+}
+
+uint32_t acquisition_policy_getRate(const acquisition_policy_t *policy, const acquisition_profile_t *profile)
+{
+	return profile->sample_rate_hz > 0 ? profile->sample_rate_hz : policy->base_rate_hz;
+}
+
+/*****Private Functions*************************************************************/
+
+/**
+ * Returns 1 if the profile records more than the current one: a higher rate, or the sensor elements instead of the
+ * summaries.
+ */
+uint8_t acquisition_policy_isUpgrade(const acquisition_policy_t *policy, const acquisition_profile_t *profile)
+{
+	if(acquisition_policy_getRate(policy, profile) > acquisition_policy_getRate(policy, policy->current)){
+		return 1;
+	}
+	return policy->current->summary_only > 0 && profile->summary_only == 0;
+}
+
+void acquisition_policy_select(acquisition_policy_t *policy, const acquisition_profile_t *profile, uint32_t activity)
+{
+	ESP_LOGI(TAG, "%s -> %s (%s, 0x%08x): %u Hz, %s, deadband %u",
+			policy->current != NULL ? policy->current->name : "start", profile->name,
+			gait_monitor_getActivityName(activity), activity, acquisition_policy_getRate(policy, profile),
+			profile->summary_only > 0 ? "summaries" : "sensor elements", profile->deadband);
+
+	policy->current = profile;
+	policy->candidate = NULL;
+	policy->transitions++;
+}
@@ -12,12 +12,15 @@
  * @author Matthias Becker
  * @date June 12. 2019
  */
+#include <math.h>
 #include <stddef.h>
+#include <string.h>
 #include <time.h>
 #include <sys/time.h>
 
 #include "esp_system.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include <esp_err.h>
 
 #include "freertos/FreeRTOS.h"
@@ -33,14 +36,74 @@
 #include "socketsense_sensor.h"
 #include "gait_monitor.h"
 #include "pcf8523.h"
+#include "sample_pool.h"
+#include "sensel_deadband.h"
+#include "sensel_calibration.h"
+#include "sensel_features.h"
+#include "sensel_exposure.h"
+#include "acquisition_policy.h"
 #include "KTHSocketSense.h"
 
 static const char *TAG = "DATA_COLLECTOR";
 
+#if CONFIG_DATA_COLLECTOR_POLICY == 1 && (CONFIG_GAIT_SENSOR_ACTIVE != 1 || CONFIG_DATA_COLLECTOR_TIMER_MODE != 1)
+#error "CONFIG_DATA_COLLECTOR_POLICY needs the gait monitor (CONFIG_GAIT_SENSOR_ACTIVE) and the timer mode"
+#endif
+
 TaskHandle_t dataCollectionTask;
 
 uint32_t dataCollector_initialized = 0;
 
+/**
+ * Timing statistics of the data collector task.
+ */
+data_collector_stats_t collector_stats;
+
+sensel_deadband_t deadband;					//change-only reporting of the sensor elements
+#if CONFIG_DATA_COLLECTOR_CALIBRATION == 1
+sensel_calibration_t calibration;			//curves of the sensor elements, loaded from the SD-card
+#endif
+#if CONFIG_DATA_COLLECTOR_FEATURES > 0
+sensel_features_t features;					//summaries of the pressure features
+uint8_t summary_only = CONFIG_DATA_COLLECTOR_FEATURES == 2;	//1 if only the samples with a summary are published
+SocketSense_Sample_t *held_sample;			//slot of the last sample without a summary
+sample_handle_t held_handle;
+#endif
+#if CONFIG_DATA_COLLECTOR_EXPOSURE == 1
+sensel_exposure_t exposure;					//pressure exposure of the sensor elements, restored from the SD-card
+#endif
+#if CONFIG_DATA_COLLECTOR_POLICY == 1
+acquisition_policy_t policy;				//acquisition profile of the current activity
+#endif
+
+#if CONFIG_DATA_COLLECTOR_TIMER_MODE == 1
+esp_timer_handle_t sampling_timer;
+uint32_t sample_rate_hz = CONFIG_DATA_COLLECTOR_SAMPLE_RATE_HZ;				//period of the timer, only changed by the task
+uint32_t base_rate_hz = CONFIG_DATA_COLLECTOR_SAMPLE_RATE_HZ;				//rate the timer was last started with
+volatile uint32_t requested_rate_hz = CONFIG_DATA_COLLECTOR_SAMPLE_RATE_HZ;	//rate of data_collector_setSampleRate()
+uint8_t timer_running = 0;
+int64_t timer_start_us;						//time at which the sampling timer was started
+volatile uint32_t timer_releases;			//number of releases of the sampling timer since it was started
+uint32_t processed_releases;				//number of the last release that was processed by the task
+uint64_t jitter_sum_us;
+uint32_t logged_misses;						//missed deadlines that have been logged already
+int64_t miss_log_us;						//time of the last warning about missed deadlines
+#endif
+
+/*****Private Functions Definitions*************************************************/
+
+void data_collector_record();
+#if CONFIG_DATA_COLLECTOR_POLICY == 1
+void data_collector_applyProfile(const acquisition_profile_t *profile);
+#endif
+#if CONFIG_DATA_COLLECTOR_TIMER_MODE == 1
+void data_collector_timer_callback(void* arg);
+esp_err_t data_collector_startTimer();
+esp_err_t data_collector_restartTimer();
+void data_collector_applyRate();
+void data_collector_logMisses(int64_t now);
+#endif
+
 /**
  * This function initializes the data collector component.
  */
@@ -72,7 +135,9 @@ esp_err_t data_collector_init(void)
 		.clock_speed_hz=16*1000*1000,           			//Clock out at 10 MHz
 		.mode=0,                               			//SPI mode 0
 		.spics_io_num=-1,  								//CS not used, the different sensor strips are addressed via GPIOs
-		.queue_size=10,                          		//We want to be able to queue 7 transactions at a time
+		.queue_size=SOCKETSENSE_SENSOR_QUEUE_SIZE,		//We want to be able to queue the transactions of a complete sweep
+		.pre_cb=socketsense_sensor_spi_pre_transfer_callback,	//The callbacks set the CS GPIO of the addressed sensor strip
+		.post_cb=socketsense_sensor_spi_post_transfer_callback,
 	};
 
 	spi_device_interface_config_t dev_gait_monitor_cfg={
@@ -110,10 +175,56 @@ esp_err_t data_collector_init(void)
 	}
 #endif
 
-	data_queue = xQueueCreate(10, sizeof(SocketSense_Sample_t));
-	if(data_queue == 0){
-		ESP_LOGE(TAG, "failed to create the queue");
+	sensel_deadband_init(&deadband, CONFIG_DATA_COLLECTOR_DEADBAND, CONFIG_DATA_COLLECTOR_KEYFRAME_INTERVAL);
+
+#if CONFIG_DATA_COLLECTOR_CALIBRATION == 1
+	sensel_calibration_init(&calibration);
+	switch(sensel_calibration_load(&calibration, SENSEL_CALIBRATION_FILE)){	//the SD-card has been mounted before
+		case ESP_OK:
+			break;
+		case ESP_ERR_NOT_FOUND:
+			ESP_LOGW(TAG, "%s not found, the sensor elements are not calibrated", SENSEL_CALIBRATION_FILE);
+			break;
+		default:
+			ESP_LOGE(TAG, "%s is invalid, the sensor elements are not calibrated", SENSEL_CALIBRATION_FILE);
+			sensel_calibration_init(&calibration);							//no mix of calibrated and raw sensor elements
+			break;
+	}
+#endif
+
+#if CONFIG_DATA_COLLECTOR_FEATURES > 0
+	sensel_features_init(&features, CONFIG_DATA_COLLECTOR_FEATURES_INTERVAL_MS, CONFIG_DATA_COLLECTOR_FEATURES_BUDGET_US);
+#endif
+
+#if CONFIG_DATA_COLLECTOR_EXPOSURE == 1
+	sensel_exposure_init(&exposure, CONFIG_DATA_COLLECTOR_EXPOSURE_THRESHOLD, CONFIG_DATA_COLLECTOR_EXPOSURE_INTERVAL_S);
+	if(sensel_exposure_load(&exposure, SENSEL_EXPOSURE_FILE) != ESP_OK
+			&& sensel_exposure_load(&exposure, SENSEL_EXPOSURE_TEMP_FILE) != ESP_OK){	//the last snapshot was not renamed
+		ESP_LOGW(TAG, "No exposure snapshot on the SD-card, the exposure starts from zero");
 	}
+#endif
+
+#if CONFIG_DATA_COLLECTOR_POLICY == 1
+	acquisition_policy_initDefault(&policy, CONFIG_DATA_COLLECTOR_POLICY_HOLD_MS, CONFIG_DATA_COLLECTOR_SAMPLE_RATE_HZ);
+#endif
+
+	if(sample_pool_init() != ESP_OK){								//the pool holds the samples that are passed to the database component
+		ESP_LOGE(TAG, "failed to initialize the sample pool");
+		retval = ESP_FAIL;
+	}
+
+#if CONFIG_DATA_COLLECTOR_TIMER_MODE == 1
+	esp_timer_create_args_t timer_args = {
+		.callback = data_collector_timer_callback,
+		.arg = NULL,
+		.dispatch_method = ESP_TIMER_TASK,
+		.name = "data_collector"
+	};
+	if(esp_timer_create(&timer_args, &sampling_timer) != ESP_OK){
+		ESP_LOGE(TAG, "failed to create the sampling timer");
+		retval = ESP_FAIL;
+	}
+#endif
 
 	if(retval == ESP_OK){
 		ESP_LOGI(TAG, "init");
@@ -126,16 +237,286 @@ esp_err_t data_collector_init(void)
 }
 
 /**
- * Main task of the data collector.
+ * Records one sample directly into a slot of the sample pool and hands it over to the database component.
+ * The activity code of the gait monitor is read after the sensors, while the sample is processed, so it is not part of
+ * the sampling time.
+ * If only the summaries are reported (CONFIG_DATA_COLLECTOR_FEATURES == 2, or a profile of the acquisition policy), only
+ * the samples that carry the summary of a window are handed over, the slot of the other ones is used again for the next sample.
+ */
+void data_collector_record()
+{
+	int64_t start;
+	int64_t stop;
+	sample_handle_t handle;
+	SocketSense_Sample_t *sample;
+#if CONFIG_DATA_COLLECTOR_POLICY == 1
+	const acquisition_profile_t *profile;
+#endif
+
+	start = esp_timer_get_time();
+
+#if CONFIG_DATA_COLLECTOR_FEATURES > 0
+	sample = held_sample;
+	handle = held_handle;
+	held_sample = NULL;
+	if(sample == NULL){
+		sample = sample_pool_acquire(&handle);
+	}
+#else
+	sample = sample_pool_acquire(&handle);
+#endif
+	if(sample == NULL){
+		ESP_LOGE(TAG, "No free sample slot, sample dropped!");
+		return;
+	}
+
+	pcf8523_getEspTimestamp(&sample->timestamp_usec);						//get the timestamp for the sample
+
+#if CONFIG_BME280_SENSOR_ACTIVE == 1
+	bme280_readSensorData(&sample->bme280_data);							//read the BME280 data
+#endif
+
+#if CONFIG_SOCKETSENSE_SENSOR_ACTIVE == 1
+	socketsense_sensor_readSensorData(sample->sensorstrip_data);			//read the sensor elements
+	for(int i = 0; i < CONFIG_SOCKETSENSE_SENSOR_COUNT; i++){
+		ESP_LOGD(TAG, "Sweep time of sensor strip %i: %u usec", i, socketsense_sensor_getSweepTime(i));
+	}
+#if CONFIG_DATA_COLLECTOR_CALIBRATION == 1
+#if CONFIG_BME280_SENSOR_ACTIVE == 1
+	sensel_calibration_apply(&calibration, sample->sensorstrip_data, sample->bme280_data.temperature);
+#else
+	sensel_calibration_apply(&calibration, sample->sensorstrip_data, NAN);		//without the BME280 there is no compensation
+#endif
+#endif
+#endif
+	stop = esp_timer_get_time();
+
+	sample->sampling_time = (uint32_t)(stop - start);						//collect statistics of the measurement
+	sample->battery_voltage = getBatteryVoltage();							//add the last battery voltage value (in mV)
+#if CONFIG_GAIT_SENSOR_ACTIVE == 1
+	gait_monitor_startRead();												//runs on the bus while the sample is processed
+#endif
+
+	collector_stats.samples++;
+	if(sample->sampling_time > collector_stats.max_sampling_time_us){
+		collector_stats.max_sampling_time_us = sample->sampling_time;
+	}
+
+#if CONFIG_DATA_COLLECTOR_EXPOSURE == 1
+	sensel_exposure_update(&exposure, sample->sensorstrip_data, start, sample->timestamp_usec);
+#endif
+
+#if CONFIG_GAIT_SENSOR_ACTIVE == 1
+	sample->activity = gait_monitor_finishRead();
+#else
+	sample->activity = BIONICS_ACTIVITY_UNKNOWN;
+#endif
+
+#if CONFIG_DATA_COLLECTOR_POLICY == 1
+	profile = acquisition_policy_update(&policy, sample->activity, start);
+	if(profile != NULL){
+		data_collector_applyProfile(profile);								//applies to this sample, the rate from the next period
+	}
+#endif
+
+#if CONFIG_DATA_COLLECTOR_FEATURES > 0
+	if(sensel_features_update(&features, sample->sensorstrip_data, start, &sample->features) == 0 && summary_only > 0){
+		held_sample = sample;												//only the summaries are published
+		held_handle = handle;
+		return;
+	}
+	sample->summary_only = summary_only;
+#else
+	sample->summary_only = 0;
+#endif
+
+	sensel_deadband_apply(&deadband, sample);								//mark the sensor elements that are reported
+#if CONFIG_DATA_COLLECTOR_EXPOSURE == 1
+	sample->exposure = sensel_exposure_take(&exposure);					//a due snapshot goes with the next published sample
+#else
+	sample->exposure = NULL;
+#endif
+	sample_pool_publish(handle);
+	ESP_LOGD(TAG, "Sample published!");
+}
+
+#if CONFIG_DATA_COLLECTOR_POLICY == 1
+/**
+ * Applies an acquisition profile. The timer is restarted with the new rate, the statistics are kept.
+ */
+void data_collector_applyProfile(const acquisition_profile_t *profile)
+{
+	uint32_t rate_hz = acquisition_policy_getRate(&policy, profile);
+
+	sensel_deadband_setThreshold(&deadband, profile->deadband);
+#if CONFIG_DATA_COLLECTOR_FEATURES > 0
+	summary_only = profile->summary_only;
+#endif
+
+	if(rate_hz != sample_rate_hz){
+		sample_rate_hz = rate_hz;
+		collector_stats.sample_rate_hz = rate_hz;
+		if(timer_running > 0){
+			esp_timer_stop(sampling_timer);
+			if(data_collector_restartTimer() != ESP_OK){
+				ESP_LOGE(TAG, "Can't restart the sampling timer!");
+			}
+		}
+	}
+}
+#endif
+
+#if CONFIG_DATA_COLLECTOR_TIMER_MODE == 1
+/**
+ * Callback of the sampling timer, releases the data collector task.
+ * This runs in the esp_timer task and must not block.
+ */
+void data_collector_timer_callback(void* arg)
+{
+	timer_releases++;
+	xTaskNotify(dataCollectionTask, DATA_COLLECTOR_NOTIFY_SAMPLE, eSetBits);
+}
+
+/**
+ * (Re)starts the sampling timer with the requested rate and resets the statistics.
+ * This is called by the data collector task, or while it is suspended.
+ */
+esp_err_t data_collector_startTimer()
+{
+	base_rate_hz = requested_rate_hz;
+	sample_rate_hz = base_rate_hz;
+#if CONFIG_DATA_COLLECTOR_POLICY == 1
+	policy.base_rate_hz = base_rate_hz;										//the rate of the profiles without their own
+#endif
+	memset(&collector_stats, 0, sizeof(collector_stats));
+	collector_stats.sample_rate_hz = sample_rate_hz;
+	sensel_deadband_reset(&deadband);										//the stream restarts with a keyframe
+#if CONFIG_DATA_COLLECTOR_FEATURES > 0
+	sensel_features_reset(&features);										//no window spans the pause
+#endif
+#if CONFIG_DATA_COLLECTOR_EXPOSURE == 1
+	sensel_exposure_pause(&exposure);										//the pause does not count as exposure
+#endif
+#if CONFIG_DATA_COLLECTOR_POLICY == 1
+	acquisition_policy_reset(&policy);										//the first sample selects the profile
+#endif
+	jitter_sum_us = 0;
+	logged_misses = 0;
+
+	return data_collector_restartTimer();
+}
+
+/**
+ * Applies the rate of data_collector_setSampleRate(), in the data collector task.
+ * While the collection is stopped, the rate is applied when the timer is started again.
+ */
+void data_collector_applyRate()
+{
+	if(timer_running == 0 || requested_rate_hz == base_rate_hz){
+		return;
+	}
+
+	esp_timer_stop(sampling_timer);
+	if(data_collector_startTimer() != ESP_OK){
+		ESP_LOGE(TAG, "Can't restart the sampling timer!");
+	}
+}
+
+/**
+ * Logs the missed deadlines since the last warning, at most once per DATA_COLLECTOR_MISS_LOG_INTERVAL_MS.
+ */
+void data_collector_logMisses(int64_t now)
+{
+	if(collector_stats.missed_deadlines == logged_misses || now - miss_log_us < DATA_COLLECTOR_MISS_LOG_INTERVAL_MS * 1000LL){
+		return;
+	}
+
+	ESP_LOGW(TAG, "Missed %u sampling deadline(s) since the last warning, %u in total",
+			collector_stats.missed_deadlines - logged_misses, collector_stats.missed_deadlines);
+	logged_misses = collector_stats.missed_deadlines;
+	miss_log_us = now;
+}
+
+/**
+ * Starts the sampling timer with the current period, the releases are counted from now on.
+ */
+esp_err_t data_collector_restartTimer()
+{
+	processed_releases = 0;
+	timer_releases = 0;
+	timer_start_us = esp_timer_get_time();
+	timer_running = 1;
+
+	return esp_timer_start_periodic(sampling_timer, 1000000 / sample_rate_hz);
+}
+
+/**
+ * Main task of the data collector (timer mode).
+ * The task blocks until it is released by the sampling timer or receives the stop notification.
  */
 void data_collector_task(void * pvParameters)
 {
-	TickType_t 				xLastWakeTime;
 	uint32_t 				ulNotifiedValue;
-	SocketSense_Sample_t 	sample;
+	uint32_t				release;
+	int64_t					now;
+	int64_t					jitter;
+
+	ESP_LOGI(TAG, "task started on core=%i", xPortGetCoreID());
 
-	struct timeval start;
-	struct timeval stop;
+	while(1){
+
+		xTaskNotifyWait( 0x00, ULONG_MAX, &ulNotifiedValue, portMAX_DELAY);		//wait for the next release
+
+		if((ulNotifiedValue & DATA_COLLECTOR_NOTIFY_STOP) > 0){
+			ESP_LOGI(TAG, "Notification received, suspending...");
+			esp_timer_stop(sampling_timer);
+			timer_running = 0;
+			vTaskSuspend(NULL);													//suspend this task, data_collector_resume() restarts the timer
+			ESP_LOGI(TAG, "Woke up again...");
+			continue;
+		}
+
+		if((ulNotifiedValue & DATA_COLLECTOR_NOTIFY_RATE) > 0){
+			data_collector_applyRate();
+		}
+
+		if((ulNotifiedValue & DATA_COLLECTOR_NOTIFY_SAMPLE) == 0){
+			continue;
+		}
+
+		release = timer_releases;
+		if(release == processed_releases){
+			continue;															//release of the timer before it was restarted
+		}
+		now = esp_timer_get_time();
+		jitter = now - (timer_start_us + (int64_t)release * (1000000 / sample_rate_hz));
+		if(jitter < 0){
+			jitter = 0;
+		}
+
+		if(release - processed_releases > 1){									//releases that arrived while we were busy are skipped
+			collector_stats.missed_deadlines += release - processed_releases - 1;
+		}
+		processed_releases = release;
+		data_collector_logMisses(now);
+
+		data_collector_record();
+
+		jitter_sum_us += (uint64_t)jitter;
+		if((uint32_t)jitter > collector_stats.max_jitter_us){
+			collector_stats.max_jitter_us = (uint32_t)jitter;
+		}
+		collector_stats.avg_jitter_us = (uint32_t)(jitter_sum_us / collector_stats.samples);
+	}
+}
+#else
+/**
+ * Main task of the data collector (periodic mode).
+ */
+void data_collector_task(void * pvParameters)
+{
+	TickType_t 				xLastWakeTime;
+	uint32_t 				ulNotifiedValue;
 
 	ESP_LOGI(TAG, "task started on core=%i", xPortGetCoreID());
 
@@ -144,7 +525,7 @@ void data_collector_task(void * pvParameters)
 	while(1){
 
 		if(xTaskNotifyWait( 0x00, ULONG_MAX, &ulNotifiedValue, 0) == pdTRUE){	//check if a notification has been received
-			if(ulNotifiedValue == DATA_COLLECTOR_NOTIFY_STOP){
+			if((ulNotifiedValue & DATA_COLLECTOR_NOTIFY_STOP) > 0){
 				ESP_LOGI(TAG, "Notification received, suspending...");
 				vTaskSuspend(NULL);												//suspend this task
 				ESP_LOGI(TAG, "Woke up again...");
@@ -152,31 +533,12 @@ void data_collector_task(void * pvParameters)
 			}
 		}
 
-		gettimeofday(&start, NULL);
-		pcf8523_getEspTimestamp(&sample.timestamp_usec);						//get the timestamp for the sample
-
-#if CONFIG_BME280_SENSOR_ACTIVE == 1
-		bme280_readSensorData(&sample.bme280_data);							//read the BME280 data
-#endif
-
-#if CONFIG_SOCKETSENSE_SENSOR_ACTIVE == 1
-		socketsense_sensor_readSensorData(&sample.sensorstrip_data);			//read the sensor elements
-#endif
-		gettimeofday(&stop, NULL);
-
-		sample.sampling_time = (uint32_t)(stop.tv_usec - start.tv_usec);		//collect statistics of the measurement
-		sample.battery_voltage = getBatteryVoltage();							//add the last battery voltage value (in mV)
-
-		if(xQueueSend(data_queue, &sample, (TickType_t) 0) != pdTRUE){
-			ESP_LOGE(TAG, "Message could not be sent!");
-		}else{
-			ESP_LOGI(TAG, "Message sent!");
-		}
-
+		data_collector_record();
 
 		vTaskDelayUntil( &xLastWakeTime, DATA_COLLECTOR_TASK_PERIOD_MS / portTICK_PERIOD_MS );
 	}
 }
+#endif
 
 /**
  * This function is called to start the data collector task
@@ -204,6 +566,12 @@ TaskHandle_t data_collector_getTaskHandle(){
 esp_err_t data_collector_resume(){
 
 	if(dataCollector_initialized > 0){
+#if CONFIG_DATA_COLLECTOR_TIMER_MODE == 1
+		if(timer_running == 0 && data_collector_startTimer() != ESP_OK){		//the task is still suspended
+			ESP_LOGE(TAG, "Can't start the sampling timer!");
+			return ESP_FAIL;
+		}
+#endif
 		vTaskResume(dataCollectionTask);
 	}else{
 		ESP_LOGE(TAG, "Can't resume task, component not initialized!");
@@ -216,7 +584,7 @@ esp_err_t data_collector_resume(){
 esp_err_t data_collector_stop(){
 
 	if(dataCollector_initialized > 0){
-		xTaskNotify(dataCollectionTask, DATA_COLLECTOR_NOTIFY_STOP, eSetValueWithOverwrite);
+		xTaskNotify(dataCollectionTask, DATA_COLLECTOR_NOTIFY_STOP, eSetBits);
 	}else{
 		ESP_LOGE(TAG, "Can't send stop signal, component not initialized!");
 		return ESP_FAIL;
@@ -224,3 +592,63 @@ esp_err_t data_collector_stop(){
 
 	return ESP_OK;
 }
+
+esp_err_t data_collector_setSampleRate(uint32_t rate_hz){
+
+	if(rate_hz < 1 || rate_hz > DATA_COLLECTOR_MAX_SAMPLE_RATE_HZ){
+		ESP_LOGE(TAG, "Sampling rate of %u Hz is out of range!", rate_hz);
+		return ESP_ERR_INVALID_ARG;
+	}
+
+#if CONFIG_DATA_COLLECTOR_TIMER_MODE == 1
+	if(dataCollector_initialized == 0){
+		ESP_LOGE(TAG, "Can't set the sampling rate, component not initialized!");
+		return ESP_FAIL;
+	}
+
+	requested_rate_hz = rate_hz;
+	if(dataCollectionTask != NULL){											//otherwise the timer starts with it
+		xTaskNotify(dataCollectionTask, DATA_COLLECTOR_NOTIFY_RATE, eSetBits);	//the task applies it before its next sample
+	}
+	ESP_LOGI(TAG, "Sampling rate set to %u Hz", rate_hz);
+
+	return ESP_OK;
+#else
+	ESP_LOGE(TAG, "The sampling rate can only be changed in timer mode!");
+	return ESP_FAIL;
+#endif
+}
+
+esp_err_t data_collector_getStatistics(data_collector_stats_t *stats){
+#if CONFIG_GAIT_SENSOR_ACTIVE == 1
+	gait_monitor_stats_t gait;
+#endif
+
+	if(stats == NULL){
+		return ESP_FAIL;
+	}
+
+	memcpy(stats, &collector_stats, sizeof(data_collector_stats_t));
+	stats->sensels_total = deadband.sensels_total;
+	stats->sensels_reported = deadband.sensels_reported;
+	stats->keyframes = deadband.keyframes;
+#if CONFIG_DATA_COLLECTOR_FEATURES > 0
+	stats->feature_summaries = features.summaries;
+	stats->feature_max_cost_ns = features.max_cost_ns;
+	stats->feature_over_budget = features.over_budget;
+#endif
+#if CONFIG_DATA_COLLECTOR_EXPOSURE == 1
+	stats->exposure_snapshots = exposure.snapshots;
+	stats->exposure_delayed = exposure.delayed;
+#endif
+#if CONFIG_GAIT_SENSOR_ACTIVE == 1
+	gait_monitor_getStatistics(&gait);
+	stats->gait_invalid = gait.invalid + gait.failed;
+	stats->gait_max_wait_us = gait.max_wait_us;
+#endif
+#if CONFIG_DATA_COLLECTOR_POLICY == 1
+	stats->policy_transitions = policy.transitions;
+#endif
+
+	return ESP_OK;
+}
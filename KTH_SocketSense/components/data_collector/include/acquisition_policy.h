@@ -0,0 +1,117 @@
+/**
+ * @file acquisition_policy.h
+ * @brief Selects the acquisition profile of the data collector from the activity reported by the gait monitor.
+ *
+ * Sampling at full rate while the subject sits wastes battery, storage and bandwidth, sampling slowly while the
+ * subject walks loses the events of the gait cycle. A profile sets the sampling rate, whether the sensor elements or
+ * only the summaries of the pressure features are reported, and the deadband. The profiles are given as a table; a
+ * profile applies to an activity code if the code contains all bits of its activity (BIONICS_ACTIVITY_* of
+ * gait_monitor.h, which are hierarchical), the first profile that applies is selected. The last profile should have
+ * the activity BIONICS_ACTIVITY_UNKNOWN, which applies to every code.
+ *
+ * The policy is updated with the activity code of every sample. A profile is only considered once
+ * ACQUISITION_POLICY_CONFIRM_CODES consecutive samples ask for it, so a single misclassified code does not change the
+ * profile. A profile with a higher sampling rate, or with the sensor elements when the current one only reports
+ * summaries, is then selected right away, within ACQUISITION_POLICY_CONFIRM_CODES sampling periods of the current
+ * profile. Any other profile has to be asked for during hold_ms first, so a short misclassification during the gait
+ * cycle does not drop the rate; fewer than ACQUISITION_POLICY_CONFIRM_CODES consecutive samples that ask for another
+ * profile do not restart the hold time.
+ *
+ * @date October 17. 2026
+ */
+#ifndef COMPONENTS_ACQUISITION_POLICY_H_
+#define COMPONENTS_ACQUISITION_POLICY_H_
+
+#include <stdint.h>
+
+#define ACQUISITION_POLICY_CONFIRM_CODES	2			//consecutive samples that have to ask for a profile
+
+/**
+ * @brief One acquisition profile.
+ */
+typedef struct {
+	const char	*name;					/**< Name that is logged with the transitions. */
+	uint32_t	activity;				/**< The profile applies to the codes that contain all bits of this activity. */
+	uint32_t	sample_rate_hz;			/**< Sampling rate, 0 for the rate set with data_collector_setSampleRate(). */
+	uint8_t		summary_only;			/**< 1 if only the summaries of the pressure features are reported. */
+	uint16_t	deadband;				/**< Deadband of the sensor elements, see sensel_deadband.h. */
+} acquisition_profile_t;
+
+/**
+ * @brief State of the policy.
+ */
+typedef struct {
+	const acquisition_profile_t	*profiles;		/**< Table of the profiles, in the order they are tried. */
+	uint32_t	count;					/**< Number of profiles. */
+	const acquisition_profile_t	*current;		/**< Selected profile, NULL before the first sample. */
+	const acquisition_profile_t	*candidate;		/**< Profile the samples ask for while it is held back. */
+	int64_t		candidate_since_us;		/**< Time of the first sample that asked for the candidate. */
+	uint32_t	candidate_codes;		/**< Consecutive samples that asked for the candidate. */
+	uint32_t	contrary_codes;			/**< Consecutive samples that asked for another profile than the candidate. */
+	uint32_t	hold_us;				/**< Time a profile that is not selected right away has to be asked for. */
+	uint32_t	base_rate_hz;			/**< Rate of the profiles with sample_rate_hz 0. */
+	uint32_t	transitions;			/**< Number of profile changes. */
+} acquisition_policy_t;
+
+/**
+ * @brief Initializes the policy, the first sample selects its profile right away.
+ *
+ * @param policy The policy.
+ * @param profiles Table of the profiles, has to stay valid.
+ * @param count Number of profiles.
+ * @param hold_ms Time a profile that is not selected right away has to be asked for.
+ * @param base_rate_hz Rate of the profiles with sample_rate_hz 0.
+ */
+void acquisition_policy_init(acquisition_policy_t *policy, const acquisition_profile_t *profiles, uint32_t count,
+		uint32_t hold_ms, uint32_t base_rate_hz);
+
+/**
+ * @brief Initializes the policy with the profiles of the data collector.
+ *
+ * The profiles gait (BIONICS_ACTIVITY_AMBULATING), transfer (CHAIR_EXIT) and mobile (MOBILE) sample at
+ * CONFIG_DATA_COLLECTOR_POLICY_GAIT_RATE_HZ, rest (IMMOBILE) at CONFIG_DATA_COLLECTOR_POLICY_REST_RATE_HZ with the
+ * summaries only (CONFIG_DATA_COLLECTOR_POLICY_REST_SUMMARY) and CONFIG_DATA_COLLECTOR_POLICY_REST_DEADBAND, and
+ * default (every other code) at the base rate with the settings of the data collector without the policy.
+ *
+ * @param policy The policy.
+ * @param hold_ms Time a profile that is not selected right away has to be asked for.
+ * @param base_rate_hz Rate of the default profile.
+ */
+void acquisition_policy_initDefault(acquisition_policy_t *policy, uint32_t hold_ms, uint32_t base_rate_hz);
+
+/**
+ * @brief Starts over, the next sample selects its profile right away (e.g. after the data collection was restarted).
+ *
+ * @param policy The policy.
+ */
+void acquisition_policy_reset(acquisition_policy_t *policy);
+
+/**
+ * @brief Returns the profile that applies to an activity code.
+ *
+ * @param policy The policy.
+ * @param activity The activity code.
+ * @return The first profile that applies, NULL if none does.
+ */
+const acquisition_profile_t* acquisition_policy_match(const acquisition_policy_t *policy, uint32_t activity);
+
+/**
+ * @brief Updates the policy with the activity code of a sample, logs a transition.
+ *
+ * @param policy The policy.
+ * @param activity The activity code of the sample.
+ * @param time_us Time of the sample (esp_timer_get_time()).
+ * @return The new profile if the sample changed the profile, NULL otherwise.
+ */
+const acquisition_profile_t* acquisition_policy_update(acquisition_policy_t *policy, uint32_t activity, int64_t time_us);
+
+/**
+ * @brief Returns the sampling rate of a profile.
+ *
+ * @param policy The policy.
+ * @param profile The profile.
+ * @return The rate of the profile, the base rate if it has none.
+ */
+uint32_t acquisition_policy_getRate(const acquisition_policy_t *policy, const acquisition_profile_t *profile);
+
+#endif /* COMPONENTS_ACQUISITION_POLICY_H_ */
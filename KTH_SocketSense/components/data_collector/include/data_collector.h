@@ -3,11 +3,25 @@
  * @brief Component that reads sensor data from several sensor types and sends them the storage component(s).
  *
  * The component realizes a periodic task that samples all sensor values.
+ * The task is either released by an esp_timer at CONFIG_DATA_COLLECTOR_SAMPLE_RATE_HZ (CONFIG_DATA_COLLECTOR_TIMER_MODE == 1),
+ * or it is paced by the FreeRTOS tick with the period DATA_COLLECTOR_TASK_PERIOD_MS.
  * The sensor values that are sampled are:
  * BME280 (temperature, humidity, atmospheric pressure).
  * Sensor Stripes, based on the MCP3208 8-channel 12-bit ADC
  *
  * Each recorded sample is tagged with the current ESP time in UNIX us format.
+ * With CONFIG_DATA_COLLECTOR_DEADBAND, only the sensor elements that moved beyond the deadband are reported,
+ * plus a keyframe every CONFIG_DATA_COLLECTOR_KEYFRAME_INTERVAL samples (see sensel_deadband.h).
+ * With CONFIG_DATA_COLLECTOR_CALIBRATION, the counts of the sensor elements are converted with per-sensel curves from
+ * the SD-card and compensated for the temperature of the BME280 before that (see sensel_calibration.h).
+ * With CONFIG_DATA_COLLECTOR_FEATURES, the center of pressure, the peak and the load share of the strips are summarized
+ * every CONFIG_DATA_COLLECTOR_FEATURES_INTERVAL_MS, alongside the samples or instead of them (see sensel_features.h).
+ * With CONFIG_DATA_COLLECTOR_EXPOSURE, the pressure exposure of every sensor element is accumulated and a snapshot is
+ * handed to the database component every CONFIG_DATA_COLLECTOR_EXPOSURE_INTERVAL_S (see sensel_exposure.h).
+ * With CONFIG_GAIT_SENSOR_ACTIVE, every sample carries the activity and gait phase code of the gait monitor. It is read
+ * after the sensors with a queued SPI transaction that runs while the sample is processed (see gait_monitor.h).
+ * With CONFIG_DATA_COLLECTOR_POLICY, the sampling rate, the deadband and whether the sensor elements or only the
+ * summaries are reported follow the activity of the subject (see acquisition_policy.h).
  *
  * @author Matthias Becker
  * @date June 12. 2019
@@ -22,9 +36,21 @@
 
 /**
  * @brief The define sets the period in ms of the data collector task, and thus the system sampling frequency.
+ *
+ * This is only used if the timer mode is disabled (CONFIG_DATA_COLLECTOR_TIMER_MODE == 0).
  */
 #define DATA_COLLECTOR_TASK_PERIOD_MS 5000
 
+/**
+ * @brief The highest sampling rate in Hz that can be set in timer mode.
+ */
+#define DATA_COLLECTOR_MAX_SAMPLE_RATE_HZ 1000
+
+/**
+ * @brief Missed sampling deadlines are counted and logged at most once per this interval in ms.
+ */
+#define DATA_COLLECTOR_MISS_LOG_INTERVAL_MS 5000
+
 /**
  * @brief Notification values for the data collector task.
  *
@@ -32,13 +58,51 @@
  * We use this inter-task communication mechanism to signal when the task should suspend itself.
  * See: https://www.freertos.org/RTOS-task-notifications.html
  */
-#define DATA_COLLECTOR_NOTIFY_STOP 	1
+#define DATA_COLLECTOR_NOTIFY_STOP 	(1 << 0)
+
+/**
+ * @brief Notification value that is sent by the sampling timer to release the data collector task (timer mode only).
+ */
+#define DATA_COLLECTOR_NOTIFY_SAMPLE	(1 << 1)
+
+/**
+ * @brief Notification value that asks the data collector task to apply the rate of data_collector_setSampleRate().
+ */
+#define DATA_COLLECTOR_NOTIFY_RATE		(1 << 2)
+
+/**
+ * @brief Timing statistics of the data collector task.
+ *
+ * Release jitter is the delay between the ideal release time of a sample (start of the timer plus n periods)
+ * and the time the task actually started to record it. A deadline is missed if a timer release arrives
+ * while the previous one has not been processed yet; the missed sample is skipped.
+ * In periodic mode only the sample count and the sampling time are recorded.
+ */
+typedef struct {
+	uint32_t	samples;				/**< Number of recorded samples since the last (re)start of the data collection. */
+	uint32_t	missed_deadlines;		/**< Number of timer releases that were skipped because the task was still busy. */
+	uint32_t	max_jitter_us;			/**< Largest release jitter in us. */
+	uint32_t	avg_jitter_us;			/**< Average release jitter in us. */
+	uint32_t	max_sampling_time_us;	/**< Largest time in us it took to record one sample. */
+	uint32_t	sample_rate_hz;			/**< Currently configured sampling rate in Hz (timer mode only). */
+	uint32_t	sensels_total;			/**< Number of sensor elements of all recorded samples. */
+	uint32_t	sensels_reported;		/**< Number of sensor elements that were reported, see CONFIG_DATA_COLLECTOR_DEADBAND. */
+	uint32_t	keyframes;				/**< Number of samples that reported all sensor elements. */
+	uint32_t	feature_summaries;		/**< Number of summary windows, see CONFIG_DATA_COLLECTOR_FEATURES. */
+	uint32_t	feature_max_cost_ns;	/**< Longest feature extraction of a sample in ns. */
+	uint32_t	feature_over_budget;	/**< Number of samples whose feature extraction exceeded CONFIG_DATA_COLLECTOR_FEATURES_BUDGET_US. */
+	uint32_t	exposure_snapshots;		/**< Number of exposure snapshots handed to the database component since the start. */
+	uint32_t	exposure_delayed;		/**< Number of exposure snapshots that were delayed because the previous one was still busy. */
+	uint32_t	gait_invalid;			/**< Number of activity codes of the gait monitor that were not valid or could not be read since the start. */
+	uint32_t	gait_max_wait_us;		/**< Longest time in us the data collector waited for the activity code, see CONFIG_GAIT_SENSOR_ACTIVE. */
+	uint32_t	policy_transitions;		/**< Number of changes of the acquisition profile since the start, see CONFIG_DATA_COLLECTOR_POLICY. */
+} data_collector_stats_t;
 
 /**
  * @brief This function initializes the data collector component.
  *
  * The initialization configures VSPI to be used for the communication with the sensors.
- * All sensors are initialized, and the queue that is used to send data to further components
+ * All sensors are initialized, and the sample pool that is used to pass data to further components
  * is initialized.
  *
  * @return ESP_OK if success, ESP_FAIL otherwise.
@@ -76,4 +140,25 @@ esp_err_t data_collector_resume();
  */
 esp_err_t data_collector_stop();
 
+/**
+ * @brief Change the sampling rate of the timer mode.
+ *
+ * The rate is handed to the data collector task with DATA_COLLECTOR_NOTIFY_RATE, which restarts the timer with the new
+ * period before its next sample and resets the statistics. If the data collection is stopped, it resumes with the new
+ * rate.
+ * With CONFIG_DATA_COLLECTOR_POLICY the rate is used by the profiles without their own rate, the others keep theirs.
+ *
+ * @param rate_hz Sampling rate in Hz (1 to DATA_COLLECTOR_MAX_SAMPLE_RATE_HZ).
+ * @return ESP_OK if success, ESP_ERR_INVALID_ARG if the rate is out of range, ESP_FAIL otherwise.
+ */
+esp_err_t data_collector_setSampleRate(uint32_t rate_hz);
+
+/**
+ * @brief Returns the timing statistics of the data collector task.
+ *
+ * @param stats Destination for the statistics.
+ * @return ESP_OK if success, ESP_FAIL otherwise.
+ */
+esp_err_t data_collector_getStatistics(data_collector_stats_t *stats);
+
 #endif /* COMPONENTS_DATA_COLLECTOR_H_ */
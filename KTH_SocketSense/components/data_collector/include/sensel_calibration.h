@@ -0,0 +1,94 @@
+/**
+ * @file sensel_calibration.h
+ * @brief Per-sensel calibration of the sensor elements with temperature compensation.
+ *
+ * Every sensor element has its own curve from ADC counts to the calibrated unit, piecewise linear with
+ * SENSEL_CALIBRATION_SEGMENTS segments of equal width, so the segment of a value is found with a shift. The drift of
+ * the sensor elements with the temperature measured by the BME280 is compensated with a relative gain and an offset
+ * per degree away from the reference temperature of the calibration:
+ *
+ *   value = curve(counts) * (1 + tc_gain * (T - Tref)) + tc_offset * (T - Tref)
+ *
+ * All of it is done in fixed point, the result is rounded and clamped to 0..4095, so the calibrated values fit into
+ * the 12 bits of the sample frames and the deadband works on them unchanged. The unit is set by the table, 0.1 kPa
+ * covers 0 to 409.5 kPa.
+ *
+ * The tables are loaded from a text file on the SD-card (SENSEL_CALIBRATION_FILE). Empty lines and lines starting with
+ * '#' are ignored, the first other line holds the reference temperature, every following line the curve of one sensor
+ * element:
+ *
+ *   tref <reference temperature in 0.01 degC>
+ *   <strip> <sensel> <tc_gain> <tc_offset> <knot 0> ... <knot SENSEL_CALIBRATION_SEGMENTS>
+ *
+ * Knot i is the calibrated value at i * 4096 / SENSEL_CALIBRATION_SEGMENTS counts, with SENSEL_CALIBRATION_FRACTION_BITS
+ * fractional bits. tc_gain is the relative gain per degC in units of 2^-20, tc_offset the offset per degC with
+ * SENSEL_CALIBRATION_FRACTION_BITS fractional bits. Sensor elements without a line keep their raw counts.
+ *
+ * @date October 17. 2026
+ */
+#ifndef COMPONENTS_SENSEL_CALIBRATION_H_
+#define COMPONENTS_SENSEL_CALIBRATION_H_
+
+#include <stdint.h>
+#include <esp_err.h>
+
+#include "KTHSocketSense.h"
+
+/**
+ * @brief File on the SD-card with the calibration tables.
+ */
+#define SENSEL_CALIBRATION_FILE				"/sdcard/calib.txt"
+
+#define SENSEL_CALIBRATION_SEGMENT_SHIFT	8			//!< log2 of the counts per segment
+#define SENSEL_CALIBRATION_SEGMENTS			(4096 >> SENSEL_CALIBRATION_SEGMENT_SHIFT)
+#define SENSEL_CALIBRATION_KNOTS			(SENSEL_CALIBRATION_SEGMENTS + 1)
+#define SENSEL_CALIBRATION_FRACTION_BITS	8			//!< Fractional bits of the knots and of tc_offset
+#define SENSEL_CALIBRATION_GAIN_BITS		20			//!< Fractional bits of tc_gain
+#define SENSEL_CALIBRATION_MAX_KNOT			(8192 << SENSEL_CALIBRATION_FRACTION_BITS)	//!< Largest magnitude of a knot
+#define SENSEL_CALIBRATION_MAX_TC			65535		//!< Largest magnitude of tc_gain and tc_offset
+#define SENSEL_CALIBRATION_MAX_DELTA_T		64			//!< Temperature differences are clamped to +-64 degC
+
+/**
+ * @brief Calibration of one sensor element.
+ */
+typedef struct {
+	int32_t		knots[SENSEL_CALIBRATION_KNOTS];	/**< Calibrated values at the segment boundaries. */
+	int32_t		tc_gain;							/**< Relative gain per degC in units of 2^-20. */
+	int32_t		tc_offset;							/**< Offset per degC, same fixed point as the knots. */
+} sensel_calibration_curve_t;
+
+/**
+ * @brief Calibration of all sensor elements.
+ */
+typedef struct {
+	sensel_calibration_curve_t	curves[CONFIG_SOCKETSENSE_SENSOR_COUNT][CONFIG_SOCKETSENSE_SENSEL_COUNT];
+	int32_t						tref_centi;			/**< Reference temperature in 0.01 degC. */
+	uint32_t					calibrated;			/**< Number of sensor elements that have been loaded. */
+} sensel_calibration_t;
+
+/**
+ * @brief Initializes the identity calibration, every sensor element keeps its raw counts.
+ */
+void sensel_calibration_init(sensel_calibration_t *calibration);
+
+/**
+ * @brief Loads the calibration tables from a file.
+ *
+ * @param calibration The calibration, sensor elements that are not in the file keep their curves.
+ * @param path Path of the file, usually SENSEL_CALIBRATION_FILE.
+ * @return ESP_OK if success, ESP_ERR_NOT_FOUND if the file does not exist, ESP_FAIL if a line is invalid (the lines
+ *         before it have been loaded).
+ */
+esp_err_t sensel_calibration_load(sensel_calibration_t *calibration, const char *path);
+
+/**
+ * @brief Calibrates the sensor elements of one sample in place.
+ *
+ * @param calibration The calibration.
+ * @param values Raw counts of the sensor elements, replaced with the calibrated values.
+ * @param temperature Temperature in degC at which the values were read.
+ */
+void sensel_calibration_apply(const sensel_calibration_t *calibration,
+		uint16_t values[][CONFIG_SOCKETSENSE_SENSEL_COUNT], float temperature);
+
+#endif /* COMPONENTS_SENSEL_CALIBRATION_H_ */
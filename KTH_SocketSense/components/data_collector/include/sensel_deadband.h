@@ -0,0 +1,65 @@
+/**
+ * @file sensel_deadband.h
+ * @brief Change-only reporting of the sensor elements.
+ *
+ * While the patient sits or stands still, most sensor elements only show ADC noise. The deadband reports a sensor
+ * element only if it moved by more than the threshold since it was reported the last time, the other ones keep their
+ * last reported value. Every interval-th sample is a keyframe that reports all sensor elements, so that the stream can
+ * be reconstructed by holding the last reported value of each sensor element from any keyframe on.
+ *
+ * @date October 17. 2026
+ */
+#ifndef COMPONENTS_SENSEL_DEADBAND_H_
+#define COMPONENTS_SENSEL_DEADBAND_H_
+
+#include <stdint.h>
+
+#include "KTHSocketSense.h"
+
+/**
+ * @brief State of the deadband filter.
+ */
+typedef struct {
+	uint16_t	reported[CONFIG_SOCKETSENSE_SENSOR_COUNT][CONFIG_SOCKETSENSE_SENSEL_COUNT];	/**< Last reported values. */
+	uint16_t	threshold;				/**< Deadband in ADC counts, 0 reports every sensor element. */
+	uint32_t	interval;				/**< Number of samples between keyframes. */
+	uint32_t	countdown;				/**< Samples until the next keyframe, 0 for a keyframe now. */
+	uint32_t	sensels_total;			/**< Number of sensor elements of all filtered samples. */
+	uint32_t	sensels_reported;		/**< Number of sensor elements that have been reported. */
+	uint32_t	keyframes;				/**< Number of keyframes. */
+} sensel_deadband_t;
+
+/**
+ * @brief Initializes the filter, the next sample is a keyframe.
+ *
+ * @param deadband The filter.
+ * @param threshold Deadband in ADC counts.
+ * @param interval Number of samples between keyframes (at least 1).
+ */
+void sensel_deadband_init(sensel_deadband_t *deadband, uint16_t threshold, uint32_t interval);
+
+/**
+ * @brief Forces a keyframe with the next sample and clears the counters, e.g. after the data collection was restarted.
+ */
+void sensel_deadband_reset(sensel_deadband_t *deadband);
+
+/**
+ * @brief Changes the deadband, a change makes the next sample a keyframe.
+ *
+ * @param deadband The filter.
+ * @param threshold Deadband in ADC counts, 0 reports every sensor element.
+ */
+void sensel_deadband_setThreshold(sensel_deadband_t *deadband, uint16_t threshold);
+
+/**
+ * @brief Filters one sample.
+ *
+ * Sets keyframe and sensel_mask of the sample, and replaces the values of the sensor elements that are not reported
+ * with their last reported value.
+ *
+ * @param deadband The filter.
+ * @param sample Sample with the values that have just been read.
+ */
+void sensel_deadband_apply(sensel_deadband_t *deadband, SocketSense_Sample_t *sample);
+
+#endif /* COMPONENTS_SENSEL_DEADBAND_H_ */
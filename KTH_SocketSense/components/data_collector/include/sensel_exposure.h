@@ -0,0 +1,110 @@
+/**
+ * @file sensel_exposure.h
+ * @brief Long-term pressure exposure of every sensor element.
+ *
+ * The risk of tissue damage depends on the load over hours rather than on single samples. The exposure accumulators
+ * are updated with every sample and keep, per sensor element, the pressure-time integral, the time above a threshold
+ * and a histogram of the time spent at each pressure (SOCKETSENSE_EXPOSURE_BINS bins). Their size does not depend on
+ * the recording time. A sample counts for the time since the previous sample (at most SENSEL_EXPOSURE_MAX_GAP_US, the
+ * gap after a pause of the data collection is not counted), in whole ms with the remainder carried to the next sample.
+ *
+ * Every interval the data collector copies the accumulators into a snapshot that is handed to the database component
+ * with the next published sample. The database component hands it to the writer task of the SD-card (sd_logging_request),
+ * which writes it to the SD-card and releases it again. At start the
+ * accumulators are restored from the last snapshot, so they survive a reboot. The snapshot is written to
+ * SENSEL_EXPOSURE_TEMP_FILE first and then renamed, one of the two files always holds a complete snapshot.
+ *
+ * @date October 17. 2026
+ */
+#ifndef COMPONENTS_SENSEL_EXPOSURE_H_
+#define COMPONENTS_SENSEL_EXPOSURE_H_
+
+#include <stdint.h>
+#include <esp_err.h>
+
+#include "KTHSocketSense.h"
+
+#define SENSEL_EXPOSURE_FILE				"/sdcard/exposure.bin"	//!< Last snapshot of the accumulators
+#define SENSEL_EXPOSURE_TEMP_FILE			"/sdcard/exposure.tmp"	//!< Snapshot that is being written
+#define SENSEL_EXPOSURE_MAX_GAP_US			1000000		//!< Longest time a sample counts for (the period at 1 Hz)
+#define SENSEL_EXPOSURE_BIN_SHIFT			9			//!< log2 of the values per histogram bin
+
+/**
+ * @brief State of the exposure accumulators.
+ */
+typedef struct {
+	SocketSense_Exposure_t	live;		/**< Accumulators, updated by the data collector. */
+	SocketSense_Exposure_t	snapshot;	/**< Copy that is handed to the database component. */
+	uint8_t		ready;					/**< 1 if the snapshot waits for the next published sample. */
+	uint8_t		waiting;				/**< 1 if a snapshot is due but the previous one is still busy. */
+	int64_t		last_us;				/**< Time of the previous sample, -1 after a pause. */
+	int64_t		next_snapshot_us;		/**< Time of the next snapshot. */
+	uint32_t	interval_us;			/**< Time between snapshots. */
+	uint32_t	carry_us;				/**< Time that has not been counted yet (less than 1 ms). */
+	uint32_t	snapshots;				/**< Snapshots that were handed over. */
+	uint32_t	delayed;				/**< Snapshots that were due while the previous one was still busy. */
+} sensel_exposure_t;
+
+/**
+ * @brief Initializes the accumulators to zero.
+ *
+ * @param exposure The accumulators.
+ * @param threshold Value above which a sensor element counts as loaded.
+ * @param interval_s Time between snapshots in s.
+ */
+void sensel_exposure_init(sensel_exposure_t *exposure, uint16_t threshold, uint32_t interval_s);
+
+/**
+ * @brief Restores the accumulators from a snapshot on the SD-card.
+ *
+ * If the snapshot was taken with another threshold, the times above the threshold start from zero.
+ *
+ * @param exposure The accumulators, initialized with sensel_exposure_init().
+ * @param path Snapshot file.
+ * @return ESP_OK if success, ESP_ERR_NOT_FOUND if the file does not exist, ESP_FAIL if it is invalid or was written
+ * for another number of sensor elements (the accumulators are unchanged then).
+ */
+esp_err_t sensel_exposure_load(sensel_exposure_t *exposure, const char *path);
+
+/**
+ * @brief Does not count the time until the next sample, e.g. when the data collection was stopped.
+ */
+void sensel_exposure_pause(sensel_exposure_t *exposure);
+
+/**
+ * @brief Adds one sample to the accumulators and copies them into the snapshot when it is due.
+ *
+ * @param exposure The accumulators.
+ * @param values The sensor elements of the sample.
+ * @param time_us Time of the sample in us (esp_timer).
+ * @param timestamp_usec UNIX timestamp of the sample in us.
+ */
+void sensel_exposure_update(sensel_exposure_t *exposure, const uint16_t values[][CONFIG_SOCKETSENSE_SENSEL_COUNT],
+		int64_t time_us, uint64_t timestamp_usec);
+
+/**
+ * @brief Hands the snapshot over to the database component, called before a sample is published.
+ *
+ * @param exposure The accumulators.
+ * @return The snapshot if one is ready, NULL otherwise. It is busy until sensel_exposure_release() is called.
+ */
+SocketSense_Exposure_t* sensel_exposure_take(sensel_exposure_t *exposure);
+
+/**
+ * @brief Writes a snapshot to the SD-card (writer task of the SD-card).
+ *
+ * The snapshot is written to temp_path and renamed to path once it is complete.
+ *
+ * @param snapshot The snapshot.
+ * @param path Snapshot file.
+ * @param temp_path File the snapshot is written to first.
+ * @return ESP_OK if success, ESP_FAIL otherwise.
+ */
+esp_err_t sensel_exposure_save(const SocketSense_Exposure_t *snapshot, const char *path, const char *temp_path);
+
+/**
+ * @brief Returns a snapshot to the data collector (writer task of the SD-card).
+ */
+void sensel_exposure_release(SocketSense_Exposure_t *snapshot);
+
+#endif /* COMPONENTS_SENSEL_EXPOSURE_H_ */
@@ -0,0 +1,82 @@
+/**
+ * @file sensel_features.h
+ * @brief Incremental extraction of pressure features from the sensor elements.
+ *
+ * Clinicians look at the center of pressure, the peak pressure and the distribution of the load over the sensor strips
+ * rather than at the raw matrices. The feature extraction runs on every sample right after the sensor elements were
+ * read (and calibrated) and adds it to integer accumulators: the load of every strip, the moment along the strips and
+ * the peak. When a window of interval_ms is over, the summary is computed from the accumulators, also in integers,
+ * and attached to the first sample after the window:
+ *
+ *   mean_load  = sum(load) / samples
+ *   cop_strip  = sum(strip * load of strip) / sum(load)
+ *   cop_sensel = sum(sensel * value) / sum(load)
+ *   load_share = load of strip / sum(load)
+ *
+ * The center of pressure and the load shares are weighted by the load over the whole window, which is the center of
+ * the pressure-time integral of the window.
+ *
+ * Every update measures its own duration with the cycle counter of the CPU, an update takes a few hundred ns and
+ * esp_timer only resolves 1 us. The summary holds the mean and the longest duration of the window in ns, and updates
+ * that took longer than the budget are counted.
+ *
+ * @date October 17. 2026
+ */
+#ifndef COMPONENTS_SENSEL_FEATURES_H_
+#define COMPONENTS_SENSEL_FEATURES_H_
+
+#include <stdint.h>
+
+#include "KTHSocketSense.h"
+
+/**
+ * @brief State of the feature extraction.
+ */
+typedef struct {
+	uint64_t	strip_load[CONFIG_SOCKETSENSE_SENSOR_COUNT];	/**< Sum of the sensor elements of each strip over the window. */
+	uint64_t	sensel_moment;			/**< Sum of sensel index times value over the window. */
+	uint32_t	samples;				/**< Samples of the current window. */
+	uint16_t	peak;					/**< Largest value of the current window. */
+	uint16_t	peak_index;				/**< strip * CONFIG_SOCKETSENSE_SENSEL_COUNT + sensel of the peak. */
+	int64_t		window_start_us;		/**< Time of the first sample of the window, -1 before the first sample. */
+	uint32_t	interval_us;			/**< Length of a window. */
+	uint32_t	budget_ns;				/**< Time an update may take. */
+	uint32_t	cpu_mhz;				/**< Clock of the CPU, converts the cycle counts into ns. */
+	uint64_t	cost_sum_ns;			/**< Duration of the updates of the current window. */
+	uint32_t	cost_max_ns;			/**< Longest update of the current window. */
+	uint32_t	max_cost_ns;			/**< Longest update since the last reset. */
+	uint32_t	over_budget;			/**< Updates since the last reset that took longer than budget_ns. */
+	uint32_t	summaries;				/**< Windows since the last reset. */
+} sensel_features_t;
+
+/**
+ * @brief Initializes the feature extraction, the next sample starts a window.
+ *
+ * @param features The feature extraction.
+ * @param interval_ms Length of a summary window in ms.
+ * @param budget_us Time in us an update may take.
+ */
+void sensel_features_init(sensel_features_t *features, uint32_t interval_ms, uint32_t budget_us);
+
+/**
+ * @brief Drops the current window and clears the counters, e.g. after the data collection was restarted.
+ */
+void sensel_features_reset(sensel_features_t *features);
+
+/**
+ * @brief Adds one sample to the current window.
+ *
+ * If interval_ms passed since the start of the current window, the summary of the window (without this sample) is
+ * written to summary and the sample starts the next window. The windows start every interval_ms from the first
+ * sample on, after a gap the next window starts with the sample after the gap.
+ *
+ * @param features The feature extraction.
+ * @param values The sensor elements of the sample.
+ * @param time_us Time of the sample in us (esp_timer).
+ * @param summary Destination for the summary, its samples field is set to 0 if the window goes on.
+ * @return 1 if the summary of a window was written, 0 otherwise.
+ */
+uint8_t sensel_features_update(sensel_features_t *features, const uint16_t values[][CONFIG_SOCKETSENSE_SENSEL_COUNT],
+		int64_t time_us, SocketSense_Features_t *summary);
+
+#endif /* COMPONENTS_SENSEL_FEATURES_H_ */
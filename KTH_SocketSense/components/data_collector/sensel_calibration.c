@@ -0,0 +1,160 @@
+/**
+ * @file sensel_calibration.c
+ * @brief Per-sensel calibration of the sensor elements with temperature compensation.
+ *
+ * @date October 17. 2026
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+
+#include "sensel_calibration.h"
+
+#define SENSEL_CALIBRATION_SENSELS (CONFIG_SOCKETSENSE_SENSOR_COUNT * CONFIG_SOCKETSENSE_SENSEL_COUNT)
+#define SENSEL_CALIBRATION_ROUND (1 << (SENSEL_CALIBRATION_FRACTION_BITS - 1))
+#define SENSEL_CALIBRATION_FULL_SCALE 4095
+
+static const char *TAG = "SENSEL_CALIBRATION";
+
+/*****Private Functions Definitions*************************************************/
+
+uint8_t sensel_calibration_parseLine(sensel_calibration_t *calibration, char *line);
+
+/*****Public Functions**************************************************************/
+
+void sensel_calibration_init(sensel_calibration_t *calibration)
+{
+	sensel_calibration_curve_t *curve = &calibration->curves[0][0];
+	uint32_t i;
+	uint32_t k;
+
+	memset(calibration, 0, sizeof(sensel_calibration_t));
+	calibration->tref_centi = 2500;
+	for(i = 0; i < SENSEL_CALIBRATION_SENSELS; i++){
+		for(k = 0; k < SENSEL_CALIBRATION_KNOTS; k++){
+			curve[i].knots[k] = (int32_t)(k << SENSEL_CALIBRATION_SEGMENT_SHIFT) << SENSEL_CALIBRATION_FRACTION_BITS;
+		}
+	}
+}
+
+esp_err_t sensel_calibration_load(sensel_calibration_t *calibration, const char *path)
+{
+	char line[256];
+	uint32_t number = 0;
+	uint8_t tref = 0;
+	FILE *f;
+
+	f = fopen(path, "r");
+	if(f == NULL){
+		return ESP_ERR_NOT_FOUND;
+	}
+
+	while(fgets(line, sizeof(line), f) != NULL){
+		number++;
+		line[strcspn(line, "\r\n")] = '\0';
+		if(line[strspn(line, " \t")] == '\0' || line[strspn(line, " \t")] == '#'){
+			continue;
+		}
+		if(tref == 0){
+			if(sscanf(line, " tref %d", &calibration->tref_centi) != 1){
+				ESP_LOGE(TAG, "%s:%u: the first line must be 'tref <0.01 degC>'", path, number);
+				fclose(f);
+				return ESP_FAIL;
+			}
+			tref = 1;
+			continue;
+		}
+		if(sensel_calibration_parseLine(calibration, line) == 0){
+			ESP_LOGE(TAG, "%s:%u: invalid calibration", path, number);
+			fclose(f);
+			return ESP_FAIL;
+		}
+	}
+	fclose(f);
+
+	ESP_LOGI(TAG, "%u of %u sensor elements calibrated, reference temperature %d.%02d degC", calibration->calibrated,
+			SENSEL_CALIBRATION_SENSELS, calibration->tref_centi / 100, abs(calibration->tref_centi % 100));
+
+	return ESP_OK;
+}
+
+void sensel_calibration_apply(const sensel_calibration_t *calibration,
+		uint16_t values[][CONFIG_SOCKETSENSE_SENSEL_COUNT], float temperature)
+{
+	const sensel_calibration_curve_t *curve = &calibration->curves[0][0];
+	uint16_t *value = &values[0][0];
+	float delta = temperature - calibration->tref_centi / 100.0f;
+	int32_t delta_t;											//temperature difference in 1/256 degC
+	int32_t counts;
+	int32_t segment;
+	int32_t fraction;
+	int32_t y;
+	uint32_t i;
+
+	if(delta != delta){											//no temperature, no compensation
+		delta = 0.0f;
+	}else if(delta > SENSEL_CALIBRATION_MAX_DELTA_T){
+		delta = SENSEL_CALIBRATION_MAX_DELTA_T;
+	}else if(delta < -SENSEL_CALIBRATION_MAX_DELTA_T){
+		delta = -SENSEL_CALIBRATION_MAX_DELTA_T;
+	}
+	delta_t = (int32_t)(delta * 256.0f + (delta < 0.0f ? -0.5f : 0.5f));
+
+	for(i = 0; i < SENSEL_CALIBRATION_SENSELS; i++, curve++){
+		counts = value[i] <= SENSEL_CALIBRATION_FULL_SCALE ? value[i] : SENSEL_CALIBRATION_FULL_SCALE;
+		segment = counts >> SENSEL_CALIBRATION_SEGMENT_SHIFT;
+		fraction = counts & ((1 << SENSEL_CALIBRATION_SEGMENT_SHIFT) - 1);
+		y = curve->knots[segment]
+				+ (((curve->knots[segment + 1] - curve->knots[segment]) * fraction) >> SENSEL_CALIBRATION_SEGMENT_SHIFT);
+
+		y += (int32_t)(((int64_t) y * (curve->tc_gain * delta_t)) >> (SENSEL_CALIBRATION_GAIN_BITS + 8));
+		y += (curve->tc_offset * delta_t) >> 8;
+
+		y = (y + SENSEL_CALIBRATION_ROUND) >> SENSEL_CALIBRATION_FRACTION_BITS;
+		value[i] = (uint16_t)(y < 0 ? 0 : (y > SENSEL_CALIBRATION_FULL_SCALE ? SENSEL_CALIBRATION_FULL_SCALE : y));
+	}
+}
+
+/*****Private Functions*************************************************************/
+
+/**
+ * Parses the curve of one sensor element, returns 0 if the line is invalid.
+ */
+uint8_t sensel_calibration_parseLine(sensel_calibration_t *calibration, char *line)
+{
+	sensel_calibration_curve_t curve;
+	long fields[4 + SENSEL_CALIBRATION_KNOTS];
+	char *pos = line;
+	char *end;
+	uint32_t i;
+
+	for(i = 0; i < sizeof(fields) / sizeof(fields[0]); i++){
+		fields[i] = strtol(pos, &end, 10);
+		if(end == pos){
+			return 0;
+		}
+		pos = end;
+	}
+	if(pos[strspn(pos, " \t")] != '\0'
+			|| fields[0] < 0 || fields[0] >= CONFIG_SOCKETSENSE_SENSOR_COUNT
+			|| fields[1] < 0 || fields[1] >= CONFIG_SOCKETSENSE_SENSEL_COUNT
+			|| labs(fields[2]) > SENSEL_CALIBRATION_MAX_TC || labs(fields[3]) > SENSEL_CALIBRATION_MAX_TC){
+		return 0;
+	}
+
+	curve.tc_gain = (int32_t) fields[2];
+	curve.tc_offset = (int32_t) fields[3];
+	for(i = 0; i < SENSEL_CALIBRATION_KNOTS; i++){
+		if(labs(fields[4 + i]) > SENSEL_CALIBRATION_MAX_KNOT){					//keeps the interpolation within 32 bits
+			return 0;
+		}
+		curve.knots[i] = (int32_t) fields[4 + i];
+	}
+
+	calibration->curves[fields[0]][fields[1]] = curve;
+	calibration->calibrated++;
+
+	return 1;
+}
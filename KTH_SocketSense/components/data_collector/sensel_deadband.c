@@ -0,0 +1,70 @@
+/**
+ * @file sensel_deadband.c
+ * @brief Change-only reporting of the sensor elements.
+ *
+ * @date October 17. 2026
+ */
+#include <string.h>
+
+#include "sensel_deadband.h"
+
+#define SENSEL_DEADBAND_SENSELS (CONFIG_SOCKETSENSE_SENSOR_COUNT * CONFIG_SOCKETSENSE_SENSEL_COUNT)
+
+void sensel_deadband_init(sensel_deadband_t *deadband, uint16_t threshold, uint32_t interval)
+{
+	memset(deadband, 0, sizeof(sensel_deadband_t));
+	deadband->threshold = threshold;
+	deadband->interval = interval > 0 ? interval : 1;
+}
+
+void sensel_deadband_reset(sensel_deadband_t *deadband)
+{
+	deadband->countdown = 0;
+	deadband->sensels_total = 0;
+	deadband->sensels_reported = 0;
+	deadband->keyframes = 0;
+}
+
+void sensel_deadband_setThreshold(sensel_deadband_t *deadband, uint16_t threshold)
+{
+	if(threshold != deadband->threshold){
+		deadband->threshold = threshold;
+		deadband->countdown = 0;													//the receivers start over from a keyframe
+	}
+}
+
+void sensel_deadband_apply(sensel_deadband_t *deadband, SocketSense_Sample_t *sample)
+{
+	uint16_t *values = &sample->sensorstrip_data[0][0];
+	uint16_t *reported = &deadband->reported[0][0];
+	uint32_t reported_count = 0;
+	uint32_t i;
+	int32_t change;
+
+	deadband->sensels_total += SENSEL_DEADBAND_SENSELS;
+
+	if(deadband->countdown == 0 || deadband->threshold == 0){						//keyframe, everything is reported
+		memcpy(reported, values, sizeof(deadband->reported));
+		memset(sample->sensel_mask, 0xFF, sizeof(sample->sensel_mask));
+		sample->keyframe = 1;
+		deadband->sensels_reported += SENSEL_DEADBAND_SENSELS;
+		deadband->keyframes++;
+		deadband->countdown = deadband->interval - 1;
+		return;
+	}
+	deadband->countdown--;
+
+	memset(sample->sensel_mask, 0, sizeof(sample->sensel_mask));
+	for(i = 0; i < SENSEL_DEADBAND_SENSELS; i++){
+		change = (int32_t) values[i] - reported[i];
+		if(change > deadband->threshold || change < -(int32_t) deadband->threshold){
+			reported[i] = values[i];
+			sample->sensel_mask[i >> 3] |= (uint8_t)(1 << (i & 7));
+			reported_count++;
+		}else{
+			values[i] = reported[i];												//hold the last reported value
+		}
+	}
+	sample->keyframe = 0;
+	deadband->sensels_reported += reported_count;
+}
@@ -0,0 +1,248 @@
+/**
+ * @file sensel_exposure.c
+ * @brief Long-term pressure exposure of every sensor element.
+ *
+ * The snapshot file starts with a header that identifies the layout, followed by the accumulators as they are in
+ * memory up to the busy flag; the header holds a FNV-1a checksum of them.
+ *
+ * @date October 17. 2026
+ */
+#include <stddef.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "esp_log.h"
+
+#include "sensel_exposure.h"
+
+static const char *TAG = "SENSEL_EXPOSURE";
+
+#define SENSEL_EXPOSURE_MAGIC		0x58455353							//"SSEX"
+#define SENSEL_EXPOSURE_VERSION		1
+#define SENSEL_EXPOSURE_PAYLOAD		offsetof(SocketSense_Exposure_t, busy)
+
+/**
+ * Header of the snapshot file.
+ */
+typedef struct {
+	uint32_t	magic;
+	uint16_t	version;
+	uint8_t		sensor_count;
+	uint8_t		sensel_count;
+	uint8_t		bins;
+	uint8_t		reserved[3];
+	uint32_t	size;					//size of the accumulators
+	uint32_t	checksum;				//FNV-1a of the accumulators
+} sensel_exposure_header_t;
+
+static SocketSense_Exposure_t loaded;	//the snapshot is checked before it replaces the accumulators
+
+/*****Private Functions Definitions*************************************************/
+
+void sensel_exposure_header(sensel_exposure_header_t *header, const SocketSense_Exposure_t *accumulators);
+uint32_t sensel_exposure_checksum(const void *data, size_t size);
+
+/*****Public Functions**************************************************************/
+
+void sensel_exposure_init(sensel_exposure_t *exposure, uint16_t threshold, uint32_t interval_s)
+{
+	memset(exposure, 0, sizeof(sensel_exposure_t));
+	exposure->live.threshold = threshold;
+	exposure->interval_us = (interval_s > 0 ? interval_s : 1) * 1000000;
+	exposure->last_us = -1;
+	exposure->next_snapshot_us = -1;
+}
+
+esp_err_t sensel_exposure_load(sensel_exposure_t *exposure, const char *path)
+{
+	sensel_exposure_header_t header;
+	sensel_exposure_header_t expected;
+	FILE *f;
+	size_t read;
+
+	f = fopen(path, "rb");
+	if(f == NULL){
+		return ESP_ERR_NOT_FOUND;
+	}
+	read = fread(&header, 1, sizeof(header), f);
+	if(read == sizeof(header)){
+		read = fread(&loaded, 1, SENSEL_EXPOSURE_PAYLOAD, f);
+	}
+	fclose(f);
+
+	sensel_exposure_header(&expected, &loaded);
+	if(read != SENSEL_EXPOSURE_PAYLOAD || header.magic != expected.magic || header.version != expected.version
+			|| header.sensor_count != expected.sensor_count || header.sensel_count != expected.sensel_count
+			|| header.bins != expected.bins || header.size != expected.size || header.checksum != expected.checksum){
+		ESP_LOGE(TAG, "%s is not a snapshot of %ix%i sensor elements", path, CONFIG_SOCKETSENSE_SENSOR_COUNT,
+				CONFIG_SOCKETSENSE_SENSEL_COUNT);
+		return ESP_FAIL;
+	}
+
+	if(loaded.threshold != exposure->live.threshold){
+		ESP_LOGW(TAG, "The threshold changed from %u to %u, the time above it starts from zero", loaded.threshold,
+				exposure->live.threshold);
+		memset(loaded.above_ms, 0, sizeof(loaded.above_ms));
+		loaded.threshold = exposure->live.threshold;
+	}
+	loaded.busy = 0;
+	memcpy(&exposure->live, &loaded, sizeof(SocketSense_Exposure_t));
+
+	ESP_LOGI(TAG, "Restored %" PRIu64 " s of exposure from %s", exposure->live.duration_ms / 1000, path);
+
+	return ESP_OK;
+}
+
+void sensel_exposure_pause(sensel_exposure_t *exposure)
+{
+	exposure->last_us = -1;
+}
+
+void sensel_exposure_update(sensel_exposure_t *exposure, const uint16_t values[][CONFIG_SOCKETSENSE_SENSEL_COUNT],
+		int64_t time_us, uint64_t timestamp_usec)
+{
+	SocketSense_Exposure_t *live = &exposure->live;
+	const uint16_t threshold = live->threshold;
+	uint32_t elapsed_us = 0;
+	uint32_t ms;
+	uint16_t value;
+	uint32_t bin;
+	uint32_t sensor_id;
+	uint32_t sensel_id;
+
+	if(exposure->last_us >= 0){
+		elapsed_us = time_us - exposure->last_us > SENSEL_EXPOSURE_MAX_GAP_US ? SENSEL_EXPOSURE_MAX_GAP_US
+				: (uint32_t)(time_us - exposure->last_us);
+	}
+	exposure->last_us = time_us;
+	if(live->start_usec == 0){
+		live->start_usec = timestamp_usec;
+	}
+	live->timestamp_usec = timestamp_usec;
+
+	ms = (exposure->carry_us + elapsed_us) / 1000;
+	exposure->carry_us = (exposure->carry_us + elapsed_us) % 1000;
+
+	if(ms > 0){
+		live->duration_ms += ms;
+		for(sensor_id = 0; sensor_id < CONFIG_SOCKETSENSE_SENSOR_COUNT; sensor_id++){
+			for(sensel_id = 0; sensel_id < CONFIG_SOCKETSENSE_SENSEL_COUNT; sensel_id++){
+				value = values[sensor_id][sensel_id];
+				live->integral[sensor_id][sensel_id] += (uint64_t) value * ms;
+				if(value > threshold){
+					live->above_ms[sensor_id][sensel_id] += ms;
+				}
+				bin = value < 4096 ? value >> SENSEL_EXPOSURE_BIN_SHIFT : SOCKETSENSE_EXPOSURE_BINS - 1;
+				if(live->histogram[sensor_id][sensel_id][bin] <= UINT32_MAX - ms){
+					live->histogram[sensor_id][sensel_id][bin] += ms;
+				}
+			}
+		}
+	}
+
+	if(exposure->next_snapshot_us < 0){
+		exposure->next_snapshot_us = time_us + exposure->interval_us;
+	}
+	if(time_us < exposure->next_snapshot_us){
+		return;
+	}
+	if(__atomic_load_n(&exposure->snapshot.busy, __ATOMIC_ACQUIRE) != 0){	//tried again with the next sample
+		if(exposure->waiting == 0){
+			exposure->waiting = 1;
+			exposure->delayed++;
+		}
+		return;
+	}
+	memcpy(&exposure->snapshot, live, sizeof(SocketSense_Exposure_t));
+	exposure->ready = 1;
+	exposure->waiting = 0;
+	exposure->next_snapshot_us += exposure->interval_us;
+	if(exposure->next_snapshot_us <= time_us){								//no burst of snapshots after a pause
+		exposure->next_snapshot_us = time_us + exposure->interval_us;
+	}
+}
+
+SocketSense_Exposure_t* sensel_exposure_take(sensel_exposure_t *exposure)
+{
+	if(exposure->ready == 0){
+		return NULL;
+	}
+
+	exposure->ready = 0;
+	exposure->snapshot.busy = 1;											//published together with the sample
+	exposure->snapshots++;
+
+	return &exposure->snapshot;
+}
+
+esp_err_t sensel_exposure_save(const SocketSense_Exposure_t *snapshot, const char *path, const char *temp_path)
+{
+	sensel_exposure_header_t header;
+	FILE *f;
+	size_t written;
+
+	sensel_exposure_header(&header, snapshot);
+
+	f = fopen(temp_path, "wb");
+	if(f == NULL){
+		ESP_LOGE(TAG, "Failed to open %s", temp_path);
+		return ESP_FAIL;
+	}
+	written = fwrite(&header, 1, sizeof(header), f);
+	written += fwrite(snapshot, 1, SENSEL_EXPOSURE_PAYLOAD, f);
+	fflush(f);
+	fsync(fileno(f));
+	fclose(f);
+	if(written != sizeof(header) + SENSEL_EXPOSURE_PAYLOAD){
+		ESP_LOGE(TAG, "Failed to write %s", temp_path);
+		return ESP_FAIL;
+	}
+
+	unlink(path);															//FAT can't rename onto an existing file
+	if(rename(temp_path, path) != 0){
+		ESP_LOGE(TAG, "Failed to rename %s to %s", temp_path, path);
+		return ESP_FAIL;
+	}
+
+	return ESP_OK;
+}
+
+void sensel_exposure_release(SocketSense_Exposure_t *snapshot)
+{
+	__atomic_store_n(&snapshot->busy, 0, __ATOMIC_RELEASE);
+}
+
+/*****Private Functions*************************************************************/
+
+/**
+ * Fills in the header of a snapshot.
+ */
+void sensel_exposure_header(sensel_exposure_header_t *header, const SocketSense_Exposure_t *accumulators)
+{
+	memset(header, 0, sizeof(sensel_exposure_header_t));
+	header->magic = SENSEL_EXPOSURE_MAGIC;
+	header->version = SENSEL_EXPOSURE_VERSION;
+	header->sensor_count = CONFIG_SOCKETSENSE_SENSOR_COUNT;
+	header->sensel_count = CONFIG_SOCKETSENSE_SENSEL_COUNT;
+	header->bins = SOCKETSENSE_EXPOSURE_BINS;
+	header->size = SENSEL_EXPOSURE_PAYLOAD;
+	header->checksum = sensel_exposure_checksum(accumulators, SENSEL_EXPOSURE_PAYLOAD);
+}
+
+/**
+ * FNV-1a hash of a block of memory.
+ */
+uint32_t sensel_exposure_checksum(const void *data, size_t size)
+{
+	const uint8_t *bytes = data;
+	uint32_t hash = 2166136261U;
+	size_t i;
+
+	for(i = 0; i < size; i++){
+		hash = (hash ^ bytes[i]) * 16777619U;
+	}
+
+	return hash;
+}
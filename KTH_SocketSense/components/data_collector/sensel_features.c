@@ -0,0 +1,158 @@
+/**
+ * @file sensel_features.c
+ * @brief Incremental extraction of pressure features from the sensor elements.
+ *
+ * A sample only touches every sensor element once; the divisions are left to the end of the window.
+ *
+ * @date October 17. 2026
+ */
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_clk.h"
+#include "xtensa/hal.h"
+
+#include "sensel_features.h"
+
+static const char *TAG = "SENSEL_FEATURES";
+
+/*****Private Functions Definitions*************************************************/
+
+void sensel_features_summarize(sensel_features_t *features, SocketSense_Features_t *summary);
+void sensel_features_clearWindow(sensel_features_t *features);
+
+/*****Public Functions**************************************************************/
+
+void sensel_features_init(sensel_features_t *features, uint32_t interval_ms, uint32_t budget_us)
+{
+	memset(features, 0, sizeof(sensel_features_t));
+	features->interval_us = (interval_ms > 0 ? interval_ms : 1) * 1000;
+	features->budget_ns = budget_us * 1000;
+	features->cpu_mhz = (uint32_t)(esp_clk_cpu_freq() / 1000000);
+	features->window_start_us = -1;
+}
+
+void sensel_features_reset(sensel_features_t *features)
+{
+	sensel_features_clearWindow(features);
+	features->window_start_us = -1;
+	features->max_cost_ns = 0;
+	features->over_budget = 0;
+	features->summaries = 0;
+}
+
+uint8_t sensel_features_update(sensel_features_t *features, const uint16_t values[][CONFIG_SOCKETSENSE_SENSEL_COUNT],
+		int64_t time_us, SocketSense_Features_t *summary)
+{
+	uint32_t start;
+	uint32_t cost;
+	uint32_t strip_load;
+	uint32_t sensel_moment = 0;
+	uint16_t peak = features->peak;
+	uint16_t peak_index = features->peak_index;
+	uint16_t value;
+	uint8_t ended = 0;
+	uint32_t sensor_id;
+	uint32_t sensel_id;
+
+	start = xthal_get_ccount();
+
+	if(features->window_start_us >= 0 && time_us - features->window_start_us >= (int64_t) features->interval_us){
+		sensel_features_summarize(features, summary);
+		sensel_features_clearWindow(features);
+		features->window_start_us += features->interval_us;				//the windows stay on their grid
+		if(time_us - features->window_start_us >= (int64_t) features->interval_us){
+			features->window_start_us = time_us;							//unless samples were missing for a window
+		}
+		peak = 0;
+		peak_index = 0;
+		ended = 1;
+	}else{
+		summary->samples = 0;
+	}
+
+	for(sensor_id = 0; sensor_id < CONFIG_SOCKETSENSE_SENSOR_COUNT; sensor_id++){
+		strip_load = 0;
+		for(sensel_id = 0; sensel_id < CONFIG_SOCKETSENSE_SENSEL_COUNT; sensel_id++){
+			value = values[sensor_id][sensel_id];
+			strip_load += value;
+			sensel_moment += value * sensel_id;
+			if(value > peak){
+				peak = value;
+				peak_index = (uint16_t)(sensor_id * CONFIG_SOCKETSENSE_SENSEL_COUNT + sensel_id);
+			}
+		}
+		features->strip_load[sensor_id] += strip_load;
+	}
+	features->sensel_moment += sensel_moment;
+	features->peak = peak;
+	features->peak_index = peak_index;
+	features->samples++;
+	if(features->window_start_us < 0){
+		features->window_start_us = time_us;
+	}
+
+	cost = (uint32_t)((uint64_t)(xthal_get_ccount() - start) * 1000 / features->cpu_mhz);	//the counter may wrap once
+	features->cost_sum_ns += cost;
+	if(cost > features->cost_max_ns){
+		features->cost_max_ns = cost;
+	}
+	if(cost > features->budget_ns){
+		features->over_budget++;
+	}
+
+	return ended;
+}
+
+/*****Private Functions*************************************************************/
+
+/**
+ * Computes the summary of the current window.
+ */
+void sensel_features_summarize(sensel_features_t *features, SocketSense_Features_t *summary)
+{
+	uint64_t total = 0;
+	uint64_t strip_moment = 0;
+	uint32_t sensor_id;
+
+	for(sensor_id = 0; sensor_id < CONFIG_SOCKETSENSE_SENSOR_COUNT; sensor_id++){
+		total += features->strip_load[sensor_id];
+		strip_moment += features->strip_load[sensor_id] * sensor_id;
+	}
+
+	summary->samples = features->samples;
+	summary->mean_load = (uint32_t)(total / features->samples);
+	summary->peak = features->peak;
+	summary->peak_strip = (uint8_t)(features->peak_index / CONFIG_SOCKETSENSE_SENSEL_COUNT);
+	summary->peak_sensel = (uint8_t)(features->peak_index % CONFIG_SOCKETSENSE_SENSEL_COUNT);
+	for(sensor_id = 0; sensor_id < CONFIG_SOCKETSENSE_SENSOR_COUNT; sensor_id++){
+		summary->load_share[sensor_id] = total > 0 ? (uint16_t)(features->strip_load[sensor_id] * 10000 / total) : 0;
+	}
+	summary->cop_strip = total > 0 ? (uint16_t)((strip_moment << 8) / total) : 0;				//the window is unloaded
+	summary->cop_sensel = total > 0 ? (uint16_t)((features->sensel_moment << 8) / total) : 0;
+	summary->cost_avg_ns = (uint32_t)(features->cost_sum_ns / features->samples);
+	summary->cost_max_ns = features->cost_max_ns;
+
+	features->summaries++;
+	if(features->cost_max_ns > features->max_cost_ns){
+		features->max_cost_ns = features->cost_max_ns;
+	}
+	if(features->cost_max_ns > features->budget_ns){
+		ESP_LOGW(TAG, "Feature extraction took up to %u nsec (mean %u nsec), the budget is %u nsec",
+				features->cost_max_ns, summary->cost_avg_ns, features->budget_ns);
+	}
+}
+
+/**
+ * Clears the accumulators of the current window.
+ */
+void sensel_features_clearWindow(sensel_features_t *features)
+{
+	memset(features->strip_load, 0, sizeof(features->strip_load));
+	features->sensel_moment = 0;
+	features->samples = 0;
+	features->peak = 0;
+	features->peak_index = 0;
+	features->cost_sum_ns = 0;
+	features->cost_max_ns = 0;
+}
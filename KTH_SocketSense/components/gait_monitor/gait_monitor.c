@@ -8,22 +8,186 @@
  * @date June 12. 2019
  */
 #include <stddef.h>
+#include <string.h>
 
 #include <esp_err.h>
 #include "esp_system.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+
+#include "freertos/FreeRTOS.h"
 
 #include "gait_monitor.h"
 
 static const char *TAG = "GAIT MONITOR";
 
+/**
+ * Name of a code, a code contains it if all its bits are set.
+ */
+typedef struct {
+	uint32_t	code;
+	const char	*name;
+} gait_monitor_name_t;
+
+/**
+ * Activities, the more specific ones first.
+ */
+static const gait_monitor_name_t activity_names[] = {
+	{BIONICS_ACTIVITY_CHAIR_RELAX,			"chair_relax"},
+	{BIONICS_ACTIVITY_CHAIR_EXIT,			"chair_exit"},
+	{BIONICS_ACTIVITY_SITTING,				"sitting"},
+	{BIONICS_ACTIVITY_STANDING,				"standing"},
+	{BIONICS_ACTIVITY_U_TURN,				"u_turn"},
+	{BIONICS_ACTIVITY_WALKING,				"walking"},
+	{BIONICS_ACTIVITY_UPSTAIRS,				"upstairs"},
+	{BIONICS_ACTIVITY_DOWNSTAIRS,			"downstairs"},
+	{BIONICS_ACTIVITY_IMMOBILE,				"immobile"},
+	{BIONICS_ACTIVITY_MOBILE,				"mobile"},
+	{BIONICS_ACTIVITY_AMBULATING,			"ambulating"},
+};
+
+/**
+ * Gait phases and events, the more specific ones first. Only the upper two bytes are compared.
+ */
+static const gait_monitor_name_t phase_names[] = {
+	{BIONICS_ACTIVITY_HEELSTRIKE,			"heelstrike"},
+	{BIONICS_ACTIVITY_MIDSTANCE,			"midstance"},
+	{BIONICS_ACTIVITY_TOEOFF,				"toeoff"},
+	{BIONICS_ACTIVITY_MIDSWING,				"midswing"},
+	{BIONICS_ACTIVITY_DOUBLE_LIMB_SUPPORT,	"double_limb_support"},
+	{BIONICS_ACTIVITY_SINGLE_LIMB_SUPPORT,	"single_limb_support"},
+	{BIONICS_ACTIVITY_LIMB_ADVANCEMENT,		"limb_advancement"},
+	{BIONICS_ACTIVITY_STANCE_PHASE,			"stance"},
+	{BIONICS_ACTIVITY_SWING_PHASE,			"swing"},
+};
+
 spi_device_handle_t spiHandle_gaitMonitor;
 
+/**
+ * The transaction of the readout, built once during the initialization.
+ */
+spi_transaction_t read_transaction;
+uint8_t read_pending = 0;				//1 between gait_monitor_startRead() and gait_monitor_finishRead()
+
+gait_monitor_stats_t gait_stats;
+
+/*****Private Functions Definitions*************************************************/
+
+uint8_t gait_monitor_isValid(uint32_t activity);
+
+/*****Public Functions**************************************************************/
+
 esp_err_t gait_monitor_init(spi_device_handle_t _spi)
 {
 	spiHandle_gaitMonitor = _spi;
 
+	memset(&read_transaction, 0, sizeof(read_transaction));
+	read_transaction.length = 4 * 8;										//the gait monitor shifts out the 32 bit code
+	read_transaction.flags = SPI_TRANS_USE_RXDATA | SPI_TRANS_USE_TXDATA;	//MOSI is ignored, tx_data stays zero
+	read_pending = 0;
+	memset(&gait_stats, 0, sizeof(gait_stats));
+
 	ESP_LOGI(TAG, "Initialized");
     
 	return ESP_OK;
 }
+
+esp_err_t gait_monitor_startRead(void)
+{
+	if(read_pending > 0){
+		return ESP_OK;														//the previous transaction has not been collected yet
+	}
+
+	if(spi_device_queue_trans(spiHandle_gaitMonitor, &read_transaction, 0) != ESP_OK){
+		gait_stats.failed++;
+		return ESP_FAIL;
+	}
+	read_pending = 1;
+
+	return ESP_OK;
+}
+
+uint32_t gait_monitor_finishRead(void)
+{
+	spi_transaction_t *t;
+	uint32_t activity;
+	uint32_t wait;
+	int64_t start;
+
+	if(read_pending == 0){
+		return BIONICS_ACTIVITY_UNKNOWN;
+	}
+
+	start = esp_timer_get_time();
+	if(spi_device_get_trans_result(spiHandle_gaitMonitor, &t, portMAX_DELAY) != ESP_OK){
+		gait_stats.failed++;
+		return BIONICS_ACTIVITY_UNKNOWN;
+	}
+	read_pending = 0;
+	wait = (uint32_t)(esp_timer_get_time() - start);
+	if(wait > gait_stats.max_wait_us){
+		gait_stats.max_wait_us = wait;
+	}
+
+	activity = ((uint32_t)t->rx_data[0] << 24) | ((uint32_t)t->rx_data[1] << 16) | ((uint32_t)t->rx_data[2] << 8) | t->rx_data[3];
+	gait_stats.reads++;
+	if(gait_monitor_isValid(activity) == 0){
+		gait_stats.invalid++;
+		return BIONICS_ACTIVITY_UNKNOWN;
+	}
+
+	return activity;
+}
+
+const char* gait_monitor_getActivityName(uint32_t activity)
+{
+	uint32_t i;
+
+	activity &= BIONICS_ACTIVITY_MASK;
+	for(i = 0; i < sizeof(activity_names) / sizeof(activity_names[0]); i++){
+		if((activity & activity_names[i].code) == activity_names[i].code){
+			return activity_names[i].name;
+		}
+	}
+
+	return "unknown";
+}
+
+const char* gait_monitor_getPhaseName(uint32_t activity)
+{
+	uint32_t i;
+	uint32_t phase;
+
+	for(i = 0; i < sizeof(phase_names) / sizeof(phase_names[0]); i++){
+		phase = phase_names[i].code & BIONICS_ACTIVITY_PHASE_MASK;			//the phases also carry the ambulating level
+		if((activity & phase) == phase){
+			return phase_names[i].name;
+		}
+	}
+
+	return NULL;
+}
+
+void gait_monitor_getStatistics(gait_monitor_stats_t *stats)
+{
+	memcpy(stats, &gait_stats, sizeof(gait_monitor_stats_t));
+}
+
+/*****Private Functions*************************************************************/
+
+/**
+ * A code is valid if its activity level is unknown or one of immobile, mobile and ambulating. This rejects the
+ * 0xFFFFFFFF of a MISO line that nobody drives.
+ */
+uint8_t gait_monitor_isValid(uint32_t activity)
+{
+	switch(activity & 0xFF){
+		case 0:
+		case BIONICS_ACTIVITY_IMMOBILE:
+		case BIONICS_ACTIVITY_MOBILE:
+		case BIONICS_ACTIVITY_AMBULATING:
+			return 1;
+		default:
+			return 0;
+	}
+}
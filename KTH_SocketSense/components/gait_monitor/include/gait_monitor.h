@@ -4,6 +4,17 @@
  *
  * The gait monitor can be used to querry the current gait cycle that can then be added to the meassured data.
  *
+ * The gait monitor shares the sensor SPI bus (VSPI) with the BME280 and the sensor strips. Whenever it is selected it
+ * shifts out its current activity code (BIONICS_ACTIVITY_*), 32 bits with the most significant byte first, and ignores
+ * MOSI. The code is made of four levels, one per byte from the least significant one: the activity level (immobile,
+ * mobile, ambulating), the activity (sitting, walking, ...), the gait phase (stance, swing and their sub-phases) and the
+ * gait event (heelstrike, midstance, toeoff, midswing). The codes of the levels are or-ed together, e.g. a walking
+ * subject in heelstrike reports BIONICS_ACTIVITY_WALKING | BIONICS_ACTIVITY_HEELSTRIKE.
+ *
+ * The readout is split in two halves so it does not add to the acquisition of the sensors: gait_monitor_startRead()
+ * queues the transaction once the sensors have been read, the SPI driver runs it from its interrupt while the data
+ * collector processes the sample, and gait_monitor_finishRead() collects the code before the sample is handed over.
+ *
  * @author Matthias Becker
  * @date June 12. 2019
  */
@@ -76,14 +87,76 @@
 /** Subject is in midswing */
 #define BIONICS_ACTIVITY_MIDSWING                               (((BIONICS_ACTIVITY_LIMB_ADVANCEMENT)) + ((((uint32_t)0))<<8) + ((((uint32_t)0))<<16) + ((((uint32_t)128))<<24))
 
+/**
+ * @brief Mask of the activity level and the activity (the two lower bytes of a code).
+ */
+#define BIONICS_ACTIVITY_MASK                                   ((uint32_t)0x0000FFFF)
+
+/**
+ * @brief Mask of the gait phase and the gait event (the two upper bytes of a code).
+ */
+#define BIONICS_ACTIVITY_PHASE_MASK                             ((uint32_t)0xFFFF0000)
+
+/**
+ * @brief Statistics of the readout since the initialization.
+ */
+typedef struct {
+	uint32_t	reads;					/**< Number of codes that were read. */
+	uint32_t	invalid;				/**< Number of codes that were not valid (no gait monitor, bus error), reported as unknown. */
+	uint32_t	failed;					/**< Number of transactions that could not be queued or collected. */
+	uint32_t	max_wait_us;			/**< Longest time gait_monitor_finishRead() waited for the transaction. */
+} gait_monitor_stats_t;
+
 /**
  * @brief Initialize the component.
  *
+ * The SPI device has to be configured in SPI mode 3 with the chip select of the gait monitor and a queue size of at
+ * least 1.
+ *
  * @param _spi The handle to the SPI device used.
  * @return ESP_OK if success, ESP_FAIL otherwise.
  */
 esp_err_t gait_monitor_init(spi_device_handle_t _spi);
 
+/**
+ * @brief Queues the transaction that reads the current activity code, without waiting for it.
+ *
+ * Every call has to be followed by gait_monitor_finishRead(). The transaction waits while another device holds the bus.
+ *
+ * @return ESP_OK if the transaction has been queued, ESP_FAIL otherwise.
+ */
+esp_err_t gait_monitor_startRead(void);
+
+/**
+ * @brief Collects the transaction queued by gait_monitor_startRead() and returns the activity code.
+ *
+ * @return The activity code, BIONICS_ACTIVITY_UNKNOWN if no transaction was queued or the code is not valid.
+ */
+uint32_t gait_monitor_finishRead(void);
+
+/**
+ * @brief Returns the name of the activity of a code (lower case, e.g. "walking"), "unknown" if there is none.
+ *
+ * @param activity The activity code.
+ * @return The name of the most specific activity the code contains.
+ */
+const char* gait_monitor_getActivityName(uint32_t activity);
+
+/**
+ * @brief Returns the name of the gait phase of a code (lower case, e.g. "heelstrike").
+ *
+ * @param activity The activity code.
+ * @return The name of the most specific gait phase or event the code contains, NULL if it contains none.
+ */
+const char* gait_monitor_getPhaseName(uint32_t activity);
+
+/**
+ * @brief Returns the statistics of the readout.
+ *
+ * @param stats Destination for the statistics.
+ */
+void gait_monitor_getStatistics(gait_monitor_stats_t *stats);
+
 
 
 #endif /* COMPONENTS_GAIT_MONITOR_H_ */
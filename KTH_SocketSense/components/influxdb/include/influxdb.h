@@ -2,23 +2,65 @@
  * @file influxdb.h
  * @brief Component that receives measurement data and transmits it to a InfluxDB instance reachable over the network.
  *
- * This component realizes a periodic task that receives measurement data over a OS queue.
- * Each item is sent to an InfluxDB instance that is reachable over the network.
+ * This component realizes a periodic task that receives measurement data from the sample pool.
+ * The samples are collected in batches of up to CONFIG_INFLUXDB_BATCH_SIZE points, or CONFIG_INFLUXDB_BATCH_TIMEOUT_MS
+ * after the first point of a batch. Each batch is sent with a single request to an InfluxDB instance that is reachable over the network.
  * Data is communicated using the line protocol, https://docs.influxdata.com/influxdb/v1.7/write_protocols/line_protocol_reference/
+ * Each sample carries the BME280 values, the statistics and every sensor element, see line_protocol.h.
  *
- * Additionally, the same sample is stored on the SD-card (if it was found during boot).
+ * Additionally, the same sample is stored on the SD-card (if it was found during boot). The task starts at boot,
+ * so data is logged locally before (and while not) a network connection is available.
  * The data is stored on the SD-card using the InfluxDB line protocol.
  * Doing this allows to upload the stored data points to the database from SD-card using a PC using the following command:
  * $curl -i -XPOST 'http://localhost:8086/write?db=mydb' --data-binary @@filename.txt`
  *
  * A description is provided here: https://docs.influxdata.com/influxdb/v1.7/guides/writing_data/
  *
+ * If CONFIG_INFLUXDB_GATEWAY_ENABLED is set, the batches are sent as binary frames (see sample_frame.h) to the ingest
+ * gateway on the Raspberry Pi instead, which writes them to its local InfluxDB, see influxdb_gateway.h. The exposure
+ * snapshots (CONFIG_DATA_COLLECTOR_EXPOSURE) go to the gateway as lines frames of their own.
+ * The line protocol is still built for the SD-card log and the spool, the spool is replayed directly to InfluxDB.
+ *
+ * All requests are sent over one HTTP client that is kept alive between requests. If the connection breaks
+ * (e.g. after a WIFI disconnect), it is closed and transparently reopened by the next request.
+ *
+ * Batches that are not acknowledged by the database (no network, or the request failed) are appended to a spool
+ * on the SD-card, see sd_spool.h. While the network is attached, the spool is replayed in chunks of up to
+ * CONFIG_INFLUXDB_SPOOL_CHUNK_SIZE bytes, limited to CONFIG_INFLUXDB_SPOOL_REPLAY_RATE bytes per second and to one
+ * request in a task period without a live batch. A chunk that is not accepted backs off the replay exponentially.
+ *
  * @author Matthias Becker
  * @date June 12. 2019
  */
 #ifndef COMPONENTS_INFLUXDB_H_
 #define COMPONENTS_INFLUXDB_H_
 
+/**
+ * @brief Statistics of the HTTP connection to the database.
+ */
+typedef struct {
+	uint32_t	requests;		/**< Number of HTTP requests that have been performed. */
+	uint32_t	failed;			/**< Number of requests that failed or were rejected by the server. */
+	uint32_t	connects;		/**< Number of TCP connections that have been opened. */
+	uint32_t	reused;			/**< Number of requests that were sent over an already open connection. */
+	uint32_t	reconnects;		/**< Number of connections that had to be reopened after the first one. */
+	uint32_t	batches;		/**< Number of batches that have been sent. */
+	uint32_t	points;			/**< Number of points in all sent batches. */
+	uint32_t	bytes;			/**< Number of line protocol bytes in all sent batches. */
+	uint32_t	frame_bytes;	/**< Number of binary frame bytes sent to the gateway (CONFIG_INFLUXDB_GATEWAY_ENABLED). */
+	uint32_t	deadband_saved_bytes;	/**< Number of line protocol bytes left out by the deadband (SOCKETSENSE_DEADBAND_ENABLED). */
+	uint32_t	avg_flush_latency_us;	/**< Average time in us from adding the first point of a batch until its request finished. */
+	uint32_t	max_flush_latency_us;	/**< Largest flush latency in us. */
+	uint32_t	avg_request_time_us;	/**< Average duration in us of the request that sends a batch. */
+	uint32_t	spooled_bytes;	/**< Number of bytes that have been written to the spool. */
+	uint32_t	replayed_bytes;	/**< Number of spooled bytes that have been acknowledged by the database. */
+	uint32_t	replayed_points;	/**< Number of spooled points that have been acknowledged by the database. */
+	uint32_t	replay_bytes_per_s;	/**< Replay throughput of the current (or last) backfill. */
+	uint32_t	spool_depth;	/**< Number of spooled bytes that still have to be replayed. */
+	uint32_t	spool_dropped_bytes;	/**< Number of spooled bytes dropped because a line did not fit into a replay chunk. */
+	uint32_t	replay_failures;	/**< Number of replayed chunks that were not accepted, each one backs off the replay. */
+} influxdb_stats_t;
+
 /**
  * @brief Initializes the InfluxDB component.
  *
@@ -27,14 +69,27 @@
 esp_err_t influxdb_init();
 
 /**
- * @brief Create the periodic task that receives the measurement data and sends it to the database.
+ * @brief Create the periodic task that receives the measurement data.
+ *
+ * The task logs the data to the SD-card right away, it is only sent to the database once influxdb_enable() was called.
+ *
+ * @return ESP_OK if success, ESP_FAIL otherwise.
+ */
+esp_err_t influxdb_start();
+
+/**
+ * @brief Attach the database, from now on the measurement data is also sent over the network.
+ *
+ * This is called once an IP has been assigned. The task is created if this has not been done yet.
  *
  * @return ESP_OK if success, ESP_FAIL otherwise.
  */
 esp_err_t influxdb_enable();
 
 /**
- * @brief Delete the influxdb task.
+ * @brief Detach the database, e.g. when the network connection is lost.
+ *
+ * The task keeps running and logs the measurement data to the SD-card only.
  *
  * @return ESP_OK if success, ESP_FAIL otherwise.
  */
@@ -47,4 +102,12 @@ esp_err_t influxdb_disable();
  */
 esp_err_t influxdb_deinit();
 
+/**
+ * @brief Returns the statistics of the HTTP connection to the database.
+ *
+ * @param stats Destination for the statistics.
+ * @return ESP_OK if success, ESP_FAIL otherwise.
+ */
+esp_err_t influxdb_getStatistics(influxdb_stats_t *stats);
+
 #endif /* COMPONENTS_INFLUXDB_H_ */
@@ -0,0 +1,98 @@
+/**
+ * @file influxdb_batch.h
+ * @brief Growable buffer that collects several samples as one line protocol body.
+ *
+ * The InfluxDB /write endpoint accepts any number of points in one request, separated by newlines.
+ * A batch collects the lines of several samples so that they can be sent with a single HTTP request.
+ * The buffer grows as needed, its capacity is doubled whenever a line does not fit anymore.
+ *
+ * @date October 17. 2026
+ */
+#ifndef COMPONENTS_INFLUXDB_BATCH_H_
+#define COMPONENTS_INFLUXDB_BATCH_H_
+
+#include <stddef.h>
+
+#include "KTHSocketSense.h"
+
+/**
+ * @brief Initial capacity of a batch buffer in bytes.
+ */
+#define INFLUXDB_BATCH_INITIAL_CAPACITY 1024
+
+/**
+ * @brief One batch of line protocol.
+ */
+typedef struct {
+	char		*data;				/**< Null terminated line protocol body. */
+	size_t		length;				/**< Length of the body without the terminating null. */
+	size_t		capacity;			/**< Allocated size of data. */
+	uint32_t	points;				/**< Number of points (lines) in the body. */
+	int64_t		first_point_us;		/**< esp_timer time at which the first point was added. */
+} influxdb_batch_t;
+
+/**
+ * @brief Allocates the buffer of a batch.
+ *
+ * @param batch The batch to initialize.
+ * @param capacity Initial capacity in bytes.
+ * @return ESP_OK if success, ESP_ERR_NO_MEM otherwise.
+ */
+esp_err_t influxdb_batch_init(influxdb_batch_t *batch, size_t capacity);
+
+/**
+ * @brief Frees the buffer of a batch.
+ *
+ * @param batch The batch to free.
+ */
+void influxdb_batch_free(influxdb_batch_t *batch);
+
+/**
+ * @brief Makes sure that at least additional bytes (plus the terminating null) fit behind the current body.
+ *
+ * @param batch The batch to grow.
+ * @param additional Number of bytes that are about to be appended.
+ * @return ESP_OK if success, ESP_ERR_NO_MEM otherwise.
+ */
+esp_err_t influxdb_batch_reserve(influxdb_batch_t *batch, size_t additional);
+
+/**
+ * @brief Appends the line protocol representation of one sample to the batch.
+ *
+ * The sample is encoded with line_protocol_encodeSample().
+ *
+ * @param batch The batch to append to.
+ * @param sample The sample to append.
+ * @return ESP_OK if success, ESP_ERR_NO_MEM otherwise.
+ */
+esp_err_t influxdb_batch_append(influxdb_batch_t *batch, const SocketSense_Sample_t *sample);
+
+/**
+ * @brief Appends a snapshot of the exposure to the batch, after the sample it was published with.
+ *
+ * The snapshot is encoded with line_protocol_encodeExposure(), it does not count as a point of the batch.
+ *
+ * @param batch The batch to append to, holds at least one sample.
+ * @param exposure The snapshot to append.
+ * @return ESP_OK if success, ESP_ERR_NO_MEM otherwise.
+ */
+esp_err_t influxdb_batch_appendExposure(influxdb_batch_t *batch, const SocketSense_Exposure_t *exposure);
+
+/**
+ * @brief Removes all points from the batch, the buffer is kept.
+ *
+ * @param batch The batch to clear.
+ */
+void influxdb_batch_clear(influxdb_batch_t *batch);
+
+/**
+ * @brief Checks if a batch has to be sent.
+ *
+ * @param batch The batch to check.
+ * @param max_points The batch is due once it contains this many points.
+ * @param max_age_ms The batch is due once its first point is older than this.
+ * @return 1 if the batch is due, 0 otherwise.
+ */
+uint8_t influxdb_batch_isDue(const influxdb_batch_t *batch, uint32_t max_points, uint32_t max_age_ms);
+
+#endif /* COMPONENTS_INFLUXDB_BATCH_H_ */
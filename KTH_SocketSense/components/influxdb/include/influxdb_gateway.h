@@ -0,0 +1,50 @@
+/**
+ * @file influxdb_gateway.h
+ * @brief TCP connection to the ingest gateway that receives samples in the binary frame format.
+ *
+ * Instead of posting line protocol to InfluxDB, the samples can be sent as binary frames (see sample_frame.h) to the
+ * gateway running on the Raspberry Pi (tools/gateway). The gateway decodes the frames and writes them to the local
+ * InfluxDB in batches.
+ *
+ * The connection is opened by the first frame and kept open. After connecting, a hello frame with the user-id is sent.
+ * The gateway acknowledges every samples frame with its sequence number once the points have been accepted. If the
+ * connection breaks or the acknowledgement does not arrive in time, the connection is closed and the frame is sent once
+ * more over a new connection.
+ *
+ * @date October 17. 2026
+ */
+#ifndef COMPONENTS_INFLUXDB_GATEWAY_H_
+#define COMPONENTS_INFLUXDB_GATEWAY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Time in ms to wait for the connection, a send or the acknowledgement of a frame.
+ */
+#define INFLUXDB_GATEWAY_TIMEOUT_MS 5000
+
+/**
+ * @brief Sets the user-id that is sent in the hello frame of each connection.
+ *
+ * @param uid The user-id (null terminated), the pointer must stay valid.
+ */
+void influxdb_gateway_setUid(const char *uid);
+
+/**
+ * @brief Sends one finished frame and waits for its acknowledgement.
+ *
+ * @param frame The frame (header and payload).
+ * @param length Length of the frame.
+ * @param sequence Sequence number written in the frame header.
+ * @param connected Set to 1 if a new connection was opened for the frame, 0 otherwise.
+ * @return ESP_OK if the gateway acknowledged the frame, ESP_FAIL otherwise.
+ */
+esp_err_t influxdb_gateway_send(const uint8_t *frame, size_t length, uint32_t sequence, uint8_t *connected);
+
+/**
+ * @brief Closes the connection to the gateway.
+ */
+void influxdb_gateway_close();
+
+#endif /* COMPONENTS_INFLUXDB_GATEWAY_H_ */
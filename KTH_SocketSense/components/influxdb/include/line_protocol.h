@@ -0,0 +1,168 @@
+/**
+ * @file line_protocol.h
+ * @brief Encoder that writes a sample in the InfluxDB line protocol.
+ *
+ * Each sample is written as one point of the measurement socket_data:
+ * socket_data temp=21.53,hum=40.12,pres=101325.00,st=2400,bl=3950,s0_0=1234i,...,s3_15=87i 1571234567890123
+ *
+ * Every sensor element is a separate integer field named s<strip>_<sensel>. The numbers are formatted with
+ * hand-rolled integer and fixed-point routines instead of sprintf, which avoids the format string parsing and the
+ * float formatting of newlib.
+ *
+ * With the gait monitor (CONFIG_GAIT_SENSOR_ACTIVE), the activity and the gait phase of the sample are written as the
+ * tags activity and phase (the phase only within the gait cycle), and the complete code as the field act:
+ * socket_data,activity=walking,phase=heelstrike temp=21.53,...,bl=3950,act=17891588i,s0_0=1234i,... 1571234567890123
+ *
+ * The names are the ones of gait_monitor_getActivityName() and gait_monitor_getPhaseName(), so a query selects e.g. the
+ * heel strikes with WHERE phase = 'heelstrike'.
+ *
+ * With the deadband of the data collector (CONFIG_DATA_COLLECTOR_DEADBAND, or a profile of the acquisition policy), the
+ * sensor elements that are not reported in a sample are left out; a query reconstructs them with fill(previous).
+ *
+ * With the feature extraction (CONFIG_DATA_COLLECTOR_FEATURES), a sample that carries the summary of a window is followed by a
+ * point of the measurement socket_features with the same timestamp (only by that point if the sample is summary_only,
+ * with CONFIG_DATA_COLLECTOR_FEATURES == 2 or a profile of the acquisition policy):
+ * socket_features n=100i,load=18342i,peak=3981i,peak_s=2i,peak_e=7i,cop_s=1.42,cop_e=4.87,ls0=21.37,...,cpu_ns=1850i,cpu_max_ns=3920i 1571234567890123
+ *
+ * The center of pressure (cop_s across the strips, cop_e along them) is in strips and sensor elements, the load shares
+ * ls<strip> in percent and cpu_ns and cpu_max_ns are the mean and the longest time of the feature extraction per sample,
+ * measured with the cycle counter of the CPU.
+ *
+ * Snapshots of the exposure (CONFIG_DATA_COLLECTOR_EXPOSURE) are points of the measurement socket_exposure with the
+ * timestamp of their last sample, the pressure-time integral p, the time above the threshold a and the histogram h of
+ * every sensor element, since the accumulators were started:
+ * socket_exposure dur=86400i,since=1571148167890123i,thr=1000i,p0_0=51234567i,a0_0=20412i,h0_0="40123,25000,...",... 1571234567890123
+ * socket_exposure p1_0=49876543i,a1_0=19876i,h1_0="41234,24000,...",... 1571234567890123
+ *
+ * dur is the time covered in s, p is in value * s, a and the bins of h are in s. Every sensor strip gets its own line
+ * with the same timestamp, InfluxDB merges them into one point. This keeps each line short enough for a chunk of the
+ * spool (CONFIG_INFLUXDB_SPOOL_CHUNK_SIZE).
+ *
+ * @date October 17. 2026
+ */
+#ifndef COMPONENTS_LINE_PROTOCOL_H_
+#define COMPONENTS_LINE_PROTOCOL_H_
+
+#include <stddef.h>
+
+#include "KTHSocketSense.h"
+
+/**
+ * @brief Upper bound of the length of one encoded sample (without terminating null).
+ *
+ * This covers the measurement name, the BME280 fields (12 characters each), the statistics (up to 14 characters each),
+ * every sensel field (up to 12 characters each) and the timestamp (up to 21 characters), plus the activity of the gait
+ * monitor and the socket_features point if they are enabled.
+ */
+#define LINE_PROTOCOL_MAX_SENSEL_LENGTH (128 + CONFIG_SOCKETSENSE_SENSOR_COUNT * CONFIG_SOCKETSENSE_SENSEL_COUNT * 12)
+
+/**
+ * @brief Upper bound of the length of one socket_features point, including the newline in front of it.
+ */
+#define LINE_PROTOCOL_MAX_FEATURES_LENGTH (200 + CONFIG_SOCKETSENSE_SENSOR_COUNT * 18)
+
+/**
+ * @brief Upper bound of the length of one line of a socket_exposure point (the fields of one sensor strip).
+ */
+#define LINE_PROTOCOL_MAX_EXPOSURE_LINE_LENGTH (128 + CONFIG_SOCKETSENSE_SENSEL_COUNT * (72 + SOCKETSENSE_EXPOSURE_BINS * 11))
+
+/**
+ * @brief Upper bound of the length of one socket_exposure point, all its lines and the newlines between them.
+ */
+#define LINE_PROTOCOL_MAX_EXPOSURE_LENGTH (CONFIG_SOCKETSENSE_SENSOR_COUNT * (LINE_PROTOCOL_MAX_EXPOSURE_LINE_LENGTH + 1))
+
+/**
+ * @brief Upper bound of the length of the activity and phase tags and the act field.
+ */
+#if CONFIG_GAIT_SENSOR_ACTIVE == 1
+#define LINE_PROTOCOL_MAX_ACTIVITY_LENGTH 80
+#else
+#define LINE_PROTOCOL_MAX_ACTIVITY_LENGTH 0
+#endif
+
+#if CONFIG_DATA_COLLECTOR_FEATURES > 0
+#define LINE_PROTOCOL_MAX_SAMPLE_LENGTH (LINE_PROTOCOL_MAX_SENSEL_LENGTH + LINE_PROTOCOL_MAX_ACTIVITY_LENGTH + LINE_PROTOCOL_MAX_FEATURES_LENGTH)
+#else
+#define LINE_PROTOCOL_MAX_SAMPLE_LENGTH (LINE_PROTOCOL_MAX_SENSEL_LENGTH + LINE_PROTOCOL_MAX_ACTIVITY_LENGTH)
+#endif
+
+/**
+ * @brief Writes the decimal representation of an unsigned 32 bit value.
+ *
+ * @param dst Destination, needs space for 10 characters.
+ * @param value The value to write.
+ * @return Pointer behind the last written character.
+ */
+char* line_protocol_writeUInt32(char *dst, uint32_t value);
+
+/**
+ * @brief Writes the decimal representation of an unsigned 64 bit value.
+ *
+ * @param dst Destination, needs space for 20 characters.
+ * @param value The value to write.
+ * @return Pointer behind the last written character.
+ */
+char* line_protocol_writeUInt64(char *dst, uint64_t value);
+
+/**
+ * @brief Writes a float as fixed-point number with two decimals, e.g. -12.30.
+ *
+ * The digits are the same as those of printf("%.2f"): the exact value of the float is rounded, half to even.
+ * Values outside of +-10000000 are clamped, NaN is written as 0.00.
+ *
+ * @param dst Destination, needs space for 12 characters.
+ * @param value The value to write.
+ * @return Pointer behind the last written character.
+ */
+char* line_protocol_writeFixed2(char *dst, float value);
+
+/**
+ * @brief Encodes one sample as a line protocol point.
+ *
+ * @param dst Destination, needs space for LINE_PROTOCOL_MAX_SAMPLE_LENGTH characters. No null is written.
+ * @param sample The sample to encode.
+ * @return Number of characters written.
+ */
+size_t line_protocol_encodeSample(char *dst, const SocketSense_Sample_t *sample);
+
+/**
+ * @brief Encodes the summary of the pressure features of a sample as a socket_features point.
+ *
+ * @param dst Destination, needs space for LINE_PROTOCOL_MAX_FEATURES_LENGTH characters. No null is written.
+ * @param sample Sample with the summary of a window (features.samples > 0).
+ * @return Number of characters written.
+ */
+size_t line_protocol_encodeFeatures(char *dst, const SocketSense_Sample_t *sample);
+
+/**
+ * @brief Encodes a snapshot of the exposure as a socket_exposure point, one line per sensor strip.
+ *
+ * @param dst Destination, needs space for LINE_PROTOCOL_MAX_EXPOSURE_LENGTH characters. No null is written.
+ * @param exposure The snapshot.
+ * @return Number of characters written.
+ */
+size_t line_protocol_encodeExposure(char *dst, const SocketSense_Exposure_t *exposure);
+
+/**
+ * @brief Returns the number of characters the sensor elements would take that are left out because of the deadband.
+ *
+ * @param sample The sample to encode.
+ * @return Number of characters that line_protocol_encodeSample() saved, 0 for keyframes or without the deadband.
+ */
+size_t line_protocol_suppressedLength(const SocketSense_Sample_t *sample);
+
+/**
+ * @brief Measures the throughput of the encoder and of an equivalent sprintf implementation and logs the results.
+ *
+ * First the output of the encoder is compared with the one of sprintf for BME280 values over their whole range, the
+ * benchmark fails if a single byte differs.
+ * A synthetic sample with all configured sensor strips and sensor elements is encoded repeatedly.
+ * The same samples are then added to sample frames with the packed and the Gorilla encoding, which logs the cost
+ * and the size per sample of both encodings.
+ *
+ * @param iterations Number of samples to encode with each implementation.
+ * @return ESP_OK if success, ESP_FAIL if the output of the encoder differs from sprintf.
+ */
+esp_err_t line_protocol_benchmark(uint32_t iterations);
+
+#endif /* COMPONENTS_LINE_PROTOCOL_H_ */
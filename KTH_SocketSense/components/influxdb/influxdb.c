@@ -5,6 +5,7 @@
  *  Author: matthiasbecker
  *
  */
+#include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stddef.h>
@@ -13,32 +14,123 @@
 #include "esp_log.h"
 #include <esp_err.h>
 #include "esp_http_client.h"
+#include "esp_timer.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
 #include "freertos/task.h"
 
 #include "sd_logging.h"
+#include "sd_spool.h"
+#include "sd_columns.h"
+#include "sample_pool.h"
+#include "influxdb.h"
+#include "influxdb_batch.h"
+#include "influxdb_gateway.h"
+#include "line_protocol.h"
+#include "sample_frame.h"
+#include "sensel_exposure.h"
 #include "KTHSocketSense.h"
 
 static const char *TAG = "INFLUX_DB";
 
 esp_http_client_config_t config;
-esp_http_client_handle_t client;
+esp_http_client_handle_t client = NULL;		//one connection that is kept alive and reused for all requests
+
+influxdb_stats_t http_stats;
 
 TaskHandle_t influxdb_handle = NULL;
 
-char buffer[200];
+volatile uint8_t network_attached = 0;		//set once an IP has been assigned, batches are only posted while this is set
+
+influxdb_batch_t batch;						//line protocol of the samples that have not been sent yet
+uint64_t flush_latency_sum_us = 0;
+uint64_t request_time_sum_us = 0;
+
+char* replay_buffer = NULL;					//chunk of the spool that is currently replayed
+int64_t replay_tokens = 0;					//token bucket that bounds the replay rate, in bytes
+int64_t replay_refill_us = 0;				//time the token bucket was last refilled
+int64_t replay_start_us = 0;				//start of the current backfill, 0 if none is in progress
+uint64_t replay_window_bytes = 0;			//bytes replayed during the current backfill
+int64_t replay_retry_us = 0;				//no chunk is replayed before this time after a failed one
+uint32_t replay_backoff_ms = 0;				//current backoff, 0 after a chunk was accepted
+
+sample_frame_t frame;						//the same samples as binary frame for the gateway and the SD log
+uint32_t frame_sequence = 0;
+uint8_t* exposure_frame = NULL;				//lines frame that carries the exposure snapshots to the gateway
+
 uint8_t* user_id;
+char write_path[64];						//the device tag lets the fan-in gateway tell the devices apart, InfluxDB ignores it
 
 #define INFLUXDB_CPU 0
-#define INFLUXDB_TASK_PERIOD_MS 500
+#define INFLUXDB_FRAMES (CONFIG_INFLUXDB_GATEWAY_ENABLED == 1 || CONFIG_SD_LOGGING_FORMAT == SD_LOGGING_FORMAT_FRAMES)
+#define INFLUXDB_COLUMNS (CONFIG_SD_LOGGING_FORMAT == SD_LOGGING_FORMAT_COLUMNS)
+#define INFLUXDB_EXPOSURE_FRAMES (CONFIG_INFLUXDB_GATEWAY_ENABLED == 1 && CONFIG_DATA_COLLECTOR_EXPOSURE == 1)
+#define INFLUXDB_TASK_PERIOD_MS 50
+#define INFLUXDB_REPLAY_BACKOFF_MIN_MS 1000	//backoff after the first failed replay, doubled with every further failure
+#define INFLUXDB_REPLAY_BACKOFF_MAX_MS 60000
+
+#if LINE_PROTOCOL_MAX_SENSEL_LENGTH + LINE_PROTOCOL_MAX_ACTIVITY_LENGTH >= CONFIG_INFLUXDB_SPOOL_CHUNK_SIZE
+#error "A sample does not fit into CONFIG_INFLUXDB_SPOOL_CHUNK_SIZE, it could not be replayed from the spool"
+#endif
+#if CONFIG_DATA_COLLECTOR_EXPOSURE == 1 && LINE_PROTOCOL_MAX_EXPOSURE_LINE_LENGTH >= CONFIG_INFLUXDB_SPOOL_CHUNK_SIZE
+#error "A line of the exposure does not fit into CONFIG_INFLUXDB_SPOOL_CHUNK_SIZE, it could not be replayed from the spool"
+#endif
 
 /**
- * This function posts the measurement data to the database.
+ * This function adds the measurement data to the current batch.
+ */
+void influxdb_post_data(const SocketSense_Sample_t *_sample);
+
+/**
+ * This function sends the current batch to the database.
  * Additionally, the same data is written to the log-file on the SD-card (if available).
  */
-void influxdb_post_data(SocketSense_Sample_t _sample);
+void influxdb_flush();
+
+/**
+ * This function sends one body of line protocol to the database over the persistent connection.
+ */
+esp_err_t influxdb_send(const char *body, int len, int attempts);
+
+/**
+ * This function sends a finished frame to the gateway.
+ */
+esp_err_t influxdb_sendFrame(const uint8_t *data, size_t len, uint32_t sequence);
+
+/**
+ * This function writes the current batch to the log-file on the SD-card, as frame or as line protocol.
+ */
+void influxdb_logBatch(size_t frame_length);
+
+/**
+ * This function replays one chunk of the spool, if the replay rate and the backoff allow it.
+ */
+void influxdb_replay();
+
+/**
+ * This function delays the next replay after a failed one, with exponential backoff.
+ */
+void influxdb_backoffReplay(int64_t now);
+
+#if CONFIG_DATA_COLLECTOR_EXPOSURE == 1
+/**
+ * This function adds a snapshot of the exposure to the batch and hands it to the writer task of the SD-card.
+ */
+void influxdb_postExposure(SocketSense_Exposure_t *exposure);
+
+/**
+ * This function saves a snapshot of the exposure on the SD-card and returns it to the data collector, it runs in the writer task of the SD-card.
+ */
+void influxdb_saveExposure(void *arg);
+#endif
+
+#if INFLUXDB_EXPOSURE_FRAMES
+/**
+ * This function sends a snapshot of the exposure to the gateway as a lines frame.
+ */
+void influxdb_sendExposure(const SocketSense_Exposure_t *exposure);
+#endif
 
 /**
  * @brief		HTTP event handler function
@@ -57,6 +149,7 @@ esp_err_t _http_event_handler(esp_http_client_event_t *evt)
             break;
         case HTTP_EVENT_ON_CONNECTED:
             ESP_LOGD(TAG, "HTTP_EVENT_ON_CONNECTED");
+            http_stats.connects++;
             break;
         case HTTP_EVENT_HEADER_SENT:
             ESP_LOGD(TAG, "HTTP_EVENT_HEADER_SENT");
@@ -83,31 +176,356 @@ esp_err_t _http_event_handler(esp_http_client_event_t *evt)
 }
 
 /**
- * This function posts the measurement data to the database.
- * Additionally, the same data is written to the log-file on the SD-card (if available).
+ * This function sends one body of line protocol to the database over the persistent connection.
+ * The client is created once and kept alive between requests. If a request fails, the connection is
+ * closed and the request is repeated on a new connection, up to attempts requests in total.
  */
-void influxdb_post_data(SocketSense_Sample_t _sample){
-		esp_err_t err;
-
-		memset(&buffer, 0, sizeof(buffer));	//resetting the buffer
-		sprintf(buffer, "socket_data temp=%.2f,hum=%.2f,pres=%.2f,st=%u,bl=%u %llu", _sample.bme280_data.temperature, _sample.bme280_data.humidity, _sample.bme280_data.pressure, _sample.sampling_time, _sample.battery_voltage, _sample.timestamp_usec);
+esp_err_t influxdb_send(const char *body, int len, int attempts){
+	esp_err_t err = ESP_FAIL;
+	uint32_t connects;
+	int status = 0;
+	int attempt;
 
+	if(client == NULL){
 		client = esp_http_client_init(&config);
+		if(client == NULL){
+			ESP_LOGE(TAG, "Failed to create the HTTP client");
+			return ESP_FAIL;
+		}
 		esp_http_client_set_method(client, HTTP_METHOD_POST);
+	}
+
+	for(attempt = 0; attempt < attempts; attempt++){
+		connects = http_stats.connects;
 
-		esp_http_client_set_post_field(client, buffer, strlen(buffer));
+		esp_http_client_set_post_field(client, body, len);
 		err = esp_http_client_perform(client);
-		if (err == ESP_OK) {
-			ESP_LOGI(TAG, "HTTP POST Status = %d, content_length = %d",
-					esp_http_client_get_status_code(client),
-					esp_http_client_get_content_length(client));
-		} else {
-			ESP_LOGE(TAG, "HTTP POST request failed: %s", esp_err_to_name(err));
+		http_stats.requests++;
+
+		if(http_stats.connects == connects){					//no new connection was opened for this request
+			http_stats.reused++;
+		}else if(http_stats.connects > 1){
+			http_stats.reconnects++;
 		}
 
-		esp_http_client_cleanup(client);
+		if(err == ESP_OK){
+			status = esp_http_client_get_status_code(client);
+			ESP_LOGD(TAG, "HTTP POST Status = %d, content_length = %d", status, esp_http_client_get_content_length(client));
+			if(status >= 200 && status < 300){
+				return ESP_OK;
+			}
+			ESP_LOGE(TAG, "HTTP POST rejected with status %d", status);
+			http_stats.failed++;
+			return ESP_FAIL;									//the server answered, repeating the request will not help
+		}
 
-		sd_logging_log(buffer);
+		ESP_LOGE(TAG, "HTTP POST request failed: %s", esp_err_to_name(err));
+		http_stats.failed++;
+		esp_http_client_close(client);							//drop the broken connection, the next perform reconnects
+	}
+
+	return err;
+}
+
+/**
+ * This function sends a finished frame to the gateway and waits for its acknowledgement.
+ */
+esp_err_t influxdb_sendFrame(const uint8_t *data, size_t len, uint32_t sequence){
+	uint8_t connected;
+
+	http_stats.requests++;
+
+	if(influxdb_gateway_send(data, len, sequence, &connected) != ESP_OK){
+		http_stats.failed++;
+		return ESP_FAIL;
+	}
+
+	if(connected == 0){
+		http_stats.reused++;
+	}else{
+		http_stats.connects++;
+		if(http_stats.connects > 1){
+			http_stats.reconnects++;
+		}
+	}
+	http_stats.frame_bytes += len;
+
+	return ESP_OK;
+}
+
+/**
+ * This function writes the current batch to the log-file on the SD-card.
+ * Depending on CONFIG_SD_LOGGING_FORMAT the finished frame or the line protocol is logged, the column log is written
+ * sample by sample in influxdb_post_data().
+ */
+void influxdb_logBatch(size_t frame_length){
+#if CONFIG_SD_LOGGING_FORMAT == SD_LOGGING_FORMAT_FRAMES
+	sd_logging_write(frame.data, frame_length);
+#elif CONFIG_SD_LOGGING_FORMAT == SD_LOGGING_FORMAT_COLUMNS
+	(void) frame_length;
+#else
+	sd_logging_log(batch.data);
+#endif
+}
+
+/**
+ * This function adds the measurement data to the current batch.
+ * If the batch can't grow anymore, it is sent right away and the sample starts a new batch.
+ * With the gateway or the frame log enabled, the sample is added to the frame as well, with the column log it is
+ * added to the current block of the log.
+ */
+void influxdb_post_data(const SocketSense_Sample_t *_sample){
+#if SOCKETSENSE_DEADBAND_ENABLED
+	http_stats.deadband_saved_bytes += line_protocol_suppressedLength(_sample);
+#endif
+#if INFLUXDB_FRAMES || INFLUXDB_COLUMNS
+	sample_frame_point_t point;
+
+	point.timestamp_usec = _sample->timestamp_usec;
+	point.temperature = _sample->bme280_data.temperature;
+	point.humidity = _sample->bme280_data.humidity;
+	point.pressure = _sample->bme280_data.pressure;
+	point.sampling_time = _sample->sampling_time;
+	point.battery_voltage = _sample->battery_voltage;
+	point.sensels = &_sample->sensorstrip_data[0][0];
+	point.sensel_mask = _sample->keyframe ? NULL : _sample->sensel_mask;
+#endif
+
+#if INFLUXDB_COLUMNS
+	sd_columns_append(&point);
+#endif
+
+#if INFLUXDB_FRAMES
+	if(sample_frame_append(&frame, &point) != SAMPLE_FRAME_OK){
+		influxdb_flush();
+		sample_frame_append(&frame, &point);
+	}
+#endif
+
+	if(influxdb_batch_append(&batch, _sample) != ESP_OK){
+		influxdb_flush();
+		if(influxdb_batch_append(&batch, _sample) != ESP_OK){
+			ESP_LOGE(TAG, "Sample could not be added to the batch!");
+		}
+	}
+
+#if CONFIG_DATA_COLLECTOR_EXPOSURE == 1
+	if(_sample->exposure != NULL){
+		influxdb_postExposure(_sample->exposure);
+	}
+#endif
+}
+
+#if CONFIG_DATA_COLLECTOR_EXPOSURE == 1
+/**
+ * This function adds a snapshot of the exposure to the current batch.
+ * With the gateway, the snapshot is sent right away in a frame of its own instead, the samples frames can't carry it.
+ * Afterwards the snapshot is handed to the writer task of the SD-card, which saves it and returns it to the data collector.
+ * If the writer task doesn't take it, the snapshot is returned right away and not saved.
+ */
+void influxdb_postExposure(SocketSense_Exposure_t *exposure){
+#if INFLUXDB_EXPOSURE_FRAMES
+	influxdb_sendExposure(exposure);
+#else
+	if(batch.points == 0 || influxdb_batch_appendExposure(&batch, exposure) != ESP_OK){
+		ESP_LOGE(TAG, "Exposure could not be added to the batch!");
+	}
+#endif
+	if(sd_logging_request(influxdb_saveExposure, exposure) != ESP_OK){
+		ESP_LOGE(TAG, "Exposure snapshot could not be handed to the SD-card!");
+		sensel_exposure_release(exposure);
+	}
+}
+
+/**
+ * This function writes a snapshot of the exposure to the SD-card and returns it to the data collector.
+ * It is called by the writer task of the SD-card, the uplink task doesn't wait for the file operations.
+ */
+void influxdb_saveExposure(void *arg){
+	SocketSense_Exposure_t *exposure = (SocketSense_Exposure_t *) arg;
+
+	if(sensel_exposure_save(exposure, SENSEL_EXPOSURE_FILE, SENSEL_EXPOSURE_TEMP_FILE) != ESP_OK){
+		ESP_LOGE(TAG, "Exposure snapshot could not be saved!");
+	}
+	sensel_exposure_release(exposure);
+}
+#endif
+
+#if INFLUXDB_EXPOSURE_FRAMES
+/**
+ * This function sends a snapshot of the exposure to the gateway as a lines frame and waits for its acknowledgement.
+ * Without network or acknowledgement the line protocol is spooled, like a batch.
+ */
+void influxdb_sendExposure(const SocketSense_Exposure_t *exposure){
+	char *lines = (char*) &exposure_frame[SAMPLE_FRAME_HEADER_SIZE];
+	size_t len;
+
+	len = line_protocol_encodeExposure(lines, exposure);
+	if(network_attached == 0
+			|| influxdb_sendFrame(exposure_frame, sample_frame_finishLines(exposure_frame, len, frame_sequence), frame_sequence) != ESP_OK){
+		sd_spool_append(lines, len);
+		http_stats.spooled_bytes += len + 1;
+	}
+	frame_sequence++;
+}
+#endif
+
+/**
+ * This function sends the current batch to the database as a single request.
+ * Additionally, the same data is written to the log-file on the SD-card (if available).
+ */
+void influxdb_flush(){
+	esp_err_t err;
+	int64_t start;
+	int64_t stop;
+	uint32_t latency;
+	size_t frame_length = 0;
+
+	if(batch.points == 0){
+		return;
+	}
+
+#if INFLUXDB_FRAMES
+	frame_length = sample_frame_finish(&frame, frame_sequence);
+#endif
+
+	if(network_attached == 0){											//no network, keep the data until it can be replayed
+		sd_spool_append(batch.data, batch.length);
+		http_stats.spooled_bytes += batch.length + 1;
+		influxdb_logBatch(frame_length);
+		influxdb_batch_clear(&batch);
+		sample_frame_clear(&frame);
+		frame_sequence++;
+		return;
+	}
+
+	start = esp_timer_get_time();
+#if CONFIG_INFLUXDB_GATEWAY_ENABLED == 1
+	err = influxdb_sendFrame(frame.data, frame_length, frame_sequence);
+#else
+	err = influxdb_send(batch.data, batch.length, 2);
+#endif
+	if(err != ESP_OK){													//not acknowledged, the line protocol is spooled in both cases
+		sd_spool_append(batch.data, batch.length);
+		http_stats.spooled_bytes += batch.length + 1;
+	}
+	stop = esp_timer_get_time();
+
+	latency = (uint32_t)(stop - batch.first_point_us);					//time the oldest point waited until the request finished
+	http_stats.batches++;
+	http_stats.points += batch.points;
+	http_stats.bytes += batch.length;
+	flush_latency_sum_us += latency;
+	request_time_sum_us += (uint64_t)(stop - start);
+	if(latency > http_stats.max_flush_latency_us){
+		http_stats.max_flush_latency_us = latency;
+	}
+	http_stats.avg_flush_latency_us = (uint32_t)(flush_latency_sum_us / http_stats.batches);
+	http_stats.avg_request_time_us = (uint32_t)(request_time_sum_us / http_stats.batches);
+
+	ESP_LOGD(TAG, "Sent batch of %u points (%u bytes), latency %u usec", batch.points, (unsigned int) batch.length, latency);
+
+	influxdb_logBatch(frame_length);
+
+	influxdb_batch_clear(&batch);
+	sample_frame_clear(&frame);
+	frame_sequence++;
+}
+
+/**
+ * This function replays one chunk of the spool.
+ * The replay rate is bounded by a token bucket that is refilled with CONFIG_INFLUXDB_SPOOL_REPLAY_RATE bytes per second,
+ * at most one chunk is sent per task period, in a single request, so that live batches are not delayed by the backfill.
+ * A chunk is only acknowledged (and removed from the spool) once the database accepted it. After a failed chunk the
+ * replay pauses for INFLUXDB_REPLAY_BACKOFF_MIN_MS, doubled with every further failure up to INFLUXDB_REPLAY_BACKOFF_MAX_MS.
+ * A line that does not fit into a chunk is dropped, it could never be replayed and would block the spool.
+ */
+void influxdb_replay(){
+	int64_t now;
+	size_t len;
+	uint32_t points = 0;
+	esp_err_t err;
+
+	now = esp_timer_get_time();
+	replay_tokens += (now - replay_refill_us) * CONFIG_INFLUXDB_SPOOL_REPLAY_RATE / 1000000;
+	if(replay_tokens > CONFIG_INFLUXDB_SPOOL_CHUNK_SIZE){				//bursts are limited to one chunk
+		replay_tokens = CONFIG_INFLUXDB_SPOOL_CHUNK_SIZE;
+	}
+	replay_refill_us = now;
+
+	http_stats.spool_depth = sd_spool_getDepth();
+
+	if(http_stats.spool_depth == 0){
+		replay_start_us = 0;
+		return;
+	}
+
+	if(replay_tokens < CONFIG_INFLUXDB_SPOOL_CHUNK_SIZE && replay_tokens < (int64_t) http_stats.spool_depth){
+		return;
+	}
+	if(now < replay_retry_us){
+		return;															//backing off after a failed chunk
+	}
+
+	err = sd_spool_read(replay_buffer, CONFIG_INFLUXDB_SPOOL_CHUNK_SIZE, &len);
+	if(err == ESP_ERR_INVALID_SIZE){
+		sd_spool_ack(len);
+		http_stats.spool_dropped_bytes += len;
+		http_stats.spool_depth = sd_spool_getDepth();
+		return;
+	}
+	if(err != ESP_OK){
+		if(err != ESP_ERR_NOT_FOUND){
+			ESP_LOGE(TAG, "Failed to read the spool");
+		}
+		return;
+	}
+
+	if(replay_start_us == 0){
+		replay_start_us = now;
+		replay_window_bytes = 0;
+		ESP_LOGI(TAG, "Replaying %u spooled bytes", http_stats.spool_depth);
+	}
+
+	if(influxdb_send(replay_buffer, len - 1, 1) != ESP_OK){
+		influxdb_backoffReplay(esp_timer_get_time());
+		return;															//the chunk stays in the spool and is tried again
+	}
+
+	replay_backoff_ms = 0;
+	replay_tokens -= len;
+	sd_spool_ack(len);
+
+	for(size_t i = 0; i < len - 1; i++){
+		if(replay_buffer[i] == '\n'){
+			points++;
+		}
+	}
+
+	now = esp_timer_get_time();
+	replay_window_bytes += len;
+	http_stats.replayed_bytes += len;
+	http_stats.replayed_points += points + 1;
+	if(now > replay_start_us){
+		http_stats.replay_bytes_per_s = (uint32_t)(replay_window_bytes * 1000000 / (uint64_t)(now - replay_start_us));
+	}
+	http_stats.spool_depth = sd_spool_getDepth();
+}
+
+/**
+ * This function delays the next replay after a failed one, with exponential backoff.
+ */
+void influxdb_backoffReplay(int64_t now){
+	if(replay_backoff_ms == 0){
+		replay_backoff_ms = INFLUXDB_REPLAY_BACKOFF_MIN_MS;
+	}else if(replay_backoff_ms < INFLUXDB_REPLAY_BACKOFF_MAX_MS / 2){
+		replay_backoff_ms *= 2;
+	}else{
+		replay_backoff_ms = INFLUXDB_REPLAY_BACKOFF_MAX_MS;
+	}
+	replay_retry_us = now + (int64_t) replay_backoff_ms * 1000;
+	http_stats.replay_failures++;
+	ESP_LOGW(TAG, "Replay failed, next attempt in %u ms", replay_backoff_ms);
 }
 
 /**
@@ -118,12 +536,78 @@ esp_err_t influxdb_init(uint8_t* uid)
 
 	config.host = CONFIG_INFLUXDB_IP;
 	config.port = CONFIG_INFLUXDB_PORT;
-	config.path = "/write?db=esp32_tst&precision=u";
+	snprintf(write_path, sizeof(write_path), "/write?db=esp32_tst&precision=u%s%s", uid[0] != 0 ? "&device=" : "", (const char*) uid);
+	config.path = write_path;
 	config.username = CONFIG_INFLUXDB_USERNAME;
 	config.password = CONFIG_INFLUXDB_PASSWORD;
 	config.event_handler = _http_event_handler;
 
-	ESP_LOGI(TAG, "init");
+	user_id = uid;
+	influxdb_gateway_setUid((const char*) uid);
+
+	if(batch.data == NULL && influxdb_batch_init(&batch, INFLUXDB_BATCH_INITIAL_CAPACITY) != ESP_OK){
+		ESP_LOGE(TAG, "Failed to allocate the batch buffer");
+		return ESP_FAIL;
+	}
+
+	if(replay_buffer == NULL){
+		replay_buffer = malloc(CONFIG_INFLUXDB_SPOOL_CHUNK_SIZE);
+		if(replay_buffer == NULL){
+			ESP_LOGE(TAG, "Failed to allocate the replay buffer");
+			return ESP_FAIL;
+		}
+	}
+
+#if INFLUXDB_FRAMES
+	if(frame.data == NULL){
+		frame.capacity = SAMPLE_FRAME_HEADER_SIZE
+				+ CONFIG_INFLUXDB_BATCH_SIZE * SAMPLE_FRAME_MAX_POINT_SIZE(CONFIG_SOCKETSENSE_SENSOR_COUNT * CONFIG_SOCKETSENSE_SENSEL_COUNT);
+		frame.data = malloc(frame.capacity);
+		if(frame.data == NULL){
+			ESP_LOGE(TAG, "Failed to allocate the frame buffer");
+			return ESP_FAIL;
+		}
+#if CONFIG_SOCKETSENSE_SENSOR_ACTIVE == 1
+		sample_frame_init(&frame, frame.data, frame.capacity, CONFIG_SOCKETSENSE_SENSOR_COUNT, CONFIG_SOCKETSENSE_SENSEL_COUNT,
+				CONFIG_INFLUXDB_FRAME_COMPRESSION);
+#else
+		sample_frame_init(&frame, frame.data, frame.capacity, 0, 0,
+				CONFIG_INFLUXDB_FRAME_COMPRESSION);							//like the line protocol, the frame carries no sensor elements
+#endif
+	}
+#endif
+
+#if INFLUXDB_EXPOSURE_FRAMES
+	if(exposure_frame == NULL){
+		exposure_frame = malloc(SAMPLE_FRAME_HEADER_SIZE + LINE_PROTOCOL_MAX_EXPOSURE_LENGTH);
+		if(exposure_frame == NULL){
+			ESP_LOGE(TAG, "Failed to allocate the exposure frame");
+			return ESP_FAIL;
+		}
+	}
+#endif
+
+#if INFLUXDB_COLUMNS
+#if CONFIG_SOCKETSENSE_SENSOR_ACTIVE == 1
+	if(sd_columns_init(CONFIG_SOCKETSENSE_SENSOR_COUNT, CONFIG_SOCKETSENSE_SENSEL_COUNT) != ESP_OK){
+#else
+	if(sd_columns_init(0, 0) != ESP_OK){
+#endif
+		ESP_LOGE(TAG, "Failed to initialize the column log");
+		return ESP_FAIL;
+	}
+#endif
+
+#if CONFIG_INFLUXDB_ENCODER_BENCHMARK == 1
+	if(line_protocol_benchmark(1000) != ESP_OK){
+		return ESP_FAIL;
+	}
+#endif
+
+	ESP_LOGI(TAG, "init, batches of up to %u points or %u ms", CONFIG_INFLUXDB_BATCH_SIZE, CONFIG_INFLUXDB_BATCH_TIMEOUT_MS);
+#if CONFIG_INFLUXDB_GATEWAY_ENABLED == 1
+	ESP_LOGI(TAG, "sending binary frames to the gateway %s:%d", CONFIG_INFLUXDB_GATEWAY_IP, CONFIG_INFLUXDB_GATEWAY_PORT);
+#endif
 
 	return ESP_OK;
 }
@@ -131,59 +615,103 @@ esp_err_t influxdb_init(uint8_t* uid)
 void influxdb_task(void * pvParameters){
 
 	TickType_t xLastWakeTime;
-	SocketSense_Sample_t data;
+	SocketSense_Sample_t *data;
+	sample_handle_t handle;
+	sample_pool_stats_t pool_stats;
+	uint32_t batches;
 
 	ESP_LOGI(TAG, "task started on core=%i", xPortGetCoreID());
 
 	xLastWakeTime = xTaskGetTickCount();
+	replay_refill_us = esp_timer_get_time();
 
 	while(1){
+		batches = http_stats.batches;
 
-		while(xQueueReceive(data_queue, &data, 0) == pdTRUE){
+		while((data = sample_pool_receive(&handle)) != NULL){			//the sample stays in its pool slot until it is released
 #if CONFIG_BME280_SENSOR_ACTIVE == 1
-			ESP_LOGI(TAG, "Temperature: %.2foC, Humidity: %.2f%%, Pressure: %.2fPa",
-							(double) data.bme280_data.temperature,
-							(double) data.bme280_data.humidity,
-							(double) data.bme280_data.pressure);
+			ESP_LOGD(TAG, "Temperature: %.2foC, Humidity: %.2f%%, Pressure: %.2fPa",
+							(double) data->bme280_data.temperature,
+							(double) data->bme280_data.humidity,
+							(double) data->bme280_data.pressure);
 #endif
 #if CONFIG_SOCKETSENSE_SENSOR_ACTIVE == 1
 			for(int i = 0; i < CONFIG_SOCKETSENSE_SENSOR_COUNT; i++){
-				ESP_LOGI(TAG, "SensorStrip-%.2i: SE1: %.4i SE2: %.4i SE3: %.4i SE4: %.4i SE5: %.4i SE6: %.4i SE7: %.4i SE8: %.4i", i,
-							data.sensorstrip_data[i][0],
-							data.sensorstrip_data[i][1],
-							data.sensorstrip_data[i][2],
-							data.sensorstrip_data[i][3],
-							data.sensorstrip_data[i][4],
-							data.sensorstrip_data[i][5],
-							data.sensorstrip_data[i][6],
-							data.sensorstrip_data[i][7]);
+				ESP_LOGD(TAG, "SensorStrip-%.2i: SE1: %.4i SE2: %.4i SE3: %.4i SE4: %.4i SE5: %.4i SE6: %.4i SE7: %.4i SE8: %.4i", i,
+							data->sensorstrip_data[i][0],
+							data->sensorstrip_data[i][1],
+							data->sensorstrip_data[i][2],
+							data->sensorstrip_data[i][3],
+							data->sensorstrip_data[i][4],
+							data->sensorstrip_data[i][5],
+							data->sensorstrip_data[i][6],
+							data->sensorstrip_data[i][7]);
 			}
 #endif
-			ESP_LOGI(TAG, "Sample Time: %u usec", data.sampling_time);
-			ESP_LOGI(TAG, "Battery Voltage: %u mV", data.battery_voltage);
+			ESP_LOGD(TAG, "Sample Time: %u usec", data->sampling_time);
+			ESP_LOGD(TAG, "Battery Voltage: %u mV", data->battery_voltage);
+			ESP_LOGD(TAG, "Activity: 0x%08x", data->activity);
 			influxdb_post_data(data);
+			sample_pool_release(handle);
+
+			if(batch.points >= CONFIG_INFLUXDB_BATCH_SIZE){
+				influxdb_flush();
+			}
+		}
+
+		if(influxdb_batch_isDue(&batch, CONFIG_INFLUXDB_BATCH_SIZE, CONFIG_INFLUXDB_BATCH_TIMEOUT_MS)){
+			influxdb_flush();
+		}
+
+		if(network_attached == 1 && http_stats.batches == batches){		//at most one request per period, live batches first
+			influxdb_replay();
 		}
 
+#if INFLUXDB_COLUMNS
+		sd_columns_poll();												//the last samples are logged even if the data collection stopped
+#endif
+
+		sample_pool_getStatistics(&pool_stats);
+		ESP_LOGD(TAG, "Sample pool: occupancy %u (max %u), published %u, overflows %u",
+				pool_stats.occupancy, pool_stats.max_occupancy, pool_stats.published, pool_stats.overflows);
+		ESP_LOGD(TAG, "HTTP: %u requests, %u failed, %u reused, %u reconnects",
+				http_stats.requests, http_stats.failed, http_stats.reused, http_stats.reconnects);
+		ESP_LOGD(TAG, "Batches: %u, %u points, %u bytes (%u frame bytes), flush latency avg %u usec max %u usec",
+				http_stats.batches, http_stats.points, http_stats.bytes, http_stats.frame_bytes, http_stats.avg_flush_latency_us, http_stats.max_flush_latency_us);
+		ESP_LOGD(TAG, "Deadband: %u line protocol bytes left out", http_stats.deadband_saved_bytes);
+		ESP_LOGD(TAG, "Spool: depth %u bytes, %u spooled, %u replayed (%u points) at %u B/s, %u failed chunks, %u bytes dropped",
+				http_stats.spool_depth, http_stats.spooled_bytes, http_stats.replayed_bytes, http_stats.replayed_points, http_stats.replay_bytes_per_s,
+				http_stats.replay_failures, http_stats.spool_dropped_bytes);
+
 		vTaskDelayUntil( &xLastWakeTime, INFLUXDB_TASK_PERIOD_MS / portTICK_PERIOD_MS );
 	}
 }
 
-esp_err_t influxdb_enable()
+esp_err_t influxdb_start()
 {
 
 	if(influxdb_handle == NULL){	//only do this if the task was not already created
-		ESP_LOGI(TAG, "enabled");
+		ESP_LOGI(TAG, "start");
 		xTaskCreatePinnedToCore(influxdb_task, "influxdb", 10000, NULL, 1, &influxdb_handle, INFLUXDB_CPU);
 	}
 
 	return ESP_OK;
 }
 
+esp_err_t influxdb_enable()
+{
+	ESP_LOGI(TAG, "enabled");
+
+	network_attached = 1;
+
+	return influxdb_start();
+}
+
 esp_err_t influxdb_disable()
 {
 	ESP_LOGI(TAG, "disabled");
 
-	vTaskDelete(influxdb_handle);
+	network_attached = 0;
 
 	return ESP_OK;
 }
@@ -192,7 +720,29 @@ esp_err_t influxdb_deinit()
 {
 
 	influxdb_disable();
+
+	if(influxdb_handle != NULL){
+		vTaskDelete(influxdb_handle);
+		influxdb_handle = NULL;
+	}
+
+	if(client != NULL){
+		esp_http_client_cleanup(client);
+		client = NULL;
+	}
+	influxdb_gateway_close();
 	ESP_LOGI(TAG, "deinit");
 
 	return ESP_OK;
 }
+
+esp_err_t influxdb_getStatistics(influxdb_stats_t *stats)
+{
+	if(stats == NULL){
+		return ESP_FAIL;
+	}
+
+	memcpy(stats, &http_stats, sizeof(influxdb_stats_t));
+
+	return ESP_OK;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file influxdb_batch.c
+ * @brief Growable buffer that collects several samples as one line protocol body.
+ *
+ * @date October 17. 2026
+ */
+#include <string.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+#include "esp_system.h"
+#include "esp_log.h"
+#include <esp_err.h>
+#include "esp_timer.h"
+
+#include "influxdb_batch.h"
+#include "line_protocol.h"
+
+static const char *TAG = "INFLUX_DB_BATCH";
+
+esp_err_t influxdb_batch_init(influxdb_batch_t *batch, size_t capacity)
+{
+	memset(batch, 0, sizeof(influxdb_batch_t));
+
+	batch->data = malloc(capacity);
+	if(batch->data == NULL){
+		ESP_LOGE(TAG, "Failed to allocate %u bytes", (unsigned int) capacity);
+		return ESP_ERR_NO_MEM;
+	}
+	batch->data[0] = '\0';
+	batch->capacity = capacity;
+
+	return ESP_OK;
+}
+
+void influxdb_batch_free(influxdb_batch_t *batch)
+{
+	free(batch->data);
+	memset(batch, 0, sizeof(influxdb_batch_t));
+}
+
+esp_err_t influxdb_batch_reserve(influxdb_batch_t *batch, size_t additional)
+{
+	size_t required = batch->length + additional + 1;
+	size_t capacity = batch->capacity;
+	char *data;
+
+	if(required <= capacity){
+		return ESP_OK;
+	}
+
+	while(capacity < required){
+		capacity *= 2;
+	}
+
+	data = realloc(batch->data, capacity);
+	if(data == NULL){
+		ESP_LOGE(TAG, "Failed to grow the batch to %u bytes", (unsigned int) capacity);
+		return ESP_ERR_NO_MEM;
+	}
+
+	ESP_LOGD(TAG, "Batch grown to %u bytes", (unsigned int) capacity);
+	batch->data = data;
+	batch->capacity = capacity;
+
+	return ESP_OK;
+}
+
+esp_err_t influxdb_batch_append(influxdb_batch_t *batch, const SocketSense_Sample_t *sample)
+{
+	if(influxdb_batch_reserve(batch, LINE_PROTOCOL_MAX_SAMPLE_LENGTH + 1) != ESP_OK){		//room for the separator and one point
+		return ESP_ERR_NO_MEM;
+	}
+
+	if(batch->points > 0){										//points are separated by a newline
+		batch->data[batch->length++] = '\n';
+	}else{
+		batch->first_point_us = esp_timer_get_time();
+	}
+
+	batch->length += line_protocol_encodeSample(&batch->data[batch->length], sample);
+	batch->data[batch->length] = '\0';
+	batch->points++;
+
+	return ESP_OK;
+}
+
+esp_err_t influxdb_batch_appendExposure(influxdb_batch_t *batch, const SocketSense_Exposure_t *exposure)
+{
+	if(influxdb_batch_reserve(batch, LINE_PROTOCOL_MAX_EXPOSURE_LENGTH + 1) != ESP_OK){
+		return ESP_ERR_NO_MEM;
+	}
+
+	batch->data[batch->length++] = '\n';
+	batch->length += line_protocol_encodeExposure(&batch->data[batch->length], exposure);
+	batch->data[batch->length] = '\0';
+
+	return ESP_OK;
+}
+
+void influxdb_batch_clear(influxdb_batch_t *batch)
+{
+	batch->length = 0;
+	batch->points = 0;
+	batch->first_point_us = 0;
+	if(batch->data != NULL){
+		batch->data[0] = '\0';
+	}
+}
+
+uint8_t influxdb_batch_isDue(const influxdb_batch_t *batch, uint32_t max_points, uint32_t max_age_ms)
+{
+	if(batch->points == 0){
+		return 0;
+	}
+
+	if(batch->points >= max_points){
+		return 1;
+	}
+
+	if(esp_timer_get_time() - batch->first_point_us >= (int64_t) max_age_ms * 1000){
+		return 1;
+	}
+
+	return 0;
+}
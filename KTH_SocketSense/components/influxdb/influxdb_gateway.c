@@ -0,0 +1,158 @@
+/**
+ * @file influxdb_gateway.c
+ * @brief TCP connection to the ingest gateway that receives samples in the binary frame format.
+ *
+ * @date October 17. 2026
+ */
+#include <string.h>
+#include <stddef.h>
+
+#include "esp_system.h"
+#include "esp_log.h"
+#include <esp_err.h>
+
+#include "lwip/sockets.h"
+
+#include "sample_frame.h"
+#include "influxdb_gateway.h"
+#include "KTHSocketSense.h"
+
+static const char *TAG = "INFLUX_GW";
+
+int gateway_socket = -1;					//connection to the gateway, -1 if not connected
+const char *gateway_uid = "";
+
+/*****Private Functions Definitions*************************************************/
+
+esp_err_t influxdb_gateway_connect();
+esp_err_t influxdb_gateway_write(const uint8_t *data, size_t length);
+esp_err_t influxdb_gateway_readAck(uint32_t sequence);
+
+/*****Public Functions**************************************************************/
+
+void influxdb_gateway_setUid(const char *uid)
+{
+	gateway_uid = uid;
+}
+
+esp_err_t influxdb_gateway_send(const uint8_t *frame, size_t length, uint32_t sequence, uint8_t *connected)
+{
+	int attempt;
+
+	*connected = 0;
+
+	for(attempt = 0; attempt < 2; attempt++){
+		if(gateway_socket < 0){
+			if(influxdb_gateway_connect() != ESP_OK){
+				return ESP_FAIL;
+			}
+			*connected = 1;
+		}
+
+		if(influxdb_gateway_write(frame, length) == ESP_OK && influxdb_gateway_readAck(sequence) == ESP_OK){
+			return ESP_OK;
+		}
+
+		ESP_LOGE(TAG, "Frame %u was not acknowledged", sequence);
+		influxdb_gateway_close();								//drop the broken connection, the next attempt reconnects
+	}
+
+	return ESP_FAIL;
+}
+
+void influxdb_gateway_close()
+{
+	if(gateway_socket >= 0){
+		close(gateway_socket);
+		gateway_socket = -1;
+	}
+}
+
+/*****Private Functions*************************************************************/
+
+/**
+ * Opens the connection and sends the hello frame.
+ */
+esp_err_t influxdb_gateway_connect()
+{
+	struct sockaddr_in addr;
+	struct timeval timeout;
+	uint8_t hello[SAMPLE_FRAME_HEADER_SIZE + 32];
+	size_t len;
+	int flag = 1;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(CONFIG_INFLUXDB_GATEWAY_PORT);
+	addr.sin_addr.s_addr = inet_addr(CONFIG_INFLUXDB_GATEWAY_IP);
+
+	gateway_socket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if(gateway_socket < 0){
+		ESP_LOGE(TAG, "Failed to create the socket");
+		return ESP_FAIL;
+	}
+
+	timeout.tv_sec = INFLUXDB_GATEWAY_TIMEOUT_MS / 1000;
+	timeout.tv_usec = (INFLUXDB_GATEWAY_TIMEOUT_MS % 1000) * 1000;
+	setsockopt(gateway_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+	setsockopt(gateway_socket, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+	setsockopt(gateway_socket, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));	//a frame is written at once, don't wait for more
+
+	if(connect(gateway_socket, (struct sockaddr*) &addr, sizeof(addr)) != 0){
+		ESP_LOGE(TAG, "Failed to connect to %s:%d", CONFIG_INFLUXDB_GATEWAY_IP, CONFIG_INFLUXDB_GATEWAY_PORT);
+		influxdb_gateway_close();
+		return ESP_FAIL;
+	}
+
+	len = sample_frame_writeHello(hello, sizeof(hello), gateway_uid, CONFIG_SOCKETSENSE_SENSOR_COUNT, CONFIG_SOCKETSENSE_SENSEL_COUNT);
+	if(len == 0 || influxdb_gateway_write(hello, len) != ESP_OK){
+		ESP_LOGE(TAG, "Failed to send the hello frame");
+		influxdb_gateway_close();
+		return ESP_FAIL;
+	}
+
+	ESP_LOGI(TAG, "Connected to %s:%d", CONFIG_INFLUXDB_GATEWAY_IP, CONFIG_INFLUXDB_GATEWAY_PORT);
+
+	return ESP_OK;
+}
+
+esp_err_t influxdb_gateway_write(const uint8_t *data, size_t length)
+{
+	int sent;
+
+	while(length > 0){
+		sent = send(gateway_socket, data, length, 0);
+		if(sent <= 0){
+			return ESP_FAIL;
+		}
+		data += sent;
+		length -= sent;
+	}
+
+	return ESP_OK;
+}
+
+/**
+ * Waits for the acknowledgement of the given frame.
+ */
+esp_err_t influxdb_gateway_readAck(uint32_t sequence)
+{
+	uint8_t ack[SAMPLE_FRAME_ACK_SIZE];
+	size_t received = 0;
+	int len;
+
+	while(received < sizeof(ack)){
+		len = recv(gateway_socket, ack + received, sizeof(ack) - received, 0);
+		if(len <= 0){
+			return ESP_FAIL;
+		}
+		received += len;
+	}
+
+	if((ack[0] | (ack[1] << 8) | (ack[2] << 16) | ((uint32_t) ack[3] << 24)) != sequence){
+		ESP_LOGE(TAG, "Unexpected acknowledgement");
+		return ESP_FAIL;
+	}
+
+	return ESP_OK;
+}
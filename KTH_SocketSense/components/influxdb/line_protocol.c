@@ -0,0 +1,560 @@
+/**
+ * @file line_protocol.c
+ * @brief Encoder that writes a sample in the InfluxDB line protocol.
+ *
+ * The integer formatter writes two digits per step from a lookup table, which halves the number of divisions.
+ *
+ * @date October 17. 2026
+ */
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include <inttypes.h>
+#include <math.h>
+
+#include "esp_system.h"
+#include "esp_log.h"
+#include <esp_err.h>
+#include "esp_timer.h"
+
+#include "line_protocol.h"
+#include "sample_frame.h"
+#include "gait_monitor.h"
+
+static const char *TAG = "LINE_PROTOCOL";
+
+#define LINE_PROTOCOL_BENCHMARK_FRAME_POINTS 50
+
+static const char digit_pairs[201] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+/*****Private Functions Definitions*************************************************/
+
+char* line_protocol_writeField(char *dst, const char *key, size_t key_length);
+char* line_protocol_writeTag(char *dst, const char *key, size_t key_length, const char *value);
+uint8_t line_protocol_isSuppressed(const SocketSense_Sample_t *sample, uint32_t index);
+uint32_t line_protocol_digits(uint32_t value);
+void line_protocol_benchmarkFrames(SocketSense_Sample_t *sample, uint32_t iterations, uint8_t encoding);
+size_t line_protocol_formatReference(char *dst, const SocketSense_Sample_t *sample);
+
+/*****Public Functions**************************************************************/
+
+char* line_protocol_writeUInt32(char *dst, uint32_t value)
+{
+	char tmp[10];
+	char *pos = &tmp[10];
+	size_t len;
+
+	while(value >= 100){
+		uint32_t pair = (value % 100) * 2;
+		value /= 100;
+		*--pos = digit_pairs[pair + 1];
+		*--pos = digit_pairs[pair];
+	}
+	if(value >= 10){
+		*--pos = digit_pairs[value * 2 + 1];
+		*--pos = digit_pairs[value * 2];
+	}else{
+		*--pos = (char)('0' + value);
+	}
+
+	len = &tmp[10] - pos;
+	memcpy(dst, pos, len);
+
+	return dst + len;
+}
+
+char* line_protocol_writeUInt64(char *dst, uint64_t value)
+{
+	uint64_t high;
+	uint32_t low;
+	int i;
+
+	if(value <= UINT32_MAX){
+		return line_protocol_writeUInt32(dst, (uint32_t) value);
+	}
+
+	high = value / 1000000000ULL;											//split off the lower 9 digits, the rest is formatted with 32 bit divisions
+	low = (uint32_t)(value % 1000000000ULL);
+
+	dst = line_protocol_writeUInt64(dst, high);
+	for(i = 8; i >= 0; i--){												//the lower chunk is zero padded
+		dst[i] = (char)('0' + low % 10);
+		low /= 10;
+	}
+
+	return dst + 9;
+}
+
+char* line_protocol_writeFixed2(char *dst, float value)
+{
+	int32_t integer;
+	float fraction;
+	double cents;
+	uint32_t hundredths;
+
+	if(!(value == value)){													//NaN
+		value = 0;
+	}
+	if(value > 10000000.0f){
+		value = 10000000.0f;
+	}
+	if(value < -10000000.0f){
+		value = -10000000.0f;
+	}
+	if(signbit(value)){
+		*dst++ = '-';
+		value = -value;
+	}
+
+	integer = (int32_t) value;												//the float is split without rounding, value * 100 is not exact above 2^23 / 100
+	fraction = value - (float) integer;										//exact, the integer part is at least as coarse as the value
+	cents = (double) fraction * 100.0;										//exact, 24 bits times 7 bits fit into a double
+	hundredths = (uint32_t) cents;
+	cents -= hundredths;
+	if(cents > 0.5 || (cents == 0.5 && (hundredths & 1) != 0)){				//round half to even, like printf
+		hundredths++;
+	}
+	if(hundredths == 100){
+		integer++;
+		hundredths = 0;
+	}
+
+	dst = line_protocol_writeUInt32(dst, (uint32_t) integer);
+	*dst++ = '.';
+	*dst++ = digit_pairs[hundredths * 2];
+	*dst++ = digit_pairs[hundredths * 2 + 1];
+
+	return dst;
+}
+
+size_t line_protocol_encodeSample(char *dst, const SocketSense_Sample_t *sample)
+{
+	char *pos = dst;
+	uint32_t sensor_id;
+	uint32_t sensel_id;
+#if CONFIG_GAIT_SENSOR_ACTIVE == 1
+	const char *phase;
+#endif
+
+#if CONFIG_DATA_COLLECTOR_FEATURES > 0
+	if(sample->summary_only > 0){
+		return line_protocol_encodeFeatures(dst, sample);					//only the summary is reported
+	}
+#endif
+
+#if CONFIG_GAIT_SENSOR_ACTIVE == 1
+	memcpy(pos, "socket_data", 11);
+	pos += 11;
+	pos = line_protocol_writeTag(pos, ",activity=", 10, gait_monitor_getActivityName(sample->activity));
+	phase = gait_monitor_getPhaseName(sample->activity);
+	if(phase != NULL){
+		pos = line_protocol_writeTag(pos, ",phase=", 7, phase);				//no tag outside of the gait cycle
+	}
+	memcpy(pos, " temp=", 6);
+	pos += 6;
+#else
+	memcpy(pos, "socket_data temp=", 17);
+	pos += 17;
+#endif
+	pos = line_protocol_writeFixed2(pos, sample->bme280_data.temperature);
+	pos = line_protocol_writeField(pos, ",hum=", 5);
+	pos = line_protocol_writeFixed2(pos, sample->bme280_data.humidity);
+	pos = line_protocol_writeField(pos, ",pres=", 6);
+	pos = line_protocol_writeFixed2(pos, sample->bme280_data.pressure);
+	pos = line_protocol_writeField(pos, ",st=", 4);
+	pos = line_protocol_writeUInt32(pos, sample->sampling_time);
+	pos = line_protocol_writeField(pos, ",bl=", 4);
+	pos = line_protocol_writeUInt32(pos, sample->battery_voltage);
+#if CONFIG_GAIT_SENSOR_ACTIVE == 1
+	pos = line_protocol_writeField(pos, ",act=", 5);
+	pos = line_protocol_writeUInt32(pos, sample->activity);
+	*pos++ = 'i';
+#endif
+
+#if CONFIG_SOCKETSENSE_SENSOR_ACTIVE == 1
+	for(sensor_id = 0; sensor_id < CONFIG_SOCKETSENSE_SENSOR_COUNT; sensor_id++){
+		for(sensel_id = 0; sensel_id < CONFIG_SOCKETSENSE_SENSEL_COUNT; sensel_id++){
+#if SOCKETSENSE_DEADBAND_ENABLED
+			if(line_protocol_isSuppressed(sample, sensor_id * CONFIG_SOCKETSENSE_SENSEL_COUNT + sensel_id)){
+				continue;													//within the deadband, the last reported value still holds
+			}
+#endif
+			*pos++ = ',';													//field key s<strip>_<sensel>
+			*pos++ = 's';
+			*pos++ = (char)('0' + sensor_id);
+			*pos++ = '_';
+			pos = line_protocol_writeUInt32(pos, sensel_id);
+			*pos++ = '=';
+			pos = line_protocol_writeUInt32(pos, sample->sensorstrip_data[sensor_id][sensel_id]);
+			*pos++ = 'i';													//integer field
+		}
+	}
+#endif
+
+	*pos++ = ' ';
+	pos = line_protocol_writeUInt64(pos, sample->timestamp_usec);
+
+#if CONFIG_DATA_COLLECTOR_FEATURES > 0
+	if(sample->features.samples > 0){
+		*pos++ = '\n';
+		pos += line_protocol_encodeFeatures(pos, sample);
+	}
+#endif
+
+	return pos - dst;
+}
+
+size_t line_protocol_encodeFeatures(char *dst, const SocketSense_Sample_t *sample)
+{
+	const SocketSense_Features_t *features = &sample->features;
+	char *pos = dst;
+	uint32_t sensor_id;
+
+	memcpy(pos, "socket_features n=", 18);
+	pos += 18;
+	pos = line_protocol_writeUInt32(pos, features->samples);
+	pos = line_protocol_writeField(pos, "i,load=", 7);
+	pos = line_protocol_writeUInt32(pos, features->mean_load);
+	pos = line_protocol_writeField(pos, "i,peak=", 7);
+	pos = line_protocol_writeUInt32(pos, features->peak);
+	pos = line_protocol_writeField(pos, "i,peak_s=", 9);
+	pos = line_protocol_writeUInt32(pos, features->peak_strip);
+	pos = line_protocol_writeField(pos, "i,peak_e=", 9);
+	pos = line_protocol_writeUInt32(pos, features->peak_sensel);
+	pos = line_protocol_writeField(pos, "i,cop_s=", 8);
+	pos = line_protocol_writeFixed2(pos, features->cop_strip / 256.0f);
+	pos = line_protocol_writeField(pos, ",cop_e=", 7);
+	pos = line_protocol_writeFixed2(pos, features->cop_sensel / 256.0f);
+	for(sensor_id = 0; sensor_id < CONFIG_SOCKETSENSE_SENSOR_COUNT; sensor_id++){
+		pos = line_protocol_writeField(pos, ",ls", 3);
+		pos = line_protocol_writeUInt32(pos, sensor_id);
+		*pos++ = '=';
+		pos = line_protocol_writeFixed2(pos, features->load_share[sensor_id] / 100.0f);
+	}
+	pos = line_protocol_writeField(pos, ",cpu_ns=", 8);
+	pos = line_protocol_writeUInt32(pos, features->cost_avg_ns);
+	pos = line_protocol_writeField(pos, "i,cpu_max_ns=", 13);
+	pos = line_protocol_writeUInt32(pos, features->cost_max_ns);
+	*pos++ = 'i';
+
+	*pos++ = ' ';
+	pos = line_protocol_writeUInt64(pos, sample->timestamp_usec);
+
+	return pos - dst;
+}
+
+size_t line_protocol_encodeExposure(char *dst, const SocketSense_Exposure_t *exposure)
+{
+	char *pos = dst;
+	uint32_t sensor_id;
+	uint32_t sensel_id;
+	uint32_t bin;
+
+	memcpy(pos, "socket_exposure dur=", 20);
+	pos += 20;
+	pos = line_protocol_writeUInt64(pos, exposure->duration_ms / 1000);
+	pos = line_protocol_writeField(pos, "i,since=", 8);
+	pos = line_protocol_writeUInt64(pos, exposure->start_usec);
+	pos = line_protocol_writeField(pos, "i,thr=", 6);
+	pos = line_protocol_writeUInt32(pos, exposure->threshold);
+	*pos++ = 'i';
+
+	for(sensor_id = 0; sensor_id < CONFIG_SOCKETSENSE_SENSOR_COUNT; sensor_id++){
+		if(sensor_id > 0){														//one line per strip, merged into one point
+			*pos++ = ' ';
+			pos = line_protocol_writeUInt64(pos, exposure->timestamp_usec);
+			memcpy(pos, "\nsocket_exposure ", 17);
+			pos += 17;
+		}
+		for(sensel_id = 0; sensel_id < CONFIG_SOCKETSENSE_SENSEL_COUNT; sensel_id++){
+			if(sensor_id > 0 && sensel_id == 0){
+				*pos++ = 'p';
+			}else{
+				pos = line_protocol_writeField(pos, ",p", 2);						//field keys p<strip>_<sensel> etc.
+			}
+			*pos++ = (char)('0' + sensor_id);
+			*pos++ = '_';
+			pos = line_protocol_writeUInt32(pos, sensel_id);
+			*pos++ = '=';
+			pos = line_protocol_writeUInt64(pos, exposure->integral[sensor_id][sensel_id] / 1000);
+			pos = line_protocol_writeField(pos, "i,a", 3);
+			*pos++ = (char)('0' + sensor_id);
+			*pos++ = '_';
+			pos = line_protocol_writeUInt32(pos, sensel_id);
+			*pos++ = '=';
+			pos = line_protocol_writeUInt64(pos, exposure->above_ms[sensor_id][sensel_id] / 1000);
+			pos = line_protocol_writeField(pos, "i,h", 3);
+			*pos++ = (char)('0' + sensor_id);
+			*pos++ = '_';
+			pos = line_protocol_writeUInt32(pos, sensel_id);
+			pos = line_protocol_writeField(pos, "=\"", 2);							//string field with the bins
+			for(bin = 0; bin < SOCKETSENSE_EXPOSURE_BINS; bin++){
+				if(bin > 0){
+					*pos++ = ',';
+				}
+				pos = line_protocol_writeUInt32(pos, exposure->histogram[sensor_id][sensel_id][bin] / 1000);
+			}
+			*pos++ = '"';
+		}
+	}
+
+	*pos++ = ' ';
+	pos = line_protocol_writeUInt64(pos, exposure->timestamp_usec);
+
+	return pos - dst;
+}
+
+size_t line_protocol_suppressedLength(const SocketSense_Sample_t *sample)
+{
+	size_t length = 0;
+#if CONFIG_SOCKETSENSE_SENSOR_ACTIVE == 1 && SOCKETSENSE_DEADBAND_ENABLED
+	uint32_t sensor_id;
+	uint32_t sensel_id;
+
+	if(sample->keyframe != 0){
+		return 0;
+	}
+
+	for(sensor_id = 0; sensor_id < CONFIG_SOCKETSENSE_SENSOR_COUNT; sensor_id++){
+		for(sensel_id = 0; sensel_id < CONFIG_SOCKETSENSE_SENSEL_COUNT; sensel_id++){
+			if(line_protocol_isSuppressed(sample, sensor_id * CONFIG_SOCKETSENSE_SENSEL_COUNT + sensel_id)){
+				length += 6 + line_protocol_digits(sensel_id)						//",s" strip "_" sensel "=" value "i"
+						+ line_protocol_digits(sample->sensorstrip_data[sensor_id][sensel_id]);
+			}
+		}
+	}
+#endif
+
+	return length;
+}
+
+esp_err_t line_protocol_benchmark(uint32_t iterations)
+{
+	static char output[LINE_PROTOCOL_MAX_SAMPLE_LENGTH + 1];
+	static char reference[LINE_PROTOCOL_MAX_SAMPLE_LENGTH + 1];
+	SocketSense_Sample_t sample;
+	uint32_t i;
+	uint32_t sensor_id;
+	uint32_t sensel_id;
+	uint32_t mismatches = 0;
+	uint64_t bytes = 0;
+	int64_t start;
+	int64_t duration;
+	size_t length;
+
+	memset(&sample, 0, sizeof(sample));
+	sample.keyframe = 1;															//all sensor elements are encoded
+	sample.timestamp_usec = 1571234567890123ULL;
+	sample.sampling_time = 2480;
+	sample.battery_voltage = 3950;
+	for(sensor_id = 0; sensor_id < CONFIG_SOCKETSENSE_SENSOR_COUNT; sensor_id++){
+		for(sensel_id = 0; sensel_id < CONFIG_SOCKETSENSE_SENSEL_COUNT; sensel_id++){
+			sample.sensorstrip_data[sensor_id][sensel_id] = (uint16_t)((sensor_id * 997 + sensel_id * 263) & 0x0FFF);
+		}
+	}
+
+	for(i = 0; i < iterations; i++){										//the encoder has to write the same bytes as sprintf
+		sample.bme280_data.temperature = -20.0f + i * 59.9731f / iterations;
+		sample.bme280_data.humidity = i * 99.9877f / iterations;
+		sample.bme280_data.pressure = 90000.0f + i * 19999.3711f / iterations;		//the range of the BME280 where a float has 2^-7 Pa steps
+		length = line_protocol_encodeSample(output, &sample);
+		output[length] = '\0';
+		if(length != line_protocol_formatReference(reference, &sample) || memcmp(output, reference, length) != 0){
+			if(mismatches == 0){
+				ESP_LOGE(TAG, "Encoder: %s", output);
+				ESP_LOGE(TAG, "sprintf: %s", reference);
+			}
+			mismatches++;
+		}
+	}
+	if(mismatches > 0){
+		ESP_LOGE(TAG, "The encoder output differs from sprintf in %u of %u samples", mismatches, iterations);
+		return ESP_FAIL;
+	}
+
+	sample.bme280_data.temperature = 23.57f;
+	sample.bme280_data.humidity = 41.23f;
+	sample.bme280_data.pressure = 101325.42f;
+
+	start = esp_timer_get_time();
+	for(i = 0; i < iterations; i++){
+		sample.timestamp_usec += 10000;
+		bytes += line_protocol_encodeSample(output, &sample);
+	}
+	duration = esp_timer_get_time() - start;
+	if(duration <= 0){
+		duration = 1;
+	}
+
+	ESP_LOGI(TAG, "Encoder (%ix%i sensels): %u samples, %u bytes in %" PRId64 " usec, %" PRIu64 " bytes/s, %" PRIu64 " samples/s",
+			CONFIG_SOCKETSENSE_SENSOR_COUNT, CONFIG_SOCKETSENSE_SENSEL_COUNT, iterations, (uint32_t) bytes, duration,
+			(uint64_t)(bytes * 1000000ULL / duration), (uint64_t)(iterations * 1000000ULL / duration));
+
+	bytes = 0;
+	start = esp_timer_get_time();
+	for(i = 0; i < iterations; i++){										//reference: the same payload built with sprintf
+		sample.timestamp_usec += 10000;
+		bytes += line_protocol_formatReference(reference, &sample);
+	}
+	duration = esp_timer_get_time() - start;
+	if(duration <= 0){
+		duration = 1;
+	}
+
+	ESP_LOGI(TAG, "sprintf (%ix%i sensels): %u samples, %u bytes in %" PRId64 " usec, %" PRIu64 " bytes/s, %" PRIu64 " samples/s",
+			CONFIG_SOCKETSENSE_SENSOR_COUNT, CONFIG_SOCKETSENSE_SENSEL_COUNT, iterations, (uint32_t) bytes, duration,
+			(uint64_t)(bytes * 1000000ULL / duration), (uint64_t)(iterations * 1000000ULL / duration));
+
+	line_protocol_benchmarkFrames(&sample, iterations, SAMPLE_FRAME_ENCODING_PACKED);
+	line_protocol_benchmarkFrames(&sample, iterations, SAMPLE_FRAME_ENCODING_GORILLA);
+
+	return ESP_OK;
+}
+
+/*****Private Functions*************************************************************/
+
+/**
+ * Copies a constant field key (including the separator and the equal sign).
+ */
+char* line_protocol_writeField(char *dst, const char *key, size_t key_length)
+{
+	memcpy(dst, key, key_length);
+	return dst + key_length;
+}
+
+/**
+ * Copies a tag key (including the separator and the equal sign) and a value that needs no escaping.
+ */
+char* line_protocol_writeTag(char *dst, const char *key, size_t key_length, const char *value)
+{
+	size_t value_length = strlen(value);
+
+	memcpy(dst, key, key_length);
+	memcpy(dst + key_length, value, value_length);
+	return dst + key_length + value_length;
+}
+
+/**
+ * Returns 1 if the sensor element with the given index is not reported in this sample (deadband).
+ */
+uint8_t line_protocol_isSuppressed(const SocketSense_Sample_t *sample, uint32_t index)
+{
+	return sample->keyframe == 0 && (sample->sensel_mask[index >> 3] & (1 << (index & 7))) == 0;
+}
+
+/**
+ * Returns the number of decimal digits of value.
+ */
+uint32_t line_protocol_digits(uint32_t value)
+{
+	uint32_t digits = 1;
+
+	while(value >= 10){
+		value /= 10;
+		digits++;
+	}
+
+	return digits;
+}
+
+/**
+ * Measures the cost of adding samples to frames of LINE_PROTOCOL_BENCHMARK_FRAME_POINTS points.
+ * The BME280 values and the sensor elements change slowly like in a recording, so that the Gorilla encoding
+ * compresses about as well as on real data.
+ */
+void line_protocol_benchmarkFrames(SocketSense_Sample_t *sample, uint32_t iterations, uint8_t encoding)
+{
+	static uint8_t buffer[SAMPLE_FRAME_HEADER_SIZE
+			+ LINE_PROTOCOL_BENCHMARK_FRAME_POINTS * SAMPLE_FRAME_MAX_POINT_SIZE(CONFIG_SOCKETSENSE_SENSOR_COUNT * CONFIG_SOCKETSENSE_SENSEL_COUNT)];
+	sample_frame_t frame;
+	sample_frame_point_t point;
+	uint32_t i;
+	uint32_t sensel;
+	uint64_t bytes = 0;
+	int64_t start;
+	int64_t duration;
+
+	sample_frame_init(&frame, buffer, sizeof(buffer), CONFIG_SOCKETSENSE_SENSOR_COUNT, CONFIG_SOCKETSENSE_SENSEL_COUNT, encoding);
+	point.temperature = sample->bme280_data.temperature;
+	point.humidity = sample->bme280_data.humidity;
+	point.pressure = sample->bme280_data.pressure;
+	point.sampling_time = sample->sampling_time;
+	point.battery_voltage = sample->battery_voltage;
+	point.sensels = &sample->sensorstrip_data[0][0];
+	point.sensel_mask = NULL;
+
+	start = esp_timer_get_time();
+	for(i = 0; i < iterations; i++){
+		sample->timestamp_usec += 10000 + (i & 3);									//10 ms period with some jitter
+		point.timestamp_usec = sample->timestamp_usec;
+		if((i & 15) == 0){
+			point.temperature += 0.01f;
+		}
+		point.sampling_time = sample->sampling_time + (i & 7);
+		sensel = i % (CONFIG_SOCKETSENSE_SENSOR_COUNT * CONFIG_SOCKETSENSE_SENSEL_COUNT);
+		(&sample->sensorstrip_data[0][0])[sensel] = ((&sample->sensorstrip_data[0][0])[sensel] + 37) & 0x0FFF;
+
+		if(sample_frame_append(&frame, &point) != SAMPLE_FRAME_OK){
+			bytes += sample_frame_finish(&frame, i);
+			sample_frame_clear(&frame);
+			sample_frame_append(&frame, &point);
+		}
+	}
+	bytes += sample_frame_finish(&frame, i);
+	duration = esp_timer_get_time() - start;
+	if(duration <= 0){
+		duration = 1;
+	}
+
+	ESP_LOGI(TAG, "Frames (%s): %u samples, %u bytes (%u.%02u bytes/sample) in %" PRId64 " usec, %" PRIu64 " samples/s",
+			encoding == SAMPLE_FRAME_ENCODING_GORILLA ? "gorilla" : "packed", iterations, (uint32_t) bytes,
+			(uint32_t)(bytes / iterations), (uint32_t)(bytes * 100 / iterations % 100), duration,
+			(uint64_t)(iterations * 1000000ULL / duration));
+}
+
+/**
+ * Writes the same line as line_protocol_encodeSample() with sprintf, for a keyframe without features.
+ * This is the reference for the output and the speed of the encoder.
+ */
+size_t line_protocol_formatReference(char *dst, const SocketSense_Sample_t *sample)
+{
+	char *pos = dst;
+	uint32_t sensor_id;
+	uint32_t sensel_id;
+#if CONFIG_GAIT_SENSOR_ACTIVE == 1
+	const char *phase;
+
+	pos += sprintf(pos, "socket_data,activity=%s", gait_monitor_getActivityName(sample->activity));
+	phase = gait_monitor_getPhaseName(sample->activity);
+	if(phase != NULL){
+		pos += sprintf(pos, ",phase=%s", phase);
+	}
+	pos += sprintf(pos, " temp=%.2f,hum=%.2f,pres=%.2f,st=%u,bl=%u,act=%ui",
+			sample->bme280_data.temperature, sample->bme280_data.humidity, sample->bme280_data.pressure,
+			sample->sampling_time, sample->battery_voltage, sample->activity);
+#else
+	pos += sprintf(pos, "socket_data temp=%.2f,hum=%.2f,pres=%.2f,st=%u,bl=%u",
+			sample->bme280_data.temperature, sample->bme280_data.humidity, sample->bme280_data.pressure,
+			sample->sampling_time, sample->battery_voltage);
+#endif
+#if CONFIG_SOCKETSENSE_SENSOR_ACTIVE == 1
+	for(sensor_id = 0; sensor_id < CONFIG_SOCKETSENSE_SENSOR_COUNT; sensor_id++){
+		for(sensel_id = 0; sensel_id < CONFIG_SOCKETSENSE_SENSEL_COUNT; sensel_id++){
+			pos += sprintf(pos, ",s%u_%u=%ui", sensor_id, sensel_id, sample->sensorstrip_data[sensor_id][sensel_id]);
+		}
+	}
+#endif
+	pos += sprintf(pos, " %" PRIu64, sample->timestamp_usec);
+
+	return pos - dst;
+}
@@ -0,0 +1,268 @@
+/**
+ * @file sample_frame.h
+ * @brief Compact binary wire format for SocketSense samples.
+ *
+ * A frame carries a batch of samples of one device. It starts with a fixed header of SAMPLE_FRAME_HEADER_SIZE bytes,
+ * all values are little endian:
+ *
+ * | Offset | Size | Content                                                      |
+ * |--------|------|--------------------------------------------------------------|
+ * | 0      | 2    | Magic 'S' 'F'                                                |
+ * | 2      | 1    | Version (SAMPLE_FRAME_VERSION)                               |
+ * | 3      | 1    | Type (SAMPLE_FRAME_TYPE_...)                                 |
+ * | 4      | 1    | Encoding of the points (SAMPLE_FRAME_ENCODING_...)           |
+ * | 5      | 1    | Number of sensor strips                                      |
+ * | 6      | 1    | Number of sensor elements per strip                          |
+ * | 7      | 1    | Reserved (0)                                                 |
+ * | 8      | 2    | Number of points                                             |
+ * | 10     | 2    | Reserved (0)                                                 |
+ * | 12     | 4    | Sequence number                                              |
+ * | 16     | 4    | Length of the payload that follows the header                |
+ * | 20     | 8    | Base timestamp in us (UNIX time)                             |
+ *
+ * The payload of a hello frame is the user-id of the device (without terminating null). It is sent once after
+ * connecting, so the receiver can tag the points of the connection.
+ *
+ * The payload of a lines frame is line protocol, one point per line, for the points that don't fit into a samples
+ * frame (the exposure snapshots). The receiver adds the device tag of the hello frame and acknowledges the frame like
+ * a samples frame. The header carries no points and no geometry.
+ *
+ * With the packed encoding every point of a samples frame is stored as:
+ * - the difference of its timestamp to the previous point (to the base timestamp for the first point) as zig-zag varint,
+ * - temperature, humidity and pressure as 32 bit floats,
+ * - sampling time and battery voltage as varints,
+ * - all sensor elements (strip major) with 12 bit each, two values are packed into three bytes.
+ *
+ * With 4x8 sensor elements and a sampling period of 10 ms this is about 67 bytes per point, compared to ~420 characters
+ * of line protocol.
+ *
+ * The Gorilla encoding (after the time series compression of Facebook's Gorilla database) exploits that consecutive
+ * samples are similar. The points are written into one bit stream (most significant bit first), each point relative
+ * to the previous point of the same frame:
+ * - the timestamp as delta-of-delta: '0' for the same delta, '10' + 7 bits, '110' + 9 bits, '1110' + 12 bits,
+ *   '11110' + 32 bits or '11111' + 64 bits (two's complement),
+ * - temperature, humidity and pressure as XOR with the previous value: '0' if equal, '10' + the meaningful bits if they
+ *   fit into the previous window of leading and trailing zeros, otherwise '11' + 5 bits leading zeros + 5 bits
+ *   (length - 1) + the meaningful bits,
+ * - sampling time and battery voltage as zig-zag varint of the difference to the previous value (groups of 8 bits,
+ *   see below),
+ * - '1' if all sensor elements follow, or '0' + one bit per sensor element that is set if it follows (deadband of the
+ *   data collector, sensel_mask of the point),
+ * - the sensor elements that follow as zig-zag varint of the difference to their previous value. The others keep their
+ *   previous value.
+ * The first point of a frame refers to zero values and always carries all sensor elements, so every frame can be
+ * decoded on its own. The packed encoding ignores sensel_mask and always carries all sensor elements.
+ *
+ * Values of sensor elements above 4095 (which the 12 bit ADC can't produce) are clamped in both encodings.
+ * Varints use 7 bits per group starting with the least significant ones, the most significant bit of a group is set
+ * if another group follows.
+ *
+ * The codec only depends on the C standard library, it is shared by the firmware and by the ingest gateway (tools/gateway).
+ *
+ * @date October 17. 2026
+ */
+#ifndef COMPONENTS_SAMPLE_FRAME_H_
+#define COMPONENTS_SAMPLE_FRAME_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SAMPLE_FRAME_HEADER_SIZE		28		//!< Size of the frame header in bytes
+#define SAMPLE_FRAME_VERSION			1		//!< Version of the frame format
+#define SAMPLE_FRAME_TYPE_HELLO			1		//!< Frame that carries the user-id of the device
+#define SAMPLE_FRAME_TYPE_SAMPLES		2		//!< Frame that carries points
+#define SAMPLE_FRAME_TYPE_LINES			3		//!< Frame that carries line protocol
+#define SAMPLE_FRAME_ENCODING_PACKED	0		//!< Points with delta timestamps and 12 bit packed sensor elements
+#define SAMPLE_FRAME_ENCODING_GORILLA	1		//!< Bit stream with delta-of-delta timestamps, XOR floats and sensor element deltas
+#define SAMPLE_FRAME_MAX_SENSELS		256		//!< Upper bound of sensor strips times sensor elements per strip
+#define SAMPLE_FRAME_MAX_PAYLOAD		(1024 * 1024)	//!< Frames with a larger payload are rejected by the parser
+#define SAMPLE_FRAME_ACK_SIZE			4		//!< The receiver acknowledges each samples frame with its 4 byte sequence number
+
+/**
+ * @brief Upper bound of the encoded size of one point with the given number of sensor elements (for both encodings).
+ */
+#define SAMPLE_FRAME_MAX_POINT_SIZE(sensels)	(41 + (sensels) * 2 + ((sensels) + 7) / 8)
+
+#define SAMPLE_FRAME_OK					0		//!< Success
+#define SAMPLE_FRAME_END				1		//!< All points of the frame have been decoded
+#define SAMPLE_FRAME_ERR_SPACE			-1		//!< The buffer is too small
+#define SAMPLE_FRAME_ERR_INCOMPLETE		-2		//!< More data is needed to parse the header
+#define SAMPLE_FRAME_ERR_INVALID		-3		//!< The data is not a valid frame
+
+/**
+ * @brief One point as it is encoded into and decoded from a frame.
+ */
+typedef struct {
+	uint64_t		timestamp_usec;		/**< UNIX timestamp in us of the sample. */
+	float			temperature;		/**< Temperature of the BME280. */
+	float			humidity;			/**< Humidity of the BME280. */
+	float			pressure;			/**< Pressure of the BME280. */
+	uint32_t		sampling_time;		/**< Time in us it took to record the sample. */
+	uint32_t		battery_voltage;	/**< Battery voltage in mV. */
+	const uint16_t	*sensels;			/**< Sensor elements, sensor_count * sensel_count values (strip major). */
+	const uint8_t	*sensel_mask;		/**< Bit i is set if sensor element i is reported (deadband), NULL if all are. */
+} sample_frame_point_t;
+
+/**
+ * @brief Decoded frame header.
+ */
+typedef struct {
+	uint8_t			version;			/**< Version of the frame format. */
+	uint8_t			type;				/**< Type of the frame. */
+	uint8_t			encoding;			/**< Encoding of the points. */
+	uint8_t			sensor_count;		/**< Number of sensor strips. */
+	uint8_t			sensel_count;		/**< Number of sensor elements per strip. */
+	uint16_t		point_count;		/**< Number of points in the frame. */
+	uint32_t		sequence;			/**< Sequence number of the frame. */
+	uint32_t		payload_length;		/**< Number of bytes that follow the header. */
+	uint64_t		base_timestamp_us;	/**< Timestamp the first delta refers to. */
+} sample_frame_header_t;
+
+/**
+ * @brief Values of the previous point, the Gorilla encoding writes each point relative to them.
+ */
+typedef struct {
+	int64_t			timestamp_delta;	/**< Difference of the last two timestamps. */
+	uint32_t		floats[3];			/**< Bits of the last temperature, humidity and pressure. */
+	uint8_t			leading[3];			/**< Leading zeros of the last XOR window of each float. */
+	uint8_t			trailing[3];		/**< Trailing zeros of the last XOR window of each float, 0xFF if there is none. */
+	uint32_t		sampling_time;		/**< Last sampling time. */
+	uint32_t		battery_voltage;	/**< Last battery voltage. */
+	uint16_t		sensels[SAMPLE_FRAME_MAX_SENSELS];	/**< Last sensor element values. */
+} sample_frame_history_t;
+
+/**
+ * @brief Frame that is being encoded.
+ */
+typedef struct {
+	uint8_t			*data;				/**< Frame buffer, the header is written by sample_frame_finish(). */
+	size_t			capacity;			/**< Size of the frame buffer. */
+	size_t			length;				/**< Used bytes including the header. */
+	uint32_t		bits;				/**< Used bits of the payload (Gorilla encoding). */
+	uint16_t		points;				/**< Number of encoded points. */
+	uint8_t			encoding;			/**< Encoding of the points. */
+	uint8_t			sensor_count;		/**< Number of sensor strips of every point. */
+	uint8_t			sensel_count;		/**< Number of sensor elements per strip of every point. */
+	uint64_t		base_timestamp_us;	/**< Timestamp of the first point. */
+	uint64_t		last_timestamp_us;	/**< Timestamp of the last point. */
+	sample_frame_history_t history;		/**< Previous point (Gorilla encoding). */
+} sample_frame_t;
+
+/**
+ * @brief State of the decoder of one frame.
+ */
+typedef struct {
+	sample_frame_header_t header;		/**< Header of the frame. */
+	const uint8_t	*payload;			/**< Start of the payload. */
+	const uint8_t	*pos;				/**< Next byte of the payload (packed encoding). */
+	const uint8_t	*end;				/**< End of the payload. */
+	uint32_t		bit;				/**< Next bit of the payload (Gorilla encoding). */
+	uint16_t		remaining;			/**< Number of points that have not been decoded yet. */
+	uint64_t		timestamp_us;		/**< Timestamp of the last decoded point. */
+	sample_frame_history_t history;		/**< Previous point (Gorilla encoding). */
+	uint8_t			mask[SAMPLE_FRAME_MAX_SENSELS / 8];	/**< Sensor elements of the last decoded point (Gorilla encoding). */
+} sample_frame_decoder_t;
+
+/**
+ * @brief Initializes an empty frame in the given buffer.
+ *
+ * @param frame The frame.
+ * @param buffer Frame buffer, needs at least SAMPLE_FRAME_HEADER_SIZE bytes.
+ * @param capacity Size of the buffer.
+ * @param sensor_count Number of sensor strips.
+ * @param sensel_count Number of sensor elements per strip.
+ * @param encoding Encoding of the points, SAMPLE_FRAME_ENCODING_PACKED or SAMPLE_FRAME_ENCODING_GORILLA.
+ */
+void sample_frame_init(sample_frame_t *frame, uint8_t *buffer, size_t capacity, uint8_t sensor_count, uint8_t sensel_count,
+		uint8_t encoding);
+
+/**
+ * @brief Removes all points from the frame.
+ *
+ * @param frame The frame.
+ */
+void sample_frame_clear(sample_frame_t *frame);
+
+/**
+ * @brief Encodes one point at the end of the frame.
+ *
+ * @param frame The frame.
+ * @param point The point, sensels must hold sensor_count * sensel_count values.
+ * @return SAMPLE_FRAME_OK if success, SAMPLE_FRAME_ERR_SPACE if the point does not fit (the frame is unchanged).
+ */
+int sample_frame_append(sample_frame_t *frame, const sample_frame_point_t *point);
+
+/**
+ * @brief Writes the header of the frame.
+ *
+ * The frame can be sent afterwards, more points may be appended and the frame finished again.
+ *
+ * @param frame The frame.
+ * @param sequence Sequence number of the frame.
+ * @return Length of the frame in bytes (header and payload).
+ */
+size_t sample_frame_finish(sample_frame_t *frame, uint32_t sequence);
+
+/**
+ * @brief Writes a hello frame that carries the user-id of the device.
+ *
+ * @param dst Destination.
+ * @param capacity Size of the destination.
+ * @param uid The user-id (null terminated).
+ * @param sensor_count Number of sensor strips.
+ * @param sensel_count Number of sensor elements per strip.
+ * @return Length of the frame, 0 if it does not fit.
+ */
+size_t sample_frame_writeHello(uint8_t *dst, size_t capacity, const char *uid, uint8_t sensor_count, uint8_t sensel_count);
+
+/**
+ * @brief Writes the header of a lines frame.
+ *
+ * @param dst Destination, the line protocol is written behind the header (at dst + SAMPLE_FRAME_HEADER_SIZE) by the caller.
+ * @param length Length of the line protocol.
+ * @param sequence Sequence number of the frame.
+ * @return Length of the frame in bytes (header and payload).
+ */
+size_t sample_frame_finishLines(uint8_t *dst, size_t length, uint32_t sequence);
+
+/**
+ * @brief Parses a frame header.
+ *
+ * @param data Received data.
+ * @param length Number of received bytes.
+ * @param header Destination for the header.
+ * @return SAMPLE_FRAME_OK if success, SAMPLE_FRAME_ERR_INCOMPLETE if less than SAMPLE_FRAME_HEADER_SIZE bytes are given,
+ * SAMPLE_FRAME_ERR_INVALID if the data is not a supported frame.
+ */
+int sample_frame_parseHeader(const uint8_t *data, size_t length, sample_frame_header_t *header);
+
+/**
+ * @brief Prepares decoding the points of a frame.
+ *
+ * @param decoder The decoder.
+ * @param header Parsed header of the frame.
+ * @param payload The header->payload_length bytes that follow the header.
+ */
+void sample_frame_decoderInit(sample_frame_decoder_t *decoder, const sample_frame_header_t *header, const uint8_t *payload);
+
+/**
+ * @brief Decodes the next point of a frame.
+ *
+ * @param decoder The decoder.
+ * @param point Destination for the point, its sensels pointer is set to the given array. Sensor elements that are not
+ * 				carried by the point hold their previous value, sensel_mask points to the mask of the decoder then.
+ * @param sensels Destination for the sensor elements, needs space for sensor_count * sensel_count values.
+ * @return SAMPLE_FRAME_OK if a point was decoded, SAMPLE_FRAME_END if all points have been decoded,
+ * SAMPLE_FRAME_ERR_INVALID if the payload is truncated.
+ */
+int sample_frame_decodePoint(sample_frame_decoder_t *decoder, sample_frame_point_t *point, uint16_t *sensels);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COMPONENTS_SAMPLE_FRAME_H_ */
@@ -0,0 +1,732 @@
+/**
+ * @file sample_frame.c
+ * @brief Compact binary wire format for SocketSense samples.
+ *
+ * All multi-byte values are written byte by byte, so the format does not depend on the alignment or the
+ * byte order of the host.
+ *
+ * The bit stream of the Gorilla encoding is written in chunks of up to 8 bits, so a value never needs more than
+ * one operation per byte it touches.
+ *
+ * @date October 17. 2026
+ */
+#include <string.h>
+
+#include "sample_frame.h"
+
+/*****Private Functions Definitions*************************************************/
+
+void sample_frame_putU16(uint8_t *dst, uint16_t value);
+void sample_frame_putU32(uint8_t *dst, uint32_t value);
+void sample_frame_putU64(uint8_t *dst, uint64_t value);
+uint16_t sample_frame_getU16(const uint8_t *src);
+uint32_t sample_frame_getU32(const uint8_t *src);
+uint64_t sample_frame_getU64(const uint8_t *src);
+uint8_t* sample_frame_putVarint(uint8_t *dst, uint64_t value);
+const uint8_t* sample_frame_getVarint(const uint8_t *src, const uint8_t *end, uint64_t *value);
+uint8_t* sample_frame_putFloat(uint8_t *dst, float value);
+float sample_frame_getFloat(const uint8_t *src);
+void sample_frame_writeHeader(uint8_t *dst, const sample_frame_header_t *header);
+uint64_t sample_frame_zigzag(int64_t value);
+int64_t sample_frame_unzigzag(uint64_t value);
+void sample_frame_appendPacked(sample_frame_t *frame, const sample_frame_point_t *point, uint32_t count);
+void sample_frame_appendGorilla(sample_frame_t *frame, const sample_frame_point_t *point, uint32_t count);
+void sample_frame_putBits(sample_frame_t *frame, uint64_t value, uint32_t count);
+void sample_frame_putBitsVarint(sample_frame_t *frame, uint64_t value);
+void sample_frame_putXor(sample_frame_t *frame, uint32_t index, float value);
+int sample_frame_decodePacked(sample_frame_decoder_t *decoder, sample_frame_point_t *point, uint16_t *sensels, uint32_t count);
+int sample_frame_decodeGorilla(sample_frame_decoder_t *decoder, sample_frame_point_t *point, uint16_t *sensels, uint32_t count);
+int sample_frame_getBits(sample_frame_decoder_t *decoder, uint32_t count, uint64_t *value);
+int sample_frame_getBitsVarint(sample_frame_decoder_t *decoder, uint64_t *value);
+int sample_frame_getXor(sample_frame_decoder_t *decoder, uint32_t index, float *value);
+
+/*****Public Functions**************************************************************/
+
+void sample_frame_init(sample_frame_t *frame, uint8_t *buffer, size_t capacity, uint8_t sensor_count, uint8_t sensel_count,
+		uint8_t encoding)
+{
+	frame->data = buffer;
+	frame->capacity = capacity;
+	frame->encoding = encoding;
+	frame->sensor_count = sensor_count;
+	frame->sensel_count = sensel_count;
+	sample_frame_clear(frame);
+}
+
+void sample_frame_clear(sample_frame_t *frame)
+{
+	frame->length = SAMPLE_FRAME_HEADER_SIZE;
+	frame->bits = 0;
+	frame->points = 0;
+	frame->base_timestamp_us = 0;
+	frame->last_timestamp_us = 0;
+	memset(&frame->history, 0, sizeof(frame->history));
+	memset(frame->history.trailing, 0xFF, sizeof(frame->history.trailing));
+}
+
+int sample_frame_append(sample_frame_t *frame, const sample_frame_point_t *point)
+{
+	uint32_t count = (uint32_t) frame->sensor_count * frame->sensel_count;
+
+	if(frame->points == UINT16_MAX || frame->capacity - frame->length < SAMPLE_FRAME_MAX_POINT_SIZE(count)){
+		return SAMPLE_FRAME_ERR_SPACE;
+	}
+
+	if(frame->points == 0){
+		frame->base_timestamp_us = point->timestamp_usec;
+		frame->last_timestamp_us = point->timestamp_usec;
+	}
+
+	if(frame->encoding == SAMPLE_FRAME_ENCODING_GORILLA){
+		sample_frame_appendGorilla(frame, point, count);
+	}else{
+		sample_frame_appendPacked(frame, point, count);
+	}
+
+	frame->last_timestamp_us = point->timestamp_usec;
+	frame->points++;
+
+	return SAMPLE_FRAME_OK;
+}
+
+size_t sample_frame_finish(sample_frame_t *frame, uint32_t sequence)
+{
+	sample_frame_header_t header;
+
+	header.version = SAMPLE_FRAME_VERSION;
+	header.type = SAMPLE_FRAME_TYPE_SAMPLES;
+	header.encoding = frame->encoding;
+	header.sensor_count = frame->sensor_count;
+	header.sensel_count = frame->sensel_count;
+	header.point_count = frame->points;
+	header.sequence = sequence;
+	header.payload_length = (uint32_t)(frame->length - SAMPLE_FRAME_HEADER_SIZE);
+	header.base_timestamp_us = frame->base_timestamp_us;
+	sample_frame_writeHeader(frame->data, &header);
+
+	return frame->length;
+}
+
+size_t sample_frame_writeHello(uint8_t *dst, size_t capacity, const char *uid, uint8_t sensor_count, uint8_t sensel_count)
+{
+	sample_frame_header_t header;
+	size_t len = strlen(uid);
+
+	if(capacity < SAMPLE_FRAME_HEADER_SIZE + len){
+		return 0;
+	}
+
+	memset(&header, 0, sizeof(header));
+	header.version = SAMPLE_FRAME_VERSION;
+	header.type = SAMPLE_FRAME_TYPE_HELLO;
+	header.encoding = SAMPLE_FRAME_ENCODING_PACKED;
+	header.sensor_count = sensor_count;
+	header.sensel_count = sensel_count;
+	header.payload_length = (uint32_t) len;
+	sample_frame_writeHeader(dst, &header);
+	memcpy(dst + SAMPLE_FRAME_HEADER_SIZE, uid, len);
+
+	return SAMPLE_FRAME_HEADER_SIZE + len;
+}
+
+size_t sample_frame_finishLines(uint8_t *dst, size_t length, uint32_t sequence)
+{
+	sample_frame_header_t header;
+
+	memset(&header, 0, sizeof(header));
+	header.version = SAMPLE_FRAME_VERSION;
+	header.type = SAMPLE_FRAME_TYPE_LINES;
+	header.encoding = SAMPLE_FRAME_ENCODING_PACKED;
+	header.sequence = sequence;
+	header.payload_length = (uint32_t) length;
+	sample_frame_writeHeader(dst, &header);
+
+	return SAMPLE_FRAME_HEADER_SIZE + length;
+}
+
+int sample_frame_parseHeader(const uint8_t *data, size_t length, sample_frame_header_t *header)
+{
+	if(length < SAMPLE_FRAME_HEADER_SIZE){
+		return SAMPLE_FRAME_ERR_INCOMPLETE;
+	}
+	if(data[0] != 'S' || data[1] != 'F'){
+		return SAMPLE_FRAME_ERR_INVALID;
+	}
+
+	header->version = data[2];
+	header->type = data[3];
+	header->encoding = data[4];
+	header->sensor_count = data[5];
+	header->sensel_count = data[6];
+	header->point_count = sample_frame_getU16(&data[8]);
+	header->sequence = sample_frame_getU32(&data[12]);
+	header->payload_length = sample_frame_getU32(&data[16]);
+	header->base_timestamp_us = sample_frame_getU64(&data[20]);
+
+	if(header->version != SAMPLE_FRAME_VERSION
+			|| header->type < SAMPLE_FRAME_TYPE_HELLO || header->type > SAMPLE_FRAME_TYPE_LINES
+			|| (header->encoding != SAMPLE_FRAME_ENCODING_PACKED && header->encoding != SAMPLE_FRAME_ENCODING_GORILLA)
+			|| (uint32_t) header->sensor_count * header->sensel_count > SAMPLE_FRAME_MAX_SENSELS
+			|| header->payload_length > SAMPLE_FRAME_MAX_PAYLOAD){
+		return SAMPLE_FRAME_ERR_INVALID;
+	}
+
+	return SAMPLE_FRAME_OK;
+}
+
+void sample_frame_decoderInit(sample_frame_decoder_t *decoder, const sample_frame_header_t *header, const uint8_t *payload)
+{
+	decoder->header = *header;
+	decoder->payload = payload;
+	decoder->pos = payload;
+	decoder->end = payload + header->payload_length;
+	decoder->bit = 0;
+	decoder->remaining = header->type == SAMPLE_FRAME_TYPE_SAMPLES ? header->point_count : 0;
+	decoder->timestamp_us = header->base_timestamp_us;
+	memset(&decoder->history, 0, sizeof(decoder->history));
+	memset(decoder->history.trailing, 0xFF, sizeof(decoder->history.trailing));
+}
+
+int sample_frame_decodePoint(sample_frame_decoder_t *decoder, sample_frame_point_t *point, uint16_t *sensels)
+{
+	uint32_t count = (uint32_t) decoder->header.sensor_count * decoder->header.sensel_count;
+	int result;
+
+	if(decoder->remaining == 0){
+		return SAMPLE_FRAME_END;
+	}
+
+	if(decoder->header.encoding == SAMPLE_FRAME_ENCODING_GORILLA){
+		result = sample_frame_decodeGorilla(decoder, point, sensels, count);
+	}else{
+		result = sample_frame_decodePacked(decoder, point, sensels, count);
+	}
+	if(result != SAMPLE_FRAME_OK){
+		return result;
+	}
+
+	point->sensels = sensels;
+	decoder->remaining--;
+
+	return SAMPLE_FRAME_OK;
+}
+
+/*****Private Functions*************************************************************/
+
+void sample_frame_putU16(uint8_t *dst, uint16_t value)
+{
+	dst[0] = (uint8_t) value;
+	dst[1] = (uint8_t)(value >> 8);
+}
+
+void sample_frame_putU32(uint8_t *dst, uint32_t value)
+{
+	sample_frame_putU16(dst, (uint16_t) value);
+	sample_frame_putU16(dst + 2, (uint16_t)(value >> 16));
+}
+
+void sample_frame_putU64(uint8_t *dst, uint64_t value)
+{
+	sample_frame_putU32(dst, (uint32_t) value);
+	sample_frame_putU32(dst + 4, (uint32_t)(value >> 32));
+}
+
+uint16_t sample_frame_getU16(const uint8_t *src)
+{
+	return (uint16_t)(src[0] | (src[1] << 8));
+}
+
+uint32_t sample_frame_getU32(const uint8_t *src)
+{
+	return sample_frame_getU16(src) | ((uint32_t) sample_frame_getU16(src + 2) << 16);
+}
+
+uint64_t sample_frame_getU64(const uint8_t *src)
+{
+	return sample_frame_getU32(src) | ((uint64_t) sample_frame_getU32(src + 4) << 32);
+}
+
+/**
+ * Writes an unsigned LEB128 varint, 7 bits per byte starting with the least significant ones.
+ */
+uint8_t* sample_frame_putVarint(uint8_t *dst, uint64_t value)
+{
+	while(value >= 0x80){
+		*dst++ = (uint8_t)(value | 0x80);
+		value >>= 7;
+	}
+	*dst++ = (uint8_t) value;
+
+	return dst;
+}
+
+/**
+ * Reads an unsigned LEB128 varint, returns NULL if it is truncated or longer than 10 bytes.
+ */
+const uint8_t* sample_frame_getVarint(const uint8_t *src, const uint8_t *end, uint64_t *value)
+{
+	uint64_t result = 0;
+	uint32_t shift = 0;
+
+	while(src < end && shift < 64){
+		result |= (uint64_t)(*src & 0x7F) << shift;
+		if((*src++ & 0x80) == 0){
+			*value = result;
+			return src;
+		}
+		shift += 7;
+	}
+
+	return NULL;
+}
+
+uint8_t* sample_frame_putFloat(uint8_t *dst, float value)
+{
+	uint32_t bits;
+
+	memcpy(&bits, &value, sizeof(bits));
+	sample_frame_putU32(dst, bits);
+
+	return dst + 4;
+}
+
+float sample_frame_getFloat(const uint8_t *src)
+{
+	uint32_t bits = sample_frame_getU32(src);
+	float value;
+
+	memcpy(&value, &bits, sizeof(value));
+
+	return value;
+}
+
+void sample_frame_writeHeader(uint8_t *dst, const sample_frame_header_t *header)
+{
+	dst[0] = 'S';
+	dst[1] = 'F';
+	dst[2] = header->version;
+	dst[3] = header->type;
+	dst[4] = header->encoding;
+	dst[5] = header->sensor_count;
+	dst[6] = header->sensel_count;
+	dst[7] = 0;
+	sample_frame_putU16(&dst[8], header->point_count);
+	sample_frame_putU16(&dst[10], 0);
+	sample_frame_putU32(&dst[12], header->sequence);
+	sample_frame_putU32(&dst[16], header->payload_length);
+	sample_frame_putU64(&dst[20], header->base_timestamp_us);
+}
+
+uint64_t sample_frame_zigzag(int64_t value)
+{
+	return ((uint64_t) value << 1) ^ (uint64_t)(value >> 63);
+}
+
+int64_t sample_frame_unzigzag(uint64_t value)
+{
+	return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+void sample_frame_appendPacked(sample_frame_t *frame, const sample_frame_point_t *point, uint32_t count)
+{
+	uint8_t *pos = frame->data + frame->length;
+	uint32_t i;
+	uint16_t a;
+	uint16_t b;
+
+	pos = sample_frame_putVarint(pos, sample_frame_zigzag((int64_t)(point->timestamp_usec - frame->last_timestamp_us)));	//the clock may be set back
+	pos = sample_frame_putFloat(pos, point->temperature);
+	pos = sample_frame_putFloat(pos, point->humidity);
+	pos = sample_frame_putFloat(pos, point->pressure);
+	pos = sample_frame_putVarint(pos, point->sampling_time);
+	pos = sample_frame_putVarint(pos, point->battery_voltage);
+
+	for(i = 0; i + 1 < count; i += 2){												//two 12 bit values in three bytes
+		a = point->sensels[i] > 0x0FFF ? 0x0FFF : point->sensels[i];
+		b = point->sensels[i + 1] > 0x0FFF ? 0x0FFF : point->sensels[i + 1];
+		*pos++ = (uint8_t) a;
+		*pos++ = (uint8_t)((a >> 8) | (b << 4));
+		*pos++ = (uint8_t)(b >> 4);
+	}
+	if(i < count){																	//odd number of values, the last one takes two bytes
+		a = point->sensels[i] > 0x0FFF ? 0x0FFF : point->sensels[i];
+		*pos++ = (uint8_t) a;
+		*pos++ = (uint8_t)(a >> 8);
+	}
+
+	frame->length = pos - frame->data;
+}
+
+void sample_frame_appendGorilla(sample_frame_t *frame, const sample_frame_point_t *point, uint32_t count)
+{
+	sample_frame_history_t *history = &frame->history;
+	int64_t delta = (int64_t)(point->timestamp_usec - frame->last_timestamp_us);
+	int64_t dod = (int64_t)((uint64_t) delta - (uint64_t) history->timestamp_delta);		//wraps like the timestamps
+	uint64_t bits;
+	uint32_t i;
+	uint32_t j;
+	uint32_t n;
+	uint16_t value;
+
+	if(dod == 0){																	//delta-of-delta in buckets of increasing size
+		sample_frame_putBits(frame, 0x0, 1);
+	}else if(dod >= -64 && dod <= 63){
+		sample_frame_putBits(frame, 0x2, 2);
+		sample_frame_putBits(frame, (uint64_t) dod, 7);
+	}else if(dod >= -256 && dod <= 255){
+		sample_frame_putBits(frame, 0x6, 3);
+		sample_frame_putBits(frame, (uint64_t) dod, 9);
+	}else if(dod >= -2048 && dod <= 2047){
+		sample_frame_putBits(frame, 0xE, 4);
+		sample_frame_putBits(frame, (uint64_t) dod, 12);
+	}else if(dod >= INT32_MIN && dod <= INT32_MAX){
+		sample_frame_putBits(frame, 0x1E, 5);
+		sample_frame_putBits(frame, (uint64_t) dod, 32);
+	}else{
+		sample_frame_putBits(frame, 0x1F, 5);
+		sample_frame_putBits(frame, (uint64_t) dod, 64);
+	}
+	history->timestamp_delta = delta;
+
+	sample_frame_putXor(frame, 0, point->temperature);
+	sample_frame_putXor(frame, 1, point->humidity);
+	sample_frame_putXor(frame, 2, point->pressure);
+
+	sample_frame_putBitsVarint(frame, sample_frame_zigzag((int64_t) point->sampling_time - history->sampling_time));
+	sample_frame_putBitsVarint(frame, sample_frame_zigzag((int64_t) point->battery_voltage - history->battery_voltage));
+	history->sampling_time = point->sampling_time;
+	history->battery_voltage = point->battery_voltage;
+
+	if(point->sensel_mask == NULL || frame->points == 0){							//all sensor elements follow
+		sample_frame_putBits(frame, 0x1, 1);
+		for(i = 0; i < count; i++){
+			value = point->sensels[i] > 0x0FFF ? 0x0FFF : point->sensels[i];
+			sample_frame_putBitsVarint(frame, sample_frame_zigzag((int32_t) value - history->sensels[i]));
+			history->sensels[i] = value;
+		}
+	}else{
+		sample_frame_putBits(frame, 0x0, 1);
+		for(i = 0; i < count; i += 56){												//the mask in chunks of up to 56 bits
+			n = count - i < 56 ? count - i : 56;
+			for(bits = 0, j = i; j < i + n; j++){
+				bits = (bits << 1) | ((point->sensel_mask[j >> 3] >> (j & 7)) & 1);
+			}
+			sample_frame_putBits(frame, bits, n);
+		}
+		for(i = 0; i < count; i++){
+			if(point->sensel_mask[i >> 3] & (1 << (i & 7))){
+				value = point->sensels[i] > 0x0FFF ? 0x0FFF : point->sensels[i];
+				sample_frame_putBitsVarint(frame, sample_frame_zigzag((int32_t) value - history->sensels[i]));
+				history->sensels[i] = value;
+			}
+		}
+	}
+
+	frame->length = SAMPLE_FRAME_HEADER_SIZE + (frame->bits + 7) / 8;
+}
+
+/**
+ * Appends the lower count bits of value to the bit stream, the most significant bit first.
+ * The bits are merged with the partly used last byte and written with one store per byte.
+ */
+void sample_frame_putBits(sample_frame_t *frame, uint64_t value, uint32_t count)
+{
+	uint8_t *pos;
+	uint64_t window;
+	uint32_t used;
+	uint32_t total;
+	int32_t shift;
+
+	if(count > 56){																	//the window holds at most 7 used bits and 57 new ones
+		sample_frame_putBits(frame, value >> 32, count - 32);
+		count = 32;
+	}
+
+	pos = &frame->data[SAMPLE_FRAME_HEADER_SIZE + (frame->bits >> 3)];
+	used = frame->bits & 7;
+	total = used + count;
+	window = used == 0 ? 0 : (uint64_t)(pos[0] >> (8 - used));
+	window = (window << count) | (value & (~0ULL >> (64 - count)));
+	window <<= 64 - total;
+
+	for(shift = 56; shift > 56 - (int32_t)((total + 7) & ~7u); shift -= 8){
+		*pos++ = (uint8_t)(window >> shift);
+	}
+	frame->bits += count;
+}
+
+void sample_frame_putBitsVarint(sample_frame_t *frame, uint64_t value)
+{
+	while(value >= 0x80){
+		sample_frame_putBits(frame, (value & 0x7F) | 0x80, 8);
+		value >>= 7;
+	}
+	sample_frame_putBits(frame, value, 8);
+}
+
+/**
+ * Appends a float as XOR with the previous value of the same field.
+ */
+void sample_frame_putXor(sample_frame_t *frame, uint32_t index, float value)
+{
+	sample_frame_history_t *history = &frame->history;
+	uint32_t bits;
+	uint32_t difference;
+	uint32_t leading;
+	uint32_t trailing;
+	uint32_t length;
+
+	memcpy(&bits, &value, sizeof(bits));
+	difference = bits ^ history->floats[index];
+	history->floats[index] = bits;
+
+	if(difference == 0){
+		sample_frame_putBits(frame, 0x0, 1);
+		return;
+	}
+
+	leading = 0;
+	while((difference & (0x80000000u >> leading)) == 0){
+		leading++;
+	}
+	trailing = 0;
+	while((difference & (1u << trailing)) == 0){
+		trailing++;
+	}
+
+	if(history->trailing[index] != 0xFF && leading >= history->leading[index] && trailing >= history->trailing[index]){
+		length = 32 - history->leading[index] - history->trailing[index];		//the meaningful bits fit into the previous window
+		sample_frame_putBits(frame, 0x2, 2);
+		sample_frame_putBits(frame, difference >> history->trailing[index], length);
+	}else{
+		length = 32 - leading - trailing;
+		sample_frame_putBits(frame, 0x3, 2);
+		sample_frame_putBits(frame, leading, 5);
+		sample_frame_putBits(frame, length - 1, 5);
+		sample_frame_putBits(frame, difference >> trailing, length);
+		history->leading[index] = (uint8_t) leading;
+		history->trailing[index] = (uint8_t) trailing;
+	}
+}
+
+int sample_frame_decodePacked(sample_frame_decoder_t *decoder, sample_frame_point_t *point, uint16_t *sensels, uint32_t count)
+{
+	const uint8_t *pos = decoder->pos;
+	const uint8_t *end = decoder->end;
+	uint64_t value;
+	uint32_t i;
+
+	pos = sample_frame_getVarint(pos, end, &value);
+	if(pos == NULL || end - pos < 12){
+		return SAMPLE_FRAME_ERR_INVALID;
+	}
+	decoder->timestamp_us += (uint64_t) sample_frame_unzigzag(value);
+	point->timestamp_usec = decoder->timestamp_us;
+	point->temperature = sample_frame_getFloat(pos);
+	point->humidity = sample_frame_getFloat(pos + 4);
+	point->pressure = sample_frame_getFloat(pos + 8);
+	pos += 12;
+
+	pos = sample_frame_getVarint(pos, end, &value);
+	if(pos == NULL){
+		return SAMPLE_FRAME_ERR_INVALID;
+	}
+	point->sampling_time = (uint32_t) value;
+	pos = sample_frame_getVarint(pos, end, &value);
+	if(pos == NULL){
+		return SAMPLE_FRAME_ERR_INVALID;
+	}
+	point->battery_voltage = (uint32_t) value;
+	point->sensel_mask = NULL;
+
+	if((size_t)(end - pos) < (count * 3 + 1) / 2){
+		return SAMPLE_FRAME_ERR_INVALID;
+	}
+	for(i = 0; i + 1 < count; i += 2){
+		sensels[i] = (uint16_t)(pos[0] | ((pos[1] & 0x0F) << 8));
+		sensels[i + 1] = (uint16_t)((pos[1] >> 4) | (pos[2] << 4));
+		pos += 3;
+	}
+	if(i < count){
+		sensels[i] = (uint16_t)(pos[0] | ((pos[1] & 0x0F) << 8));
+		pos += 2;
+	}
+
+	decoder->pos = pos;
+
+	return SAMPLE_FRAME_OK;
+}
+
+int sample_frame_decodeGorilla(sample_frame_decoder_t *decoder, sample_frame_point_t *point, uint16_t *sensels, uint32_t count)
+{
+	static const uint8_t dod_bits[5] = {7, 9, 12, 32, 64};
+	sample_frame_history_t *history = &decoder->history;
+	uint64_t value;
+	uint32_t prefix = 0;
+	int64_t dod = 0;
+	uint32_t i;
+	uint32_t j;
+	uint32_t n;
+
+	while(prefix < 5){																//count the leading ones of the bucket prefix
+		if(sample_frame_getBits(decoder, 1, &value) != SAMPLE_FRAME_OK){
+			return SAMPLE_FRAME_ERR_INVALID;
+		}
+		if(value == 0){
+			break;
+		}
+		prefix++;
+	}
+	if(prefix > 0){
+		if(sample_frame_getBits(decoder, dod_bits[prefix - 1], &value) != SAMPLE_FRAME_OK){
+			return SAMPLE_FRAME_ERR_INVALID;
+		}
+		if(dod_bits[prefix - 1] < 64 && (value >> (dod_bits[prefix - 1] - 1)) != 0){	//sign extension
+			value |= ~0ULL << dod_bits[prefix - 1];
+		}
+		dod = (int64_t) value;
+	}
+	history->timestamp_delta = (int64_t)((uint64_t) history->timestamp_delta + (uint64_t) dod);
+	decoder->timestamp_us += (uint64_t) history->timestamp_delta;
+	point->timestamp_usec = decoder->timestamp_us;
+
+	if(sample_frame_getXor(decoder, 0, &point->temperature) != SAMPLE_FRAME_OK
+			|| sample_frame_getXor(decoder, 1, &point->humidity) != SAMPLE_FRAME_OK
+			|| sample_frame_getXor(decoder, 2, &point->pressure) != SAMPLE_FRAME_OK){
+		return SAMPLE_FRAME_ERR_INVALID;
+	}
+
+	if(sample_frame_getBitsVarint(decoder, &value) != SAMPLE_FRAME_OK){
+		return SAMPLE_FRAME_ERR_INVALID;
+	}
+	history->sampling_time += (uint32_t) sample_frame_unzigzag(value);
+	point->sampling_time = history->sampling_time;
+	if(sample_frame_getBitsVarint(decoder, &value) != SAMPLE_FRAME_OK){
+		return SAMPLE_FRAME_ERR_INVALID;
+	}
+	history->battery_voltage += (uint32_t) sample_frame_unzigzag(value);
+	point->battery_voltage = history->battery_voltage;
+
+	if(sample_frame_getBits(decoder, 1, &value) != SAMPLE_FRAME_OK){
+		return SAMPLE_FRAME_ERR_INVALID;
+	}
+	if(value == 1){																	//all sensor elements follow
+		memset(decoder->mask, 0xFF, sizeof(decoder->mask));
+		point->sensel_mask = NULL;
+	}else{
+		memset(decoder->mask, 0, sizeof(decoder->mask));
+		for(i = 0; i < count; i += 56){
+			n = count - i < 56 ? count - i : 56;
+			if(sample_frame_getBits(decoder, n, &value) != SAMPLE_FRAME_OK){
+				return SAMPLE_FRAME_ERR_INVALID;
+			}
+			for(j = i + n; j > i; j--){
+				decoder->mask[(j - 1) >> 3] |= (uint8_t)((value & 1) << ((j - 1) & 7));
+				value >>= 1;
+			}
+		}
+		point->sensel_mask = decoder->mask;
+	}
+
+	for(i = 0; i < count; i++){
+		if(decoder->mask[i >> 3] & (1 << (i & 7))){
+			if(sample_frame_getBitsVarint(decoder, &value) != SAMPLE_FRAME_OK){
+				return SAMPLE_FRAME_ERR_INVALID;
+			}
+			history->sensels[i] = (uint16_t)(history->sensels[i] + sample_frame_unzigzag(value));
+		}
+		sensels[i] = history->sensels[i];
+	}
+
+	return SAMPLE_FRAME_OK;
+}
+
+/**
+ * Reads count bits (most significant bit first), fails if they are beyond the end of the payload.
+ */
+int sample_frame_getBits(sample_frame_decoder_t *decoder, uint32_t count, uint64_t *value)
+{
+	const uint8_t *pos;
+	uint64_t window = 0;
+	uint64_t high = 0;
+	uint32_t used;
+	uint32_t bytes;
+
+	if((uint64_t) decoder->bit + count > (uint64_t) decoder->header.payload_length * 8){
+		return SAMPLE_FRAME_ERR_INVALID;
+	}
+
+	if(count > 56){
+		sample_frame_getBits(decoder, count - 32, &high);
+		count = 32;
+	}
+
+	pos = &decoder->payload[decoder->bit >> 3];
+	used = decoder->bit & 7;
+	for(bytes = (used + count + 7) >> 3; bytes > 0; bytes--){
+		window = (window << 8) | *pos++;
+	}
+	window >>= (8 - ((used + count) & 7)) & 7;										//drop the bits behind the value
+	*value = (high << count) | (window & (~0ULL >> (64 - count)));
+	decoder->bit += count;
+
+	return SAMPLE_FRAME_OK;
+}
+
+int sample_frame_getBitsVarint(sample_frame_decoder_t *decoder, uint64_t *value)
+{
+	uint64_t result = 0;
+	uint64_t group;
+	uint32_t shift;
+
+	for(shift = 0; shift < 64; shift += 7){
+		if(sample_frame_getBits(decoder, 8, &group) != SAMPLE_FRAME_OK){
+			return SAMPLE_FRAME_ERR_INVALID;
+		}
+		result |= (group & 0x7F) << shift;
+		if((group & 0x80) == 0){
+			*value = result;
+			return SAMPLE_FRAME_OK;
+		}
+	}
+
+	return SAMPLE_FRAME_ERR_INVALID;
+}
+
+int sample_frame_getXor(sample_frame_decoder_t *decoder, uint32_t index, float *value)
+{
+	sample_frame_history_t *history = &decoder->history;
+	uint64_t control;
+	uint64_t leading;
+	uint64_t length;
+	uint64_t bits;
+
+	if(sample_frame_getBits(decoder, 1, &control) != SAMPLE_FRAME_OK){
+		return SAMPLE_FRAME_ERR_INVALID;
+	}
+	if(control == 1){
+		if(sample_frame_getBits(decoder, 1, &control) != SAMPLE_FRAME_OK){
+			return SAMPLE_FRAME_ERR_INVALID;
+		}
+		if(control == 1){															//new window
+			if(sample_frame_getBits(decoder, 5, &leading) != SAMPLE_FRAME_OK
+					|| sample_frame_getBits(decoder, 5, &length) != SAMPLE_FRAME_OK
+					|| leading + length + 1 > 32){
+				return SAMPLE_FRAME_ERR_INVALID;
+			}
+			history->leading[index] = (uint8_t) leading;
+			history->trailing[index] = (uint8_t)(32 - leading - length - 1);
+		}else if(history->trailing[index] == 0xFF){
+			return SAMPLE_FRAME_ERR_INVALID;
+		}
+		length = 32 - history->leading[index] - history->trailing[index];
+		if(sample_frame_getBits(decoder, (uint32_t) length, &bits) != SAMPLE_FRAME_OK){
+			return SAMPLE_FRAME_ERR_INVALID;
+		}
+		history->floats[index] ^= (uint32_t)(bits << history->trailing[index]);
+	}
+
+	memcpy(value, &history->floats[index], sizeof(*value));
+
+	return SAMPLE_FRAME_OK;
+}
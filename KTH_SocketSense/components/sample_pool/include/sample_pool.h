@@ -0,0 +1,87 @@
+/**
+ * @file sample_pool.h
+ * @brief Component that provides preallocated sample slots shared between the data collector and the consumers of the samples.
+ *
+ * All samples are recorded in place into slots of a statically allocated pool. Only the index of a slot (the handle)
+ * is passed between the tasks, the sample itself is never copied.
+ *
+ * Two lock-free single-producer/single-consumer rings connect the tasks:
+ * - the ready ring carries handles of recorded samples from the data collector to the consumer,
+ * - the free ring carries handles of processed samples back to the data collector.
+ *
+ * If the data collector does not find a free slot, the new sample is dropped and the overflow counter is incremented.
+ *
+ * @date October 17. 2026
+ */
+#ifndef COMPONENTS_SAMPLE_POOL_H_
+#define COMPONENTS_SAMPLE_POOL_H_
+
+#include "KTHSocketSense.h"
+
+/**
+ * @brief Number of sample slots in the pool, this must be a power of two.
+ */
+#define SAMPLE_POOL_SIZE CONFIG_SAMPLE_POOL_SIZE
+
+/**
+ * @brief Handle of one sample slot.
+ */
+typedef uint16_t sample_handle_t;
+
+/**
+ * @brief Statistics of the sample pool.
+ */
+typedef struct {
+	uint32_t	occupancy;			/**< Number of recorded samples that wait for the consumer. */
+	uint32_t	max_occupancy;		/**< Highest number of waiting samples since initialization. */
+	uint32_t	published;			/**< Number of samples handed over to the consumer. */
+	uint32_t	overflows;			/**< Number of samples that were dropped because no slot was free. */
+} sample_pool_stats_t;
+
+/**
+ * @brief Initializes the pool, all slots are free afterwards.
+ *
+ * @return ESP_OK if success, ESP_FAIL otherwise.
+ */
+esp_err_t sample_pool_init();
+
+/**
+ * @brief Takes a free slot from the pool (producer side).
+ *
+ * @param handle Destination for the handle of the slot.
+ * @return Pointer to the slot, NULL if the pool is exhausted (this is counted as overflow).
+ */
+SocketSense_Sample_t* sample_pool_acquire(sample_handle_t *handle);
+
+/**
+ * @brief Hands a recorded sample over to the consumer (producer side).
+ *
+ * @param handle Handle returned by sample_pool_acquire().
+ */
+void sample_pool_publish(sample_handle_t handle);
+
+/**
+ * @brief Takes the oldest recorded sample (consumer side).
+ *
+ * The slot stays owned by the consumer until it is returned with sample_pool_release().
+ *
+ * @param handle Destination for the handle of the slot.
+ * @return Pointer to the sample, NULL if no sample is waiting.
+ */
+SocketSense_Sample_t* sample_pool_receive(sample_handle_t *handle);
+
+/**
+ * @brief Returns a processed sample to the pool (consumer side).
+ *
+ * @param handle Handle returned by sample_pool_receive().
+ */
+void sample_pool_release(sample_handle_t handle);
+
+/**
+ * @brief Returns the statistics of the pool.
+ *
+ * @param stats Destination for the statistics.
+ */
+void sample_pool_getStatistics(sample_pool_stats_t *stats);
+
+#endif /* COMPONENTS_SAMPLE_POOL_H_ */
@@ -0,0 +1,163 @@
+/**
+ * @file sample_pool.c
+ * @brief Component that provides preallocated sample slots shared between the data collector and the consumers of the samples.
+ *
+ * Both rings use free running 32 bit counters. The head of a ring is only written by its producer and the tail
+ * only by its consumer, so no lock is needed. The acquire/release ordering of the counter accesses makes sure
+ * that the content of a slot is visible to the other core before its handle is.
+ *
+ * @date October 17. 2026
+ */
+#include <stddef.h>
+#include <string.h>
+
+#include "esp_system.h"
+#include "esp_log.h"
+#include <esp_err.h>
+
+#include "freertos/FreeRTOS.h"
+
+#include "sample_pool.h"
+
+#if (SAMPLE_POOL_SIZE & (SAMPLE_POOL_SIZE - 1)) != 0
+#error "CONFIG_SAMPLE_POOL_SIZE must be a power of two"
+#endif
+
+#define SAMPLE_POOL_MASK (SAMPLE_POOL_SIZE - 1)
+
+static const char *TAG = "SAMPLE_POOL";
+
+/**
+ * Single-producer/single-consumer ring of slot handles.
+ */
+typedef struct {
+	sample_handle_t		handles[SAMPLE_POOL_SIZE];
+	uint32_t			head;		//written by the producer only
+	uint32_t			tail;		//written by the consumer only
+} sample_ring_t;
+
+SocketSense_Sample_t sample_slots[SAMPLE_POOL_SIZE];
+
+sample_ring_t ready_ring;			//data collector -> consumer
+sample_ring_t free_ring;			//consumer -> data collector
+
+uint32_t pool_overflows = 0;
+uint32_t pool_max_occupancy = 0;
+
+/*****Private Functions Definitions*************************************************/
+
+uint8_t sample_ring_push(sample_ring_t *ring, sample_handle_t handle);
+uint8_t sample_ring_pop(sample_ring_t *ring, sample_handle_t *handle);
+uint32_t sample_ring_count(sample_ring_t *ring);
+
+/*****Public Functions**************************************************************/
+
+esp_err_t sample_pool_init()
+{
+	sample_handle_t i;
+
+	memset(&sample_slots, 0, sizeof(sample_slots));
+	memset(&ready_ring, 0, sizeof(ready_ring));
+	memset(&free_ring, 0, sizeof(free_ring));
+
+	for(i = 0; i < SAMPLE_POOL_SIZE; i++){		//all slots start in the free ring
+		sample_ring_push(&free_ring, i);
+	}
+
+	pool_overflows = 0;
+	pool_max_occupancy = 0;
+
+	ESP_LOGI(TAG, "init, %u slots of %u bytes", SAMPLE_POOL_SIZE, (unsigned int) sizeof(SocketSense_Sample_t));
+
+	return ESP_OK;
+}
+
+SocketSense_Sample_t* sample_pool_acquire(sample_handle_t *handle)
+{
+	if(sample_ring_pop(&free_ring, handle) == 0){
+		pool_overflows++;
+		return NULL;
+	}
+
+	return &sample_slots[*handle];
+}
+
+void sample_pool_publish(sample_handle_t handle)
+{
+	uint32_t occupancy;
+
+	sample_ring_push(&ready_ring, handle);		//can't fail, the ring has room for all slots
+
+	occupancy = sample_ring_count(&ready_ring);
+	if(occupancy > pool_max_occupancy){
+		pool_max_occupancy = occupancy;
+	}
+}
+
+SocketSense_Sample_t* sample_pool_receive(sample_handle_t *handle)
+{
+	if(sample_ring_pop(&ready_ring, handle) == 0){
+		return NULL;
+	}
+
+	return &sample_slots[*handle];
+}
+
+void sample_pool_release(sample_handle_t handle)
+{
+	sample_ring_push(&free_ring, handle);
+}
+
+void sample_pool_getStatistics(sample_pool_stats_t *stats)
+{
+	stats->occupancy = sample_ring_count(&ready_ring);
+	stats->max_occupancy = pool_max_occupancy;
+	stats->published = __atomic_load_n(&ready_ring.head, __ATOMIC_ACQUIRE);
+	stats->overflows = pool_overflows;
+}
+
+/*****Private Functions*************************************************************/
+
+/**
+ * Adds a handle to the ring, returns 0 if the ring is full.
+ */
+uint8_t sample_ring_push(sample_ring_t *ring, sample_handle_t handle)
+{
+	uint32_t head = ring->head;
+	uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+	if(head - tail >= SAMPLE_POOL_SIZE){
+		return 0;
+	}
+
+	ring->handles[head & SAMPLE_POOL_MASK] = handle;
+	__atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+
+	return 1;
+}
+
+/**
+ * Removes the oldest handle from the ring, returns 0 if the ring is empty.
+ */
+uint8_t sample_ring_pop(sample_ring_t *ring, sample_handle_t *handle)
+{
+	uint32_t tail = ring->tail;
+	uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+	if(head == tail){
+		return 0;
+	}
+
+	*handle = ring->handles[tail & SAMPLE_POOL_MASK];
+	__atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+
+	return 1;
+}
+
+/**
+ * Number of handles in the ring.
+ */
+uint32_t sample_ring_count(sample_ring_t *ring)
+{
+	return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+}
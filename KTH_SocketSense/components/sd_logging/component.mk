@@ -1,2 +1,2 @@
 COMPONENT_ADD_INCLUDEDIRS = include
-COMPONENT_DEPENDS = log
\ No newline at end of file
+COMPONENT_DEPENDS = log sample_frame column_log
\ No newline at end of file
@@ -0,0 +1,73 @@
+/**
+ * @file sd_columns.h
+ * @brief Writes the samples to the log-file in indexed column blocks (CONFIG_SD_LOGGING_FORMAT == SD_LOGGING_FORMAT_COLUMNS).
+ *
+ * The samples are collected in a block of CONFIG_SD_LOGGING_BLOCK_SAMPLES samples (see column_log.h). A full block, or
+ * a partial one once its first sample is CONFIG_SD_LOGGING_SYNC_INTERVAL_MS old, is handed to the writer task of the
+ * log-file. The offset and time range of every written block is kept, and after CONFIG_SD_LOGGING_INDEX_INTERVAL blocks
+ * they are written as an index block. If the log-file does not end on a block boundary, because a block was cut off
+ * by a reset, it is padded before the first block.
+ *
+ * The functions are only called by the InfluxDB task, thus no locking is needed.
+ *
+ * @date October 17. 2026
+ */
+#ifndef COMPONENTS_SD_COLUMNS_H_
+#define COMPONENTS_SD_COLUMNS_H_
+
+#include <stdint.h>
+
+#include "sample_frame.h"
+
+/**
+ * @brief Statistics of the column log.
+ */
+typedef struct {
+	uint32_t	samples;			/**< Number of samples that have been added. */
+	uint32_t	blocks;				/**< Number of samples blocks passed to the writer task. */
+	uint32_t	index_blocks;		/**< Number of index blocks passed to the writer task. */
+	uint32_t	dropped_blocks;		/**< Number of blocks that were dropped because the log buffer was full. */
+} sd_columns_stats_t;
+
+/**
+ * @brief Allocates the block buffer and the index.
+ *
+ * @param sensor_count Number of sensor strips of the samples.
+ * @param sensel_count Number of sensor elements per strip.
+ * @return ESP_OK if success, ESP_FAIL otherwise.
+ */
+esp_err_t sd_columns_init(uint8_t sensor_count, uint8_t sensel_count);
+
+/**
+ * @brief Adds one sample, the block is written once it is full or old enough.
+ *
+ * @param point The sample.
+ * @return ESP_OK if success, ESP_FAIL if a block could not be written.
+ */
+esp_err_t sd_columns_append(const sample_frame_point_t *point);
+
+/**
+ * @brief Writes the partial block if its first sample is older than CONFIG_SD_LOGGING_SYNC_INTERVAL_MS.
+ *
+ * This is called periodically, so the last samples are written even if the data collection stops.
+ *
+ * @return ESP_OK if success, ESP_FAIL if the block could not be written.
+ */
+esp_err_t sd_columns_poll();
+
+/**
+ * @brief Writes the partial block and an index of the blocks that are not indexed yet.
+ *
+ * @return ESP_OK if success, ESP_FAIL otherwise.
+ */
+esp_err_t sd_columns_flush();
+
+/**
+ * @brief Returns the statistics of the column log.
+ *
+ * @param stats Destination for the statistics.
+ * @return ESP_OK if success, ESP_FAIL otherwise.
+ */
+esp_err_t sd_columns_getStatistics(sd_columns_stats_t *stats);
+
+#endif /* COMPONENTS_SD_COLUMNS_H_ */
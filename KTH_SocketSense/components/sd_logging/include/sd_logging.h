@@ -6,6 +6,10 @@
  * This allows to avoid rebuilding the project for different patients.
  *
  * In addition, the SD-card is used to log measurement values along with the network transmission.
+ * Logging does not block the caller: the data is copied into a ring buffer and written in cluster aligned blocks
+ * by a dedicated writer task, which synchronizes the file every CONFIG_SD_LOGGING_SYNC_KB or CONFIG_SD_LOGGING_SYNC_INTERVAL_MS.
+ * CONFIG_SD_LOGGING_FORMAT selects the content of the log-file: line protocol in <uid>.txt, binary sample frames in
+ * <uid>.sfr, or samples stored column by column in indexed blocks in <uid>.col (see sd_columns.h).
  *
  * @author Matthias Becker
  * @date June 21. 2019
@@ -15,6 +19,39 @@
 
 #include <stddef.h>
 
+#define SD_LOGGING_FORMAT_TEXT		0		//!< CONFIG_SD_LOGGING_FORMAT: line protocol
+#define SD_LOGGING_FORMAT_FRAMES	1		//!< CONFIG_SD_LOGGING_FORMAT: sample frames, see sample_frame.h
+#define SD_LOGGING_FORMAT_COLUMNS	2		//!< CONFIG_SD_LOGGING_FORMAT: indexed column blocks, see column_log.h
+
+/**
+ * @brief Size of the blocks written by the writer task, this matches the allocation unit used when the card is formatted.
+ */
+#define SD_LOGGING_CLUSTER_SIZE (16 * 1024)
+
+/**
+ * @brief Number of requests that can wait for the writer task, see sd_logging_request().
+ */
+#define SD_LOGGING_REQUEST_QUEUE_LENGTH 4
+
+/**
+ * @brief Function that the writer task runs on behalf of another component, see sd_logging_request().
+ */
+typedef void (*sd_logging_request_t)(void *arg);
+
+/**
+ * @brief Statistics of the writer task.
+ */
+typedef struct {
+	uint32_t	bytes_written;			/**< Number of bytes written to the log-file. */
+	uint32_t	blocks_written;			/**< Number of write calls. */
+	uint32_t	syncs;					/**< Number of fsync calls. */
+	uint32_t	dropped_bytes;			/**< Number of bytes that were dropped because the ring buffer was full. */
+	uint32_t	throughput_bytes_per_s;	/**< Bytes written per second of wall time since the first log data arrived. */
+	uint32_t	max_commit_latency_us;	/**< Longest time in us one write (including the fsync) took. */
+	uint32_t	requests;				/**< Number of requests of other components that the writer task ran. */
+	uint32_t	max_request_time_us;	/**< Longest time in us one request took. */
+} sd_logging_stats_t;
+
 /**
  * @brief Initialize the SD-Card and mounts the partition.
  *
@@ -48,8 +85,51 @@ esp_err_t sd_load_configuration(uint8_t *wifi_ssid, uint8_t *wifi_pw, uint8_t *u
 /**
  * @brief This function adds the null terminated string str to the log-file.
  *
+ * A newline is appended after the string. The string may itself contain several newline separated lines.
+ * The string is only copied into the ring buffer of the writer task, if there is not enough space it is dropped.
+ *
  * @return ESP_OK if success, ESP_FAIL otherwise.
  */
 esp_err_t sd_logging_log(char* str);
 
+/**
+ * @brief This function adds len bytes of binary data to the log-file, e.g. a finished sample frame.
+ *
+ * Unlike sd_logging_log(), nothing is appended. The data is dropped if it does not fit into the ring buffer.
+ *
+ * @return ESP_OK if success, ESP_FAIL otherwise.
+ */
+esp_err_t sd_logging_write(const void* data, size_t len);
+
+/**
+ * @brief Hands a file operation of another component over to the writer task, so that the caller does not wait for
+ * the SD-card.
+ *
+ * The writer task runs the function between two blocks of the log-file, in the order of the requests. The function
+ * owns arg until it returns, e.g. it releases the buffer it has written.
+ *
+ * @param function The function that accesses the SD-card.
+ * @param arg Argument of the function.
+ * @return ESP_OK if the request is queued, ESP_FAIL if there is no writer task or SD_LOGGING_REQUEST_QUEUE_LENGTH
+ * requests are already waiting.
+ */
+esp_err_t sd_logging_request(sd_logging_request_t function, void *arg);
+
+/**
+ * @brief Returns the length the log-file will have once the data in the ring buffer has been written.
+ *
+ * This is the offset at which the next data passed to sd_logging_log() or sd_logging_write() will be stored.
+ *
+ * @return Length in bytes, 0 if the log-file has not been opened.
+ */
+long sd_logging_getLength();
+
+/**
+ * @brief Returns the statistics of the writer task.
+ *
+ * @param stats Destination for the statistics.
+ * @return ESP_OK if success, ESP_FAIL otherwise.
+ */
+esp_err_t sd_logging_getStatistics(sd_logging_stats_t *stats);
+
 #endif /* COMPONENTS_SD_LOGGING_H_ */
@@ -0,0 +1,75 @@
+/**
+ * @file sd_spool.h
+ * @brief Store-and-forward spool on the SD-card for data that has not been acknowledged by the database.
+ *
+ * Batches that could not be sent (no network, or the request failed) are appended to the spool file.
+ * Once the network is available again, the spool is read back in chunks of complete lines and replayed.
+ * The position up to which the database has acknowledged the spooled data is kept in a small index file,
+ * so the spool survives a reboot. When everything has been acknowledged the spool file is truncated.
+ *
+ * @date October 17. 2026
+ */
+#ifndef COMPONENTS_SD_SPOOL_H_
+#define COMPONENTS_SD_SPOOL_H_
+
+#include <stddef.h>
+
+/**
+ * @brief File that holds the spooled line protocol.
+ */
+#define SD_SPOOL_FILE "/sdcard/spool.txt"
+
+/**
+ * @brief File that holds the acknowledged offset into the spool file.
+ */
+#define SD_SPOOL_INDEX_FILE "/sdcard/spool.idx"
+
+/**
+ * @brief Opens the spool file and restores the acknowledged offset.
+ *
+ * This is called once the SD-card has been mounted.
+ *
+ * @return ESP_OK if success, ESP_FAIL otherwise.
+ */
+esp_err_t sd_spool_open();
+
+/**
+ * @brief Appends data to the spool, a newline is added after the data.
+ *
+ * @param data Line protocol (one or more newline separated lines).
+ * @param len Length of data.
+ * @return ESP_OK if success, ESP_FAIL otherwise.
+ */
+esp_err_t sd_spool_append(const char *data, size_t len);
+
+/**
+ * @brief Reads the oldest unacknowledged data from the spool.
+ *
+ * Only complete lines are returned, the data is null terminated and does not end with a newline.
+ * A line that does not fit into the buffer can never be replayed. It is not returned, instead len is set to its length
+ * so that the caller drops it with sd_spool_ack() and the spool continues with the next line.
+ *
+ * @param buffer Destination buffer.
+ * @param size Size of the destination buffer.
+ * @param len Number of bytes that have been read from the spool (including the last newline), this is passed to sd_spool_ack().
+ * @return ESP_OK if data was read, ESP_ERR_NOT_FOUND if the spool is empty, ESP_ERR_INVALID_SIZE if the oldest line
+ * 			does not fit into the buffer (len is its length), ESP_FAIL otherwise.
+ */
+esp_err_t sd_spool_read(char *buffer, size_t size, size_t *len);
+
+/**
+ * @brief Marks data returned by sd_spool_read() as acknowledged by the database.
+ *
+ * @param len Number of bytes that have been acknowledged.
+ * @return ESP_OK if success, ESP_FAIL otherwise.
+ */
+esp_err_t sd_spool_ack(size_t len);
+
+/**
+ * @brief Returns the number of bytes in the spool that have not been acknowledged yet.
+ *
+ * @return Spool depth in bytes.
+ */
+size_t sd_spool_getDepth();
+
+#endif /* COMPONENTS_SD_SPOOL_H_ */
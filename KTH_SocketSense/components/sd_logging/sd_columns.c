@@ -0,0 +1,205 @@
+/**
+ * @file sd_columns.c
+ * @brief Writes the samples to the log-file in indexed column blocks.
+ *
+ * The offset of a block is taken from sd_logging_getLength() right before the block is handed to the writer task,
+ * it is only added to the index if the block was accepted.
+ *
+ * @date October 17. 2026
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <esp_err.h>
+#include "esp_system.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "column_log.h"
+#include "sd_logging.h"
+#include "sd_columns.h"
+
+static const char *TAG = "SD_COLUMNS";
+
+column_log_block_t column_block;					//samples that have not been written yet
+column_log_entry_t *index_entries = NULL;			//blocks written since the last index block
+uint8_t *index_buffer = NULL;
+uint32_t index_count = 0;
+uint64_t last_index = COLUMN_LOG_NO_INDEX;			//offset of the last index block in the log-file
+uint32_t column_sequence = 0;
+int64_t block_start_us = 0;							//time the first sample of the block was added
+
+sd_columns_stats_t column_stats;
+
+/*****Private Functions Definitions*************************************************/
+
+esp_err_t sd_columns_writeBlock();
+esp_err_t sd_columns_writeIndex();
+esp_err_t sd_columns_align(long *offset);
+
+/*****Public Functions**************************************************************/
+
+esp_err_t sd_columns_init(uint8_t sensor_count, uint8_t sensel_count){
+	size_t capacity = COLUMN_LOG_BLOCK_LENGTH((size_t) CONFIG_SD_LOGGING_BLOCK_SAMPLES, (size_t) sensor_count * sensel_count);
+	uint8_t *buffer;
+
+	if(index_buffer != NULL){
+		return ESP_OK;
+	}
+
+	if(capacity > CONFIG_SD_LOGGING_BUFFER_SIZE){
+		ESP_LOGE(TAG, "A block of %u bytes does not fit into the log buffer", (unsigned int) capacity);
+		return ESP_FAIL;
+	}
+
+	buffer = malloc(capacity);
+	index_entries = malloc(CONFIG_SD_LOGGING_INDEX_INTERVAL * sizeof(column_log_entry_t));
+	index_buffer = malloc(COLUMN_LOG_INDEX_LENGTH(CONFIG_SD_LOGGING_INDEX_INTERVAL));
+	if(buffer == NULL || index_entries == NULL || index_buffer == NULL
+			|| column_log_init(&column_block, buffer, capacity, CONFIG_SD_LOGGING_BLOCK_SAMPLES, sensor_count, sensel_count) != COLUMN_LOG_OK){
+		ESP_LOGE(TAG, "Failed to allocate the column block");
+		free(buffer);
+		free(index_entries);
+		free(index_buffer);
+		index_entries = NULL;
+		index_buffer = NULL;
+		return ESP_FAIL;
+	}
+
+	ESP_LOGI(TAG, "init, blocks of %u samples (%u bytes), an index every %u blocks",
+			CONFIG_SD_LOGGING_BLOCK_SAMPLES, (unsigned int) capacity, CONFIG_SD_LOGGING_INDEX_INTERVAL);
+
+	return ESP_OK;
+}
+
+esp_err_t sd_columns_append(const sample_frame_point_t *point){
+	esp_err_t err = ESP_OK;
+
+	if(index_buffer == NULL){
+		return ESP_FAIL;
+	}
+
+	if(column_block.samples == 0){
+		block_start_us = esp_timer_get_time();
+	}
+	column_log_append(&column_block, point);
+	column_stats.samples++;
+
+	if(column_block.samples == column_block.max_samples){
+		err = sd_columns_writeBlock();
+	}else{
+		err = sd_columns_poll();
+	}
+
+	return err;
+}
+
+esp_err_t sd_columns_poll(){
+	if(index_buffer == NULL || column_block.samples == 0
+			|| esp_timer_get_time() - block_start_us < (int64_t) CONFIG_SD_LOGGING_SYNC_INTERVAL_MS * 1000){
+		return ESP_OK;
+	}
+
+	return sd_columns_writeBlock();
+}
+
+esp_err_t sd_columns_flush(){
+	esp_err_t err;
+
+	if(index_buffer == NULL){
+		return ESP_FAIL;
+	}
+
+	err = sd_columns_writeBlock();
+	if(index_count > 0 && sd_columns_writeIndex() != ESP_OK){
+		err = ESP_FAIL;
+	}
+
+	return err;
+}
+
+esp_err_t sd_columns_getStatistics(sd_columns_stats_t *stats){
+	if(stats == NULL){
+		return ESP_FAIL;
+	}
+
+	memcpy(stats, &column_stats, sizeof(sd_columns_stats_t));
+
+	return ESP_OK;
+}
+
+/*****Private Functions*************************************************************/
+
+/**
+ * Hands the block to the writer task and adds it to the index, an index block is written once the index is full.
+ */
+esp_err_t sd_columns_writeBlock(){
+	column_log_entry_t *entry = &index_entries[index_count];
+	esp_err_t err = ESP_FAIL;
+	long offset;
+	size_t length;
+
+	if(column_block.samples == 0){
+		return ESP_OK;
+	}
+
+	length = column_log_finish(&column_block, column_sequence++, last_index);
+	if(sd_columns_align(&offset) == ESP_OK && sd_logging_write(column_block.data, length) == ESP_OK){
+		entry->offset = (uint64_t) offset;
+		entry->min_timestamp_us = column_block.min_timestamp_us;
+		entry->max_timestamp_us = column_block.max_timestamp_us;
+		entry->samples = column_block.samples;
+		index_count++;
+		column_stats.blocks++;
+		err = ESP_OK;
+	}else{
+		column_stats.dropped_blocks++;
+	}
+	column_log_clear(&column_block);
+
+	if(index_count == CONFIG_SD_LOGGING_INDEX_INTERVAL && sd_columns_writeIndex() != ESP_OK){
+		err = ESP_FAIL;
+	}
+
+	return err;
+}
+
+/**
+ * Writes the entries of the blocks since the last index block. The entries are discarded even if the index block
+ * is dropped, the readers find these blocks by scanning.
+ */
+esp_err_t sd_columns_writeIndex(){
+	esp_err_t err = ESP_FAIL;
+	long offset;
+	size_t length;
+
+	length = column_log_writeIndex(index_buffer, COLUMN_LOG_INDEX_LENGTH(CONFIG_SD_LOGGING_INDEX_INTERVAL), index_entries,
+			index_count, column_block.sensor_count, column_block.sensel_count, column_sequence++, last_index);
+	if(sd_columns_align(&offset) == ESP_OK && sd_logging_write(index_buffer, length) == ESP_OK){
+		last_index = (uint64_t) offset;
+		column_stats.index_blocks++;
+		err = ESP_OK;
+	}else{
+		column_stats.dropped_blocks++;
+	}
+	index_count = 0;
+
+	return err;
+}
+
+/**
+ * Pads the log-file to the next block boundary, and returns the offset of the next block.
+ */
+esp_err_t sd_columns_align(long *offset){
+	static const uint8_t padding[COLUMN_LOG_ALIGNMENT] = {0};
+
+	*offset = sd_logging_getLength();
+	if(*offset % COLUMN_LOG_ALIGNMENT != 0){
+		ESP_LOGW(TAG, "The log-file ends with an incomplete block, padding it");
+		if(sd_logging_write(padding, COLUMN_LOG_ALIGNMENT - *offset % COLUMN_LOG_ALIGNMENT) != ESP_OK){
+			return ESP_FAIL;
+		}
+		*offset = sd_logging_getLength();
+	}
+
+	return ESP_OK;
+}
@@ -6,6 +6,10 @@
  * This allows to avoid rebuilding the project for different patients.
  *
  * In addition, the SD-card is used to log measurement values along with the network transmission.
+ * Log data is not written by the caller. It is copied into a ring buffer and a dedicated writer task
+ * collects it into cluster aligned blocks that are written to the log-file. The file is synchronized
+ * (fsync) once CONFIG_SD_LOGGING_SYNC_KB have been written or CONFIG_SD_LOGGING_SYNC_INTERVAL_MS have passed.
+ * Other components hand their file operations to the writer task as well (sd_logging_request()).
  *
  * @author Matthias Becker
  * @date June 21. 2019
@@ -21,15 +25,53 @@
 #include "driver/sdmmc_host.h"
 #include "driver/sdspi_host.h"
 #include "sdmmc_cmd.h"
+#include "esp_timer.h"
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+#include "freertos/ringbuf.h"
+
+#include "sd_logging.h"
+#include "sd_spool.h"
 #include "KTHSocketSense.h"
 
 static const char *TAG = "SD_LOGGING";
 
+#define SD_LOGGING_CPU 0
+
 uint8_t sd_initialized = 0;
 sdmmc_card_t* card;
 FILE* logFile = NULL;
 
+RingbufHandle_t log_ring = NULL;		//log data that waits for the writer task
+SemaphoreHandle_t log_mutex = NULL;		//keeps the string and its newline together in the ring buffer
+TaskHandle_t sd_writer_handle = NULL;
+QueueHandle_t request_queue = NULL;		//file operations of other components that wait for the writer task
+
+uint8_t *staging_block = NULL;			//one cluster of log data that is written at once
+long file_offset = 0;					//current size of the log-file
+long log_length = 0;					//size of the log-file including the data in the ring buffer
+
+sd_logging_stats_t sd_stats;
+int64_t first_data_us = 0;				//time the writer task received the first log data
+
+/**
+ * @brief A file operation of another component.
+ */
+typedef struct {
+	sd_logging_request_t	function;	/**< Function that the writer task calls. */
+	void					*arg;		/**< Argument of the function. */
+} sd_logging_request_item_t;
+
+/*****Private Functions Definitions*************************************************/
+
+esp_err_t sd_logging_startWriter();
+void sd_writer_commit(size_t len, uint8_t sync);
+void sd_writer_task(void * pvParameters);
+void sd_writer_runRequests();
+
 esp_err_t sd_logging_init()
 {
     
@@ -135,7 +177,13 @@ esp_err_t sd_load_configuration(uint8_t *wifi_ssid, uint8_t *wifi_pw, uint8_t *u
 
 
 		strcat((char*) uid_filename, (char*)tmp_uid);
+#if CONFIG_SD_LOGGING_FORMAT == SD_LOGGING_FORMAT_FRAMES
+		strcat((char*) uid_filename, ".sfr");						//binary sample frames, see sample_frame.h
+#elif CONFIG_SD_LOGGING_FORMAT == SD_LOGGING_FORMAT_COLUMNS
+		strcat((char*) uid_filename, ".col");						//indexed column blocks, see column_log.h
+#else
 		strcat((char*) uid_filename, ".txt");
+#endif
 		ESP_LOGI(TAG, "Searching log-file %s for user ID %s", uid_filename, tmp_uid);
 
 		if (stat((char*)uid_filename, &st) != 0) {				//check if the log-file for the defined user ID does not yet exist
@@ -150,6 +198,12 @@ esp_err_t sd_load_configuration(uint8_t *wifi_ssid, uint8_t *wifi_pw, uint8_t *u
 			return ESP_FAIL;
 		}
 
+		if(sd_logging_startWriter() != ESP_OK){
+			return ESP_FAIL;
+		}
+
+		sd_spool_open();										//data that was not sent before the last reboot is replayed from here
+
 	}else{
 		ESP_LOGI(TAG, "The configuration file does not exist.");
 		return ESP_FAIL;
@@ -159,23 +213,230 @@ esp_err_t sd_load_configuration(uint8_t *wifi_ssid, uint8_t *wifi_pw, uint8_t *u
 }
 
 esp_err_t sd_logging_log(char* str){
+	size_t len;
+
 	if(sd_initialized != 1){
-		ESP_LOGI(TAG, "Configuration not loaded, SD-card not initialized/present.");
+		ESP_LOGD(TAG, "Configuration not loaded, SD-card not initialized/present.");
+		return ESP_FAIL;
+	}
+
+	if(log_ring == NULL){
+		ESP_LOGD(TAG, "Log-file has not been setup.");
+		return ESP_FAIL;
+	}
+
+	len = strlen(str);
+
+	xSemaphoreTake(log_mutex, portMAX_DELAY);
+	if(xRingbufferGetCurFreeSize(log_ring) < len + 1){				//never block the caller, the data is dropped instead
+		xSemaphoreGive(log_mutex);
+		sd_stats.dropped_bytes += len + 1;
+		ESP_LOGW(TAG, "Log buffer full, %u bytes dropped", (unsigned int)(len + 1));
+		return ESP_FAIL;
+	}
+	xRingbufferSend(log_ring, str, len, 0);							//the string may contain several lines
+	xRingbufferSend(log_ring, "\n", 1, 0);							//adding a newline
+	log_length += len + 1;
+	xSemaphoreGive(log_mutex);
+
+	return ESP_OK;
+}
+
+esp_err_t sd_logging_write(const void* data, size_t len){
+	if(sd_initialized != 1 || log_ring == NULL){
+		ESP_LOGD(TAG, "Log-file has not been setup.");
+		return ESP_FAIL;
+	}
+
+	xSemaphoreTake(log_mutex, portMAX_DELAY);
+	if(xRingbufferGetCurFreeSize(log_ring) < len){
+		xSemaphoreGive(log_mutex);
+		sd_stats.dropped_bytes += len;
+		ESP_LOGW(TAG, "Log buffer full, %u bytes dropped", (unsigned int) len);
+		return ESP_FAIL;
+	}
+	xRingbufferSend(log_ring, data, len, 0);
+	log_length += len;
+	xSemaphoreGive(log_mutex);
+
+	return ESP_OK;
+}
+
+long sd_logging_getLength(){
+	long length;
+
+	if(log_mutex == NULL){
+		return 0;
+	}
+
+	xSemaphoreTake(log_mutex, portMAX_DELAY);
+	length = log_length;
+	xSemaphoreGive(log_mutex);
+
+	return length;
+}
+
+esp_err_t sd_logging_request(sd_logging_request_t function, void *arg){
+	sd_logging_request_item_t request;
+
+	if(request_queue == NULL || function == NULL){
+		return ESP_FAIL;
+	}
+
+	request.function = function;
+	request.arg = arg;
+	if(xQueueSend(request_queue, &request, 0) != pdTRUE){
+		ESP_LOGW(TAG, "Request queue full, request dropped");
 		return ESP_FAIL;
 	}
 
-	if(logFile == NULL){
-		ESP_LOGI(TAG, "Log-file has not been setup.");
+	return ESP_OK;
+}
+
+esp_err_t sd_logging_getStatistics(sd_logging_stats_t *stats){
+	if(stats == NULL){
 		return ESP_FAIL;
 	}
 
-	char* pos = strchr(str, '\0');				//adding a newline
-	if (pos) {
-		*pos = '\n';
+	memcpy(stats, &sd_stats, sizeof(sd_logging_stats_t));
+
+	return ESP_OK;
+}
+
+/*****Private Functions*************************************************************/
+
+/**
+ * Creates the ring buffer and the writer task for the open log-file.
+ */
+esp_err_t sd_logging_startWriter(){
+
+	if(sd_writer_handle != NULL){
+		return ESP_OK;
 	}
-	fprintf(logFile, str, card->cid.name);
-	fflush(logFile);
-	fsync(fileno(logFile));
+
+	setvbuf(logFile, NULL, _IONBF, 0);								//the writer task already writes whole clusters
+	fseek(logFile, 0, SEEK_END);
+	file_offset = ftell(logFile);
+	log_length = file_offset;
+
+	staging_block = malloc(SD_LOGGING_CLUSTER_SIZE);
+	log_mutex = xSemaphoreCreateMutex();
+	log_ring = xRingbufferCreate(CONFIG_SD_LOGGING_BUFFER_SIZE, RINGBUF_TYPE_BYTEBUF);
+	request_queue = xQueueCreate(SD_LOGGING_REQUEST_QUEUE_LENGTH, sizeof(sd_logging_request_item_t));
+	if(staging_block == NULL || log_mutex == NULL || log_ring == NULL || request_queue == NULL){
+		ESP_LOGE(TAG, "Failed to allocate the log buffers");
+		return ESP_FAIL;
+	}
+
+	xTaskCreatePinnedToCore(sd_writer_task, "sd_writer", 4096, NULL, 1, &sd_writer_handle, SD_LOGGING_CPU);
 
 	return ESP_OK;
 }
+
+/**
+ * Writes the first len bytes of the staging block to the log-file, and synchronizes the file if sync is set.
+ */
+void sd_writer_commit(size_t len, uint8_t sync){
+	int64_t start = esp_timer_get_time();
+	int64_t stop;
+	uint32_t latency;
+
+	if(len > 0){
+		if(fwrite(staging_block, 1, len, logFile) != len){
+			ESP_LOGE(TAG, "Failed to write %u bytes to the log-file", (unsigned int) len);
+		}
+		file_offset += len;
+		sd_stats.bytes_written += len;
+		sd_stats.blocks_written++;
+	}
+
+	if(sync > 0){
+		fsync(fileno(logFile));
+		sd_stats.syncs++;
+	}
+
+	stop = esp_timer_get_time();
+	latency = (uint32_t)(stop - start);
+	if(latency > sd_stats.max_commit_latency_us){
+		sd_stats.max_commit_latency_us = latency;
+	}
+	if(stop > first_data_us){														//over wall time, the idle time of the writer counts
+		sd_stats.throughput_bytes_per_s = (uint32_t)((uint64_t) sd_stats.bytes_written * 1000000ULL / (uint64_t)(stop - first_data_us));
+	}
+}
+
+/**
+ * The writer task collects the log data into blocks that end on a cluster boundary of the log-file.
+ * A block is written once it is complete, or with whatever has been collected when the durability window expires.
+ */
+void sd_writer_task(void * pvParameters){
+	size_t staged = 0;
+	size_t block_size;
+	size_t unsynced = 0;
+	size_t size;
+	uint8_t sync;
+	uint8_t *item;
+	int64_t now;
+	int64_t last_sync;
+
+	ESP_LOGI(TAG, "writer task started on core=%i", xPortGetCoreID());
+
+	last_sync = esp_timer_get_time();
+
+	while(1){
+		block_size = SD_LOGGING_CLUSTER_SIZE - (file_offset % SD_LOGGING_CLUSTER_SIZE);	//the first block fills up the current cluster
+
+		item = xRingbufferReceiveUpTo(log_ring, &size, 100 / portTICK_PERIOD_MS, block_size - staged);
+		if(item != NULL){
+			if(first_data_us == 0){
+				first_data_us = esp_timer_get_time();
+			}
+			memcpy(&staging_block[staged], item, size);
+			vRingbufferReturnItem(log_ring, item);
+			staged += size;
+		}
+
+		now = esp_timer_get_time();
+
+		if(staged == block_size){													//complete block
+			unsynced += staged;
+			sync = (unsynced >= CONFIG_SD_LOGGING_SYNC_KB * 1024) || (now - last_sync >= (int64_t) CONFIG_SD_LOGGING_SYNC_INTERVAL_MS * 1000);
+			sd_writer_commit(staged, sync);
+			staged = 0;
+		}else if((staged > 0 || unsynced > 0) && now - last_sync >= (int64_t) CONFIG_SD_LOGGING_SYNC_INTERVAL_MS * 1000){
+			sync = 1;																//durability window expired, commit the partial block
+			sd_writer_commit(staged, sync);
+			staged = 0;
+		}else{
+			sync = 0;
+		}
+
+		if(sync > 0){
+			unsynced = 0;
+			last_sync = now;
+			ESP_LOGD(TAG, "Synchronized, %u bytes written, %u bytes/s, max commit latency %u usec",
+					sd_stats.bytes_written, sd_stats.throughput_bytes_per_s, sd_stats.max_commit_latency_us);
+		}
+
+		sd_writer_runRequests();													//between two blocks of the log-file
+	}
+}
+
+/**
+ * Runs the file operations that other components have requested.
+ */
+void sd_writer_runRequests(){
+	sd_logging_request_item_t request;
+	int64_t start;
+	uint32_t duration;
+
+	while(xQueueReceive(request_queue, &request, 0) == pdTRUE){
+		start = esp_timer_get_time();
+		request.function(request.arg);
+		duration = (uint32_t)(esp_timer_get_time() - start);
+		sd_stats.requests++;
+		if(duration > sd_stats.max_request_time_us){
+			sd_stats.max_request_time_us = duration;
+		}
+	}
+}
@@ -0,0 +1,182 @@
+/**
+ * @file sd_spool.c
+ * @brief Store-and-forward spool on the SD-card for data that has not been acknowledged by the database.
+ *
+ * The spool is only used by the InfluxDB task, thus no locking is needed.
+ *
+ * @date October 17. 2026
+ */
+#include <stdio.h>
+#include <string.h>
+#include <sys/unistd.h>
+#include <sys/stat.h>
+#include <esp_err.h>
+#include "esp_system.h"
+#include "esp_log.h"
+
+#include "sd_spool.h"
+
+static const char *TAG = "SD_SPOOL";
+
+FILE* spoolFile = NULL;
+long spool_size = 0;				//size of the spool file
+long spool_acked = 0;				//offset up to which the data has been acknowledged
+
+/*****Private Functions Definitions*************************************************/
+
+esp_err_t sd_spool_writeIndex();
+size_t sd_spool_skipLine(char *buffer, size_t size, size_t count);
+
+/*****Public Functions**************************************************************/
+
+esp_err_t sd_spool_open(){
+	FILE* f;
+	long offset = 0;
+
+	spoolFile = fopen(SD_SPOOL_FILE, "a+");
+	if(spoolFile == NULL){
+		ESP_LOGE(TAG, "Failed to open %s", SD_SPOOL_FILE);
+		return ESP_FAIL;
+	}
+
+	fseek(spoolFile, 0, SEEK_END);
+	spool_size = ftell(spoolFile);
+
+	f = fopen(SD_SPOOL_INDEX_FILE, "r");
+	if(f != NULL){
+		if(fscanf(f, "%ld", &offset) != 1){
+			offset = 0;
+		}
+		fclose(f);
+	}
+	if(offset < 0 || offset > spool_size){
+		ESP_LOGW(TAG, "Invalid spool index %ld, replaying the whole spool", offset);
+		offset = 0;
+	}
+	spool_acked = offset;
+
+	ESP_LOGI(TAG, "Spool opened, %ld bytes not yet acknowledged", spool_size - spool_acked);
+
+	return ESP_OK;
+}
+
+esp_err_t sd_spool_append(const char *data, size_t len){
+
+	if(spoolFile == NULL){
+		return ESP_FAIL;
+	}
+
+	fseek(spoolFile, 0, SEEK_END);								//switching from reading to writing requires a seek
+	if(fwrite(data, 1, len, spoolFile) != len || fputc('\n', spoolFile) == EOF){
+		ESP_LOGE(TAG, "Failed to append %u bytes", (unsigned int) len);
+		return ESP_FAIL;
+	}
+	fflush(spoolFile);
+	fsync(fileno(spoolFile));
+
+	spool_size += len + 1;
+
+	return ESP_OK;
+}
+
+esp_err_t sd_spool_read(char *buffer, size_t size, size_t *len){
+	size_t count;
+	char *last;
+
+	*len = 0;
+
+	if(spoolFile == NULL){
+		return ESP_FAIL;
+	}
+
+	if(spool_acked >= spool_size){
+		return ESP_ERR_NOT_FOUND;
+	}
+
+	fseek(spoolFile, spool_acked, SEEK_SET);
+	count = fread(buffer, 1, size - 1, spoolFile);
+	if(count == 0){
+		return ESP_FAIL;
+	}
+
+	buffer[count] = '\0';
+	last = strrchr(buffer, '\n');								//only hand out complete lines
+	if(last == NULL){											//the line can't be replayed, it would block the spool for good
+		*len = sd_spool_skipLine(buffer, size, count);
+		ESP_LOGE(TAG, "Line at offset %ld does not fit into %u bytes, %u bytes are dropped", spool_acked,
+				(unsigned int) size, (unsigned int) *len);
+		return ESP_ERR_INVALID_SIZE;
+	}
+
+	*last = '\0';
+	*len = last - buffer + 1;
+
+	return ESP_OK;
+}
+
+esp_err_t sd_spool_ack(size_t len){
+
+	if(spoolFile == NULL){
+		return ESP_FAIL;
+	}
+
+	spool_acked += len;
+
+	if(spool_acked >= spool_size){								//everything has been replayed, start over with an empty spool
+		fclose(spoolFile);
+		spoolFile = fopen(SD_SPOOL_FILE, "w+");
+		if(spoolFile == NULL){
+			ESP_LOGE(TAG, "Failed to truncate %s", SD_SPOOL_FILE);
+			return ESP_FAIL;
+		}
+		spool_size = 0;
+		spool_acked = 0;
+		ESP_LOGI(TAG, "Spool completely replayed");
+	}
+
+	return sd_spool_writeIndex();
+}
+
+size_t sd_spool_getDepth(){
+	return (size_t)(spool_size - spool_acked);
+}
+
+/*****Private Functions*************************************************************/
+
+/**
+ * Continues reading the line of which count bytes are in the buffer, returns its length including the newline.
+ * A line without a newline (cut off by a reset while it was appended) ends at the end of the spool.
+ */
+size_t sd_spool_skipLine(char *buffer, size_t size, size_t count){
+	size_t length = count;
+	char *end;
+
+	while((count = fread(buffer, 1, size - 1, spoolFile)) > 0){
+		end = memchr(buffer, '\n', count);
+		if(end != NULL){
+			return length + (end - buffer) + 1;
+		}
+		length += count;
+	}
+
+	return length;
+}
+
+/**
+ * Persists the acknowledged offset, this is small enough to be rewritten every time.
+ */
+esp_err_t sd_spool_writeIndex(){
+	FILE* f = fopen(SD_SPOOL_INDEX_FILE, "w");
+
+	if(f == NULL){
+		ESP_LOGE(TAG, "Failed to write %s", SD_SPOOL_INDEX_FILE);
+		return ESP_FAIL;
+	}
+
+	fprintf(f, "%ld\n", spool_acked);
+	fflush(f);
+	fsync(fileno(f));
+	fclose(f);
+
+	return ESP_OK;
+}
@@ -5,6 +5,11 @@
  * Each sensor strip is connected to one MCP3208. This component reads values of each of the
  * connected sensor strips.
  *
+ * The sensor elements of a strip are read in one sweep. The SPI transactions of a sweep are built once
+ * during initialization and are queued back-to-back, so the SPI driver can process the whole strip from its
+ * interrupt without returning to the data collector task in between. The chip select line of the strip is
+ * toggled by the pre- and post-transaction callbacks of the SPI device.
+ *
  * @author Matthias Becker
  * @date June 12. 2019
  */
@@ -13,8 +18,20 @@
 
 #include "driver/spi_master.h"
 
+/**
+ * @brief Number of transactions the SPI device of the sensor strips needs to be able to queue.
+ *
+ * One sweep queues one transaction for each sensor element of a strip.
+ */
+#define SOCKETSENSE_SENSOR_QUEUE_SIZE CONFIG_SOCKETSENSE_SENSEL_COUNT
+
 /**
  * @brief This function initializes the sensors
+ *
+ * The SPI device has to be configured with socketsense_sensor_spi_pre_transfer_callback() and
+ * socketsense_sensor_spi_post_transfer_callback() as pre_cb and post_cb, and with a queue size of
+ * at least SOCKETSENSE_SENSOR_QUEUE_SIZE.
+ *
  * @param _spi Handle to the SPI device that is used to communicate with the sensors.
  * @return ESP_OK if success, ESP_FAIL otherwise.
  */
@@ -23,13 +40,39 @@ esp_err_t socketsense_sensor_init(spi_device_handle_t _spi);
 /**
  * @brief This function reads all sensor elements.
  *
- * The function sequentially reads all sensor elements that are present.
- * This is done over the provided SPI device handle. As there are potentially many
- * sensor strips, the chip select line is handled manually by this component.
- * This means, the function sets the respective CS line low/high using the GPIO functionality.
+ * The function sweeps all sensor strips that are present, one strip after the other.
+ * This is done over the provided SPI device handle, which holds the bus for the duration of the sweep.
+ * As there are potentially many sensor strips, the chip select line is handled by this component.
+ * This means, the SPI callbacks set the respective CS line low/high using the GPIO functionality.
  *
  * @param sensor_data Pointer to the array that is to be filled with the sensor data.
  */
 void socketsense_sensor_readSensorData(uint16_t sensor_data[][CONFIG_SOCKETSENSE_SENSEL_COUNT]);
 
+/**
+ * @brief Returns the time it took to sweep one sensor strip during the last call of socketsense_sensor_readSensorData().
+ *
+ * @param sensorId Index of the sensor strip (0 to CONFIG_SOCKETSENSE_SENSOR_COUNT - 1).
+ * @return Sweep time in us, 0 if the strip has not been read yet.
+ */
+uint32_t socketsense_sensor_getSweepTime(uint8_t sensorId);
+
+/**
+ * @brief SPI pre-transaction callback, pulls the chip select line of the addressed sensor strip low.
+ *
+ * This is called from the SPI driver (possibly in interrupt context) and must be registered as pre_cb of the SPI device.
+ *
+ * @param t The transaction that is about to start, t->user holds the chip select GPIO.
+ */
+void socketsense_sensor_spi_pre_transfer_callback(spi_transaction_t *t);
+
+/**
+ * @brief SPI post-transaction callback, releases the chip select line of the addressed sensor strip.
+ *
+ * This is called from the SPI driver (possibly in interrupt context) and must be registered as post_cb of the SPI device.
+ *
+ * @param t The transaction that just finished, t->user holds the chip select GPIO.
+ */
+void socketsense_sensor_spi_post_transfer_callback(spi_transaction_t *t);
+
 #endif /* COMPONENTS_SOCKETSENSE_SENSOR_SOCKETSENSE_SENSOR_H_ */
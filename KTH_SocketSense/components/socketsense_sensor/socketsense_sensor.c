@@ -16,6 +16,7 @@
 #include <esp_err.h>
 #include "esp_system.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 
 #include "socketsense_sensor.h"
 #include "KTHSocketSense.h"
@@ -28,19 +29,34 @@ static const char *TAG = "SOCKETSENSE SENSOR";
 
 gpio_num_t cs_line[MAX_SENSOR_STRIPS] = {PIN_NUM_SENSOR_CS1, PIN_NUM_SENSOR_CS2, PIN_NUM_SENSOR_CS3, PIN_NUM_SENSOR_CS4};
 
+/**
+ * Pre-built transactions of one sweep for each sensor strip. These are set up once during the initialization,
+ * the SPI driver only writes the received bytes into rx_data.
+ */
+spi_transaction_t sweep_transactions[CONFIG_SOCKETSENSE_SENSOR_COUNT][CONFIG_SOCKETSENSE_SENSEL_COUNT];
+
+/**
+ * Duration of the last sweep of each sensor strip in us.
+ */
+uint32_t sweep_time_us[CONFIG_SOCKETSENSE_SENSOR_COUNT];
+
 /*****Private Functions Definitions*************************************************/
 
+void socketsense_sensor_sweep(uint8_t sensorId, uint16_t sensor_data[CONFIG_SOCKETSENSE_SENSEL_COUNT]);
 uint16_t socketsense_sensor_read(uint8_t sensorId, uint8_t senselId);
 
 /*****Public Functions**************************************************************/
 
 /**
  * Initialize the sensors. This includes mainly the configuration of
- * GPIO pins that are used as chip select for the individual sensor strips.
+ * GPIO pins that are used as chip select for the individual sensor strips,
+ * and the transactions that are used to sweep the sensor strips.
  */
 esp_err_t socketsense_sensor_init(spi_device_handle_t _spi)
 {
 	uint8_t i = 0;
+	uint8_t sensor_id = 0;
+	uint8_t sensel_id = 0;
 
 	spiHandle = _spi;
 
@@ -51,6 +67,20 @@ esp_err_t socketsense_sensor_init(spi_device_handle_t _spi)
 		gpio_set_level(cs_line[i], 1);
 	}
 
+	//build the transactions of each sweep, one reading of the MCP3208 is performed by transmitting 3 bytes
+	memset(&sweep_transactions, 0, sizeof(sweep_transactions));
+	for(sensor_id = 0; sensor_id < CONFIG_SOCKETSENSE_SENSOR_COUNT; sensor_id++){
+		for(sensel_id = 0; sensel_id < CONFIG_SOCKETSENSE_SENSEL_COUNT; sensel_id++){
+			spi_transaction_t *t = &sweep_transactions[sensor_id][sensel_id];
+			t->length = 3 * 8;
+			t->flags = SPI_TRANS_USE_RXDATA | SPI_TRANS_USE_TXDATA;
+			t->user = (void*)(intptr_t)cs_line[sensor_id];											//the callbacks use this to select the strip
+			t->tx_data[0] = (0x01 << 2) | (0x01 << 1) | (sensel_id >> 2);						//start bit, single ended, D2
+			t->tx_data[1] = (sensel_id << 6);													//D1, D0
+		}
+		sweep_time_us[sensor_id] = 0;
+	}
+
 	ESP_LOGI(TAG, "Initialized");
 
 	return ESP_OK;
@@ -62,34 +92,74 @@ esp_err_t socketsense_sensor_init(spi_device_handle_t _spi)
 void socketsense_sensor_readSensorData(uint16_t sensor_data[][CONFIG_SOCKETSENSE_SENSEL_COUNT]){
 
 	uint8_t sensor_id = 0;
-	uint8_t sensel_id = 0;
+
+	ESP_ERROR_CHECK( spi_device_acquire_bus(spiHandle, portMAX_DELAY) );	//keep the bus for the whole sweep
 
 	for(sensor_id = 0; sensor_id < CONFIG_SOCKETSENSE_SENSOR_COUNT; sensor_id++){
-		for(sensel_id = 0; sensel_id < CONFIG_SOCKETSENSE_SENSEL_COUNT; sensel_id++){
-			sensor_data[sensor_id][sensel_id] = socketsense_sensor_read(sensor_id, sensel_id);
-		}
+		socketsense_sensor_sweep(sensor_id, sensor_data[sensor_id]);
+	}
+
+	spi_device_release_bus(spiHandle);
+}
+
+uint32_t socketsense_sensor_getSweepTime(uint8_t sensorId){
+	if(sensorId >= CONFIG_SOCKETSENSE_SENSOR_COUNT){
+		return 0;
 	}
+	return sweep_time_us[sensorId];
+}
+
+void IRAM_ATTR socketsense_sensor_spi_pre_transfer_callback(spi_transaction_t *t){
+	gpio_set_level((gpio_num_t)(intptr_t)t->user, 0);
+}
+
+void IRAM_ATTR socketsense_sensor_spi_post_transfer_callback(spi_transaction_t *t){
+	gpio_set_level((gpio_num_t)(intptr_t)t->user, 1);
 }
 
 /*****Private Functions*************************************************************/
 
+/**
+ * This function reads all sensor elements of one sensor strip.
+ * With CONFIG_SOCKETSENSE_SENSOR_QUEUED_SWEEP all transactions are queued at once and the results are collected afterwards,
+ * otherwise each sensor element is read with a separate polling transaction.
+ */
+void socketsense_sensor_sweep(uint8_t sensorId, uint16_t sensor_data[CONFIG_SOCKETSENSE_SENSEL_COUNT]){
+	uint8_t sensel_id = 0;
+	int64_t start = esp_timer_get_time();
+
+#if CONFIG_SOCKETSENSE_SENSOR_QUEUED_SWEEP == 1
+	spi_transaction_t *t;
+
+	for(sensel_id = 0; sensel_id < CONFIG_SOCKETSENSE_SENSEL_COUNT; sensel_id++){
+		ESP_ERROR_CHECK( spi_device_queue_trans(spiHandle, &sweep_transactions[sensorId][sensel_id], portMAX_DELAY) );
+	}
+
+	for(sensel_id = 0; sensel_id < CONFIG_SOCKETSENSE_SENSEL_COUNT; sensel_id++){
+		ESP_ERROR_CHECK( spi_device_get_trans_result(spiHandle, &t, portMAX_DELAY) );	//results are returned in the order they were queued
+	}
+
+	for(sensel_id = 0; sensel_id < CONFIG_SOCKETSENSE_SENSEL_COUNT; sensel_id++){
+		t = &sweep_transactions[sensorId][sensel_id];
+		sensor_data[sensel_id] = (uint16_t)(((t->rx_data[1] & 0x0F) << 8) | (t->rx_data[2]));
+	}
+#else
+	for(sensel_id = 0; sensel_id < CONFIG_SOCKETSENSE_SENSEL_COUNT; sensel_id++){
+		sensor_data[sensel_id] = socketsense_sensor_read(sensorId, sensel_id);
+	}
+#endif
+
+	sweep_time_us[sensorId] = (uint32_t)(esp_timer_get_time() - start);
+}
+
 /**
  * This function reads a single sensor element and returns the ADC value
  * Each sensor strip has a MCP3208. One reading can be performed by transmitting 3 bytes.
  */
 uint16_t socketsense_sensor_read(uint8_t sensorId, uint8_t senselId){
-	spi_transaction_t t;
-	memset(&t, 0, sizeof(t));
-	t.length=3 * 8;
-	t.flags = SPI_TRANS_USE_RXDATA | SPI_TRANS_USE_TXDATA;
-	t.user = (void*)1;
-	t.tx_data[0] = (0x01 << 2) | (0x01 << 1) | (senselId >> 2);
-	t.tx_data[1] = (senselId << 6);
-
-	gpio_set_level(cs_line[sensorId], 0);
-	esp_err_t ret = spi_device_polling_transmit(spiHandle, &t);
-	gpio_set_level(cs_line[sensorId], 1);
-	assert( ret == ESP_OK );
-
-	return (uint16_t)(((t.rx_data[1] & 0x0F) << 8) | (t.rx_data[2]));
+	spi_transaction_t *t = &sweep_transactions[sensorId][senselId];
+
+	ESP_ERROR_CHECK( spi_device_polling_transmit(spiHandle, t) );			//the CS line is set by the SPI callbacks
+
+	return (uint16_t)(((t->rx_data[1] & 0x0F) << 8) | (t->rx_data[2]));
 }
@@ -0,0 +1,309 @@
+/**
+ * @file calibration_benchmark.c
+ * @brief Accuracy and speed of the fixed point sensel calibration against a float reference.
+ *
+ * The benchmark draws a calibration for every sensor element: a force sensing resistor like curve from counts to
+ * 0.1 kPa (no response below a threshold, then a power law) and a temperature drift of gain and offset. It writes
+ * the curves as fixed point tables to calib.txt in the SD-card directory, mounts it and loads them with
+ * sensel_calibration_load(), like the firmware does at boot.
+ *
+ * Accuracy: all counts 0..4095 at temperatures from 5 to 45 degC are calibrated with sensel_calibration_apply() and
+ * compared with the same calibration evaluated in float, once with the float curve sampled at the same knots
+ * (the error of the fixed point arithmetic) and once with the exact curve (including the error of the
+ * piecewise linear approximation). Errors are in units of the calibrated value (0.1 kPa).
+ *
+ * Speed: random samples are calibrated with the fixed point and with the float implementation, the time per sample
+ * is compared with the sampling period at DATA_COLLECTOR_MAX_SAMPLE_RATE_HZ.
+ *
+ * Usage: calibration_benchmark [-n samples] [-d sdcard_dir]
+ *   -n  Number of samples of the speed test (default 200000).
+ *   -d  Directory that backs the SD-card (default ./sdcard).
+ *
+ * @date October 17. 2026
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "esp_err.h"
+#include "esp_timer.h"
+#include "esp_vfs_fat.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "host_shims.h"
+
+#include "KTHSocketSense.h"
+#include "data_collector.h"
+#include "sensel_calibration.h"
+
+#define BENCHMARK_SENSELS (CONFIG_SOCKETSENSE_SENSOR_COUNT * CONFIG_SOCKETSENSE_SENSEL_COUNT)
+#define BENCHMARK_TREF 25.0f
+#define BENCHMARK_FULL_SCALE 4095.0f
+
+/**
+ * @brief Float model of one sensor element.
+ */
+typedef struct {
+	float	threshold;		/**< Counts below which the sensor element does not respond. */
+	float	range;			/**< Calibrated value at full scale and the reference temperature. */
+	float	exponent;		/**< Exponent of the power law. */
+	float	tc_gain;		/**< Relative gain per degC. */
+	float	tc_offset;		/**< Offset per degC. */
+	float	knots[SENSEL_CALIBRATION_KNOTS];	/**< The curve at the knots of the tables. */
+} sensel_model_t;
+
+/**
+ * @brief Errors of the fixed point calibration against one reference.
+ */
+typedef struct {
+	double		sum_squares;
+	double		max;
+	uint64_t	count;
+	uint64_t	within_one;	/**< Number of values that are off by at most 1. */
+} error_stats_t;
+
+static sensel_model_t models[BENCHMARK_SENSELS];
+static sensel_calibration_t calibration;
+
+/*****Private Functions Definitions*************************************************/
+
+static float random_uniform(float low, float high);
+static float model_curve(const sensel_model_t *model, float counts);
+static float model_apply(const sensel_model_t *model, float value, float temperature);
+static float model_interpolate(const sensel_model_t *model, uint16_t counts);
+static void float_apply(uint16_t values[][CONFIG_SOCKETSENSE_SENSEL_COUNT], float temperature);
+static void error_add(error_stats_t *stats, float reference, uint16_t value);
+static void error_print(const char *name, const error_stats_t *stats);
+static esp_err_t write_tables(const char *root);
+
+/*****Public Functions**************************************************************/
+
+int main(int argc, char **argv){
+	uint32_t samples = 200000;
+	const char *sdcard = "sdcard";
+	static uint16_t (*inputs)[CONFIG_SOCKETSENSE_SENSOR_COUNT][CONFIG_SOCKETSENSE_SENSEL_COUNT];
+	static float *temperatures;
+	uint16_t values[CONFIG_SOCKETSENSE_SENSOR_COUNT][CONFIG_SOCKETSENSE_SENSEL_COUNT];
+	error_stats_t arithmetic;
+	error_stats_t approximation;
+	uint64_t checksum = 0;
+	int64_t fixed_us;
+	int64_t float_us;
+	int64_t start;
+	float temperature;
+	uint32_t counts;
+	uint32_t i;
+	uint32_t j;
+	int opt;
+
+	while((opt = getopt(argc, argv, "n:d:")) != -1){
+		switch(opt){
+			case 'n': samples = strtoul(optarg, NULL, 10); break;
+			case 'd': sdcard = optarg; break;
+			default:
+				fprintf(stderr, "Usage: %s [-n samples] [-d sdcard_dir]\n", argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+	if(samples == 0){
+		samples = 1;
+	}
+
+	printf("SocketSense calibration benchmark: %d sensor strips x %d sensels, %d segments per curve\n",
+			CONFIG_SOCKETSENSE_SENSOR_COUNT, CONFIG_SOCKETSENSE_SENSEL_COUNT, SENSEL_CALIBRATION_SEGMENTS);
+
+	srand(1);
+	for(i = 0; i < BENCHMARK_SENSELS; i++){
+		models[i].threshold = random_uniform(80.0f, 300.0f);
+		models[i].range = random_uniform(2500.0f, 4000.0f);				//250 to 400 kPa in 0.1 kPa
+		models[i].exponent = random_uniform(1.2f, 2.0f);
+		models[i].tc_gain = random_uniform(-0.006f, -0.002f);
+		models[i].tc_offset = random_uniform(-0.5f, 0.5f);
+		for(j = 0; j < SENSEL_CALIBRATION_KNOTS; j++){
+			models[i].knots[j] = model_curve(&models[i], (float)(j << SENSEL_CALIBRATION_SEGMENT_SHIFT));
+		}
+	}
+
+	if(write_tables(sdcard) != ESP_OK){
+		return EXIT_FAILURE;
+	}
+	sensel_calibration_init(&calibration);
+	if(sensel_calibration_load(&calibration, SENSEL_CALIBRATION_FILE) != ESP_OK || calibration.calibrated != BENCHMARK_SENSELS){
+		fprintf(stderr, "The calibration tables could not be loaded\n");
+		return EXIT_FAILURE;
+	}
+
+	/* Accuracy */
+	memset(&arithmetic, 0, sizeof(arithmetic));
+	memset(&approximation, 0, sizeof(approximation));
+	for(temperature = 5.0f; temperature <= 45.0f; temperature += 0.25f){
+		for(counts = 0; counts <= 4095; counts++){
+			for(i = 0; i < BENCHMARK_SENSELS; i++){
+				(&values[0][0])[i] = (uint16_t) counts;
+			}
+			sensel_calibration_apply(&calibration, values, temperature);
+			for(i = 0; i < BENCHMARK_SENSELS; i++){
+				error_add(&arithmetic, model_apply(&models[i], model_interpolate(&models[i], counts), temperature),
+						(&values[0][0])[i]);
+				error_add(&approximation, model_apply(&models[i], model_curve(&models[i], counts), temperature),
+						(&values[0][0])[i]);
+			}
+		}
+	}
+	printf("\nAccuracy (all counts, 5 to 45 degC, in 0.1 kPa):\n");
+	error_print("fixed point vs float tables", &arithmetic);
+	error_print("fixed point vs float curves", &approximation);
+
+	/* Speed */
+	inputs = malloc(samples * sizeof(*inputs));
+	temperatures = malloc(samples * sizeof(float));
+	if(inputs == NULL || temperatures == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return EXIT_FAILURE;
+	}
+	for(i = 0; i < samples; i++){
+		for(j = 0; j < BENCHMARK_SENSELS; j++){
+			(&inputs[i][0][0])[j] = (uint16_t)(rand() % 4096);
+		}
+		temperatures[i] = random_uniform(20.0f, 38.0f);
+	}
+
+	start = esp_timer_get_time();
+	for(i = 0; i < samples; i++){
+		memcpy(values, inputs[i], sizeof(values));
+		sensel_calibration_apply(&calibration, values, temperatures[i]);
+		checksum += values[i % CONFIG_SOCKETSENSE_SENSOR_COUNT][i % CONFIG_SOCKETSENSE_SENSEL_COUNT];
+	}
+	fixed_us = esp_timer_get_time() - start;
+
+	start = esp_timer_get_time();
+	for(i = 0; i < samples; i++){
+		memcpy(values, inputs[i], sizeof(values));
+		float_apply(values, temperatures[i]);
+		checksum += values[i % CONFIG_SOCKETSENSE_SENSOR_COUNT][i % CONFIG_SOCKETSENSE_SENSEL_COUNT];
+	}
+	float_us = esp_timer_get_time() - start;
+
+	printf("\nSpeed (%u samples, checksum %llu):\n", samples, (unsigned long long) checksum);
+	printf("  fixed point: %8.1f ns/sample %6.2f ns/sensel, %.3f%% of the sampling period at %d Hz\n",
+			1e3 * fixed_us / samples, 1e3 * fixed_us / samples / BENCHMARK_SENSELS,
+			100.0 * fixed_us / samples * DATA_COLLECTOR_MAX_SAMPLE_RATE_HZ / 1e6, DATA_COLLECTOR_MAX_SAMPLE_RATE_HZ);
+	printf("  float:       %8.1f ns/sample %6.2f ns/sensel, %.3f%% of the sampling period at %d Hz\n",
+			1e3 * float_us / samples, 1e3 * float_us / samples / BENCHMARK_SENSELS,
+			100.0 * float_us / samples * DATA_COLLECTOR_MAX_SAMPLE_RATE_HZ / 1e6, DATA_COLLECTOR_MAX_SAMPLE_RATE_HZ);
+
+	free(inputs);
+	free(temperatures);
+
+	return arithmetic.max <= 1.0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*****Private Functions*************************************************************/
+
+static float random_uniform(float low, float high){
+	return low + (high - low) * (float) rand() / RAND_MAX;
+}
+
+/**
+ * The exact curve at the reference temperature.
+ */
+static float model_curve(const sensel_model_t *model, float counts){
+	if(counts <= model->threshold){
+		return 0.0f;
+	}
+	return model->range * powf((counts - model->threshold) / (BENCHMARK_FULL_SCALE - model->threshold), model->exponent);
+}
+
+static float model_apply(const sensel_model_t *model, float value, float temperature){
+	float delta = temperature - BENCHMARK_TREF;
+
+	return value * (1.0f + model->tc_gain * delta) + model->tc_offset * delta;
+}
+
+/**
+ * The curve at the reference temperature, interpolated between the knots.
+ */
+static float model_interpolate(const sensel_model_t *model, uint16_t counts){
+	uint32_t segment = counts >> SENSEL_CALIBRATION_SEGMENT_SHIFT;
+	float fraction = (float)(counts & ((1 << SENSEL_CALIBRATION_SEGMENT_SHIFT) - 1)) / (1 << SENSEL_CALIBRATION_SEGMENT_SHIFT);
+
+	return model->knots[segment] + (model->knots[segment + 1] - model->knots[segment]) * fraction;
+}
+
+/**
+ * The float implementation of sensel_calibration_apply().
+ */
+static void float_apply(uint16_t values[][CONFIG_SOCKETSENSE_SENSEL_COUNT], float temperature){
+	uint16_t *value = &values[0][0];
+	float y;
+	uint32_t i;
+
+	for(i = 0; i < BENCHMARK_SENSELS; i++){
+		y = model_apply(&models[i], model_interpolate(&models[i], value[i] < 4095 ? value[i] : 4095), temperature);
+		y = roundf(y);
+		value[i] = (uint16_t)(y < 0.0f ? 0.0f : (y > BENCHMARK_FULL_SCALE ? BENCHMARK_FULL_SCALE : y));
+	}
+}
+
+static void error_add(error_stats_t *stats, float reference, uint16_t value){
+	double error;
+
+	if(reference < 0.0f){											//the calibrated values are clamped
+		reference = 0.0f;
+	}else if(reference > BENCHMARK_FULL_SCALE){
+		reference = BENCHMARK_FULL_SCALE;
+	}
+	error = fabs((double) value - reference);
+	stats->sum_squares += error * error;
+	stats->count++;
+	if(error > stats->max){
+		stats->max = error;
+	}
+	if(error <= 1.0){
+		stats->within_one++;
+	}
+}
+
+static void error_print(const char *name, const error_stats_t *stats){
+	printf("  %-28s max %6.2f rms %6.3f, %.3f%% within 1\n", name, stats->max, sqrt(stats->sum_squares / stats->count),
+			100.0 * stats->within_one / stats->count);
+}
+
+/**
+ * Writes the models as fixed point tables to calib.txt in the SD-card directory.
+ */
+static esp_err_t write_tables(const char *root){
+	char path[512];
+	sdmmc_card_t *card;
+	FILE *f;
+	uint32_t i;
+	uint32_t j;
+
+	host_shims_setSdCardRoot(root);
+	if(esp_vfs_fat_sdmmc_mount("/sdcard", NULL, NULL, NULL, &card) != ESP_OK){
+		return ESP_FAIL;
+	}
+
+	snprintf(path, sizeof(path), "%s/calib.txt", root);
+	f = fopen(path, "w");
+	if(f == NULL){
+		fprintf(stderr, "Can't write %s\n", path);
+		return ESP_FAIL;
+	}
+	fprintf(f, "# Synthetic calibration of the calibration benchmark, values in 0.1 kPa\ntref %d\n", (int)(BENCHMARK_TREF * 100));
+	for(i = 0; i < BENCHMARK_SENSELS; i++){
+		fprintf(f, "%u %u %ld %ld", i / CONFIG_SOCKETSENSE_SENSEL_COUNT, i % CONFIG_SOCKETSENSE_SENSEL_COUNT,
+				lrintf(models[i].tc_gain * (1 << SENSEL_CALIBRATION_GAIN_BITS)),
+				lrintf(models[i].tc_offset * (1 << SENSEL_CALIBRATION_FRACTION_BITS)));
+		for(j = 0; j < SENSEL_CALIBRATION_KNOTS; j++){
+			fprintf(f, " %ld", lrintf(models[i].knots[j] * (1 << SENSEL_CALIBRATION_FRACTION_BITS)));
+		}
+		fprintf(f, "\n");
+	}
+	fclose(f);
+
+	return ESP_OK;
+}
@@ -0,0 +1,229 @@
+/**
+ * @file features_benchmark.c
+ * @brief Accuracy and cost of the incremental pressure features against a float reference.
+ *
+ * Synthetic samples with a load that moves over the sensor matrix (a pressure spot that circles the strips and moves
+ * along them, plus noise) are fed to sensel_features_update() at a simulated sampling rate. For every summary window the
+ * same features are computed in double from the raw samples and compared with the fixed point summary: the center of
+ * pressure in strips and sensor elements, the load shares in percent, the mean load and the peak.
+ *
+ * The cost of an update is measured over all samples (mean in ns) and compared with the sampling period; the summary
+ * itself reports the cost measured by the feature extraction (with the 1 us resolution of esp_timer).
+ *
+ * Usage: features_benchmark [-n samples] [-r rate_hz] [-i interval_ms]
+ *   -n  Number of samples (default 1000000).
+ *   -r  Simulated sampling rate in Hz (default 1000).
+ *   -i  Summary window in ms (default 1000).
+ *
+ * @date October 17. 2026
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "esp_timer.h"
+
+#include "KTHSocketSense.h"
+#include "sensel_features.h"
+
+#define BENCHMARK_SENSELS (CONFIG_SOCKETSENSE_SENSOR_COUNT * CONFIG_SOCKETSENSE_SENSEL_COUNT)
+
+/**
+ * @brief Float reference of one window.
+ */
+typedef struct {
+	double		strip_load[CONFIG_SOCKETSENSE_SENSOR_COUNT];
+	double		strip_moment;
+	double		sensel_moment;
+	uint32_t	samples;
+	uint16_t	peak;
+} reference_t;
+
+/**
+ * @brief Largest deviation of the fixed point summaries from the reference.
+ */
+typedef struct {
+	double		cop_strip;
+	double		cop_sensel;
+	double		load_share;
+	double		mean_load;
+	uint32_t	peak_mismatches;
+	uint32_t	windows;
+} deviation_t;
+
+/*****Private Functions Definitions*************************************************/
+
+static void make_sample(uint16_t values[][CONFIG_SOCKETSENSE_SENSEL_COUNT], double t);
+static void reference_add(reference_t *reference, uint16_t values[][CONFIG_SOCKETSENSE_SENSEL_COUNT]);
+static void reference_compare(const reference_t *reference, const SocketSense_Features_t *summary, deviation_t *deviation);
+static double maximum(double a, double b);
+
+/*****Public Functions**************************************************************/
+
+int main(int argc, char **argv){
+	uint32_t samples = 1000000;
+	uint32_t rate_hz = 1000;
+	uint32_t interval_ms = 1000;
+	static uint16_t (*inputs)[CONFIG_SOCKETSENSE_SENSOR_COUNT][CONFIG_SOCKETSENSE_SENSEL_COUNT];
+	sensel_features_t features;
+	SocketSense_Features_t summary;
+	SocketSense_Features_t last;
+	reference_t reference;
+	deviation_t deviation;
+	uint64_t cost_ns_sum = 0;
+	uint32_t cost_max_ns = 0;
+	int64_t start;
+	int64_t duration;
+	uint32_t i;
+	int opt;
+
+	while((opt = getopt(argc, argv, "n:r:i:")) != -1){
+		switch(opt){
+			case 'n': samples = strtoul(optarg, NULL, 10); break;
+			case 'r': rate_hz = strtoul(optarg, NULL, 10); break;
+			case 'i': interval_ms = strtoul(optarg, NULL, 10); break;
+			default:
+				fprintf(stderr, "Usage: %s [-n samples] [-r rate_hz] [-i interval_ms]\n", argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+	if(samples == 0 || rate_hz == 0){
+		fprintf(stderr, "samples and rate must be larger than 0\n");
+		return EXIT_FAILURE;
+	}
+
+	inputs = malloc(samples * sizeof(*inputs));
+	if(inputs == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return EXIT_FAILURE;
+	}
+	srand(1);
+	for(i = 0; i < samples; i++){
+		make_sample(inputs[i], (double) i / rate_hz);
+	}
+
+	printf("SocketSense feature benchmark: %d sensor strips x %d sensels, %u samples at %u Hz, windows of %u ms\n",
+			CONFIG_SOCKETSENSE_SENSOR_COUNT, CONFIG_SOCKETSENSE_SENSEL_COUNT, samples, rate_hz, interval_ms);
+
+	/* Accuracy */
+	sensel_features_init(&features, interval_ms, 1000000 / rate_hz);
+	memset(&reference, 0, sizeof(reference));
+	memset(&deviation, 0, sizeof(deviation));
+	memset(&last, 0, sizeof(last));
+	for(i = 0; i < samples; i++){
+		if(sensel_features_update(&features, inputs[i], (int64_t) i * 1000000 / rate_hz, &summary) != 0){
+			reference_compare(&reference, &summary, &deviation);		//the summary is of the window before this sample
+			memset(&reference, 0, sizeof(reference));
+			cost_ns_sum += summary.cost_avg_ns;
+			if(summary.cost_max_ns > cost_max_ns){
+				cost_max_ns = summary.cost_max_ns;
+			}
+			last = summary;
+		}
+		reference_add(&reference, inputs[i]);
+	}
+	if(deviation.windows == 0){
+		fprintf(stderr, "No window completed, use more samples or a shorter window\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("\nLast summary: %u samples, mean load %u, peak %u at s%u_%u, center of pressure strip %.2f sensel %.2f, load shares",
+			last.samples, last.mean_load, last.peak, last.peak_strip, last.peak_sensel, last.cop_strip / 256.0,
+			last.cop_sensel / 256.0);
+	for(i = 0; i < CONFIG_SOCKETSENSE_SENSOR_COUNT; i++){
+		printf(" %.2f%%", last.load_share[i] / 100.0);
+	}
+	printf("\n\nLargest deviation from the float reference over %u windows:\n", deviation.windows);
+	printf("  center of pressure: %.4f strips, %.4f sensels (resolution 1/256 = 0.0039)\n", deviation.cop_strip, deviation.cop_sensel);
+	printf("  load share:         %.4f %% (resolution 0.01 %%)\n", deviation.load_share);
+	printf("  mean load:          %.4f counts (truncated to integers)\n", deviation.mean_load);
+	printf("  peak:               %u windows with a different peak\n", deviation.peak_mismatches);
+
+	/* Cost */
+	sensel_features_init(&features, interval_ms, 1000000 / rate_hz);
+	start = esp_timer_get_time();
+	for(i = 0; i < samples; i++){
+		sensel_features_update(&features, inputs[i], (int64_t) i * 1000000 / rate_hz, &summary);
+	}
+	duration = esp_timer_get_time() - start;
+
+	printf("\nCost per sample: %.1f ns measured outside, %.1f ns mean and %u ns max reported by the summaries,\n",
+			1e3 * duration / samples, (double) cost_ns_sum / deviation.windows, cost_max_ns);
+	printf("  %.3f%% of the sampling period at %u Hz, %u samples over the budget of %u ns\n",
+			100.0 * duration / samples * rate_hz / 1e6, rate_hz, features.over_budget, features.budget_ns);
+
+	free(inputs);
+
+	return deviation.cop_strip < 0.01 && deviation.cop_sensel < 0.01 && deviation.load_share < 0.02
+			&& deviation.peak_mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*****Private Functions*************************************************************/
+
+/**
+ * A pressure spot that circles the strips once per second and moves along them, on top of a base load and noise.
+ */
+static void make_sample(uint16_t values[][CONFIG_SOCKETSENSE_SENSEL_COUNT], double t){
+	double spot_strip = fmod(t, 1.0) * CONFIG_SOCKETSENSE_SENSOR_COUNT;
+	double spot_sensel = (0.5 + 0.4 * sin(2.0 * M_PI * t / 7.0)) * (CONFIG_SOCKETSENSE_SENSEL_COUNT - 1);
+	double distance;
+	double value;
+	uint32_t sensor_id;
+	uint32_t sensel_id;
+
+	for(sensor_id = 0; sensor_id < CONFIG_SOCKETSENSE_SENSOR_COUNT; sensor_id++){
+		for(sensel_id = 0; sensel_id < CONFIG_SOCKETSENSE_SENSEL_COUNT; sensel_id++){
+			distance = fabs(sensor_id - spot_strip);
+			distance = fmin(distance, CONFIG_SOCKETSENSE_SENSOR_COUNT - distance);			//the strips go around the socket
+			value = 300.0 + 3500.0 * exp(-distance * distance - 0.2 * (sensel_id - spot_sensel) * (sensel_id - spot_sensel))
+					+ (rand() % 41) - 20;
+			values[sensor_id][sensel_id] = (uint16_t)(value < 0.0 ? 0.0 : (value > 4095.0 ? 4095.0 : value));
+		}
+	}
+}
+
+static void reference_add(reference_t *reference, uint16_t values[][CONFIG_SOCKETSENSE_SENSEL_COUNT]){
+	uint32_t sensor_id;
+	uint32_t sensel_id;
+
+	for(sensor_id = 0; sensor_id < CONFIG_SOCKETSENSE_SENSOR_COUNT; sensor_id++){
+		for(sensel_id = 0; sensel_id < CONFIG_SOCKETSENSE_SENSEL_COUNT; sensel_id++){
+			reference->strip_load[sensor_id] += values[sensor_id][sensel_id];
+			reference->strip_moment += (double) sensor_id * values[sensor_id][sensel_id];
+			reference->sensel_moment += (double) sensel_id * values[sensor_id][sensel_id];
+			if(values[sensor_id][sensel_id] > reference->peak){
+				reference->peak = values[sensor_id][sensel_id];
+			}
+		}
+	}
+	reference->samples++;
+}
+
+static void reference_compare(const reference_t *reference, const SocketSense_Features_t *summary, deviation_t *deviation){
+	double total = 0.0;
+	uint32_t sensor_id;
+
+	for(sensor_id = 0; sensor_id < CONFIG_SOCKETSENSE_SENSOR_COUNT; sensor_id++){
+		total += reference->strip_load[sensor_id];
+	}
+	deviation->windows++;
+	if(summary->samples != reference->samples || summary->peak != reference->peak){
+		deviation->peak_mismatches++;
+	}
+	if(total <= 0.0){
+		return;
+	}
+	deviation->cop_strip = maximum(deviation->cop_strip, fabs(summary->cop_strip / 256.0 - reference->strip_moment / total));
+	deviation->cop_sensel = maximum(deviation->cop_sensel, fabs(summary->cop_sensel / 256.0 - reference->sensel_moment / total));
+	deviation->mean_load = maximum(deviation->mean_load, fabs(summary->mean_load - total / reference->samples));
+	for(sensor_id = 0; sensor_id < CONFIG_SOCKETSENSE_SENSOR_COUNT; sensor_id++){
+		deviation->load_share = maximum(deviation->load_share,
+				fabs(summary->load_share[sensor_id] / 100.0 - 100.0 * reference->strip_load[sensor_id] / total));
+	}
+}
+
+static double maximum(double a, double b){
+	return a > b ? a : b;
+}
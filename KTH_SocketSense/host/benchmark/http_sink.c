@@ -0,0 +1,291 @@
+/**
+ * @file http_sink.c
+ * @brief Minimal InfluxDB write endpoint for the pipeline benchmark.
+ *
+ * @date October 17. 2026
+ */
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include "http_sink.h"
+
+#define HTTP_SINK_BUFFER_SIZE (64 * 1024)
+
+static int listen_sock = -1;
+static http_sink_stats_t sink_stats;
+static http_sink_faults_t sink_faults;
+static http_sink_point_cb_t point_callback = NULL;
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*****Private Functions Definitions*************************************************/
+
+static void *http_sink_acceptThread(void *arg);
+static void *http_sink_connectionThread(void *arg);
+
+/*****Public Functions**************************************************************/
+
+esp_err_t http_sink_start(int port){
+	struct sockaddr_in addr;
+	pthread_t thread;
+	int flag = 1;
+
+	listen_sock = socket(AF_INET, SOCK_STREAM, 0);
+	if(listen_sock < 0){
+		return ESP_FAIL;
+	}
+	setsockopt(listen_sock, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(port);
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	if(bind(listen_sock, (struct sockaddr*) &addr, sizeof(addr)) != 0 || listen(listen_sock, 8) != 0){
+		fprintf(stderr, "Can't listen on port %d: %s\n", port, strerror(errno));
+		close(listen_sock);
+		listen_sock = -1;
+		return ESP_FAIL;
+	}
+
+	if(pthread_create(&thread, NULL, http_sink_acceptThread, NULL) != 0){
+		return ESP_FAIL;
+	}
+	pthread_detach(thread);
+
+	return ESP_OK;
+}
+
+void http_sink_setFaults(const http_sink_faults_t *faults){
+	pthread_mutex_lock(&stats_lock);
+	if(faults != NULL){
+		sink_faults = *faults;
+	}else{
+		memset(&sink_faults, 0, sizeof(sink_faults));
+	}
+	pthread_mutex_unlock(&stats_lock);
+}
+
+void http_sink_setPointCallback(http_sink_point_cb_t callback){
+	pthread_mutex_lock(&stats_lock);
+	point_callback = callback;
+	pthread_mutex_unlock(&stats_lock);
+}
+
+void http_sink_getStatistics(http_sink_stats_t *stats){
+	pthread_mutex_lock(&stats_lock);
+	*stats = sink_stats;
+	pthread_mutex_unlock(&stats_lock);
+}
+
+/*****Private Functions*************************************************************/
+
+static void *http_sink_acceptThread(void *arg){
+	pthread_t thread;
+	intptr_t sock;
+	int flag = 1;
+
+	while(1){
+		sock = accept(listen_sock, NULL, NULL);
+		if(sock < 0){
+			continue;
+		}
+		setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+		pthread_mutex_lock(&stats_lock);
+		sink_stats.connections++;
+		pthread_mutex_unlock(&stats_lock);
+
+		if(pthread_create(&thread, NULL, http_sink_connectionThread, (void*) sock) != 0){
+			close(sock);
+			continue;
+		}
+		pthread_detach(thread);
+	}
+
+	return NULL;
+}
+
+/**
+ * Returns the UNIX time in us, the clock of the sample timestamps.
+ */
+static uint64_t http_sink_now(void){
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return (uint64_t) tv.tv_sec * 1000000ULL + (uint64_t) tv.tv_usec;
+}
+
+/**
+ * Counts the points of a body and passes their timestamps to the callback.
+ */
+static uint64_t http_sink_points(const char *body, size_t len, http_sink_point_cb_t callback, uint64_t accepted){
+	const char *line = body;
+	const char *end = body + len;
+	const char *newline;
+	const char *pos;
+	uint64_t timestamp;
+	uint64_t scale;
+	uint64_t points = 0;
+
+	while(line < end){
+		newline = memchr(line, '\n', end - line);
+		if(newline == NULL){
+			newline = end;										//the last line does not need a newline
+		}
+		if(newline > line){
+			points++;
+			if(callback != NULL){
+				timestamp = 0;
+				scale = 1;
+				for(pos = newline; pos > line && pos[-1] >= '0' && pos[-1] <= '9'; pos--){
+					timestamp += (uint64_t)(pos[-1] - '0') * scale;
+					scale *= 10;
+				}
+				if(pos < newline && pos > line && pos[-1] == ' '){
+					callback(timestamp, accepted);
+				}
+			}
+		}
+		line = newline + 1;
+	}
+
+	return points;
+}
+
+/**
+ * Serves the requests of one connection until the client closes it.
+ */
+static void *http_sink_connectionThread(void *arg){
+	static const char response[] = "HTTP/1.1 204 No Content\r\nContent-Type: application/json\r\nX-Influxdb-Version: host-sink\r\n\r\n";
+	static const char unavailable[] = "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\nX-Influxdb-Version: host-sink\r\n\r\n";
+	int sock = (int)(intptr_t) arg;
+	char *buffer = malloc(HTTP_SINK_BUFFER_SIZE);
+	char *body = NULL;
+	size_t body_capacity = 0;
+	size_t buffered = 0;
+	size_t content_length;
+	size_t header_len;
+	size_t body_read;
+	size_t chunk;
+	uint64_t points;
+	uint64_t accepted;
+	uint32_t delay_ms;
+	unsigned int seed = (unsigned int) sock;
+	http_sink_faults_t faults;
+	http_sink_point_cb_t callback;
+	char *header_end;
+	char *field;
+	char *grown;
+	ssize_t received;
+	float draw;
+
+	while(buffer != NULL){
+		while((header_end = memmem(buffer, buffered, "\r\n\r\n", 4)) == NULL){	//request line and header
+			if(buffered == HTTP_SINK_BUFFER_SIZE){							//header too large
+				goto out;
+			}
+			received = recv(sock, &buffer[buffered], HTTP_SINK_BUFFER_SIZE - buffered, 0);
+			if(received <= 0){
+				goto out;
+			}
+			buffered += received;
+		}
+		*header_end = '\0';
+		header_len = header_end - buffer + 4;
+
+		content_length = 0;
+		field = strcasestr(buffer, "\r\nContent-Length:");
+		if(field != NULL){
+			content_length = strtoul(field + 17, NULL, 10);
+		}
+
+		buffered -= header_len;											//body, possibly already partly received
+		memmove(buffer, &buffer[header_len], buffered);
+
+		if(content_length > body_capacity){								//the body is kept for the timestamps of its points
+			grown = realloc(body, content_length);
+			if(grown == NULL){
+				goto out;
+			}
+			body = grown;
+			body_capacity = content_length;
+		}
+		body_read = 0;
+		while(body_read < content_length){
+			if(buffered == 0){
+				received = recv(sock, buffer, HTTP_SINK_BUFFER_SIZE, 0);
+				if(received <= 0){
+					goto out;
+				}
+				buffered = received;
+			}
+			chunk = content_length - body_read < buffered ? content_length - body_read : buffered;
+			memcpy(&body[body_read], buffer, chunk);
+			body_read += chunk;
+			buffered -= chunk;
+			memmove(buffer, &buffer[chunk], buffered);
+		}
+
+		pthread_mutex_lock(&stats_lock);
+		sink_stats.requests++;
+		faults = sink_faults;
+		callback = point_callback;
+		pthread_mutex_unlock(&stats_lock);
+
+		draw = (float) rand_r(&seed) / RAND_MAX;
+		if(draw < faults.disconnect_rate){								//the request was received, but is never answered
+			pthread_mutex_lock(&stats_lock);
+			sink_stats.disconnects++;
+			pthread_mutex_unlock(&stats_lock);
+			goto out;
+		}
+
+		delay_ms = faults.delay_ms;
+		if((float) rand_r(&seed) / RAND_MAX < faults.slow_rate){
+			delay_ms += faults.slow_ms;
+		}
+		if(delay_ms > 0){
+			usleep(delay_ms * 1000);
+		}
+
+		if(draw < faults.disconnect_rate + faults.error_rate){
+			if(send(sock, unavailable, sizeof(unavailable) - 1, MSG_NOSIGNAL) < 0){
+				goto out;
+			}
+			pthread_mutex_lock(&stats_lock);
+			sink_stats.errors++;
+			sink_stats.slow += delay_ms > faults.delay_ms;
+			pthread_mutex_unlock(&stats_lock);
+			continue;
+		}
+
+		if(send(sock, response, sizeof(response) - 1, MSG_NOSIGNAL) < 0){
+			goto out;
+		}
+		accepted = http_sink_now();
+		points = http_sink_points(body, content_length, callback, accepted);
+
+		pthread_mutex_lock(&stats_lock);
+		sink_stats.points += points;
+		sink_stats.bytes += content_length;
+		sink_stats.slow += delay_ms > faults.delay_ms;
+		pthread_mutex_unlock(&stats_lock);
+	}
+
+out:
+	free(body);
+	free(buffer);
+	close(sock);
+
+	return NULL;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file http_sink.h
+ * @brief Minimal InfluxDB write endpoint for the pipeline benchmark.
+ *
+ * The sink accepts HTTP/1.1 POST requests with keep-alive, counts the received line protocol points and bytes,
+ * and answers each request with 204 No Content like InfluxDB does.
+ *
+ * Faults can be injected to see how the pipeline copes with a struggling database: answers can be delayed, a
+ * fraction of the requests is answered with 503 Service Unavailable, and another fraction is read but the connection
+ * is closed instead of answered. The timestamp of every accepted point can be passed to a callback together with the
+ * time its request was answered, which gives the end-to-end latency of the samples.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_BENCHMARK_HTTP_SINK_H_
+#define HOST_BENCHMARK_HTTP_SINK_H_
+
+#include <stdint.h>
+#include "esp_err.h"
+
+/**
+ * @brief Statistics of the sink.
+ */
+typedef struct {
+	uint32_t	connections;	/**< Number of accepted connections. */
+	uint32_t	requests;		/**< Number of received requests. */
+	uint64_t	points;			/**< Number of line protocol points of the accepted requests. */
+	uint64_t	bytes;			/**< Number of body bytes of the accepted requests. */
+	uint32_t	slow;			/**< Number of answers that were delayed by slow_ms. */
+	uint32_t	errors;			/**< Number of requests answered with 503. */
+	uint32_t	disconnects;	/**< Number of requests whose connection was closed instead of answered. */
+} http_sink_stats_t;
+
+/**
+ * @brief Faults injected by the sink, all zero answers every request right away.
+ */
+typedef struct {
+	uint32_t	delay_ms;		/**< Delay of every answer in ms. */
+	uint32_t	slow_ms;		/**< Additional delay of slow answers in ms. */
+	float		slow_rate;		/**< Fraction of the answers that are slow. */
+	float		error_rate;		/**< Fraction of the requests answered with 503. */
+	float		disconnect_rate;	/**< Fraction of the requests whose connection is closed instead of answered. */
+} http_sink_faults_t;
+
+/**
+ * @brief Called for every point of an accepted request.
+ *
+ * @param timestamp_usec Timestamp of the point (the last field of its line).
+ * @param accepted_usec UNIX time in us at which the request was answered.
+ */
+typedef void (*http_sink_point_cb_t)(uint64_t timestamp_usec, uint64_t accepted_usec);
+
+/**
+ * @brief Starts the sink on the loopback interface.
+ *
+ * @param port TCP port to listen on.
+ * @return ESP_OK if success, ESP_FAIL if the port can't be used.
+ */
+esp_err_t http_sink_start(int port);
+
+/**
+ * @brief Sets the injected faults, they apply to the requests received from now on.
+ *
+ * @param faults The faults, NULL disables them.
+ */
+void http_sink_setFaults(const http_sink_faults_t *faults);
+
+/**
+ * @brief Sets the callback that receives the accepted points, NULL disables it.
+ */
+void http_sink_setPointCallback(http_sink_point_cb_t callback);
+
+/**
+ * @brief Returns the statistics of the sink.
+ */
+void http_sink_getStatistics(http_sink_stats_t *stats);
+
+#endif /* HOST_BENCHMARK_HTTP_SINK_H_ */
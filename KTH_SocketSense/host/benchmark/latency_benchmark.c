@@ -0,0 +1,268 @@
+/**
+ * @file latency_benchmark.c
+ * @brief End-to-end latency of the measurement pipeline on the host, with and without a struggling database.
+ *
+ * The firmware tasks run as on the device (sampling timer, data collector, InfluxDB task, SD writer) against the
+ * InfluxDB sink on the loopback interface. The sink passes the timestamp of every accepted point to the benchmark,
+ * which gives the latency from the start of the sample (socketsense_sensor_readSensorData() follows right after the
+ * timestamp) until the database accepted it. The stages in between are measured by the probe, see latency_probe.h.
+ *
+ * The run is split into phases of equal length, each with other faults injected by the sink:
+ * 1. none,
+ * 2. slow: a share of the answers is delayed,
+ * 3. 5xx: a share of the requests is answered with 503,
+ * 4. disconnects: a share of the requests is never answered, the connection is closed,
+ * 5. all of them together.
+ * For every phase p50, p99 and max of every stage and of the end-to-end latency are reported. Samples of rejected
+ * batches go to the spool and are accepted when they are replayed, their end-to-end latency includes the time in
+ * the spool.
+ *
+ * Usage: latency_benchmark [-t seconds] [-r rate_hz] [-d sdcard_dir] [-l slow_ms] [-s slow_rate] [-e error_rate]
+ *                          [-x disconnect_rate] [-f]
+ *   -t  Duration of each phase in seconds (default 15).
+ *   -r  Sampling rate in Hz (default 200).
+ *   -d  Directory that backs the SD-card (default ./sdcard).
+ *   -l  Additional delay of the slow answers in ms (default 500).
+ *   -s  Share of the slow answers (default 0.1).
+ *   -e  Share of the requests answered with 503 (default 0.1).
+ *   -x  Share of the requests whose connection is closed (default 0.05).
+ *   -f  Do not simulate the SPI transfer time.
+ *
+ * @date October 17. 2026
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "host_shims.h"
+#include "http_sink.h"
+#include "latency_recorder.h"
+#include "latency_probe.h"
+
+#include "KTHSocketSense.h"
+#include "data_collector.h"
+#include "influxdb.h"
+#include "sd_logging.h"
+
+#define BENCHMARK_UID "bench"
+#define BENCHMARK_PHASES 5
+
+#if CONFIG_SD_LOGGING_FORMAT == SD_LOGGING_FORMAT_FRAMES
+#define BENCHMARK_LOG_FILE BENCHMARK_UID ".sfr"
+#elif CONFIG_SD_LOGGING_FORMAT == SD_LOGGING_FORMAT_COLUMNS
+#define BENCHMARK_LOG_FILE BENCHMARK_UID ".col"
+#else
+#define BENCHMARK_LOG_FILE BENCHMARK_UID ".txt"
+#endif
+
+/**
+ * @brief One phase of the benchmark and its results.
+ */
+typedef struct {
+	const char			*name;
+	http_sink_faults_t	faults;
+	latency_summary_t	stages[LATENCY_STAGE_COUNT];
+	latency_summary_t	end_to_end;
+} phase_t;
+
+static latency_recorder_t end_to_end;
+
+/*****Private Functions Definitions*************************************************/
+
+static esp_err_t prepare_sdcard(const char *root);
+static void record_point(uint64_t timestamp_usec, uint64_t accepted_usec);
+static void run_phase(phase_t *phase, uint32_t seconds);
+static void print_summary(const char *name, const latency_summary_t *summary);
+
+/*****Public Functions**************************************************************/
+
+int main(int argc, char **argv){
+	uint32_t seconds = 15;
+	uint32_t rate_hz = 200;
+	uint32_t slow_ms = 500;
+	float slow_rate = 0.1f;
+	float error_rate = 0.1f;
+	float disconnect_rate = 0.05f;
+	const char *sdcard = "sdcard";
+	uint8_t wifi_ssid[32] = {0};
+	uint8_t wifi_pw[64] = {0};
+	uint8_t uid[16] = {0};
+	char log_path[512];
+	phase_t phases[BENCHMARK_PHASES];
+	int opt;
+	int i;
+
+	while((opt = getopt(argc, argv, "t:r:d:l:s:e:x:f")) != -1){
+		switch(opt){
+			case 't': seconds = strtoul(optarg, NULL, 10); break;
+			case 'r': rate_hz = strtoul(optarg, NULL, 10); break;
+			case 'd': sdcard = optarg; break;
+			case 'l': slow_ms = strtoul(optarg, NULL, 10); break;
+			case 's': slow_rate = strtof(optarg, NULL); break;
+			case 'e': error_rate = strtof(optarg, NULL); break;
+			case 'x': disconnect_rate = strtof(optarg, NULL); break;
+			case 'f': host_shims_setSpiTiming(0); break;
+			default:
+				fprintf(stderr, "Usage: %s [-t seconds] [-r rate_hz] [-d sdcard_dir] [-l slow_ms] [-s slow_rate] [-e error_rate]"
+						" [-x disconnect_rate] [-f]\n", argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+	if(seconds == 0){
+		seconds = 1;
+	}
+
+	memset(phases, 0, sizeof(phases));
+	phases[0].name = "none";
+	phases[1].name = "slow";
+	phases[1].faults.slow_ms = slow_ms;
+	phases[1].faults.slow_rate = slow_rate;
+	phases[2].name = "5xx";
+	phases[2].faults.error_rate = error_rate;
+	phases[3].name = "disconnects";
+	phases[3].faults.disconnect_rate = disconnect_rate;
+	phases[4].name = "all";
+	phases[4].faults.slow_ms = slow_ms;
+	phases[4].faults.slow_rate = slow_rate;
+	phases[4].faults.error_rate = error_rate;
+	phases[4].faults.disconnect_rate = disconnect_rate;
+
+	printf("SocketSense latency benchmark: %d sensor strips x %d sensels at %u Hz, batches of %d points or %d ms, %u s per phase\n",
+			CONFIG_SOCKETSENSE_SENSOR_COUNT, CONFIG_SOCKETSENSE_SENSEL_COUNT, rate_hz, CONFIG_INFLUXDB_BATCH_SIZE,
+			CONFIG_INFLUXDB_BATCH_TIMEOUT_MS, seconds);
+
+	if(prepare_sdcard(sdcard) != ESP_OK){
+		return EXIT_FAILURE;
+	}
+
+	if(http_sink_start(CONFIG_INFLUXDB_PORT) != ESP_OK){
+		fprintf(stderr, "The InfluxDB sink can't be started, configure another port with -DHOST_INFLUXDB_PORT=<port>\n");
+		return EXIT_FAILURE;
+	}
+	latency_recorder_init(&end_to_end, "end-to-end");
+	http_sink_setPointCallback(record_point);
+
+	if(sd_logging_init() != ESP_OK || sd_load_configuration(wifi_ssid, wifi_pw, uid) != ESP_OK){
+		fprintf(stderr, "The SD-card could not be set up\n");
+		return EXIT_FAILURE;
+	}
+
+	snprintf(log_path, sizeof(log_path), "%s/%s", sdcard, BENCHMARK_LOG_FILE);
+	if(latency_probe_init(log_path) != ESP_OK){
+		fprintf(stderr, "The log-file %s was not created\n", log_path);
+		return EXIT_FAILURE;
+	}
+
+	if(data_collector_init() != ESP_OK || influxdb_init(uid) != ESP_OK || influxdb_enable() != ESP_OK
+			|| data_collector_start() != ESP_OK || data_collector_setSampleRate(rate_hz) != ESP_OK){
+		fprintf(stderr, "The components could not be started\n");
+		return EXIT_FAILURE;
+	}
+	data_collector_resume();
+
+	for(i = 0; i < BENCHMARK_PHASES; i++){
+		run_phase(&phases[i], seconds);
+	}
+
+	printf("\nEnd-to-end latency (sample start until accepted by the database):\n");
+	printf("  %-12s %10s %10s %10s %10s\n", "faults", "points", "p50 ms", "p99 ms", "max ms");
+	for(i = 0; i < BENCHMARK_PHASES; i++){
+		printf("  %-12s %10zu %10.1f %10.1f %10.1f\n", phases[i].name, phases[i].end_to_end.count,
+				phases[i].end_to_end.p50_us / 1e3, phases[i].end_to_end.p99_us / 1e3, phases[i].end_to_end.max_us / 1e3);
+	}
+
+	return EXIT_SUCCESS;											//the firmware tasks end with the process
+}
+
+/*****Private Functions*************************************************************/
+
+/**
+ * Creates the SD-card directory with a configuration file, and removes the files of previous runs.
+ */
+static esp_err_t prepare_sdcard(const char *root){
+	static const char *files[] = {BENCHMARK_UID ".txt", BENCHMARK_UID ".sfr", BENCHMARK_UID ".col", "spool.txt", "spool.idx"};
+	char path[512];
+	FILE *f;
+	size_t i;
+
+	host_shims_setSdCardRoot(root);
+	mkdir(root, 0755);
+
+	snprintf(path, sizeof(path), "%s/config.txt", root);
+	f = fopen(path, "w");
+	if(f == NULL){
+		fprintf(stderr, "Can't write %s\n", path);
+		return ESP_FAIL;
+	}
+	fprintf(f, "benchmark\nbenchmark\n%s\n", BENCHMARK_UID);
+	fclose(f);
+
+	for(i = 0; i < sizeof(files) / sizeof(files[0]); i++){
+		snprintf(path, sizeof(path), "%s/%s", root, files[i]);
+		unlink(path);
+	}
+
+	return ESP_OK;
+}
+
+/**
+ * Called by the sink for every accepted point, the timestamp was taken with the same clock.
+ */
+static void record_point(uint64_t timestamp_usec, uint64_t accepted_usec){
+	latency_recorder_add(&end_to_end, (int64_t)(accepted_usec - timestamp_usec));
+}
+
+/**
+ * Runs one phase with its faults and reports the latencies recorded during it.
+ */
+static void run_phase(phase_t *phase, uint32_t seconds){
+	latency_summary_t discarded;
+	http_sink_stats_t sink_before;
+	http_sink_stats_t sink;
+	influxdb_stats_t influx_before;
+	influxdb_stats_t influx;
+	int i;
+
+	http_sink_setFaults(&phase->faults);
+	for(i = 0; i < LATENCY_STAGE_COUNT; i++){
+		latency_recorder_take(latency_probe_getRecorder((latency_stage_t) i), &discarded);
+	}
+	latency_recorder_take(&end_to_end, &discarded);
+	http_sink_getStatistics(&sink_before);
+	influxdb_getStatistics(&influx_before);
+
+	vTaskDelay(seconds * 1000 / portTICK_PERIOD_MS);
+
+	for(i = 0; i < LATENCY_STAGE_COUNT; i++){
+		latency_recorder_take(latency_probe_getRecorder((latency_stage_t) i), &phase->stages[i]);
+	}
+	latency_recorder_take(&end_to_end, &phase->end_to_end);
+	http_sink_getStatistics(&sink);
+	influxdb_getStatistics(&influx);
+
+	printf("\nFaults: %s (%u ms delay on %.0f%% of the answers, %.0f%% 503, %.0f%% disconnects)\n", phase->name,
+			phase->faults.slow_ms, 100.0 * phase->faults.slow_rate, 100.0 * phase->faults.error_rate,
+			100.0 * phase->faults.disconnect_rate);
+	printf("  %-12s %10s %10s %10s %10s\n", "stage", "count", "p50 us", "p99 us", "max us");
+	for(i = 0; i < LATENCY_STAGE_COUNT; i++){
+		print_summary(latency_probe_getRecorder((latency_stage_t) i)->name, &phase->stages[i]);
+	}
+	print_summary(end_to_end.name, &phase->end_to_end);
+	printf("  sink:     %u requests, %u slow, %u answered with 503, %u disconnected\n",
+			sink.requests - sink_before.requests, sink.slow - sink_before.slow, sink.errors - sink_before.errors,
+			sink.disconnects - sink_before.disconnects);
+	printf("  influxdb: %u failed requests, %u bytes spooled, %u points replayed, %u replays backed off, spool depth %u bytes\n",
+			influx.failed - influx_before.failed, influx.spooled_bytes - influx_before.spooled_bytes,
+			influx.replayed_points - influx_before.replayed_points, influx.replay_failures - influx_before.replay_failures,
+			influx.spool_depth);
+}
+
+static void print_summary(const char *name, const latency_summary_t *summary){
+	printf("  %-12s %10zu %10u %10u %10u\n", name, summary->count, summary->p50_us, summary->p99_us, summary->max_us);
+}
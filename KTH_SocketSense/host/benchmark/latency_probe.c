@@ -0,0 +1,175 @@
+/**
+ * @file latency_probe.c
+ * @brief Measures the latency of the pipeline stages while the firmware tasks run unmodified.
+ *
+ * @date October 17. 2026
+ */
+#include <unistd.h>
+#include <sys/stat.h>
+#include <pthread.h>
+
+#include "esp_timer.h"
+#include "esp_http_client.h"
+
+#include "KTHSocketSense.h"
+#include "sample_pool.h"
+#include "sd_logging.h"
+#include "latency_probe.h"
+
+#define LATENCY_PROBE_SD_PENDING 1024			//log calls that wait for their synchronization
+
+/**
+ * Log data that has been handed to sd_logging and is not synchronized yet.
+ */
+typedef struct {
+	int64_t	logged_us;
+	long	end;								//length of the log-file once the data is written
+} sd_pending_t;
+
+static latency_recorder_t recorders[LATENCY_STAGE_COUNT];
+static const char *stage_names[LATENCY_STAGE_COUNT] = {"acquisition", "queue", "encode", "HTTP", "SD"};
+
+static int64_t acquired_us[SAMPLE_POOL_SIZE];	//per slot, written by the owner of the slot
+static int64_t published_us[SAMPLE_POOL_SIZE];
+static int64_t received_us[SAMPLE_POOL_SIZE];
+
+static dev_t log_device;
+static ino_t log_inode;
+static sd_pending_t sd_pending[LATENCY_PROBE_SD_PENDING];
+static uint32_t sd_head = 0;
+static uint32_t sd_tail = 0;
+static pthread_mutex_t sd_lock = PTHREAD_MUTEX_INITIALIZER;
+
+SocketSense_Sample_t* __real_sample_pool_acquire(sample_handle_t *handle);
+void __real_sample_pool_publish(sample_handle_t handle);
+SocketSense_Sample_t* __real_sample_pool_receive(sample_handle_t *handle);
+void __real_sample_pool_release(sample_handle_t handle);
+esp_err_t __real_esp_http_client_perform(esp_http_client_handle_t client);
+esp_err_t __real_sd_logging_log(char* str);
+esp_err_t __real_sd_logging_write(const void* data, size_t len);
+int __real_fsync(int fd);
+
+/*****Private Functions Definitions*************************************************/
+
+static void latency_probe_logged(int64_t start);
+
+/*****Public Functions**************************************************************/
+
+esp_err_t latency_probe_init(const char *log_path){
+	struct stat st;
+	int i;
+
+	if(stat(log_path, &st) != 0){
+		return ESP_FAIL;
+	}
+	log_device = st.st_dev;
+	log_inode = st.st_ino;
+
+	for(i = 0; i < LATENCY_STAGE_COUNT; i++){
+		latency_recorder_init(&recorders[i], stage_names[i]);
+	}
+
+	return ESP_OK;
+}
+
+latency_recorder_t* latency_probe_getRecorder(latency_stage_t stage){
+	return &recorders[stage];
+}
+
+/*****Wrapped Functions*************************************************************/
+
+SocketSense_Sample_t* __wrap_sample_pool_acquire(sample_handle_t *handle){
+	int64_t now = esp_timer_get_time();
+	SocketSense_Sample_t *sample = __real_sample_pool_acquire(handle);
+
+	if(sample != NULL){
+		acquired_us[*handle] = now;
+	}
+	return sample;
+}
+
+void __wrap_sample_pool_publish(sample_handle_t handle){
+	published_us[handle] = esp_timer_get_time();					//before the handle is visible to the consumer
+	latency_recorder_add(&recorders[LATENCY_STAGE_ACQUISITION], published_us[handle] - acquired_us[handle]);
+	__real_sample_pool_publish(handle);
+}
+
+SocketSense_Sample_t* __wrap_sample_pool_receive(sample_handle_t *handle){
+	SocketSense_Sample_t *sample = __real_sample_pool_receive(handle);
+
+	if(sample != NULL){
+		received_us[*handle] = esp_timer_get_time();
+		latency_recorder_add(&recorders[LATENCY_STAGE_QUEUE], received_us[*handle] - published_us[*handle]);
+	}
+	return sample;
+}
+
+void __wrap_sample_pool_release(sample_handle_t handle){
+	latency_recorder_add(&recorders[LATENCY_STAGE_ENCODE], esp_timer_get_time() - received_us[handle]);
+	__real_sample_pool_release(handle);
+}
+
+esp_err_t __wrap_esp_http_client_perform(esp_http_client_handle_t client){
+	int64_t start = esp_timer_get_time();
+	esp_err_t err = __real_esp_http_client_perform(client);
+
+	latency_recorder_add(&recorders[LATENCY_STAGE_HTTP], esp_timer_get_time() - start);
+	return err;
+}
+
+esp_err_t __wrap_sd_logging_log(char* str){
+	int64_t start = esp_timer_get_time();
+	esp_err_t err = __real_sd_logging_log(str);
+
+	if(err == ESP_OK){
+		latency_probe_logged(start);
+	}
+	return err;
+}
+
+esp_err_t __wrap_sd_logging_write(const void* data, size_t len){
+	int64_t start = esp_timer_get_time();
+	esp_err_t err = __real_sd_logging_write(data, len);
+
+	if(err == ESP_OK){
+		latency_probe_logged(start);
+	}
+	return err;
+}
+
+/**
+ * The log data is on the card once the log-file has been synchronized, everything up to its size is done.
+ */
+int __wrap_fsync(int fd){
+	int ret = __real_fsync(fd);
+	int64_t now = esp_timer_get_time();
+	struct stat st;
+
+	if(ret != 0 || fstat(fd, &st) != 0 || st.st_dev != log_device || st.st_ino != log_inode){
+		return ret;														//the spool
+	}
+
+	pthread_mutex_lock(&sd_lock);
+	while(sd_tail != sd_head && sd_pending[sd_tail % LATENCY_PROBE_SD_PENDING].end <= st.st_size){
+		latency_recorder_add(&recorders[LATENCY_STAGE_SD], now - sd_pending[sd_tail % LATENCY_PROBE_SD_PENDING].logged_us);
+		sd_tail++;
+	}
+	pthread_mutex_unlock(&sd_lock);
+
+	return ret;
+}
+
+/*****Private Functions*************************************************************/
+
+/**
+ * Remembers the end of log data that was just handed to sd_logging.
+ */
+static void latency_probe_logged(int64_t start){
+	pthread_mutex_lock(&sd_lock);
+	if(sd_head - sd_tail < LATENCY_PROBE_SD_PENDING){
+		sd_pending[sd_head % LATENCY_PROBE_SD_PENDING].logged_us = start;
+		sd_pending[sd_head % LATENCY_PROBE_SD_PENDING].end = sd_logging_getLength();
+		sd_head++;
+	}
+	pthread_mutex_unlock(&sd_lock);
+}
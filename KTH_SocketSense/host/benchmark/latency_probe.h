@@ -0,0 +1,47 @@
+/**
+ * @file latency_probe.h
+ * @brief Measures the latency of the pipeline stages while the firmware tasks run unmodified.
+ *
+ * The benchmark is linked with --wrap for the functions at the stage boundaries (see CMakeLists.txt), so the firmware
+ * calls pass through the probe, which timestamps them:
+ * - acquisition: from taking a slot of the sample pool until the recorded sample is published (timestamp, BME280,
+ *   sensor elements, deadband), per sample,
+ * - queue: from publishing the sample until the InfluxDB task receives it, per sample,
+ * - encode: from receiving the sample until its slot is released (line protocol and frame or column log), per sample,
+ * - HTTP: duration of esp_http_client_perform(), per request (batches and spool replays),
+ * - SD: from handing log data to sd_logging until the writer task synchronized it to the card, per log call.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_BENCHMARK_LATENCY_PROBE_H_
+#define HOST_BENCHMARK_LATENCY_PROBE_H_
+
+#include "esp_err.h"
+#include "latency_recorder.h"
+
+/**
+ * @brief Stages of the pipeline.
+ */
+typedef enum {
+	LATENCY_STAGE_ACQUISITION = 0,
+	LATENCY_STAGE_QUEUE,
+	LATENCY_STAGE_ENCODE,
+	LATENCY_STAGE_HTTP,
+	LATENCY_STAGE_SD,
+	LATENCY_STAGE_COUNT
+} latency_stage_t;
+
+/**
+ * @brief Initializes the recorders of the stages.
+ *
+ * @param log_path Path of the SD-card log-file on the host, its synchronization ends the SD stage.
+ * @return ESP_OK if success, ESP_FAIL if the log-file does not exist.
+ */
+esp_err_t latency_probe_init(const char *log_path);
+
+/**
+ * @brief Returns the recorder of a stage.
+ */
+latency_recorder_t* latency_probe_getRecorder(latency_stage_t stage);
+
+#endif /* HOST_BENCHMARK_LATENCY_PROBE_H_ */
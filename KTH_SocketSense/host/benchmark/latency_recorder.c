@@ -0,0 +1,81 @@
+/**
+ * @file latency_recorder.c
+ * @brief Records latencies and reports their percentiles, for the latency benchmark.
+ *
+ * @date October 17. 2026
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "latency_recorder.h"
+
+#define LATENCY_RECORDER_INITIAL_CAPACITY 4096
+
+/*****Private Functions Definitions*************************************************/
+
+static int latency_recorder_compare(const void *a, const void *b);
+
+/*****Public Functions**************************************************************/
+
+void latency_recorder_init(latency_recorder_t *recorder, const char *name){
+	memset(recorder, 0, sizeof(*recorder));
+	recorder->name = name;
+	pthread_mutex_init(&recorder->lock, NULL);
+}
+
+void latency_recorder_add(latency_recorder_t *recorder, int64_t latency_us){
+	uint32_t *grown;
+	size_t capacity;
+
+	if(latency_us < 0){
+		latency_us = 0;
+	}else if(latency_us > UINT32_MAX){
+		latency_us = UINT32_MAX;
+	}
+
+	pthread_mutex_lock(&recorder->lock);
+	if(recorder->count == recorder->capacity){
+		capacity = recorder->capacity > 0 ? 2 * recorder->capacity : LATENCY_RECORDER_INITIAL_CAPACITY;
+		grown = realloc(recorder->values, capacity * sizeof(uint32_t));
+		if(grown == NULL){
+			pthread_mutex_unlock(&recorder->lock);
+			return;
+		}
+		recorder->values = grown;
+		recorder->capacity = capacity;
+	}
+	recorder->values[recorder->count++] = (uint32_t) latency_us;
+	pthread_mutex_unlock(&recorder->lock);
+}
+
+void latency_recorder_take(latency_recorder_t *recorder, latency_summary_t *summary){
+	uint32_t *values;
+	size_t count;
+
+	pthread_mutex_lock(&recorder->lock);
+	values = recorder->values;
+	count = recorder->count;
+	recorder->values = NULL;
+	recorder->count = 0;
+	recorder->capacity = 0;
+	pthread_mutex_unlock(&recorder->lock);
+
+	memset(summary, 0, sizeof(*summary));
+	summary->count = count;
+	if(count > 0){
+		qsort(values, count, sizeof(uint32_t), latency_recorder_compare);
+		summary->p50_us = values[count / 2];
+		summary->p99_us = values[count - 1 - count / 100];
+		summary->max_us = values[count - 1];
+	}
+	free(values);
+}
+
+/*****Private Functions*************************************************************/
+
+static int latency_recorder_compare(const void *a, const void *b){
+	uint32_t x = *(const uint32_t*) a;
+	uint32_t y = *(const uint32_t*) b;
+
+	return (x > y) - (x < y);
+}
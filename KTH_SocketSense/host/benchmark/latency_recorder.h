@@ -0,0 +1,55 @@
+/**
+ * @file latency_recorder.h
+ * @brief Records latencies and reports their percentiles, for the latency benchmark.
+ *
+ * All values are kept, so the percentiles are exact. A recorder may be written by several threads.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_BENCHMARK_LATENCY_RECORDER_H_
+#define HOST_BENCHMARK_LATENCY_RECORDER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+
+/**
+ * @brief Latencies of one stage.
+ */
+typedef struct {
+	const char		*name;		/**< Name of the stage in the report. */
+	uint32_t		*values;	/**< Latencies in us. */
+	size_t			count;		/**< Number of latencies. */
+	size_t			capacity;	/**< Number of latencies that fit into values. */
+	pthread_mutex_t	lock;
+} latency_recorder_t;
+
+/**
+ * @brief Percentiles of a recorder.
+ */
+typedef struct {
+	size_t		count;		/**< Number of latencies. */
+	uint32_t	p50_us;		/**< Median in us. */
+	uint32_t	p99_us;		/**< 99th percentile in us. */
+	uint32_t	max_us;		/**< Largest latency in us. */
+} latency_summary_t;
+
+/**
+ * @brief Initializes an empty recorder.
+ *
+ * @param recorder The recorder.
+ * @param name Name of the stage, the string must stay valid.
+ */
+void latency_recorder_init(latency_recorder_t *recorder, const char *name);
+
+/**
+ * @brief Adds one latency, negative latencies are recorded as 0.
+ */
+void latency_recorder_add(latency_recorder_t *recorder, int64_t latency_us);
+
+/**
+ * @brief Returns the percentiles of the latencies and removes them from the recorder.
+ */
+void latency_recorder_take(latency_recorder_t *recorder, latency_summary_t *summary);
+
+#endif /* HOST_BENCHMARK_LATENCY_RECORDER_H_ */
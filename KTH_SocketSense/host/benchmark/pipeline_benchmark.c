@@ -0,0 +1,459 @@
+/**
+ * @file pipeline_benchmark.c
+ * @brief Benchmark of the complete measurement pipeline on the host.
+ *
+ * The benchmark runs in two phases:
+ * 1. Stages: the stages of the pipeline are called back-to-back for a number of samples, and the time spent in
+ *    each stage is measured (acquisition over SPI, hand-over through the sample pool, line protocol encoding,
+ *    sample frame encoding, HTTP transmission of a batch, and queueing of the batch for the SD-card writer).
+ *    This gives the highest sample rate the code can sustain, and where the time goes. With
+ *    CONFIG_DATA_COLLECTOR_DEADBAND, the bytes that the deadband saves in the line protocol and in the frames are
+ *    reported as well.
+ * 2. Pipeline: the firmware tasks run as on the device (sampling timer, data collector, InfluxDB task, SD writer)
+ *    at a fixed sampling rate, and the statistics of all components are reported.
+ * A phase fails if the SD log drops data because its ring buffer is full.
+ *
+ * The InfluxDB server is replaced by a sink on the loopback interface, the SD-card by a directory of the host.
+ *
+ * Usage: pipeline_benchmark [-n samples] [-t seconds] [-r rate_hz] [-d sdcard_dir] [-f]
+ *   -n  Number of samples of the stage benchmark (default 10000).
+ *   -t  Duration of the pipeline run in seconds (default 5).
+ *   -r  Sampling rate of the pipeline run in Hz (default 1000).
+ *   -d  Directory that backs the SD-card (default ./sdcard).
+ *   -f  Do not simulate the SPI transfer time.
+ *
+ * @date October 17. 2026
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "esp_err.h"
+#include "esp_timer.h"
+#include "esp_http_client.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "host_shims.h"
+#include "http_sink.h"
+
+#include "KTHSocketSense.h"
+#include "bme280.h"
+#include "socketsense_sensor.h"
+#include "data_collector.h"
+#include "sample_pool.h"
+#include "influxdb.h"
+#include "influxdb_batch.h"
+#include "line_protocol.h"
+#include "sd_logging.h"
+#include "sd_columns.h"
+#include "sample_frame.h"
+#include "sensel_deadband.h"
+
+#define BENCHMARK_UID "bench"
+
+/**
+ * @brief Time spent in one stage of the pipeline.
+ */
+typedef struct {
+	const char	*name;
+	uint64_t	count;
+	uint64_t	sum_us;
+	uint64_t	max_us;
+} stage_t;
+
+/*****Private Functions Definitions*************************************************/
+
+static void stage_add(stage_t *stage, int64_t start, int64_t stop);
+static void stage_print(const stage_t *stage, const char *unit);
+static esp_err_t prepare_sdcard(const char *root);
+static void wait_sd_log(long offset, size_t len);
+static esp_err_t run_stages(uint32_t samples);
+static esp_err_t run_pipeline(uint32_t seconds, uint32_t rate_hz);
+
+/*****Public Functions**************************************************************/
+
+int main(int argc, char **argv){
+	uint32_t samples = 10000;
+	uint32_t seconds = 5;
+	uint32_t rate_hz = 1000;
+	const char *sdcard = "sdcard";
+	uint8_t wifi_ssid[32] = {0};
+	uint8_t wifi_pw[64] = {0};
+	uint8_t uid[16] = {0};
+	int opt;
+
+	while((opt = getopt(argc, argv, "n:t:r:d:f")) != -1){
+		switch(opt){
+			case 'n': samples = strtoul(optarg, NULL, 10); break;
+			case 't': seconds = strtoul(optarg, NULL, 10); break;
+			case 'r': rate_hz = strtoul(optarg, NULL, 10); break;
+			case 'd': sdcard = optarg; break;
+			case 'f': host_shims_setSpiTiming(0); break;
+			default:
+				fprintf(stderr, "Usage: %s [-n samples] [-t seconds] [-r rate_hz] [-d sdcard_dir] [-f]\n", argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+
+	printf("SocketSense pipeline benchmark: %d sensor strips x %d sensels, batches of %d points\n",
+			CONFIG_SOCKETSENSE_SENSOR_COUNT, CONFIG_SOCKETSENSE_SENSEL_COUNT, CONFIG_INFLUXDB_BATCH_SIZE);
+
+	if(prepare_sdcard(sdcard) != ESP_OK){
+		return EXIT_FAILURE;
+	}
+
+	if(http_sink_start(CONFIG_INFLUXDB_PORT) != ESP_OK){
+		fprintf(stderr, "The InfluxDB sink can't be started, configure another port with -DHOST_INFLUXDB_PORT=<port>\n");
+		return EXIT_FAILURE;
+	}
+
+	if(sd_logging_init() != ESP_OK || sd_load_configuration(wifi_ssid, wifi_pw, uid) != ESP_OK){
+		fprintf(stderr, "The SD-card could not be set up\n");
+		return EXIT_FAILURE;
+	}
+
+	if(data_collector_init() != ESP_OK || influxdb_init(uid) != ESP_OK){
+		fprintf(stderr, "The components could not be initialized\n");
+		return EXIT_FAILURE;
+	}
+
+	if(samples > 0 && run_stages(samples) != ESP_OK){
+		return EXIT_FAILURE;
+	}
+
+	if(seconds > 0 && run_pipeline(seconds, rate_hz) != ESP_OK){
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;											//the firmware tasks end with the process
+}
+
+/*****Private Functions*************************************************************/
+
+static void stage_add(stage_t *stage, int64_t start, int64_t stop){
+	uint64_t duration = (uint64_t)(stop - start);
+
+	stage->count++;
+	stage->sum_us += duration;
+	if(duration > stage->max_us){
+		stage->max_us = duration;
+	}
+}
+
+static void stage_print(const stage_t *stage, const char *unit){
+	if(stage->count == 0){
+		return;
+	}
+	printf("  %-10s %10.2f us avg %8llu us max  (%llu %s)\n", stage->name, (double) stage->sum_us / stage->count,
+			(unsigned long long) stage->max_us, (unsigned long long) stage->count, unit);
+}
+
+/**
+ * Creates the SD-card directory with a configuration file, and removes the files of previous runs.
+ */
+static esp_err_t prepare_sdcard(const char *root){
+	static const char *files[] = {BENCHMARK_UID ".txt", BENCHMARK_UID ".sfr", BENCHMARK_UID ".col", "spool.txt", "spool.idx"};
+	char path[512];
+	FILE *f;
+	size_t i;
+
+	host_shims_setSdCardRoot(root);
+	mkdir(root, 0755);
+
+	snprintf(path, sizeof(path), "%s/config.txt", root);
+	f = fopen(path, "w");
+	if(f == NULL){
+		fprintf(stderr, "Can't write %s\n", path);
+		return ESP_FAIL;
+	}
+	fprintf(f, "benchmark\nbenchmark\n%s\n", BENCHMARK_UID);
+	fclose(f);
+
+	for(i = 0; i < sizeof(files) / sizeof(files[0]); i++){
+		snprintf(path, sizeof(path), "%s/%s", root, files[i]);
+		unlink(path);
+	}
+
+	return ESP_OK;
+}
+
+/**
+ * Waits until the ring buffer of the SD log has room for len bytes. Back-to-back, the stages produce log data much
+ * faster than at DATA_COLLECTOR_MAX_SAMPLE_RATE_HZ, for which CONFIG_SD_LOGGING_BUFFER_SIZE is sized.
+ * The data that has not been written yet is the length of the log minus offset (the log-file size when the
+ * statistics were zero) minus the bytes written, this includes the block that the writer task collects.
+ */
+static void wait_sd_log(long offset, size_t len){
+	sd_logging_stats_t sd;
+
+	while(1){
+		sd_logging_getStatistics(&sd);
+		if(sd_logging_getLength() - offset - (long) sd.bytes_written + (long) len <= CONFIG_SD_LOGGING_BUFFER_SIZE){
+			return;
+		}
+		vTaskDelay(1);
+	}
+}
+
+/**
+ * Calls the stages of the pipeline back-to-back and measures each of them.
+ */
+static esp_err_t run_stages(uint32_t samples){
+	stage_t acquire = {"acquire"};
+	stage_t handoff = {"handoff"};
+	stage_t encode = {"encode"};
+	stage_t frame_encode = {"frame"};
+	stage_t transmit = {"transmit"};
+	stage_t sd_log = {"sd log"};
+	esp_http_client_config_t config;
+	esp_http_client_handle_t client;
+	influxdb_batch_t batch;
+	static uint8_t frame_buffer[SAMPLE_FRAME_HEADER_SIZE
+			+ CONFIG_INFLUXDB_BATCH_SIZE * SAMPLE_FRAME_MAX_POINT_SIZE(CONFIG_SOCKETSENSE_SENSOR_COUNT * CONFIG_SOCKETSENSE_SENSEL_COUNT)];
+	sample_frame_t frame;
+	sample_frame_point_t point;
+	size_t frame_length;
+	uint64_t frame_bytes = 0;
+	static sensel_deadband_t deadband;
+#if CONFIG_DATA_COLLECTOR_DEADBAND > 0
+	static uint8_t full_frame_buffer[sizeof(frame_buffer)];
+	sample_frame_t full_frame;										//the same frames without the deadband
+	uint64_t full_frame_bytes = 0;
+	uint64_t saved_bytes = 0;
+#endif
+	SocketSense_Sample_t *sample;
+	sample_handle_t handle;
+	host_spi_stats_t spi_before;
+	host_spi_stats_t spi_after;
+	sd_logging_stats_t sd;
+	long sd_length;
+	uint64_t encoded_bytes = 0;
+	int64_t begin;
+	int64_t start;
+	int64_t stop;
+	uint32_t i;
+
+	memset(&config, 0, sizeof(config));
+	config.host = CONFIG_INFLUXDB_IP;
+	config.port = CONFIG_INFLUXDB_PORT;
+	config.path = "/write?db=esp32_tst&precision=u";
+	config.username = CONFIG_INFLUXDB_USERNAME;
+	config.password = CONFIG_INFLUXDB_PASSWORD;
+	client = esp_http_client_init(&config);
+	if(client == NULL || influxdb_batch_init(&batch, INFLUXDB_BATCH_INITIAL_CAPACITY) != ESP_OK){
+		return ESP_FAIL;
+	}
+	esp_http_client_set_method(client, HTTP_METHOD_POST);
+	sample_frame_init(&frame, frame_buffer, sizeof(frame_buffer), CONFIG_SOCKETSENSE_SENSOR_COUNT, CONFIG_SOCKETSENSE_SENSEL_COUNT,
+			CONFIG_INFLUXDB_FRAME_COMPRESSION);
+	sensel_deadband_init(&deadband, CONFIG_DATA_COLLECTOR_DEADBAND, CONFIG_DATA_COLLECTOR_KEYFRAME_INTERVAL);
+#if CONFIG_DATA_COLLECTOR_DEADBAND > 0
+	sample_frame_init(&full_frame, full_frame_buffer, sizeof(full_frame_buffer), CONFIG_SOCKETSENSE_SENSOR_COUNT,
+			CONFIG_SOCKETSENSE_SENSEL_COUNT, CONFIG_INFLUXDB_FRAME_COMPRESSION);
+#endif
+
+	printf("\nStages (%u samples back-to-back):\n", samples);
+
+	host_shims_getSpiStatistics(&spi_before);
+	sd_logging_getStatistics(&sd);
+	sd_length = sd_logging_getLength() - (long) sd.bytes_written;	//the log data is written back-to-back as well
+	begin = esp_timer_get_time();
+
+	for(i = 0; i < samples; i++){
+		start = esp_timer_get_time();
+		sample = sample_pool_acquire(&handle);
+		if(sample == NULL){
+			fprintf(stderr, "The sample pool is exhausted\n");
+			return ESP_FAIL;
+		}
+		sample->timestamp_usec = 1571313600000000ULL + (uint64_t) start;
+		bme280_readSensorData(&sample->bme280_data);
+		socketsense_sensor_readSensorData(sample->sensorstrip_data);
+		stop = esp_timer_get_time();
+		sample->sampling_time = (uint32_t)(stop - start);
+		sample->battery_voltage = 2 * HOST_SHIMS_BATTERY_MV;
+		sensel_deadband_apply(&deadband, sample);
+		sample_pool_publish(handle);
+		stage_add(&acquire, start, stop);
+
+		start = esp_timer_get_time();
+		sample = sample_pool_receive(&handle);
+		stage_add(&handoff, start, esp_timer_get_time());
+
+		start = esp_timer_get_time();
+		if(influxdb_batch_append(&batch, sample) != ESP_OK){
+			fprintf(stderr, "The sample could not be encoded\n");
+			return ESP_FAIL;
+		}
+		stage_add(&encode, start, esp_timer_get_time());
+
+		start = esp_timer_get_time();
+		point.timestamp_usec = sample->timestamp_usec;
+		point.temperature = sample->bme280_data.temperature;
+		point.humidity = sample->bme280_data.humidity;
+		point.pressure = sample->bme280_data.pressure;
+		point.sampling_time = sample->sampling_time;
+		point.battery_voltage = sample->battery_voltage;
+		point.sensels = &sample->sensorstrip_data[0][0];
+		point.sensel_mask = sample->keyframe ? NULL : sample->sensel_mask;
+		if(sample_frame_append(&frame, &point) != SAMPLE_FRAME_OK){
+			fprintf(stderr, "The sample could not be added to the frame\n");
+			return ESP_FAIL;
+		}
+		stage_add(&frame_encode, start, esp_timer_get_time());
+#if CONFIG_SD_LOGGING_FORMAT == SD_LOGGING_FORMAT_COLUMNS
+		start = esp_timer_get_time();										//the column log is written sample by sample
+		sd_columns_append(&point);
+		stage_add(&sd_log, start, esp_timer_get_time());
+#endif
+#if CONFIG_DATA_COLLECTOR_DEADBAND > 0
+		saved_bytes += line_protocol_suppressedLength(sample);
+		point.sensel_mask = NULL;
+		sample_frame_append(&full_frame, &point);
+#endif
+		sample_pool_release(handle);
+
+		if(batch.points >= CONFIG_INFLUXDB_BATCH_SIZE || i == samples - 1){
+			encoded_bytes += batch.length;
+			frame_length = sample_frame_finish(&frame, i);
+			frame_bytes += frame_length;
+#if CONFIG_DATA_COLLECTOR_DEADBAND > 0
+			full_frame_bytes += sample_frame_finish(&full_frame, i);
+			sample_frame_clear(&full_frame);
+#endif
+
+			start = esp_timer_get_time();
+			esp_http_client_set_post_field(client, batch.data, batch.length);
+			if(esp_http_client_perform(client) != ESP_OK || esp_http_client_get_status_code(client) != 204){
+				fprintf(stderr, "The batch could not be sent\n");
+				return ESP_FAIL;
+			}
+			stage_add(&transmit, start, esp_timer_get_time());
+
+#if CONFIG_SD_LOGGING_FORMAT != SD_LOGGING_FORMAT_COLUMNS
+			start = esp_timer_get_time();
+#if CONFIG_SD_LOGGING_FORMAT == SD_LOGGING_FORMAT_FRAMES
+			wait_sd_log(sd_length, frame_length);
+			sd_logging_write(frame.data, frame_length);
+#else
+			wait_sd_log(sd_length, batch.length + 1);
+			sd_logging_log(batch.data);
+#endif
+			stage_add(&sd_log, start, esp_timer_get_time());
+#endif
+
+			influxdb_batch_clear(&batch);
+			sample_frame_clear(&frame);
+		}
+	}
+
+	stop = esp_timer_get_time();
+	host_shims_getSpiStatistics(&spi_after);
+
+	stage_print(&acquire, "samples");
+	stage_print(&handoff, "samples");
+	stage_print(&encode, "samples");
+	stage_print(&frame_encode, "samples");
+	stage_print(&transmit, "batches");
+	stage_print(&sd_log, CONFIG_SD_LOGGING_FORMAT == SD_LOGGING_FORMAT_COLUMNS ? "samples" : "batches");
+	printf("  %u samples in %.3f s: %.0f samples/s, %.1f bytes/sample, %.2f MB/s line protocol\n",
+			samples, (stop - begin) / 1e6, samples * 1e6 / (stop - begin),
+			(double) encoded_bytes / samples, encoded_bytes / (double)(stop - begin));
+	printf("  frames (%s): %.1f bytes/sample, %.1fx smaller than the line protocol\n",
+			CONFIG_INFLUXDB_FRAME_COMPRESSION == 1 ? "gorilla" : "packed", (double) frame_bytes / samples,
+			(double) encoded_bytes / frame_bytes);
+#if CONFIG_DATA_COLLECTOR_DEADBAND > 0
+	printf("  deadband %d: %.1f%% of the sensels reported (%u keyframes), line protocol %.1f%% and frames %.1f%% smaller\n",
+			CONFIG_DATA_COLLECTOR_DEADBAND, 100.0 * deadband.sensels_reported / deadband.sensels_total, deadband.keyframes,
+			100.0 * saved_bytes / (encoded_bytes + saved_bytes), 100.0 * (1.0 - (double) frame_bytes / full_frame_bytes));
+#endif
+	printf("  SPI: %u transactions, %.1f us bus time per sample\n",
+			spi_after.transactions - spi_before.transactions,
+			(spi_after.bus_time_ns - spi_before.bus_time_ns) / 1000.0 / samples);
+
+	esp_http_client_cleanup(client);
+	influxdb_batch_free(&batch);
+
+	sd_logging_getStatistics(&sd);
+	if(sd.dropped_bytes > 0){
+		printf("  FAILED: %u bytes dropped by the SD log, increase CONFIG_SD_LOGGING_BUFFER_SIZE\n", sd.dropped_bytes);
+		return ESP_FAIL;
+	}
+
+	return ESP_OK;
+}
+
+/**
+ * Runs the firmware tasks at the given sampling rate and reports the statistics of the components.
+ */
+static esp_err_t run_pipeline(uint32_t seconds, uint32_t rate_hz){
+	data_collector_stats_t collector;
+	sample_pool_stats_t pool;
+	influxdb_stats_t influx;
+	sd_logging_stats_t sd_before;
+	sd_logging_stats_t sd;
+#if CONFIG_SD_LOGGING_FORMAT == SD_LOGGING_FORMAT_COLUMNS
+	sd_columns_stats_t columns;
+#endif
+	http_sink_stats_t sink_before;
+	http_sink_stats_t sink;
+	int64_t begin;
+	int64_t stop;
+
+	printf("\nPipeline (%u s at %u Hz):\n", seconds, rate_hz);
+
+	http_sink_getStatistics(&sink_before);
+	sd_logging_getStatistics(&sd_before);
+
+	if(influxdb_enable() != ESP_OK || data_collector_start() != ESP_OK || data_collector_setSampleRate(rate_hz) != ESP_OK){
+		return ESP_FAIL;
+	}
+	begin = esp_timer_get_time();
+	data_collector_resume();
+	vTaskDelay(seconds * 1000 / portTICK_PERIOD_MS);
+	data_collector_getStatistics(&collector);						//before the stop, the statistics are reset on the next start
+	data_collector_stop();
+	stop = esp_timer_get_time();
+
+	vTaskDelay((CONFIG_INFLUXDB_BATCH_TIMEOUT_MS + CONFIG_SD_LOGGING_SYNC_INTERVAL_MS + 500) / portTICK_PERIOD_MS);	//let the last batch and block drain
+
+	sample_pool_getStatistics(&pool);
+	influxdb_getStatistics(&influx);
+	sd_logging_getStatistics(&sd);
+	http_sink_getStatistics(&sink);
+
+	printf("  collector: %u samples, %u missed deadlines, jitter avg %u us max %u us, sampling time max %u us\n",
+			collector.samples, collector.missed_deadlines, collector.avg_jitter_us, collector.max_jitter_us, collector.max_sampling_time_us);
+	if(collector.sensels_reported != collector.sensels_total){
+		printf("  deadband:  %u of %u sensels reported (%u keyframes), %u line protocol bytes left out\n",
+				collector.sensels_reported, collector.sensels_total, collector.keyframes, influx.deadband_saved_bytes);
+	}
+	printf("  pool:      max occupancy %u of %d, %u overflows\n", pool.max_occupancy, SAMPLE_POOL_SIZE, pool.overflows);
+	printf("  influxdb:  %u batches, %u points, flush latency avg %u us max %u us, request avg %u us, %u reconnects\n",
+			influx.batches, influx.points, influx.avg_flush_latency_us, influx.max_flush_latency_us, influx.avg_request_time_us, influx.reconnects);
+	printf("  sd log:    %u bytes in %u blocks, %u syncs, %u bytes dropped, %.0f bytes/s, max commit %u us\n",
+			sd.bytes_written - sd_before.bytes_written, sd.blocks_written - sd_before.blocks_written, sd.syncs - sd_before.syncs,
+			sd.dropped_bytes - sd_before.dropped_bytes, (sd.bytes_written - sd_before.bytes_written) * 1e6 / (stop - begin),
+			sd.max_commit_latency_us);
+	if(sd.requests != sd_before.requests){
+		printf("  sd requests: %u run by the writer task, max %u us\n", sd.requests - sd_before.requests, sd.max_request_time_us);
+	}
+#if CONFIG_SD_LOGGING_FORMAT == SD_LOGGING_FORMAT_COLUMNS
+	sd_columns_getStatistics(&columns);
+	printf("  columns:   %u samples in %u blocks and %u index blocks, %u blocks dropped\n",
+			columns.samples, columns.blocks, columns.index_blocks, columns.dropped_blocks);
+#endif
+	printf("  delivered: %llu points (%.0f samples/s) in %u requests over %u connection(s)\n",
+			(unsigned long long)(sink.points - sink_before.points), (sink.points - sink_before.points) * 1e6 / (stop - begin),
+			sink.requests - sink_before.requests, sink.connections - sink_before.connections);
+
+	if(sd.dropped_bytes > sd_before.dropped_bytes){
+		printf("  FAILED: %u bytes dropped by the SD log, increase CONFIG_SD_LOGGING_BUFFER_SIZE\n", sd.dropped_bytes - sd_before.dropped_bytes);
+		return ESP_FAIL;
+	}
+
+	return ESP_OK;
+}
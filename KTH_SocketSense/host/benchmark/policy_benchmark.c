@@ -0,0 +1,313 @@
+/**
+ * @file policy_benchmark.c
+ * @brief Switching delay and savings of the activity-aware acquisition policy.
+ *
+ * A subject follows a daily routine (sitting, standing up, standing, walking, turning, stairs) while the gait monitor
+ * reports its activity with the phases of every stride. A share of the codes is replaced by a wrong activity, like a
+ * classifier that is unsure for a moment. The samples are taken at the rate of the profile that the policy selected,
+ * in simulated time, with the profiles of the data collector (acquisition_policy_initDefault()).
+ *
+ * For every change of the activity that changes the profile, the delay until the policy selected it is measured, and
+ * it is compared with the stride. The samples read and the points published (one per summary window while only the
+ * summaries are reported) are compared with sampling at the gait rate all the time.
+ *
+ * Finally a batch of CONFIG_INFLUXDB_BATCH_SIZE samples of a subject that stands still (a constant load with ADC noise) is
+ * encoded with the deadband of the gait and of the rest profile. The benchmark fails if the deadband of the rest profile
+ * does not make the batch smaller (only with CONFIG_DATA_COLLECTOR_POLICY, the deadband is not compiled in otherwise).
+ *
+ * Usage: policy_benchmark [-t hours] [-e error_rate] [-w hold_ms] [-s stride_ms]
+ *   -t  Simulated time in hours (default 24).
+ *   -e  Share of the codes with a wrong activity (default 0.02).
+ *   -w  Hold time of the policy in ms (default CONFIG_DATA_COLLECTOR_POLICY_HOLD_MS).
+ *   -s  Stride of the subject in ms (default 1100).
+ *
+ * The policy logs every transition to stderr, redirect it to keep the report short.
+ *
+ * @date October 17. 2026
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "KTHSocketSense.h"
+#include "gait_monitor.h"
+#include "acquisition_policy.h"
+#include "sensel_deadband.h"
+#include "influxdb_batch.h"
+
+#define BENCHMARK_SUMMARY_US		((int64_t) CONFIG_DATA_COLLECTOR_FEATURES_INTERVAL_MS * 1000)
+
+/**
+ * @brief One part of the routine.
+ */
+typedef struct {
+	uint32_t	activity;
+	uint32_t	seconds;
+} segment_t;
+
+/**
+ * @brief Delays of the switches of one direction.
+ */
+typedef struct {
+	uint32_t	count;
+	int64_t		sum_us;
+	int64_t		max_us;
+} delay_t;
+
+static const segment_t routine[] = {
+	{BIONICS_ACTIVITY_CHAIR_RELAX,	1800},
+	{BIONICS_ACTIVITY_CHAIR_EXIT,	3},
+	{BIONICS_ACTIVITY_STANDING,		20},
+	{BIONICS_ACTIVITY_WALKING,		120},
+	{BIONICS_ACTIVITY_U_TURN,		3},
+	{BIONICS_ACTIVITY_WALKING,		60},
+	{BIONICS_ACTIVITY_UPSTAIRS,		20},
+	{BIONICS_ACTIVITY_STANDING,		60},
+	{BIONICS_ACTIVITY_DOWNSTAIRS,	20},
+	{BIONICS_ACTIVITY_WALKING,		180},
+	{BIONICS_ACTIVITY_STANDING,		300},
+	{BIONICS_ACTIVITY_SITTING,		600},
+};
+
+/*****Private Functions Definitions*************************************************/
+
+static uint32_t routine_activity(int64_t time_us, int64_t stride_us, int64_t *segment_start_us);
+static void delay_add(delay_t *delay, int64_t delay_us);
+static void delay_print(const char *name, const delay_t *delay);
+#if CONFIG_DATA_COLLECTOR_POLICY == 1
+static size_t batch_length(const acquisition_profile_t *profile, unsigned int seed);
+#endif
+
+/*****Public Functions**************************************************************/
+
+int main(int argc, char **argv){
+	double hours = 24;
+	double error_rate = 0.02;
+	uint32_t hold_ms = CONFIG_DATA_COLLECTOR_POLICY_HOLD_MS;
+	int64_t stride_us = 1100000;
+	acquisition_policy_t policy;
+	const acquisition_profile_t *expected = NULL;
+	const acquisition_profile_t *target;
+	const acquisition_profile_t *previous;
+#if CONFIG_DATA_COLLECTOR_POLICY == 1
+	const acquisition_profile_t *gait;
+	const acquisition_profile_t *rest;
+	size_t gait_bytes;
+	size_t rest_bytes;
+#endif
+	delay_t up = {0};
+	delay_t down = {0};
+	int64_t duration_us;
+	int64_t time_us = 0;
+	int64_t segment_start_us;
+	int64_t change_us = 0;
+	int64_t window_end_us = BENCHMARK_SUMMARY_US;
+	uint64_t samples = 0;
+	uint64_t points = 0;
+	uint64_t wrong = 0;
+	uint32_t changes = 0;
+	uint32_t spurious = 0;
+	uint8_t pending = 0;
+	uint32_t activity;
+	uint32_t rate_hz;
+	unsigned int seed = 1;
+	uint32_t i;
+	int opt;
+
+	while((opt = getopt(argc, argv, "t:e:w:s:")) != -1){
+		switch(opt){
+			case 't': hours = atof(optarg); break;
+			case 'e': error_rate = atof(optarg); break;
+			case 'w': hold_ms = (uint32_t) atoi(optarg); break;
+			case 's': stride_us = (int64_t) atoi(optarg) * 1000; break;
+			default:
+				fprintf(stderr, "Usage: %s [-t hours] [-e error_rate] [-w hold_ms] [-s stride_ms]\n", argv[0]);
+				return 1;
+		}
+	}
+	if(hours <= 0 || stride_us <= 0){
+		fprintf(stderr, "time and stride must be larger than 0\n");
+		return 1;
+	}
+	duration_us = (int64_t)(hours * 3600e6);
+
+	acquisition_policy_initDefault(&policy, hold_ms, CONFIG_DATA_COLLECTOR_SAMPLE_RATE_HZ);
+
+	printf("SocketSense policy benchmark: %.1f h, stride %.2f s, %.1f%% wrong codes, hold %u ms\n", hours, stride_us / 1e6,
+			error_rate * 100, hold_ms);
+	for(i = 0; i < policy.count; i++){
+		printf("  %-9s %4u Hz, %s, deadband %u\n", policy.profiles[i].name, acquisition_policy_getRate(&policy, &policy.profiles[i]),
+				policy.profiles[i].summary_only > 0 ? "summaries" : "sensor elements", policy.profiles[i].deadband);
+	}
+
+	while(time_us < duration_us){
+		activity = routine_activity(time_us, stride_us, &segment_start_us);
+		target = acquisition_policy_match(&policy, activity);
+		if(target != expected){													//the routine asks for another profile
+			if(expected != NULL){
+				changes++;
+			}
+			expected = target;
+			pending = expected != policy.current;
+			change_us = segment_start_us;
+		}
+
+		if((double) rand_r(&seed) / RAND_MAX < error_rate){
+			activity = (activity & BIONICS_ACTIVITY_AMBULATING) ? BIONICS_ACTIVITY_STANDING : BIONICS_ACTIVITY_WALKING;
+			wrong++;
+		}
+
+		previous = policy.current;
+		if(acquisition_policy_update(&policy, activity, time_us) != NULL && previous != NULL){
+			if(policy.current != expected){
+				spurious++;
+			}else if(pending){											//the first time the policy follows the routine
+				if(acquisition_policy_getRate(&policy, expected) > acquisition_policy_getRate(&policy, previous)){
+					delay_add(&up, time_us - change_us);
+				}else{
+					delay_add(&down, time_us - change_us);
+				}
+			}
+		}
+		pending = pending && policy.current != expected;
+
+		samples++;
+		if(policy.current->summary_only == 0){
+			points++;
+		}else if(time_us >= window_end_us){									//the first sample after a window carries its summary
+			points++;
+		}
+		while(window_end_us <= time_us){
+			window_end_us += BENCHMARK_SUMMARY_US;
+		}
+
+		rate_hz = acquisition_policy_getRate(&policy, policy.current);
+		time_us += 1000000 / rate_hz;
+	}
+
+	printf("\n%u changes of the profile in the routine, %u transitions of the policy (%u to a wrong profile), %llu wrong codes\n",
+			changes, policy.transitions - 1, spurious, (unsigned long long) wrong);
+	delay_print("up", &up);
+	delay_print("down", &down);
+	printf("  delay in strides: up %.2f max, down %.2f max\n", up.max_us / (double) stride_us, down.max_us / (double) stride_us);
+
+	printf("\nSamples read:     %12llu (%5.1f%% of %llu at %u Hz)\n", (unsigned long long) samples,
+			100.0 * samples / (duration_us / 1e6 * CONFIG_DATA_COLLECTOR_POLICY_GAIT_RATE_HZ),
+			(unsigned long long)(duration_us / 1e6 * CONFIG_DATA_COLLECTOR_POLICY_GAIT_RATE_HZ), CONFIG_DATA_COLLECTOR_POLICY_GAIT_RATE_HZ);
+	printf("Points published: %12llu (%5.1f%%)\n", (unsigned long long) points,
+			100.0 * points / (duration_us / 1e6 * CONFIG_DATA_COLLECTOR_POLICY_GAIT_RATE_HZ));
+
+#if CONFIG_DATA_COLLECTOR_POLICY == 1
+	gait = acquisition_policy_match(&policy, BIONICS_ACTIVITY_WALKING);
+	rest = acquisition_policy_match(&policy, BIONICS_ACTIVITY_STANDING);
+	gait_bytes = batch_length(gait, seed);
+	rest_bytes = batch_length(rest, seed);
+	printf("\nBatch of %d samples standing still: %zu bytes with the %s profile (deadband %u), %zu bytes with the %s profile "
+			"(deadband %u), %.1f%% smaller\n", CONFIG_INFLUXDB_BATCH_SIZE, gait_bytes, gait->name, gait->deadband, rest_bytes,
+			rest->name, rest->deadband, 100.0 - 100.0 * rest_bytes / gait_bytes);
+	if(rest->deadband > gait->deadband && rest_bytes >= gait_bytes){
+		printf("FAILED: the deadband of the %s profile does not reduce the line protocol\n", rest->name);
+		return 1;
+	}
+#else
+	printf("\nCONFIG_DATA_COLLECTOR_POLICY is not enabled, the batch with the deadband of the rest profile is not checked\n");
+#endif
+
+	return 0;
+}
+
+/*****Private Functions*************************************************************/
+
+/**
+ * Returns the activity code of the routine at a time, with the phase of the stride while the subject walks, and the
+ * start of the current part of the routine.
+ */
+static uint32_t routine_activity(int64_t time_us, int64_t stride_us, int64_t *segment_start_us){
+	int64_t routine_us = 0;
+	int64_t offset_us;
+	double phase;
+	uint32_t i;
+
+	for(i = 0; i < sizeof(routine) / sizeof(routine[0]); i++){
+		routine_us += (int64_t) routine[i].seconds * 1000000;
+	}
+	offset_us = time_us % routine_us;
+	*segment_start_us = time_us - offset_us;
+	for(i = 0; offset_us >= (int64_t) routine[i].seconds * 1000000; i++){
+		offset_us -= (int64_t) routine[i].seconds * 1000000;
+		*segment_start_us += (int64_t) routine[i].seconds * 1000000;
+	}
+
+	if((routine[i].activity & BIONICS_ACTIVITY_AMBULATING) == 0){
+		return routine[i].activity;
+	}
+	phase = (double)(offset_us % stride_us) / stride_us;
+	if(phase < 0.12){
+		return routine[i].activity | BIONICS_ACTIVITY_HEELSTRIKE;
+	}else if(phase < 0.5){
+		return routine[i].activity | BIONICS_ACTIVITY_MIDSTANCE;
+	}else if(phase < 0.62){
+		return routine[i].activity | BIONICS_ACTIVITY_DOUBLE_LIMB_SUPPORT;
+	}else if(phase < 0.72){
+		return routine[i].activity | BIONICS_ACTIVITY_TOEOFF;
+	}
+	return routine[i].activity | BIONICS_ACTIVITY_MIDSWING;
+}
+
+static void delay_add(delay_t *delay, int64_t delay_us){
+	delay->count++;
+	delay->sum_us += delay_us;
+	if(delay_us > delay->max_us){
+		delay->max_us = delay_us;
+	}
+}
+
+static void delay_print(const char *name, const delay_t *delay){
+	printf("  switch %-4s %6u times, delay mean %7.1f ms, max %7.1f ms\n", name, delay->count,
+			delay->count > 0 ? delay->sum_us / 1e3 / delay->count : 0.0, delay->max_us / 1e3);
+}
+
+#if CONFIG_DATA_COLLECTOR_POLICY == 1
+/**
+ * Returns the length of the line protocol of a batch of samples of a subject that stands still, with the deadband of a
+ * profile. The sensor elements are reported completely, as if the profile did not report the summaries only.
+ */
+static size_t batch_length(const acquisition_profile_t *profile, unsigned int seed){
+	static SocketSense_Sample_t sample;
+	sensel_deadband_t deadband;
+	influxdb_batch_t batch;
+	size_t length;
+	uint32_t i;
+	uint32_t sensor_id;
+	uint32_t sensel_id;
+
+	if(influxdb_batch_init(&batch, INFLUXDB_BATCH_INITIAL_CAPACITY) != ESP_OK){
+		return 0;
+	}
+	sensel_deadband_init(&deadband, profile->deadband, CONFIG_DATA_COLLECTOR_KEYFRAME_INTERVAL);
+	memset(&sample, 0, sizeof(sample));
+	sample.activity = BIONICS_ACTIVITY_STANDING;
+	sample.bme280_data.temperature = 31.2f;
+	sample.bme280_data.humidity = 48.5f;
+	sample.bme280_data.pressure = 100812.0f;
+	sample.sampling_time = 2450;
+	sample.battery_voltage = 3950;
+
+	for(i = 0; i < CONFIG_INFLUXDB_BATCH_SIZE; i++){
+		sample.timestamp_usec = 1792266702000000ULL + (uint64_t) i * 1000000 / profile->sample_rate_hz;
+		for(sensor_id = 0; sensor_id < CONFIG_SOCKETSENSE_SENSOR_COUNT; sensor_id++){
+			for(sensel_id = 0; sensel_id < CONFIG_SOCKETSENSE_SENSEL_COUNT; sensel_id++){
+				sample.sensorstrip_data[sensor_id][sensel_id] = (uint16_t)(800 + sensor_id * 211 + sensel_id * 37
+						+ rand_r(&seed) % 17 - 8);							//constant load, +-8 counts of noise
+			}
+		}
+		sensel_deadband_apply(&deadband, &sample);
+		influxdb_batch_append(&batch, &sample);
+	}
+
+	length = batch.length;
+	influxdb_batch_free(&batch);
+	return length;
+}
+#endif
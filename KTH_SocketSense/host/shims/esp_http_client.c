@@ -0,0 +1,456 @@
+/**
+ * @file esp_http_client.c
+ * @brief Host shim of the ESP-IDF HTTP client.
+ *
+ * The client keeps one TCP connection open between requests (HTTP/1.1 keep-alive) and reconnects
+ * transparently when the connection was closed. Responses with Content-Length, chunked transfer encoding
+ * or without body (1xx, 204, 304) are supported.
+ *
+ * @date October 17. 2026
+ */
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_http_client.h"
+
+static const char *TAG = "HTTP_CLIENT_SHIM";
+
+#define HTTP_SHIM_DEFAULT_TIMEOUT_MS	5000
+#define HTTP_SHIM_HEADER_SIZE			2048
+#define HTTP_SHIM_BUFFER_SIZE			4096
+
+struct esp_http_client {
+	esp_http_client_config_t	config;
+	char						*host;
+	char						*path;
+	char						*authorization;			//complete Authorization header line, NULL without credentials
+	esp_http_client_method_t	method;
+	const char					*post_data;
+	int							post_len;
+	int							sock;
+	int							status_code;
+	int							content_length;
+	bool						chunked;
+	bool						keep_alive;
+	char						buffer[HTTP_SHIM_BUFFER_SIZE];	//received data that has not been consumed yet
+	int							buffered;
+};
+
+/*****Private Functions Definitions*************************************************/
+
+static void http_dispatch(esp_http_client_handle_t client, esp_http_client_event_id_t id, void *data, int len, char *key, char *value);
+static esp_err_t http_connect(esp_http_client_handle_t client);
+static esp_err_t http_sendAll(esp_http_client_handle_t client, const char *data, int len);
+static int http_fill(esp_http_client_handle_t client);
+static int http_readLine(esp_http_client_handle_t client, char *line, int size);
+static esp_err_t http_readBody(esp_http_client_handle_t client, int len);
+static esp_err_t http_readResponse(esp_http_client_handle_t client);
+static char *base64_encode(const char *input);
+
+/*****Public Functions**************************************************************/
+
+esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t *config){
+	esp_http_client_handle_t client;
+	char *credentials;
+	char *encoded;
+
+	if(config->host == NULL){
+		ESP_LOGE(TAG, "Only configurations with host (and optionally port and path) are supported");
+		return NULL;
+	}
+
+	client = calloc(1, sizeof(struct esp_http_client));
+	if(client == NULL){
+		return NULL;
+	}
+
+	client->config = *config;
+	if(client->config.port == 0){
+		client->config.port = 80;
+	}
+	if(client->config.timeout_ms == 0){
+		client->config.timeout_ms = HTTP_SHIM_DEFAULT_TIMEOUT_MS;
+	}
+	client->host = strdup(config->host);
+	client->path = strdup(config->path != NULL ? config->path : "/");
+	client->sock = -1;
+	client->method = HTTP_METHOD_GET;
+
+	if(config->username != NULL){
+		credentials = malloc(strlen(config->username) + strlen(config->password != NULL ? config->password : "") + 2);
+		sprintf(credentials, "%s:%s", config->username, config->password != NULL ? config->password : "");
+		encoded = base64_encode(credentials);
+		client->authorization = malloc(strlen(encoded) + 32);
+		sprintf(client->authorization, "Authorization: Basic %s\r\n", encoded);
+		free(encoded);
+		free(credentials);
+	}
+
+	return client;
+}
+
+esp_err_t esp_http_client_set_method(esp_http_client_handle_t client, esp_http_client_method_t method){
+	client->method = method;
+	return ESP_OK;
+}
+
+esp_err_t esp_http_client_set_post_field(esp_http_client_handle_t client, const char *data, int len){
+	client->post_data = data;
+	client->post_len = len;
+	return ESP_OK;
+}
+
+esp_err_t esp_http_client_set_header(esp_http_client_handle_t client, const char *key, const char *value){
+	return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t esp_http_client_perform(esp_http_client_handle_t client){
+	char header[HTTP_SHIM_HEADER_SIZE];
+	int header_len;
+	int body_len = (client->method == HTTP_METHOD_POST) ? client->post_len : 0;
+
+	if(client->sock < 0 && http_connect(client) != ESP_OK){
+		http_dispatch(client, HTTP_EVENT_ERROR, NULL, 0, NULL, NULL);
+		return ESP_FAIL;
+	}
+
+	header_len = snprintf(header, sizeof(header),
+			"%s %s HTTP/1.1\r\n"
+			"Host: %s:%d\r\n"
+			"User-Agent: ESP32 HTTP Client/1.0\r\n"
+			"%s"
+			"Content-Length: %d\r\n"
+			"\r\n",
+			client->method == HTTP_METHOD_POST ? "POST" : "GET", client->path,
+			client->host, client->config.port,
+			client->authorization != NULL ? client->authorization : "",
+			body_len);
+
+	if(http_sendAll(client, header, header_len) != ESP_OK){
+		return ESP_FAIL;
+	}
+	http_dispatch(client, HTTP_EVENT_HEADER_SENT, NULL, 0, NULL, NULL);
+
+	if(body_len > 0 && http_sendAll(client, client->post_data, body_len) != ESP_OK){
+		return ESP_FAIL;
+	}
+
+	if(http_readResponse(client) != ESP_OK){
+		http_dispatch(client, HTTP_EVENT_ERROR, NULL, 0, NULL, NULL);
+		esp_http_client_close(client);
+		return ESP_FAIL;
+	}
+
+	http_dispatch(client, HTTP_EVENT_ON_FINISH, NULL, 0, NULL, NULL);
+
+	if(client->keep_alive == false){
+		esp_http_client_close(client);
+	}
+
+	return ESP_OK;
+}
+
+int esp_http_client_get_status_code(esp_http_client_handle_t client){
+	return client->status_code;
+}
+
+int esp_http_client_get_content_length(esp_http_client_handle_t client){
+	return client->content_length;
+}
+
+bool esp_http_client_is_chunked_response(esp_http_client_handle_t client){
+	return client->chunked;
+}
+
+esp_err_t esp_http_client_close(esp_http_client_handle_t client){
+	if(client->sock >= 0){
+		close(client->sock);
+		client->sock = -1;
+		client->buffered = 0;
+		http_dispatch(client, HTTP_EVENT_DISCONNECTED, NULL, 0, NULL, NULL);
+	}
+	return ESP_OK;
+}
+
+esp_err_t esp_http_client_cleanup(esp_http_client_handle_t client){
+	esp_http_client_close(client);
+	free(client->host);
+	free(client->path);
+	free(client->authorization);
+	free(client);
+	return ESP_OK;
+}
+
+/*****Private Functions*************************************************************/
+
+static void http_dispatch(esp_http_client_handle_t client, esp_http_client_event_id_t id, void *data, int len, char *key, char *value){
+	esp_http_client_event_t event;
+
+	if(client->config.event_handler == NULL){
+		return;
+	}
+
+	memset(&event, 0, sizeof(event));
+	event.event_id = id;
+	event.client = client;
+	event.data = data;
+	event.data_len = len;
+	event.user_data = client->config.user_data;
+	event.header_key = key;
+	event.header_value = value;
+
+	client->config.event_handler(&event);
+}
+
+static esp_err_t http_connect(esp_http_client_handle_t client){
+	struct addrinfo hints;
+	struct addrinfo *result;
+	struct addrinfo *rp;
+	struct timeval tv;
+	char port[8];
+	int flag = 1;
+	int sock = -1;
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	snprintf(port, sizeof(port), "%d", client->config.port);
+
+	if(getaddrinfo(client->host, port, &hints, &result) != 0){
+		ESP_LOGE(TAG, "Can't resolve %s", client->host);
+		return ESP_FAIL;
+	}
+
+	tv.tv_sec = client->config.timeout_ms / 1000;
+	tv.tv_usec = (client->config.timeout_ms % 1000) * 1000;
+
+	for(rp = result; rp != NULL; rp = rp->ai_next){
+		sock = socket(rp->ai_family, rp->ai_socktype, rp->ai_protocol);
+		if(sock < 0){
+			continue;
+		}
+		setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+		setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+		setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+		if(connect(sock, rp->ai_addr, rp->ai_addrlen) == 0){
+			break;
+		}
+		close(sock);
+		sock = -1;
+	}
+	freeaddrinfo(result);
+
+	if(sock < 0){
+		ESP_LOGE(TAG, "Connection to %s:%d failed: %s", client->host, client->config.port, strerror(errno));
+		return ESP_FAIL;
+	}
+
+	client->sock = sock;
+	client->buffered = 0;
+	http_dispatch(client, HTTP_EVENT_ON_CONNECTED, NULL, 0, NULL, NULL);
+
+	return ESP_OK;
+}
+
+static esp_err_t http_sendAll(esp_http_client_handle_t client, const char *data, int len){
+	ssize_t sent;
+
+	while(len > 0){
+		sent = send(client->sock, data, len, MSG_NOSIGNAL);
+		if(sent <= 0){
+			if(sent < 0 && errno == EINTR){
+				continue;
+			}
+			ESP_LOGE(TAG, "Sending failed: %s", strerror(errno));
+			esp_http_client_close(client);
+			return ESP_FAIL;
+		}
+		data += sent;
+		len -= sent;
+	}
+
+	return ESP_OK;
+}
+
+/**
+ * Receives more data into the buffer, returns the number of new bytes (0 if the connection was closed, -1 on error).
+ */
+static int http_fill(esp_http_client_handle_t client){
+	ssize_t received;
+
+	if(client->buffered == HTTP_SHIM_BUFFER_SIZE){
+		return -1;
+	}
+
+	do{
+		received = recv(client->sock, &client->buffer[client->buffered], HTTP_SHIM_BUFFER_SIZE - client->buffered, 0);
+	}while(received < 0 && errno == EINTR);
+
+	if(received > 0){
+		client->buffered += received;
+	}
+
+	return (int) received;
+}
+
+/**
+ * Reads one line (without CRLF) from the connection, returns its length or -1 on error.
+ */
+static int http_readLine(esp_http_client_handle_t client, char *line, int size){
+	char *end;
+	int len;
+
+	while((end = memchr(client->buffer, '\n', client->buffered)) == NULL){
+		if(http_fill(client) <= 0){
+			return -1;
+		}
+	}
+
+	len = end - client->buffer;
+	if(len >= size){
+		return -1;
+	}
+	memcpy(line, client->buffer, len);
+	line[len] = '\0';
+	if(len > 0 && line[len - 1] == '\r'){
+		line[--len] = '\0';
+	}
+
+	client->buffered -= (end - client->buffer) + 1;
+	memmove(client->buffer, end + 1, client->buffered);
+
+	return len;
+}
+
+/**
+ * Reads len bytes of body data and passes them to the event handler, len < 0 reads until the connection is closed.
+ */
+static esp_err_t http_readBody(esp_http_client_handle_t client, int len){
+	int chunk;
+	int received;
+
+	while(len != 0){
+		if(client->buffered == 0){
+			received = http_fill(client);
+			if(received < 0 || (received == 0 && len > 0)){
+				return ESP_FAIL;
+			}
+			if(received == 0){
+				return ESP_OK;										//the end of the body is the end of the connection
+			}
+		}
+		chunk = (len < 0 || client->buffered < len) ? client->buffered : len;
+		http_dispatch(client, HTTP_EVENT_ON_DATA, client->buffer, chunk, NULL, NULL);
+		client->buffered -= chunk;
+		memmove(client->buffer, &client->buffer[chunk], client->buffered);
+		if(len > 0){
+			len -= chunk;
+		}
+	}
+
+	return ESP_OK;
+}
+
+static esp_err_t http_readResponse(esp_http_client_handle_t client){
+	char line[HTTP_SHIM_HEADER_SIZE];
+	char *value;
+	int minor = 1;
+	int chunk;
+	int n;
+
+	do{
+		if(http_readLine(client, line, sizeof(line)) < 0 || sscanf(line, "HTTP/1.%d %d", &minor, &client->status_code) != 2){
+			ESP_LOGE(TAG, "Invalid or no response");
+			return ESP_FAIL;
+		}
+
+		client->content_length = -1;
+		client->chunked = false;
+		client->keep_alive = (minor >= 1);
+
+		while((n = http_readLine(client, line, sizeof(line))) > 0){
+			value = strchr(line, ':');
+			if(value == NULL){
+				continue;
+			}
+			*value++ = '\0';
+			while(*value == ' '){
+				value++;
+			}
+			http_dispatch(client, HTTP_EVENT_ON_HEADER, NULL, 0, line, value);
+
+			if(strcasecmp(line, "Content-Length") == 0){
+				client->content_length = atoi(value);
+			}else if(strcasecmp(line, "Transfer-Encoding") == 0 && strcasecmp(value, "chunked") == 0){
+				client->chunked = true;
+			}else if(strcasecmp(line, "Connection") == 0){
+				client->keep_alive = (strcasecmp(value, "close") != 0);
+			}
+		}
+		if(n < 0){
+			ESP_LOGE(TAG, "Incomplete response header");
+			return ESP_FAIL;
+		}
+	}while(client->status_code >= 100 && client->status_code < 200);	//skip interim responses
+
+	if(client->status_code == 204 || client->status_code == 304){
+		return ESP_OK;
+	}
+
+	if(client->chunked){
+		while(1){
+			if(http_readLine(client, line, sizeof(line)) < 0){
+				return ESP_FAIL;
+			}
+			chunk = (int) strtol(line, NULL, 16);
+			if(chunk == 0){
+				while(http_readLine(client, line, sizeof(line)) > 0);	//trailer
+				return ESP_OK;
+			}
+			if(http_readBody(client, chunk) != ESP_OK || http_readLine(client, line, sizeof(line)) < 0){
+				return ESP_FAIL;
+			}
+		}
+	}
+
+	if(client->content_length >= 0){
+		return http_readBody(client, client->content_length);
+	}
+
+	client->keep_alive = false;											//the body ends with the connection
+	return http_readBody(client, -1);
+}
+
+static char *base64_encode(const char *input){
+	static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	size_t len = strlen(input);
+	char *output = malloc(4 * ((len + 2) / 3) + 1);
+	char *out = output;
+	uint32_t triple;
+	size_t i;
+
+	for(i = 0; i < len; i += 3){
+		triple = (uint32_t)(uint8_t) input[i] << 16;
+		if(i + 1 < len) triple |= (uint32_t)(uint8_t) input[i + 1] << 8;
+		if(i + 2 < len) triple |= (uint8_t) input[i + 2];
+
+		*out++ = alphabet[(triple >> 18) & 0x3F];
+		*out++ = alphabet[(triple >> 12) & 0x3F];
+		*out++ = (i + 1 < len) ? alphabet[(triple >> 6) & 0x3F] : '=';
+		*out++ = (i + 2 < len) ? alphabet[triple & 0x3F] : '=';
+	}
+	*out = '\0';
+
+	return output;
+}
@@ -0,0 +1,241 @@
+/**
+ * @file esp_timer.c
+ * @brief Host shim of the ESP-IDF high resolution timer.
+ *
+ * Each timer has its own thread that waits for the next expiry and calls the callback, like the esp_timer task does.
+ * Periodic timers are rearmed relative to their previous expiry, so they do not drift. The cycle counter of the CPU
+ * (xtensa/hal.h) is served from the same clock.
+ *
+ * @date October 17. 2026
+ */
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "esp_timer.h"
+#include "esp_clk.h"
+#include "xtensa/hal.h"
+#include "host_internal.h"
+
+struct esp_timer {
+	esp_timer_cb_t		callback;
+	void				*arg;
+	const char			*name;
+	pthread_t			thread;
+	pthread_mutex_t		lock;
+	pthread_cond_t		cond;
+	uint8_t				armed;
+	uint8_t				deleted;
+	uint64_t			period_us;			//0 for one-shot timers
+	int64_t				alarm_us;			//time of the next expiry
+};
+
+static int64_t boot_us;
+
+/*****Private Functions Definitions*************************************************/
+
+static int64_t monotonic_us(void);
+static void *esp_timer_thread(void *arg);
+
+/*****Public Functions**************************************************************/
+
+__attribute__((constructor)) static void esp_timer_boot(void){
+	boot_us = monotonic_us();
+}
+
+int64_t host_now_us(void){
+	return monotonic_us() - boot_us;
+}
+
+void host_abs_time(int64_t time_us, struct timespec *ts){
+	int64_t abs_us = boot_us + time_us;
+
+	ts->tv_sec = abs_us / 1000000;
+	ts->tv_nsec = (abs_us % 1000000) * 1000;
+}
+
+void host_cond_init(pthread_cond_t *cond){
+	pthread_condattr_t attr;
+
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(cond, &attr);
+	pthread_condattr_destroy(&attr);
+}
+
+int host_cond_wait_until(pthread_cond_t *cond, pthread_mutex_t *mutex, int64_t deadline_us){
+	struct timespec ts;
+
+	if(deadline_us < 0){
+		return pthread_cond_wait(cond, mutex);
+	}
+
+	host_abs_time(deadline_us, &ts);
+	return pthread_cond_timedwait(cond, mutex, &ts);
+}
+
+int64_t host_deadline_us(TickType_t ticks){
+	if(ticks == portMAX_DELAY){
+		return -1;
+	}
+	return host_now_us() + (int64_t) ticks * 1000000 / configTICK_RATE_HZ;
+}
+
+int64_t esp_timer_get_time(void){
+	return host_now_us();
+}
+
+unsigned xthal_get_ccount(void){
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (unsigned)((uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec);		//wraps like the 32 bit CCOUNT register
+}
+
+int esp_clk_cpu_freq(void){
+	return HOST_CPU_FREQ_HZ;
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *create_args, esp_timer_handle_t *out_handle){
+	esp_timer_handle_t timer;
+
+	if(create_args == NULL || create_args->callback == NULL || out_handle == NULL){
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	timer = calloc(1, sizeof(struct esp_timer));
+	if(timer == NULL){
+		return ESP_ERR_NO_MEM;
+	}
+
+	timer->callback = create_args->callback;
+	timer->arg = create_args->arg;
+	timer->name = create_args->name;
+	pthread_mutex_init(&timer->lock, NULL);
+	host_cond_init(&timer->cond);
+
+	if(pthread_create(&timer->thread, NULL, esp_timer_thread, timer) != 0){
+		free(timer);
+		return ESP_ERR_NO_MEM;
+	}
+
+	*out_handle = timer;
+
+	return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period){
+	esp_err_t ret = ESP_OK;
+
+	pthread_mutex_lock(&timer->lock);
+	if(timer->armed){
+		ret = ESP_ERR_INVALID_STATE;
+	}else{
+		timer->period_us = period;
+		timer->alarm_us = host_now_us() + period;
+		timer->armed = 1;
+		pthread_cond_signal(&timer->cond);
+	}
+	pthread_mutex_unlock(&timer->lock);
+
+	return ret;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us){
+	esp_err_t ret = ESP_OK;
+
+	pthread_mutex_lock(&timer->lock);
+	if(timer->armed){
+		ret = ESP_ERR_INVALID_STATE;
+	}else{
+		timer->period_us = 0;
+		timer->alarm_us = host_now_us() + timeout_us;
+		timer->armed = 1;
+		pthread_cond_signal(&timer->cond);
+	}
+	pthread_mutex_unlock(&timer->lock);
+
+	return ret;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer){
+	esp_err_t ret = ESP_OK;
+
+	pthread_mutex_lock(&timer->lock);
+	if(timer->armed == 0){
+		ret = ESP_ERR_INVALID_STATE;
+	}else{
+		timer->armed = 0;
+		pthread_cond_signal(&timer->cond);
+	}
+	pthread_mutex_unlock(&timer->lock);
+
+	return ret;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer){
+
+	pthread_mutex_lock(&timer->lock);
+	if(timer->armed){
+		pthread_mutex_unlock(&timer->lock);
+		return ESP_ERR_INVALID_STATE;
+	}
+	timer->deleted = 1;
+	pthread_cond_signal(&timer->cond);
+	pthread_mutex_unlock(&timer->lock);
+
+	pthread_join(timer->thread, NULL);
+	pthread_cond_destroy(&timer->cond);
+	pthread_mutex_destroy(&timer->lock);
+	free(timer);
+
+	return ESP_OK;
+}
+
+/*****Private Functions*************************************************************/
+
+static int64_t monotonic_us(void){
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (int64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * Serves one timer, the callback is called without holding the lock so it may stop or restart the timer.
+ */
+static void *esp_timer_thread(void *arg){
+	esp_timer_handle_t timer = arg;
+
+	pthread_mutex_lock(&timer->lock);
+
+	while(timer->deleted == 0){
+		if(timer->armed == 0){
+			pthread_cond_wait(&timer->cond, &timer->lock);
+			continue;
+		}
+
+		if(host_now_us() < timer->alarm_us){
+			host_cond_wait_until(&timer->cond, &timer->lock, timer->alarm_us);
+			continue;														//the timer may have been stopped in the meantime
+		}
+
+		if(timer->period_us > 0){
+			timer->alarm_us += timer->period_us;
+		}else{
+			timer->armed = 0;
+		}
+
+		pthread_mutex_unlock(&timer->lock);
+		timer->callback(timer->arg);
+		pthread_mutex_lock(&timer->lock);
+	}
+
+	pthread_mutex_unlock(&timer->lock);
+
+	return NULL;
+}
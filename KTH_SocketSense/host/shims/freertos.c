@@ -0,0 +1,465 @@
+/**
+ * @file freertos.c
+ * @brief Host shim of the FreeRTOS tasks, task notifications, queues and mutexes.
+ *
+ * Each task is a detached POSIX thread. The FreeRTOS scheduler semantics that the firmware relies on are kept:
+ * notifications are latched until the task waits for them, delays are based on the tick count, and
+ * vTaskDelayUntil() releases the task relative to its previous wake time.
+ * Suspending another task takes effect the next time that task waits in one of the functions of this file.
+ *
+ * @date October 17. 2026
+ */
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "host_internal.h"
+
+struct tskTaskControlBlock {
+	pthread_t			thread;
+	TaskFunction_t		code;
+	void				*parameters;
+	char				name[16];
+	int					core;
+	UBaseType_t			priority;
+	pthread_mutex_t		lock;
+	pthread_cond_t		cond;
+	uint32_t			notify_value;
+	uint8_t				notify_pending;
+	uint8_t				suspended;
+};
+
+struct QueueDefinition {
+	pthread_mutex_t		lock;
+	pthread_cond_t		not_empty;
+	pthread_cond_t		not_full;
+	uint8_t				*storage;
+	UBaseType_t			length;
+	UBaseType_t			item_size;
+	UBaseType_t			head;
+	UBaseType_t			count;
+};
+
+static __thread TaskHandle_t current_task = NULL;
+static pthread_mutex_t critical_lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+/*****Private Functions Definitions*************************************************/
+
+static void *task_entry(void *arg);
+static void task_unlock(void *arg);
+static void task_waitWhileSuspended(TaskHandle_t task);
+static void task_sleepUntil(int64_t wake_us);
+
+/*****Tasks*************************************************************************/
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode, const char *pcName, uint32_t usStackDepth, void *pvParameters,
+		UBaseType_t uxPriority, TaskHandle_t *pvCreatedTask, BaseType_t xCoreID){
+	TaskHandle_t task;
+	pthread_attr_t attr;
+
+	task = calloc(1, sizeof(struct tskTaskControlBlock));
+	if(task == NULL){
+		return pdFAIL;
+	}
+
+	task->code = pvTaskCode;
+	task->parameters = pvParameters;
+	task->core = (xCoreID == tskNO_AFFINITY) ? 0 : xCoreID;
+	task->priority = uxPriority;
+	strncpy(task->name, pcName, sizeof(task->name) - 1);
+	pthread_mutex_init(&task->lock, NULL);
+	host_cond_init(&task->cond);
+
+	if(pvCreatedTask != NULL){
+		*pvCreatedTask = task;										//the handle is valid before the task runs, as on FreeRTOS
+	}
+
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	if(pthread_create(&task->thread, &attr, task_entry, task) != 0){
+		pthread_attr_destroy(&attr);
+		if(pvCreatedTask != NULL){
+			*pvCreatedTask = NULL;
+		}
+		free(task);
+		return pdFAIL;
+	}
+	pthread_attr_destroy(&attr);
+
+	return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t pvTaskCode, const char *pcName, uint32_t usStackDepth, void *pvParameters,
+		UBaseType_t uxPriority, TaskHandle_t *pvCreatedTask){
+	return xTaskCreatePinnedToCore(pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pvCreatedTask, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t xTaskToDelete){
+
+	if(xTaskToDelete == NULL || xTaskToDelete == current_task){
+		pthread_exit(NULL);
+	}
+
+	pthread_cancel(xTaskToDelete->thread);							//the control block is kept, the handle may still be referenced
+}
+
+void vTaskSuspend(TaskHandle_t xTaskToSuspend){
+	TaskHandle_t task = (xTaskToSuspend == NULL) ? current_task : xTaskToSuspend;
+
+	if(task == NULL){
+		return;
+	}
+
+	pthread_mutex_lock(&task->lock);
+	task->suspended = 1;
+	pthread_mutex_unlock(&task->lock);
+
+	if(task == current_task){
+		task_waitWhileSuspended(task);
+	}
+}
+
+void vTaskResume(TaskHandle_t xTaskToResume){
+
+	if(xTaskToResume == NULL){
+		return;
+	}
+
+	pthread_mutex_lock(&xTaskToResume->lock);
+	xTaskToResume->suspended = 0;
+	pthread_cond_broadcast(&xTaskToResume->cond);
+	pthread_mutex_unlock(&xTaskToResume->lock);
+}
+
+TickType_t xTaskGetTickCount(void){
+	return (TickType_t)(host_now_us() * configTICK_RATE_HZ / 1000000);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void){
+	return current_task;
+}
+
+void vTaskDelay(const TickType_t xTicksToDelay){
+	task_sleepUntil(host_now_us() + (int64_t) xTicksToDelay * 1000000 / configTICK_RATE_HZ);
+}
+
+void vTaskDelayUntil(TickType_t *pxPreviousWakeTime, const TickType_t xTimeIncrement){
+	int64_t wake_us;
+
+	*pxPreviousWakeTime += xTimeIncrement;
+	wake_us = (int64_t) *pxPreviousWakeTime * 1000000 / configTICK_RATE_HZ;
+
+	task_sleepUntil(wake_us);
+}
+
+int xPortGetCoreID(void){
+	return (current_task == NULL) ? 0 : current_task->core;
+}
+
+void vPortEnterCritical(portMUX_TYPE *mux){
+	pthread_mutex_lock(&critical_lock);
+}
+
+void vPortExitCritical(portMUX_TYPE *mux){
+	pthread_mutex_unlock(&critical_lock);
+}
+
+/*****Task Notifications************************************************************/
+
+BaseType_t xTaskNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction){
+	BaseType_t ret = pdPASS;
+
+	if(xTaskToNotify == NULL){
+		return pdFAIL;
+	}
+
+	pthread_mutex_lock(&xTaskToNotify->lock);
+	switch(eAction){
+		case eSetBits:
+			xTaskToNotify->notify_value |= ulValue;
+			break;
+		case eIncrement:
+			xTaskToNotify->notify_value++;
+			break;
+		case eSetValueWithOverwrite:
+			xTaskToNotify->notify_value = ulValue;
+			break;
+		case eSetValueWithoutOverwrite:
+			if(xTaskToNotify->notify_pending){
+				ret = pdFAIL;
+			}else{
+				xTaskToNotify->notify_value = ulValue;
+			}
+			break;
+		case eNoAction:
+			break;
+	}
+	xTaskToNotify->notify_pending = 1;
+	pthread_cond_broadcast(&xTaskToNotify->cond);
+	pthread_mutex_unlock(&xTaskToNotify->lock);
+
+	return ret;
+}
+
+BaseType_t xTaskNotifyFromISR(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken){
+	if(pxHigherPriorityTaskWoken != NULL){
+		*pxHigherPriorityTaskWoken = pdFALSE;
+	}
+	return xTaskNotify(xTaskToNotify, ulValue, eAction);
+}
+
+BaseType_t host_xTaskNotifyWait(uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait){
+	TaskHandle_t task = current_task;
+	int64_t deadline = host_deadline_us(xTicksToWait);
+	BaseType_t ret = pdFALSE;
+
+	if(task == NULL){
+		return pdFALSE;
+	}
+
+	pthread_mutex_lock(&task->lock);
+	pthread_cleanup_push(task_unlock, task);
+
+	if(task->notify_pending == 0){
+		task->notify_value &= ~ulBitsToClearOnEntry;
+	}
+
+	while(1){
+		while(task->suspended){
+			pthread_cond_wait(&task->cond, &task->lock);
+		}
+		if(task->notify_pending || xTicksToWait == 0){
+			break;
+		}
+		if(host_cond_wait_until(&task->cond, &task->lock, deadline) == ETIMEDOUT && task->suspended == 0){
+			break;
+		}
+	}
+
+	if(pulNotificationValue != NULL){
+		*pulNotificationValue = task->notify_value;
+	}
+	if(task->notify_pending){
+		task->notify_value &= ~ulBitsToClearOnExit;
+		task->notify_pending = 0;
+		ret = pdTRUE;
+	}
+
+	pthread_cleanup_pop(1);
+
+	return ret;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait){
+	TaskHandle_t task = current_task;
+	int64_t deadline = host_deadline_us(xTicksToWait);
+	uint32_t value;
+
+	if(task == NULL){
+		return 0;
+	}
+
+	pthread_mutex_lock(&task->lock);
+	pthread_cleanup_push(task_unlock, task);
+
+	while(1){
+		while(task->suspended){
+			pthread_cond_wait(&task->cond, &task->lock);
+		}
+		if(task->notify_value > 0 || xTicksToWait == 0){
+			break;
+		}
+		if(host_cond_wait_until(&task->cond, &task->lock, deadline) == ETIMEDOUT && task->suspended == 0){
+			break;
+		}
+	}
+
+	value = task->notify_value;
+	if(value > 0){
+		task->notify_value = xClearCountOnExit ? 0 : value - 1;
+	}
+	task->notify_pending = 0;
+
+	pthread_cleanup_pop(1);
+
+	return value;
+}
+
+/*****Queues and Mutexes************************************************************/
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize){
+	QueueHandle_t queue;
+
+	queue = calloc(1, sizeof(struct QueueDefinition));
+	if(queue == NULL){
+		return NULL;
+	}
+
+	if(uxItemSize > 0){
+		queue->storage = malloc((size_t) uxQueueLength * uxItemSize);
+		if(queue->storage == NULL){
+			free(queue);
+			return NULL;
+		}
+	}
+	queue->length = uxQueueLength;
+	queue->item_size = uxItemSize;
+	pthread_mutex_init(&queue->lock, NULL);
+	host_cond_init(&queue->not_empty);
+	host_cond_init(&queue->not_full);
+
+	return queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait){
+	int64_t deadline = host_deadline_us(xTicksToWait);
+	BaseType_t ret = pdFAIL;
+
+	pthread_mutex_lock(&xQueue->lock);
+	while(xQueue->count == xQueue->length && xTicksToWait > 0){
+		if(host_cond_wait_until(&xQueue->not_full, &xQueue->lock, deadline) == ETIMEDOUT){
+			break;
+		}
+	}
+	if(xQueue->count < xQueue->length){
+		if(xQueue->item_size > 0 && pvItemToQueue != NULL){
+			memcpy(&xQueue->storage[((xQueue->head + xQueue->count) % xQueue->length) * xQueue->item_size], pvItemToQueue, xQueue->item_size);
+		}
+		xQueue->count++;
+		pthread_cond_signal(&xQueue->not_empty);
+		ret = pdPASS;
+	}
+	pthread_mutex_unlock(&xQueue->lock);
+
+	return ret;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait){
+	int64_t deadline = host_deadline_us(xTicksToWait);
+	BaseType_t ret = pdFAIL;
+
+	pthread_mutex_lock(&xQueue->lock);
+	while(xQueue->count == 0 && xTicksToWait > 0){
+		if(host_cond_wait_until(&xQueue->not_empty, &xQueue->lock, deadline) == ETIMEDOUT){
+			break;
+		}
+	}
+	if(xQueue->count > 0){
+		if(xQueue->item_size > 0 && pvBuffer != NULL){
+			memcpy(pvBuffer, &xQueue->storage[xQueue->head * xQueue->item_size], xQueue->item_size);
+		}
+		xQueue->head = (xQueue->head + 1) % xQueue->length;
+		xQueue->count--;
+		pthread_cond_signal(&xQueue->not_full);
+		ret = pdPASS;
+	}
+	pthread_mutex_unlock(&xQueue->lock);
+
+	return ret;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue){
+	UBaseType_t count;
+
+	pthread_mutex_lock(&xQueue->lock);
+	count = xQueue->count;
+	pthread_mutex_unlock(&xQueue->lock);
+
+	return count;
+}
+
+void vQueueDelete(QueueHandle_t xQueue){
+	pthread_cond_destroy(&xQueue->not_empty);
+	pthread_cond_destroy(&xQueue->not_full);
+	pthread_mutex_destroy(&xQueue->lock);
+	free(xQueue->storage);
+	free(xQueue);
+}
+
+/**
+ * A mutex is a queue of length one without item storage that is created full, taking it receives the token.
+ */
+SemaphoreHandle_t xSemaphoreCreateMutex(void){
+	SemaphoreHandle_t mutex = xQueueCreate(1, 0);
+
+	if(mutex != NULL){
+		mutex->count = 1;
+	}
+
+	return mutex;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xTicksToWait){
+	return xQueueReceive(xSemaphore, NULL, xTicksToWait);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore){
+	return xQueueSend(xSemaphore, NULL, 0);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t xSemaphore){
+	vQueueDelete(xSemaphore);
+}
+
+/*****Private Functions*************************************************************/
+
+static void *task_entry(void *arg){
+	TaskHandle_t task = arg;
+
+	current_task = task;
+	pthread_setcanceltype(PTHREAD_CANCEL_DEFERRED, NULL);
+
+	task->code(task->parameters);
+
+	return NULL;														//a FreeRTOS task must not return, this ends the thread anyway
+}
+
+static void task_unlock(void *arg){
+	TaskHandle_t task = arg;
+
+	pthread_mutex_unlock(&task->lock);
+}
+
+/**
+ * Blocks the calling task as long as it is suspended.
+ */
+static void task_waitWhileSuspended(TaskHandle_t task){
+	pthread_mutex_lock(&task->lock);
+	pthread_cleanup_push(task_unlock, task);
+	while(task->suspended){
+		pthread_cond_wait(&task->cond, &task->lock);
+	}
+	pthread_cleanup_pop(1);
+}
+
+/**
+ * Blocks the caller until the given time (since the start of the program). A task that gets suspended
+ * while it sleeps stays blocked until it is resumed.
+ */
+static void task_sleepUntil(int64_t wake_us){
+	TaskHandle_t task = current_task;
+	struct timespec ts;
+
+	if(task == NULL){
+		host_abs_time(wake_us, &ts);
+		while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR);
+		return;
+	}
+
+	pthread_mutex_lock(&task->lock);
+	pthread_cleanup_push(task_unlock, task);
+	while(task->suspended || host_now_us() < wake_us){
+		if(task->suspended){
+			pthread_cond_wait(&task->cond, &task->lock);
+		}else{
+			host_cond_wait_until(&task->cond, &task->lock, wake_us);
+		}
+	}
+	pthread_cleanup_pop(1);
+}
@@ -0,0 +1,71 @@
+/**
+ * @file host_internal.h
+ * @brief Helpers that are shared between the host shims.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_HOST_INTERNAL_H_
+#define HOST_SHIMS_HOST_INTERNAL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "freertos/FreeRTOS.h"
+
+/**
+ * @brief Initializes a condition variable that uses CLOCK_MONOTONIC for its timeouts.
+ */
+void host_cond_init(pthread_cond_t *cond);
+
+/**
+ * @brief Monotonic time in us since the start of the program (the time base of esp_timer_get_time()).
+ */
+int64_t host_now_us(void);
+
+/**
+ * @brief Converts a time in us since the start of the program into an absolute CLOCK_MONOTONIC time.
+ */
+void host_abs_time(int64_t time_us, struct timespec *ts);
+
+/**
+ * @brief Waits on the condition variable until it is signaled or the deadline passed.
+ *
+ * @param deadline_us Deadline from host_deadline_us(), -1 to wait without timeout.
+ * @return 0 if signaled, ETIMEDOUT if the deadline passed.
+ */
+int host_cond_wait_until(pthread_cond_t *cond, pthread_mutex_t *mutex, int64_t deadline_us);
+
+/**
+ * @brief Deadline in us for a timeout in ticks, -1 for portMAX_DELAY.
+ */
+int64_t host_deadline_us(TickType_t ticks);
+
+/**
+ * @brief Simulated device on the SPI bus, selected by its chip select GPIO.
+ */
+typedef struct {
+	int		cs_pin;											/**< Chip select GPIO of the device. */
+	void	(*transfer)(void *ctx, const uint8_t *tx, uint8_t *rx, size_t len);	/**< Full duplex transfer of len bytes, tx may be NULL. */
+	void	*ctx;
+} host_spi_model_t;
+
+/**
+ * @brief Returns the simulated device with the given chip select GPIO, NULL if there is none.
+ */
+const host_spi_model_t *sim_devices_find(int cs_pin);
+
+/**
+ * @brief Returns the simulated device whose chip select GPIO is currently low, NULL if there is none.
+ *
+ * This is used for SPI devices without a hardware chip select (the sensor strips).
+ */
+const host_spi_model_t *sim_devices_findSelected(void);
+
+/**
+ * @brief Fills the time registers (0x03 - 0x09) of the simulated PCF8523 in BCD format.
+ */
+void sim_devices_readRtc(uint8_t *data, size_t len);
+
+#endif /* HOST_SHIMS_HOST_INTERNAL_H_ */
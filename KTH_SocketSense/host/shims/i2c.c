@@ -0,0 +1,72 @@
+/**
+ * @file i2c.c
+ * @brief Host shim of the ESP-IDF I2C driver.
+ *
+ * A command link only records where the data of its read commands has to go. When the link is executed,
+ * the reads are answered by the simulated PCF8523.
+ *
+ * @date October 17. 2026
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_err.h"
+#include "driver/i2c.h"
+#include "host_internal.h"
+
+#define I2C_SHIM_MAX_READS 4
+
+struct i2c_cmd_link {
+	uint8_t		*read_data[I2C_SHIM_MAX_READS];
+	size_t		read_len[I2C_SHIM_MAX_READS];
+	int			reads;
+};
+
+esp_err_t i2c_param_config(i2c_port_t i2c_num, const i2c_config_t *i2c_conf){
+	return ESP_OK;
+}
+
+esp_err_t i2c_driver_install(i2c_port_t i2c_num, i2c_mode_t mode, size_t slv_rx_buf_len, size_t slv_tx_buf_len, int intr_alloc_flags){
+	return ESP_OK;
+}
+
+i2c_cmd_handle_t i2c_cmd_link_create(void){
+	return calloc(1, sizeof(struct i2c_cmd_link));
+}
+
+void i2c_cmd_link_delete(i2c_cmd_handle_t cmd_handle){
+	free(cmd_handle);
+}
+
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd_handle){
+	return ESP_OK;
+}
+
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd_handle){
+	return ESP_OK;
+}
+
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd_handle, uint8_t data, int ack_en){
+	return ESP_OK;
+}
+
+esp_err_t i2c_master_read(i2c_cmd_handle_t cmd_handle, uint8_t *data, size_t data_len, int ack){
+	if(cmd_handle->reads == I2C_SHIM_MAX_READS){
+		return ESP_ERR_NO_MEM;
+	}
+	cmd_handle->read_data[cmd_handle->reads] = data;
+	cmd_handle->read_len[cmd_handle->reads] = data_len;
+	cmd_handle->reads++;
+
+	return ESP_OK;
+}
+
+esp_err_t i2c_master_cmd_begin(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle, TickType_t ticks_to_wait){
+	int i;
+
+	for(i = 0; i < cmd_handle->reads; i++){
+		sim_devices_readRtc(cmd_handle->read_data[i], cmd_handle->read_len[i]);
+	}
+
+	return ESP_OK;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file i2c.h
+ * @brief Host shim of the ESP-IDF I2C driver.
+ *
+ * Read commands are answered by a simulated PCF8523 that returns the host time.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_DRIVER_I2C_H_
+#define HOST_SHIMS_DRIVER_I2C_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+
+typedef enum {
+	I2C_NUM_0 = 0,
+	I2C_NUM_1,
+	I2C_NUM_MAX
+} i2c_port_t;
+
+typedef enum {
+	I2C_MODE_SLAVE = 0,
+	I2C_MODE_MASTER
+} i2c_mode_t;
+
+#define I2C_MASTER_WRITE	0
+#define I2C_MASTER_READ		1
+
+typedef struct {
+	i2c_mode_t		mode;
+	int				sda_io_num;
+	int				scl_io_num;
+	gpio_pullup_t	sda_pullup_en;
+	gpio_pullup_t	scl_pullup_en;
+	struct {
+		uint32_t	clk_speed;
+	} master;
+} i2c_config_t;
+
+typedef struct i2c_cmd_link* i2c_cmd_handle_t;
+
+esp_err_t i2c_param_config(i2c_port_t i2c_num, const i2c_config_t *i2c_conf);
+esp_err_t i2c_driver_install(i2c_port_t i2c_num, i2c_mode_t mode, size_t slv_rx_buf_len, size_t slv_tx_buf_len, int intr_alloc_flags);
+i2c_cmd_handle_t i2c_cmd_link_create(void);
+void i2c_cmd_link_delete(i2c_cmd_handle_t cmd_handle);
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd_handle);
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd_handle);
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd_handle, uint8_t data, int ack_en);
+esp_err_t i2c_master_read(i2c_cmd_handle_t cmd_handle, uint8_t *data, size_t data_len, int ack);
+esp_err_t i2c_master_cmd_begin(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle, TickType_t ticks_to_wait);
+
+#endif /* HOST_SHIMS_DRIVER_I2C_H_ */
@@ -0,0 +1,22 @@
+/**
+ * @file sdmmc_host.h
+ * @brief Host shim of the ESP-IDF SD/MMC host definitions.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_DRIVER_SDMMC_HOST_H_
+#define HOST_SHIMS_DRIVER_SDMMC_HOST_H_
+
+#include <stdint.h>
+
+typedef struct {
+	int			slot;
+	int			max_freq_khz;
+} sdmmc_host_t;
+
+typedef struct {
+	char		name[8];
+	uint64_t	capacity;			/**< Capacity in bytes of the directory that backs the card. */
+} sdmmc_card_t;
+
+#endif /* HOST_SHIMS_DRIVER_SDMMC_HOST_H_ */
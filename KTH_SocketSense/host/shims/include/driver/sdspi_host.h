@@ -0,0 +1,26 @@
+/**
+ * @file sdspi_host.h
+ * @brief Host shim of the ESP-IDF SD over SPI host definitions.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_DRIVER_SDSPI_HOST_H_
+#define HOST_SHIMS_DRIVER_SDSPI_HOST_H_
+
+#include "driver/sdmmc_host.h"
+#include "driver/gpio.h"
+
+typedef struct {
+	gpio_num_t	gpio_miso;
+	gpio_num_t	gpio_mosi;
+	gpio_num_t	gpio_sck;
+	gpio_num_t	gpio_cs;
+	gpio_num_t	gpio_cd;
+	gpio_num_t	gpio_wp;
+	int			dma_channel;
+} sdspi_slot_config_t;
+
+#define SDSPI_HOST_DEFAULT() {.slot = 1, .max_freq_khz = 20000}
+#define SDSPI_SLOT_CONFIG_DEFAULT() {.gpio_cd = GPIO_NUM_NC, .gpio_wp = GPIO_NUM_NC, .dma_channel = 1}
+
+#endif /* HOST_SHIMS_DRIVER_SDSPI_HOST_H_ */
@@ -0,0 +1,92 @@
+/**
+ * @file spi_master.h
+ * @brief Host shim of the ESP-IDF SPI master driver.
+ *
+ * Transactions are executed by the simulated devices of host_shims.h. Queued transactions are executed
+ * right away and their results are kept until they are collected with spi_device_get_trans_result().
+ * The pre- and post-transaction callbacks are called like the driver does.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_DRIVER_SPI_MASTER_H_
+#define HOST_SHIMS_DRIVER_SPI_MASTER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "driver/gpio.h"
+
+typedef enum {
+	SPI_HOST = 0,
+	HSPI_HOST = 1,
+	VSPI_HOST = 2
+} spi_host_device_t;
+
+#define SPI_TRANS_MODE_DIO		(1 << 0)
+#define SPI_TRANS_MODE_QIO		(1 << 1)
+#define SPI_TRANS_USE_RXDATA	(1 << 2)
+#define SPI_TRANS_USE_TXDATA	(1 << 3)
+
+typedef struct spi_transaction_t spi_transaction_t;
+
+typedef void (*transaction_cb_t)(spi_transaction_t *trans);
+
+struct spi_transaction_t {
+	uint32_t	flags;
+	uint16_t	cmd;
+	uint64_t	addr;
+	size_t		length;					/**< Total data length, in bits. */
+	size_t		rxlength;				/**< Total data length received, in bits. */
+	void		*user;
+	union {
+		const void	*tx_buffer;
+		uint8_t		tx_data[4];
+	};
+	union {
+		void		*rx_buffer;
+		uint8_t		rx_data[4];
+	};
+};
+
+typedef struct {
+	int			mosi_io_num;
+	int			miso_io_num;
+	int			sclk_io_num;
+	int			quadwp_io_num;
+	int			quadhd_io_num;
+	int			max_transfer_sz;
+	uint32_t	flags;
+	int			intr_flags;
+} spi_bus_config_t;
+
+typedef struct {
+	uint8_t				command_bits;
+	uint8_t				address_bits;
+	uint8_t				dummy_bits;
+	uint8_t				mode;
+	uint16_t			duty_cycle_pos;
+	uint16_t			cs_ena_pretrans;
+	uint8_t				cs_ena_posttrans;
+	int					clock_speed_hz;
+	int					input_delay_ns;
+	int					spics_io_num;
+	uint32_t			flags;
+	int					queue_size;
+	transaction_cb_t	pre_cb;
+	transaction_cb_t	post_cb;
+} spi_device_interface_config_t;
+
+typedef struct spi_device_t* spi_device_handle_t;
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *bus_config, int dma_chan);
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *dev_config, spi_device_handle_t *handle);
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans_desc, TickType_t ticks_to_wait);
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans_desc, TickType_t ticks_to_wait);
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc);
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc);
+esp_err_t spi_device_acquire_bus(spi_device_handle_t device, TickType_t wait);
+void spi_device_release_bus(spi_device_handle_t dev);
+
+#endif /* HOST_SHIMS_DRIVER_SPI_MASTER_H_ */
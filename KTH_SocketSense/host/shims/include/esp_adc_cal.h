@@ -0,0 +1,30 @@
+/**
+ * @file esp_adc_cal.h
+ * @brief Host shim of the ESP-IDF ADC calibration, the simulated battery is always at HOST_SHIMS_BATTERY_MV.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_ESP_ADC_CAL_H_
+#define HOST_SHIMS_ESP_ADC_CAL_H_
+
+#include <stdint.h>
+#include "driver/adc.h"
+
+typedef struct {
+	adc_unit_t			adc_num;
+	adc_atten_t			atten;
+	adc_bits_width_t	bit_width;
+	uint32_t			vref;
+} esp_adc_cal_characteristics_t;
+
+typedef enum {
+	ESP_ADC_CAL_VAL_EFUSE_VREF = 0,
+	ESP_ADC_CAL_VAL_EFUSE_TP,
+	ESP_ADC_CAL_VAL_DEFAULT_VREF
+} esp_adc_cal_value_t;
+
+esp_adc_cal_value_t esp_adc_cal_characterize(adc_unit_t adc_num, adc_atten_t atten, adc_bits_width_t bit_width,
+		uint32_t default_vref, esp_adc_cal_characteristics_t *chars);
+esp_err_t esp_adc_cal_get_voltage(adc1_channel_t channel, const esp_adc_cal_characteristics_t *chars, uint32_t *voltage);
+
+#endif /* HOST_SHIMS_ESP_ADC_CAL_H_ */
@@ -0,0 +1,14 @@
+/**
+ * @file esp_clk.h
+ * @brief Host shim of the ESP-IDF clock functions.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_ESP_CLK_H_
+#define HOST_SHIMS_ESP_CLK_H_
+
+#define HOST_CPU_FREQ_HZ 1000000000			//!< Rate of the cycle counter of the host (xtensa/hal.h)
+
+int esp_clk_cpu_freq(void);
+
+#endif /* HOST_SHIMS_ESP_CLK_H_ */
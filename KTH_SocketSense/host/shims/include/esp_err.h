@@ -0,0 +1,38 @@
+/**
+ * @file esp_err.h
+ * @brief Host shim of the ESP-IDF error codes.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_ESP_ERR_H_
+#define HOST_SHIMS_ESP_ERR_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+typedef int32_t esp_err_t;
+
+#define ESP_OK					0
+#define ESP_FAIL				-1
+#define ESP_ERR_NO_MEM			0x101
+#define ESP_ERR_INVALID_ARG		0x102
+#define ESP_ERR_INVALID_STATE	0x103
+#define ESP_ERR_INVALID_SIZE	0x104
+#define ESP_ERR_NOT_FOUND		0x105
+#define ESP_ERR_NOT_SUPPORTED	0x106
+#define ESP_ERR_TIMEOUT			0x107
+
+const char *esp_err_to_name(esp_err_t code);
+
+#define ESP_ERROR_CHECK(x) do {																\
+		esp_err_t __err_rc = (x);															\
+		if (__err_rc != ESP_OK) {															\
+			fprintf(stderr, "ESP_ERROR_CHECK failed: %s at %s:%d\n",						\
+					esp_err_to_name(__err_rc), __FILE__, __LINE__);							\
+			abort();																		\
+		}																					\
+	} while(0)
+
+#endif /* HOST_SHIMS_ESP_ERR_H_ */
@@ -0,0 +1,69 @@
+/**
+ * @file esp_http_client.h
+ * @brief Host shim of the ESP-IDF HTTP client.
+ *
+ * Requests are sent over a POSIX socket with HTTP/1.1 keep-alive, like the ESP-IDF client does.
+ * The events that the firmware handles (connected, header, data, finish, disconnected) are raised in the same order.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_ESP_HTTP_CLIENT_H_
+#define HOST_SHIMS_ESP_HTTP_CLIENT_H_
+
+#include <stdbool.h>
+#include "esp_err.h"
+
+typedef struct esp_http_client* esp_http_client_handle_t;
+
+typedef enum {
+	HTTP_EVENT_ERROR = 0,
+	HTTP_EVENT_ON_CONNECTED,
+	HTTP_EVENT_HEADER_SENT,
+	HTTP_EVENT_ON_HEADER,
+	HTTP_EVENT_ON_DATA,
+	HTTP_EVENT_ON_FINISH,
+	HTTP_EVENT_DISCONNECTED
+} esp_http_client_event_id_t;
+
+typedef struct esp_http_client_event {
+	esp_http_client_event_id_t	event_id;
+	esp_http_client_handle_t	client;
+	void						*data;
+	int							data_len;
+	void						*user_data;
+	char						*header_key;
+	char						*header_value;
+} esp_http_client_event_t;
+
+typedef esp_err_t (*http_event_handle_cb)(esp_http_client_event_t *evt);
+
+typedef enum {
+	HTTP_METHOD_GET = 0,
+	HTTP_METHOD_POST
+} esp_http_client_method_t;
+
+typedef struct {
+	const char				*url;
+	const char				*host;
+	int						port;
+	const char				*username;
+	const char				*password;
+	const char				*path;
+	const char				*query;
+	int						timeout_ms;
+	http_event_handle_cb	event_handler;
+	void					*user_data;
+} esp_http_client_config_t;
+
+esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t *config);
+esp_err_t esp_http_client_perform(esp_http_client_handle_t client);
+esp_err_t esp_http_client_set_method(esp_http_client_handle_t client, esp_http_client_method_t method);
+esp_err_t esp_http_client_set_post_field(esp_http_client_handle_t client, const char *data, int len);
+esp_err_t esp_http_client_set_header(esp_http_client_handle_t client, const char *key, const char *value);
+int esp_http_client_get_status_code(esp_http_client_handle_t client);
+int esp_http_client_get_content_length(esp_http_client_handle_t client);
+bool esp_http_client_is_chunked_response(esp_http_client_handle_t client);
+esp_err_t esp_http_client_close(esp_http_client_handle_t client);
+esp_err_t esp_http_client_cleanup(esp_http_client_handle_t client);
+
+#endif /* HOST_SHIMS_ESP_HTTP_CLIENT_H_ */
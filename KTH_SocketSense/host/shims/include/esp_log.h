@@ -0,0 +1,41 @@
+/**
+ * @file esp_log.h
+ * @brief Host shim of the ESP-IDF logging library.
+ *
+ * The messages are written to stderr, the level is limited by CONFIG_LOG_DEFAULT_LEVEL from the sdkconfig.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_ESP_LOG_H_
+#define HOST_SHIMS_ESP_LOG_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef enum {
+	ESP_LOG_NONE,
+	ESP_LOG_ERROR,
+	ESP_LOG_WARN,
+	ESP_LOG_INFO,
+	ESP_LOG_DEBUG,
+	ESP_LOG_VERBOSE
+} esp_log_level_t;
+
+/**
+ * @brief Milliseconds since the start of the program, printed with each message.
+ */
+uint32_t esp_log_timestamp(void);
+
+#define ESP_LOG_LEVEL_HOST(level, letter, tag, format, ...) do {										\
+		if (CONFIG_LOG_DEFAULT_LEVEL >= (level)) {														\
+			fprintf(stderr, letter " (%u) %s: " format "\n", esp_log_timestamp(), tag, ##__VA_ARGS__);	\
+		}																								\
+	} while(0)
+
+#define ESP_LOGE(tag, format, ...) ESP_LOG_LEVEL_HOST(ESP_LOG_ERROR, "E", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) ESP_LOG_LEVEL_HOST(ESP_LOG_WARN, "W", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) ESP_LOG_LEVEL_HOST(ESP_LOG_INFO, "I", tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) ESP_LOG_LEVEL_HOST(ESP_LOG_DEBUG, "D", tag, format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) ESP_LOG_LEVEL_HOST(ESP_LOG_VERBOSE, "V", tag, format, ##__VA_ARGS__)
+
+#endif /* HOST_SHIMS_ESP_LOG_H_ */
@@ -0,0 +1,16 @@
+/**
+ * @file esp_system.h
+ * @brief Host shim of the ESP-IDF system definitions.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_ESP_SYSTEM_H_
+#define HOST_SHIMS_ESP_SYSTEM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#define IRAM_ATTR
+
+#endif /* HOST_SHIMS_ESP_SYSTEM_H_ */
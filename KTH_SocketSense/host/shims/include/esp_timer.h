@@ -0,0 +1,37 @@
+/**
+ * @file esp_timer.h
+ * @brief Host shim of the ESP-IDF high resolution timer.
+ *
+ * The time base is CLOCK_MONOTONIC. Each timer is served by its own thread, which plays the role of the esp_timer task.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_ESP_TIMER_H_
+#define HOST_SHIMS_ESP_TIMER_H_
+
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef struct esp_timer* esp_timer_handle_t;
+
+typedef void (*esp_timer_cb_t)(void* arg);
+
+typedef enum {
+	ESP_TIMER_TASK
+} esp_timer_dispatch_t;
+
+typedef struct {
+	esp_timer_cb_t			callback;
+	void*					arg;
+	esp_timer_dispatch_t	dispatch_method;
+	const char*				name;
+} esp_timer_create_args_t;
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* create_args, esp_timer_handle_t* out_handle);
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period);
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us);
+esp_err_t esp_timer_stop(esp_timer_handle_t timer);
+esp_err_t esp_timer_delete(esp_timer_handle_t timer);
+int64_t esp_timer_get_time(void);
+
+#endif /* HOST_SHIMS_ESP_TIMER_H_ */
@@ -0,0 +1,30 @@
+/**
+ * @file esp_vfs_fat.h
+ * @brief Host shim of the ESP-IDF FAT file system on the SD-card.
+ *
+ * Mounting maps the base path (e.g. /sdcard) to a directory of the host, see host_shims_setSdCardRoot().
+ * The firmware sources are compiled with vfs_shim.h, which redirects their file accesses.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_ESP_VFS_FAT_H_
+#define HOST_SHIMS_ESP_VFS_FAT_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "driver/sdmmc_host.h"
+#include "driver/sdspi_host.h"
+#include "sdmmc_cmd.h"
+
+typedef struct {
+	bool		format_if_mount_failed;
+	int			max_files;
+	size_t		allocation_unit_size;
+} esp_vfs_fat_sdmmc_mount_config_t;
+
+esp_err_t esp_vfs_fat_sdmmc_mount(const char *base_path, const sdmmc_host_t *host_config, const void *slot_config,
+		const esp_vfs_fat_sdmmc_mount_config_t *mount_config, sdmmc_card_t **out_card);
+esp_err_t esp_vfs_fat_sdmmc_unmount(void);
+
+#endif /* HOST_SHIMS_ESP_VFS_FAT_H_ */
@@ -0,0 +1,58 @@
+/**
+ * @file FreeRTOS.h
+ * @brief Host shim of the FreeRTOS base definitions.
+ *
+ * Tasks are POSIX threads, see freertos.c. The tick rate is CONFIG_FREERTOS_HZ from the sdkconfig,
+ * so all periods that are expressed in ticks behave as they do on the ESP32.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_FREERTOS_H_
+#define HOST_SHIMS_FREERTOS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <limits.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define pdTRUE					1
+#define pdFALSE					0
+#define pdPASS					pdTRUE
+#define pdFAIL					pdFALSE
+
+#define portMAX_DELAY			(TickType_t) 0xffffffffUL
+#define configTICK_RATE_HZ		CONFIG_FREERTOS_HZ
+#define portTICK_PERIOD_MS		((TickType_t) 1000 / configTICK_RATE_HZ)
+#define portTICK_RATE_MS		portTICK_PERIOD_MS
+#define pdMS_TO_TICKS(ms)		((TickType_t)(((TickType_t)(ms) * configTICK_RATE_HZ) / 1000))
+#define tskNO_AFFINITY			0x7fffffff
+
+/**
+ * @brief Critical sections are implemented with one global recursive mutex.
+ */
+typedef struct {
+	int		unused;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {0}
+
+void vPortEnterCritical(portMUX_TYPE *mux);
+void vPortExitCritical(portMUX_TYPE *mux);
+
+#define portENTER_CRITICAL(mux)			vPortEnterCritical(mux)
+#define portEXIT_CRITICAL(mux)			vPortExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux)		vPortEnterCritical(mux)
+#define portEXIT_CRITICAL_ISR(mux)		vPortExitCritical(mux)
+#define portYIELD_FROM_ISR()			do {} while(0)
+
+/**
+ * @brief Returns the core the calling task was pinned to, 0 for threads that are not FreeRTOS tasks.
+ */
+int xPortGetCoreID(void);
+
+typedef struct QueueDefinition* QueueHandle_t;
+
+#endif /* HOST_SHIMS_FREERTOS_H_ */
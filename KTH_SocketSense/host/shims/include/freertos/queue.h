@@ -0,0 +1,18 @@
+/**
+ * @file queue.h
+ * @brief Host shim of the FreeRTOS queue API.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_FREERTOS_QUEUE_H_
+#define HOST_SHIMS_FREERTOS_QUEUE_H_
+
+#include "freertos/FreeRTOS.h"
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize);
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait);
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue);
+void vQueueDelete(QueueHandle_t xQueue);
+
+#endif /* HOST_SHIMS_FREERTOS_QUEUE_H_ */
@@ -0,0 +1,27 @@
+/**
+ * @file ringbuf.h
+ * @brief Host shim of the ESP-IDF ring buffer, only byte buffers (RINGBUF_TYPE_BYTEBUF) are provided.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_FREERTOS_RINGBUF_H_
+#define HOST_SHIMS_FREERTOS_RINGBUF_H_
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct ringbuf* RingbufHandle_t;
+
+typedef enum {
+	RINGBUF_TYPE_NOSPLIT = 0,
+	RINGBUF_TYPE_ALLOWSPLIT,
+	RINGBUF_TYPE_BYTEBUF
+} ringbuf_type_t;
+
+RingbufHandle_t xRingbufferCreate(size_t xBufferSize, ringbuf_type_t xBufferType);
+void vRingbufferDelete(RingbufHandle_t xRingbuffer);
+BaseType_t xRingbufferSend(RingbufHandle_t xRingbuffer, const void *pvItem, size_t xItemSize, TickType_t xTicksToWait);
+void *xRingbufferReceiveUpTo(RingbufHandle_t xRingbuffer, size_t *pxItemSize, TickType_t xTicksToWait, size_t xMaxSize);
+void vRingbufferReturnItem(RingbufHandle_t xRingbuffer, void *pvItem);
+size_t xRingbufferGetCurFreeSize(RingbufHandle_t xRingbuffer);
+
+#endif /* HOST_SHIMS_FREERTOS_RINGBUF_H_ */
@@ -0,0 +1,19 @@
+/**
+ * @file semphr.h
+ * @brief Host shim of the FreeRTOS semaphore API, only mutexes are provided.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_FREERTOS_SEMPHR_H_
+#define HOST_SHIMS_FREERTOS_SEMPHR_H_
+
+#include "freertos/queue.h"
+
+typedef QueueHandle_t SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xTicksToWait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore);
+void vSemaphoreDelete(SemaphoreHandle_t xSemaphore);
+
+#endif /* HOST_SHIMS_FREERTOS_SEMPHR_H_ */
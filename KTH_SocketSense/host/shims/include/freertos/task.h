@@ -0,0 +1,53 @@
+/**
+ * @file task.h
+ * @brief Host shim of the FreeRTOS task API.
+ *
+ * Each task runs in its own POSIX thread, priorities and core affinity are recorded but not enforced.
+ * A task can only be suspended by another task while it waits in a FreeRTOS call (delay or notification wait),
+ * which is where the firmware tasks spend their idle time.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_FREERTOS_TASK_H_
+#define HOST_SHIMS_FREERTOS_TASK_H_
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct tskTaskControlBlock* TaskHandle_t;
+
+typedef void (*TaskFunction_t)(void*);
+
+typedef enum {
+	eNoAction,
+	eSetBits,
+	eIncrement,
+	eSetValueWithOverwrite,
+	eSetValueWithoutOverwrite
+} eNotifyAction;
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pvTaskCode, const char *pcName, uint32_t usStackDepth, void *pvParameters,
+		UBaseType_t uxPriority, TaskHandle_t *pvCreatedTask, BaseType_t xCoreID);
+BaseType_t xTaskCreate(TaskFunction_t pvTaskCode, const char *pcName, uint32_t usStackDepth, void *pvParameters,
+		UBaseType_t uxPriority, TaskHandle_t *pvCreatedTask);
+void vTaskDelete(TaskHandle_t xTaskToDelete);
+void vTaskSuspend(TaskHandle_t xTaskToSuspend);
+void vTaskResume(TaskHandle_t xTaskToResume);
+void vTaskDelay(const TickType_t xTicksToDelay);
+void vTaskDelayUntil(TickType_t *pxPreviousWakeTime, const TickType_t xTimeIncrement);
+TickType_t xTaskGetTickCount(void);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+BaseType_t xTaskNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction);
+BaseType_t xTaskNotifyFromISR(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, BaseType_t *pxHigherPriorityTaskWoken);
+BaseType_t host_xTaskNotifyWait(uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait);
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
+
+#define xTaskNotifyGive(xTaskToNotify) xTaskNotify((xTaskToNotify), 0, eIncrement)
+
+/**
+ * The firmware clears all bits with ULONG_MAX, which is 64 bits wide on the host: the casts truncate it to the 32 bits
+ * of the ESP32 without an overflow warning.
+ */
+#define xTaskNotifyWait(ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait)	\
+		host_xTaskNotifyWait((uint32_t)(ulBitsToClearOnEntry), (uint32_t)(ulBitsToClearOnExit), (pulNotificationValue), (TickType_t)(xTicksToWait))
+
+#endif /* HOST_SHIMS_FREERTOS_TASK_H_ */
@@ -0,0 +1,64 @@
+/**
+ * @file host_shims.h
+ * @brief Controls the simulation of the host build.
+ *
+ * The firmware components are compiled unmodified for the host. The ESP-IDF and FreeRTOS APIs they use are
+ * provided by the shims in this directory:
+ * - FreeRTOS tasks, notifications, queues, mutexes and ring buffers run on POSIX threads.
+ * - esp_timer uses CLOCK_MONOTONIC, each timer is served by its own thread.
+ * - The SPI master executes transactions against simulated devices: the BME280 and one MCP3208 per sensor strip.
+ *   The MCP3208 channels return a slow sine wave with a different phase for each sensor element.
+ * - esp_http_client sends real HTTP/1.1 requests over a socket, with keep-alive.
+ * - The SD-card is a directory of the host, see host_shims_setSdCardRoot().
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_HOST_SHIMS_H_
+#define HOST_SHIMS_HOST_SHIMS_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Simulated battery voltage at the ADC input in mV (half the battery voltage).
+ */
+#define HOST_SHIMS_BATTERY_MV 1900
+
+/**
+ * @brief Statistics of the simulated SPI bus.
+ */
+typedef struct {
+	uint32_t	transactions;		/**< Number of executed transactions. */
+	uint64_t	bytes;				/**< Number of transferred bytes. */
+	uint64_t	bus_time_ns;		/**< Time the bus was busy with transfers (only if the timing is simulated). */
+} host_spi_stats_t;
+
+/**
+ * @brief Sets the host directory that backs the SD-card, the default is "sdcard" in the working directory.
+ *
+ * This has to be called before the SD-card is mounted.
+ *
+ * @param path Directory, it is created when the card is mounted.
+ */
+void host_shims_setSdCardRoot(const char *path);
+
+/**
+ * @brief Returns the host directory that backs the SD-card.
+ */
+const char *host_shims_getSdCardRoot(void);
+
+/**
+ * @brief Enables or disables the simulation of the SPI transfer time.
+ *
+ * If enabled (the default), each transaction keeps the bus busy for the time it takes to clock out its bits
+ * at the configured clock speed of the device.
+ *
+ * @param enabled 1 to enable the simulation, 0 to disable it.
+ */
+void host_shims_setSpiTiming(uint8_t enabled);
+
+/**
+ * @brief Returns the statistics of the simulated SPI bus.
+ */
+void host_shims_getSpiStatistics(host_spi_stats_t *stats);
+
+#endif /* HOST_SHIMS_HOST_SHIMS_H_ */
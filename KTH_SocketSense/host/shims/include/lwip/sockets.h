@@ -0,0 +1,18 @@
+/**
+ * @file sockets.h
+ * @brief Host shim of the LwIP socket API, the BSD sockets of the host are used directly.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_LWIP_SOCKETS_H_
+#define HOST_SHIMS_LWIP_SOCKETS_H_
+
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#endif /* HOST_SHIMS_LWIP_SOCKETS_H_ */
@@ -0,0 +1,15 @@
+/**
+ * @file sdmmc_cmd.h
+ * @brief Host shim of the ESP-IDF SD/MMC protocol layer.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_SDMMC_CMD_H_
+#define HOST_SHIMS_SDMMC_CMD_H_
+
+#include <stdio.h>
+#include "driver/sdmmc_host.h"
+
+void sdmmc_card_print_info(FILE *stream, const sdmmc_card_t *card);
+
+#endif /* HOST_SHIMS_SDMMC_CMD_H_ */
@@ -0,0 +1,36 @@
+/**
+ * @file vfs_shim.h
+ * @brief Redirects the file accesses of the firmware sources to the directory that backs the SD-card.
+ *
+ * This header is force included into the firmware sources of the host build. Paths below the mount point
+ * of the SD-card (e.g. /sdcard/config.txt) are mapped into the directory set with host_shims_setSdCardRoot(),
+ * all other paths are passed through.
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_VFS_SHIM_H_
+#define HOST_SHIMS_VFS_SHIM_H_
+
+#include <stdio.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+FILE *host_vfs_fopen(const char *path, const char *mode);
+int host_vfs_stat(const char *path, struct stat *buf);
+int host_vfs_remove(const char *path);
+int host_vfs_unlink(const char *path);
+int host_vfs_rename(const char *oldpath, const char *newpath);
+int host_vfs_mkdir(const char *path, mode_t mode);
+DIR *host_vfs_opendir(const char *path);
+
+#define fopen(path, mode)			host_vfs_fopen(path, mode)
+#define stat(path, buf)				host_vfs_stat(path, buf)
+#define remove(path)				host_vfs_remove(path)
+#define unlink(path)				host_vfs_unlink(path)
+#define rename(oldpath, newpath)	host_vfs_rename(oldpath, newpath)
+#define mkdir(path, mode)			host_vfs_mkdir(path, mode)
+#define opendir(path)				host_vfs_opendir(path)
+
+#endif /* HOST_SHIMS_VFS_SHIM_H_ */
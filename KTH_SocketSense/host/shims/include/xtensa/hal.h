@@ -0,0 +1,14 @@
+/**
+ * @file hal.h
+ * @brief Host shim of the Xtensa HAL, only the cycle counter.
+ *
+ * The host counts nanoseconds of CLOCK_MONOTONIC as cycles, i.e. it looks like a CPU with 1 GHz (see esp_clk.h).
+ *
+ * @date October 17. 2026
+ */
+#ifndef HOST_SHIMS_XTENSA_HAL_H_
+#define HOST_SHIMS_XTENSA_HAL_H_
+
+unsigned xthal_get_ccount(void);
+
+#endif /* HOST_SHIMS_XTENSA_HAL_H_ */
@@ -0,0 +1,84 @@
+/**
+ * @file peripherals.c
+ * @brief Host shims of the small ESP-IDF services: error names, log time stamps, GPIO and ADC.
+ *
+ * @date October 17. 2026
+ */
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "driver/gpio.h"
+#include "driver/adc.h"
+#include "esp_adc_cal.h"
+#include "host_shims.h"
+
+static volatile uint8_t gpio_level[GPIO_NUM_MAX];
+
+const char *esp_err_to_name(esp_err_t code){
+	switch(code){
+		case ESP_OK:				return "ESP_OK";
+		case ESP_FAIL:				return "ESP_FAIL";
+		case ESP_ERR_NO_MEM:		return "ESP_ERR_NO_MEM";
+		case ESP_ERR_INVALID_ARG:	return "ESP_ERR_INVALID_ARG";
+		case ESP_ERR_INVALID_STATE:	return "ESP_ERR_INVALID_STATE";
+		case ESP_ERR_INVALID_SIZE:	return "ESP_ERR_INVALID_SIZE";
+		case ESP_ERR_NOT_FOUND:		return "ESP_ERR_NOT_FOUND";
+		case ESP_ERR_NOT_SUPPORTED:	return "ESP_ERR_NOT_SUPPORTED";
+		case ESP_ERR_TIMEOUT:		return "ESP_ERR_TIMEOUT";
+		default:					return "UNKNOWN ERROR";
+	}
+}
+
+uint32_t esp_log_timestamp(void){
+	return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+void gpio_pad_select_gpio(uint8_t gpio_num){
+}
+
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode){
+	if(gpio_num < 0 || gpio_num >= GPIO_NUM_MAX){
+		return ESP_ERR_INVALID_ARG;
+	}
+	return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level){
+	if(gpio_num < 0 || gpio_num >= GPIO_NUM_MAX){
+		return ESP_ERR_INVALID_ARG;
+	}
+	gpio_level[gpio_num] = (level > 0);
+	return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num){
+	if(gpio_num < 0 || gpio_num >= GPIO_NUM_MAX){
+		return 0;
+	}
+	return gpio_level[gpio_num];
+}
+
+esp_err_t adc1_config_width(adc_bits_width_t width_bit){
+	return ESP_OK;
+}
+
+esp_err_t adc1_config_channel_atten(adc1_channel_t channel, adc_atten_t atten){
+	return ESP_OK;
+}
+
+esp_adc_cal_value_t esp_adc_cal_characterize(adc_unit_t adc_num, adc_atten_t atten, adc_bits_width_t bit_width,
+		uint32_t default_vref, esp_adc_cal_characteristics_t *chars){
+	chars->adc_num = adc_num;
+	chars->atten = atten;
+	chars->bit_width = bit_width;
+	chars->vref = default_vref;
+
+	return ESP_ADC_CAL_VAL_EFUSE_VREF;
+}
+
+esp_err_t esp_adc_cal_get_voltage(adc1_channel_t channel, const esp_adc_cal_characteristics_t *chars, uint32_t *voltage){
+	*voltage = HOST_SHIMS_BATTERY_MV;
+	return ESP_OK;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file ringbuf.c
+ * @brief Host shim of the ESP-IDF byte ring buffer.
+ *
+ * Like the ESP-IDF byte buffer, received data is handed out in place (up to the end of the storage)
+ * and only becomes free space again once it is returned with vRingbufferReturnItem().
+ *
+ * @date October 17. 2026
+ */
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/ringbuf.h"
+#include "host_internal.h"
+
+struct ringbuf {
+	pthread_mutex_t		lock;
+	pthread_cond_t		not_empty;
+	pthread_cond_t		not_full;
+	uint8_t				*storage;
+	size_t				size;
+	size_t				head;					//read position
+	size_t				used;					//bytes in the buffer, including the item that is handed out
+	size_t				outstanding;			//size of the item that has been received but not returned yet
+};
+
+RingbufHandle_t xRingbufferCreate(size_t xBufferSize, ringbuf_type_t xBufferType){
+	RingbufHandle_t rb;
+
+	if(xBufferType != RINGBUF_TYPE_BYTEBUF || xBufferSize == 0){
+		return NULL;
+	}
+
+	rb = calloc(1, sizeof(struct ringbuf));
+	if(rb == NULL){
+		return NULL;
+	}
+
+	rb->storage = malloc(xBufferSize);
+	if(rb->storage == NULL){
+		free(rb);
+		return NULL;
+	}
+	rb->size = xBufferSize;
+	pthread_mutex_init(&rb->lock, NULL);
+	host_cond_init(&rb->not_empty);
+	host_cond_init(&rb->not_full);
+
+	return rb;
+}
+
+void vRingbufferDelete(RingbufHandle_t xRingbuffer){
+	pthread_cond_destroy(&xRingbuffer->not_empty);
+	pthread_cond_destroy(&xRingbuffer->not_full);
+	pthread_mutex_destroy(&xRingbuffer->lock);
+	free(xRingbuffer->storage);
+	free(xRingbuffer);
+}
+
+BaseType_t xRingbufferSend(RingbufHandle_t xRingbuffer, const void *pvItem, size_t xItemSize, TickType_t xTicksToWait){
+	int64_t deadline = host_deadline_us(xTicksToWait);
+	BaseType_t ret = pdFALSE;
+	size_t tail;
+	size_t first;
+
+	if(xItemSize > xRingbuffer->size){
+		return pdFALSE;
+	}
+
+	pthread_mutex_lock(&xRingbuffer->lock);
+	while(xRingbuffer->size - xRingbuffer->used < xItemSize && xTicksToWait > 0){
+		if(host_cond_wait_until(&xRingbuffer->not_full, &xRingbuffer->lock, deadline) == ETIMEDOUT){
+			break;
+		}
+	}
+	if(xRingbuffer->size - xRingbuffer->used >= xItemSize){
+		tail = (xRingbuffer->head + xRingbuffer->used) % xRingbuffer->size;
+		first = xRingbuffer->size - tail;
+		if(first > xItemSize){
+			first = xItemSize;
+		}
+		memcpy(&xRingbuffer->storage[tail], pvItem, first);
+		memcpy(xRingbuffer->storage, (const uint8_t*) pvItem + first, xItemSize - first);
+		xRingbuffer->used += xItemSize;
+		pthread_cond_signal(&xRingbuffer->not_empty);
+		ret = pdTRUE;
+	}
+	pthread_mutex_unlock(&xRingbuffer->lock);
+
+	return ret;
+}
+
+void *xRingbufferReceiveUpTo(RingbufHandle_t xRingbuffer, size_t *pxItemSize, TickType_t xTicksToWait, size_t xMaxSize){
+	int64_t deadline = host_deadline_us(xTicksToWait);
+	void *item = NULL;
+	size_t len;
+
+	pthread_mutex_lock(&xRingbuffer->lock);
+	while((xRingbuffer->outstanding > 0 || xRingbuffer->used == 0) && xTicksToWait > 0){
+		if(host_cond_wait_until(&xRingbuffer->not_empty, &xRingbuffer->lock, deadline) == ETIMEDOUT){
+			break;
+		}
+	}
+	if(xRingbuffer->outstanding == 0 && xRingbuffer->used > 0 && xMaxSize > 0){
+		len = xRingbuffer->size - xRingbuffer->head;					//the item ends at the end of the storage at the latest
+		if(len > xRingbuffer->used){
+			len = xRingbuffer->used;
+		}
+		if(len > xMaxSize){
+			len = xMaxSize;
+		}
+		item = &xRingbuffer->storage[xRingbuffer->head];
+		xRingbuffer->outstanding = len;
+		*pxItemSize = len;
+	}
+	pthread_mutex_unlock(&xRingbuffer->lock);
+
+	return item;
+}
+
+void vRingbufferReturnItem(RingbufHandle_t xRingbuffer, void *pvItem){
+	pthread_mutex_lock(&xRingbuffer->lock);
+	xRingbuffer->head = (xRingbuffer->head + xRingbuffer->outstanding) % xRingbuffer->size;
+	xRingbuffer->used -= xRingbuffer->outstanding;
+	xRingbuffer->outstanding = 0;
+	pthread_cond_broadcast(&xRingbuffer->not_full);
+	pthread_cond_signal(&xRingbuffer->not_empty);
+	pthread_mutex_unlock(&xRingbuffer->lock);
+}
+
+size_t xRingbufferGetCurFreeSize(RingbufHandle_t xRingbuffer){
+	size_t free_size;
+
+	pthread_mutex_lock(&xRingbuffer->lock);
+	free_size = xRingbuffer->size - xRingbuffer->used;
+	pthread_mutex_unlock(&xRingbuffer->lock);
+
+	return free_size;
+}
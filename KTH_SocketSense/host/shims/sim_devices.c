@@ -0,0 +1,249 @@
+/**
+ * @file sim_devices.c
+ * @brief Simulated devices of the SocketSense board for the host shims.
+ *
+ * The devices are wired like on the board, see KTHSocketSense.h:
+ * - BME280 on the sensor SPI bus, with the calibration values of the example in the Bosch datasheet.
+ *   Temperature and pressure drift slowly, so the samples are not all the same.
+ * - One MCP3208 per sensor strip, selected by the chip select GPIOs of the strips. Each channel returns
+ *   a 1 Hz sine wave around mid-scale, with a different phase for each sensor element.
+ * - Gait monitor on the sensor SPI bus. The subject walks for 20 s with a stride of 1.1 s and stands for 10 s, the
+ *   activity code follows the phases of the stride.
+ * - PCF8523 real time clock on I2C, which returns the local time of the host.
+ *
+ * @date October 17. 2026
+ */
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+#include "esp_timer.h"
+#include "driver/gpio.h"
+#include "host_internal.h"
+#include "KTHSocketSense.h"
+#include "gait_monitor.h"
+
+#define SIM_STRIP_COUNT 4
+
+#define BME280_SIM_ADC_T 519888				//25.08 degC with the datasheet calibration
+#define BME280_SIM_ADC_P 415148				//100653 Pa with the datasheet calibration
+#define BME280_SIM_ADC_H 27000
+
+#define GAIT_SIM_WALKING_S 20.0				//walking bout, followed by standing
+#define GAIT_SIM_STANDING_S 10.0
+#define GAIT_SIM_STRIDE_S 1.1
+
+static uint8_t bme280_registers[256];
+static uint8_t bme280_loaded = 0;
+
+static const int strip_cs[SIM_STRIP_COUNT] = {PIN_NUM_SENSOR_CS1, PIN_NUM_SENSOR_CS2, PIN_NUM_SENSOR_CS3, PIN_NUM_SENSOR_CS4};
+
+/*****Private Functions Definitions*************************************************/
+
+static void bme280_transfer(void *ctx, const uint8_t *tx, uint8_t *rx, size_t len);
+static void mcp3208_transfer(void *ctx, const uint8_t *tx, uint8_t *rx, size_t len);
+static void gait_monitor_transfer(void *ctx, const uint8_t *tx, uint8_t *rx, size_t len);
+static void bme280_load(void);
+static void bme280_setRaw20(uint8_t reg, int32_t value);
+static uint8_t toBcd(int value);
+
+static const host_spi_model_t bme280_model = {PIN_NUM_BME280_CS, bme280_transfer, NULL};
+static const host_spi_model_t gait_monitor_model = {PIN_NUM_GAITMONITOR_CS, gait_monitor_transfer, NULL};
+
+static const host_spi_model_t mcp3208_model[SIM_STRIP_COUNT] = {
+	{PIN_NUM_SENSOR_CS1, mcp3208_transfer, (void*) 0},
+	{PIN_NUM_SENSOR_CS2, mcp3208_transfer, (void*) 1},
+	{PIN_NUM_SENSOR_CS3, mcp3208_transfer, (void*) 2},
+	{PIN_NUM_SENSOR_CS4, mcp3208_transfer, (void*) 3},
+};
+
+/*****Public Functions**************************************************************/
+
+const host_spi_model_t *sim_devices_find(int cs_pin){
+	int i;
+
+	if(cs_pin == bme280_model.cs_pin){
+		return &bme280_model;
+	}
+	if(cs_pin == gait_monitor_model.cs_pin){
+		return &gait_monitor_model;
+	}
+	for(i = 0; i < SIM_STRIP_COUNT; i++){
+		if(cs_pin == strip_cs[i]){
+			return &mcp3208_model[i];
+		}
+	}
+
+	return NULL;
+}
+
+const host_spi_model_t *sim_devices_findSelected(void){
+	int i;
+
+	for(i = 0; i < SIM_STRIP_COUNT; i++){
+		if(gpio_get_level(strip_cs[i]) == 0){
+			return &mcp3208_model[i];
+		}
+	}
+
+	return NULL;
+}
+
+void sim_devices_readRtc(uint8_t *data, size_t len){
+	uint8_t regs[7];
+	struct tm tm;
+	time_t now = time(NULL);
+
+	localtime_r(&now, &tm);
+	regs[0] = toBcd(tm.tm_sec);
+	regs[1] = toBcd(tm.tm_min);
+	regs[2] = toBcd(tm.tm_hour);
+	regs[3] = toBcd(tm.tm_mday);
+	regs[4] = toBcd(tm.tm_wday);
+	regs[5] = toBcd(tm.tm_mon + 1);
+	regs[6] = toBcd(tm.tm_year % 100);
+
+	memcpy(data, regs, len < sizeof(regs) ? len : sizeof(regs));
+}
+
+/*****Private Functions*************************************************************/
+
+/**
+ * The first byte selects the register, bit 7 set for a read. Reads auto-increment the register address.
+ */
+static void bme280_transfer(void *ctx, const uint8_t *tx, uint8_t *rx, size_t len){
+	uint8_t reg;
+	size_t i;
+	double t;
+
+	if(bme280_loaded == 0){
+		bme280_load();
+	}
+	if(tx == NULL || len == 0){
+		memset(rx, 0, len);
+		return;
+	}
+
+	reg = tx[0] | 0x80;											//the registers are in the upper half, bit 7 selects read/write
+	rx[0] = 0;
+
+	if((tx[0] & 0x80) == 0){
+		for(i = 1; i + 1 <= len; i += 2){						//write: pairs of data and the next address
+			bme280_registers[reg] = tx[i];
+			if(i + 1 < len){
+				reg = tx[i + 1] | 0x80;
+			}
+		}
+		return;
+	}
+
+	if(reg == 0xF7){											//burst read of the measurement, update the values
+		t = esp_timer_get_time() / 1000000.0;
+		bme280_setRaw20(0xFA, BME280_SIM_ADC_T + (int32_t)(2000 * sin(t * 0.05)));
+		bme280_setRaw20(0xF7, BME280_SIM_ADC_P + (int32_t)(500 * sin(t * 0.03)));
+	}
+
+	for(i = 1; i < len; i++){
+		rx[i] = bme280_registers[(uint8_t)(reg + i - 1)];
+	}
+}
+
+/**
+ * Start bit, single/differential bit and D2 in the first byte, D1 and D0 in the upper bits of the second byte.
+ * The 12-bit result is returned in the lower nibble of the second and in the third byte.
+ */
+static void mcp3208_transfer(void *ctx, const uint8_t *tx, uint8_t *rx, size_t len){
+	int strip = (int)(intptr_t) ctx;
+	int channel;
+	double t;
+	uint16_t value;
+
+	memset(rx, 0, len);
+	if(tx == NULL || len < 3){
+		return;
+	}
+
+	channel = ((tx[0] & 0x01) << 2) | (tx[1] >> 6);
+	t = esp_timer_get_time() / 1000000.0;
+	value = (uint16_t)(2048 + 1500 * sin(2 * M_PI * t + (strip * 8 + channel) * 0.4));
+
+	rx[1] = (value >> 8) & 0x0F;
+	rx[2] = value & 0xFF;
+}
+
+/**
+ * Shifts out the current activity code, most significant byte first.
+ */
+static void gait_monitor_transfer(void *ctx, const uint8_t *tx, uint8_t *rx, size_t len){
+	double t = fmod(esp_timer_get_time() / 1000000.0, GAIT_SIM_WALKING_S + GAIT_SIM_STANDING_S);
+	double phase = fmod(t, GAIT_SIM_STRIDE_S) / GAIT_SIM_STRIDE_S;
+	uint32_t code;
+	size_t i;
+
+	if(t >= GAIT_SIM_WALKING_S){
+		code = BIONICS_ACTIVITY_STANDING;
+	}else if(phase < 0.12){
+		code = BIONICS_ACTIVITY_WALKING | BIONICS_ACTIVITY_HEELSTRIKE;
+	}else if(phase < 0.5){
+		code = BIONICS_ACTIVITY_WALKING | BIONICS_ACTIVITY_MIDSTANCE;
+	}else if(phase < 0.62){
+		code = BIONICS_ACTIVITY_WALKING | BIONICS_ACTIVITY_DOUBLE_LIMB_SUPPORT;
+	}else if(phase < 0.72){
+		code = BIONICS_ACTIVITY_WALKING | BIONICS_ACTIVITY_TOEOFF;
+	}else{
+		code = BIONICS_ACTIVITY_WALKING | BIONICS_ACTIVITY_MIDSWING;
+	}
+
+	for(i = 0; i < len; i++){
+		rx[i] = i < 4 ? (uint8_t)(code >> (24 - 8 * i)) : 0;
+	}
+}
+
+static void bme280_load(void){
+	static const uint8_t calibration[] = {
+		0x70, 0x6B,						//dig_T1 27504
+		0x43, 0x67,						//dig_T2 26435
+		0x18, 0xFC,						//dig_T3 -1000
+		0x7D, 0x8E,						//dig_P1 36477
+		0x43, 0xD6,						//dig_P2 -10685
+		0xD0, 0x0B,						//dig_P3 3024
+		0x27, 0x0B,						//dig_P4 2855
+		0x8C, 0x00,						//dig_P5 140
+		0xF9, 0xFF,						//dig_P6 -7
+		0x8C, 0x3C,						//dig_P7 15500
+		0xF8, 0xC6,						//dig_P8 -14600
+		0x70, 0x17,						//dig_P9 6000
+	};
+
+	memset(bme280_registers, 0, sizeof(bme280_registers));
+	memcpy(&bme280_registers[0x88], calibration, sizeof(calibration));
+	bme280_registers[0xA1] = 75;		//dig_H1
+	bme280_registers[0xE1] = 0x72;		//dig_H2 370
+	bme280_registers[0xE2] = 0x01;
+	bme280_registers[0xE3] = 0;			//dig_H3
+	bme280_registers[0xE4] = 0x13;		//dig_H4 313
+	bme280_registers[0xE5] = 0x29;		//dig_H4 (lower nibble), dig_H5 (upper nibble) 50
+	bme280_registers[0xE6] = 0x03;
+	bme280_registers[0xE7] = 30;		//dig_H6
+	bme280_registers[0xD0] = 0x60;		//chip id
+
+	bme280_setRaw20(0xFA, BME280_SIM_ADC_T);
+	bme280_setRaw20(0xF7, BME280_SIM_ADC_P);
+	bme280_registers[0xFD] = (BME280_SIM_ADC_H >> 8) & 0xFF;
+	bme280_registers[0xFE] = BME280_SIM_ADC_H & 0xFF;
+
+	bme280_loaded = 1;
+}
+
+/**
+ * Stores a 20-bit measurement in the msb, lsb and xlsb (bits 7:4) registers.
+ */
+static void bme280_setRaw20(uint8_t reg, int32_t value){
+	bme280_registers[reg] = (value >> 12) & 0xFF;
+	bme280_registers[reg + 1] = (value >> 4) & 0xFF;
+	bme280_registers[reg + 2] = (value & 0x0F) << 4;
+}
+
+static uint8_t toBcd(int value){
+	return (uint8_t)(((value / 10) << 4) | (value % 10));
+}
@@ -0,0 +1,247 @@
+/**
+ * @file spi_master.c
+ * @brief Host shim of the ESP-IDF SPI master driver.
+ *
+ * Transactions are executed synchronously against the simulated devices. For devices with a hardware chip select
+ * the device is selected by spics_io_num, otherwise the pre-transaction callback has to pull the chip select GPIO
+ * of the addressed device low (this is how the sensor strips are addressed).
+ * Queued transactions are executed when they are queued, their results are returned in order.
+ *
+ * @date October 17. 2026
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "esp_err.h"
+#include "driver/spi_master.h"
+#include "host_shims.h"
+#include "host_internal.h"
+
+#define SPI_SHIM_HOST_COUNT 3
+
+struct spi_device_t {
+	spi_host_device_t					host;
+	spi_device_interface_config_t		cfg;
+	spi_transaction_t					**results;		//transactions that have been queued but not collected yet
+	int									result_head;
+	int									result_count;
+};
+
+typedef struct {
+	pthread_mutex_t		lock;
+	pthread_cond_t		released;
+	spi_device_handle_t	owner;							//device that acquired the bus, NULL if the bus is free
+	uint8_t				initialized;
+} spi_bus_t;
+
+static spi_bus_t spi_bus[SPI_SHIM_HOST_COUNT] = {
+	{PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, 0},
+	{PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, 0},
+	{PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, 0},
+};
+
+static uint8_t spi_timing = 1;
+static host_spi_stats_t spi_stats;
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*****Private Functions Definitions*************************************************/
+
+static esp_err_t spi_execute(spi_device_handle_t handle, spi_transaction_t *trans_desc);
+static int64_t spi_now_ns(void);
+
+/*****Public Functions**************************************************************/
+
+void host_shims_setSpiTiming(uint8_t enabled){
+	spi_timing = enabled;
+}
+
+void host_shims_getSpiStatistics(host_spi_stats_t *stats){
+	pthread_mutex_lock(&stats_lock);
+	*stats = spi_stats;
+	pthread_mutex_unlock(&stats_lock);
+}
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *bus_config, int dma_chan){
+	if(host < 0 || host >= SPI_SHIM_HOST_COUNT){
+		return ESP_ERR_INVALID_ARG;
+	}
+	if(spi_bus[host].initialized){
+		return ESP_ERR_INVALID_STATE;
+	}
+	spi_bus[host].initialized = 1;
+
+	return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *dev_config, spi_device_handle_t *handle){
+	spi_device_handle_t dev;
+
+	if(host < 0 || host >= SPI_SHIM_HOST_COUNT || spi_bus[host].initialized == 0){
+		return ESP_ERR_INVALID_STATE;
+	}
+	if(dev_config->queue_size < 1){
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	dev = calloc(1, sizeof(struct spi_device_t));
+	if(dev == NULL){
+		return ESP_ERR_NO_MEM;
+	}
+	dev->results = calloc(dev_config->queue_size, sizeof(spi_transaction_t*));
+	if(dev->results == NULL){
+		free(dev);
+		return ESP_ERR_NO_MEM;
+	}
+	dev->host = host;
+	dev->cfg = *dev_config;
+
+	*handle = dev;
+
+	return ESP_OK;
+}
+
+esp_err_t spi_device_acquire_bus(spi_device_handle_t device, TickType_t wait){
+	spi_bus_t *bus = &spi_bus[device->host];
+
+	pthread_mutex_lock(&bus->lock);
+	while(bus->owner != NULL && bus->owner != device){
+		pthread_cond_wait(&bus->released, &bus->lock);
+	}
+	bus->owner = device;
+	pthread_mutex_unlock(&bus->lock);
+
+	return ESP_OK;
+}
+
+void spi_device_release_bus(spi_device_handle_t dev){
+	spi_bus_t *bus = &spi_bus[dev->host];
+
+	pthread_mutex_lock(&bus->lock);
+	if(bus->owner == dev){
+		bus->owner = NULL;
+		pthread_cond_broadcast(&bus->released);
+	}
+	pthread_mutex_unlock(&bus->lock);
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc){
+	return spi_execute(handle, trans_desc);
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc){
+	return spi_execute(handle, trans_desc);
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans_desc, TickType_t ticks_to_wait){
+	esp_err_t ret;
+
+	if(handle->result_count == handle->cfg.queue_size){
+		return ESP_ERR_TIMEOUT;										//nobody else collects the results, waiting would not help
+	}
+
+	ret = spi_execute(handle, trans_desc);
+	if(ret != ESP_OK){
+		return ret;
+	}
+
+	handle->results[(handle->result_head + handle->result_count) % handle->cfg.queue_size] = trans_desc;
+	handle->result_count++;
+
+	return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans_desc, TickType_t ticks_to_wait){
+
+	if(handle->result_count == 0){
+		return ESP_ERR_TIMEOUT;
+	}
+
+	*trans_desc = handle->results[handle->result_head];
+	handle->result_head = (handle->result_head + 1) % handle->cfg.queue_size;
+	handle->result_count--;
+
+	return ESP_OK;
+}
+
+/*****Private Functions*************************************************************/
+
+/**
+ * Executes one transaction, the bus is held for its duration (unless the device already acquired it).
+ */
+static esp_err_t spi_execute(spi_device_handle_t handle, spi_transaction_t *trans_desc){
+	spi_bus_t *bus = &spi_bus[handle->host];
+	const host_spi_model_t *model;
+	const uint8_t *tx;
+	uint8_t *rx;
+	uint8_t dummy[64];
+	size_t len;
+	uint8_t acquired = 0;
+	int64_t busy_ns = 0;
+	int64_t start;
+
+	len = (trans_desc->length + 7) / 8;
+	tx = (trans_desc->flags & SPI_TRANS_USE_TXDATA) ? trans_desc->tx_data : trans_desc->tx_buffer;
+	rx = (trans_desc->flags & SPI_TRANS_USE_RXDATA) ? trans_desc->rx_data : trans_desc->rx_buffer;
+	if(((trans_desc->flags & SPI_TRANS_USE_TXDATA) || (trans_desc->flags & SPI_TRANS_USE_RXDATA)) && len > 4){
+		return ESP_ERR_INVALID_ARG;
+	}
+	if(rx == NULL){
+		if(len > sizeof(dummy)){
+			return ESP_ERR_INVALID_SIZE;
+		}
+		rx = dummy;
+	}
+
+	pthread_mutex_lock(&bus->lock);
+	if(bus->owner != handle){
+		while(bus->owner != NULL){
+			pthread_cond_wait(&bus->released, &bus->lock);
+		}
+		bus->owner = handle;
+		acquired = 1;
+	}
+	pthread_mutex_unlock(&bus->lock);
+
+	if(handle->cfg.pre_cb != NULL){
+		handle->cfg.pre_cb(trans_desc);
+	}
+
+	start = spi_now_ns();
+	model = (handle->cfg.spics_io_num >= 0) ? sim_devices_find(handle->cfg.spics_io_num) : sim_devices_findSelected();
+	if(model != NULL){
+		model->transfer(model->ctx, tx, rx, len);
+	}else{
+		memset(rx, 0xFF, len);										//nobody drives MISO
+	}
+
+	if(spi_timing > 0 && handle->cfg.clock_speed_hz > 0){
+		busy_ns = (int64_t) len * 8 * 1000000000 / handle->cfg.clock_speed_hz;
+		while(spi_now_ns() - start < busy_ns);						//the wire time is too short to sleep
+	}
+
+	if(handle->cfg.post_cb != NULL){
+		handle->cfg.post_cb(trans_desc);
+	}
+
+	if(acquired){
+		spi_device_release_bus(handle);
+	}
+
+	pthread_mutex_lock(&stats_lock);
+	spi_stats.transactions++;
+	spi_stats.bytes += len;
+	spi_stats.bus_time_ns += busy_ns;
+	pthread_mutex_unlock(&stats_lock);
+
+	return ESP_OK;
+}
+
+static int64_t spi_now_ns(void){
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (int64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file vfs.c
+ * @brief Host shim of the FAT file system on the SD-card.
+ *
+ * Mounting the card maps its base path into a directory of the host. The file accesses of the firmware
+ * are redirected by vfs_shim.h, paths below the base path are only valid while the card is mounted.
+ *
+ * @date October 17. 2026
+ */
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <sys/types.h>
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_vfs_fat.h"
+#include "sdmmc_cmd.h"
+#include "host_shims.h"
+
+static const char *TAG = "VFS_SHIM";
+
+#define VFS_SHIM_PATH_MAX 512
+
+static char sdcard_root[VFS_SHIM_PATH_MAX] = "sdcard";
+static char base_path[32] = "";
+static sdmmc_card_t host_card;
+
+/*****Private Functions Definitions*************************************************/
+
+static const char *vfs_mapPath(const char *path, char *buffer, size_t size);
+
+/*****Public Functions**************************************************************/
+
+void host_shims_setSdCardRoot(const char *path){
+	strncpy(sdcard_root, path, sizeof(sdcard_root) - 1);
+}
+
+const char *host_shims_getSdCardRoot(void){
+	return sdcard_root;
+}
+
+esp_err_t esp_vfs_fat_sdmmc_mount(const char *path, const sdmmc_host_t *host_config, const void *slot_config,
+		const esp_vfs_fat_sdmmc_mount_config_t *mount_config, sdmmc_card_t **out_card){
+	struct statvfs fs;
+
+	if(base_path[0] != '\0'){
+		return ESP_ERR_INVALID_STATE;
+	}
+
+	if(mkdir(sdcard_root, 0755) != 0 && errno != EEXIST){
+		ESP_LOGE(TAG, "Can't create %s", sdcard_root);
+		return ESP_FAIL;
+	}
+
+	strncpy(base_path, path, sizeof(base_path) - 1);
+	memset(&host_card, 0, sizeof(host_card));
+	strcpy(host_card.name, "HOST");
+	if(statvfs(sdcard_root, &fs) == 0){
+		host_card.capacity = (uint64_t) fs.f_blocks * fs.f_frsize;
+	}
+	*out_card = &host_card;
+
+	ESP_LOGI(TAG, "%s is mapped to %s", base_path, sdcard_root);
+
+	return ESP_OK;
+}
+
+esp_err_t esp_vfs_fat_sdmmc_unmount(void){
+	if(base_path[0] == '\0'){
+		return ESP_ERR_INVALID_STATE;
+	}
+	base_path[0] = '\0';
+
+	return ESP_OK;
+}
+
+void sdmmc_card_print_info(FILE *stream, const sdmmc_card_t *card){
+	fprintf(stream, "Name: %s\n", card->name);
+	fprintf(stream, "Size: %lluMB\n", (unsigned long long)(card->capacity / (1024 * 1024)));
+}
+
+FILE *host_vfs_fopen(const char *path, const char *mode){
+	char buffer[VFS_SHIM_PATH_MAX];
+	const char *mapped = vfs_mapPath(path, buffer, sizeof(buffer));
+
+	return (mapped == NULL) ? NULL : fopen(mapped, mode);
+}
+
+int host_vfs_stat(const char *path, struct stat *buf){
+	char buffer[VFS_SHIM_PATH_MAX];
+	const char *mapped = vfs_mapPath(path, buffer, sizeof(buffer));
+
+	return (mapped == NULL) ? -1 : stat(mapped, buf);
+}
+
+int host_vfs_remove(const char *path){
+	char buffer[VFS_SHIM_PATH_MAX];
+	const char *mapped = vfs_mapPath(path, buffer, sizeof(buffer));
+
+	return (mapped == NULL) ? -1 : remove(mapped);
+}
+
+int host_vfs_unlink(const char *path){
+	char buffer[VFS_SHIM_PATH_MAX];
+	const char *mapped = vfs_mapPath(path, buffer, sizeof(buffer));
+
+	return (mapped == NULL) ? -1 : unlink(mapped);
+}
+
+int host_vfs_rename(const char *oldpath, const char *newpath){
+	char old_buffer[VFS_SHIM_PATH_MAX];
+	char new_buffer[VFS_SHIM_PATH_MAX];
+	const char *old_mapped = vfs_mapPath(oldpath, old_buffer, sizeof(old_buffer));
+	const char *new_mapped = vfs_mapPath(newpath, new_buffer, sizeof(new_buffer));
+
+	return (old_mapped == NULL || new_mapped == NULL) ? -1 : rename(old_mapped, new_mapped);
+}
+
+int host_vfs_mkdir(const char *path, mode_t mode){
+	char buffer[VFS_SHIM_PATH_MAX];
+	const char *mapped = vfs_mapPath(path, buffer, sizeof(buffer));
+
+	return (mapped == NULL) ? -1 : mkdir(mapped, mode);
+}
+
+DIR *host_vfs_opendir(const char *path){
+	char buffer[VFS_SHIM_PATH_MAX];
+	const char *mapped = vfs_mapPath(path, buffer, sizeof(buffer));
+
+	return (mapped == NULL) ? NULL : opendir(mapped);
+}
+
+/*****Private Functions*************************************************************/
+
+/**
+ * Maps a path below the base path of the card into the host directory, other paths are returned unchanged.
+ * Returns NULL (errno ENOENT) for paths on the card while it is not mounted.
+ */
+static const char *vfs_mapPath(const char *path, char *buffer, size_t size){
+	const char *card_prefix = "/sdcard";
+	const char *prefix = (base_path[0] != '\0') ? base_path : card_prefix;
+	size_t prefix_len = strlen(prefix);
+
+	if(strncmp(path, prefix, prefix_len) != 0 || (path[prefix_len] != '/' && path[prefix_len] != '\0')){
+		return path;
+	}
+
+	if(base_path[0] == '\0'){
+		errno = ENOENT;
+		return NULL;
+	}
+
+	snprintf(buffer, size, "%s%s", sdcard_root, &path[prefix_len]);
+
+	return buffer;
+}
@@ -3,8 +3,8 @@
  * @brief Header file of the application.
  *
  * This header file defines the pin mapping depending on the connected device (the device is selected in the main menuconfig settings of the IDF project).
- * The file further defines the data structure that holds all required sensor values, and it defines the OS queue used to send data from
- * the data collection component to the InfluxDB component.
+ * The file further defines the data structure that holds all required sensor values. Samples are passed from
+ * the data collection component to the InfluxDB component through the slots of the sample pool component.
  *
  * @author Matthias Becker
  * @date June 18. 2019
@@ -38,8 +38,64 @@
 #define PIN_NUM_SENSOR_CS4			GPIO_NUM_27		//!< Chip select pin of the sensor strip 4
 #define PIN_NUM_GAITMONITOR_CS		GPIO_NUM_16		//!< Chip select pin of the gait monitor
 
+/**
+ * @brief Number of bytes of the mask with one bit per sensor element.
+ */
+#define SOCKETSENSE_SENSEL_MASK_SIZE	((CONFIG_SOCKETSENSE_SENSOR_COUNT * CONFIG_SOCKETSENSE_SENSEL_COUNT + 7) / 8)
+
+/**
+ * @brief 1 if samples may leave out sensor elements: with the deadband (CONFIG_DATA_COLLECTOR_DEADBAND), or with a
+ * profile of the acquisition policy that sets a deadband at runtime (CONFIG_DATA_COLLECTOR_POLICY_REST_DEADBAND).
+ * The keyframe flag and the sensel_mask of each sample tell which sensor elements are reported.
+ */
+#define SOCKETSENSE_DEADBAND_ENABLED	(CONFIG_DATA_COLLECTOR_DEADBAND > 0 \
+		|| (CONFIG_DATA_COLLECTOR_POLICY == 1 && CONFIG_DATA_COLLECTOR_POLICY_REST_DEADBAND > 0))
+
+/**
+ * @brief Pressure features of the sensor elements over one summary window (see sensel_features.h).
+ *
+ * The values are in the unit of the sensor elements (ADC counts, or the unit of the calibration). The center of pressure
+ * is given on the sensor matrix, across the strips (strip index) and along them (sensel index).
+ */
+typedef struct {
+	uint32_t		samples;			/**< Number of samples of the window, 0 if no window ended before the sample. */
+	uint32_t		mean_load;			/**< Mean of the sum over all sensor elements. */
+	uint16_t		peak;				/**< Largest value of a sensor element in the window. */
+	uint8_t			peak_strip;			/**< Sensor strip of the peak. */
+	uint8_t			peak_sensel;		/**< Sensor element of the peak. */
+	uint16_t		cop_strip;			/**< Center of pressure across the strips, in 1/256 strip. */
+	uint16_t		cop_sensel;			/**< Center of pressure along the strips, in 1/256 sensor element. */
+	uint16_t		load_share[CONFIG_SOCKETSENSE_SENSOR_COUNT];	/**< Share of the load carried by each strip, in 0.01 %. */
+	uint32_t		cost_avg_ns;		/**< Mean time of the feature extraction per sample in ns. */
+	uint32_t		cost_max_ns;		/**< Longest feature extraction of a sample in ns. */
+} SocketSense_Features_t;
+
+/**
+ * @brief Number of bins of the exposure histograms, each covers 4096 / SOCKETSENSE_EXPOSURE_BINS values.
+ */
+#define SOCKETSENSE_EXPOSURE_BINS		8
+
+/**
+ * @brief Cumulative pressure exposure of every sensor element (see sensel_exposure.h).
+ *
+ * The values are in the unit of the sensor elements (ADC counts, or the unit of the calibration), times in ms.
+ */
+typedef struct {
+	uint64_t		start_usec;			/**< UNIX timestamp in us of the first sample of the accumulators. */
+	uint64_t		timestamp_usec;		/**< UNIX timestamp in us of the last sample of the accumulators. */
+	uint64_t		duration_ms;		/**< Time covered by the samples. */
+	uint64_t		integral[CONFIG_SOCKETSENSE_SENSOR_COUNT][CONFIG_SOCKETSENSE_SENSEL_COUNT];	/**< Pressure-time integral in value * ms. */
+	uint64_t		above_ms[CONFIG_SOCKETSENSE_SENSOR_COUNT][CONFIG_SOCKETSENSE_SENSEL_COUNT];	/**< Time above the threshold. */
+	uint32_t		histogram[CONFIG_SOCKETSENSE_SENSOR_COUNT][CONFIG_SOCKETSENSE_SENSEL_COUNT][SOCKETSENSE_EXPOSURE_BINS];	/**< Time in each bin, saturates after 49 days. */
+	uint16_t		threshold;			/**< Threshold of above_ms. */
+	uint8_t			busy;				/**< Set while a snapshot is handed over to the database component. */
+} SocketSense_Exposure_t;
+
 /**
  * @brief This type represents all data included in one SocketSense sample.
+ *
+ * With the deadband enabled (SOCKETSENSE_DEADBAND_ENABLED), sensorstrip_data holds the last reported value of the
+ * sensor elements that did not move beyond the deadband, and only the sensor elements set in sensel_mask are reported.
  */
 typedef struct {
 	uint64_t		timestamp_usec;		/**< UNIX timestamp in us associated with the start of the data collection for this sample.*/
@@ -47,12 +103,12 @@ typedef struct {
 	uint16_t 		sensorstrip_data[CONFIG_SOCKETSENSE_SENSOR_COUNT][CONFIG_SOCKETSENSE_SENSEL_COUNT];
 	uint32_t		sampling_time;		/**< Time in us it took to record the data */
 	uint32_t 		battery_voltage;	/**< Last read battery voltage in mV*/
+	uint32_t		activity;			/**< Activity and gait phase of the gait monitor (BIONICS_ACTIVITY_*), 0 (unknown) without it. */
+	uint8_t			keyframe;			/**< 1 if all sensor elements are reported. */
+	uint8_t			sensel_mask[SOCKETSENSE_SENSEL_MASK_SIZE];	/**< Bit i (strip * sensels + sensel) is set if sensor element i is reported. */
+	SocketSense_Features_t	features;	/**< Summary of the window that ended before this sample, see CONFIG_DATA_COLLECTOR_FEATURES. */
+	uint8_t			summary_only;		/**< 1 if only the summary is reported, not the sensor elements. */
+	SocketSense_Exposure_t	*exposure;	/**< Snapshot of the exposure, NULL for most samples, see CONFIG_DATA_COLLECTOR_EXPOSURE. */
 } SocketSense_Sample_t;
 
-/**
- * @brief The queue that is used to send data to the database task.
- */
-QueueHandle_t data_queue;
-
-
 #endif /* MAIN_INCLUDE_KTHSOCKETSENSE_H_ */
@@ -53,11 +53,11 @@ esp_err_t event_handler(void *ctx, system_event_t *event)
 			wifi_active = 1;
 			gpio_set_level(PIN_NUM_LED_GREEN, 1);						//turn on the green LED to signal that an IP has been assigned
 			influxdb_enable();											//once the IP has been assigned the remote database can be accessed
-			data_collector_start();										//now that the wifi connection is setup we can start the data collection
 
 			break;
 		case SYSTEM_EVENT_STA_DISCONNECTED:
 			wifi_active = 0;											//start blinking the green LED if the IP was lost
+			influxdb_disable();											//keep logging to the SD-card only until the IP is assigned again
 			ESP_ERROR_CHECK( esp_wifi_connect() );
 			break;
 		default:
@@ -114,13 +114,19 @@ void app_main(void)
 
     sd_load_configuration(sta_config.sta.ssid, sta_config.sta.password, uid);	//try to load the configuration from the SD-card
 
+	data_collector_init();												//initialize the data collection component, this does not start a task yet!
+	influxdb_init(uid);													//initialize the influxDB component, this does not start the task yet!
+	influxdb_start();													//start receiving samples, they are logged to the SD-card until the network is attached
+	data_collector_start();												//the data collection does not depend on the network connection
+	if(data_collector_resume() == ESP_OK){								//start measuring right away, button 1 stops and resumes
+		gpio_set_level(PIN_NUM_LED_RED, 1);
+		measuring = 1;
+	}
+
     ESP_ERROR_CHECK( esp_wifi_set_config(WIFI_IF_STA, &sta_config) );
     ESP_ERROR_CHECK( esp_wifi_start() );
     ESP_ERROR_CHECK( esp_wifi_connect() );
 
-	data_collector_init();												//initialize the data collection component, this does not start a task yet!
-	influxdb_init(uid);													//initialize the influxDB component, this does not start the task yet!
-
     while (true) {														//from here on all happens in the created tasks and this part only toggles the blue LED
         if(wifi_active == 0){
         	gpio_set_level(PIN_NUM_LED_GREEN, led_level);
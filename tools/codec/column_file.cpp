@@ -0,0 +1,320 @@
+/**
+ * @file column_file.cpp
+ * @brief Reads column log-files with the index, see column_file.h.
+ *
+ * @date October 17. 2026
+ */
+#include "column_file.h"
+
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace socketsense {
+
+ColumnFile::~ColumnFile()
+{
+	if(fd_ >= 0){
+		::close(fd_);
+	}
+}
+
+bool ColumnFile::open(const std::string &path, bool use_index)
+{
+	struct stat info;
+
+	fd_ = ::open(path.c_str(), O_RDONLY);
+	if(fd_ < 0 || fstat(fd_, &info) != 0){
+		return false;
+	}
+	size_ = static_cast<uint64_t>(info.st_size);
+
+	if(!use_index){
+		scanForward(0, size_);
+		return true;
+	}
+
+	uint64_t end = size_;
+	uint64_t offset;
+	column_log_header_t header;
+	while(findLast(end, offset, header)){											//one recording of the device per pass
+		uint64_t index = header.type == COLUMN_LOG_TYPE_INDEX ? offset : header.previous_index;
+		std::vector<Extent> extents;
+		uint64_t lowest = index <= offset ? readChain(index, end, extents) : UINT64_MAX;
+
+		if(lowest == UINT64_MAX){													//no index yet, step back block by block
+			if(header.type == COLUMN_LOG_TYPE_SAMPLES){
+				addBlock(offset, header, false);
+			}
+			end = offset;
+			continue;
+		}
+
+		std::sort(extents.begin(), extents.end(), [](const Extent &a, const Extent &b) { return a.offset < b.offset; });
+		uint64_t pos = lowest;
+		for(const auto &extent : extents){											//blocks whose index block was lost
+			if(extent.offset > pos){
+				scanForward(pos, extent.offset);
+			}
+			pos = std::max(pos, extent.offset + extent.length);
+		}
+		if(pos < end){																//blocks after the last index block
+			scanForward(pos, end);
+		}
+		end = lowest;
+	}
+
+	std::sort(blocks_.begin(), blocks_.end(), [](const ColumnBlock &a, const ColumnBlock &b) { return a.offset < b.offset; });
+	blocks_.erase(std::unique(blocks_.begin(), blocks_.end(),
+			[](const ColumnBlock &a, const ColumnBlock &b) { return a.offset == b.offset; }), blocks_.end());
+
+	return true;
+}
+
+std::vector<ColumnBlock> ColumnFile::findRange(uint64_t start_us, uint64_t end_us) const
+{
+	std::vector<ColumnBlock> range;
+
+	for(const auto &block : blocks_){											//the clock may jump back after a reset
+		if(block.max_timestamp_us >= start_us && block.min_timestamp_us <= end_us){
+			range.push_back(block);
+		}
+	}
+
+	return range;
+}
+
+bool ColumnFile::readBlock(const ColumnBlock &block, std::vector<uint8_t> &data, column_log_header_t &header)
+{
+	data.resize(block.length);
+	if(block.length < COLUMN_LOG_HEADER_SIZE + COLUMN_LOG_MARKER_SIZE || !readAt(block.offset, data.data(), data.size())){
+		return false;
+	}
+
+	return column_log_parseHeader(data.data(), data.size(), &header) == COLUMN_LOG_OK
+			&& header.type == COLUMN_LOG_TYPE_SAMPLES && header.length == block.length
+			&& column_log_checkMarker(data.data() + header.length - COLUMN_LOG_MARKER_SIZE, &header) == COLUMN_LOG_OK;
+}
+
+bool ColumnFile::readAt(uint64_t offset, void *dst, size_t length)
+{
+	uint8_t *pos = static_cast<uint8_t *>(dst);
+
+	stats_.reads++;
+	stats_.bytes_read += length;
+	while(length > 0){
+		ssize_t result = pread(fd_, pos, length, static_cast<off_t>(offset));
+		if(result <= 0){
+			return false;
+		}
+		pos += result;
+		offset += static_cast<uint64_t>(result);
+		length -= static_cast<size_t>(result);
+	}
+
+	return true;
+}
+
+/**
+ * Reads the header and the marker of a block, the block has to end before end.
+ */
+bool ColumnFile::probe(uint64_t offset, uint64_t end, column_log_header_t &header)
+{
+	uint8_t data[COLUMN_LOG_HEADER_SIZE];
+	uint8_t marker[COLUMN_LOG_MARKER_SIZE];
+
+	if(offset + COLUMN_LOG_HEADER_SIZE + COLUMN_LOG_MARKER_SIZE > end || !readAt(offset, data, sizeof(data))
+			|| column_log_parseHeader(data, sizeof(data), &header) != COLUMN_LOG_OK || offset + header.length > end){
+		return false;
+	}
+
+	return readAt(offset + header.length - COLUMN_LOG_MARKER_SIZE, marker, sizeof(marker))
+			&& column_log_checkMarker(marker, &header) == COLUMN_LOG_OK;
+}
+
+/**
+ * Searches the last complete block before end backwards on the block boundaries.
+ */
+bool ColumnFile::findLast(uint64_t end, uint64_t &offset, column_log_header_t &header)
+{
+	if(end < COLUMN_LOG_HEADER_SIZE + COLUMN_LOG_MARKER_SIZE){
+		return false;
+	}
+
+	offset = (end - COLUMN_LOG_HEADER_SIZE - COLUMN_LOG_MARKER_SIZE) / COLUMN_LOG_ALIGNMENT * COLUMN_LOG_ALIGNMENT;
+	while(!probe(offset, end, header)){
+		if(offset == 0){
+			return false;
+		}
+		offset -= COLUMN_LOG_ALIGNMENT;
+	}
+
+	return true;
+}
+
+/**
+ * Adds the samples blocks in [begin, end) by reading their headers, invalid regions are skipped boundary by boundary.
+ */
+void ColumnFile::scanForward(uint64_t begin, uint64_t end)
+{
+	uint64_t offset = (begin + COLUMN_LOG_ALIGNMENT - 1) / COLUMN_LOG_ALIGNMENT * COLUMN_LOG_ALIGNMENT;
+	column_log_header_t header;
+
+	while(offset + COLUMN_LOG_HEADER_SIZE + COLUMN_LOG_MARKER_SIZE <= end){
+		if(!probe(offset, end, header)){
+			offset += COLUMN_LOG_ALIGNMENT;
+			continue;
+		}
+		if(header.type == COLUMN_LOG_TYPE_SAMPLES){
+			addBlock(offset, header, false);
+		}
+		offset += header.length;
+	}
+}
+
+/**
+ * Follows the chain of index blocks, returns the lowest offset covered by it or UINT64_MAX if the first index block
+ * is not valid. The index blocks and the blocks they list are added to extents.
+ */
+uint64_t ColumnFile::readChain(uint64_t index, uint64_t end, std::vector<Extent> &extents)
+{
+	uint64_t lowest = UINT64_MAX;
+	std::vector<uint8_t> data;
+	column_log_header_t header;
+
+	while(index != COLUMN_LOG_NO_INDEX && index < end){
+		if(!probe(index, end, header) || header.type != COLUMN_LOG_TYPE_INDEX){
+			break;
+		}
+		data.resize(header.length);
+		if(!readAt(index, data.data(), data.size())){
+			break;
+		}
+		stats_.index_blocks++;
+		extents.push_back({index, header.length});
+		lowest = std::min(lowest, index);
+
+		const uint32_t sensels = static_cast<uint32_t>(header.sensor_count) * header.sensel_count;
+		for(uint32_t i = 0; i < header.count; i++){
+			column_log_entry_t entry;
+			column_log_readEntry(data.data(), i, &entry);
+			if(entry.offset >= index || entry.offset % COLUMN_LOG_ALIGNMENT != 0 || entry.samples == 0){
+				continue;
+			}
+			ColumnBlock block;
+			block.offset = entry.offset;
+			block.length = COLUMN_LOG_BLOCK_LENGTH(static_cast<uint64_t>(entry.samples), sensels);
+			block.min_timestamp_us = entry.min_timestamp_us;
+			block.max_timestamp_us = entry.max_timestamp_us;
+			block.samples = entry.samples;
+			block.indexed = true;
+			blocks_.push_back(block);
+			extents.push_back({block.offset, block.length});
+			lowest = std::min(lowest, block.offset);
+		}
+
+		end = index;
+		index = header.previous_index;
+	}
+
+	return lowest;
+}
+
+void ColumnFile::addBlock(uint64_t offset, const column_log_header_t &header, bool indexed)
+{
+	ColumnBlock block;
+
+	block.offset = offset;
+	block.length = header.length;
+	block.min_timestamp_us = header.min_timestamp_us;
+	block.max_timestamp_us = header.max_timestamp_us;
+	block.samples = header.count;
+	block.indexed = indexed;
+	blocks_.push_back(block);
+	if(!indexed){
+		stats_.scanned_blocks++;
+	}
+}
+
+ColumnWriter::~ColumnWriter()
+{
+	if(file_ != nullptr){
+		std::fclose(file_);
+	}
+}
+
+bool ColumnWriter::open(const std::string &path, uint8_t sensor_count, uint8_t sensel_count, uint32_t block_samples,
+		uint32_t index_interval)
+{
+	buffer_.resize(COLUMN_LOG_BLOCK_LENGTH(static_cast<size_t>(block_samples), static_cast<size_t>(sensor_count) * sensel_count));
+	index_.resize(COLUMN_LOG_INDEX_LENGTH(static_cast<size_t>(index_interval)));
+	entries_.reserve(index_interval);
+	index_interval_ = index_interval;
+	if(index_interval == 0 || column_log_init(&block_, buffer_.data(), buffer_.size(), block_samples, sensor_count,
+			sensel_count) != COLUMN_LOG_OK){
+		return false;
+	}
+
+	file_ = std::fopen(path.c_str(), "wb");
+	return file_ != nullptr;
+}
+
+bool ColumnWriter::append(const sample_frame_point_t &point)
+{
+	column_log_append(&block_, &point);
+	if(block_.samples == block_.max_samples){
+		return writeBlock();
+	}
+
+	return ok_;
+}
+
+bool ColumnWriter::close()
+{
+	if(file_ == nullptr){
+		return false;
+	}
+	writeBlock();
+	if(!entries_.empty()){
+		writeIndex();
+	}
+	ok_ = std::fclose(file_) == 0 && ok_;
+	file_ = nullptr;
+
+	return ok_;
+}
+
+bool ColumnWriter::writeBlock()
+{
+	if(block_.samples == 0){
+		return ok_;
+	}
+
+	size_t length = column_log_finish(&block_, sequence_++, last_index_);
+	ok_ = std::fwrite(buffer_.data(), 1, length, file_) == length && ok_;
+	entries_.push_back({offset_, block_.min_timestamp_us, block_.max_timestamp_us, block_.samples});
+	offset_ += length;
+	blocks_++;
+	column_log_clear(&block_);
+
+	if(entries_.size() == index_interval_){
+		writeIndex();
+	}
+
+	return ok_;
+}
+
+bool ColumnWriter::writeIndex()
+{
+	size_t length = column_log_writeIndex(index_.data(), index_.size(), entries_.data(),
+			static_cast<uint32_t>(entries_.size()), block_.sensor_count, block_.sensel_count, sequence_++, last_index_);
+	ok_ = std::fwrite(index_.data(), 1, length, file_) == length && ok_;
+	last_index_ = offset_;
+	offset_ += length;
+	entries_.clear();
+
+	return ok_;
+}
+
+} // namespace socketsense
@@ -0,0 +1,171 @@
+/**
+ * @file column_file.h
+ * @brief Reads column log-files (column_log.h) with the index, so only the blocks of a time range are read.
+ *
+ * The index is rebuilt from the end of the file: the last complete block is searched backwards on the block
+ * boundaries, then the chain of index blocks is followed to the start of the recording. Samples blocks that no index
+ * block covers (after the last index, or after a reset of the device) are found by reading the block headers only.
+ * A block cut off by a reset or a corrupted region is skipped. ColumnWriter writes log-files the way the firmware does.
+ *
+ * @date October 17. 2026
+ */
+#ifndef TOOLS_CODEC_COLUMN_FILE_H_
+#define TOOLS_CODEC_COLUMN_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "column_log.h"
+
+namespace socketsense {
+
+/**
+ * @brief Position and time range of one samples block.
+ */
+struct ColumnBlock {
+	uint64_t offset = 0;			//!< Offset of the block in the log-file
+	uint64_t length = 0;			//!< Length of the block in bytes
+	uint64_t min_timestamp_us = 0;	//!< Smallest timestamp of the block
+	uint64_t max_timestamp_us = 0;	//!< Largest timestamp of the block
+	uint32_t samples = 0;			//!< Number of samples of the block
+	bool indexed = false;			//!< True if the block was found in an index block, false if by scanning
+};
+
+/**
+ * @brief A column log-file opened for reading.
+ */
+class ColumnFile {
+public:
+	/**
+	 * @brief Read statistics, to compare the indexed access with a full scan.
+	 */
+	struct Statistics {
+		uint64_t reads = 0;				//!< Number of read calls
+		uint64_t bytes_read = 0;		//!< Number of bytes read
+		uint32_t index_blocks = 0;		//!< Number of index blocks that were read
+		uint32_t scanned_blocks = 0;	//!< Number of samples blocks found by scanning
+	};
+
+	ColumnFile() = default;
+	ColumnFile(const ColumnFile &) = delete;
+	ColumnFile &operator=(const ColumnFile &) = delete;
+	~ColumnFile();
+
+	/**
+	 * @brief Opens the file and builds the block list.
+	 *
+	 * @param path Path of the log-file.
+	 * @param use_index False to find the blocks by scanning all block headers from the start instead.
+	 * @return False if the file can't be opened.
+	 */
+	bool open(const std::string &path, bool use_index = true);
+
+	/**
+	 * @brief All samples blocks ordered by their offset.
+	 */
+	const std::vector<ColumnBlock> &blocks() const { return blocks_; }
+
+	/**
+	 * @brief The samples blocks that may hold timestamps in [start_us, end_us], ordered by their offset.
+	 */
+	std::vector<ColumnBlock> findRange(uint64_t start_us, uint64_t end_us) const;
+
+	/**
+	 * @brief Reads and checks one samples block.
+	 *
+	 * @param block The block.
+	 * @param data Destination of the whole block.
+	 * @param header Destination of the parsed header.
+	 * @return False if the block can't be read or is not valid.
+	 */
+	bool readBlock(const ColumnBlock &block, std::vector<uint8_t> &data, column_log_header_t &header);
+
+	/**
+	 * @brief Size of the file in bytes.
+	 */
+	uint64_t size() const { return size_; }
+
+	const Statistics &statistics() const { return stats_; }
+
+private:
+	struct Extent {
+		uint64_t offset;
+		uint64_t length;
+	};
+
+	bool readAt(uint64_t offset, void *dst, size_t length);
+	bool probe(uint64_t offset, uint64_t end, column_log_header_t &header);
+	bool findLast(uint64_t end, uint64_t &offset, column_log_header_t &header);
+	void scanForward(uint64_t begin, uint64_t end);
+	uint64_t readChain(uint64_t index, uint64_t end, std::vector<Extent> &extents);
+	void addBlock(uint64_t offset, const column_log_header_t &header, bool indexed);
+
+	int fd_ = -1;
+	uint64_t size_ = 0;
+	std::vector<ColumnBlock> blocks_;
+	Statistics stats_;
+};
+
+/**
+ * @brief Writes a column log-file, with an index block every index_interval blocks and at the end.
+ */
+class ColumnWriter {
+public:
+	ColumnWriter() = default;
+	ColumnWriter(const ColumnWriter &) = delete;
+	ColumnWriter &operator=(const ColumnWriter &) = delete;
+	~ColumnWriter();
+
+	/**
+	 * @brief Creates the log-file.
+	 *
+	 * @param path Path of the log-file.
+	 * @param sensor_count Number of sensor strips of every sample.
+	 * @param sensel_count Number of sensor elements per strip.
+	 * @param block_samples Number of samples per block.
+	 * @param index_interval Number of samples blocks per index block.
+	 * @return False if the file can't be created or the geometry is not supported.
+	 */
+	bool open(const std::string &path, uint8_t sensor_count, uint8_t sensel_count, uint32_t block_samples,
+			uint32_t index_interval);
+
+	/**
+	 * @brief Appends one sample, a full block is written right away.
+	 *
+	 * @return False if writing failed.
+	 */
+	bool append(const sample_frame_point_t &point);
+
+	/**
+	 * @brief Writes the last block and index block and closes the file.
+	 *
+	 * @return False if writing failed.
+	 */
+	bool close();
+
+	uint64_t bytes() const { return offset_; }
+	size_t blocks() const { return blocks_; }
+
+private:
+	bool writeBlock();
+	bool writeIndex();
+
+	FILE *file_ = nullptr;
+	std::vector<uint8_t> buffer_;
+	std::vector<uint8_t> index_;
+	std::vector<column_log_entry_t> entries_;
+	column_log_block_t block_{};
+	uint32_t index_interval_ = 0;
+	uint64_t offset_ = 0;
+	uint64_t last_index_ = COLUMN_LOG_NO_INDEX;
+	uint32_t sequence_ = 0;
+	size_t blocks_ = 0;
+	bool ok_ = true;
+};
+
+} // namespace socketsense
+
+#endif /* TOOLS_CODEC_COLUMN_FILE_H_ */
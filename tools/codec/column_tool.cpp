@@ -0,0 +1,286 @@
+/**
+ * @file column_tool.cpp
+ * @brief Extracts time ranges from column log-files and converts recordings to the column log format.
+ *
+ *   column_tool info [-f] <file.col>
+ *       Lists the blocks of a log-file (CONFIG_SD_LOGGING_FORMAT == 2) and how many reads it took to find them.
+ *
+ *   column_tool extract [-f] [-u uid] [-s start us] [-e end us] <file.col>
+ *       Writes the samples with a timestamp in [start, end] as line protocol to stdout. Only the blocks that overlap
+ *       the range are read; the number of blocks and bytes read and the time it took are reported to stderr.
+ *       With -f the blocks are found by scanning all block headers instead of with the index, for comparison.
+ *
+ *   column_tool convert [-b samples per block] [-i blocks per index] <recording.txt> <file.col>
+ *       Writes a line protocol log-file in the column log format, the way the firmware does. The log-file is read back
+ *       and its samples written as line protocol have to give the lines of the recording byte for byte.
+ *
+ * @date October 17. 2026
+ */
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "column_log.h"
+#include "column_file.h"
+#include "line_parser.h"
+#include "line_writer.h"
+
+using namespace socketsense;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+int info(const char *path, bool use_index)
+{
+	ColumnFile file;
+	auto start = Clock::now();
+	if(!file.open(path, use_index)){
+		std::fprintf(stderr, "Can't open %s\n", path);
+		return 1;
+	}
+	double open_time = seconds(start);
+
+	uint64_t samples = 0;
+	uint64_t first = UINT64_MAX;
+	uint64_t last = 0;
+	for(const auto &block : file.blocks()){
+		samples += block.samples;
+		first = std::min(first, block.min_timestamp_us);
+		last = std::max(last, block.max_timestamp_us);
+	}
+	const auto &stats = file.statistics();
+
+	std::printf("%s: %" PRIu64 " bytes, %zu samples blocks (%u found by scanning), %u index blocks, %" PRIu64 " samples\n",
+			path, file.size(), file.blocks().size(), stats.scanned_blocks, stats.index_blocks, samples);
+	if(samples > 0){
+		std::printf("timestamps %" PRIu64 " to %" PRIu64 " (%.1f s)\n", first, last, (last - first) / 1e6);
+	}
+	std::printf("blocks found with %" PRIu64 " reads of %" PRIu64 " bytes in %.2f ms\n",
+			stats.reads, stats.bytes_read, open_time * 1e3);
+
+	return 0;
+}
+
+int extract(const char *path, bool use_index, const std::string &uid, uint64_t start_us, uint64_t end_us)
+{
+	ColumnFile file;
+	auto start = Clock::now();
+	if(!file.open(path, use_index)){
+		std::fprintf(stderr, "Can't open %s\n", path);
+		return 1;
+	}
+
+	std::vector<ColumnBlock> range = file.findRange(start_us, end_us);
+	std::vector<uint8_t> data;
+	std::vector<uint16_t> sensels(COLUMN_LOG_MAX_SENSELS);
+	column_log_header_t header;
+	sample_frame_point_t point;
+	LineWriter writer;
+	std::string lines;
+	size_t samples = 0;
+	size_t invalid = 0;
+
+	writer.setDevice(uid);
+	for(const auto &block : range){
+		if(!file.readBlock(block, data, header)){
+			std::fprintf(stderr, "Invalid block at offset %" PRIu64 ", skipping\n", block.offset);
+			invalid++;
+			continue;
+		}
+
+		const uint8_t *timestamps = data.data() + column_log_columnOffset(&header, COLUMN_LOG_COLUMN_TIMESTAMP);
+		lines.clear();
+		for(uint32_t i = 0; i < header.count; i++){							//only the timestamp column is read for the others
+			uint64_t timestamp;
+			std::memcpy(&timestamp, timestamps + i * sizeof(uint64_t), sizeof(uint64_t));
+			if(timestamp < start_us || timestamp > end_us){
+				continue;
+			}
+			column_log_readPoint(data.data(), &header, i, &point, sensels.data());
+			writer.append(lines, point, header.sensor_count, header.sensel_count);
+			samples++;
+		}
+		std::fwrite(lines.data(), 1, lines.size(), stdout);
+	}
+	double time = seconds(start);
+
+	const auto &stats = file.statistics();
+	std::fprintf(stderr, "%zu samples from %zu of %zu blocks (%zu invalid), read %" PRIu64 " of %" PRIu64
+			" bytes (%.2f%%) in %" PRIu64 " reads, %.2f ms\n",
+			samples, range.size(), file.blocks().size(), invalid, stats.bytes_read, file.size(),
+			file.size() > 0 ? 100.0 * stats.bytes_read / file.size() : 0.0, stats.reads, time * 1e3);
+
+	return invalid == 0 ? 0 : 1;
+}
+
+/**
+ * Reads all samples of a converted log-file and compares them as line protocol with the lines of the recording.
+ * Lines with other tags or fields than a point, or that only carry some sensor elements (deadband) are not compared,
+ * the column log holds all sensor elements of every sample.
+ */
+bool verify(const char *path, const std::vector<ParsedLine> &points)
+{
+	ColumnFile file;
+	if(!file.open(path)){
+		std::fprintf(stderr, "Can't open %s\n", path);
+		return false;
+	}
+
+	std::vector<uint8_t> data;
+	std::vector<uint16_t> sensels(COLUMN_LOG_MAX_SENSELS);
+	column_log_header_t header;
+	sample_frame_point_t point;
+	LineWriter writer;
+	std::string device;
+	std::string text;
+	size_t index = 0;
+	size_t compared = 0;
+	size_t mismatches = 0;
+
+	for(const auto &block : file.blocks()){
+		if(!file.readBlock(block, data, header)){
+			std::fprintf(stderr, "Invalid block at offset %" PRIu64 "\n", block.offset);
+			return false;
+		}
+		for(uint32_t i = 0; i < header.count && index < points.size(); i++){
+			const ParsedLine &line = points[index++];
+			if(line.extra || !line.sensel_mask.empty()){
+				continue;
+			}
+			column_log_readPoint(data.data(), &header, i, &point, sensels.data());
+			if(line.device != device){
+				device = line.device;
+				writer.setDevice(device);
+			}
+			text.clear();
+			writer.append(text, point, header.sensor_count, header.sensel_count);
+			if(text.size() != line.text_length + 1 || std::memcmp(text.data(), line.text, line.text_length) != 0){
+				if(mismatches++ == 0){
+					std::fprintf(stderr, "recording: %.*s\nextracted: %s", static_cast<int>(line.text_length), line.text,
+							text.c_str());
+				}
+			}
+			compared++;
+		}
+	}
+
+	std::printf("%zu of %zu lines extracted again byte for byte, %zu differ (%zu have fields or sensels the column log does not carry)\n",
+			compared - mismatches, points.size(), mismatches, points.size() - compared);
+	if(index != points.size()){
+		std::fprintf(stderr, "%zu of %zu samples read back\n", index, points.size());
+		return false;
+	}
+	if(mismatches != 0){
+		std::fprintf(stderr, "%zu of %zu lines differ from the recording after the round trip\n", mismatches, compared);
+		return false;
+	}
+
+	return true;
+}
+
+int convert(const char *source, const char *destination, uint32_t block_samples, uint32_t index_interval)
+{
+	std::ifstream input(source, std::ios::binary);
+	if(!input){
+		std::fprintf(stderr, "Can't open %s\n", source);
+		return 1;
+	}
+	std::string content((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+	std::vector<ParsedLine> points = parseRecording(content.data(), content.size(), nullptr);
+	if(points.empty()){
+		std::fprintf(stderr, "No points in %s\n", source);
+		return 1;
+	}
+
+	ColumnWriter writer;
+	if(!writer.open(destination, points[0].sensor_count, points[0].sensel_count, block_samples, index_interval)){
+		std::fprintf(stderr, "Can't write %s\n", destination);
+		return 1;
+	}
+	bool ok = true;
+	for(const auto &line : points){
+		ok = writer.append(line.point) && ok;
+	}
+	ok = writer.close() && ok;
+
+	std::printf("%zu samples in %zu blocks, %" PRIu64 " bytes (%.1f bytes/sample, %.1f bytes/sample as text)\n",
+			points.size(), writer.blocks(), writer.bytes(), static_cast<double>(writer.bytes()) / points.size(),
+			static_cast<double>(content.size()) / points.size());
+
+	return ok && verify(destination, points) ? 0 : 1;
+}
+
+void usage(const char *name)
+{
+	std::fprintf(stderr, "Usage: %s info [-f] <file.col>\n"
+			"       %s extract [-f] [-u uid] [-s start us] [-e end us] <file.col>\n"
+			"       %s convert [-b samples per block] [-i blocks per index] <recording.txt> <file.col>\n",
+			name, name, name);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	std::string uid;
+	bool use_index = true;
+	uint64_t start_us = 0;
+	uint64_t end_us = UINT64_MAX;
+	unsigned long block_samples = 128;
+	unsigned long index_interval = 64;
+	int opt;
+
+	if(argc < 2){
+		usage(argv[0]);
+		return 1;
+	}
+	std::string command = argv[1];
+	optind = 2;
+
+	while((opt = getopt(argc, argv, "fu:s:e:b:i:")) != -1){
+		switch(opt){
+			case 'f': use_index = false; break;
+			case 'u': uid = optarg; break;
+			case 's': start_us = std::strtoull(optarg, nullptr, 10); break;
+			case 'e': end_us = std::strtoull(optarg, nullptr, 10); break;
+			case 'b': block_samples = std::strtoul(optarg, nullptr, 10); break;
+			case 'i': index_interval = std::strtoul(optarg, nullptr, 10); break;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+	const int files = command == "convert" ? 2 : 1;
+	if(optind + files != argc || block_samples == 0 || block_samples > 65536 || index_interval == 0
+			|| index_interval > 65536){
+		usage(argv[0]);
+		return 1;
+	}
+
+	if(command == "info"){
+		return info(argv[optind], use_index);
+	}
+	if(command == "extract"){
+		return extract(argv[optind], use_index, uid, start_us, end_us);
+	}
+	if(command == "convert"){
+		return convert(argv[optind], argv[optind + 1], static_cast<uint32_t>(block_samples),
+				static_cast<uint32_t>(index_interval));
+	}
+
+	usage(argv[0]);
+	return 1;
+}
@@ -0,0 +1,322 @@
+/**
+ * @file frame_tool.cpp
+ * @brief Converts sample frame log-files to line protocol and measures the frame codecs on recordings.
+ *
+ *   frame_tool decode [-u uid] <file.sfr>
+ *       Writes the points of all frames of a log-file (CONFIG_SD_LOGGING_FORMAT == 1) as line protocol to stdout.
+ *
+ *   frame_tool bench [-p points per frame] [-n repetitions] <recording.txt>
+ *       Parses a line protocol log-file, encodes it in frames with the packed and with the Gorilla encoding and reports
+ *       the bytes per point, the compression ratio compared to the text and the encode and decode time per point.
+ *       The decoded points are compared with the recording, and written as line protocol again they have to give the
+ *       lines of the recording byte for byte.
+ *
+ * @date October 17. 2026
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "sample_frame.h"
+#include "line_parser.h"
+#include "line_writer.h"
+
+using namespace socketsense;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+bool readFile(const char *path, std::string &content)
+{
+	std::ifstream file(path, std::ios::binary);
+	if(!file){
+		std::fprintf(stderr, "Can't open %s\n", path);
+		return false;
+	}
+	content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	return true;
+}
+
+double seconds(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+int decode(const char *path, const std::string &uid)
+{
+	std::string content;
+	if(!readFile(path, content)){
+		return 1;
+	}
+
+	const uint8_t *data = reinterpret_cast<const uint8_t *>(content.data());
+	size_t offset = 0;
+	size_t frames = 0;
+	size_t points = 0;
+	sample_frame_header_t header;
+	sample_frame_decoder_t decoder;
+	sample_frame_point_t point;
+	std::vector<uint16_t> sensels(SAMPLE_FRAME_MAX_SENSELS);
+	LineWriter writer;
+	std::string lines;
+
+	writer.setDevice(uid);
+	while(offset < content.size()){
+		int result = sample_frame_parseHeader(data + offset, content.size() - offset, &header);
+		if(result == SAMPLE_FRAME_OK && content.size() - offset - SAMPLE_FRAME_HEADER_SIZE < header.payload_length){
+			result = SAMPLE_FRAME_ERR_INCOMPLETE;
+		}
+		if(result != SAMPLE_FRAME_OK){											//a frame cut off by a reset ends the log
+			std::fprintf(stderr, "%s frame at offset %zu, stopping\n",
+					result == SAMPLE_FRAME_ERR_INCOMPLETE ? "Incomplete" : "Invalid", offset);
+			break;
+		}
+
+		sample_frame_decoderInit(&decoder, &header, data + offset + SAMPLE_FRAME_HEADER_SIZE);
+		lines.clear();
+		while((result = sample_frame_decodePoint(&decoder, &point, sensels.data())) == SAMPLE_FRAME_OK){
+			writer.append(lines, point, header.sensor_count, header.sensel_count);
+			points++;
+		}
+		if(result != SAMPLE_FRAME_END){
+			std::fprintf(stderr, "Invalid payload of frame %u at offset %zu\n", header.sequence, offset);
+		}
+		std::fwrite(lines.data(), 1, lines.size(), stdout);
+
+		offset += SAMPLE_FRAME_HEADER_SIZE + header.payload_length;
+		frames++;
+	}
+
+	std::fprintf(stderr, "%zu frames, %zu points\n", frames, points);
+
+	return 0;
+}
+
+bool samePoint(const sample_frame_point_t &a, const sample_frame_point_t &b, uint32_t count)
+{
+	return a.timestamp_usec == b.timestamp_usec
+			&& std::memcmp(&a.temperature, &b.temperature, sizeof(float)) == 0
+			&& std::memcmp(&a.humidity, &b.humidity, sizeof(float)) == 0
+			&& std::memcmp(&a.pressure, &b.pressure, sizeof(float)) == 0
+			&& a.sampling_time == b.sampling_time
+			&& a.battery_voltage == b.battery_voltage
+			&& std::memcmp(a.sensels, b.sensels, count * sizeof(uint16_t)) == 0;
+}
+
+/**
+ * Returns true if the point written by the writer is the text of the line.
+ * A line is only reproduced if it has no other tags or fields than a point carries and the point carries the same
+ * sensor elements, compared is set to false otherwise.
+ */
+bool sameText(LineWriter &writer, std::string &device, std::string &text, const ParsedLine &line,
+		const sample_frame_point_t &point, uint8_t sensor_count, uint8_t sensel_count, bool &compared)
+{
+	compared = !line.extra && (point.sensel_mask != nullptr) == !line.sensel_mask.empty();
+	if(!compared){
+		return true;
+	}
+	if(line.device != device){
+		device = line.device;
+		writer.setDevice(device);
+	}
+	text.clear();
+	writer.append(text, point, sensor_count, sensel_count);
+	return text.size() == line.text_length + 1 && std::memcmp(text.data(), line.text, line.text_length) == 0;
+}
+
+/**
+ * Encodes the recording with one encoding, returns false if the decoded points or their text differ.
+ */
+bool benchEncoding(uint8_t encoding, std::vector<ParsedLine> &points, size_t text_bytes, unsigned points_per_frame,
+		unsigned repetitions)
+{
+	const uint8_t sensor_count = points[0].sensor_count;
+	const uint8_t sensel_count = points[0].sensel_count;
+	const uint32_t count = static_cast<uint32_t>(sensor_count) * sensel_count;
+	std::vector<uint8_t> buffer(SAMPLE_FRAME_HEADER_SIZE + points_per_frame * SAMPLE_FRAME_MAX_POINT_SIZE(count));
+	std::vector<std::vector<uint8_t>> frames;
+	sample_frame_t frame;
+	uint64_t frame_bytes = 0;
+
+	sample_frame_init(&frame, buffer.data(), buffer.size(), sensor_count, sensel_count, encoding);
+
+	auto start = Clock::now();
+	for(unsigned r = 0; r < repetitions; r++){
+		frames.clear();
+		frame_bytes = 0;
+		sample_frame_clear(&frame);
+		for(size_t i = 0; i < points.size(); i++){
+			sample_frame_append(&frame, &points[i].point);
+			if(frame.points == points_per_frame || i + 1 == points.size()){
+				size_t length = sample_frame_finish(&frame, static_cast<uint32_t>(frames.size()));
+				frames.emplace_back(buffer.begin(), buffer.begin() + length);
+				frame_bytes += length;
+				sample_frame_clear(&frame);
+			}
+		}
+	}
+	double encode_time = seconds(start);
+
+	sample_frame_header_t header;
+	sample_frame_decoder_t decoder;
+	sample_frame_point_t point;
+	std::vector<uint16_t> sensels(SAMPLE_FRAME_MAX_SENSELS);
+	LineWriter writer;
+	std::string device;
+	std::string text;
+	bool compared;
+	size_t index = 0;
+	size_t mismatches = 0;
+	size_t text_compared = 0;
+	size_t text_mismatches = 0;
+	start = Clock::now();
+	for(unsigned r = 0; r < repetitions; r++){
+		index = 0;
+		for(const auto &data : frames){
+			sample_frame_parseHeader(data.data(), data.size(), &header);
+			sample_frame_decoderInit(&decoder, &header, data.data() + SAMPLE_FRAME_HEADER_SIZE);
+			while(sample_frame_decodePoint(&decoder, &point, sensels.data()) == SAMPLE_FRAME_OK){
+				if(r == 0 && (index >= points.size() || !samePoint(point, points[index].point, count))){
+					mismatches++;
+				}
+				index++;
+			}
+		}
+	}
+	double decode_time = seconds(start);
+
+	size_t line_index = 0;
+	for(const auto &data : frames){													//round trip text -> frame -> text
+		sample_frame_parseHeader(data.data(), data.size(), &header);
+		sample_frame_decoderInit(&decoder, &header, data.data() + SAMPLE_FRAME_HEADER_SIZE);
+		while(line_index < points.size() && sample_frame_decodePoint(&decoder, &point, sensels.data()) == SAMPLE_FRAME_OK){
+			const ParsedLine &line = points[line_index++];
+			if(!sameText(writer, device, text, line, point, header.sensor_count, header.sensel_count, compared)){
+				if(text_mismatches++ == 0){
+					std::fprintf(stderr, "recording: %.*s\ndecoded:   %s", static_cast<int>(line.text_length), line.text,
+							text.c_str());
+				}
+			}
+			text_compared += compared ? 1 : 0;
+		}
+	}
+
+	const double total = static_cast<double>(points.size()) * repetitions;
+	std::printf("%-8s %8.1f bytes/point  %5.1fx smaller than the text  encode %7.1f ns/point  decode %7.1f ns/point\n",
+			encoding == SAMPLE_FRAME_ENCODING_GORILLA ? "gorilla" : "packed",
+			static_cast<double>(frame_bytes) / points.size(), static_cast<double>(text_bytes) / frame_bytes,
+			encode_time * 1e9 / total, decode_time * 1e9 / total);
+	std::printf("         %zu of %zu lines written again byte for byte, %zu differ (%zu have fields or sensels the frames do not carry)\n",
+			text_compared - text_mismatches, points.size(), text_mismatches, points.size() - text_compared);
+	if(mismatches != 0 || index != points.size()){
+		std::fprintf(stderr, "%zu of %zu decoded points differ from the recording\n", mismatches, index);
+		return false;
+	}
+	if(text_mismatches != 0){
+		std::fprintf(stderr, "%zu of %zu lines differ from the recording after the round trip\n", text_mismatches, text_compared);
+		return false;
+	}
+
+	return true;
+}
+
+int bench(const char *path, unsigned points_per_frame, unsigned repetitions)
+{
+	std::string content;
+	if(!readFile(path, content)){
+		return 1;
+	}
+
+	size_t invalid;
+	auto start = Clock::now();
+	std::vector<ParsedLine> points = parseRecording(content.data(), content.size(), &invalid);
+	double parse_time = seconds(start);
+	if(points.empty()){
+		std::fprintf(stderr, "No points in %s\n", path);
+		return 1;
+	}
+
+	size_t text_bytes = 0;
+	size_t reported = 0;
+	LineWriter writer;
+	std::string text;
+	writer.setDevice(points[0].device);
+	for(const auto &line : points){											//all lines have the geometry of the recording
+		text.clear();
+		writer.append(text, line.point, line.sensor_count, line.sensel_count);
+		text_bytes += text.size();
+		for(size_t i = 0; i < line.sensels.size(); i++){
+			if(line.sensel_mask.empty() || (line.sensel_mask[i >> 3] & (1 << (i & 7)))){
+				reported++;
+			}
+		}
+	}
+
+	std::printf("%s: %zu points with %ux%u sensels (%zu invalid lines), %.1f bytes/point as line protocol, parsed in %.1f ns/point\n",
+			path, points.size(), points[0].sensor_count, points[0].sensel_count, invalid,
+			static_cast<double>(text_bytes) / points.size(), parse_time * 1e9 / points.size());
+	if(reported != points.size() * points[0].sensels.size()){
+		std::printf("deadband: %.1f%% of the sensels are reported\n",
+				100.0 * reported / (points.size() * points[0].sensels.size()));
+	}
+
+	bool ok = benchEncoding(SAMPLE_FRAME_ENCODING_PACKED, points, text_bytes, points_per_frame, repetitions);
+	ok = benchEncoding(SAMPLE_FRAME_ENCODING_GORILLA, points, text_bytes, points_per_frame, repetitions) && ok;
+
+	return ok ? 0 : 1;
+}
+
+void usage(const char *name)
+{
+	std::fprintf(stderr, "Usage: %s decode [-u uid] <file.sfr>\n"
+			"       %s bench [-p points per frame] [-n repetitions] <recording.txt>\n", name, name);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	std::string uid;
+	unsigned points_per_frame = 50;
+	unsigned repetitions = 10;
+	int opt;
+
+	if(argc < 2){
+		usage(argv[0]);
+		return 1;
+	}
+	std::string command = argv[1];
+	optind = 2;
+
+	while((opt = getopt(argc, argv, "u:p:n:")) != -1){
+		switch(opt){
+			case 'u': uid = optarg; break;
+			case 'p': points_per_frame = std::atoi(optarg); break;
+			case 'n': repetitions = std::atoi(optarg); break;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+	if(optind + 1 != argc || points_per_frame == 0 || points_per_frame > UINT16_MAX || repetitions == 0){
+		usage(argv[0]);
+		return 1;
+	}
+
+	if(command == "decode"){
+		return decode(argv[optind], uid);
+	}
+	if(command == "bench"){
+		return bench(argv[optind], points_per_frame, repetitions);
+	}
+
+	usage(argv[0]);
+	return 1;
+}
@@ -0,0 +1,236 @@
+/**
+ * @file line_parser.cpp
+ * @brief Parses the line protocol of the SocketSense log-files back into points.
+ *
+ * A straightforward scalar parser that walks the line once. The numbers are converted with std::from_chars, which
+ * rounds the decimal text to the nearest float, so that LineWriter reproduces the text of the firmware.
+ *
+ * @date October 17. 2026
+ */
+#include <charconv>
+#include <cstring>
+
+#include "line_parser.h"
+
+namespace socketsense {
+
+namespace {
+
+const char MEASUREMENT[] = "socket_data";
+
+template<typename T>
+bool parseNumber(const char *&pos, const char *end, T &value)
+{
+	auto result = std::from_chars(pos, end, value);
+	if(result.ec != std::errc()){
+		return false;
+	}
+	pos = result.ptr;
+	return true;
+}
+
+/**
+ * Parses the key s<strip>_<sensel>, pos points behind the 's'.
+ */
+bool parseSenselKey(const char *&pos, const char *end, unsigned &strip, unsigned &sensel)
+{
+	return parseNumber(pos, end, strip) && pos < end && *pos++ == '_' && parseNumber(pos, end, sensel);
+}
+
+} // namespace
+
+bool parseLine(const char *begin, const char *end, ParsedLine &line)
+{
+	const size_t measurement_length = sizeof(MEASUREMENT) - 1;
+	const char *pos = begin;
+	unsigned max_strip = 0;
+	unsigned max_sensel = 0;
+	unsigned field = 0;
+	int last_key = -1;
+
+	line.sensels.clear();
+	line.keys.clear();
+	line.sensel_mask.clear();
+	line.device.clear();
+	line.sensor_count = 0;
+	line.sensel_count = 0;
+	line.point = sample_frame_point_t{};
+	line.text = begin;
+	line.text_length = end - begin;
+	line.extra = false;
+
+	if(static_cast<size_t>(end - pos) < measurement_length || std::memcmp(pos, MEASUREMENT, measurement_length) != 0){
+		return false;
+	}
+	pos += measurement_length;
+
+	while(pos < end && *pos == ','){													//tags
+		const char *key = ++pos;
+		while(pos < end && *pos != '='){
+			pos++;
+		}
+		if(pos == end){
+			return false;
+		}
+		bool device = pos - key == 6 && std::memcmp(key, "device", 6) == 0;
+		line.extra = line.extra || !device;
+		pos++;
+		while(pos < end && *pos != ',' && *pos != ' '){
+			if(*pos == '\\' && pos + 1 < end){
+				pos++;
+			}
+			if(device){
+				line.device += *pos;
+			}
+			pos++;
+		}
+	}
+	if(pos == end || *pos++ != ' '){
+		return false;
+	}
+
+	do{																				//fields
+		const char *key = pos;
+		while(pos < end && *pos != '='){
+			pos++;
+		}
+		if(pos == end){
+			return false;
+		}
+		size_t key_length = pos - key;
+		pos++;
+
+		bool ok = true;
+		unsigned strip;
+		unsigned sensel;
+		uint32_t value;
+		const char *sensel_key = key + 1;
+		if(key_length == 4 && std::memcmp(key, "temp", 4) == 0){
+			ok = parseNumber(pos, end, line.point.temperature);
+			line.extra = line.extra || field++ != 0;								//the order of the firmware
+		}else if(key_length == 3 && std::memcmp(key, "hum", 3) == 0){
+			ok = parseNumber(pos, end, line.point.humidity);
+			line.extra = line.extra || field++ != 1;
+		}else if(key_length == 4 && std::memcmp(key, "pres", 4) == 0){
+			ok = parseNumber(pos, end, line.point.pressure);
+			line.extra = line.extra || field++ != 2;
+		}else if(key_length == 2 && std::memcmp(key, "st", 2) == 0){
+			ok = parseNumber(pos, end, line.point.sampling_time);
+			line.extra = line.extra || field++ != 3;
+		}else if(key_length == 2 && std::memcmp(key, "bl", 2) == 0){
+			ok = parseNumber(pos, end, line.point.battery_voltage);
+			line.extra = line.extra || field++ != 4;
+		}else if(key[0] == 's' && parseSenselKey(sensel_key, key + key_length, strip, sensel) && sensel_key == key + key_length){
+			ok = parseNumber(pos, end, value) && pos < end && *pos++ == 'i' && strip <= 0xFF && sensel <= 0xFF;
+			line.extra = line.extra || field != 5 || static_cast<int>(strip << 8 | sensel) <= last_key;	//strip by strip
+			last_key = static_cast<int>(strip << 8 | sensel);
+			if(strip > max_strip){
+				max_strip = strip;
+			}
+			if(sensel > max_sensel){
+				max_sensel = sensel;
+			}
+			line.sensels.push_back(static_cast<uint16_t>(value > 0xFFFF ? 0xFFFF : value));
+			line.keys.push_back(static_cast<uint16_t>(strip << 8 | sensel));
+		}else{
+			while(pos < end && *pos != ',' && *pos != ' '){							//unknown field
+				pos++;
+			}
+			line.extra = true;
+		}
+		if(!ok || pos == end){
+			return false;
+		}
+	}while(*pos++ == ',');
+
+	if(!parseNumber(pos, end, line.point.timestamp_usec) || pos != end){
+		return false;
+	}
+
+	if(!line.sensels.empty()){
+		if(static_cast<size_t>(max_strip + 1) * (max_sensel + 1) > SAMPLE_FRAME_MAX_SENSELS){
+			return false;
+		}
+		line.sensor_count = static_cast<uint8_t>(max_strip + 1);
+		line.sensel_count = static_cast<uint8_t>(max_sensel + 1);
+	}
+	line.point.sensels = line.sensels.data();
+
+	return true;
+}
+
+std::vector<ParsedLine> parseRecording(const char *data, size_t length, size_t *invalid)
+{
+	std::vector<ParsedLine> lines;
+	const char *pos = data;
+	const char *end = data + length;
+	ParsedLine line;
+
+	if(invalid != NULL){
+		*invalid = 0;
+	}
+
+	while(pos < end){
+		const char *newline = static_cast<const char *>(std::memchr(pos, '\n', end - pos));
+		const char *line_end = newline != NULL ? newline : end;
+		if(line_end > pos && line_end[-1] == '\r'){
+			line_end--;
+		}
+		if(line_end > pos){
+			if(parseLine(pos, line_end, line)){
+				lines.push_back(line);
+			}else if(invalid != NULL){
+				(*invalid)++;
+			}
+		}
+		pos = newline != NULL ? newline + 1 : end;
+	}
+
+	uint8_t sensor_count = 0;
+	uint8_t sensel_count = 0;
+	for(const auto &parsed : lines){
+		if(parsed.sensor_count > sensor_count){
+			sensor_count = parsed.sensor_count;
+		}
+		if(parsed.sensel_count > sensel_count){
+			sensel_count = parsed.sensel_count;
+		}
+	}
+	if(static_cast<size_t>(sensor_count) * sensel_count > SAMPLE_FRAME_MAX_SENSELS){		//only valid per line
+		sensel_count = static_cast<uint8_t>(SAMPLE_FRAME_MAX_SENSELS / sensor_count);
+	}
+
+	const size_t count = static_cast<size_t>(sensor_count) * sensel_count;
+	std::vector<uint16_t> held(count, 0);
+	for(auto &parsed : lines){															//strip by strip, missing ones hold their value
+		std::vector<uint8_t> mask((count + 7) / 8, 0);
+		size_t carried = 0;
+		for(size_t i = 0; i < parsed.keys.size(); i++){
+			unsigned strip = parsed.keys[i] >> 8;
+			unsigned sensel = parsed.keys[i] & 0xFF;
+			if(strip >= sensor_count || sensel >= sensel_count){
+				continue;
+			}
+			size_t index = strip * sensel_count + sensel;
+			held[index] = parsed.sensels[i];
+			if((mask[index >> 3] & (1 << (index & 7))) == 0){
+				mask[index >> 3] |= static_cast<uint8_t>(1 << (index & 7));
+				carried++;
+			}
+		}
+		parsed.sensels = held;
+		parsed.sensor_count = sensor_count;
+		parsed.sensel_count = sensel_count;
+		if(carried == count){
+			parsed.sensel_mask.clear();
+		}else{
+			parsed.sensel_mask = std::move(mask);
+		}
+		parsed.point.sensels = parsed.sensels.data();
+		parsed.point.sensel_mask = parsed.sensel_mask.empty() ? nullptr : parsed.sensel_mask.data();
+	}
+
+	return lines;
+}
+
+} // namespace socketsense
@@ -0,0 +1,66 @@
+/**
+ * @file line_parser.h
+ * @brief Parses the line protocol of the SocketSense log-files back into points.
+ *
+ * Only the format written by the firmware (line_protocol.h) and the gateway (line_writer.h) is supported:
+ * socket_data[,device=<uid>] temp=<f>,hum=<f>,pres=<f>,st=<u>,bl=<u>[,s<strip>_<sensel>=<u>i...] <timestamp>
+ * Lines of a device with a deadband (CONFIG_DATA_COLLECTOR_DEADBAND) only carry the sensor elements that changed,
+ * parseRecording() fills in the others with their last value and sets the sensel_mask. Unknown fields are skipped.
+ *
+ * @date October 17. 2026
+ */
+#ifndef TOOLS_CODEC_LINE_PARSER_H_
+#define TOOLS_CODEC_LINE_PARSER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "sample_frame.h"
+
+namespace socketsense {
+
+/**
+ * @brief One parsed line, the sensel values are owned by the line.
+ */
+struct ParsedLine {
+	sample_frame_point_t point{};		//!< BME280 values and timestamp, point.sensels points into sensels
+	std::vector<uint16_t> sensels;		//!< Values of the sensor elements, strip by strip after parseRecording()
+	std::vector<uint16_t> keys;			//!< Strip << 8 | sensel of each value in the order of the line
+	std::vector<uint8_t> sensel_mask;	//!< Sensor elements carried by the line, empty if all (parseRecording())
+	uint8_t sensor_count = 0;			//!< Number of strips (highest strip found in the line + 1)
+	uint8_t sensel_count = 0;			//!< Number of sensor elements per strip
+	std::string device;					//!< Value of the device tag, empty if there is none
+	const char *text = nullptr;			//!< The line in the parsed data (without the newline), valid as long as the data
+	size_t text_length = 0;				//!< Length of text
+	bool extra = false;					//!< The line has tags or fields that a point does not carry (e.g. activity), or they are not in the order of the firmware
+};
+
+/**
+ * @brief Parses one line.
+ *
+ * @param begin First character of the line.
+ * @param end End of the line, without the newline.
+ * @param line Destination, the sensels are in the order of the line.
+ * @return False if the line is not a valid socket_data point.
+ */
+bool parseLine(const char *begin, const char *end, ParsedLine &line);
+
+/**
+ * @brief Parses all lines of a recording, invalid and empty lines are skipped.
+ *
+ * The sensels of every line are arranged strip by strip in the geometry of the whole recording (the largest strip
+ * and sensor element found). Sensor elements that a line does not carry keep the value of the previous line (0 in the
+ * first one) and point.sensel_mask marks the ones it carries.
+ *
+ * @param data Content of the log-file.
+ * @param length Length of the content.
+ * @param invalid Number of skipped lines that were not empty, may be NULL.
+ * @return The parsed lines.
+ */
+std::vector<ParsedLine> parseRecording(const char *data, size_t length, size_t *invalid);
+
+} // namespace socketsense
+
+#endif /* TOOLS_CODEC_LINE_PARSER_H_ */
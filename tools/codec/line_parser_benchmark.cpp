@@ -0,0 +1,235 @@
+/**
+ * @file line_parser_benchmark.cpp
+ * @brief Compares SimdLineParser with the scalar parseLine() when converting line protocol into columns.
+ *
+ * The baseline parses line by line with parseLine() and holds the sensor elements in the geometry of the recording,
+ * like RecordingReader did before. SimdLineParser is measured with each instruction set the CPU supports. The columns
+ * of every run are compared with the ones of the baseline. The text is a synthetic recording with gait-like sensor
+ * values, optionally with a deadband like the firmware writes it, or a recording from the SD card.
+ *
+ *   line_parser_benchmark [-m MB] [-s strips] [-e sensels per strip] [-d deadband] [-n repetitions] [recording.txt]
+ *
+ * @date October 17. 2026
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "line_parser.h"
+#include "line_writer.h"
+#include "simd_line_parser.h"
+
+using namespace socketsense;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * Writes a synthetic recording with the same waveforms as decode_benchmark.
+ */
+std::string generate(size_t bytes, unsigned sensors, unsigned sensels, unsigned deadband)
+{
+	const unsigned count = sensors * sensels;
+	std::vector<uint16_t> values(count);
+	std::vector<uint16_t> reported(count, 0);
+	std::vector<uint8_t> mask((count + 7) / 8);
+	sample_frame_point_t point{};
+	LineWriter writer;
+	std::string text;
+	unsigned sample = 0;
+
+	writer.setDevice("bench");
+	point.timestamp_usec = 1571234567890123ULL;
+	point.sensels = values.data();
+	while(text.size() < bytes){
+		double t = point.timestamp_usec * 1e-6;
+		point.timestamp_usec += 10000 + (sample % 7);
+		point.temperature = 25.0f + 0.01f * static_cast<float>(std::sin(t * 0.01));
+		point.humidity = 39.0f + 0.02f * static_cast<float>(std::sin(t * 0.02));
+		point.pressure = 100655.0f + static_cast<float>(std::sin(t * 0.005));
+		point.sampling_time = 2400 + (sample % 50);
+		point.battery_voltage = 3950;
+		std::fill(mask.begin(), mask.end(), 0);
+		for(unsigned i = 0; i < count; i++){
+			double phase = std::fmod(t + i * 0.05, 1.0);
+			values[i] = static_cast<uint16_t>(phase < 0.6 ? 400 + 3000 * std::sin(phase / 0.6 * M_PI) : 400 + (i * 7) % 13);
+			if(sample % 100 == 0 || std::abs(values[i] - reported[i]) > static_cast<int>(deadband)){
+				reported[i] = values[i];
+				mask[i >> 3] |= static_cast<uint8_t>(1 << (i & 7));
+			}
+		}
+		point.sensel_mask = deadband > 0 ? mask.data() : nullptr;
+		writer.append(text, point, sensors, sensels);
+		sample++;
+	}
+
+	return text;
+}
+
+/**
+ * The scalar baseline: parseLine() for each line, the sensor elements are held in the geometry of the columns.
+ */
+size_t parseBaseline(const std::string &text, LineColumns &columns)
+{
+	const char *pos = text.data();
+	const char *end = pos + text.size();
+	std::vector<uint16_t> held(static_cast<size_t>(columns.sensor_count) * columns.sensel_count, 0);
+	ParsedLine line;
+	size_t invalid = 0;
+
+	while(pos < end){
+		const char *newline = static_cast<const char *>(std::memchr(pos, '\n', end - pos));
+		const char *line_end = newline != nullptr ? newline : end;
+		if(line_end > pos && line_end[-1] == '\r'){
+			line_end--;
+		}
+		if(line_end > pos){
+			if(parseLine(pos, line_end, line)){
+				for(size_t i = 0; i < line.keys.size(); i++){
+					unsigned strip = line.keys[i] >> 8;
+					unsigned sensel = line.keys[i] & 0xFF;
+					if(strip < columns.sensor_count && sensel < columns.sensel_count){
+						held[strip * columns.sensel_count + sensel] = line.sensels[i];
+					}
+				}
+				line.point.sensels = held.data();
+				columns.append(line.point);
+			}else{
+				invalid++;
+			}
+		}
+		pos = newline != nullptr ? newline + 1 : end;
+	}
+
+	return invalid;
+}
+
+template<typename T>
+bool sameColumn(const std::vector<T> &a, const std::vector<T> &b)
+{
+	return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+}
+
+bool sameColumns(const LineColumns &a, const LineColumns &b)
+{
+	bool same = a.sensor_count == b.sensor_count && a.sensel_count == b.sensel_count && sameColumn(a.timestamps, b.timestamps)
+			&& sameColumn(a.temperature, b.temperature) && sameColumn(a.humidity, b.humidity)
+			&& sameColumn(a.pressure, b.pressure) && sameColumn(a.sampling_time, b.sampling_time)
+			&& sameColumn(a.battery_voltage, b.battery_voltage) && a.sensels.size() == b.sensels.size();
+	for(size_t i = 0; same && i < a.sensels.size(); i++){
+		same = sameColumn(a.sensels[i], b.sensels[i]);
+	}
+	return same;
+}
+
+void report(const char *name, double duration, size_t bytes, size_t rows, double baseline)
+{
+	std::printf("%-10s %8.1f MB/s %8.2f M lines/s %7.1f ms %6.1fx\n", name, bytes / duration / 1e6, rows / duration / 1e6,
+			duration * 1e3, baseline / duration);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	unsigned long megabytes = 64;
+	unsigned sensors = 4;
+	unsigned sensels = 8;
+	unsigned deadband = 0;
+	unsigned repetitions = 3;
+	int opt;
+
+	while((opt = getopt(argc, argv, "m:s:e:d:n:")) != -1){
+		switch(opt){
+			case 'm': megabytes = std::strtoul(optarg, nullptr, 10); break;
+			case 's': sensors = std::atoi(optarg); break;
+			case 'e': sensels = std::atoi(optarg); break;
+			case 'd': deadband = std::atoi(optarg); break;
+			case 'n': repetitions = std::atoi(optarg); break;
+			default:
+				std::fprintf(stderr, "Usage: %s [-m MB] [-s strips] [-e sensels per strip] [-d deadband] [-n repetitions] [recording.txt]\n",
+						argv[0]);
+				return 1;
+		}
+	}
+	if(megabytes == 0 || repetitions == 0 || sensors == 0 || sensels == 0 || sensors * sensels > SAMPLE_FRAME_MAX_SENSELS){
+		std::fprintf(stderr, "Invalid size or geometry\n");
+		return 1;
+	}
+
+	std::string text;
+	if(optind < argc){
+		std::ifstream file(argv[optind], std::ios::binary);
+		if(!file){
+			std::fprintf(stderr, "Can't open %s\n", argv[optind]);
+			return 1;
+		}
+		text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}else{
+		text = generate(megabytes * 1000000, sensors, sensels, deadband);
+	}
+
+	LineColumns expected;																//geometry of the first valid line
+	SimdLineParser(SimdLineParser::Mode::Scalar).parse(text.data(), std::min<size_t>(text.size(), 65536), expected);
+	if(expected.sensor_count == 0){
+		std::fprintf(stderr, "No valid line found\n");
+		return 1;
+	}
+	const uint8_t sensor_count = expected.sensor_count;
+	const uint8_t sensel_count = expected.sensel_count;
+
+	double baseline = 1e9;
+	size_t invalid = 0;
+	for(unsigned r = 0; r < repetitions; r++){
+		expected.reset(sensor_count, sensel_count);
+		auto start = Clock::now();
+		invalid = parseBaseline(text, expected);
+		baseline = std::min(baseline, seconds(start));
+	}
+	std::printf("%zu bytes, %zu lines with %ux%u sensels (%zu invalid), %.1f bytes/line\n", text.size(), expected.rows(),
+			sensor_count, sensel_count, invalid, static_cast<double>(text.size()) / std::max<size_t>(expected.rows(), 1));
+	report("baseline", baseline, text.size(), expected.rows(), baseline);
+
+	bool ok = true;
+	const SimdLineParser::Mode modes[] = {SimdLineParser::Mode::Scalar, SimdLineParser::Mode::Sse2, SimdLineParser::Mode::Avx2};
+	for(auto mode : modes){
+		LineColumns columns;
+		double best = 1e9;
+		size_t fallbacks = 0;
+		if(SimdLineParser(mode).mode() != mode){
+			std::printf("%-10s not supported\n", SimdLineParser::modeName(mode));
+			continue;
+		}
+		for(unsigned r = 0; r < repetitions; r++){
+			SimdLineParser parser(mode);
+			columns.reset(sensor_count, sensel_count);
+			auto start = Clock::now();
+			parser.parse(text.data(), text.size(), columns);
+			best = std::min(best, seconds(start));
+			fallbacks = parser.fallbacks();
+		}
+		report(SimdLineParser::modeName(mode), best, text.size(), columns.rows(), baseline);
+		if(!sameColumns(columns, expected)){
+			std::fprintf(stderr, "%s: the columns differ from the baseline\n", SimdLineParser::modeName(mode));
+			ok = false;
+		}
+		if(fallbacks > invalid){
+			std::printf("%-10s %zu lines parsed by parseLine()\n", "", fallbacks - invalid);
+		}
+	}
+
+	return ok ? 0 : 1;
+}
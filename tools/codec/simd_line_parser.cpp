@@ -0,0 +1,512 @@
+/**
+ * @file simd_line_parser.cpp
+ * @brief Parses line protocol log-files straight into columns, see simd_line_parser.h.
+ *
+ * The BME280 values are written by the firmware with two decimals. n / 10^k is computed in double precision and then
+ * rounded to float; for k <= 2 and at most 9 integer digits the exact decimal value is never within half a double ulp
+ * of a float rounding boundary, so the result is the nearest float like std::from_chars gives it.
+ *
+ * @date October 17. 2026
+ */
+#include "simd_line_parser.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_LINE_PARSER_X86 1
+#endif
+
+namespace socketsense {
+
+namespace {
+
+const char MEASUREMENT[] = "socket_data";
+const size_t BLOCK = 64;						//!< Bytes classified at once, one bit per byte
+
+enum Field {
+	FIELD_TEMPERATURE,
+	FIELD_HUMIDITY,
+	FIELD_PRESSURE,
+	FIELD_SAMPLING_TIME,
+	FIELD_BATTERY,
+	FIELD_SENSEL								//!< First sensor element, the others follow
+};
+
+inline bool isDelimiter(char c)
+{
+	return c == ',' || c == '=' || c == ' ' || c == '\n' || c == '\\';
+}
+
+inline bool isDigit(char c)
+{
+	return static_cast<unsigned char>(c - '0') < 10;
+}
+
+uint64_t classifyScalar(const char *block)
+{
+	uint64_t mask = 0;
+
+	for(size_t i = 0; i < BLOCK; i++){
+		if(isDelimiter(block[i])){
+			mask |= 1ULL << i;
+		}
+	}
+
+	return mask;
+}
+
+#ifdef SIMD_LINE_PARSER_X86
+__attribute__((target("sse2")))
+uint64_t classifySse2(const char *block)
+{
+	const __m128i comma = _mm_set1_epi8(',');
+	const __m128i equals = _mm_set1_epi8('=');
+	const __m128i space = _mm_set1_epi8(' ');
+	const __m128i newline = _mm_set1_epi8('\n');
+	const __m128i escape = _mm_set1_epi8('\\');
+	uint64_t mask = 0;
+
+	for(size_t i = 0; i < BLOCK; i += 16){
+		__m128i text = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i));
+		__m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(text, comma), _mm_cmpeq_epi8(text, equals)),
+				_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(text, space), _mm_cmpeq_epi8(text, newline)),
+				_mm_cmpeq_epi8(text, escape)));
+		mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(hits))) << i;
+	}
+
+	return mask;
+}
+
+__attribute__((target("avx2")))
+uint64_t classifyAvx2(const char *block)
+{
+	const __m256i comma = _mm256_set1_epi8(',');
+	const __m256i equals = _mm256_set1_epi8('=');
+	const __m256i space = _mm256_set1_epi8(' ');
+	const __m256i newline = _mm256_set1_epi8('\n');
+	const __m256i escape = _mm256_set1_epi8('\\');
+	uint64_t mask = 0;
+
+	for(size_t i = 0; i < BLOCK; i += 32){
+		__m256i text = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + i));
+		__m256i hits = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(text, comma), _mm256_cmpeq_epi8(text, equals)),
+				_mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(text, space), _mm256_cmpeq_epi8(text, newline)),
+				_mm256_cmpeq_epi8(text, escape)));
+		mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(hits))) << i;
+	}
+
+	return mask;
+}
+#endif
+
+/**
+ * Converts 8 ASCII digits at once, returns false if one of them is not a digit.
+ */
+inline bool parseEightDigits(const char *text, uint64_t &value)
+{
+	uint64_t chunk;
+	std::memcpy(&chunk, text, sizeof(chunk));
+	if((((chunk + 0x4646464646464646ULL) | (chunk - 0x3030303030303030ULL)) & 0x8080808080808080ULL) != 0){
+		return false;
+	}
+
+	chunk -= 0x3030303030303030ULL;											//little endian: the first digit is the lowest byte
+	chunk = (chunk * 10) + (chunk >> 8);
+	chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)))
+			+ (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+	value = chunk;
+	return true;
+}
+
+bool parseTimestamp(const char *begin, const char *end, uint64_t &value)
+{
+	uint64_t high;
+	uint64_t low;
+
+	if(end - begin == 16 && parseEightDigits(begin, high) && parseEightDigits(begin + 8, low)){
+		value = high * 100000000ULL + low;
+		return true;
+	}
+
+	auto result = std::from_chars(begin, end, value);
+	return result.ec == std::errc() && result.ptr == end;
+}
+
+bool parseUnsigned(const char *begin, const char *end, uint32_t &value)
+{
+	if(end - begin > 0 && end - begin <= 9){
+		uint32_t number = 0;
+		for(const char *pos = begin; pos < end; pos++){
+			if(!isDigit(*pos)){
+				return false;
+			}
+			number = number * 10 + static_cast<uint32_t>(*pos - '0');
+		}
+		value = number;
+		return true;
+	}
+
+	auto result = std::from_chars(begin, end, value);
+	return result.ec == std::errc() && result.ptr == end;
+}
+
+/**
+ * Converts [-]digits[.d[d]] as fixed-point number, anything else with std::from_chars.
+ */
+bool parseFixed(const char *begin, const char *end, float &value)
+{
+	static const double SCALE[] = {1.0, 10.0, 100.0};
+	const char *pos = begin;
+	bool negative = pos < end && *pos == '-';
+	uint64_t number = 0;
+	int digits = 0;
+	int decimals = 0;
+
+	pos += negative ? 1 : 0;
+	for(; pos < end && isDigit(*pos) && digits < 10; pos++, digits++){
+		number = number * 10 + static_cast<uint64_t>(*pos - '0');
+	}
+	if(pos < end && *pos == '.'){
+		for(pos++; pos < end && isDigit(*pos) && decimals < 3; pos++, decimals++){
+			number = number * 10 + static_cast<uint64_t>(*pos - '0');
+		}
+		decimals = decimals == 0 ? 3 : decimals;
+	}
+	if(pos == end && digits > 0 && digits <= 9 && decimals <= 2){
+		float magnitude = static_cast<float>(static_cast<double>(number) / SCALE[decimals]);
+		value = negative ? -magnitude : magnitude;
+		return true;
+	}
+
+	auto result = std::from_chars(begin, end, value);
+	return result.ec == std::errc() && result.ptr == end;
+}
+
+} // namespace
+
+void LineColumns::reset(uint8_t sensors, uint8_t sensels_per_strip)
+{
+	sensor_count = sensors;
+	sensel_count = sensels_per_strip;
+	sensels.assign(static_cast<size_t>(sensors) * sensels_per_strip, std::vector<uint16_t>());
+	clear();
+}
+
+void LineColumns::clear()
+{
+	timestamps.clear();
+	temperature.clear();
+	humidity.clear();
+	pressure.clear();
+	sampling_time.clear();
+	battery_voltage.clear();
+	for(auto &column : sensels){
+		column.clear();
+	}
+}
+
+void LineColumns::append(const sample_frame_point_t &point)
+{
+	timestamps.push_back(point.timestamp_usec);
+	temperature.push_back(point.temperature);
+	humidity.push_back(point.humidity);
+	pressure.push_back(point.pressure);
+	sampling_time.push_back(point.sampling_time);
+	battery_voltage.push_back(point.battery_voltage);
+	for(size_t i = 0; i < sensels.size(); i++){
+		sensels[i].push_back(point.sensels[i]);
+	}
+}
+
+SimdLineParser::SimdLineParser(Mode mode)
+	: mode_(Mode::Scalar), classify_(classifyScalar)
+{
+#ifdef SIMD_LINE_PARSER_X86
+	bool avx2 = __builtin_cpu_supports("avx2");
+	if((mode == Mode::Auto || mode == Mode::Avx2) && avx2){
+		mode_ = Mode::Avx2;
+		classify_ = classifyAvx2;
+	}else if(mode != Mode::Scalar){
+		mode_ = Mode::Sse2;
+		classify_ = classifySse2;
+	}
+#else
+	(void) mode;
+#endif
+}
+
+const char *SimdLineParser::modeName(Mode mode)
+{
+	switch(mode){
+		case Mode::Sse2: return "sse2";
+		case Mode::Avx2: return "avx2";
+		case Mode::Scalar: return "scalar";
+		default: return "auto";
+	}
+}
+
+void SimdLineParser::setRange(uint64_t start_us, uint64_t end_us)
+{
+	start_us_ = start_us;
+	end_us_ = end_us;
+}
+
+void SimdLineParser::resetHeld()
+{
+	std::fill(held_.begin(), held_.end(), 0);
+}
+
+size_t SimdLineParser::parse(const char *data, size_t length, LineColumns &columns)
+{
+	const size_t rows = columns.rows();
+	const char *end = data + length;
+	const char *line = data;
+	const char *token = data;
+	char tail[BLOCK];
+
+	if(columns.sensor_count == 0){													//geometry of the first valid line
+		for(const char *pos = data; pos < end;){
+			const char *newline = static_cast<const char *>(std::memchr(pos, '\n', end - pos));
+			const char *line_end = newline != nullptr ? newline : end;
+			if(parseLine(pos, line_end - (line_end > pos && line_end[-1] == '\r'), fallback_)
+					&& fallback_.sensor_count > 0){
+				columns.reset(fallback_.sensor_count, fallback_.sensel_count);
+				break;
+			}
+			pos = newline != nullptr ? newline + 1 : end;
+		}
+	}
+	setGeometry(columns);
+
+	state_ = State::Measurement;
+	startLine();
+	for(size_t block = 0; block < length; block += BLOCK){
+		uint64_t mask;
+		if(length - block >= BLOCK){
+			mask = classify_(data + block);
+		}else{																		//the classifiers read whole blocks
+			std::memset(tail, 0, sizeof(tail));
+			std::memcpy(tail, data + block, length - block);
+			mask = classify_(tail) & ((1ULL << (length - block)) - 1);
+		}
+
+		while(mask != 0){
+			const char *pos = data + block + __builtin_ctzll(mask);
+			const char c = *pos;
+			mask &= mask - 1;
+
+			if(c == '\n'){
+				const char *line_end = pos > line && pos[-1] == '\r' ? pos - 1 : pos;
+				if(state_ == State::Timestamp){
+					commitLine(line, token, line_end, columns);
+				}else if(line_end > line){
+					parseFallback(line, line_end, columns);
+				}
+				line = token = pos + 1;
+				state_ = State::Measurement;
+				startLine();
+				continue;
+			}
+
+			switch(state_){
+				case State::Measurement:
+					if(pos - token == static_cast<std::ptrdiff_t>(sizeof(MEASUREMENT) - 1)
+							&& std::memcmp(token, MEASUREMENT, sizeof(MEASUREMENT) - 1) == 0 && (c == ',' || c == ' ')){
+						state_ = c == ',' ? State::TagKey : State::FieldKey;
+					}else{
+						state_ = State::Skip;
+					}
+					break;
+				case State::TagKey:
+					state_ = c == '=' ? State::TagValue : State::Skip;
+					break;
+				case State::TagValue:
+					state_ = c == ',' ? State::TagKey : (c == ' ' ? State::FieldKey : State::Skip);
+					break;
+				case State::FieldKey:
+					state_ = c == '=' && fieldKey(token, pos) ? State::FieldValue : State::Skip;
+					break;
+				case State::FieldValue:
+					if((c == ',' || c == ' ') && fieldValue(token, pos)){
+						state_ = c == ',' ? State::FieldKey : State::Timestamp;
+					}else{
+						state_ = State::Skip;
+					}
+					break;
+				default:
+					state_ = State::Skip;
+					break;
+			}
+			token = pos + 1;
+		}
+	}
+
+	if(line < end){																	//last line without a newline
+		const char *line_end = end[-1] == '\r' ? end - 1 : end;
+		if(state_ == State::Timestamp){
+			commitLine(line, token, line_end, columns);
+		}else if(line_end > line){
+			parseFallback(line, line_end, columns);
+		}
+	}
+
+	return columns.rows() - rows;
+}
+
+void SimdLineParser::setGeometry(const LineColumns &columns)
+{
+	if(columns.sensor_count == sensor_count_ && columns.sensel_count == sensel_count_){
+		return;
+	}
+
+	sensor_count_ = columns.sensor_count;
+	sensel_count_ = columns.sensel_count;
+	keys_.clear();
+	for(unsigned strip = 0; strip < sensor_count_; strip++){
+		for(unsigned sensel = 0; sensel < sensel_count_; sensel++){
+			keys_.push_back("s" + std::to_string(strip) + "_" + std::to_string(sensel));
+		}
+	}
+	held_.assign(keys_.size(), 0);
+	pending_.assign(keys_.size(), 0);
+}
+
+void SimdLineParser::startLine()
+{
+	point_ = sample_frame_point_t{};
+	std::copy(held_.begin(), held_.end(), pending_.begin());
+	next_sensel_ = 0;
+}
+
+/**
+ * Identifies the field, the keys of the sensor elements are expected in the order the firmware writes them.
+ */
+bool SimdLineParser::fieldKey(const char *begin, const char *end)
+{
+	const size_t length = end - begin;
+
+	if(next_sensel_ < keys_.size() && keys_[next_sensel_].size() == length
+			&& std::memcmp(keys_[next_sensel_].data(), begin, length) == 0){
+		field_ = FIELD_SENSEL + static_cast<int>(next_sensel_++);
+		return true;
+	}
+
+	switch(length){
+		case 4:
+			if(std::memcmp(begin, "temp", 4) == 0){
+				field_ = FIELD_TEMPERATURE;
+				return true;
+			}
+			if(std::memcmp(begin, "pres", 4) == 0){
+				field_ = FIELD_PRESSURE;
+				return true;
+			}
+			break;
+		case 3:
+			if(std::memcmp(begin, "hum", 3) == 0){
+				field_ = FIELD_HUMIDITY;
+				return true;
+			}
+			break;
+		case 2:
+			if(std::memcmp(begin, "st", 2) == 0){
+				field_ = FIELD_SAMPLING_TIME;
+				return true;
+			}
+			if(std::memcmp(begin, "bl", 2) == 0){
+				field_ = FIELD_BATTERY;
+				return true;
+			}
+			break;
+	}
+
+	unsigned strip;
+	unsigned sensel;
+	const char *pos = begin + 1;
+	if(length < 4 || begin[0] != 's'){
+		return false;															//unknown fields are left to parseLine()
+	}
+	auto result = std::from_chars(pos, end, strip);
+	if(result.ec != std::errc() || result.ptr == end || *result.ptr != '_'){
+		return false;
+	}
+	result = std::from_chars(result.ptr + 1, end, sensel);
+	if(result.ec != std::errc() || result.ptr != end || strip >= sensor_count_ || sensel >= sensel_count_){
+		return false;
+	}
+	next_sensel_ = strip * sensel_count_ + sensel;
+	field_ = FIELD_SENSEL + static_cast<int>(next_sensel_++);
+
+	return true;
+}
+
+bool SimdLineParser::fieldValue(const char *begin, const char *end)
+{
+	uint32_t value;
+
+	switch(field_){
+		case FIELD_TEMPERATURE: return parseFixed(begin, end, point_.temperature);
+		case FIELD_HUMIDITY: return parseFixed(begin, end, point_.humidity);
+		case FIELD_PRESSURE: return parseFixed(begin, end, point_.pressure);
+		case FIELD_SAMPLING_TIME: return parseUnsigned(begin, end, point_.sampling_time);
+		case FIELD_BATTERY: return parseUnsigned(begin, end, point_.battery_voltage);
+		default:
+			if(end - begin < 2 || end[-1] != 'i' || !parseUnsigned(begin, end - 1, value)){
+				return false;
+			}
+			pending_[field_ - FIELD_SENSEL] = static_cast<uint16_t>(value > 0xFFFF ? 0xFFFF : value);
+			return true;
+	}
+}
+
+void SimdLineParser::commitLine(const char *line, const char *begin, const char *end, LineColumns &columns)
+{
+	if(!parseTimestamp(begin, end, point_.timestamp_usec)){
+		parseFallback(line, end, columns);
+		return;
+	}
+
+	held_.swap(pending_);
+	if(point_.timestamp_usec < start_us_ || point_.timestamp_usec > end_us_){
+		return;
+	}
+	columns.timestamps.push_back(point_.timestamp_usec);
+	columns.temperature.push_back(point_.temperature);
+	columns.humidity.push_back(point_.humidity);
+	columns.pressure.push_back(point_.pressure);
+	columns.sampling_time.push_back(point_.sampling_time);
+	columns.battery_voltage.push_back(point_.battery_voltage);
+	for(size_t i = 0; i < held_.size(); i++){
+		columns.sensels[i].push_back(held_[i]);
+	}
+}
+
+/**
+ * Parses a line that does not fit the fast path with parseLine().
+ */
+void SimdLineParser::parseFallback(const char *begin, const char *end, LineColumns &columns)
+{
+	fallbacks_++;
+	if(!parseLine(begin, end, fallback_)){
+		invalid_++;
+		return;
+	}
+
+	for(size_t i = 0; i < fallback_.keys.size(); i++){
+		unsigned strip = fallback_.keys[i] >> 8;
+		unsigned sensel = fallback_.keys[i] & 0xFF;
+		if(strip < sensor_count_ && sensel < sensel_count_){
+			held_[strip * sensel_count_ + sensel] = fallback_.sensels[i];
+		}
+	}
+	if(fallback_.point.timestamp_usec < start_us_ || fallback_.point.timestamp_usec > end_us_){
+		return;
+	}
+	fallback_.point.sensels = held_.data();
+	columns.append(fallback_.point);
+}
+
+} // namespace socketsense
@@ -0,0 +1,151 @@
+/**
+ * @file simd_line_parser.h
+ * @brief Parses line protocol log-files straight into columns, finding the delimiters with SSE2 or AVX2.
+ *
+ * The text is classified 64 bytes at a time: one vector compare per delimiter (',', '=', ' ', '\n' and the escape
+ * character '\') yields a bit mask of the delimiter positions, and the tokens between them are converted in one pass:
+ * the keys of the sensor elements are matched against the keys the firmware writes in order, the BME280 values with
+ * two decimals are converted as fixed-point numbers and the 16 digit timestamps eight digits at a time (SWAR).
+ * A line that does not fit this format (escaped tags, other number formats) is handed to parseLine(), so the result
+ * is always the same as the one of the scalar parser.
+ *
+ * The values of the sensor elements are held from line to line like parseRecording() does, so lines of a device with
+ * a deadband (CONFIG_DATA_COLLECTOR_DEADBAND) are completed with the previous values.
+ *
+ * @date October 17. 2026
+ */
+#ifndef TOOLS_CODEC_SIMD_LINE_PARSER_H_
+#define TOOLS_CODEC_SIMD_LINE_PARSER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "line_parser.h"
+
+namespace socketsense {
+
+/**
+ * @brief Samples in columns, one array per field and per sensor element.
+ */
+struct LineColumns {
+	uint8_t sensor_count = 0;						//!< Number of sensor strips
+	uint8_t sensel_count = 0;						//!< Number of sensor elements per strip
+	std::vector<uint64_t> timestamps;				//!< Timestamps in us
+	std::vector<float> temperature;
+	std::vector<float> humidity;
+	std::vector<float> pressure;
+	std::vector<uint32_t> sampling_time;
+	std::vector<uint32_t> battery_voltage;
+	std::vector<std::vector<uint16_t>> sensels;		//!< One column per sensor element, strip by strip
+
+	size_t rows() const { return timestamps.size(); }
+
+	/**
+	 * @brief Sets the geometry and removes all rows.
+	 */
+	void reset(uint8_t sensors, uint8_t sensels_per_strip);
+
+	/**
+	 * @brief Removes all rows and keeps the geometry.
+	 */
+	void clear();
+
+	/**
+	 * @brief Appends one row, the point has the geometry of the columns.
+	 */
+	void append(const sample_frame_point_t &point);
+};
+
+/**
+ * @brief Converts line protocol text into LineColumns.
+ */
+class SimdLineParser {
+public:
+	/**
+	 * @brief Instruction set used to find the delimiters.
+	 */
+	enum class Mode {
+		Auto,		//!< The best one the CPU supports
+		Scalar,		//!< One character at a time
+		Sse2,		//!< 16 bytes per compare
+		Avx2		//!< 32 bytes per compare
+	};
+
+	/**
+	 * @param mode Instruction set, falls back to a supported one.
+	 */
+	explicit SimdLineParser(Mode mode = Mode::Auto);
+
+	/**
+	 * @brief Parses the lines and appends them to the columns.
+	 *
+	 * A line without a newline at the end of the text is parsed as well. If the columns have no geometry yet, it is
+	 * taken from the first valid line. Sensor elements outside of the geometry are ignored.
+	 *
+	 * @param data The text.
+	 * @param length Length of the text.
+	 * @param columns Destination.
+	 * @return Number of appended rows.
+	 */
+	size_t parse(const char *data, size_t length, LineColumns &columns);
+
+	/**
+	 * @brief Only the rows with a timestamp in [start_us, end_us] are appended, the others still update the held values.
+	 */
+	void setRange(uint64_t start_us, uint64_t end_us);
+
+	/**
+	 * @brief Sets the held values of the sensor elements back to 0, e.g. before another recording is parsed.
+	 */
+	void resetHeld();
+
+	/**
+	 * @brief Number of lines that were not valid since the construction.
+	 */
+	size_t invalid() const { return invalid_; }
+
+	/**
+	 * @brief Number of lines that were passed on to parseLine() since the construction.
+	 */
+	size_t fallbacks() const { return fallbacks_; }
+
+	Mode mode() const { return mode_; }
+	static const char *modeName(Mode mode);
+
+private:
+	enum class State {
+		Measurement, TagKey, TagValue, FieldKey, FieldValue, Timestamp, Skip
+	};
+
+	void setGeometry(const LineColumns &columns);
+	void startLine();
+	bool fieldKey(const char *begin, const char *end);
+	bool fieldValue(const char *begin, const char *end);
+	void commitLine(const char *line, const char *begin, const char *end, LineColumns &columns);
+	void parseFallback(const char *begin, const char *end, LineColumns &columns);
+
+	Mode mode_;
+	uint64_t (*classify_)(const char *block);
+	uint64_t start_us_ = 0;
+	uint64_t end_us_ = UINT64_MAX;
+	size_t invalid_ = 0;
+	size_t fallbacks_ = 0;
+
+	uint8_t sensor_count_ = 0;
+	uint8_t sensel_count_ = 0;
+	std::vector<std::string> keys_;			//!< Field keys s<strip>_<sensel> of the geometry
+	std::vector<uint16_t> held_;			//!< Last value of each sensor element
+	std::vector<uint16_t> pending_;			//!< Values of the line that is being parsed
+
+	State state_ = State::Measurement;
+	int field_ = 0;							//!< Field of the value that is being parsed
+	size_t next_sensel_ = 0;				//!< Sensor element expected next
+	sample_frame_point_t point_{};
+	ParsedLine fallback_;
+};
+
+} // namespace socketsense
+
+#endif /* TOOLS_CODEC_SIMD_LINE_PARSER_H_ */
@@ -0,0 +1,305 @@
+/**
+ * @file batcher.cpp
+ * @brief Collects the line protocol of all devices and writes it to InfluxDB in large, time-ordered batches.
+ *
+ * @date October 17. 2026
+ */
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+#include "batcher.h"
+
+namespace socketsense {
+
+namespace {
+
+/**
+ * Returns the end of the measurement of a line, the first comma or space that is not escaped.
+ */
+const char *measurementEnd(const char *begin, const char *end)
+{
+	const char *pos = begin;
+	while(pos < end && *pos != ',' && *pos != ' '){
+		pos += *pos == '\\' && pos + 1 < end ? 2 : 1;
+	}
+	return pos;
+}
+
+/**
+ * Returns the timestamp behind the last space of a line, UINT64_MAX if the line ends with a field instead.
+ */
+uint64_t lineTimestamp(const char *begin, const char *end)
+{
+	const char *pos = end;
+	uint64_t timestamp = 0;
+
+	while(pos > begin && pos[-1] >= '0' && pos[-1] <= '9'){
+		pos--;
+	}
+	if(pos == end || pos == begin || pos[-1] != ' ' || std::from_chars(pos, end, timestamp).ptr != end){
+		return UINT64_MAX;
+	}
+	return timestamp;
+}
+
+} // namespace
+
+Batcher::Batcher(const BatcherConfig &config, WriteFunction write) : config_(config), write_(std::move(write))
+{
+	config_.batch_points = std::max<size_t>(config_.batch_points, 1);
+	config_.rate_window_ms = std::max(config_.rate_window_ms, 1);
+}
+
+Batcher::~Batcher()
+{
+	stop();
+}
+
+void Batcher::setSpaceListener(std::function<void()> listener)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	space_listener_ = std::move(listener);
+}
+
+void Batcher::start()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if(!running_){
+		running_ = true;
+		thread_ = std::thread(&Batcher::run, this);
+	}
+}
+
+void Batcher::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		running_ = false;
+	}
+	ready_.notify_all();
+	if(thread_.joinable()){
+		thread_.join();
+	}
+}
+
+AddResult Batcher::add(const std::string &device, const char *lines, size_t length)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if(!running_){
+		return AddResult::Stopped;
+	}
+
+	auto found = devices_.find(device);
+	if(found == devices_.end()){
+		found = devices_.emplace(device, Device()).first;
+		found->second.stats.device = device;
+		found->second.window_start = Clock::now();
+	}
+	Device &source = found->second;
+
+	const size_t total = pending_bytes_ + inflight_bytes_;
+	if((source.stats.pending_bytes > 0 && source.stats.pending_bytes + length > config_.max_device_pending_bytes)
+			|| (total > 0 && total + length > config_.max_pending_bytes)){		//a single oversized add is let through
+		source.stats.blocked++;
+		stats_.blocked++;
+		return AddResult::Held;
+	}
+
+	const char *pos = lines;
+	const char *end = lines + length;
+	Measurement *measurement = nullptr;
+	const std::string *name = nullptr;
+	uint32_t points = 0;
+	size_t bytes = 0;
+
+	while(pos < end){
+		const char *newline = static_cast<const char *>(std::memchr(pos, '\n', end - pos));
+		const char *line_end = newline != nullptr ? newline : end;
+		const char *next = newline != nullptr ? newline + 1 : end;
+		if(line_end > pos && line_end[-1] == '\r'){
+			line_end--;
+		}
+		if(line_end == pos || *pos == '#'){
+			pos = next;
+			continue;
+		}
+
+		const char *name_end = measurementEnd(pos, line_end);
+		if(name == nullptr || name->compare(0, std::string::npos, pos, name_end - pos) != 0){	//the lines of a body mostly share one measurement
+			auto entry = pending_.emplace(std::string(pos, name_end), Measurement()).first;
+			name = &entry->first;
+			measurement = &entry->second;
+		}
+		const uint32_t line_length = static_cast<uint32_t>(line_end - pos + 1);
+		measurement->index.push_back(Line{lineTimestamp(pos, line_end), measurement->lines.size(), line_length});
+		measurement->lines.append(pos, line_end);
+		measurement->lines += '\n';
+		points++;
+		bytes += line_length;
+		pos = next;
+	}
+	if(points == 0){
+		return AddResult::Added;
+	}
+
+	roll(source, Clock::now());
+	source.stats.points += points;
+	source.stats.bytes += bytes;
+	source.stats.pending_bytes += bytes;
+	source.window_points += points;
+	source.window_bytes += bytes;
+	pending_shares_[&source] += bytes;
+
+	if(pending_points_ == 0){
+		deadline_ = Clock::now() + std::chrono::milliseconds(config_.batch_timeout_ms);
+	}
+	pending_bytes_ += bytes;
+	pending_points_ += points;
+	stats_.points_added += points;
+
+	if(pending_points_ == points || pending_points_ >= config_.batch_points){	//the writer starts the timeout or sends the full batch
+		ready_.notify_one();
+	}
+
+	return AddResult::Added;
+}
+
+BatcherStats Batcher::statistics()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	BatcherStats stats = stats_;
+	stats.pending_bytes = pending_bytes_ + inflight_bytes_;
+	return stats;
+}
+
+std::vector<DeviceStats> Batcher::deviceStatistics()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	std::vector<DeviceStats> devices;
+	Clock::time_point now = Clock::now();
+
+	devices.reserve(devices_.size());
+	for(auto &entry : devices_){
+		roll(entry.second, now);
+		devices.push_back(entry.second.stats);
+	}
+	return devices;
+}
+
+/**
+ * Closes the rate windows of a device that ended before now. The rates are those of the last closed window, or zero
+ * if the device added nothing during it.
+ */
+void Batcher::roll(Device &device, Clock::time_point now)
+{
+	const std::chrono::milliseconds window(config_.rate_window_ms);
+	const auto windows = (now - device.window_start) / window;
+	if(windows < 1){
+		return;
+	}
+
+	const double seconds = config_.rate_window_ms / 1000.0;
+	device.stats.points_per_second = windows == 1 ? device.window_points / seconds : 0.0;
+	device.stats.bytes_per_second = windows == 1 ? device.window_bytes / seconds : 0.0;
+	device.window_start += windows * window;
+	device.window_points = 0;
+	device.window_bytes = 0;
+}
+
+/**
+ * Writer thread. The batch is taken out of pending_ so the devices can continue while the requests are running.
+ */
+void Batcher::run()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	std::map<std::string, Measurement> batch;
+	std::string body;
+
+	while(true){
+		while(running_ && pending_points_ < config_.batch_points){
+			if(pending_points_ == 0){
+				ready_.wait(lock);
+			}else if(ready_.wait_until(lock, deadline_) == std::cv_status::timeout){
+				break;
+			}
+		}
+		if(pending_points_ == 0){
+			if(!running_){
+				return;
+			}
+			continue;
+		}
+
+		batch.swap(pending_);
+		pending_.clear();
+		inflight_shares_.swap(pending_shares_);
+		pending_shares_.clear();
+		inflight_bytes_ = pending_bytes_;
+		pending_bytes_ = 0;
+		pending_points_ = 0;
+
+		for(auto &entry : batch){
+			writeMeasurement(lock, entry.second, body);
+		}
+
+		for(const auto &share : inflight_shares_){
+			share.first->stats.pending_bytes -= share.second;
+		}
+		inflight_shares_.clear();
+		inflight_bytes_ = 0;
+		batch.clear();
+
+		if(space_listener_){
+			lock.unlock();
+			space_listener_();
+			lock.lock();
+		}
+	}
+}
+
+/**
+ * Sorts the lines of one measurement by their timestamps and writes them with requests of up to batch_points points.
+ * Called and returns with the lock held, the lock is released while sorting and writing.
+ */
+void Batcher::writeMeasurement(std::unique_lock<std::mutex> &lock, Measurement &measurement, std::string &body)
+{
+	lock.unlock();
+	std::stable_sort(measurement.index.begin(), measurement.index.end(), [](const Line &a, const Line &b){
+		return a.timestamp < b.timestamp;
+	});
+
+	for(size_t first = 0; first < measurement.index.size(); first += config_.batch_points){
+		const size_t last = std::min(first + config_.batch_points, measurement.index.size());
+		const uint32_t points = static_cast<uint32_t>(last - first);
+		body.clear();
+		for(size_t i = first; i < last; i++){
+			body.append(measurement.lines, measurement.index[i].offset, measurement.index[i].length);
+		}
+
+		int backoff_ms = 100;
+		while(true){
+			int status = write_(body);
+			lock.lock();
+
+			if(status >= 200 && status < 300){
+				stats_.batches++;
+				stats_.points_written += points;
+				stats_.bytes_written += body.size();
+				break;
+			}
+			stats_.failed_writes++;
+			if(!running_ || (status >= 400 && status < 500)){		//rejected lines will not be accepted on a retry
+				stats_.points_dropped += points;
+				break;
+			}
+			ready_.wait_for(lock, std::chrono::milliseconds(backoff_ms));
+			backoff_ms = std::min(backoff_ms * 2, config_.max_backoff_ms);
+			lock.unlock();
+		}
+		lock.unlock();
+	}
+	lock.lock();
+}
+
+} // namespace socketsense
@@ -0,0 +1,184 @@
+/**
+ * @file batcher.h
+ * @brief Collects the line protocol of all devices and writes it to InfluxDB in large, time-ordered batches.
+ *
+ * The lines are kept per measurement. A writer thread takes all pending lines once batch_points points are waiting,
+ * or batch_timeout_ms after the first pending point was added, sorts the lines of each measurement by their timestamp
+ * and writes them with requests of up to batch_points points. Sorted batches let InfluxDB append to its series
+ * instead of merging the interleaved points of many devices. Failed writes are repeated with an exponential backoff,
+ * the batch is kept meanwhile.
+ *
+ * add() does not block. It holds the lines back if the device already has max_device_pending_bytes waiting, or the
+ * gateway max_pending_bytes in total; the caller stops reading from that device and tries again when the space
+ * listener is called. So a device that sends faster than the database writes is slowed down through its
+ * acknowledgements, without taking the space of the other devices. The points and bytes of each device are counted
+ * and the ingest rates are measured over the last complete rate window.
+ *
+ * @date October 17. 2026
+ */
+#ifndef TOOLS_GATEWAY_BATCHER_H_
+#define TOOLS_GATEWAY_BATCHER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace socketsense {
+
+/**
+ * @brief Configuration of the batcher.
+ */
+struct BatcherConfig {
+	size_t batch_points = 5000;					//!< A batch is written once this many points are waiting, also the points per request
+	int batch_timeout_ms = 1000;				//!< A batch is written at the latest this long after its first point
+	size_t max_pending_bytes = 64 << 20;		//!< Lines are held back while more bytes are waiting in total
+	size_t max_device_pending_bytes = 4 << 20;	//!< Lines of a device are held back while more of its bytes are waiting
+	int max_backoff_ms = 5000;					//!< Upper bound of the delay between two attempts of a failed write
+	int rate_window_ms = 5000;					//!< Window of the ingest rates of the devices
+};
+
+/**
+ * @brief Statistics of the batcher.
+ */
+struct BatcherStats {
+	uint64_t points_added = 0;			//!< Points handed to the batcher
+	uint64_t points_written = 0;		//!< Points accepted by the database
+	uint64_t bytes_written = 0;			//!< Line protocol bytes accepted by the database
+	uint64_t batches = 0;				//!< Successful write requests
+	uint64_t failed_writes = 0;			//!< Write requests that failed or were rejected
+	uint64_t points_dropped = 0;		//!< Points of batches that were rejected by the database or could not be written at the stop
+	uint64_t blocked = 0;				//!< Calls of add() whose lines were held back
+	size_t pending_bytes = 0;			//!< Bytes waiting to be written
+};
+
+/**
+ * @brief Ingest of one device.
+ */
+struct DeviceStats {
+	std::string device;					//!< Name the device was added with
+	uint64_t points = 0;				//!< Points added
+	uint64_t bytes = 0;					//!< Line protocol bytes added
+	uint64_t blocked = 0;				//!< Calls of add() whose lines were held back
+	size_t pending_bytes = 0;			//!< Bytes waiting to be written
+	double points_per_second = 0.0;		//!< Points added during the last complete rate window
+	double bytes_per_second = 0.0;		//!< Bytes added during the last complete rate window
+};
+
+/**
+ * @brief Result of Batcher::add().
+ */
+enum class AddResult {
+	Added,								//!< The lines are pending
+	Held,								//!< The device or the gateway has too much pending, try again later
+	Stopped								//!< The batcher was stopped
+};
+
+/**
+ * @brief Writes one body, returns the HTTP status code or -1.
+ */
+using WriteFunction = std::function<int(const std::string &body)>;
+
+/**
+ * @brief Batches line protocol of several devices for one writer.
+ */
+class Batcher {
+public:
+	Batcher(const BatcherConfig &config, WriteFunction write);
+	~Batcher();
+
+	Batcher(const Batcher &) = delete;
+	Batcher &operator=(const Batcher &) = delete;
+
+	/**
+	 * @brief Sets the function that is called by the writer thread whenever pending bytes were written.
+	 *
+	 * Must be set before start(). The function must not call add().
+	 */
+	void setSpaceListener(std::function<void()> listener);
+
+	/**
+	 * @brief Starts the writer thread.
+	 */
+	void start();
+
+	/**
+	 * @brief Writes the remaining points (one attempt) and stops the writer thread.
+	 */
+	void stop();
+
+	/**
+	 * @brief Adds the lines of a device.
+	 *
+	 * The lines are separated by newlines, the last one does not need one. Carriage returns, empty lines and comments
+	 * are left out. If the device has nothing pending, its lines are added even if they exceed the limits.
+	 *
+	 * @param device Name of the device.
+	 * @param lines The lines.
+	 * @param length Length of the lines.
+	 * @return Whether the lines were added.
+	 */
+	AddResult add(const std::string &device, const char *lines, size_t length);
+
+	/**
+	 * @brief Returns the statistics.
+	 */
+	BatcherStats statistics();
+
+	/**
+	 * @brief Returns the ingest of every device that added lines, ordered by name.
+	 */
+	std::vector<DeviceStats> deviceStatistics();
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Line {
+		uint64_t timestamp;				//!< Timestamp of the point, UINT64_MAX for none (the database uses the time of the write)
+		size_t offset;					//!< Start in the lines of the measurement
+		uint32_t length;				//!< Length including the newline
+	};
+
+	struct Measurement {
+		std::string lines;
+		std::vector<Line> index;
+	};
+
+	struct Device {
+		DeviceStats stats;
+		Clock::time_point window_start;	//!< Start of the rate window being filled
+		uint64_t window_points = 0;		//!< Points added during that window
+		uint64_t window_bytes = 0;
+	};
+
+	void run();
+	void writeMeasurement(std::unique_lock<std::mutex> &lock, Measurement &measurement, std::string &body);
+	void roll(Device &device, Clock::time_point now);
+
+	BatcherConfig config_;
+	WriteFunction write_;
+	std::function<void()> space_listener_;
+	std::mutex mutex_;
+	std::condition_variable ready_;		//!< Signals the writer, a batch is full or the batcher stops
+	std::map<std::string, Measurement> pending_;	//!< Lines that wait for the next batch, by measurement
+	std::unordered_map<Device *, size_t> pending_shares_;	//!< Bytes of each device in pending_
+	size_t pending_bytes_ = 0;
+	uint32_t pending_points_ = 0;
+	Clock::time_point deadline_;		//!< Time the pending lines have to be written
+	std::unordered_map<Device *, size_t> inflight_shares_;	//!< Bytes of each device in the batch being written
+	size_t inflight_bytes_ = 0;			//!< Size of the batch the writer is working on
+	std::map<std::string, Device> devices_;
+	BatcherStats stats_;
+	bool running_ = false;
+	std::thread thread_;
+};
+
+} // namespace socketsense
+
+#endif /* TOOLS_GATEWAY_BATCHER_H_ */
@@ -0,0 +1,165 @@
+/**
+ * @file decode_benchmark.cpp
+ * @brief Throughput benchmark of the frame codec and of the conversion to line protocol.
+ *
+ * Synthetic frames with gait-like sensor values are encoded with the firmware encoder, then decoded and converted to
+ * line protocol like the gateway does it. For each step the points/s and the MB/s of the frames are reported, together
+ * with the size of the frames compared to the line protocol. The packed and the Gorilla encoding are measured one after
+ * the other.
+ *
+ *   decode_benchmark [-s strips] [-e sensels per strip] [-p points per frame] [-n frames]
+ *
+ * @date October 17. 2026
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "sample_frame.h"
+#include "ingest_server.h"
+#include "line_writer.h"
+
+using namespace socketsense;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void report(const char *name, double duration, uint64_t points, uint64_t bytes)
+{
+	std::printf("%-22s %10.0f points/s %9.1f MB/s %8.1f ns/point\n", name,
+			points / duration, bytes / duration / 1e6, duration * 1e9 / points);
+}
+
+void runEncoding(uint8_t encoding, unsigned sensors, unsigned sensels, unsigned points_per_frame, unsigned frames)
+{
+	const unsigned count = sensors * sensels;
+	const size_t capacity = SAMPLE_FRAME_HEADER_SIZE + points_per_frame * SAMPLE_FRAME_MAX_POINT_SIZE(count);
+	std::vector<uint8_t> buffer(capacity);
+	std::vector<std::vector<uint8_t>> encoded(frames);
+	std::vector<uint16_t> values(count);
+	sample_frame_t frame;
+	sample_frame_point_t point;
+	uint64_t frame_bytes = 0;
+	uint64_t total_points = static_cast<uint64_t>(frames) * points_per_frame;
+
+	sample_frame_init(&frame, buffer.data(), buffer.size(), sensors, sensels, encoding);
+	point.timestamp_usec = 1571234567890123ULL;
+	point.sensels = values.data();
+	point.sensel_mask = nullptr;
+
+	for(unsigned f = 0; f < frames; f++){								//recording used by the decode benchmarks
+		sample_frame_clear(&frame);
+		for(unsigned p = 0; p < points_per_frame; p++){
+			double t = point.timestamp_usec * 1e-6;
+			point.timestamp_usec += 10000 + (p % 7);							//10 ms period with some jitter
+			point.temperature = 25.0f + 0.01f * static_cast<float>(std::sin(t * 0.01));
+			point.humidity = 39.0f + 0.02f * static_cast<float>(std::sin(t * 0.02));
+			point.pressure = 100655.0f + static_cast<float>(std::sin(t * 0.005));
+			point.sampling_time = 2400 + (p % 50);
+			point.battery_voltage = 3950;
+			for(unsigned i = 0; i < count; i++){								//one step per second, phase shifted per sensel
+				double phase = std::fmod(t + i * 0.05, 1.0);
+				values[i] = static_cast<uint16_t>(phase < 0.6 ? 400 + 3000 * std::sin(phase / 0.6 * M_PI) : 400 + (i * 7) % 13);
+			}
+			sample_frame_append(&frame, &point);
+		}
+		size_t len = sample_frame_finish(&frame, f);
+		encoded[f].assign(buffer.begin(), buffer.begin() + len);
+		frame_bytes += len;
+	}
+
+	std::printf("%s: %u frames of %u points with %ux%u sensels, %.1f bytes/point\n",
+			encoding == SAMPLE_FRAME_ENCODING_GORILLA ? "gorilla" : "packed", frames, points_per_frame, sensors, sensels,
+			static_cast<double>(frame_bytes) / total_points);
+
+	// encode only, without generating the waveforms
+	auto start = Clock::now();
+	uint64_t encode_bytes = 0;
+	for(unsigned f = 0; f < frames; f++){
+		sample_frame_clear(&frame);
+		for(unsigned p = 0; p < points_per_frame; p++){
+			point.timestamp_usec += 10000;
+			values[p % count] ^= 1;
+			sample_frame_append(&frame, &point);
+		}
+		encode_bytes += sample_frame_finish(&frame, f);
+	}
+	report("encode", seconds(start), total_points, encode_bytes);
+
+	// decode only
+	sample_frame_header_t header;
+	sample_frame_decoder_t decoder;
+	std::vector<uint16_t> decoded(SAMPLE_FRAME_MAX_SENSELS);
+	uint64_t checksum = 0;
+	start = Clock::now();
+	for(const auto &data : encoded){
+		sample_frame_parseHeader(data.data(), data.size(), &header);
+		sample_frame_decoderInit(&decoder, &header, data.data() + SAMPLE_FRAME_HEADER_SIZE);
+		while(sample_frame_decodePoint(&decoder, &point, decoded.data()) == SAMPLE_FRAME_OK){
+			checksum += point.timestamp_usec + point.sensels[count - 1];
+		}
+	}
+	report("decode", seconds(start), total_points, frame_bytes);
+
+	// decode and convert to line protocol, like the gateway
+	LineWriter writer;
+	std::string lines;
+	uint64_t line_bytes = 0;
+	writer.setDevice("bench");
+	start = Clock::now();
+	for(const auto &data : encoded){
+		sample_frame_parseHeader(data.data(), data.size(), &header);
+		lines.clear();
+		decodeFrameToLines(header, data.data() + SAMPLE_FRAME_HEADER_SIZE, writer, lines);
+		line_bytes += lines.size();
+	}
+	report("decode + line protocol", seconds(start), total_points, frame_bytes);
+
+	std::printf("line protocol: %.1f bytes/point, frames are %.1fx smaller (checksum %llu)\n",
+			static_cast<double>(line_bytes) / total_points, static_cast<double>(line_bytes) / frame_bytes,
+			static_cast<unsigned long long>(checksum));
+	std::printf("\n");
+
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	unsigned sensors = 4;
+	unsigned sensels = 8;
+	unsigned points_per_frame = 50;
+	unsigned frames = 20000;
+	int opt;
+
+	while((opt = getopt(argc, argv, "s:e:p:n:")) != -1){
+		switch(opt){
+			case 's': sensors = std::atoi(optarg); break;
+			case 'e': sensels = std::atoi(optarg); break;
+			case 'p': points_per_frame = std::atoi(optarg); break;
+			case 'n': frames = std::atoi(optarg); break;
+			default:
+				std::fprintf(stderr, "Usage: %s [-s strips] [-e sensels] [-p points per frame] [-n frames]\n", argv[0]);
+				return 1;
+		}
+	}
+	if(sensors * sensels == 0 || sensors * sensels > SAMPLE_FRAME_MAX_SENSELS || points_per_frame == 0 || points_per_frame > UINT16_MAX){
+		std::fprintf(stderr, "Invalid geometry\n");
+		return 1;
+	}
+
+	runEncoding(SAMPLE_FRAME_ENCODING_PACKED, sensors, sensels, points_per_frame, frames);
+	runEncoding(SAMPLE_FRAME_ENCODING_GORILLA, sensors, sensels, points_per_frame, frames);
+
+	return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file gzip_codec.cpp
+ * @brief gzip compression of HTTP bodies (Content-Encoding: gzip) with zlib.
+ *
+ * @date October 17. 2026
+ */
+#include <cstring>
+#include <zlib.h>
+
+#include "gzip_codec.h"
+
+namespace socketsense {
+
+namespace {
+
+const int GZIP_WINDOW_BITS = 15 + 16;		//!< 32 kB window, gzip header instead of zlib
+const int GZIP_MEMORY_LEVEL = 8;
+
+} // namespace
+
+bool gzipCompress(const char *data, size_t length, int level, std::string &out)
+{
+	z_stream stream;
+	std::memset(&stream, 0, sizeof(stream));
+	if(deflateInit2(&stream, level, Z_DEFLATED, GZIP_WINDOW_BITS, GZIP_MEMORY_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK){
+		return false;
+	}
+
+	out.resize(deflateBound(&stream, length));
+	stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+	stream.avail_in = static_cast<uInt>(length);
+	stream.next_out = reinterpret_cast<Bytef *>(&out[0]);
+	stream.avail_out = static_cast<uInt>(out.size());
+	int result = deflate(&stream, Z_FINISH);							//the bound guarantees one call is enough
+	out.resize(stream.total_out);
+	deflateEnd(&stream);
+
+	return result == Z_STREAM_END;
+}
+
+bool gzipDecompress(const char *data, size_t length, std::string &out)
+{
+	z_stream stream;
+	std::memset(&stream, 0, sizeof(stream));
+	if(inflateInit2(&stream, GZIP_WINDOW_BITS) != Z_OK){
+		return false;
+	}
+
+	size_t produced = 0;																//total_out restarts with each member
+	int result = Z_OK;
+	out.resize(length * 4 + 4096);
+	stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+	stream.avail_in = static_cast<uInt>(length);
+	while(result != Z_STREAM_END || stream.avail_in > 0){
+		if(result == Z_STREAM_END){														//concatenated members
+			inflateReset(&stream);
+		}
+		if(produced == out.size()){
+			out.resize(out.size() * 2);
+		}
+		stream.next_out = reinterpret_cast<Bytef *>(&out[produced]);
+		stream.avail_out = static_cast<uInt>(out.size() - produced);
+		uInt available = stream.avail_in;
+		uInt space = stream.avail_out;
+		result = inflate(&stream, Z_NO_FLUSH);
+		produced += space - stream.avail_out;
+		if(result == Z_BUF_ERROR && stream.avail_out > 0 && stream.avail_in == 0){
+			break;																		//truncated input
+		}
+		if(result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR){
+			break;
+		}
+		if(result != Z_STREAM_END && stream.avail_in == available && stream.avail_out == space){
+			break;																		//no progress
+		}
+	}
+	out.resize(produced);
+	inflateEnd(&stream);
+
+	return result == Z_STREAM_END && stream.avail_in == 0;
+}
+
+} // namespace socketsense
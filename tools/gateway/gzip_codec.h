@@ -0,0 +1,41 @@
+/**
+ * @file gzip_codec.h
+ * @brief gzip compression of HTTP bodies (Content-Encoding: gzip) with zlib.
+ *
+ * InfluxDB accepts gzip compressed bodies on /write. Line protocol of the sensor elements compresses about fivefold
+ * even at level 1, which matters on the Wi-Fi of a ward or the uplink of the Pi.
+ *
+ * @date October 17. 2026
+ */
+#ifndef TOOLS_GATEWAY_GZIP_CODEC_H_
+#define TOOLS_GATEWAY_GZIP_CODEC_H_
+
+#include <cstddef>
+#include <string>
+
+namespace socketsense {
+
+/**
+ * @brief Compresses data into a gzip member.
+ *
+ * @param data Data.
+ * @param length Length of the data.
+ * @param level zlib compression level 1 (fastest) to 9 (smallest).
+ * @param out Replaced by the compressed data.
+ * @return False if zlib failed.
+ */
+bool gzipCompress(const char *data, size_t length, int level, std::string &out);
+
+/**
+ * @brief Decompresses one or more gzip members.
+ *
+ * @param data Compressed data.
+ * @param length Length of the compressed data.
+ * @param out Replaced by the decompressed data.
+ * @return False if the data is not complete and valid gzip.
+ */
+bool gzipDecompress(const char *data, size_t length, std::string &out);
+
+} // namespace socketsense
+
+#endif /* TOOLS_GATEWAY_GZIP_CODEC_H_ */
@@ -0,0 +1,234 @@
+/**
+ * @file influx_client.cpp
+ * @brief Minimal HTTP/1.1 client that posts line protocol to the /write endpoint of InfluxDB.
+ *
+ * @date October 17. 2026
+ */
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include "influx_client.h"
+
+namespace socketsense {
+
+InfluxClient::InfluxClient(const InfluxConfig &config) : config_(config)
+{
+	static const char HEX[] = "0123456789ABCDEF";
+	std::string device;
+	for(char c : config_.device){													//percent-encoded query parameter
+		if(std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_' || c == '.' || c == '~'){
+			device += c;
+		}else{
+			device += '%';
+			device += HEX[static_cast<unsigned char>(c) >> 4];
+			device += HEX[c & 0xF];
+		}
+	}
+	request_head_ = "POST /write?db=" + config_.database + "&precision=u" + (device.empty() ? "" : "&device=" + device)
+			+ " HTTP/1.1\r\n"
+			"Host: " + config_.host + ":" + std::to_string(config_.port) + "\r\n"
+			"Content-Type: text/plain\r\n";
+	if(!config_.username.empty()){
+		request_head_ += "Authorization: Basic " + base64Encode(config_.username + ":" + config_.password) + "\r\n";
+	}
+}
+
+InfluxClient::~InfluxClient()
+{
+	close();
+}
+
+int InfluxClient::write(const std::string &body, bool gzip)
+{
+	std::string head = request_head_ + (gzip ? "Content-Encoding: gzip\r\n" : "")
+			+ "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n";
+
+	for(int attempt = 0; attempt < 2; attempt++){
+		bool reused = socket_ >= 0;
+		if(!reused && !connect()){
+			return -1;
+		}
+
+		if(sendAll(head.data(), head.size()) && sendAll(body.data(), body.size())){
+			int status = readResponse();
+			if(status > 0){
+				return status;
+			}
+		}
+
+		close();											//drop the broken connection
+		if(!reused){
+			break;											//a fresh connection failed, repeating will not help
+		}
+	}
+
+	return -1;
+}
+
+void InfluxClient::close()
+{
+	if(socket_ >= 0){
+		::close(socket_);
+		socket_ = -1;
+	}
+	buffer_.clear();
+}
+
+bool InfluxClient::connect()
+{
+	struct sockaddr_in addr;
+	struct timeval timeout;
+	int flag = 1;
+
+	std::memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(config_.port);
+	if(inet_pton(AF_INET, config_.host.c_str(), &addr.sin_addr) != 1){
+		return false;
+	}
+
+	socket_ = ::socket(AF_INET, SOCK_STREAM, 0);
+	if(socket_ < 0){
+		return false;
+	}
+	timeout.tv_sec = config_.timeout_ms / 1000;
+	timeout.tv_usec = (config_.timeout_ms % 1000) * 1000;
+	setsockopt(socket_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+	setsockopt(socket_, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+	setsockopt(socket_, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+	if(::connect(socket_, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0){
+		close();
+		return false;
+	}
+	connects_++;
+
+	return true;
+}
+
+bool InfluxClient::sendAll(const char *data, size_t length)
+{
+	while(length > 0){
+		ssize_t sent = ::send(socket_, data, length, MSG_NOSIGNAL);
+		if(sent <= 0){
+			if(sent < 0 && errno == EINTR){
+				continue;
+			}
+			return false;
+		}
+		data += sent;
+		length -= sent;
+	}
+
+	return true;
+}
+
+/**
+ * Reads one response and returns its status code. The body is read according to Content-Length or chunked
+ * transfer encoding and discarded. The connection is closed if the server asked for it.
+ */
+int InfluxClient::readResponse()
+{
+	char chunk[4096];
+	size_t header_end;
+
+	while((header_end = buffer_.find("\r\n\r\n")) == std::string::npos){
+		ssize_t len = ::recv(socket_, chunk, sizeof(chunk), 0);
+		if(len <= 0){
+			return -1;
+		}
+		buffer_.append(chunk, len);
+	}
+
+	int status = -1;
+	if(buffer_.compare(0, 5, "HTTP/") == 0){
+		size_t space = buffer_.find(' ');
+		if(space != std::string::npos && space < header_end){
+			status = std::atoi(buffer_.c_str() + space + 1);
+		}
+	}
+
+	size_t content_length = 0;
+	bool chunked = false;
+	bool keep_alive = true;
+	size_t line = buffer_.find("\r\n") + 2;
+	while(line < header_end){
+		size_t next = buffer_.find("\r\n", line);
+		const char *header = buffer_.c_str() + line;
+		if(strncasecmp(header, "Content-Length:", 15) == 0){
+			content_length = std::strtoul(header + 15, nullptr, 10);
+		}else if(strncasecmp(header, "Transfer-Encoding:", 18) == 0 && std::strstr(header, "chunked") != nullptr){
+			chunked = true;
+		}else if(strncasecmp(header, "Connection:", 11) == 0 && std::strstr(header, "close") != nullptr){
+			keep_alive = false;
+		}
+		line = next + 2;
+	}
+	buffer_.erase(0, header_end + 4);
+
+	if(chunked){												//read until the terminating zero length chunk
+		while(buffer_.find("\r\n0\r\n\r\n") == std::string::npos && buffer_.compare(0, 5, "0\r\n\r\n") != 0){
+			ssize_t len = ::recv(socket_, chunk, sizeof(chunk), 0);
+			if(len <= 0){
+				return -1;
+			}
+			buffer_.append(chunk, len);
+		}
+		buffer_.clear();
+	}else{
+		while(buffer_.size() < content_length){
+			ssize_t len = ::recv(socket_, chunk, sizeof(chunk), 0);
+			if(len <= 0){
+				return -1;
+			}
+			buffer_.append(chunk, len);
+		}
+		buffer_.erase(0, content_length);
+	}
+
+	if(!keep_alive){
+		close();
+	}
+
+	return status;
+}
+
+std::string base64Encode(const std::string &input)
+{
+	static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	std::string output;
+	size_t i = 0;
+
+	for(; i + 2 < input.size(); i += 3){
+		uint32_t v = (uint8_t) input[i] << 16 | (uint8_t) input[i + 1] << 8 | (uint8_t) input[i + 2];
+		output += alphabet[v >> 18];
+		output += alphabet[(v >> 12) & 0x3F];
+		output += alphabet[(v >> 6) & 0x3F];
+		output += alphabet[v & 0x3F];
+	}
+	if(i + 1 == input.size()){
+		uint32_t v = (uint8_t) input[i] << 16;
+		output += alphabet[v >> 18];
+		output += alphabet[(v >> 12) & 0x3F];
+		output += "==";
+	}else if(i + 2 == input.size()){
+		uint32_t v = (uint8_t) input[i] << 16 | (uint8_t) input[i + 1] << 8;
+		output += alphabet[v >> 18];
+		output += alphabet[(v >> 12) & 0x3F];
+		output += alphabet[(v >> 6) & 0x3F];
+		output += '=';
+	}
+
+	return output;
+}
+
+} // namespace socketsense
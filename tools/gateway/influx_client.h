@@ -0,0 +1,80 @@
+/**
+ * @file influx_client.h
+ * @brief Minimal HTTP/1.1 client that posts line protocol to the /write endpoint of InfluxDB.
+ *
+ * The connection is kept alive between requests and reopened when the server closes it.
+ *
+ * @date October 17. 2026
+ */
+#ifndef TOOLS_GATEWAY_INFLUX_CLIENT_H_
+#define TOOLS_GATEWAY_INFLUX_CLIENT_H_
+
+#include <string>
+
+namespace socketsense {
+
+/**
+ * @brief Address and credentials of an InfluxDB instance.
+ */
+struct InfluxConfig {
+	std::string host = "127.0.0.1";		//!< IPv4 address of the server
+	int port = 8086;						//!< Port of the HTTP API
+	std::string database = "SOCKET_SENSE";	//!< Database the points are written to (see scripts/install_influx.sh)
+	std::string username;					//!< User, no authentication if empty
+	std::string password;					//!< Password of the user
+	int timeout_ms = 10000;					//!< Timeout of connecting, sending and receiving
+	std::string device;						//!< Sent as device query parameter like the firmware does, empty for none
+};
+
+/**
+ * @brief Posts line protocol bodies over one keep-alive connection.
+ */
+class InfluxClient {
+public:
+	explicit InfluxClient(const InfluxConfig &config);
+	~InfluxClient();
+
+	InfluxClient(const InfluxClient &) = delete;
+	InfluxClient &operator=(const InfluxClient &) = delete;
+
+	/**
+	 * @brief Posts one body to /write.
+	 *
+	 * If the request fails on a reused connection, it is repeated once on a new connection.
+	 *
+	 * @param body Line protocol with microsecond timestamps.
+	 * @param gzip The body is gzip compressed (see gzip_codec.h).
+	 * @return The HTTP status code, or -1 if no response was received.
+	 */
+	int write(const std::string &body, bool gzip = false);
+
+	/**
+	 * @brief Closes the connection.
+	 */
+	void close();
+
+	/**
+	 * @brief Number of connections that have been opened.
+	 */
+	unsigned connects() const { return connects_; }
+
+private:
+	bool connect();
+	bool sendAll(const char *data, size_t length);
+	int readResponse();
+
+	InfluxConfig config_;
+	std::string request_head_;		//!< Request line and constant headers
+	std::string buffer_;			//!< Received bytes of the current response
+	int socket_ = -1;
+	unsigned connects_ = 0;
+};
+
+/**
+ * @brief Encodes a string in base64, used for the basic authentication.
+ */
+std::string base64Encode(const std::string &input);
+
+} // namespace socketsense
+
+#endif /* TOOLS_GATEWAY_INFLUX_CLIENT_H_ */
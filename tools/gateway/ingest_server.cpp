@@ -0,0 +1,899 @@
+/**
+ * @file ingest_server.cpp
+ * @brief TCP server that receives the points of many devices, as binary sample frames or as InfluxDB writes.
+ *
+ * A connection collects the received bytes in its input and processes every complete frame or request in it. The
+ * lines of a message stay in the connection together with its acknowledgement until the batcher accepted them;
+ * meanwhile the socket is only registered for writing, so the kernel buffers fill up and the device has to wait.
+ *
+ * @date October 17. 2026
+ */
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <strings.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include "gzip_codec.h"
+#include "ingest_server.h"
+
+namespace socketsense {
+
+namespace {
+
+const size_t MAX_HEAD = 16384;				//!< Longest accepted request head
+const size_t MAX_BODY = 64 << 20;			//!< Largest accepted body
+const size_t MAX_OUTPUT = 65536;			//!< A connection is not read while more answers wait to be sent
+const size_t READ_SIZE = 65536;				//!< Bytes per recv()
+const size_t READ_BUDGET = 4 * READ_SIZE;	//!< Bytes read from one connection per event, so a fast device can't starve its group
+const int MAX_EVENTS = 64;
+
+/**
+ * Head of an HTTP request, as far as the gateway needs it.
+ */
+struct Request {
+	std::string method;
+	std::string target;
+	size_t content_length = 0;
+	bool has_length = false;
+	bool gzip = false;
+	bool chunked = false;
+	bool close = false;						//!< The connection is closed after the answer
+};
+
+bool hasPrefix(const std::string &header, const char *prefix)
+{
+	return strncasecmp(header.c_str(), prefix, std::strlen(prefix)) == 0;
+}
+
+/**
+ * Parses the request line and the headers, the head ends before the empty line. Returns false if the request line is
+ * invalid.
+ */
+bool parseHead(const std::string &head, Request &request)
+{
+	const size_t line_end = std::min(head.find("\r\n"), head.size());
+	const size_t method_end = head.find(' ');
+	const size_t target_end = head.find(' ', method_end + 1);
+	if(method_end == std::string::npos || target_end == std::string::npos || target_end >= line_end){
+		return false;
+	}
+	request.method = head.substr(0, method_end);
+	request.target = head.substr(method_end + 1, target_end - method_end - 1);
+	request.close = head.compare(target_end + 1, line_end - target_end - 1, "HTTP/1.0") == 0;
+
+	size_t pos = line_end;
+	while(pos < head.size()){
+		pos += 2;
+		const size_t next = std::min(head.find("\r\n", pos), head.size());
+		const std::string header = head.substr(pos, next - pos);
+		if(hasPrefix(header, "Content-Length:")){
+			request.content_length = std::strtoul(header.c_str() + 15, nullptr, 10);
+			request.has_length = true;
+		}else if(hasPrefix(header, "Content-Encoding:")){
+			request.gzip = header.find("gzip") != std::string::npos;
+		}else if(hasPrefix(header, "Transfer-Encoding:")){
+			request.chunked = header.find("chunked") != std::string::npos;
+		}else if(hasPrefix(header, "Connection:")){
+			request.close = header.find("close") != std::string::npos
+					|| (request.close && header.find("eep-alive") == std::string::npos);	//HTTP/1.0 closes unless asked not to
+		}
+		pos = next;
+	}
+
+	return true;
+}
+
+int hexDigit(char c)
+{
+	if(c >= '0' && c <= '9'){
+		return c - '0';
+	}
+	c |= 0x20;
+	return c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1;
+}
+
+/**
+ * Looks up a parameter of the query string and decodes it, returns false if the target has no such parameter.
+ */
+bool queryParameter(const std::string &target, const char *name, std::string &value)
+{
+	const size_t name_length = std::strlen(name);
+	size_t pos = target.find('?');
+
+	while(pos != std::string::npos){
+		pos++;
+		const size_t end = std::min(target.find('&', pos), target.size());
+		if(target.compare(pos, name_length, name) == 0 && pos + name_length < end && target[pos + name_length] == '='){
+			value.clear();
+			for(size_t i = pos + name_length + 1; i < end; i++){
+				if(target[i] == '%' && i + 2 < end && hexDigit(target[i + 1]) >= 0 && hexDigit(target[i + 2]) >= 0){
+					value += static_cast<char>(hexDigit(target[i + 1]) * 16 + hexDigit(target[i + 2]));
+					i += 2;
+				}else{
+					value += target[i] == '+' ? ' ' : target[i];
+				}
+			}
+			return true;
+		}
+		pos = end < target.size() ? end : std::string::npos;
+	}
+
+	return false;
+}
+
+std::string response(int status, const char *reason, const std::string &body, bool close)
+{
+	std::string response = "HTTP/1.1 " + std::to_string(status) + " " + reason + "\r\nX-Influxdb-Version: socketsense-gateway\r\n";
+	if(close){
+		response += "Connection: close\r\n";
+	}
+	if(status != 204){
+		response += "Content-Type: application/json\r\nContent-Length: " + std::to_string(body.size()) + "\r\n";
+	}
+	response += "\r\n";
+	response += body;
+	return response;
+}
+
+std::string errorResponse(int status, const char *reason, const char *message, bool close)
+{
+	return response(status, reason, std::string("{\"error\":\"") + message + "\"}", close);
+}
+
+std::string jsonString(const std::string &value)
+{
+	std::string json = "\"";
+	char escaped[8];
+	for(char c : value){
+		if(c == '"' || c == '\\'){
+			json += '\\';
+			json += c;
+		}else if(static_cast<unsigned char>(c) < 0x20){
+			std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+			json += escaped;
+		}else{
+			json += c;
+		}
+	}
+	return json + "\"";
+}
+
+/**
+ * Appends the lines of a line protocol body with the device tag, empty lines and comments are left out. Returns the
+ * number of points.
+ */
+uint64_t appendLines(std::string &out, const char *body, size_t length, const std::string &tag)
+{
+	const char *pos = body;
+	const char *end = body + length;
+	uint64_t points = 0;
+
+	while(pos < end){
+		const char *newline = static_cast<const char *>(std::memchr(pos, '\n', end - pos));
+		const char *line_end = newline != nullptr ? newline : end;
+		const char *next = newline != nullptr ? newline + 1 : end;
+		if(line_end > pos && line_end[-1] == '\r'){
+			line_end--;
+		}
+		if(line_end > pos && *pos != '#'){
+			LineWriter::appendTagged(out, pos, line_end, tag);
+			points++;
+		}
+		pos = next;
+	}
+
+	return points;
+}
+
+void signalEvent(int event)
+{
+	uint64_t one = 1;
+	ssize_t written = ::write(event, &one, sizeof(one));
+	(void) written;													//a pending signal is as good as a new one
+}
+
+} // namespace
+
+int decodeFrameToLines(const sample_frame_header_t &header, const uint8_t *payload, LineWriter &writer, std::string &out)
+{
+	sample_frame_decoder_t decoder;
+	sample_frame_point_t point;
+	uint16_t sensels[SAMPLE_FRAME_MAX_SENSELS];
+	int points = 0;
+	int result;
+
+	size_t start = out.size();
+	out.resize(start + header.point_count * writer.maxLineLength(header.sensor_count, header.sensel_count));
+	char *pos = &out[start];
+
+	sample_frame_decoderInit(&decoder, &header, payload);
+	while((result = sample_frame_decodePoint(&decoder, &point, sensels)) == SAMPLE_FRAME_OK){
+		pos = writer.write(pos, point, header.sensor_count, header.sensel_count);
+		points++;
+	}
+	out.resize(pos - out.data());
+
+	return result == SAMPLE_FRAME_END ? points : -1;
+}
+
+/**
+ * State of one device connection, only used by the thread of its worker.
+ */
+struct IngestServer::Connection {
+	int sock = -1;
+	Protocol protocol = Protocol::Frames;
+	std::string peer;					//!< Address of the device
+	std::string device;					//!< Name the lines are added to the batcher with
+	std::string input;					//!< Received bytes
+	size_t consumed = 0;				//!< Processed bytes at the start of input
+	std::string lines;					//!< Lines of the current message, kept while the batcher holds them back
+	std::string reply;					//!< Acknowledgement or answer of the current message
+	std::string output;					//!< Bytes waiting to be sent
+	LineWriter writer;					//!< Writer with the device tag of the hello frame
+	std::string tag;					//!< Device tag of the hello frame for the lines of lines frames
+	uint32_t events = 0;				//!< Events the socket is registered for
+	bool held = false;					//!< The batcher held lines back, nothing is read until they are accepted
+	bool closing = false;				//!< Closed once the output is sent
+};
+
+/**
+ * A worker thread with its group of connections.
+ */
+struct IngestServer::Worker {
+	int epoll = -1;
+	int event = -1;											//!< Signals new connections, the stop and space in the batcher
+	std::thread thread;
+	std::mutex mutex;										//!< Guards incoming and stats
+	std::vector<std::unique_ptr<Connection>> incoming;		//!< Accepted connections that are not attached yet
+	IngestServerStats stats;
+	std::atomic<bool> retry{false};							//!< The batcher has space, held connections try again
+	std::map<int, std::unique_ptr<Connection>> connections;
+	std::vector<char> buffer = std::vector<char>(READ_SIZE);
+	std::string inflated;									//!< Decompressed body of a write
+};
+
+IngestServer::IngestServer(const IngestServerConfig &config, Batcher &batcher) : config_(config), batcher_(batcher)
+{
+}
+
+IngestServer::~IngestServer()
+{
+	stop();
+}
+
+bool IngestServer::start()
+{
+	unsigned count = config_.workers > 0 ? config_.workers : std::max(std::thread::hardware_concurrency(), 1U);
+	bool ok = (stop_event_ = eventfd(0, EFD_CLOEXEC)) >= 0;
+
+	ok = ok && (config_.frame_port < 0 || listenOn(config_.frame_port, frame_socket_, frame_port_));
+	ok = ok && (config_.http_port < 0 || listenOn(config_.http_port, http_socket_, http_port_));
+	for(unsigned i = 0; ok && i < count; i++){
+		std::unique_ptr<Worker> worker(new Worker());
+		struct epoll_event event = {};
+		worker->epoll = epoll_create1(EPOLL_CLOEXEC);
+		worker->event = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		event.events = EPOLLIN;
+		event.data.fd = worker->event;
+		ok = worker->epoll >= 0 && worker->event >= 0 && epoll_ctl(worker->epoll, EPOLL_CTL_ADD, worker->event, &event) == 0;
+		workers_.push_back(std::move(worker));
+	}
+	if(!ok){
+		release();
+		return false;
+	}
+
+	running_ = true;
+	for(auto &worker : workers_){
+		worker->thread = std::thread(&IngestServer::work, this, std::ref(*worker));
+	}
+	accept_thread_ = std::thread(&IngestServer::acceptLoop, this);
+
+	return true;
+}
+
+void IngestServer::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if(!running_.exchange(false)){
+			return;
+		}
+	}
+
+	signalEvent(stop_event_);
+	accept_thread_.join();
+	for(auto &worker : workers_){
+		signalEvent(worker->event);								//the workers close their connections
+	}
+	for(auto &worker : workers_){
+		worker->thread.join();
+	}
+	release();
+}
+
+void IngestServer::wake()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if(!running_){
+		return;
+	}
+	for(auto &worker : workers_){
+		worker->retry = true;
+		signalEvent(worker->event);
+	}
+}
+
+IngestServerStats IngestServer::statistics()
+{
+	IngestServerStats total;
+
+	for(auto &worker : workers_){
+		std::lock_guard<std::mutex> lock(worker->mutex);
+		const IngestServerStats &stats = worker->stats;
+		total.connections += stats.connections;
+		total.active += stats.active;
+		total.frames += stats.frames;
+		total.frame_bytes += stats.frame_bytes;
+		total.requests += stats.requests;
+		total.writes += stats.writes;
+		total.write_bytes += stats.write_bytes;
+		total.points += stats.points;
+		total.line_bytes += stats.line_bytes;
+		total.held += stats.held;
+		total.invalid += stats.invalid;
+	}
+
+	return total;
+}
+
+bool IngestServer::listenOn(int port, int &sock, int &bound)
+{
+	struct sockaddr_in addr;
+	socklen_t length = sizeof(addr);
+	int flag = 1;
+
+	sock = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if(sock < 0){
+		return false;
+	}
+	setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+
+	std::memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(port);
+	addr.sin_addr.s_addr = htonl(config_.loopback ? INADDR_LOOPBACK : INADDR_ANY);
+
+	if(bind(sock, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0 || listen(sock, 128) != 0
+			|| getsockname(sock, reinterpret_cast<struct sockaddr *>(&addr), &length) != 0){
+		std::fprintf(stderr, "Can't listen on port %d: %s\n", port, std::strerror(errno));
+		return false;
+	}
+	bound = ntohs(addr.sin_port);
+
+	return true;
+}
+
+/**
+ * Closes the sockets and descriptors of the server, after the threads ended or if the start failed.
+ */
+void IngestServer::release()
+{
+	for(int *fd : {&frame_socket_, &http_socket_, &stop_event_}){
+		if(*fd >= 0){
+			::close(*fd);
+			*fd = -1;
+		}
+	}
+	for(auto &worker : workers_){
+		if(worker->epoll >= 0){
+			::close(worker->epoll);
+		}
+		if(worker->event >= 0){
+			::close(worker->event);
+		}
+	}
+	workers_.clear();
+}
+
+void IngestServer::acceptLoop()
+{
+	struct pollfd fds[3] = {{stop_event_, POLLIN, 0}, {frame_socket_, POLLIN, 0}, {http_socket_, POLLIN, 0}};
+
+	while(running_){
+		if(poll(fds, 3, -1) < 0){											//disabled ports have a negative descriptor and are ignored
+			if(errno == EINTR){
+				continue;
+			}
+			break;
+		}
+		if(fds[0].revents != 0){
+			break;
+		}
+		if(fds[1].revents & POLLIN){
+			acceptFrom(frame_socket_, Protocol::Frames);
+		}
+		if(fds[2].revents & POLLIN){
+			acceptFrom(http_socket_, Protocol::Http);
+		}
+	}
+}
+
+/**
+ * Accepts the waiting connections and hands them to the workers round robin.
+ */
+void IngestServer::acceptFrom(int listen_socket, Protocol protocol)
+{
+	struct sockaddr_in addr;
+	char address[INET_ADDRSTRLEN];
+	int flag = 1;
+
+	while(true){
+		socklen_t length = sizeof(addr);
+		int sock = ::accept4(listen_socket, reinterpret_cast<struct sockaddr *>(&addr), &length, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if(sock < 0){
+			return;
+		}
+		setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+		std::unique_ptr<Connection> connection(new Connection());
+		connection->sock = sock;
+		connection->protocol = protocol;
+		connection->peer = inet_ntop(AF_INET, &addr.sin_addr, address, sizeof(address)) != nullptr ? address : "unknown";
+		connection->device = connection->peer;
+
+		Worker &worker = *workers_[next_worker_++ % workers_.size()];
+		{
+			std::lock_guard<std::mutex> lock(worker.mutex);
+			worker.incoming.push_back(std::move(connection));
+			worker.stats.connections++;
+			worker.stats.active++;
+		}
+		signalEvent(worker.event);
+	}
+}
+
+/**
+ * Worker thread, serves its connections until the server stops.
+ */
+void IngestServer::work(Worker &worker)
+{
+	struct epoll_event events[MAX_EVENTS];
+
+	while(running_){
+		int count = epoll_wait(worker.epoll, events, MAX_EVENTS, -1);
+		if(count < 0){
+			if(errno == EINTR){
+				continue;
+			}
+			break;
+		}
+
+		for(int i = 0; i < count; i++){
+			if(events[i].data.fd == worker.event){
+				uint64_t value;
+				ssize_t length = ::read(worker.event, &value, sizeof(value));
+				(void) length;
+				attach(worker);
+				if(worker.retry.exchange(false)){
+					retryHeld(worker);
+				}
+				continue;
+			}
+
+			auto found = worker.connections.find(events[i].data.fd);
+			if(found == worker.connections.end()){
+				continue;													//closed by an earlier event of this round
+			}
+			Connection &connection = *found->second;
+			bool open = (events[i].events & EPOLLERR) == 0;
+			if(open && (events[i].events & EPOLLOUT)){
+				open = send(connection) && process(worker, connection);	//answers were sent, go on with the buffered requests
+			}
+			if(open && (events[i].events & (EPOLLIN | EPOLLHUP))){
+				open = !connection.held && receive(worker, connection);
+			}
+			if(open){
+				update(worker, connection);
+			}else{
+				close(worker, connection);
+			}
+		}
+	}
+
+	attach(worker);
+	while(!worker.connections.empty()){
+		close(worker, *worker.connections.begin()->second);
+	}
+}
+
+/**
+ * Registers the connections the accept thread handed over.
+ */
+void IngestServer::attach(Worker &worker)
+{
+	std::vector<std::unique_ptr<Connection>> incoming;
+	{
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		incoming.swap(worker.incoming);
+	}
+
+	for(auto &connection : incoming){
+		struct epoll_event event = {};
+		event.events = EPOLLIN;
+		event.data.fd = connection->sock;
+		connection->events = EPOLLIN;
+		int sock = connection->sock;
+		worker.connections[sock] = std::move(connection);
+		if(epoll_ctl(worker.epoll, EPOLL_CTL_ADD, sock, &event) != 0){
+			close(worker, *worker.connections[sock]);
+		}
+	}
+}
+
+/**
+ * Reads what the device sent and processes it, returns false if the connection has to be closed.
+ */
+bool IngestServer::receive(Worker &worker, Connection &connection)
+{
+	size_t budget = READ_BUDGET;
+	bool eof = false;
+
+	while(budget > 0){
+		ssize_t length = ::recv(connection.sock, worker.buffer.data(), worker.buffer.size(), 0);
+		if(length > 0){
+			connection.input.append(worker.buffer.data(), length);
+			budget -= std::min(budget, static_cast<size_t>(length));
+			if(static_cast<size_t>(length) < worker.buffer.size()){
+				break;															//drained, level triggered epoll reports more
+			}
+		}else if(length == 0){
+			eof = true;
+			break;
+		}else if(errno == EINTR){
+			continue;
+		}else if(errno == EAGAIN || errno == EWOULDBLOCK){
+			break;
+		}else{
+			return false;
+		}
+	}
+
+	return process(worker, connection) && !eof;
+}
+
+/**
+ * Processes the complete messages in the input and sends the answers, returns false if the connection has to be
+ * closed.
+ */
+bool IngestServer::process(Worker &worker, Connection &connection)
+{
+	bool open = connection.protocol == Protocol::Frames ? processFrames(worker, connection) : processHttp(worker, connection);
+	if(connection.consumed > 0){
+		connection.input.erase(0, connection.consumed);
+		connection.consumed = 0;
+	}
+	return open && send(connection);
+}
+
+bool IngestServer::processFrames(Worker &worker, Connection &connection)
+{
+	sample_frame_header_t header;
+
+	while(!connection.held && connection.output.size() < MAX_OUTPUT){
+		const uint8_t *data = reinterpret_cast<const uint8_t *>(connection.input.data()) + connection.consumed;
+		const size_t available = connection.input.size() - connection.consumed;
+		if(available < SAMPLE_FRAME_HEADER_SIZE){
+			break;
+		}
+		if(sample_frame_parseHeader(data, SAMPLE_FRAME_HEADER_SIZE, &header) != SAMPLE_FRAME_OK){
+			countInvalid(worker);
+			return false;
+		}
+		if(available - SAMPLE_FRAME_HEADER_SIZE < header.payload_length){
+			break;
+		}
+		const uint8_t *payload = data + SAMPLE_FRAME_HEADER_SIZE;
+		connection.consumed += SAMPLE_FRAME_HEADER_SIZE + header.payload_length;
+
+		if(header.type == SAMPLE_FRAME_TYPE_HELLO){
+			std::string uid(payload, payload + header.payload_length);
+			connection.writer.setDevice(uid);
+			connection.tag = LineWriter::deviceTag(uid);
+			connection.device = uid.empty() ? connection.peer : uid;
+			continue;
+		}
+
+		connection.lines.clear();
+		int points;
+		if(header.type == SAMPLE_FRAME_TYPE_LINES){
+			points = static_cast<int>(appendLines(connection.lines, reinterpret_cast<const char *>(payload),
+					header.payload_length, connection.tag));
+		}else{
+			points = decodeFrameToLines(header, payload, connection.writer, connection.lines);
+		}
+		if(points < 0){
+			countInvalid(worker);
+			return false;
+		}
+		{
+			std::lock_guard<std::mutex> lock(worker.mutex);
+			worker.stats.frames++;
+			worker.stats.frame_bytes += SAMPLE_FRAME_HEADER_SIZE + header.payload_length;
+			worker.stats.points += points;
+			worker.stats.line_bytes += connection.lines.size();
+		}
+
+		connection.reply.resize(SAMPLE_FRAME_ACK_SIZE);
+		for(int i = 0; i < SAMPLE_FRAME_ACK_SIZE; i++){
+			connection.reply[i] = static_cast<char>(header.sequence >> (8 * i));
+		}
+		if(!submit(worker, connection)){
+			return false;												//the gateway stops, the frame is not acknowledged
+		}
+	}
+
+	return true;
+}
+
+bool IngestServer::processHttp(Worker &worker, Connection &connection)
+{
+	Request request;
+
+	while(!connection.held && !connection.closing && connection.output.size() < MAX_OUTPUT){
+		const size_t head_end = connection.input.find("\r\n\r\n", connection.consumed);
+		if(head_end == std::string::npos){
+			if(connection.input.size() - connection.consumed > MAX_HEAD){
+				connection.output += errorResponse(431, "Request Header Fields Too Large", "request head too large", true);
+				connection.closing = true;
+				countInvalid(worker);
+			}
+			break;
+		}
+
+		request = Request();
+		if(!parseHead(connection.input.substr(connection.consumed, head_end - connection.consumed), request)){
+			connection.output += errorResponse(400, "Bad Request", "invalid request line", true);
+			connection.closing = true;
+			countInvalid(worker);
+			break;
+		}
+		const std::string path = request.target.substr(0, request.target.find('?'));
+		const bool write = request.method == "POST" && path == "/write";
+		if(write && (request.chunked || !request.has_length)){
+			connection.output += errorResponse(411, "Length Required", "length required", true);
+			connection.closing = true;
+			countInvalid(worker);
+			break;
+		}
+		if(request.content_length > MAX_BODY){
+			connection.output += errorResponse(413, "Request Entity Too Large", "body too large", true);
+			connection.closing = true;
+			countInvalid(worker);
+			break;
+		}
+		const size_t body_start = head_end + 4;
+		if(connection.input.size() - body_start < request.content_length){
+			break;
+		}
+		connection.consumed = body_start + request.content_length;
+		connection.closing = request.close;
+		{
+			std::lock_guard<std::mutex> lock(worker.mutex);
+			worker.stats.requests++;
+		}
+
+		if(write){
+			if(!handleWrite(worker, connection, request.target, connection.input.data() + body_start, request.content_length,
+					request.gzip, request.close)){
+				return false;
+			}
+		}else if(path == "/ping" && (request.method == "GET" || request.method == "HEAD")){
+			connection.output += response(204, "No Content", std::string(), request.close);
+		}else if(path == "/stats" && request.method == "GET"){
+			connection.output += response(200, "OK", statsJson(), request.close);
+		}else{
+			connection.output += errorResponse(404, "Not Found", "not found", request.close);
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Hands the lines of a write to the batcher. The lines get the device tag of the device query parameter if they have
+ * none; the gateway writes with microseconds, so other precisions are rejected.
+ */
+bool IngestServer::handleWrite(Worker &worker, Connection &connection, const std::string &target, const char *body, size_t length,
+		bool gzip, bool close)
+{
+	std::string precision;
+	std::string device;
+
+	if(!queryParameter(target, "precision", precision) || precision != "u"){
+		connection.output += errorResponse(400, "Bad Request", "the gateway accepts precision=u only", close);
+		return true;
+	}
+	if(gzip){
+		if(!gzipDecompress(body, length, worker.inflated)){
+			connection.output += errorResponse(400, "Bad Request", "invalid gzip body", close);
+			return true;
+		}
+		body = worker.inflated.data();
+		length = worker.inflated.size();
+	}
+	queryParameter(target, "device", device);
+	connection.device = device.empty() ? connection.peer : device;
+
+	connection.lines.clear();
+	const uint64_t points = appendLines(connection.lines, body, length, LineWriter::deviceTag(device));
+	{
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		worker.stats.writes++;
+		worker.stats.write_bytes += length;
+		worker.stats.points += points;
+		worker.stats.line_bytes += connection.lines.size();
+	}
+
+	connection.reply = response(204, "No Content", std::string(), close);
+	return submit(worker, connection);
+}
+
+/**
+ * Statistics of the server and the batcher with the ingest of every device.
+ */
+std::string IngestServer::statsJson()
+{
+	IngestServerStats server = statistics();
+	BatcherStats batcher = batcher_.statistics();
+	char rates[96];
+
+	std::string json = "{\"connections\":" + std::to_string(server.active) + ",\"frames\":" + std::to_string(server.frames)
+			+ ",\"writes\":" + std::to_string(server.writes) + ",\"points\":" + std::to_string(server.points)
+			+ ",\"points_written\":" + std::to_string(batcher.points_written) + ",\"batches\":" + std::to_string(batcher.batches)
+			+ ",\"failed_writes\":" + std::to_string(batcher.failed_writes) + ",\"points_dropped\":"
+			+ std::to_string(batcher.points_dropped) + ",\"pending_bytes\":" + std::to_string(batcher.pending_bytes)
+			+ ",\"devices\":[";
+	for(const DeviceStats &device : batcher_.deviceStatistics()){
+		std::snprintf(rates, sizeof(rates), ",\"points_per_second\":%.1f,\"bytes_per_second\":%.0f}",
+				device.points_per_second, device.bytes_per_second);
+		json += (json.back() == '[' ? "{\"device\":" : ",{\"device\":") + jsonString(device.device)
+				+ ",\"points\":" + std::to_string(device.points) + ",\"bytes\":" + std::to_string(device.bytes)
+				+ ",\"blocked\":" + std::to_string(device.blocked) + ",\"pending_bytes\":" + std::to_string(device.pending_bytes)
+				+ rates;
+	}
+	return json + "]}";
+}
+
+/**
+ * Hands the lines of the current message to the batcher and queues its answer, or holds the connection if the batcher
+ * holds the lines back. Returns false if the batcher was stopped.
+ */
+bool IngestServer::submit(Worker &worker, Connection &connection)
+{
+	if(!connection.lines.empty()){
+		AddResult result = batcher_.add(connection.device, connection.lines.data(), connection.lines.size());
+		if(result == AddResult::Stopped){
+			return false;
+		}
+		if(result == AddResult::Held){
+			connection.held = true;
+			std::lock_guard<std::mutex> lock(worker.mutex);
+			worker.stats.held++;
+			return true;
+		}
+	}
+
+	connection.output += connection.reply;
+	connection.lines.clear();
+	return true;
+}
+
+/**
+ * Tries again to hand the held lines to the batcher, the connections that succeed go on with their buffered input.
+ */
+void IngestServer::retryHeld(Worker &worker)
+{
+	std::vector<int> closed;
+
+	for(auto &entry : worker.connections){
+		Connection &connection = *entry.second;
+		if(!connection.held){
+			continue;
+		}
+		AddResult result = batcher_.add(connection.device, connection.lines.data(), connection.lines.size());
+		if(result == AddResult::Held){
+			continue;
+		}
+
+		bool open = result == AddResult::Added;
+		if(open){
+			connection.held = false;
+			connection.output += connection.reply;
+			connection.lines.clear();
+			open = process(worker, connection);
+		}
+		if(open){
+			update(worker, connection);
+		}else{
+			closed.push_back(entry.first);
+		}
+	}
+
+	for(int sock : closed){
+		close(worker, *worker.connections[sock]);
+	}
+}
+
+/**
+ * Sends as much of the output as the socket takes, returns false if the connection has to be closed.
+ */
+bool IngestServer::send(Connection &connection)
+{
+	size_t sent = 0;
+
+	while(sent < connection.output.size()){
+		ssize_t length = ::send(connection.sock, connection.output.data() + sent, connection.output.size() - sent, MSG_NOSIGNAL);
+		if(length < 0){
+			if(errno == EINTR){
+				continue;
+			}
+			if(errno == EAGAIN || errno == EWOULDBLOCK){
+				break;
+			}
+			return false;
+		}
+		sent += length;
+	}
+	connection.output.erase(0, sent);
+
+	return !(connection.closing && connection.output.empty() && !connection.held);
+}
+
+void IngestServer::countInvalid(Worker &worker)
+{
+	std::lock_guard<std::mutex> lock(worker.mutex);
+	worker.stats.invalid++;
+}
+
+/**
+ * Registers the socket for reading unless the connection is held or has too many answers waiting, and for writing if
+ * answers are waiting.
+ */
+void IngestServer::update(Worker &worker, Connection &connection)
+{
+	const bool reading = !connection.held && !connection.closing && connection.output.size() < MAX_OUTPUT;
+	uint32_t events = (reading ? static_cast<uint32_t>(EPOLLIN) : 0) | (connection.output.empty() ? 0 : static_cast<uint32_t>(EPOLLOUT));
+	if(events != connection.events){
+		struct epoll_event event = {};
+		event.events = events;
+		event.data.fd = connection.sock;
+		epoll_ctl(worker.epoll, EPOLL_CTL_MOD, connection.sock, &event);
+		connection.events = events;
+	}
+}
+
+void IngestServer::close(Worker &worker, Connection &connection)
+{
+	int sock = connection.sock;
+	epoll_ctl(worker.epoll, EPOLL_CTL_DEL, sock, nullptr);
+	::close(sock);
+	{
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		worker.stats.active--;
+	}
+	worker.connections.erase(sock);
+}
+
+} // namespace socketsense
@@ -0,0 +1,169 @@
+/**
+ * @file ingest_server.h
+ * @brief TCP server that receives the points of many devices, as binary sample frames or as InfluxDB writes.
+ *
+ * Two ports are served. On the frame port a device starts with a hello frame carrying its user-id, followed by
+ * samples frames and lines frames (see sample_frame.h); each of them is acknowledged with its sequence number once its
+ * points were handed to the batcher. The lines of a lines frame get the device tag of the hello frame. The HTTP port answers POST /write like InfluxDB does, so a device that posts line
+ * protocol (CONFIG_INFLUXDB_IP and CONFIG_INFLUXDB_PORT pointing at the gateway) needs no other change; the points get
+ * the device tag of the device query parameter if they have none. GET /stats returns the statistics and the ingest
+ * rates of the devices as JSON, GET /ping is answered with 204.
+ *
+ * The connections are spread round robin over a fixed number of worker threads. Each worker serves its group of
+ * connections with epoll and non-blocking sockets, so the gateway scales over the cores without a thread per device.
+ * If the batcher holds the lines of a device back, the worker stops reading from that connection and keeps the
+ * acknowledgement (or the answer of the write) until the batcher has space again. The device slows down or spools its
+ * data, while the other devices of the group are still served. A device is identified by its user-id (hello frame or
+ * device query parameter), or by its address if it sends none. A connection that sends an invalid frame is closed.
+ *
+ * @date October 17. 2026
+ */
+#ifndef TOOLS_GATEWAY_INGEST_SERVER_H_
+#define TOOLS_GATEWAY_INGEST_SERVER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sample_frame.h"
+#include "batcher.h"
+#include "line_writer.h"
+
+namespace socketsense {
+
+/**
+ * @brief Configuration of the ingest server.
+ */
+struct IngestServerConfig {
+	int frame_port = 8095;				//!< Port of the sample frames, 0 picks a free one, -1 disables it
+	int http_port = 8096;				//!< Port of the InfluxDB compatible /write endpoint, 0 picks a free one, -1 disables it
+	unsigned workers = 0;				//!< Worker threads, each serving a group of connections, 0 for one per core
+	bool loopback = false;				//!< Listen on the loopback interface only instead of all interfaces
+};
+
+/**
+ * @brief Statistics of the ingest server.
+ */
+struct IngestServerStats {
+	uint64_t connections = 0;		//!< Accepted connections
+	uint64_t active = 0;			//!< Currently open connections
+	uint64_t frames = 0;			//!< Received samples frames and lines frames
+	uint64_t frame_bytes = 0;		//!< Received bytes of all frames
+	uint64_t requests = 0;			//!< Received HTTP requests
+	uint64_t writes = 0;			//!< Received write requests
+	uint64_t write_bytes = 0;		//!< Received bodies of the write requests
+	uint64_t points = 0;			//!< Decoded or received points
+	uint64_t line_bytes = 0;		//!< Line protocol bytes of the decoded points
+	uint64_t held = 0;				//!< Times a connection stopped reading because its lines were held back
+	uint64_t invalid = 0;			//!< Connections closed because of an invalid frame or request
+};
+
+/**
+ * @brief Decodes all points of a samples frame and appends them as line protocol.
+ *
+ * @param header Parsed header of the frame.
+ * @param payload Payload of the frame.
+ * @param writer Writer with the device tag of the connection.
+ * @param out Destination of the lines.
+ * @return Number of points, -1 if the payload is invalid.
+ */
+int decodeFrameToLines(const sample_frame_header_t &header, const uint8_t *payload, LineWriter &writer, std::string &out);
+
+/**
+ * @brief Accepts device connections and forwards their points to the batcher.
+ */
+class IngestServer {
+public:
+	IngestServer(const IngestServerConfig &config, Batcher &batcher);
+	~IngestServer();
+
+	IngestServer(const IngestServer &) = delete;
+	IngestServer &operator=(const IngestServer &) = delete;
+
+	/**
+	 * @brief Starts listening and the worker threads.
+	 *
+	 * @return False if a port can't be bound.
+	 */
+	bool start();
+
+	/**
+	 * @brief Stops accepting, closes all connections and waits for the worker threads.
+	 */
+	void stop();
+
+	/**
+	 * @brief Port of the sample frames, the chosen one if the configured port is 0, -1 if disabled.
+	 */
+	int framePort() const { return frame_port_; }
+
+	/**
+	 * @brief Port of the HTTP endpoint, the chosen one if the configured port is 0, -1 if disabled.
+	 */
+	int httpPort() const { return http_port_; }
+
+	/**
+	 * @brief Number of worker threads.
+	 */
+	unsigned workerCount() const { return static_cast<unsigned>(workers_.size()); }
+
+	/**
+	 * @brief Lets the workers try again to hand the held lines to the batcher, given to Batcher::setSpaceListener().
+	 */
+	void wake();
+
+	/**
+	 * @brief Returns the statistics.
+	 */
+	IngestServerStats statistics();
+
+private:
+	enum class Protocol {
+		Frames,
+		Http
+	};
+
+	struct Connection;
+	struct Worker;
+
+	bool listenOn(int port, int &sock, int &bound);
+	void release();
+	void acceptLoop();
+	void acceptFrom(int listen_socket, Protocol protocol);
+	void work(Worker &worker);
+	void attach(Worker &worker);
+	bool receive(Worker &worker, Connection &connection);
+	bool process(Worker &worker, Connection &connection);
+	bool processFrames(Worker &worker, Connection &connection);
+	bool processHttp(Worker &worker, Connection &connection);
+	bool handleWrite(Worker &worker, Connection &connection, const std::string &target, const char *body, size_t length,
+			bool gzip, bool close);
+	std::string statsJson();
+	bool submit(Worker &worker, Connection &connection);
+	void retryHeld(Worker &worker);
+	bool send(Connection &connection);
+	void countInvalid(Worker &worker);
+	void update(Worker &worker, Connection &connection);
+	void close(Worker &worker, Connection &connection);
+
+	IngestServerConfig config_;
+	Batcher &batcher_;
+	int frame_port_ = -1;
+	int http_port_ = -1;
+	int frame_socket_ = -1;
+	int http_socket_ = -1;
+	int stop_event_ = -1;								//!< Wakes up the accept thread at the stop
+	std::thread accept_thread_;
+	std::vector<std::unique_ptr<Worker>> workers_;
+	unsigned next_worker_ = 0;							//!< Worker of the next accepted connection
+	std::mutex mutex_;									//!< Guards running_ against wake() while stopping
+	std::atomic<bool> running_{false};
+};
+
+} // namespace socketsense
+
+#endif /* TOOLS_GATEWAY_INGEST_SERVER_H_ */
@@ -0,0 +1,165 @@
+/**
+ * @file line_writer.cpp
+ * @brief Writes decoded points in the InfluxDB line protocol.
+ *
+ * The numbers are written in place with std::to_chars, the field keys of the sensor elements are copied from a table.
+ *
+ * @date October 17. 2026
+ */
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+#include "line_writer.h"
+
+namespace socketsense {
+
+void LineWriter::setDevice(const std::string &uid)
+{
+	prefix_ = "socket_data" + deviceTag(uid) + " temp=";
+}
+
+std::string LineWriter::escapeTag(const std::string &value)
+{
+	std::string escaped;
+	for(char c : value){
+		if(c == ',' || c == '=' || c == ' '){							//tag values must escape these characters
+			escaped += '\\';
+		}
+		escaped += c;
+	}
+	return escaped;
+}
+
+std::string LineWriter::deviceTag(const std::string &uid)
+{
+	return uid.empty() ? std::string() : ",device=" + escapeTag(uid);
+}
+
+void LineWriter::appendTagged(std::string &out, const char *begin, const char *end, const std::string &tag)
+{
+	static const char KEY[] = ",device=";
+	const char *measurement_end = begin;
+	while(measurement_end < end && *measurement_end != ',' && *measurement_end != ' '){
+		measurement_end += *measurement_end == '\\' && measurement_end + 1 < end ? 2 : 1;
+	}
+	const char *tags_end = measurement_end;
+	while(tags_end < end && *tags_end != ' '){
+		tags_end += *tags_end == '\\' && tags_end + 1 < end ? 2 : 1;
+	}
+
+	out.append(begin, measurement_end);
+	if(!tag.empty() && std::search(measurement_end, tags_end, KEY, KEY + sizeof(KEY) - 1) == tags_end){
+		out += tag;
+	}
+	out.append(measurement_end, end);
+	out += '\n';
+}
+
+size_t LineWriter::maxLineLength(uint8_t sensor_count, uint8_t sensel_count) const
+{
+	return prefix_.size() + 128 + static_cast<size_t>(sensor_count) * sensel_count * 16;
+}
+
+void LineWriter::append(std::string &out, const sample_frame_point_t &point, uint8_t sensor_count, uint8_t sensel_count)
+{
+	size_t start = out.size();
+	out.resize(start + maxLineLength(sensor_count, sensel_count));
+	char *end = write(&out[start], point, sensor_count, sensel_count);
+	out.resize(end - out.data());
+}
+
+char *LineWriter::write(char *pos, const sample_frame_point_t &point, uint8_t sensor_count, uint8_t sensel_count)
+{
+	char *end = pos + maxLineLength(sensor_count, sensel_count);
+
+	if(sensor_count != key_sensors_ || sensel_count != key_sensels_){
+		buildKeys(sensor_count, sensel_count);
+	}
+
+	std::memcpy(pos, prefix_.data(), prefix_.size());
+	pos += prefix_.size();
+	pos = writeFixed2(pos, point.temperature);
+	std::memcpy(pos, ",hum=", 5);
+	pos = writeFixed2(pos + 5, point.humidity);
+	std::memcpy(pos, ",pres=", 6);
+	pos = writeFixed2(pos + 6, point.pressure);
+	std::memcpy(pos, ",st=", 4);
+	pos = std::to_chars(pos + 4, end, point.sampling_time).ptr;
+	std::memcpy(pos, ",bl=", 4);
+	pos = std::to_chars(pos + 4, end, point.battery_voltage).ptr;
+
+	const char *keys = keys_.data();
+	const uint32_t count = static_cast<uint32_t>(sensor_count) * sensel_count;
+	for(uint32_t i = 0; i < count; i++){
+		if(point.sensel_mask != nullptr && (point.sensel_mask[i >> 3] & (1 << (i & 7))) == 0){
+			continue;													//left out by the deadband of the device
+		}
+		uint32_t key_length = key_offsets_[i + 1] - key_offsets_[i];
+		std::memcpy(pos, keys + key_offsets_[i], key_length);
+		pos = std::to_chars(pos + key_length, end, point.sensels[i]).ptr;
+		*pos++ = 'i';
+	}
+
+	*pos++ = ' ';
+	pos = std::to_chars(pos, end, point.timestamp_usec).ptr;
+	*pos++ = '\n';
+
+	return pos;
+}
+
+char *LineWriter::writeFixed2(char *dst, float value)
+{
+	if(!(value == value)){												//NaN
+		value = 0;
+	}
+	if(value > 10000000.0f){
+		value = 10000000.0f;
+	}
+	if(value < -10000000.0f){
+		value = -10000000.0f;
+	}
+
+	if(std::signbit(value)){
+		*dst++ = '-';
+		value = -value;
+	}
+
+	int32_t integer = static_cast<int32_t>(value);						//split without rounding, value * 100 is not exact above 2^23 / 100
+	float fraction = value - static_cast<float>(integer);				//exact, the integer part is at least as coarse as the value
+	double cents = static_cast<double>(fraction) * 100.0;				//exact, 24 bits times 7 bits fit into a double
+	uint32_t hundredths = static_cast<uint32_t>(cents);
+	cents -= hundredths;
+	if(cents > 0.5 || (cents == 0.5 && (hundredths & 1) != 0)){			//round half to even, like printf
+		hundredths++;
+	}
+	if(hundredths == 100){
+		integer++;
+		hundredths = 0;
+	}
+
+	dst = std::to_chars(dst, dst + 10, static_cast<uint32_t>(integer)).ptr;
+	*dst++ = '.';
+	*dst++ = static_cast<char>('0' + hundredths / 10);
+	*dst++ = static_cast<char>('0' + hundredths % 10);
+
+	return dst;
+}
+
+void LineWriter::buildKeys(uint8_t sensor_count, uint8_t sensel_count)
+{
+	keys_.clear();
+	key_offsets_.clear();
+	for(unsigned sensor_id = 0; sensor_id < sensor_count; sensor_id++){
+		for(unsigned sensel_id = 0; sensel_id < sensel_count; sensel_id++){
+			key_offsets_.push_back(static_cast<uint32_t>(keys_.size()));
+			keys_ += ",s" + std::to_string(sensor_id) + "_" + std::to_string(sensel_id) + "=";
+		}
+	}
+	key_offsets_.push_back(static_cast<uint32_t>(keys_.size()));
+	key_sensors_ = sensor_count;
+	key_sensels_ = sensel_count;
+}
+
+} // namespace socketsense
@@ -0,0 +1,103 @@
+/**
+ * @file line_writer.h
+ * @brief Writes decoded points in the InfluxDB line protocol.
+ *
+ * The output is the same as the one of the firmware (line_protocol.h), each point is written as
+ * socket_data,device=<uid> temp=21.53,hum=40.12,pres=101325.00,st=2400,bl=3950,s0_0=1234i,...,s3_7=87i 1571234567890123
+ * The device tag is only written if the device sent a user-id. Sensor elements that are not set in the sensel_mask of
+ * the point are left out, like the firmware does with its deadband; only the first point of a frame always carries all
+ * of them. The BME280 values are rounded with the same single
+ * precision arithmetic as on the ESP32, so both paths produce identical text. The field keys of the sensor elements are
+ * built once per geometry.
+ *
+ * @date October 17. 2026
+ */
+#ifndef TOOLS_GATEWAY_LINE_WRITER_H_
+#define TOOLS_GATEWAY_LINE_WRITER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "sample_frame.h"
+
+namespace socketsense {
+
+/**
+ * @brief Appends points of one device to a line protocol body.
+ */
+class LineWriter {
+public:
+	/**
+	 * @brief Sets the device tag of the following points.
+	 *
+	 * @param uid User-id of the device, empty for no tag.
+	 */
+	void setDevice(const std::string &uid);
+
+	/**
+	 * @brief Appends one point terminated by a newline.
+	 *
+	 * @param out Destination.
+	 * @param point The point.
+	 * @param sensor_count Number of sensor strips of the point.
+	 * @param sensel_count Number of sensor elements per strip.
+	 */
+	void append(std::string &out, const sample_frame_point_t &point, uint8_t sensor_count, uint8_t sensel_count);
+
+	/**
+	 * @brief Writes one point terminated by a newline.
+	 *
+	 * @param dst Destination, needs space for maxLineLength() characters.
+	 * @param point The point.
+	 * @param sensor_count Number of sensor strips of the point.
+	 * @param sensel_count Number of sensor elements per strip.
+	 * @return Pointer behind the last written character.
+	 */
+	char *write(char *dst, const sample_frame_point_t &point, uint8_t sensor_count, uint8_t sensel_count);
+
+	/**
+	 * @brief Upper bound of the length of one line.
+	 */
+	size_t maxLineLength(uint8_t sensor_count, uint8_t sensel_count) const;
+
+	/**
+	 * @brief Writes a float as fixed-point number with two decimals, like line_protocol_writeFixed2() of the firmware
+	 *        (the digits of printf("%.2f")).
+	 */
+	static char *writeFixed2(char *dst, float value);
+
+	/**
+	 * @brief Escapes the characters of a tag value that line protocol requires to be escaped.
+	 */
+	static std::string escapeTag(const std::string &value);
+
+	/**
+	 * @brief Returns the device tag ",device=<uid>" that appendTagged() inserts, empty if the uid is empty.
+	 */
+	static std::string deviceTag(const std::string &uid);
+
+	/**
+	 * @brief Appends a line terminated by a newline, with the device tag behind the measurement unless the line has a
+	 * device tag already.
+	 *
+	 * @param out Destination.
+	 * @param begin Start of the line.
+	 * @param end End of the line, without the newline.
+	 * @param tag Tag returned by deviceTag(), empty to append the line as it is.
+	 */
+	static void appendTagged(std::string &out, const char *begin, const char *end, const std::string &tag);
+
+private:
+	void buildKeys(uint8_t sensor_count, uint8_t sensel_count);
+
+	std::string prefix_ = "socket_data temp=";	//!< Measurement, tags and the first field key
+	std::string keys_;							//!< Field keys ",s<strip>_<sensel>=" of all sensor elements
+	std::vector<uint32_t> key_offsets_;			//!< Start of each key in keys_, followed by the end of the last key
+	uint8_t key_sensors_ = 0;					//!< Geometry the keys were built for
+	uint8_t key_sensels_ = 0;
+};
+
+} // namespace socketsense
+
+#endif /* TOOLS_GATEWAY_LINE_WRITER_H_ */
@@ -0,0 +1,135 @@
+/**
+ * @file main.cpp
+ * @brief Ingest gateway daemon for the Raspberry Pi.
+ *
+ * Receives binary sample frames (CONFIG_INFLUXDB_GATEWAY_ENABLED) and line protocol writes from many devices and writes
+ * them to the local InfluxDB in large, time-ordered batches per measurement. The statistics and the ingest rate of
+ * every device are printed periodically, and returned by GET /stats on the HTTP port.
+ *
+ *   socketsense_gateway -p 8095 -a 8096 -H 127.0.0.1 -P 8086 -d SOCKET_SENSE -u socketsense -w socketsense
+ *
+ * @date October 17. 2026
+ */
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <unistd.h>
+
+#include "batcher.h"
+#include "ingest_server.h"
+#include "influx_client.h"
+
+using namespace socketsense;
+
+static volatile std::sig_atomic_t stop_requested = 0;
+
+static void handleSignal(int)
+{
+	stop_requested = 1;
+}
+
+static void usage(const char *name)
+{
+	std::fprintf(stderr,
+			"Usage: %s [options]\n"
+			"  -p port      port of the sample frames, -1 to disable (8095)\n"
+			"  -a port      port of the InfluxDB compatible /write endpoint, -1 to disable (8096)\n"
+			"  -W count     worker threads serving the connections, 0 for one per core (0)\n"
+			"  -H host      IPv4 address of InfluxDB (127.0.0.1)\n"
+			"  -P port      port of InfluxDB (8086)\n"
+			"  -d database  database (SOCKET_SENSE)\n"
+			"  -u user      InfluxDB user (no authentication)\n"
+			"  -w password  password of the user\n"
+			"  -b points    points per write request (5000)\n"
+			"  -t ms        maximum age of a batch (1000)\n"
+			"  -m MB        pending data before all devices are slowed down (64)\n"
+			"  -M KB        pending data of one device before it is slowed down (4096)\n"
+			"  -s seconds   statistics interval, 0 to disable (10)\n", name);
+}
+
+int main(int argc, char **argv)
+{
+	InfluxConfig influx;
+	BatcherConfig batching;
+	IngestServerConfig serving;
+	int stats_interval = 10;
+	int opt;
+
+	while((opt = getopt(argc, argv, "p:a:W:H:P:d:u:w:b:t:m:M:s:h")) != -1){
+		switch(opt){
+			case 'p': serving.frame_port = std::atoi(optarg); break;
+			case 'a': serving.http_port = std::atoi(optarg); break;
+			case 'W': serving.workers = std::strtoul(optarg, nullptr, 10); break;
+			case 'H': influx.host = optarg; break;
+			case 'P': influx.port = std::atoi(optarg); break;
+			case 'd': influx.database = optarg; break;
+			case 'u': influx.username = optarg; break;
+			case 'w': influx.password = optarg; break;
+			case 'b': batching.batch_points = std::strtoul(optarg, nullptr, 10); break;
+			case 't': batching.batch_timeout_ms = std::atoi(optarg); break;
+			case 'm': batching.max_pending_bytes = std::strtoul(optarg, nullptr, 10) << 20; break;
+			case 'M': batching.max_device_pending_bytes = std::strtoul(optarg, nullptr, 10) << 10; break;
+			case 's': stats_interval = std::atoi(optarg); break;
+			default: usage(argv[0]); return 1;
+		}
+	}
+
+	InfluxClient client(influx);
+	Batcher batcher(batching, [&client](const std::string &body){
+		int status = client.write(body);
+		if(status < 200 || status >= 300){
+			std::fprintf(stderr, "InfluxDB write failed with status %d\n", status);
+		}
+		return status;
+	});
+	IngestServer server(serving, batcher);
+	batcher.setSpaceListener([&server]{ server.wake(); });
+
+	std::signal(SIGINT, handleSignal);
+	std::signal(SIGTERM, handleSignal);
+
+	batcher.start();
+	if(!server.start()){
+		return 1;
+	}
+	std::fprintf(stderr, "Frames on port %d, writes on port %d, %u workers, writing to %s:%d/%s\n", server.framePort(),
+			server.httpPort(), server.workerCount(), influx.host.c_str(), influx.port, influx.database.c_str());
+
+	auto last = std::chrono::steady_clock::now();
+	IngestServerStats last_server;
+	while(!stop_requested){
+		std::this_thread::sleep_for(std::chrono::milliseconds(200));
+		auto now = std::chrono::steady_clock::now();
+		double elapsed = std::chrono::duration<double>(now - last).count();
+		if(stats_interval <= 0 || elapsed < stats_interval){
+			continue;
+		}
+
+		IngestServerStats server_stats = server.statistics();
+		BatcherStats batch_stats = batcher.statistics();
+		std::fprintf(stderr, "connections %llu, %.0f points/s, %.0f frame B/s, %.0f write B/s, "
+				"written %llu points in %llu batches, %llu failed writes, %zu bytes pending, %llu times held back\n",
+				(unsigned long long) server_stats.active,
+				(server_stats.points - last_server.points) / elapsed,
+				(server_stats.frame_bytes - last_server.frame_bytes) / elapsed,
+				(server_stats.write_bytes - last_server.write_bytes) / elapsed,
+				(unsigned long long) batch_stats.points_written, (unsigned long long) batch_stats.batches,
+				(unsigned long long) batch_stats.failed_writes, batch_stats.pending_bytes,
+				(unsigned long long) server_stats.held);
+		for(const DeviceStats &device : batcher.deviceStatistics()){
+			std::fprintf(stderr, "  %-20s %8.0f points/s %10.0f B/s %10llu points %8zu bytes pending %6llu held\n",
+					device.device.c_str(), device.points_per_second, device.bytes_per_second,
+					(unsigned long long) device.points, device.pending_bytes, (unsigned long long) device.blocked);
+		}
+		last = now;
+		last_server = server_stats;
+	}
+
+	std::fprintf(stderr, "Stopping\n");
+	batcher.stop();												//the remaining points are written once, held lines are not acknowledged
+	server.stop();
+
+	return 0;
+}
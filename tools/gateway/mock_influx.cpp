@@ -0,0 +1,304 @@
+/**
+ * @file mock_influx.cpp
+ * @brief Local stand-in for the /write endpoint of InfluxDB.
+ *
+ * @date October 17. 2026
+ */
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <strings.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include "gzip_codec.h"
+#include "mock_influx.h"
+
+namespace socketsense {
+
+namespace {
+
+const size_t MAX_HEAD = 16384;				//!< Longest accepted request head
+const size_t MAX_BODY = 256 << 20;			//!< Largest accepted body
+
+/**
+ * Counts the lines of a body, the last one does not need a newline.
+ */
+uint64_t countLines(const std::string &body)
+{
+	uint64_t lines = std::count(body.begin(), body.end(), '\n');
+	return lines + (!body.empty() && body.back() != '\n' ? 1 : 0);
+}
+
+} // namespace
+
+MockInflux::MockInflux(const MockInfluxConfig &config) : config_(config), port_(config.port)
+{
+}
+
+MockInflux::~MockInflux()
+{
+	stop();
+}
+
+bool MockInflux::start()
+{
+	struct sockaddr_in addr;
+	socklen_t length = sizeof(addr);
+	int flag = 1;
+
+	listen_socket_ = ::socket(AF_INET, SOCK_STREAM, 0);
+	if(listen_socket_ < 0){
+		return false;
+	}
+	setsockopt(listen_socket_, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+
+	std::memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(config_.port);
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	if(bind(listen_socket_, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0 || listen(listen_socket_, 64) != 0
+			|| getsockname(listen_socket_, reinterpret_cast<struct sockaddr *>(&addr), &length) != 0){
+		std::fprintf(stderr, "Can't listen on port %d: %s\n", config_.port, std::strerror(errno));
+		::close(listen_socket_);
+		listen_socket_ = -1;
+		return false;
+	}
+	port_ = ntohs(addr.sin_port);
+
+	running_ = true;
+	accept_thread_ = std::thread(&MockInflux::acceptLoop, this);
+
+	return true;
+}
+
+void MockInflux::stop()
+{
+	if(!running_.exchange(false)){
+		return;
+	}
+
+	::shutdown(listen_socket_, SHUT_RDWR);							//wakes up accept()
+	accept_thread_.join();
+	::close(listen_socket_);
+	listen_socket_ = -1;
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	for(int sock : sockets_){
+		::shutdown(sock, SHUT_RDWR);								//wakes up the connection threads
+	}
+	idle_.wait(lock, [this]{ return sockets_.empty(); });
+}
+
+MockInfluxStats MockInflux::statistics()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return stats_;
+}
+
+void MockInflux::acceptLoop()
+{
+	int flag = 1;
+
+	while(running_){
+		int sock = ::accept(listen_socket_, nullptr, nullptr);
+		if(sock < 0){
+			if(errno == EINTR || errno == ECONNABORTED){
+				continue;
+			}
+			break;
+		}
+		setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		if(!running_){
+			::close(sock);
+			break;
+		}
+		sockets_.insert(sock);
+		stats_.connections++;
+		std::thread(&MockInflux::serve, this, sock, config_.seed + static_cast<uint32_t>(stats_.connections)).detach();
+	}
+}
+
+/**
+ * Connection thread, answers requests until the client closes the connection or a disconnect is injected.
+ */
+void MockInflux::serve(int sock, uint32_t seed)
+{
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<double> chance(0.0, 1.0);
+	std::string buffer;
+	std::string body;
+	std::string lines;
+	char chunk[65536];
+	bool open = true;
+
+	while(open){
+		size_t head_end;
+		while((head_end = buffer.find("\r\n\r\n")) == std::string::npos && buffer.size() < MAX_HEAD){
+			ssize_t len = ::recv(sock, chunk, sizeof(chunk), 0);
+			if(len <= 0){
+				if(len < 0 && errno == EINTR){
+					continue;
+				}
+				open = false;
+				break;
+			}
+			buffer.append(chunk, len);
+		}
+		if(!open || head_end == std::string::npos){
+			break;
+		}
+
+		size_t content_length = 0;
+		bool has_length = false;
+		bool gzip = false;
+		bool close = false;
+		size_t line = buffer.find("\r\n") + 2;
+		while(line < head_end){
+			size_t next = buffer.find("\r\n", line);
+			std::string header = buffer.substr(line, next - line);
+			if(strncasecmp(header.c_str(), "Content-Length:", 15) == 0){
+				content_length = std::strtoul(header.c_str() + 15, nullptr, 10);
+				has_length = true;
+			}else if(strncasecmp(header.c_str(), "Content-Encoding:", 17) == 0){
+				gzip = header.find("gzip") != std::string::npos;
+			}else if(strncasecmp(header.c_str(), "Connection:", 11) == 0){
+				close = header.find("close") != std::string::npos;
+			}
+			line = next + 2;
+		}
+		const bool write = buffer.compare(0, 11, "POST /write") == 0;
+		const bool ping = buffer.compare(0, 9, "GET /ping") == 0 || buffer.compare(0, 10, "HEAD /ping") == 0;
+		buffer.erase(0, head_end + 4);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stats_.requests++;
+		}
+		if(content_length > MAX_BODY){
+			respond(sock, 413, "Request Entity Too Large", "{\"error\":\"body too large\"}");
+			break;
+		}
+		while(buffer.size() < content_length){
+			ssize_t len = ::recv(sock, chunk, std::min(sizeof(chunk), content_length - buffer.size()), 0);
+			if(len <= 0){
+				if(len < 0 && errno == EINTR){
+					continue;
+				}
+				open = false;
+				break;
+			}
+			buffer.append(chunk, len);
+		}
+		if(!open){
+			break;
+		}
+		body.assign(buffer, 0, content_length);
+		buffer.erase(0, content_length);
+
+		if(config_.delay_ms > 0){
+			std::this_thread::sleep_for(std::chrono::milliseconds(config_.delay_ms));
+		}
+
+		if(ping){
+			open = respond(sock, 204, "No Content", nullptr) && !close;
+			continue;
+		}
+		if(!write || !has_length){
+			std::lock_guard<std::mutex> lock(mutex_);
+			stats_.bad_requests++;
+		}
+		if(!write){
+			open = respond(sock, 404, "Not Found", "{\"error\":\"not found\"}") && !close;
+			continue;
+		}
+		if(!has_length){
+			respond(sock, 411, "Length Required", "{\"error\":\"length required\"}");
+			break;
+		}
+
+		double roll = chance(random);
+		if(roll < config_.disconnect_rate){
+			std::lock_guard<std::mutex> lock(mutex_);
+			stats_.disconnects++;
+			break;
+		}
+		if(roll < config_.disconnect_rate + config_.error_rate){
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				stats_.errors++;
+			}
+			open = respond(sock, 503, "Service Unavailable", "{\"error\":\"injected failure\"}") && !close;
+			continue;
+		}
+
+		if(gzip && !gzipDecompress(body.data(), body.size(), lines)){
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				stats_.bad_requests++;
+			}
+			open = respond(sock, 400, "Bad Request", "{\"error\":\"invalid gzip body\"}") && !close;
+			continue;
+		}
+		const std::string &text = gzip ? lines : body;
+		if(observer_){
+			observer_(text);
+		}
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stats_.writes++;
+			stats_.gzip_writes += gzip ? 1 : 0;
+			stats_.points += countLines(text);
+			stats_.wire_bytes += body.size();
+			stats_.body_bytes += text.size();
+		}
+		open = respond(sock, 204, "No Content", nullptr) && !close;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	::close(sock);													//under the lock, stop() must not see a reused descriptor
+	sockets_.erase(sock);
+	if(sockets_.empty()){
+		idle_.notify_all();
+	}
+}
+
+bool MockInflux::respond(int sock, int status, const char *reason, const char *body)
+{
+	size_t body_length = body != nullptr ? std::strlen(body) : 0;
+	std::string response = "HTTP/1.1 " + std::to_string(status) + " " + reason + "\r\n"
+			"X-Influxdb-Version: mock\r\n";
+	if(body != nullptr){
+		response += "Content-Type: application/json\r\nContent-Length: " + std::to_string(body_length) + "\r\n\r\n" + body;
+	}else{
+		response += "\r\n";
+	}
+
+	const char *data = response.data();
+	size_t length = response.size();
+	while(length > 0){
+		ssize_t sent = ::send(sock, data, length, MSG_NOSIGNAL);
+		if(sent <= 0){
+			if(sent < 0 && errno == EINTR){
+				continue;
+			}
+			return false;
+		}
+		data += sent;
+		length -= sent;
+	}
+
+	return true;
+}
+
+} // namespace socketsense
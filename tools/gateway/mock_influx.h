@@ -0,0 +1,116 @@
+/**
+ * @file mock_influx.h
+ * @brief Local stand-in for the /write endpoint of InfluxDB, for tests and benchmarks of the upload paths.
+ *
+ * Every connection is served by its own thread with HTTP/1.1 keep-alive, like InfluxDB does. A write is answered with
+ * 204 after its body was read (and decompressed if it is sent with Content-Encoding: gzip); its points are counted
+ * but not stored. Failures can be injected at random: a 503 answer or a connection that is closed before the answer.
+ * In both cases the points of the write are not counted, so a client that repeats its failed writes has to end up
+ * with exactly the points it sent. /ping is answered with 204 as well.
+ *
+ * @date October 17. 2026
+ */
+#ifndef TOOLS_GATEWAY_MOCK_INFLUX_H_
+#define TOOLS_GATEWAY_MOCK_INFLUX_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+namespace socketsense {
+
+/**
+ * @brief Behavior of the mock server.
+ */
+struct MockInfluxConfig {
+	int port = 8086;						//!< Port on the loopback interface, 0 picks a free one
+	double error_rate = 0.0;				//!< Fraction of the writes answered with 503
+	double disconnect_rate = 0.0;			//!< Fraction of the writes whose connection is closed instead of answered
+	int delay_ms = 0;						//!< Delay of every answer
+	uint32_t seed = 1;						//!< Seed of the injected failures
+};
+
+/**
+ * @brief Statistics of the mock server.
+ */
+struct MockInfluxStats {
+	uint64_t connections = 0;		//!< Accepted connections
+	uint64_t requests = 0;			//!< Received requests
+	uint64_t writes = 0;			//!< Writes answered with 204
+	uint64_t gzip_writes = 0;		//!< Accepted writes with a gzip body
+	uint64_t points = 0;			//!< Lines of the accepted writes
+	uint64_t wire_bytes = 0;		//!< Bodies of the accepted writes as received
+	uint64_t body_bytes = 0;		//!< Bodies of the accepted writes after decompression
+	uint64_t errors = 0;			//!< Injected 503 answers
+	uint64_t disconnects = 0;		//!< Injected disconnects
+	uint64_t bad_requests = 0;		//!< Requests answered with 4xx
+};
+
+/**
+ * @brief Called with the line protocol of every accepted write, from the connection threads.
+ */
+using MockInfluxObserver = std::function<void(const std::string &lines)>;
+
+/**
+ * @brief Mock InfluxDB HTTP server.
+ */
+class MockInflux {
+public:
+	explicit MockInflux(const MockInfluxConfig &config);
+	~MockInflux();
+
+	MockInflux(const MockInflux &) = delete;
+	MockInflux &operator=(const MockInflux &) = delete;
+
+	/**
+	 * @brief Starts listening on 127.0.0.1.
+	 *
+	 * @return False if the port can't be bound.
+	 */
+	bool start();
+
+	/**
+	 * @brief Stops accepting, closes all connections and waits for their threads.
+	 */
+	void stop();
+
+	/**
+	 * @brief The port the server listens on, after start().
+	 */
+	int port() const { return port_; }
+
+	/**
+	 * @brief Sets the observer of the accepted writes, before start().
+	 */
+	void setObserver(MockInfluxObserver observer) { observer_ = std::move(observer); }
+
+	/**
+	 * @brief Returns the statistics.
+	 */
+	MockInfluxStats statistics();
+
+private:
+	void acceptLoop();
+	void serve(int sock, uint32_t seed);
+	bool respond(int sock, int status, const char *reason, const char *body);
+
+	MockInfluxConfig config_;
+	MockInfluxObserver observer_;
+	int port_;
+	int listen_socket_ = -1;
+	std::thread accept_thread_;
+	std::mutex mutex_;
+	std::condition_variable idle_;		//!< Signaled when the last connection thread ends
+	std::set<int> sockets_;				//!< Open connections, shut down by stop()
+	MockInfluxStats stats_;
+	std::atomic<bool> running_{false};
+};
+
+} // namespace socketsense
+
+#endif /* TOOLS_GATEWAY_MOCK_INFLUX_H_ */
@@ -0,0 +1,88 @@
+/**
+ * @file mock_influx_main.cpp
+ * @brief Mock InfluxDB for trying out the gateway, the uploader or the firmware without a database.
+ *
+ * Accepts writes on 127.0.0.1, counts their points and prints the statistics periodically, see mock_influx.h.
+ *
+ *   mock_influxdb -p 8086 -e 0.05 -x 0.01 -l 20
+ *
+ * @date October 17. 2026
+ */
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <unistd.h>
+
+#include "mock_influx.h"
+
+using namespace socketsense;
+
+static volatile std::sig_atomic_t stop_requested = 0;
+
+static void handleSignal(int)
+{
+	stop_requested = 1;
+}
+
+static void usage(const char *name)
+{
+	std::fprintf(stderr,
+			"Usage: %s [options]\n"
+			"  -p port      port on 127.0.0.1 (8086)\n"
+			"  -e rate      fraction of the writes answered with 503 (0)\n"
+			"  -x rate      fraction of the writes answered by closing the connection (0)\n"
+			"  -l ms        delay of every answer (0)\n"
+			"  -s seconds   statistics interval, 0 to disable (10)\n", name);
+}
+
+int main(int argc, char **argv)
+{
+	MockInfluxConfig config;
+	int stats_interval = 10;
+	int opt;
+
+	while((opt = getopt(argc, argv, "p:e:x:l:s:h")) != -1){
+		switch(opt){
+			case 'p': config.port = std::atoi(optarg); break;
+			case 'e': config.error_rate = std::atof(optarg); break;
+			case 'x': config.disconnect_rate = std::atof(optarg); break;
+			case 'l': config.delay_ms = std::atoi(optarg); break;
+			case 's': stats_interval = std::atoi(optarg); break;
+			default: usage(argv[0]); return 1;
+		}
+	}
+
+	MockInflux server(config);
+	std::signal(SIGINT, handleSignal);
+	std::signal(SIGTERM, handleSignal);
+	if(!server.start()){
+		return 1;
+	}
+	std::fprintf(stderr, "Mock InfluxDB listening on 127.0.0.1:%d\n", server.port());
+
+	auto last = std::chrono::steady_clock::now();
+	MockInfluxStats last_stats;
+	while(!stop_requested){
+		std::this_thread::sleep_for(std::chrono::milliseconds(200));
+		auto now = std::chrono::steady_clock::now();
+		double elapsed = std::chrono::duration<double>(now - last).count();
+		if(stats_interval <= 0 || elapsed < stats_interval){
+			continue;
+		}
+
+		MockInfluxStats stats = server.statistics();
+		std::fprintf(stderr, "%.0f points/s, %.0f wire B/s, %llu points in %llu writes (%llu gzip), "
+				"%llu injected errors, %llu injected disconnects, %llu bad requests\n",
+				(stats.points - last_stats.points) / elapsed, (stats.wire_bytes - last_stats.wire_bytes) / elapsed,
+				(unsigned long long) stats.points, (unsigned long long) stats.writes, (unsigned long long) stats.gzip_writes,
+				(unsigned long long) stats.errors, (unsigned long long) stats.disconnects, (unsigned long long) stats.bad_requests);
+		last = now;
+		last_stats = stats;
+	}
+
+	server.stop();
+
+	return 0;
+}
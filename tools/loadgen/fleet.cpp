@@ -0,0 +1,353 @@
+/**
+ * @file fleet.cpp
+ * @brief Simulates a fleet of SocketSense devices that write to InfluxDB or to the gateway.
+ *
+ * @date October 17. 2026
+ */
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include "sample_frame.h"
+#include "line_writer.h"
+#include "gait_model.h"
+#include "fleet.h"
+
+namespace socketsense {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+uint32_t microseconds(Clock::duration duration)
+{
+	auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+	return static_cast<uint32_t>(std::min<int64_t>(std::max<int64_t>(us, 0), UINT32_MAX));
+}
+
+/**
+ * Connection of a device to the frame port of the gateway, opened with a hello frame.
+ */
+class FrameConnection {
+public:
+	FrameConnection(const InfluxConfig &target, const std::string &uid, uint8_t sensor_count, uint8_t sensel_count)
+			: target_(target), uid_(uid), sensor_count_(sensor_count), sensel_count_(sensel_count)
+	{
+	}
+
+	~FrameConnection()
+	{
+		close();
+	}
+
+	/**
+	 * Sends a samples frame and waits for its acknowledgement, returns false if the connection failed.
+	 */
+	bool send(const uint8_t *frame, size_t length, uint32_t sequence)
+	{
+		uint8_t ack[SAMPLE_FRAME_ACK_SIZE];
+
+		if(sock_ < 0 && !connect()){
+			return false;
+		}
+		if(!sendAll(frame, length) || !receiveAll(ack, sizeof(ack))){
+			close();
+			return false;
+		}
+		uint32_t acknowledged = 0;
+		for(int i = 0; i < SAMPLE_FRAME_ACK_SIZE; i++){
+			acknowledged |= static_cast<uint32_t>(ack[i]) << (8 * i);
+		}
+		if(acknowledged != sequence){
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	unsigned connects() const { return connects_; }
+
+private:
+	bool connect()
+	{
+		struct sockaddr_in addr;
+		struct timeval timeout;
+		uint8_t hello[SAMPLE_FRAME_HEADER_SIZE + 64];
+		int flag = 1;
+
+		std::memset(&addr, 0, sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons(target_.port);
+		if(inet_pton(AF_INET, target_.host.c_str(), &addr.sin_addr) != 1){
+			return false;
+		}
+		sock_ = ::socket(AF_INET, SOCK_STREAM, 0);
+		if(sock_ < 0){
+			return false;
+		}
+		timeout.tv_sec = target_.timeout_ms / 1000;
+		timeout.tv_usec = (target_.timeout_ms % 1000) * 1000;
+		setsockopt(sock_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+		setsockopt(sock_, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+		setsockopt(sock_, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+		connects_++;
+
+		size_t length = sample_frame_writeHello(hello, sizeof(hello), uid_.c_str(), sensor_count_, sensel_count_);
+		if(::connect(sock_, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0 || length == 0
+				|| !sendAll(hello, length)){
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	void close()
+	{
+		if(sock_ >= 0){
+			::close(sock_);
+			sock_ = -1;
+		}
+	}
+
+	bool sendAll(const uint8_t *data, size_t length)
+	{
+		while(length > 0){
+			ssize_t sent = ::send(sock_, data, length, MSG_NOSIGNAL);
+			if(sent <= 0){
+				if(sent < 0 && errno == EINTR){
+					continue;
+				}
+				return false;
+			}
+			data += sent;
+			length -= sent;
+		}
+		return true;
+	}
+
+	bool receiveAll(uint8_t *data, size_t length)
+	{
+		while(length > 0){
+			ssize_t received = ::recv(sock_, data, length, 0);
+			if(received <= 0){
+				if(received < 0 && errno == EINTR){
+					continue;
+				}
+				return false;
+			}
+			data += received;
+			length -= received;
+		}
+		return true;
+	}
+
+	InfluxConfig target_;
+	std::string uid_;
+	uint8_t sensor_count_;
+	uint8_t sensel_count_;
+	int sock_ = -1;
+	unsigned connects_ = 0;
+};
+
+} // namespace
+
+void FleetStats::merge(const FleetStats &other)
+{
+	writes += other.writes;
+	points += other.points;
+	bytes += other.bytes;
+	failed += other.failed;
+	server_errors += other.server_errors;
+	rejected += other.rejected;
+	failed_points += other.failed_points;
+	skipped_points += other.skipped_points;
+	connects += other.connects;
+	latency_us.insert(latency_us.end(), other.latency_us.begin(), other.latency_us.end());
+	service_us.insert(service_us.end(), other.service_us.begin(), other.service_us.end());
+	age_us.insert(age_us.end(), other.age_us.begin(), other.age_us.end());
+}
+
+uint32_t percentile(std::vector<uint32_t> &values, double fraction)
+{
+	if(values.empty()){
+		return 0;
+	}
+	size_t rank = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+	std::nth_element(values.begin(), values.begin() + rank, values.end());
+	return values[rank];
+}
+
+Fleet::Fleet(const FleetConfig &config) : config_(config)
+{
+	config_.sample_rate = std::max(config_.sample_rate, 0.01);
+	config_.batch_points = std::min(std::max(config_.batch_points, 1U), 65535U);
+	config_.max_points = std::min(std::max(config_.max_points, config_.batch_points), 65535U);		//points of a frame
+}
+
+Fleet::~Fleet()
+{
+	stop();
+}
+
+void Fleet::start()
+{
+	if(running_.exchange(true)){
+		return;
+	}
+	for(unsigned i = 0; i < config_.devices; i++){
+		threads_.emplace_back(&Fleet::run, this, i);
+	}
+}
+
+void Fleet::stop()
+{
+	running_ = false;
+	for(std::thread &thread : threads_){
+		thread.join();
+	}
+	threads_.clear();
+}
+
+FleetStats Fleet::takeStatistics()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	FleetStats stats;
+	std::swap(stats, stats_);
+	return stats;
+}
+
+void Fleet::record(const FleetStats &result)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	stats_.merge(result);
+}
+
+/**
+ * Device thread. The samples of a batch are generated when the batch is due, with the timestamps they were recorded at.
+ */
+void Fleet::run(unsigned index)
+{
+	const uint32_t seed = config_.seed * 7919U + index;
+	const unsigned count = static_cast<unsigned>(config_.sensor_count) * config_.sensel_count;
+	const std::string uid = config_.uid_prefix + std::to_string(index);
+	const Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / config_.sample_rate));
+	const Clock::duration timeout = std::chrono::milliseconds(config_.batch_timeout_ms);
+	const Clock::duration interval = std::min(period * (config_.batch_points - 1), timeout);
+	const Clock::time_point start = Clock::now();
+	const uint64_t epoch_us = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count();
+
+	std::mt19937 random(seed);
+	GaitModel model(config_.sensor_count, config_.sensel_count, seed);
+	std::vector<uint16_t> values(count);
+	sample_frame_point_t point{};
+	point.sensels = values.data();
+	const float temperature = std::uniform_real_distribution<float>(28.0f, 34.0f)(random);
+	const float humidity = std::uniform_real_distribution<float>(35.0f, 60.0f)(random);
+	const float pressure = std::uniform_real_distribution<float>(100300.0f, 101300.0f)(random);
+
+	InfluxConfig target = config_.target;
+	target.device = uid;
+	LineWriter writer;
+	writer.setDevice(config_.tag_lines ? uid : std::string());
+	std::unique_ptr<InfluxClient> client;
+	std::unique_ptr<FrameConnection> connection;
+	std::vector<uint8_t> frame_buffer;
+	sample_frame_t frame;
+	uint32_t sequence = 0;
+	if(config_.protocol == FleetProtocol::Line){
+		client.reset(new InfluxClient(target));
+	}else{
+		connection.reset(new FrameConnection(target, uid, config_.sensor_count, config_.sensel_count));
+		frame_buffer.resize(SAMPLE_FRAME_HEADER_SIZE + config_.max_points * SAMPLE_FRAME_MAX_POINT_SIZE(count));
+		sample_frame_init(&frame, frame_buffer.data(), frame_buffer.size(), config_.sensor_count, config_.sensel_count,
+				config_.gorilla ? SAMPLE_FRAME_ENCODING_GORILLA : SAMPLE_FRAME_ENCODING_PACKED);
+	}
+	std::string body;
+	unsigned connects = 0;
+
+	Clock::time_point next = start + std::chrono::duration_cast<Clock::duration>(
+			(interval + period) * std::uniform_real_distribution<double>(0.0, 1.0)(random));	//the devices are not synchronized
+	while(running_){
+		const Clock::time_point first = next;
+		const Clock::time_point due = first + interval;
+		while(running_ && Clock::now() < due){
+			std::this_thread::sleep_for(std::min<Clock::duration>(due - Clock::now(), std::chrono::milliseconds(100)));
+		}
+		if(!running_){
+			break;
+		}
+
+		FleetStats result;
+		Clock::time_point now = Clock::now();
+		uint64_t samples = (now - first) / period + 1;
+		if(samples > config_.max_points){											//the firmware would spool them to the SD card
+			result.skipped_points = samples - config_.max_points;
+			next += period * result.skipped_points;
+			samples = config_.max_points;
+		}
+		const Clock::time_point oldest = next;
+
+		body.clear();
+		if(connection){
+			sample_frame_clear(&frame);
+		}
+		for(uint64_t i = 0; i < samples; i++, next += period){
+			const uint64_t time_us = std::chrono::duration_cast<std::chrono::microseconds>(next - start).count();
+			const double t = time_us * 1e-6;
+			model.sample(time_us, values.data());
+			point.timestamp_usec = epoch_us + time_us;
+			point.temperature = temperature + 0.5f * static_cast<float>(std::sin(t / 600.0));
+			point.humidity = humidity + 2.0f * static_cast<float>(std::sin(t / 900.0));
+			point.pressure = pressure + 20.0f * static_cast<float>(std::sin(t / 1800.0));
+			point.sampling_time = 2400 + random() % 64;
+			point.battery_voltage = 4100 - static_cast<uint32_t>(std::min(t / 30.0, 500.0));
+			if(connection){
+				sample_frame_append(&frame, &point);
+			}else{
+				writer.append(body, point, config_.sensor_count, config_.sensel_count);
+			}
+		}
+
+		const Clock::time_point sent = Clock::now();
+		int status;
+		size_t bytes;
+		if(connection){
+			bytes = sample_frame_finish(&frame, sequence);
+			status = connection->send(frame_buffer.data(), bytes, sequence++) ? 204 : -1;
+		}else{
+			bytes = body.size();
+			status = client->write(body);
+		}
+		const Clock::time_point answered = Clock::now();
+
+		if(status >= 200 && status < 300){
+			result.writes = 1;
+			result.points = samples;
+			result.bytes = bytes;
+			result.latency_us.push_back(microseconds(answered - due));
+			result.service_us.push_back(microseconds(answered - sent));
+			result.age_us.push_back(microseconds(answered - oldest));
+		}else{
+			result.failed = status < 0 ? 1 : 0;
+			result.server_errors = status >= 500 ? 1 : 0;
+			result.rejected = status > 0 && status < 500 ? 1 : 0;
+			result.failed_points = samples;
+		}
+		unsigned total_connects = connection ? connection->connects() : client->connects();
+		result.connects = total_connects - connects;
+		connects = total_connects;
+		record(result);
+	}
+}
+
+} // namespace socketsense
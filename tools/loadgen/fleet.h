@@ -0,0 +1,131 @@
+/**
+ * @file fleet.h
+ * @brief Simulates a fleet of SocketSense devices that write to InfluxDB or to the gateway.
+ *
+ * Every device is a thread with its own connection and behaves like the firmware: it samples at sample_rate and sends
+ * its batch once batch_points samples are collected or batch_timeout_ms after the first one. With the line protocol
+ * the body is the one of influxdb_post_data(), posted to /write with the user-id as device query parameter; with
+ * frames the device sends a hello frame and then one samples frame per batch to the frame port of the gateway and
+ * waits for its acknowledgement. The sensor elements follow a GaitModel.
+ *
+ * The schedule does not wait for the endpoint: if a write takes longer than the batch interval, the next batch takes
+ * all samples recorded meanwhile, like the firmware does. Three latencies are recorded per successful write: from the
+ * time the batch was due to its answer (includes the time it waited for the previous write), from sending it to the
+ * answer, and the age of its oldest sample at the answer.
+ *
+ * @date October 17. 2026
+ */
+#ifndef TOOLS_LOADGEN_FLEET_H_
+#define TOOLS_LOADGEN_FLEET_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "influx_client.h"
+
+namespace socketsense {
+
+/**
+ * @brief How the devices send their samples.
+ */
+enum class FleetProtocol {
+	Line,								//!< Line protocol posted to /write (InfluxDB or the HTTP port of the gateway)
+	Frames								//!< Sample frames to the frame port of the gateway
+};
+
+/**
+ * @brief Configuration of the simulated fleet, the defaults are those of the sdkconfig.
+ */
+struct FleetConfig {
+	InfluxConfig target;				//!< Endpoint; for frames only host, port and timeout_ms are used
+	FleetProtocol protocol = FleetProtocol::Line;
+	unsigned devices = 16;				//!< Simulated devices
+	double sample_rate = 10.0;			//!< Samples per second of a device (CONFIG_DATA_COLLECTOR_SAMPLE_RATE_HZ)
+	unsigned batch_points = 50;			//!< Samples per write (CONFIG_INFLUXDB_BATCH_SIZE)
+	int batch_timeout_ms = 1000;		//!< Maximum age of a batch (CONFIG_INFLUXDB_BATCH_TIMEOUT_MS)
+	unsigned max_points = 5000;			//!< Samples a device that fell behind keeps, older ones are skipped
+	uint8_t sensor_count = 4;			//!< Sensor strips (CONFIG_SOCKETSENSE_SENSOR_COUNT)
+	uint8_t sensel_count = 8;			//!< Sensor elements per strip (CONFIG_SOCKETSENSE_SENSEL_COUNT)
+	bool tag_lines = false;				//!< Writes the device tag into the lines, for a database without the gateway
+	bool gorilla = true;				//!< Gorilla encoded frames (CONFIG_INFLUXDB_FRAME_COMPRESSION)
+	std::string uid_prefix = "sim";		//!< User-ids are the prefix followed by the number of the device
+	uint32_t seed = 1;					//!< Seed of the gait models and of the start times
+};
+
+/**
+ * @brief Results of the fleet since the last call of Fleet::takeStatistics().
+ */
+struct FleetStats {
+	uint64_t writes = 0;				//!< Successful writes (2xx or acknowledged frame)
+	uint64_t points = 0;				//!< Samples of the successful writes
+	uint64_t bytes = 0;					//!< Bodies or frames of the successful writes
+	uint64_t failed = 0;				//!< Writes without an answer (connection refused, closed or timed out)
+	uint64_t server_errors = 0;			//!< Writes answered with 5xx
+	uint64_t rejected = 0;				//!< Writes answered with another status
+	uint64_t failed_points = 0;			//!< Samples of the writes that did not succeed
+	uint64_t skipped_points = 0;		//!< Samples dropped because a device fell more than max_points behind
+	uint64_t connects = 0;				//!< Connections opened
+	std::vector<uint32_t> latency_us;	//!< From the time the batch was due to the answer
+	std::vector<uint32_t> service_us;	//!< From sending the batch to the answer
+	std::vector<uint32_t> age_us;		//!< Age of the oldest sample of the batch at the answer
+
+	/**
+	 * @brief Adds the results of another interval.
+	 */
+	void merge(const FleetStats &other);
+};
+
+/**
+ * @brief Returns a percentile of latencies, the values are reordered.
+ *
+ * @param values The latencies.
+ * @param fraction Percentile between 0 and 1.
+ * @return The percentile, 0 if there are no values.
+ */
+uint32_t percentile(std::vector<uint32_t> &values, double fraction);
+
+/**
+ * @brief Runs the simulated devices.
+ */
+class Fleet {
+public:
+	explicit Fleet(const FleetConfig &config);
+	~Fleet();
+
+	Fleet(const Fleet &) = delete;
+	Fleet &operator=(const Fleet &) = delete;
+
+	/**
+	 * @brief Starts the devices, spread over the first batch interval.
+	 */
+	void start();
+
+	/**
+	 * @brief Stops the devices after their current write.
+	 */
+	void stop();
+
+	/**
+	 * @brief Returns the results since the last call and resets them, may be called while the devices run.
+	 */
+	FleetStats takeStatistics();
+
+private:
+	void run(unsigned index);
+	void record(const FleetStats &result);
+
+	FleetConfig config_;
+	std::vector<std::thread> threads_;
+	std::mutex mutex_;
+	FleetStats stats_;
+	std::atomic<bool> running_{false};
+};
+
+} // namespace socketsense
+
+#endif /* TOOLS_LOADGEN_FLEET_H_ */
@@ -0,0 +1,108 @@
+/**
+ * @file gait_model.cpp
+ * @brief Synthetic socket pressures of an amputee who walks and stands, for load tests of the ingest path.
+ *
+ * @date October 17. 2026
+ */
+#include <algorithm>
+#include <cmath>
+
+#include "gait_model.h"
+
+namespace socketsense {
+
+namespace {
+
+const double STANCE = 0.6;					//!< Share of the stride with the foot on the ground
+const float FULL_SCALE = 4095.0f;			//!< 12 bit ADC of the sensor strips
+
+/**
+ * Hump of the ground reaction force around a phase of the stance.
+ */
+float hump(double phase, double center)
+{
+	double x = (phase - center) / 0.13;
+	return static_cast<float>(std::exp(-x * x));
+}
+
+} // namespace
+
+GaitModel::GaitModel(uint8_t sensor_count, uint8_t sensel_count, uint32_t seed) : random_(seed), noise_(0.0f, 6.0f)
+{
+	std::uniform_real_distribution<float> spread(0.8f, 1.2f);
+	const unsigned strips = std::max<unsigned>(sensor_count, 1);
+	const unsigned elements = std::max<unsigned>(sensel_count, 1);
+
+	stride_us_ = 1e6 * std::uniform_real_distribution<double>(0.95, 1.25)(random_);
+	sensels_.resize(static_cast<size_t>(sensor_count) * sensel_count);
+	for(unsigned strip = 0; strip < sensor_count; strip++){
+		const double angle = 2.0 * M_PI * strip / strips;						//0 is anterior, pi posterior
+		for(unsigned element = 0; element < sensel_count; element++){
+			const float distal = elements > 1 ? static_cast<float>(element) / (elements - 1) : 1.0f;
+			Sensel &sensel = sensels_[strip * sensel_count + element];
+			sensel.base = (250.0f + 250.0f * distal) * spread(random_);
+			sensel.loading = (300.0f + 1900.0f * distal) * static_cast<float>(0.55 - 0.45 * std::cos(angle)) * spread(random_);
+			sensel.push_off = (300.0f + 2100.0f * distal) * static_cast<float>(0.55 + 0.45 * std::cos(angle)) * spread(random_);
+		}
+	}
+
+	nextBout(0);
+	nextStride();
+}
+
+void GaitModel::sample(uint64_t time_us, uint16_t *sensels)
+{
+	if(time_us >= bout_end_){
+		nextBout(time_us);
+		stride_start_ = time_us;
+		nextStride();
+	}
+	while(walking_ && time_us >= stride_start_ + stride_length_){
+		stride_start_ += stride_length_;
+		nextStride();
+	}
+
+	float loading = 0.0f;
+	float push_off = 0.0f;
+	float unloaded = 0.0f;
+	if(walking_){
+		const double phase = static_cast<double>(time_us - stride_start_) / stride_length_;
+		if(phase < STANCE){
+			loading = hump(phase / STANCE, 0.22);
+			push_off = hump(phase / STANCE, 0.74);
+		}else{
+			unloaded = 0.15f * static_cast<float>(std::sin(M_PI * (phase - STANCE) / (1.0 - STANCE)));	//the liner pulls during swing
+		}
+	}else{
+		const float sway = 0.05f * static_cast<float>(std::sin(2.0 * M_PI * 0.3 * time_us * 1e-6));
+		loading = 0.35f + sway;
+		push_off = 0.35f - sway;
+	}
+
+	for(size_t i = 0; i < sensels_.size(); i++){
+		const Sensel &sensel = sensels_[i];
+		float value = sensel.base * (1.0f - unloaded) + sensel.loading * loading + sensel.push_off * push_off + noise_(random_);
+		sensels[i] = static_cast<uint16_t>(std::min(std::max(value, 0.0f), FULL_SCALE));
+	}
+}
+
+/**
+ * Draws the duration of the next stride, a few percent around the cadence of the subject.
+ */
+void GaitModel::nextStride()
+{
+	stride_length_ = static_cast<uint64_t>(stride_us_ * std::normal_distribution<double>(1.0, 0.03)(random_));
+}
+
+/**
+ * Alternates between walking and standing.
+ */
+void GaitModel::nextBout(uint64_t time_us)
+{
+	walking_ = time_us == 0 ? std::bernoulli_distribution(0.7)(random_) : !walking_;
+	double seconds = walking_ ? std::uniform_real_distribution<double>(20.0, 120.0)(random_)
+			: std::uniform_real_distribution<double>(5.0, 60.0)(random_);
+	bout_end_ = time_us + static_cast<uint64_t>(seconds * 1e6);
+}
+
+} // namespace socketsense
@@ -0,0 +1,70 @@
+/**
+ * @file gait_model.h
+ * @brief Synthetic socket pressures of an amputee who walks and stands, for load tests of the ingest path.
+ *
+ * A stride takes about a second, 60% of it is stance. During stance each sensor element follows the two humps of the
+ * ground reaction force: the loading response after heel strike and the push-off before toe-off. The strips are
+ * spread around the socket and the sensor elements of a strip run from proximal to distal, so the posterior distal
+ * elements peak at the loading response, the anterior distal ones at the push-off and the proximal ones stay near the
+ * pressure of the donned socket. The subject walks for bouts of 20 to 120 s and stands for 5 to 60 s between them,
+ * swaying slightly. Cadence, stride-to-stride variation and sensor noise differ between the simulated devices.
+ *
+ * @date October 17. 2026
+ */
+#ifndef TOOLS_LOADGEN_GAIT_MODEL_H_
+#define TOOLS_LOADGEN_GAIT_MODEL_H_
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace socketsense {
+
+/**
+ * @brief Sensor element values of one simulated socket.
+ */
+class GaitModel {
+public:
+	/**
+	 * @param sensor_count Number of sensor strips.
+	 * @param sensel_count Number of sensor elements per strip.
+	 * @param seed Seed of the device, devices with different seeds walk differently.
+	 */
+	GaitModel(uint8_t sensor_count, uint8_t sensel_count, uint32_t seed);
+
+	/**
+	 * @brief Writes the 12 bit values of all sensor elements (strip major) at a time.
+	 *
+	 * @param time_us Time in us since the start of the simulation, must not decrease between calls.
+	 * @param sensels Destination, sensor_count * sensel_count values.
+	 */
+	void sample(uint64_t time_us, uint16_t *sensels);
+
+	/**
+	 * @brief Returns true while the subject walks.
+	 */
+	bool walking() const { return walking_; }
+
+private:
+	void nextStride();
+	void nextBout(uint64_t time_us);
+
+	struct Sensel {
+		float base;					//!< Pressure of the donned socket without load
+		float loading;				//!< Amplitude at the loading response
+		float push_off;				//!< Amplitude at the push-off
+	};
+
+	std::vector<Sensel> sensels_;
+	std::mt19937 random_;
+	std::normal_distribution<float> noise_;
+	double stride_us_;				//!< Mean stride duration of the subject
+	uint64_t stride_start_ = 0;		//!< Start of the current stride
+	uint64_t stride_length_ = 0;	//!< Duration of the current stride
+	uint64_t bout_end_ = 0;			//!< End of the current walking or standing bout
+	bool walking_ = false;
+};
+
+} // namespace socketsense
+
+#endif /* TOOLS_LOADGEN_GAIT_MODEL_H_ */
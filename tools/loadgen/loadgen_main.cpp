@@ -0,0 +1,263 @@
+/**
+ * @file loadgen_main.cpp
+ * @brief Load generator that measures how many SocketSense devices an InfluxDB host or the gateway absorbs.
+ *
+ *   socketsense_loadgen [options]
+ *
+ * The simulated devices (see fleet.h) write to InfluxDB (-H, -P), to the gateway (-P 8096 for line protocol, -f with
+ * -P 8095 for frames), to an in-process mock InfluxDB (-M) or to an in-process gateway (-G) in front of one of them.
+ * A list of device counts (-n 16,32,64) runs one step per count. During a step the rates, the error rate and the
+ * latency percentiles are printed periodically; at the end a table compares the steps:
+ *
+ *   socketsense_loadgen -H 192.168.1.10 -u socketsense -w socketsense -n 10,20,50,100,200 -D 60
+ *   socketsense_loadgen -M -l 5 -G -f -n 50,100,200 -r 100
+ *
+ * @date October 17. 2026
+ */
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "batcher.h"
+#include "ingest_server.h"
+#include "mock_influx.h"
+#include "fleet.h"
+
+using namespace socketsense;
+
+static volatile std::sig_atomic_t stop_requested = 0;
+
+static void handleSignal(int)
+{
+	stop_requested = 1;
+}
+
+static void usage(const char *name)
+{
+	std::fprintf(stderr,
+			"Usage: %s [options]\n"
+			"  -H host      IPv4 address of InfluxDB or the gateway (127.0.0.1)\n"
+			"  -P port      port of InfluxDB or the gateway (8086)\n"
+			"  -d database  database (SOCKET_SENSE)\n"
+			"  -u user      InfluxDB user (no authentication)\n"
+			"  -w password  password of the user\n"
+			"  -f           send sample frames to the frame port of the gateway instead of line protocol\n"
+			"  -T           write the device tag into the lines (for InfluxDB without the gateway)\n"
+			"  -n counts    simulated devices, a comma separated list runs one step per count (16)\n"
+			"  -r Hz        samples per second of a device (10)\n"
+			"  -b points    samples per write (50)\n"
+			"  -t ms        maximum age of a batch (1000)\n"
+			"  -s strips    sensor strips (4)\n"
+			"  -e sensels   sensor elements per strip (8)\n"
+			"  -D seconds   duration of a step (30)\n"
+			"  -i seconds   report interval, 0 to disable (5)\n"
+			"  -M           write to an in-process mock InfluxDB instead of -H/-P\n"
+			"  -l ms        answer delay of the mock (0)\n"
+			"  -E rate      fraction of the writes the mock answers with 503 (0)\n"
+			"  -X rate      fraction of the writes whose connection the mock closes (0)\n"
+			"  -G           put an in-process gateway in front of the database\n"
+			"  -S seed      seed of the simulation (1)\n", name);
+}
+
+static double percent(uint64_t part, uint64_t total)
+{
+	return total > 0 ? 100.0 * part / total : 0.0;
+}
+
+static uint64_t errors(const FleetStats &stats)
+{
+	return stats.failed + stats.server_errors + stats.rejected;
+}
+
+static void printInterval(double elapsed, FleetStats &stats, double duration)
+{
+	std::printf("  %5.0f s %9.0f points/s %7.1f writes/s %6.2f%% errors  latency p50 %7.1f ms  p99 %7.1f ms  max %7.1f ms\n",
+			elapsed, stats.points / duration, stats.writes / duration, percent(errors(stats), stats.writes + errors(stats)),
+			percentile(stats.latency_us, 0.5) / 1e3, percentile(stats.latency_us, 0.99) / 1e3,
+			percentile(stats.latency_us, 1.0) / 1e3);
+	std::fflush(stdout);
+}
+
+struct Step {
+	unsigned devices;
+	double duration;
+	FleetStats stats;
+};
+
+int main(int argc, char **argv)
+{
+	FleetConfig config;
+	MockInfluxConfig mock_config;
+	std::vector<unsigned> counts;
+	std::string count_list = "16";
+	double duration = 30.0;
+	double report_interval = 5.0;
+	bool mock = false;
+	bool gateway = false;
+	int opt;
+
+	mock_config.port = 0;
+	while((opt = getopt(argc, argv, "H:P:d:u:w:fTn:r:b:t:s:e:D:i:Ml:E:X:GS:h")) != -1){
+		switch(opt){
+			case 'H': config.target.host = optarg; break;
+			case 'P': config.target.port = std::atoi(optarg); break;
+			case 'd': config.target.database = optarg; break;
+			case 'u': config.target.username = optarg; break;
+			case 'w': config.target.password = optarg; break;
+			case 'f': config.protocol = FleetProtocol::Frames; break;
+			case 'T': config.tag_lines = true; break;
+			case 'n': count_list = optarg; break;
+			case 'r': config.sample_rate = std::atof(optarg); break;
+			case 'b': config.batch_points = std::strtoul(optarg, nullptr, 10); break;
+			case 't': config.batch_timeout_ms = std::atoi(optarg); break;
+			case 's': config.sensor_count = std::atoi(optarg); break;
+			case 'e': config.sensel_count = std::atoi(optarg); break;
+			case 'D': duration = std::atof(optarg); break;
+			case 'i': report_interval = std::atof(optarg); break;
+			case 'M': mock = true; break;
+			case 'l': mock_config.delay_ms = std::atoi(optarg); break;
+			case 'E': mock_config.error_rate = std::atof(optarg); break;
+			case 'X': mock_config.disconnect_rate = std::atof(optarg); break;
+			case 'G': gateway = true; break;
+			case 'S': config.seed = std::strtoul(optarg, nullptr, 10); break;
+			default: usage(argv[0]); return 1;
+		}
+	}
+	std::stringstream list(count_list);
+	std::string item;
+	while(std::getline(list, item, ',')){
+		if(std::atoi(item.c_str()) > 0){
+			counts.push_back(std::atoi(item.c_str()));
+		}
+	}
+	if(optind != argc || counts.empty() || duration <= 0 || config.sample_rate <= 0
+			|| config.sensor_count * config.sensel_count > SAMPLE_FRAME_MAX_SENSELS){
+		usage(argv[0]);
+		return 1;
+	}
+	if(config.protocol == FleetProtocol::Frames && mock && !gateway){
+		std::fprintf(stderr, "The mock InfluxDB does not accept frames, add -G\n");
+		return 1;
+	}
+
+	std::signal(SIGINT, handleSignal);
+	std::signal(SIGTERM, handleSignal);
+	std::printf("%s, %.1f samples/s per device, %u samples per write, %ux%u sensels, writing to %s\n",
+			config.protocol == FleetProtocol::Frames ? "frames" : "line protocol", config.sample_rate, config.batch_points,
+			config.sensor_count, config.sensel_count, mock ? (gateway ? "gateway and mock InfluxDB" : "mock InfluxDB")
+			: (gateway ? "gateway and InfluxDB" : "InfluxDB"));
+
+	std::vector<Step> steps;
+	for(unsigned devices : counts){
+		if(stop_requested){
+			break;
+		}
+
+		std::unique_ptr<MockInflux> mock_server;
+		std::unique_ptr<InfluxClient> gateway_client;
+		std::unique_ptr<Batcher> batcher;
+		std::unique_ptr<IngestServer> server;
+		FleetConfig step_config = config;
+		InfluxConfig database = config.target;
+		if(mock){
+			mock_server.reset(new MockInflux(mock_config));
+			if(!mock_server->start()){
+				return 1;
+			}
+			database.host = "127.0.0.1";
+			database.port = mock_server->port();
+			step_config.target.host = database.host;
+			step_config.target.port = database.port;
+		}
+		if(gateway){
+			IngestServerConfig serving;
+			serving.frame_port = 0;
+			serving.http_port = 0;
+			serving.loopback = true;
+			gateway_client.reset(new InfluxClient(database));
+			InfluxClient *client = gateway_client.get();
+			batcher.reset(new Batcher(BatcherConfig(), [client](const std::string &body){ return client->write(body); }));
+			server.reset(new IngestServer(serving, *batcher));
+			IngestServer *ingest = server.get();
+			batcher->setSpaceListener([ingest]{ ingest->wake(); });
+			batcher->start();
+			if(!server->start()){
+				return 1;
+			}
+			step_config.target.host = "127.0.0.1";
+			step_config.target.port = config.protocol == FleetProtocol::Frames ? server->framePort() : server->httpPort();
+		}
+		step_config.devices = devices;
+
+		std::printf("%u devices\n", devices);
+		Fleet fleet(step_config);
+		fleet.start();
+		const double warmup = std::min(config.batch_points / config.sample_rate, config.batch_timeout_ms / 1000.0) + 1.0;
+		for(int i = 0; i < warmup * 10 && !stop_requested; i++){		//until every device has started
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		}
+		fleet.takeStatistics();
+
+		auto start = std::chrono::steady_clock::now();
+		auto last = start;
+		Step step{devices, 0.0, FleetStats()};
+		while(!stop_requested){
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			auto now = std::chrono::steady_clock::now();
+			double elapsed = std::chrono::duration<double>(now - start).count();
+			double since = std::chrono::duration<double>(now - last).count();
+			if(elapsed >= duration || (report_interval > 0 && since >= report_interval)){
+				FleetStats interval = fleet.takeStatistics();
+				if(report_interval > 0){
+					printInterval(elapsed, interval, since);
+				}
+				step.stats.merge(interval);
+				last = now;
+			}
+			if(elapsed >= duration){
+				break;
+			}
+		}
+		fleet.stop();
+		step.stats.merge(fleet.takeStatistics());
+		step.duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		steps.push_back(std::move(step));
+
+		if(server){
+			batcher->stop();
+			server->stop();
+		}
+		if(mock_server){
+			mock_server->stop();
+		}
+	}
+
+	std::printf("\ndevices   points/s   writes/s    MB/s  errors  skipped | latency ms  p50     p90     p99   p99.9     max | "
+			"service p99 | age p99\n");
+	for(Step &step : steps){
+		FleetStats &stats = step.stats;
+		std::printf("%7u %10.0f %10.1f %7.2f %6.2f%% %8llu | %19.1f %7.1f %7.1f %7.1f %7.1f | %11.1f | %7.1f\n", step.devices,
+				stats.points / step.duration, stats.writes / step.duration, stats.bytes / step.duration / 1e6,
+				percent(errors(stats), stats.writes + errors(stats)), (unsigned long long) stats.skipped_points,
+				percentile(stats.latency_us, 0.5) / 1e3, percentile(stats.latency_us, 0.9) / 1e3,
+				percentile(stats.latency_us, 0.99) / 1e3, percentile(stats.latency_us, 0.999) / 1e3,
+				percentile(stats.latency_us, 1.0) / 1e3, percentile(stats.service_us, 0.99) / 1e3,
+				percentile(stats.age_us, 0.99) / 1e3);
+		if(errors(stats) > 0){
+			std::printf("        %llu without answer, %llu 5xx, %llu rejected, %llu samples lost, %llu connections\n",
+					(unsigned long long) stats.failed, (unsigned long long) stats.server_errors,
+					(unsigned long long) stats.rejected, (unsigned long long) stats.failed_points,
+					(unsigned long long) stats.connects);
+		}
+	}
+
+	return 0;
+}
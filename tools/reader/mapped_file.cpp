@@ -0,0 +1,66 @@
+/**
+ * @file mapped_file.cpp
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * @date October 17. 2026
+ */
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace socketsense {
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const std::string &path)
+{
+	struct stat info;
+
+	close();
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if(fd < 0){
+		return false;
+	}
+	if(fstat(fd, &info) != 0){
+		::close(fd);
+		return false;
+	}
+
+	size_ = static_cast<size_t>(info.st_size);
+	if(size_ > 0){
+		void *mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(mapping == MAP_FAILED){
+			size_ = 0;
+			::close(fd);
+			return false;
+		}
+		data_ = static_cast<const uint8_t *>(mapping);
+	}
+	::close(fd);															//the mapping keeps the file open
+
+	return true;
+}
+
+void MappedFile::advise(Access access)
+{
+	if(data_ != nullptr){
+		madvise(const_cast<uint8_t *>(data_), size_, access == Access::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+	}
+}
+
+void MappedFile::close()
+{
+	if(data_ != nullptr){
+		munmap(const_cast<uint8_t *>(data_), size_);
+	}
+	data_ = nullptr;
+	size_ = 0;
+}
+
+} // namespace socketsense
@@ -0,0 +1,59 @@
+/**
+ * @file mapped_file.h
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * @date October 17. 2026
+ */
+#ifndef TOOLS_READER_MAPPED_FILE_H_
+#define TOOLS_READER_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace socketsense {
+
+/**
+ * @brief Maps a file read-only into memory, the mapping is removed by the destructor.
+ */
+class MappedFile {
+public:
+	/**
+	 * @brief Expected access pattern, passed on to the kernel to tune the read-ahead.
+	 */
+	enum class Access {
+		Sequential,		//!< The file is read from the start to the end
+		Random			//!< Only parts of the file are read
+	};
+
+	MappedFile() = default;
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+	~MappedFile();
+
+	/**
+	 * @brief Maps the file, an empty file is mapped with a size of 0.
+	 *
+	 * @param path Path of the file.
+	 * @return False if the file can't be opened or mapped.
+	 */
+	bool open(const std::string &path);
+
+	/**
+	 * @brief Sets the expected access pattern of the whole mapping.
+	 */
+	void advise(Access access);
+
+	const uint8_t *data() const { return data_; }
+	size_t size() const { return size_; }
+
+private:
+	void close();
+
+	const uint8_t *data_ = nullptr;
+	size_t size_ = 0;
+};
+
+} // namespace socketsense
+
+#endif /* TOOLS_READER_MAPPED_FILE_H_ */
@@ -0,0 +1,238 @@
+/**
+ * @file reader_benchmark.cpp
+ * @brief Throughput benchmark of RecordingReader on large synthetic recordings.
+ *
+ * A recording with gait-like sensor values is written as line protocol, as Gorilla sample frames and as column blocks,
+ * the three formats of the SD-card log. Each file is then read through RecordingReader: all samples, a time range of
+ * 10% in the middle, one sensor element column, and the CSV export. For each step the throughput in GB/s of the file
+ * and in samples/s is reported. Each file is read once before the measurements, so they show the parsing and not
+ * the disk.
+ *
+ *   reader_benchmark [-m MB of line protocol] [-s strips] [-e sensels per strip] [-d directory]
+ *
+ * @date October 17. 2026
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "sample_frame.h"
+#include "column_file.h"
+#include "line_writer.h"
+#include "mapped_file.h"
+#include "recording_export.h"
+#include "recording_reader.h"
+
+using namespace socketsense;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const unsigned FRAME_POINTS = 50;		//!< Points per sample frame, like CONFIG_INFLUXDB_BATCH_SIZE
+
+double seconds(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void report(const char *name, double duration, uint64_t samples, size_t bytes)
+{
+	std::printf("%-30s %7.2f GB/s %8.2f M samples/s %9.1f ms\n", name, bytes / duration / 1e9, samples / duration / 1e6,
+			duration * 1e3);
+}
+
+struct Recording {
+	uint64_t samples = 0;
+	uint64_t first_us = 0;
+	uint64_t last_us = 0;
+};
+
+/**
+ * Writes the synthetic recording in the three formats until the line protocol has the requested size.
+ */
+bool generate(const std::string &directory, size_t text_bytes, unsigned sensors, unsigned sensels, Recording &recording)
+{
+	const unsigned count = sensors * sensels;
+	std::vector<uint16_t> values(count);
+	std::vector<uint8_t> frame_buffer(SAMPLE_FRAME_HEADER_SIZE + FRAME_POINTS * SAMPLE_FRAME_MAX_POINT_SIZE(count));
+	sample_frame_t frame;
+	sample_frame_point_t point{};
+	ColumnWriter columns;
+	LineWriter writer;
+	std::string lines;
+	size_t written = 0;
+	uint32_t sequence = 0;
+
+	FILE *text = std::fopen((directory + "/synthetic.txt").c_str(), "wb");
+	FILE *frames = std::fopen((directory + "/synthetic.sfr").c_str(), "wb");
+	bool ok = text != nullptr && frames != nullptr
+			&& columns.open(directory + "/synthetic.col", sensors, sensels, 128, 64);
+
+	sample_frame_init(&frame, frame_buffer.data(), frame_buffer.size(), sensors, sensels, SAMPLE_FRAME_ENCODING_GORILLA);
+	writer.setDevice("bench");
+	point.timestamp_usec = 1571234567890123ULL;
+	point.sensels = values.data();
+	recording.first_us = point.timestamp_usec + 10000;
+	while(ok && written < text_bytes){
+		lines.clear();
+		for(unsigned p = 0; p < FRAME_POINTS; p++){							//same waveforms as decode_benchmark
+			double t = point.timestamp_usec * 1e-6;
+			point.timestamp_usec += 10000 + (p % 7);
+			point.temperature = 25.0f + 0.01f * static_cast<float>(std::sin(t * 0.01));
+			point.humidity = 39.0f + 0.02f * static_cast<float>(std::sin(t * 0.02));
+			point.pressure = 100655.0f + static_cast<float>(std::sin(t * 0.005));
+			point.sampling_time = 2400 + (p % 50);
+			point.battery_voltage = 3950;
+			for(unsigned i = 0; i < count; i++){
+				double phase = std::fmod(t + i * 0.05, 1.0);
+				values[i] = static_cast<uint16_t>(phase < 0.6 ? 400 + 3000 * std::sin(phase / 0.6 * M_PI) : 400 + (i * 7) % 13);
+			}
+			writer.append(lines, point, sensors, sensels);
+			sample_frame_append(&frame, &point);
+			ok = columns.append(point) && ok;
+			recording.samples++;
+		}
+		size_t length = sample_frame_finish(&frame, sequence++);
+		ok = std::fwrite(frame_buffer.data(), 1, length, frames) == length && ok;
+		ok = std::fwrite(lines.data(), 1, lines.size(), text) == lines.size() && ok;
+		sample_frame_clear(&frame);
+		written += lines.size();
+	}
+	recording.last_us = point.timestamp_usec;
+
+	ok = columns.close() && ok;
+	if(text != nullptr){
+		ok = std::fclose(text) == 0 && ok;
+	}
+	if(frames != nullptr){
+		ok = std::fclose(frames) == 0 && ok;
+	}
+
+	return ok;
+}
+
+/**
+ * Runs the measurements on one file, returns false if the samples differ from the recording.
+ */
+bool measure(const std::string &path, const char *name, const Recording &recording)
+{
+	RecordingReader reader;
+	if(!reader.open(path)){
+		std::fprintf(stderr, "Can't read %s\n", path.c_str());
+		return false;
+	}
+	std::printf("%s: %zu bytes, %.1f bytes/sample\n", name, reader.size(), static_cast<double>(reader.size()) / recording.samples);
+
+	const uint32_t count = static_cast<uint32_t>(reader.sensorCount()) * reader.senselCount();
+	const uint32_t sensel_column = COLUMN_LOG_COLUMN_SENSEL + count / 2;
+	const uint64_t span = recording.last_us - recording.first_us;
+	TimeRange middle;
+	middle.start_us = recording.first_us + span * 45 / 100;
+	middle.end_us = recording.first_us + span * 55 / 100;
+	uint64_t checksum = 0;
+	uint64_t samples;
+	std::string label;
+	bool ok = true;
+
+	auto sum = [&](const sample_frame_point_t &point) {
+		checksum += point.timestamp_usec + point.sensels[count - 1];
+		return true;
+	};
+	reader.forEach(TimeRange(), sum);												//page in the file
+
+	auto start = Clock::now();
+	samples = reader.forEach(TimeRange(), sum);
+	label = std::string(name) + ": all samples";
+	report(label.c_str(), seconds(start), samples, reader.size());
+	ok = samples == recording.samples && reader.invalid() == 0 && ok;
+
+	start = Clock::now();
+	samples = reader.forEach(middle, sum);
+	label = std::string(name) + ": 10% time range";
+	report(label.c_str(), seconds(start), samples, reader.size());
+
+	start = Clock::now();
+	samples = reader.forEachColumns(TimeRange(), {sensel_column}, [&](size_t n, const uint8_t *const *values) {
+		uint16_t value;
+		std::memcpy(&value, values[0] + (n - 1) * sizeof(uint16_t), sizeof(value));
+		checksum += value;
+		return true;
+	});
+	label = std::string(name) + ": one sensel column";
+	report(label.c_str(), seconds(start), samples, reader.size());
+	ok = samples == recording.samples && ok;
+
+	FILE *null = std::fopen("/dev/null", "wb");
+	std::vector<uint32_t> columns;
+	for(uint32_t column = 0; column < reader.columnCount(); column++){
+		columns.push_back(column);
+	}
+	start = Clock::now();
+	ok = null != nullptr && exportCsv(reader, TimeRange(), columns, null, samples) && ok;
+	label = std::string(name) + ": CSV export";
+	report(label.c_str(), seconds(start), samples, reader.size());
+	if(null != nullptr){
+		std::fclose(null);
+	}
+
+	if(checksum == 0){																//keeps the visitors from being optimized away
+		std::printf("checksum 0\n");
+	}
+
+	return ok;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	unsigned long megabytes = 256;
+	unsigned sensors = 4;
+	unsigned sensels = 8;
+	std::string directory = "/tmp";
+	int opt;
+
+	while((opt = getopt(argc, argv, "m:s:e:d:")) != -1){
+		switch(opt){
+			case 'm': megabytes = std::strtoul(optarg, nullptr, 10); break;
+			case 's': sensors = std::atoi(optarg); break;
+			case 'e': sensels = std::atoi(optarg); break;
+			case 'd': directory = optarg; break;
+			default:
+				std::fprintf(stderr, "Usage: %s [-m MB of line protocol] [-s strips] [-e sensels per strip] [-d directory]\n", argv[0]);
+				return 1;
+		}
+	}
+	if(megabytes == 0 || sensors == 0 || sensels == 0 || sensors > 255 || sensels > 255 || sensors * sensels > SAMPLE_FRAME_MAX_SENSELS){
+		std::fprintf(stderr, "Invalid geometry or size\n");
+		return 1;
+	}
+
+	Recording recording;
+	auto start = Clock::now();
+	if(!generate(directory, megabytes * 1000000, sensors, sensels, recording)){
+		std::fprintf(stderr, "Can't write the recordings to %s\n", directory.c_str());
+		return 1;
+	}
+	std::printf("%llu samples with %ux%u sensels written in %.1f s\n", static_cast<unsigned long long>(recording.samples),
+			sensors, sensels, seconds(start));
+
+	bool ok = measure(directory + "/synthetic.txt", "text", recording);
+	ok = measure(directory + "/synthetic.sfr", "frames", recording) && ok;
+	ok = measure(directory + "/synthetic.col", "columns", recording) && ok;
+	if(!ok){
+		std::fprintf(stderr, "The samples read differ from the recording\n");
+	}
+
+	std::remove((directory + "/synthetic.txt").c_str());
+	std::remove((directory + "/synthetic.sfr").c_str());
+	std::remove((directory + "/synthetic.col").c_str());
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file recording_export.cpp
+ * @brief Exports the samples of a recording, see recording_export.h.
+ *
+ * @date October 17. 2026
+ */
+#include "recording_export.h"
+
+#include <charconv>
+#include <cstring>
+#include <memory>
+
+#include "column_file.h"
+#include "line_writer.h"
+
+namespace socketsense {
+
+namespace {
+
+const size_t CSV_BUFFER = 1 << 20;		//!< The CSV text is written in chunks of this size
+
+struct FileCloser {
+	void operator()(FILE *file) const { std::fclose(file); }
+};
+
+/**
+ * Writes one value of a column as text.
+ */
+char *writeValue(char *dst, uint32_t column, const uint8_t *value)
+{
+	if(column == COLUMN_LOG_COLUMN_TIMESTAMP){
+		uint64_t timestamp;
+		std::memcpy(&timestamp, value, sizeof(timestamp));
+		return std::to_chars(dst, dst + 20, timestamp).ptr;
+	}
+	if(column < COLUMN_LOG_COLUMN_SAMPLING_TIME){
+		float number;
+		std::memcpy(&number, value, sizeof(number));
+		return LineWriter::writeFixed2(dst, number);
+	}
+	if(column < COLUMN_LOG_COLUMN_SENSEL){
+		uint32_t number;
+		std::memcpy(&number, value, sizeof(number));
+		return std::to_chars(dst, dst + 10, number).ptr;
+	}
+
+	uint16_t sensel;
+	std::memcpy(&sensel, value, sizeof(sensel));
+	return std::to_chars(dst, dst + 5, sensel).ptr;
+}
+
+} // namespace
+
+bool exportCsv(RecordingReader &reader, const TimeRange &range, const std::vector<uint32_t> &columns, FILE *out,
+		uint64_t &samples)
+{
+	const size_t max_row = columns.size() * 24 + 1;			//a value and its separator take at most 24 characters
+	std::vector<char> buffer(CSV_BUFFER + max_row);
+	char *pos = buffer.data();
+	bool ok = true;
+
+	std::string header;
+	for(size_t k = 0; k < columns.size(); k++){
+		header += (k > 0 ? "," : "") + columnName(columns[k], reader.senselCount());
+	}
+	header += '\n';
+	ok = std::fwrite(header.data(), 1, header.size(), out) == header.size();
+
+	samples = reader.forEachColumns(range, columns, [&](size_t count, const uint8_t *const *values) {
+		for(size_t i = 0; i < count; i++){
+			for(size_t k = 0; k < columns.size(); k++){
+				if(k > 0){
+					*pos++ = ',';
+				}
+				pos = writeValue(pos, columns[k], values[k] + i * columnSize(columns[k]));
+			}
+			*pos++ = '\n';
+			if(pos - buffer.data() >= static_cast<std::ptrdiff_t>(CSV_BUFFER)){
+				ok = std::fwrite(buffer.data(), 1, pos - buffer.data(), out) == static_cast<size_t>(pos - buffer.data()) && ok;
+				pos = buffer.data();
+			}
+		}
+		return ok;
+	});
+	ok = std::fwrite(buffer.data(), 1, pos - buffer.data(), out) == static_cast<size_t>(pos - buffer.data()) && ok;
+
+	return ok;
+}
+
+bool exportColumns(RecordingReader &reader, const TimeRange &range, const std::vector<uint32_t> &columns,
+		const std::string &directory, uint64_t &samples)
+{
+	std::vector<std::unique_ptr<FILE, FileCloser>> files;
+	bool ok = true;
+
+	for(uint32_t column : columns){
+		std::string path = directory + "/" + columnName(column, reader.senselCount()) + ".bin";
+		files.emplace_back(std::fopen(path.c_str(), "wb"));
+		if(files.back() == nullptr){
+			return false;
+		}
+	}
+
+	samples = reader.forEachColumns(range, columns, [&](size_t count, const uint8_t *const *values) {
+		for(size_t k = 0; k < columns.size(); k++){
+			ok = std::fwrite(values[k], columnSize(columns[k]), count, files[k].get()) == count && ok;
+		}
+		return ok;
+	});
+	for(auto &file : files){
+		ok = std::fclose(file.release()) == 0 && ok;
+	}
+
+	return ok;
+}
+
+bool exportColumnLog(RecordingReader &reader, const TimeRange &range, const std::string &path, uint32_t block_samples,
+		uint32_t index_interval, uint64_t &samples)
+{
+	ColumnWriter writer;
+	bool ok;
+
+	if(!writer.open(path, reader.sensorCount(), reader.senselCount(), block_samples, index_interval)){
+		return false;
+	}
+	ok = true;
+	samples = reader.forEach(range, [&](const sample_frame_point_t &point) {
+		ok = writer.append(point) && ok;
+		return ok;
+	});
+
+	return writer.close() && ok;
+}
+
+} // namespace socketsense
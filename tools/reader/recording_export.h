@@ -0,0 +1,57 @@
+/**
+ * @file recording_export.h
+ * @brief Exports the samples of a recording to CSV, to one raw array file per column, or to a column log-file.
+ *
+ * The raw arrays hold the values in the native byte order without any header (uint64_t timestamps, float BME280
+ * values, uint32_t sampling time and battery voltage, uint16_t sensor elements), so they can be loaded directly,
+ * e.g. with numpy.fromfile(). The column log-file (column_log.h) keeps all columns in blocks with their time range
+ * and an index, like a Parquet file with row groups, and is read by column_tool and RecordingReader.
+ *
+ * @date October 17. 2026
+ */
+#ifndef TOOLS_READER_RECORDING_EXPORT_H_
+#define TOOLS_READER_RECORDING_EXPORT_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "recording_reader.h"
+
+namespace socketsense {
+
+/**
+ * @brief Writes the columns of the samples in the range as CSV with a header line.
+ *
+ * The BME280 values are written with two decimals like in the line protocol.
+ *
+ * @param reader The recording.
+ * @param range Time range.
+ * @param columns The columns in the order of the CSV.
+ * @param out Destination.
+ * @param samples Number of written samples.
+ * @return False if writing failed.
+ */
+bool exportCsv(RecordingReader &reader, const TimeRange &range, const std::vector<uint32_t> &columns, FILE *out,
+		uint64_t &samples);
+
+/**
+ * @brief Writes each column of the samples in the range to <directory>/<column name>.bin.
+ *
+ * @return False if a file can't be written.
+ */
+bool exportColumns(RecordingReader &reader, const TimeRange &range, const std::vector<uint32_t> &columns,
+		const std::string &directory, uint64_t &samples);
+
+/**
+ * @brief Writes the samples in the range to a column log-file.
+ *
+ * @return False if the file can't be written.
+ */
+bool exportColumnLog(RecordingReader &reader, const TimeRange &range, const std::string &path, uint32_t block_samples,
+		uint32_t index_interval, uint64_t &samples);
+
+} // namespace socketsense
+
+#endif /* TOOLS_READER_RECORDING_EXPORT_H_ */
@@ -0,0 +1,465 @@
+/**
+ * @file recording_reader.cpp
+ * @brief Iterates the samples of SD-card recordings straight from a memory mapping, see recording_reader.h.
+ *
+ * @date October 17. 2026
+ */
+#include "recording_reader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+#include "line_parser.h"
+#include "simd_line_parser.h"
+
+namespace socketsense {
+
+namespace {
+
+const size_t GATHER_ROWS = 4096;		//!< Samples per run when the columns have to be gathered
+const unsigned GEOMETRY_LINES = 64;		//!< Lines at the start of a text recording that define its geometry
+const size_t TEXT_CHUNK = 1 << 20;		//!< Bytes of line protocol parsed into columns at once
+
+/**
+ * Reads the timestamp at the end of a line without parsing the line.
+ */
+bool lineTimestamp(const char *begin, const char *end, uint64_t &timestamp)
+{
+	const char *pos = end;
+	while(pos > begin && pos[-1] != ' '){
+		pos--;
+	}
+	auto result = std::from_chars(pos, end, timestamp);
+	return pos > begin && result.ec == std::errc() && result.ptr == end;
+}
+
+const void *pointValue(const sample_frame_point_t &point, uint32_t column)
+{
+	switch(column){
+		case COLUMN_LOG_COLUMN_TIMESTAMP: return &point.timestamp_usec;
+		case COLUMN_LOG_COLUMN_TEMPERATURE: return &point.temperature;
+		case COLUMN_LOG_COLUMN_HUMIDITY: return &point.humidity;
+		case COLUMN_LOG_COLUMN_PRESSURE: return &point.pressure;
+		case COLUMN_LOG_COLUMN_SAMPLING_TIME: return &point.sampling_time;
+		case COLUMN_LOG_COLUMN_BATTERY: return &point.battery_voltage;
+		default: return &point.sensels[column - COLUMN_LOG_COLUMN_SENSEL];
+	}
+}
+
+const void *columnData(const LineColumns &columns, uint32_t column)
+{
+	switch(column){
+		case COLUMN_LOG_COLUMN_TIMESTAMP: return columns.timestamps.data();
+		case COLUMN_LOG_COLUMN_TEMPERATURE: return columns.temperature.data();
+		case COLUMN_LOG_COLUMN_HUMIDITY: return columns.humidity.data();
+		case COLUMN_LOG_COLUMN_PRESSURE: return columns.pressure.data();
+		case COLUMN_LOG_COLUMN_SAMPLING_TIME: return columns.sampling_time.data();
+		case COLUMN_LOG_COLUMN_BATTERY: return columns.battery_voltage.data();
+		default: return columns.sensels[column - COLUMN_LOG_COLUMN_SENSEL].data();
+	}
+}
+
+/**
+ * Collects the requested columns of single samples into runs for a ColumnVisitor.
+ */
+class ColumnGather {
+public:
+	ColumnGather(const std::vector<uint32_t> &columns, const ColumnVisitor &visit)
+		: columns_(columns), visit_(visit), buffers_(columns.size()), values_(columns.size())
+	{
+		for(size_t k = 0; k < columns.size(); k++){
+			buffers_[k].resize(GATHER_ROWS * columnSize(columns[k]));
+			values_[k] = buffers_[k].data();
+		}
+	}
+
+	bool add(const sample_frame_point_t &point)
+	{
+		for(size_t k = 0; k < columns_.size(); k++){
+			size_t size = columnSize(columns_[k]);
+			std::memcpy(buffers_[k].data() + rows_ * size, pointValue(point, columns_[k]), size);
+		}
+		return ++rows_ < GATHER_ROWS || flush();
+	}
+
+	bool flush()
+	{
+		size_t rows = rows_;
+		rows_ = 0;
+		return rows == 0 || visit_(rows, values_.data());
+	}
+
+private:
+	const std::vector<uint32_t> &columns_;
+	const ColumnVisitor &visit_;
+	std::vector<std::vector<uint8_t>> buffers_;
+	std::vector<const uint8_t *> values_;
+	size_t rows_ = 0;
+};
+
+} // namespace
+
+std::string columnName(uint32_t column, uint8_t sensel_count)
+{
+	static const char *const NAMES[] = {"timestamp", "temp", "hum", "pres", "st", "bl"};
+
+	if(column < COLUMN_LOG_COLUMN_SENSEL){
+		return NAMES[column];
+	}
+	uint32_t sensel = column - COLUMN_LOG_COLUMN_SENSEL;
+	return "s" + std::to_string(sensel / sensel_count) + "_" + std::to_string(sensel % sensel_count);
+}
+
+bool parseColumnName(const std::string &name, uint8_t sensor_count, uint8_t sensel_count, uint32_t &column)
+{
+	const uint32_t count = COLUMN_LOG_COLUMN_SENSEL + static_cast<uint32_t>(sensor_count) * sensel_count;
+
+	for(column = 0; column < count; column++){
+		if(columnName(column, sensel_count) == name){
+			return true;
+		}
+	}
+
+	return false;
+}
+
+size_t columnSize(uint32_t column)
+{
+	if(column == COLUMN_LOG_COLUMN_TIMESTAMP){
+		return sizeof(uint64_t);
+	}
+
+	return column < COLUMN_LOG_COLUMN_SENSEL ? sizeof(uint32_t) : sizeof(uint16_t);
+}
+
+bool RecordingReader::open(const std::string &path)
+{
+	sample_frame_header_t frame;
+	column_log_header_t block;
+
+	if(!file_.open(path)){
+		return false;
+	}
+
+	const uint8_t *data = file_.data();
+	size_t offset = 0;
+	if(file_.size() >= 3 && data[0] == 'S' && data[1] == 'C' && data[2] == COLUMN_LOG_VERSION){
+		format_ = RecordingFormat::Columns;
+		for(; nextBlock(offset, block); offset += block.length){
+			if(block.type == COLUMN_LOG_TYPE_SAMPLES){
+				sensor_count_ = block.sensor_count;
+				sensel_count_ = block.sensel_count;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	if(sample_frame_parseHeader(data, file_.size(), &frame) == SAMPLE_FRAME_OK){
+		format_ = RecordingFormat::Frames;
+		while(offset + SAMPLE_FRAME_HEADER_SIZE <= file_.size()
+				&& sample_frame_parseHeader(data + offset, file_.size() - offset, &frame) == SAMPLE_FRAME_OK){
+			if(frame.type == SAMPLE_FRAME_TYPE_SAMPLES){
+				sensor_count_ = frame.sensor_count;
+				sensel_count_ = frame.sensel_count;
+				return true;
+			}
+			offset += SAMPLE_FRAME_HEADER_SIZE + frame.payload_length;
+		}
+		return false;
+	}
+
+	format_ = RecordingFormat::Text;
+	return detectGeometry();
+}
+
+uint64_t RecordingReader::forEach(const TimeRange &range, const SampleVisitor &visit)
+{
+	invalid_ = 0;
+	file_.advise(format_ == RecordingFormat::Columns && !range.all() ? MappedFile::Access::Random
+			: MappedFile::Access::Sequential);
+
+	switch(format_){
+		case RecordingFormat::Text: return forEachLine(range, visit);
+		case RecordingFormat::Frames: return forEachFrame(range, visit);
+		default: return forEachBlock(range, nullptr, &visit, nullptr);
+	}
+}
+
+uint64_t RecordingReader::forEachColumns(const TimeRange &range, const std::vector<uint32_t> &columns,
+		const ColumnVisitor &visit)
+{
+	if(format_ == RecordingFormat::Columns){
+		invalid_ = 0;
+		file_.advise(range.all() ? MappedFile::Access::Sequential : MappedFile::Access::Random);
+		return forEachBlock(range, &columns, nullptr, &visit);
+	}
+
+	if(format_ == RecordingFormat::Text){
+		std::vector<const uint8_t *> values(columns.size());
+		invalid_ = 0;
+		file_.advise(MappedFile::Access::Sequential);
+		return parseLines(range, [&](const LineColumns &parsed) {
+			for(size_t k = 0; k < columns.size(); k++){
+				values[k] = static_cast<const uint8_t *>(columnData(parsed, columns[k]));
+			}
+			return visit(parsed.rows(), values.data());
+		});
+	}
+
+	ColumnGather gather(columns, visit);
+	bool running = true;
+	uint64_t samples = forEach(range, [&](const sample_frame_point_t &point) {
+		running = gather.add(point);
+		return running;
+	});
+	if(running){
+		gather.flush();
+	}
+
+	return samples;
+}
+
+/**
+ * Parses the lines into columns with SimdLineParser, a chunk of lines at a time, the values of the sensor elements are
+ * held in the geometry of the recording. Without a deadband the runs of lines outside of the time range are skipped
+ * by their timestamp and only the other lines are handed to the parser.
+ */
+uint64_t RecordingReader::parseLines(const TimeRange &range, const std::function<bool(const LineColumns &)> &visit)
+{
+	const char *pos = reinterpret_cast<const char *>(file_.data());
+	const char *end = pos + file_.size();
+	const char *run = pos;
+	SimdLineParser parser;
+	LineColumns columns;
+	uint64_t samples = 0;
+	bool filter = !range.all() && !sparse_;
+	bool running = true;
+
+	columns.reset(sensor_count_, sensel_count_);
+	parser.setRange(range.start_us, range.end_us);
+	auto flush = [&](const char *until) {
+		while(running && run < until){
+			const char *chunk_end = until;
+			if(static_cast<size_t>(until - run) > TEXT_CHUNK){
+				const char *newline = static_cast<const char *>(std::memchr(run + TEXT_CHUNK, '\n', until - run - TEXT_CHUNK));
+				chunk_end = newline != nullptr ? newline + 1 : until;
+			}
+			columns.clear();
+			parser.parse(run, chunk_end - run, columns);
+			run = chunk_end;
+			samples += columns.rows();
+			running = columns.rows() == 0 || visit(columns);
+		}
+	};
+
+	while(filter && running && pos < end){
+		const char *newline = static_cast<const char *>(std::memchr(pos, '\n', end - pos));
+		const char *line_end = newline != nullptr ? newline : end;
+		const char *next = newline != nullptr ? newline + 1 : end;
+		uint64_t timestamp;
+		if(line_end > pos && line_end[-1] == '\r'){
+			line_end--;
+		}
+		if(lineTimestamp(pos, line_end, timestamp) && !range.contains(timestamp)){
+			flush(pos);
+			run = next;
+		}
+		pos = next;
+	}
+	flush(end);
+	invalid_ = parser.invalid();
+
+	return samples;
+}
+
+uint64_t RecordingReader::forEachLine(const TimeRange &range, const SampleVisitor &visit)
+{
+	std::vector<uint16_t> sensels(static_cast<size_t>(sensor_count_) * sensel_count_);
+	sample_frame_point_t point{};
+	uint64_t samples = 0;
+
+	point.sensels = sensels.data();
+	parseLines(range, [&](const LineColumns &columns) {
+		for(size_t row = 0; row < columns.rows(); row++){
+			point.timestamp_usec = columns.timestamps[row];
+			point.temperature = columns.temperature[row];
+			point.humidity = columns.humidity[row];
+			point.pressure = columns.pressure[row];
+			point.sampling_time = columns.sampling_time[row];
+			point.battery_voltage = columns.battery_voltage[row];
+			for(size_t i = 0; i < sensels.size(); i++){
+				sensels[i] = columns.sensels[i][row];
+			}
+			samples++;
+			if(!visit(point)){
+				return false;
+			}
+		}
+		return true;
+	});
+
+	return samples;
+}
+
+/**
+ * Decodes the frames from the mapping, a frame cut off by a reset ends the log like in frame_tool.
+ */
+uint64_t RecordingReader::forEachFrame(const TimeRange &range, const SampleVisitor &visit)
+{
+	const uint8_t *data = file_.data();
+	const size_t size = file_.size();
+	std::vector<uint16_t> sensels(SAMPLE_FRAME_MAX_SENSELS);
+	sample_frame_header_t header;
+	sample_frame_decoder_t decoder;
+	sample_frame_point_t point;
+	uint64_t samples = 0;
+	size_t offset = 0;
+
+	while(offset < size){
+		if(sample_frame_parseHeader(data + offset, size - offset, &header) != SAMPLE_FRAME_OK
+				|| size - offset - SAMPLE_FRAME_HEADER_SIZE < header.payload_length){
+			invalid_++;
+			break;
+		}
+		const uint8_t *payload = data + offset + SAMPLE_FRAME_HEADER_SIZE;
+		offset += SAMPLE_FRAME_HEADER_SIZE + header.payload_length;
+		if(header.type != SAMPLE_FRAME_TYPE_SAMPLES){
+			continue;
+		}
+		if(header.sensor_count != sensor_count_ || header.sensel_count != sensel_count_){
+			invalid_++;
+			continue;
+		}
+
+		int result;
+		sample_frame_decoderInit(&decoder, &header, payload);
+		while((result = sample_frame_decodePoint(&decoder, &point, sensels.data())) == SAMPLE_FRAME_OK){
+			if(!range.contains(point.timestamp_usec)){
+				continue;
+			}
+			point.sensel_mask = nullptr;
+			samples++;
+			if(!visit(point)){
+				return samples;
+			}
+		}
+		if(result != SAMPLE_FRAME_END){
+			invalid_++;
+		}
+	}
+
+	return samples;
+}
+
+/**
+ * Walks the blocks of a column log-file. The columns of a block that lies completely in the range are passed on
+ * without a copy, the samples of the other blocks one by one.
+ */
+uint64_t RecordingReader::forEachBlock(const TimeRange &range, const std::vector<uint32_t> *columns,
+		const SampleVisitor *visit, const ColumnVisitor *visit_columns)
+{
+	std::vector<uint16_t> sensels(COLUMN_LOG_MAX_SENSELS);
+	std::vector<const uint8_t *> values(columns != nullptr ? columns->size() : 0);
+	std::vector<uint32_t> no_columns;
+	ColumnVisitor no_visit;
+	ColumnGather gather(columns != nullptr ? *columns : no_columns, visit_columns != nullptr ? *visit_columns : no_visit);
+	column_log_header_t header;
+	sample_frame_point_t point;
+	uint64_t samples = 0;
+	size_t offset = 0;
+	bool running = true;
+
+	for(; running && nextBlock(offset, header); offset += header.length){
+		if(header.type != COLUMN_LOG_TYPE_SAMPLES || header.count == 0 || header.max_timestamp_us < range.start_us
+				|| header.min_timestamp_us > range.end_us){
+			continue;
+		}
+		if(header.sensor_count != sensor_count_ || header.sensel_count != sensel_count_){
+			invalid_++;
+			continue;
+		}
+
+		const uint8_t *block = file_.data() + offset;
+		if(visit_columns != nullptr && range.contains(header.min_timestamp_us) && range.contains(header.max_timestamp_us)){
+			for(size_t k = 0; k < values.size(); k++){
+				values[k] = block + column_log_columnOffset(&header, (*columns)[k]);
+			}
+			running = gather.flush() && (*visit_columns)(header.count, values.data());
+			samples += header.count;
+			continue;
+		}
+
+		const uint8_t *timestamps = block + column_log_columnOffset(&header, COLUMN_LOG_COLUMN_TIMESTAMP);
+		for(uint32_t i = 0; running && i < header.count; i++){
+			uint64_t timestamp;
+			std::memcpy(&timestamp, timestamps + i * sizeof(uint64_t), sizeof(uint64_t));
+			if(!range.contains(timestamp)){
+				continue;
+			}
+			column_log_readPoint(block, &header, i, &point, sensels.data());
+			samples++;
+			running = visit != nullptr ? (*visit)(point) : gather.add(point);
+		}
+	}
+	if(running && visit_columns != nullptr){
+		gather.flush();
+	}
+
+	return samples;
+}
+
+/**
+ * Finds the next complete block at or after offset, invalid regions are skipped boundary by boundary.
+ */
+bool RecordingReader::nextBlock(size_t &offset, column_log_header_t &header) const
+{
+	const size_t size = file_.size();
+
+	offset = (offset + COLUMN_LOG_ALIGNMENT - 1) / COLUMN_LOG_ALIGNMENT * COLUMN_LOG_ALIGNMENT;
+	for(; offset + COLUMN_LOG_HEADER_SIZE + COLUMN_LOG_MARKER_SIZE <= size; offset += COLUMN_LOG_ALIGNMENT){
+		const uint8_t *block = file_.data() + offset;
+		if(column_log_parseHeader(block, size - offset, &header) == COLUMN_LOG_OK && header.length <= size - offset
+				&& column_log_checkMarker(block + header.length - COLUMN_LOG_MARKER_SIZE, &header) == COLUMN_LOG_OK){
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Takes the geometry of a text recording from its first lines.
+ */
+bool RecordingReader::detectGeometry()
+{
+	const char *pos = reinterpret_cast<const char *>(file_.data());
+	const char *end = pos + file_.size();
+	std::vector<size_t> carried;
+	ParsedLine line;
+
+	while(pos < end && carried.size() < GEOMETRY_LINES){
+		const char *newline = static_cast<const char *>(std::memchr(pos, '\n', end - pos));
+		const char *line_end = newline != nullptr ? newline : end;
+		if(line_end > pos && line_end[-1] == '\r'){
+			line_end--;
+		}
+		if(parseLine(pos, line_end, line)){
+			sensor_count_ = std::max(sensor_count_, line.sensor_count);
+			sensel_count_ = std::max(sensel_count_, line.sensel_count);
+			carried.push_back(line.sensels.size());
+		}
+		pos = newline != nullptr ? newline + 1 : end;
+	}
+	if(static_cast<size_t>(sensor_count_) * sensel_count_ > SAMPLE_FRAME_MAX_SENSELS){
+		sensel_count_ = static_cast<uint8_t>(SAMPLE_FRAME_MAX_SENSELS / sensor_count_);
+	}
+
+	const size_t count = static_cast<size_t>(sensor_count_) * sensel_count_;
+	sparse_ = std::any_of(carried.begin(), carried.end(), [count](size_t sensels) { return sensels < count; });
+
+	return !carried.empty();
+}
+
+} // namespace socketsense
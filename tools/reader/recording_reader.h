@@ -0,0 +1,162 @@
+/**
+ * @file recording_reader.h
+ * @brief Iterates the samples of SD-card recordings straight from a memory mapping.
+ *
+ * The three formats of the SD-card log (CONFIG_SD_LOGGING_FORMAT) are read: line protocol (<uid>.txt), sample frames
+ * (<uid>.sfr) and column blocks (<uid>.col). The file is mapped once and never copied into buffers: the lines are
+ * parsed in place, the frames are decoded from the mapping, and the columns of a column log-file are handed out as
+ * pointers into the mapping when a block lies completely in the time range.
+ *
+ * All samples are presented in the geometry of the recording, which is taken from the start of the file. Sensor
+ * elements that a line of a deadband recording leaves out keep their previous value. The lines are parsed into columns
+ * by SimdLineParser. A time range skips the lines by their timestamp before they are parsed (unless the recording has
+ * a deadband, where the values before the range are needed) and the column blocks by the time range in their header.
+ *
+ * @date October 17. 2026
+ */
+#ifndef TOOLS_READER_RECORDING_READER_H_
+#define TOOLS_READER_RECORDING_READER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "sample_frame.h"
+#include "column_log.h"
+#include "mapped_file.h"
+
+namespace socketsense {
+
+struct LineColumns;
+
+/**
+ * @brief Format of a recording.
+ */
+enum class RecordingFormat {
+	Text,		//!< Line protocol
+	Frames,		//!< Sample frames (sample_frame.h)
+	Columns		//!< Column blocks (column_log.h)
+};
+
+/**
+ * @brief Closed range of timestamps in us.
+ */
+struct TimeRange {
+	uint64_t start_us = 0;
+	uint64_t end_us = UINT64_MAX;
+
+	bool contains(uint64_t timestamp_us) const { return timestamp_us >= start_us && timestamp_us <= end_us; }
+	bool all() const { return start_us == 0 && end_us == UINT64_MAX; }
+};
+
+/**
+ * @brief Called for each sample, the point and its sensels are only valid during the call.
+ *
+ * @return False to stop the iteration.
+ */
+using SampleVisitor = std::function<bool(const sample_frame_point_t &point)>;
+
+/**
+ * @brief Called for runs of consecutive samples with one array per requested column.
+ *
+ * values[k] holds count values of the k-th requested column, in the native byte order with columnSize() bytes each.
+ * The arrays are only valid during the call.
+ *
+ * @return False to stop the iteration.
+ */
+using ColumnVisitor = std::function<bool(size_t count, const uint8_t *const *values)>;
+
+/**
+ * @brief Name of a column (COLUMN_LOG_COLUMN_*): timestamp, temp, hum, pres, st, bl or s<strip>_<sensel>.
+ */
+std::string columnName(uint32_t column, uint8_t sensel_count);
+
+/**
+ * @brief Finds a column by its name.
+ *
+ * @return False if there is no such column in the geometry.
+ */
+bool parseColumnName(const std::string &name, uint8_t sensor_count, uint8_t sensel_count, uint32_t &column);
+
+/**
+ * @brief Size of one value of a column in bytes.
+ */
+size_t columnSize(uint32_t column);
+
+/**
+ * @brief A recording opened for reading.
+ */
+class RecordingReader {
+public:
+	/**
+	 * @brief Maps the file and detects its format and geometry.
+	 *
+	 * @param path Path of the recording.
+	 * @return False if the file can't be mapped or holds no valid sample.
+	 */
+	bool open(const std::string &path);
+
+	RecordingFormat format() const { return format_; }
+	uint8_t sensorCount() const { return sensor_count_; }
+	uint8_t senselCount() const { return sensel_count_; }
+	size_t size() const { return file_.size(); }
+
+	/**
+	 * @brief The mapped file, e.g. to hand out the lines of a text recording unparsed.
+	 */
+	const uint8_t *data() const { return file_.data(); }
+
+	/**
+	 * @brief Number of columns of a sample, COLUMN_LOG_COLUMN_SENSEL plus one per sensor element.
+	 */
+	uint32_t columnCount() const { return COLUMN_LOG_COLUMN_SENSEL + static_cast<uint32_t>(sensor_count_) * sensel_count_; }
+
+	/**
+	 * @brief True if the lines of the recording leave out sensor elements (deadband).
+	 */
+	bool sparse() const { return sparse_; }
+
+	/**
+	 * @brief Number of lines, frames or blocks that were skipped as invalid by the last iteration.
+	 */
+	size_t invalid() const { return invalid_; }
+
+	/**
+	 * @brief Visits the samples in the time range in the order of the file.
+	 *
+	 * @return Number of visited samples.
+	 */
+	uint64_t forEach(const TimeRange &range, const SampleVisitor &visit);
+
+	/**
+	 * @brief Visits some columns of the samples in the time range in the order of the file.
+	 *
+	 * @param range Time range.
+	 * @param columns The columns (COLUMN_LOG_COLUMN_*), each below columnCount().
+	 * @param visit Called with runs of samples.
+	 * @return Number of visited samples.
+	 */
+	uint64_t forEachColumns(const TimeRange &range, const std::vector<uint32_t> &columns, const ColumnVisitor &visit);
+
+private:
+	uint64_t parseLines(const TimeRange &range, const std::function<bool(const LineColumns &)> &visit);
+	uint64_t forEachLine(const TimeRange &range, const SampleVisitor &visit);
+	uint64_t forEachFrame(const TimeRange &range, const SampleVisitor &visit);
+	uint64_t forEachBlock(const TimeRange &range, const std::vector<uint32_t> *columns, const SampleVisitor *visit,
+			const ColumnVisitor *visit_columns);
+	bool nextBlock(size_t &offset, column_log_header_t &header) const;
+	bool detectGeometry();
+
+	MappedFile file_;
+	RecordingFormat format_ = RecordingFormat::Text;
+	uint8_t sensor_count_ = 0;
+	uint8_t sensel_count_ = 0;
+	bool sparse_ = false;
+	size_t invalid_ = 0;
+};
+
+} // namespace socketsense
+
+#endif /* TOOLS_READER_RECORDING_READER_H_ */
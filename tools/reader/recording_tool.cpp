@@ -0,0 +1,194 @@
+/**
+ * @file recording_tool.cpp
+ * @brief Reads SD-card recordings (line protocol, sample frames or column blocks) through a memory mapping.
+ *
+ *   recording_tool info <recording>
+ *       Reports the format, the geometry, the number of samples and the time span of a recording.
+ *
+ *   recording_tool csv [-s start us] [-e end us] [-c columns] <recording>
+ *       Writes the samples in the time range as CSV to stdout.
+ *
+ *   recording_tool columns [-s start us] [-e end us] [-c columns] <recording> <directory>
+ *       Writes each column of the samples in the time range to <directory>/<column>.bin as a raw array.
+ *
+ *   recording_tool col [-s start us] [-e end us] [-b samples per block] [-i blocks per index] <recording> <file.col>
+ *       Writes the samples in the time range to a column log-file (column_tool, CONFIG_SD_LOGGING_FORMAT == 2).
+ *
+ * The columns are a comma separated list of timestamp, temp, hum, pres, st, bl and s<strip>_<sensel>; all columns by
+ * default. The time taken and the throughput are reported to stderr.
+ *
+ * @date October 17. 2026
+ */
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "recording_reader.h"
+#include "recording_export.h"
+
+using namespace socketsense;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+const char *formatName(RecordingFormat format)
+{
+	switch(format){
+		case RecordingFormat::Text: return "line protocol";
+		case RecordingFormat::Frames: return "sample frames";
+		default: return "column blocks";
+	}
+}
+
+/**
+ * Parses the column list, an empty list selects all columns.
+ */
+bool parseColumns(const std::string &list, const RecordingReader &reader, std::vector<uint32_t> &columns)
+{
+	if(list.empty()){
+		for(uint32_t column = 0; column < reader.columnCount(); column++){
+			columns.push_back(column);
+		}
+		return true;
+	}
+
+	size_t start = 0;
+	while(start <= list.size()){
+		size_t end = list.find(',', start);
+		if(end == std::string::npos){
+			end = list.size();
+		}
+		uint32_t column;
+		std::string name = list.substr(start, end - start);
+		if(!parseColumnName(name, reader.sensorCount(), reader.senselCount(), column)){
+			std::fprintf(stderr, "Unknown column %s\n", name.c_str());
+			return false;
+		}
+		columns.push_back(column);
+		start = end + 1;
+	}
+
+	return true;
+}
+
+void report(const RecordingReader &reader, uint64_t samples, double time)
+{
+	std::fprintf(stderr, "%" PRIu64 " samples (%zu invalid) in %.1f ms, %.2f GB/s of the %zu bytes recording\n",
+			samples, reader.invalid(), time * 1e3, reader.size() / time / 1e9, reader.size());
+}
+
+int info(RecordingReader &reader, const char *path)
+{
+	uint64_t first = UINT64_MAX;
+	uint64_t last = 0;
+
+	auto start = Clock::now();
+	uint64_t samples = reader.forEachColumns(TimeRange(), {COLUMN_LOG_COLUMN_TIMESTAMP},
+			[&](size_t count, const uint8_t *const *values) {
+		const uint64_t *timestamps = reinterpret_cast<const uint64_t *>(values[0]);
+		for(size_t i = 0; i < count; i++){
+			first = std::min(first, timestamps[i]);
+			last = std::max(last, timestamps[i]);
+		}
+		return true;
+	});
+	double time = seconds(start);
+
+	std::printf("%s: %s, %ux%u sensels%s, %" PRIu64 " samples\n", path, formatName(reader.format()),
+			reader.sensorCount(), reader.senselCount(), reader.sparse() ? " (deadband)" : "", samples);
+	if(samples > 0){
+		std::printf("timestamps %" PRIu64 " to %" PRIu64 " (%.1f s)\n", first, last, (last - first) / 1e6);
+	}
+	report(reader, samples, time);
+
+	return 0;
+}
+
+void usage(const char *name)
+{
+	std::fprintf(stderr, "Usage: %s info <recording>\n"
+			"       %s csv [-s start us] [-e end us] [-c columns] <recording>\n"
+			"       %s columns [-s start us] [-e end us] [-c columns] <recording> <directory>\n"
+			"       %s col [-s start us] [-e end us] [-b samples per block] [-i blocks per index] <recording> <file.col>\n",
+			name, name, name, name);
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	TimeRange range;
+	std::string column_list;
+	unsigned long block_samples = 128;
+	unsigned long index_interval = 64;
+	int opt;
+
+	if(argc < 2){
+		usage(argv[0]);
+		return 1;
+	}
+	std::string command = argv[1];
+	optind = 2;
+
+	while((opt = getopt(argc, argv, "s:e:c:b:i:")) != -1){
+		switch(opt){
+			case 's': range.start_us = std::strtoull(optarg, nullptr, 10); break;
+			case 'e': range.end_us = std::strtoull(optarg, nullptr, 10); break;
+			case 'c': column_list = optarg; break;
+			case 'b': block_samples = std::strtoul(optarg, nullptr, 10); break;
+			case 'i': index_interval = std::strtoul(optarg, nullptr, 10); break;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+	const int files = command == "columns" || command == "col" ? 2 : 1;
+	if(optind + files != argc || block_samples == 0 || block_samples > 65536 || index_interval == 0
+			|| index_interval > 65536){
+		usage(argv[0]);
+		return 1;
+	}
+
+	RecordingReader reader;
+	if(!reader.open(argv[optind])){
+		std::fprintf(stderr, "Can't read %s\n", argv[optind]);
+		return 1;
+	}
+	std::vector<uint32_t> columns;
+	if(!parseColumns(column_list, reader, columns)){
+		return 1;
+	}
+
+	uint64_t samples = 0;
+	bool ok;
+	auto start = Clock::now();
+	if(command == "info"){
+		return info(reader, argv[optind]);
+	}else if(command == "csv"){
+		ok = exportCsv(reader, range, columns, stdout, samples);
+	}else if(command == "columns"){
+		ok = exportColumns(reader, range, columns, argv[optind + 1], samples);
+	}else if(command == "col"){
+		ok = exportColumnLog(reader, range, argv[optind + 1], static_cast<uint32_t>(block_samples),
+				static_cast<uint32_t>(index_interval), samples);
+	}else{
+		usage(argv[0]);
+		return 1;
+	}
+	report(reader, samples, seconds(start));
+	if(!ok){
+		std::fprintf(stderr, "Writing the export failed\n");
+	}
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,336 @@
+/**
+ * @file bulk_uploader.cpp
+ * @brief Replays an SD-card recording into InfluxDB over several keep-alive connections.
+ *
+ * The checkpoint file is a header line that identifies the upload followed by the numbers of the written chunks, one
+ * per line. A line that was cut off by a crash is ignored.
+ *
+ * @date October 17. 2026
+ */
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "gzip_codec.h"
+#include "line_writer.h"
+#include "bulk_uploader.h"
+
+namespace socketsense {
+
+namespace {
+
+const char CHECKPOINT_MAGIC[] = "socketsense-upload 1";
+const size_t QUEUE_PER_CONNECTION = 2;		//!< Chunks cut ahead per connection
+
+bool retryable(int status)
+{
+	return status < 0 || status >= 500 || status == 408 || status == 429;
+}
+
+} // namespace
+
+BulkUploader::BulkUploader(const UploadConfig &config) : config_(config)
+{
+	config_.connections = std::max(config_.connections, 1U);
+	config_.chunk_points = std::max<size_t>(config_.chunk_points, 1);
+	config_.max_attempts = std::max(config_.max_attempts, 1U);
+}
+
+BulkUploader::~BulkUploader()
+{
+	if(checkpoint_ != nullptr){
+		std::fclose(checkpoint_);
+	}
+}
+
+bool BulkUploader::upload(RecordingReader &reader)
+{
+	if(!openCheckpoint(reader)){
+		std::lock_guard<std::mutex> lock(mutex_);
+		stats_.failed = true;
+		return false;
+	}
+
+	std::vector<std::thread> workers;
+	for(unsigned i = 0; i < config_.connections; i++){
+		workers.emplace_back(&BulkUploader::work, this);
+	}
+
+	if(reader.format() == RecordingFormat::Text){
+		cutLines(reader);
+	}else{
+		cutSamples(reader);
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		done_ = true;
+	}
+	ready_.notify_all();
+	for(auto &worker : workers){
+		worker.join();
+	}
+
+	if(checkpoint_ != nullptr){
+		std::fclose(checkpoint_);
+		checkpoint_ = nullptr;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	return !stopping_ && !stats_.failed && stats_.rejected == 0;
+}
+
+void BulkUploader::cancel()
+{
+	stopping_ = true;
+	std::lock_guard<std::mutex> lock(mutex_);
+	ready_.notify_all();
+	space_.notify_all();
+}
+
+UploadStats BulkUploader::statistics()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return stats_;
+}
+
+/**
+ * Loads the written chunks from the checkpoint file and opens it for appending, or creates it.
+ */
+bool BulkUploader::openCheckpoint(const RecordingReader &reader)
+{
+	if(config_.checkpoint.empty()){
+		return true;
+	}
+
+	const std::string header = std::string(CHECKPOINT_MAGIC) + " " + std::to_string(reader.size()) + " "
+			+ std::to_string(config_.chunk_points) + " " + config_.device;
+	std::ifstream existing(config_.checkpoint, std::ios::binary);
+	std::string content((std::istreambuf_iterator<char>(existing)), std::istreambuf_iterator<char>());
+
+	if(!content.empty()){
+		size_t line_end = content.find('\n');
+		if(content.compare(0, line_end, header) != 0 || line_end == std::string::npos){
+			std::fprintf(stderr, "The checkpoint %s belongs to another recording, chunk size or device\n",
+					config_.checkpoint.c_str());
+			return false;
+		}
+		for(size_t pos = line_end + 1, next; (next = content.find('\n', pos)) != std::string::npos; pos = next + 1){
+			checkpointed_.insert(std::strtoull(content.c_str() + pos, nullptr, 10));
+		}
+	}
+
+	checkpoint_ = std::fopen(config_.checkpoint.c_str(), "a");
+	if(checkpoint_ == nullptr){
+		std::fprintf(stderr, "Can't write the checkpoint %s: %s\n", config_.checkpoint.c_str(), std::strerror(errno));
+		return false;
+	}
+	if(content.empty()){
+		std::fprintf(checkpoint_, "%s\n", header.c_str());
+	}else if(content.back() != '\n'){
+		std::fputc('\n', checkpoint_);											//terminates the line cut off by a crash
+	}
+
+	return std::fflush(checkpoint_) == 0;
+}
+
+/**
+ * Cuts a text recording into chunks of lines, the lines are passed on as they are.
+ */
+bool BulkUploader::cutLines(RecordingReader &reader)
+{
+	const char *pos = reinterpret_cast<const char *>(reader.data());
+	const char *end = pos + reader.size();
+	const std::string tag = LineWriter::deviceTag(config_.device);
+
+	for(uint64_t index = 0; pos < end && !stopping_; index++){
+		Chunk chunk{index, 0, std::string()};
+		const bool skip = checkpointed_.count(index) != 0;
+
+		for(size_t lines = 0; pos < end && lines < config_.chunk_points; lines++){
+			const char *newline = static_cast<const char *>(std::memchr(pos, '\n', end - pos));
+			const char *line_end = newline != nullptr ? newline : end;
+			const char *next = newline != nullptr ? newline + 1 : end;
+			if(line_end > pos && line_end[-1] == '\r'){
+				line_end--;
+			}
+			if(line_end > pos && !skip){
+				LineWriter::appendTagged(chunk.lines, pos, line_end, tag);
+			}
+			chunk.points += line_end > pos ? 1 : 0;
+			pos = next;
+		}
+
+		if(!push(std::move(chunk), skip)){
+			return false;
+		}
+	}
+
+	return !stopping_;
+}
+
+/**
+ * Cuts a recording of sample frames or column blocks into chunks of samples, written as line protocol.
+ */
+bool BulkUploader::cutSamples(RecordingReader &reader)
+{
+	const uint8_t sensor_count = reader.sensorCount();
+	const uint8_t sensel_count = reader.senselCount();
+	LineWriter writer;
+	Chunk chunk{0, 0, std::string()};
+	bool running = true;
+
+	writer.setDevice(config_.device);
+	reader.forEach(TimeRange(), [&](const sample_frame_point_t &point) {
+		const bool skip = checkpointed_.count(chunk.index) != 0;
+		if(!skip){
+			writer.append(chunk.lines, point, sensor_count, sensel_count);
+		}
+		if(++chunk.points == config_.chunk_points){
+			uint64_t index = chunk.index;
+			running = push(std::move(chunk), skip);
+			chunk = Chunk{index + 1, 0, std::string()};
+		}
+		return running && !stopping_;
+	});
+	if(running && chunk.points > 0){
+		const bool skip = checkpointed_.count(chunk.index) != 0;
+		running = push(std::move(chunk), skip);
+	}
+
+	return running && !stopping_;
+}
+
+/**
+ * Queues a chunk for the workers, blocks while the queue is full. A chunk of the checkpoint is only counted.
+ */
+bool BulkUploader::push(Chunk &&chunk, bool skip)
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	stats_.chunks++;
+	if(skip || chunk.points == 0){
+		stats_.skipped += skip ? 1 : 0;
+		return true;
+	}
+
+	space_.wait(lock, [this]{ return queue_.size() < config_.connections * QUEUE_PER_CONNECTION || stopping_; });
+	if(stopping_){
+		return false;
+	}
+	queue_.push_back(std::move(chunk));
+	ready_.notify_one();
+
+	return true;
+}
+
+/**
+ * Worker thread with its own keep-alive connection.
+ */
+void BulkUploader::work()
+{
+	InfluxClient client(config_.influx);
+	std::string body;
+	unsigned connects = 0;
+
+	while(true){
+		Chunk chunk;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			ready_.wait(lock, [this]{ return !queue_.empty() || done_ || stopping_; });
+			if(stopping_ || queue_.empty()){
+				break;
+			}
+			chunk = std::move(queue_.front());
+			queue_.pop_front();
+			space_.notify_one();
+		}
+
+		bool written = writeChunk(client, chunk, body);
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stats_.connects += client.connects() - connects;
+			connects = client.connects();
+		}
+		if(!written){
+			cancel();
+			break;
+		}
+	}
+}
+
+/**
+ * Writes one chunk, repeating failed writes with backoff. Returns false if the upload has to stop.
+ */
+bool BulkUploader::writeChunk(InfluxClient &client, const Chunk &chunk, std::string &body)
+{
+	const bool gzip = config_.gzip_level > 0;
+	if(gzip && !gzipCompress(chunk.lines.data(), chunk.lines.size(), config_.gzip_level, body)){
+		std::fprintf(stderr, "Can't compress chunk %" PRIu64 "\n", chunk.index);
+		std::lock_guard<std::mutex> lock(mutex_);
+		stats_.failed = true;
+		return false;
+	}
+	const std::string &payload = gzip ? body : chunk.lines;
+
+	int backoff_ms = config_.initial_backoff_ms;
+	for(unsigned attempt = 1;; attempt++){
+		int status = client.write(payload, gzip);
+
+		if(status >= 200 && status < 300){
+			std::lock_guard<std::mutex> lock(mutex_);
+			stats_.written++;
+			stats_.points += chunk.points;
+			stats_.line_bytes += chunk.lines.size();
+			stats_.wire_bytes += payload.size();
+			if(checkpoint_ != nullptr && (std::fprintf(checkpoint_, "%" PRIu64 "\n", chunk.index) < 0
+					|| std::fflush(checkpoint_) != 0)){
+				std::fprintf(stderr, "Can't write the checkpoint %s\n", config_.checkpoint.c_str());
+				stats_.failed = true;
+				return false;
+			}
+			return true;
+		}
+		if(!retryable(status)){
+			std::fprintf(stderr, "Chunk %" PRIu64 " was rejected with status %d\n", chunk.index, status);
+			std::lock_guard<std::mutex> lock(mutex_);
+			stats_.rejected++;
+			return true;
+		}
+		if(stopping_){
+			return false;
+		}
+		if(attempt >= config_.max_attempts){
+			std::fprintf(stderr, "Chunk %" PRIu64 " failed %u times, last status %d\n", chunk.index, attempt, status);
+			std::lock_guard<std::mutex> lock(mutex_);
+			stats_.failed = true;
+			return false;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stats_.retries++;
+		}
+		sleepBackoff(backoff_ms);
+		backoff_ms = std::min(backoff_ms * 2, config_.max_backoff_ms);
+	}
+}
+
+/**
+ * Waits between half and all of the backoff, so the workers do not repeat their writes in lockstep. Returns early
+ * when the upload stops.
+ */
+void BulkUploader::sleepBackoff(int backoff_ms)
+{
+	thread_local std::mt19937 random(std::random_device{}());
+	std::uniform_int_distribution<int> jitter(backoff_ms / 2, std::max(backoff_ms, 1));
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	ready_.wait_for(lock, std::chrono::milliseconds(jitter(random)), [this]{ return stopping_.load(); });
+}
+
+} // namespace socketsense
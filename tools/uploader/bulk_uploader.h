@@ -0,0 +1,124 @@
+/**
+ * @file bulk_uploader.h
+ * @brief Replays an SD-card recording into InfluxDB over several keep-alive connections.
+ *
+ * The recording is split into chunks of chunk_points lines (line protocol, handed out unparsed) or samples (sample
+ * frames and column blocks, written as line protocol by LineWriter). The calling thread cuts the chunks, a worker per
+ * connection compresses them with gzip and posts them, so the chunks are written out of order. A write that fails
+ * (no answer, 5xx, 408 or 429) is repeated with an exponential backoff; if a chunk still fails after max_attempts,
+ * the upload stops. Other 4xx answers reject the chunk, it is reported and the upload goes on.
+ *
+ * Written chunks are appended to the checkpoint file, an upload with the same checkpoint skips them. The chunks are
+ * identified by their number, so the checkpoint only fits the same recording with the same chunk size and device.
+ * Since a chunk is written again when its answer got lost, a point can be written twice; InfluxDB keeps one point per
+ * series and timestamp, so this does not duplicate data.
+ *
+ * @date October 17. 2026
+ */
+#ifndef TOOLS_UPLOADER_BULK_UPLOADER_H_
+#define TOOLS_UPLOADER_BULK_UPLOADER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include "influx_client.h"
+#include "recording_reader.h"
+
+namespace socketsense {
+
+/**
+ * @brief Configuration of an upload.
+ */
+struct UploadConfig {
+	InfluxConfig influx;					//!< The database
+	unsigned connections = 4;				//!< Keep-alive connections, each with its own worker thread
+	size_t chunk_points = 5000;				//!< Points per write request
+	int gzip_level = 1;						//!< zlib level of the bodies, 0 sends them uncompressed
+	std::string device;						//!< Device tag added to the points that have none, empty to leave them
+	std::string checkpoint;					//!< Checkpoint file, empty for none
+	unsigned max_attempts = 8;				//!< Attempts of a chunk before the upload stops
+	int initial_backoff_ms = 100;			//!< Delay before the second attempt, doubled with every further one
+	int max_backoff_ms = 5000;				//!< Upper bound of the delay between two attempts
+};
+
+/**
+ * @brief Progress of an upload.
+ */
+struct UploadStats {
+	uint64_t chunks = 0;				//!< Chunks cut from the recording so far
+	uint64_t skipped = 0;				//!< Chunks written according to the checkpoint
+	uint64_t written = 0;				//!< Chunks written by this upload
+	uint64_t rejected = 0;				//!< Chunks rejected by the database (4xx)
+	uint64_t points = 0;				//!< Points of the written chunks
+	uint64_t line_bytes = 0;			//!< Line protocol bytes of the written chunks
+	uint64_t wire_bytes = 0;			//!< Bodies of the written chunks as sent
+	uint64_t retries = 0;				//!< Repeated write requests
+	uint64_t connects = 0;				//!< Connections opened
+	bool failed = false;				//!< A chunk failed max_attempts times, or the checkpoint can't be written
+};
+
+/**
+ * @brief Uploads one recording.
+ */
+class BulkUploader {
+public:
+	explicit BulkUploader(const UploadConfig &config);
+	~BulkUploader();
+
+	BulkUploader(const BulkUploader &) = delete;
+	BulkUploader &operator=(const BulkUploader &) = delete;
+
+	/**
+	 * @brief Uploads the recording, blocks until all chunks are written or the upload stops.
+	 *
+	 * @param reader The opened recording.
+	 * @return True if every chunk was written or skipped.
+	 */
+	bool upload(RecordingReader &reader);
+
+	/**
+	 * @brief Stops the upload after the chunks that are being written, may be called from another thread.
+	 */
+	void cancel();
+
+	/**
+	 * @brief Returns the progress, may be called from another thread.
+	 */
+	UploadStats statistics();
+
+private:
+	struct Chunk {
+		uint64_t index;
+		uint64_t points;
+		std::string lines;
+	};
+
+	bool openCheckpoint(const RecordingReader &reader);
+	bool cutLines(RecordingReader &reader);
+	bool cutSamples(RecordingReader &reader);
+	bool push(Chunk &&chunk, bool skip);
+	void work();
+	bool writeChunk(InfluxClient &client, const Chunk &chunk, std::string &body);
+	void sleepBackoff(int backoff_ms);
+
+	UploadConfig config_;
+	std::mutex mutex_;
+	std::condition_variable ready_;			//!< Signals the workers, a chunk is queued or the upload ends
+	std::condition_variable space_;			//!< Signals the producer, a chunk was taken from the queue
+	std::deque<Chunk> queue_;
+	bool done_ = false;						//!< All chunks are cut
+	std::atomic<bool> stopping_{false};		//!< Cancelled or failed, no further chunks are written
+	std::set<uint64_t> checkpointed_;		//!< Chunks written according to the checkpoint file
+	FILE *checkpoint_ = nullptr;
+	UploadStats stats_;
+};
+
+} // namespace socketsense
+
+#endif /* TOOLS_UPLOADER_BULK_UPLOADER_H_ */
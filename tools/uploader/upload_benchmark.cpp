@@ -0,0 +1,236 @@
+/**
+ * @file upload_benchmark.cpp
+ * @brief Measures BulkUploader against the mock InfluxDB and checks that every point arrives exactly once.
+ *
+ * A synthetic line protocol recording with gait-like sensor values is uploaded to an in-process MockInflux that
+ * answers each write after a delay, like a database that is busy storing the points. The upload is repeated with
+ * 1, 2, 4 and 8 connections, with and without gzip, and once with injected 503 answers and disconnects. Finally an
+ * upload is stopped by failures and resumed from its checkpoint. For each run the points/s are reported, and the
+ * points counted by the mock are compared with the lines of the recording.
+ *
+ *   upload_benchmark [-m MB of line protocol] [-s strips] [-e sensels per strip] [-n points per write] [-l ms per write]
+ *                    [-d directory]
+ *
+ * @date October 17. 2026
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "line_writer.h"
+#include "mock_influx.h"
+#include "bulk_uploader.h"
+
+using namespace socketsense;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds(Clock::time_point start)
+{
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * Writes the synthetic recording with the same waveforms as decode_benchmark, returns the number of lines.
+ */
+uint64_t generate(const std::string &path, size_t bytes, unsigned sensors, unsigned sensels)
+{
+	const unsigned count = sensors * sensels;
+	std::vector<uint16_t> values(count);
+	sample_frame_point_t point{};
+	LineWriter writer;
+	std::string lines;
+	uint64_t samples = 0;
+	size_t written = 0;
+
+	FILE *file = std::fopen(path.c_str(), "wb");
+	if(file == nullptr){
+		return 0;
+	}
+	point.timestamp_usec = 1571234567890123ULL;
+	point.sensels = values.data();
+	while(written < bytes){
+		lines.clear();
+		for(unsigned p = 0; p < 1000; p++, samples++){
+			double t = point.timestamp_usec * 1e-6;
+			point.timestamp_usec += 10000 + (p % 7);
+			point.temperature = 25.0f + 0.01f * static_cast<float>(std::sin(t * 0.01));
+			point.humidity = 39.0f + 0.02f * static_cast<float>(std::sin(t * 0.02));
+			point.pressure = 100655.0f + static_cast<float>(std::sin(t * 0.005));
+			point.sampling_time = 2400 + (p % 50);
+			point.battery_voltage = 3950;
+			for(unsigned i = 0; i < count; i++){
+				double phase = std::fmod(t + i * 0.05, 1.0);
+				values[i] = static_cast<uint16_t>(phase < 0.6 ? 400 + 3000 * std::sin(phase / 0.6 * M_PI) : 400 + (i * 7) % 13);
+			}
+			writer.append(lines, point, sensors, sensels);
+		}
+		if(std::fwrite(lines.data(), 1, lines.size(), file) != lines.size()){
+			samples = 0;
+			break;
+		}
+		written += lines.size();
+	}
+
+	return std::fclose(file) == 0 ? samples : 0;
+}
+
+struct Run {
+	const char *name;
+	unsigned connections;
+	int gzip_level;
+	double error_rate;
+	double disconnect_rate;
+};
+
+/**
+ * Uploads the recording once to a new mock server, returns false if the points that arrived differ.
+ */
+bool measure(const Run &run, RecordingReader &reader, uint64_t samples, size_t chunk_points, int delay_ms)
+{
+	MockInfluxConfig mock_config;
+	mock_config.port = 0;
+	mock_config.delay_ms = delay_ms;
+	mock_config.error_rate = run.error_rate;
+	mock_config.disconnect_rate = run.disconnect_rate;
+	MockInflux mock(mock_config);
+	if(!mock.start()){
+		return false;
+	}
+
+	UploadConfig config;
+	config.influx.port = mock.port();
+	config.connections = run.connections;
+	config.chunk_points = chunk_points;
+	config.gzip_level = run.gzip_level;
+	config.initial_backoff_ms = 10;
+	config.max_attempts = 20;
+	BulkUploader uploader(config);
+
+	auto start = Clock::now();
+	bool ok = uploader.upload(reader);
+	double duration = seconds(start);
+	mock.stop();
+
+	UploadStats stats = uploader.statistics();
+	MockInfluxStats received = mock.statistics();
+	ok = ok && received.points == samples && stats.points == samples;
+	std::printf("%-24s %9.0f points/s %7.1f MB/s %6.1fx %5llu retries %4llu connections %s\n", run.name,
+			stats.points / duration, stats.line_bytes / duration / 1e6,
+			stats.wire_bytes > 0 ? static_cast<double>(stats.line_bytes) / stats.wire_bytes : 0.0,
+			(unsigned long long) stats.retries, (unsigned long long) stats.connects, ok ? "" : "POINTS DIFFER");
+
+	return ok;
+}
+
+/**
+ * Stops an upload with failures that are not repeated, then resumes it from the checkpoint.
+ */
+bool measureResume(RecordingReader &reader, uint64_t samples, size_t chunk_points, const std::string &checkpoint,
+		int delay_ms)
+{
+	uint64_t points = 0;
+	std::remove(checkpoint.c_str());
+
+	for(int attempt = 0; attempt < 2; attempt++){
+		MockInfluxConfig mock_config;
+		mock_config.port = 0;
+		mock_config.delay_ms = delay_ms;
+		mock_config.error_rate = attempt == 0 ? 0.02 : 0.0;
+		MockInflux mock(mock_config);
+		if(!mock.start()){
+			return false;
+		}
+
+		UploadConfig config;
+		config.influx.port = mock.port();
+		config.chunk_points = chunk_points;
+		config.checkpoint = checkpoint;
+		config.max_attempts = 1;
+		BulkUploader uploader(config);
+		bool ok = uploader.upload(reader);
+		mock.stop();
+
+		UploadStats stats = uploader.statistics();
+		points += mock.statistics().points;
+		std::printf("%-24s %llu of %llu chunks written, %llu from the checkpoint%s\n", attempt == 0 ? "stopped by a failure"
+				: "resumed", (unsigned long long) (stats.written + stats.skipped), (unsigned long long) stats.chunks,
+				(unsigned long long) stats.skipped, ok ? "" : ", stopped");
+	}
+	std::remove(checkpoint.c_str());
+
+	if(points != samples){
+		std::printf("%llu points arrived instead of %llu\n", (unsigned long long) points, (unsigned long long) samples);
+	}
+	return points == samples;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+	unsigned long megabytes = 64;
+	unsigned sensors = 4;
+	unsigned sensels = 8;
+	unsigned long chunk_points = 2000;
+	int delay_ms = 5;
+	std::string directory = "/tmp";
+	int opt;
+
+	while((opt = getopt(argc, argv, "m:s:e:n:l:d:")) != -1){
+		switch(opt){
+			case 'm': megabytes = std::strtoul(optarg, nullptr, 10); break;
+			case 's': sensors = std::atoi(optarg); break;
+			case 'e': sensels = std::atoi(optarg); break;
+			case 'n': chunk_points = std::strtoul(optarg, nullptr, 10); break;
+			case 'l': delay_ms = std::atoi(optarg); break;
+			case 'd': directory = optarg; break;
+			default:
+				std::fprintf(stderr, "Usage: %s [-m MB of line protocol] [-s strips] [-e sensels per strip] [-n points per write] "
+						"[-l ms per write] [-d directory]\n", argv[0]);
+				return 1;
+		}
+	}
+	if(megabytes == 0 || chunk_points == 0 || sensors == 0 || sensels == 0 || sensors * sensels > SAMPLE_FRAME_MAX_SENSELS){
+		std::fprintf(stderr, "Invalid geometry or size\n");
+		return 1;
+	}
+
+	const std::string path = directory + "/upload_benchmark.txt";
+	uint64_t samples = generate(path, megabytes * 1000000, sensors, sensels);
+	RecordingReader reader;
+	if(samples == 0 || !reader.open(path)){
+		std::fprintf(stderr, "Can't write the recording to %s\n", directory.c_str());
+		return 1;
+	}
+	std::printf("%llu points with %ux%u sensels, %zu bytes, %lu points and %d ms per write\n", (unsigned long long) samples,
+			sensors, sensels, reader.size(), chunk_points, delay_ms);
+
+	const Run runs[] = {
+		{"1 connection", 1, 0, 0.0, 0.0},
+		{"1 connection, gzip", 1, 1, 0.0, 0.0},
+		{"2 connections, gzip", 2, 1, 0.0, 0.0},
+		{"4 connections", 4, 0, 0.0, 0.0},
+		{"4 connections, gzip", 4, 1, 0.0, 0.0},
+		{"8 connections, gzip", 8, 1, 0.0, 0.0},
+		{"4 conn., 5% 503, 2% drop", 4, 1, 0.05, 0.02},
+	};
+	bool ok = true;
+	for(const Run &run : runs){
+		ok = measure(run, reader, samples, chunk_points, delay_ms) && ok;
+	}
+	ok = measureResume(reader, samples, chunk_points, directory + "/upload_benchmark.ckpt", delay_ms) && ok;
+
+	std::remove(path.c_str());
+	if(!ok){
+		std::fprintf(stderr, "The points that arrived differ from the recording\n");
+	}
+
+	return ok ? 0 : 1;
+}
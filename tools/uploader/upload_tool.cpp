@@ -0,0 +1,132 @@
+/**
+ * @file upload_tool.cpp
+ * @brief Uploads SD-card recordings to InfluxDB in parallel, with gzip bodies and a checkpoint to resume from.
+ *
+ *   socketsense_upload [options] <recording>
+ *
+ * The recording can be line protocol, sample frames or column blocks (see recording_reader.h). The progress is printed
+ * periodically and a summary at the end. Interrupting the upload (SIGINT) lets the chunks in flight finish, so the
+ * checkpoint is complete and the same command resumes the upload.
+ *
+ *   socketsense_upload -H 192.168.1.10 -u socketsense -w socketsense -D 3fa2 -k 3fa2.ckpt 3fa2.txt
+ *
+ * @date October 17. 2026
+ */
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <unistd.h>
+
+#include "bulk_uploader.h"
+
+using namespace socketsense;
+
+static volatile std::sig_atomic_t stop_requested = 0;
+
+static void handleSignal(int)
+{
+	stop_requested = 1;
+}
+
+static void usage(const char *name)
+{
+	std::fprintf(stderr,
+			"Usage: %s [options] <recording>\n"
+			"  -H host      IPv4 address of InfluxDB (127.0.0.1)\n"
+			"  -P port      port of InfluxDB (8086)\n"
+			"  -d database  database (SOCKET_SENSE)\n"
+			"  -u user      InfluxDB user (no authentication)\n"
+			"  -w password  password of the user\n"
+			"  -c count     parallel connections (4)\n"
+			"  -n points    points per write request (5000)\n"
+			"  -z level     gzip level of the bodies, 0 for none (1)\n"
+			"  -D uid       device tag of the points that have none (none)\n"
+			"  -k file      checkpoint file to resume from (none)\n"
+			"  -a count     attempts of a write before the upload stops (8)\n"
+			"  -s seconds   progress interval, 0 to disable (5)\n", name);
+}
+
+static void printStats(const char *label, const UploadStats &stats, double elapsed, uint64_t last_points)
+{
+	std::fprintf(stderr, "%s: %llu points, %.0f points/s, %llu of %llu chunks written (%llu from the checkpoint, "
+			"%llu rejected), %llu retries, %llu connections\n", label, (unsigned long long) stats.points,
+			(stats.points - last_points) / elapsed, (unsigned long long) (stats.written + stats.skipped),
+			(unsigned long long) stats.chunks, (unsigned long long) stats.skipped, (unsigned long long) stats.rejected,
+			(unsigned long long) stats.retries, (unsigned long long) stats.connects);
+}
+
+int main(int argc, char **argv)
+{
+	UploadConfig config;
+	int stats_interval = 5;
+	int opt;
+
+	while((opt = getopt(argc, argv, "H:P:d:u:w:c:n:z:D:k:a:s:h")) != -1){
+		switch(opt){
+			case 'H': config.influx.host = optarg; break;
+			case 'P': config.influx.port = std::atoi(optarg); break;
+			case 'd': config.influx.database = optarg; break;
+			case 'u': config.influx.username = optarg; break;
+			case 'w': config.influx.password = optarg; break;
+			case 'c': config.connections = std::strtoul(optarg, nullptr, 10); break;
+			case 'n': config.chunk_points = std::strtoul(optarg, nullptr, 10); break;
+			case 'z': config.gzip_level = std::atoi(optarg); break;
+			case 'D': config.device = optarg; break;
+			case 'k': config.checkpoint = optarg; break;
+			case 'a': config.max_attempts = std::strtoul(optarg, nullptr, 10); break;
+			case 's': stats_interval = std::atoi(optarg); break;
+			default: usage(argv[0]); return 1;
+		}
+	}
+	if(optind + 1 != argc || config.gzip_level < 0 || config.gzip_level > 9){
+		usage(argv[0]);
+		return 1;
+	}
+
+	RecordingReader reader;
+	if(!reader.open(argv[optind])){
+		std::fprintf(stderr, "Can't read %s\n", argv[optind]);
+		return 1;
+	}
+
+	BulkUploader uploader(config);
+	std::signal(SIGINT, handleSignal);
+	std::signal(SIGTERM, handleSignal);
+
+	auto start = std::chrono::steady_clock::now();
+	bool ok = false;
+	std::atomic<bool> finished{false};
+	std::thread upload([&]{
+		ok = uploader.upload(reader);
+		finished = true;
+	});
+
+	auto last = start;
+	uint64_t last_points = 0;
+	while(!finished){
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		if(stop_requested){
+			uploader.cancel();
+		}
+		auto now = std::chrono::steady_clock::now();
+		double elapsed = std::chrono::duration<double>(now - last).count();
+		if(stats_interval > 0 && elapsed >= stats_interval){
+			UploadStats stats = uploader.statistics();
+			printStats("progress", stats, elapsed, last_points);
+			last = now;
+			last_points = stats.points;
+		}
+	}
+	upload.join();
+
+	UploadStats stats = uploader.statistics();
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	printStats(ok ? "done" : "stopped", stats, elapsed, 0);
+	std::fprintf(stderr, "%.1f s, %.1f MB of line protocol sent as %.1f MB (%.1fx)\n", elapsed, stats.line_bytes / 1e6,
+			stats.wire_bytes / 1e6, stats.wire_bytes > 0 ? static_cast<double>(stats.line_bytes) / stats.wire_bytes : 0.0);
+
+	return ok ? 0 : 1;
+}